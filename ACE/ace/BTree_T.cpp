@@ -0,0 +1,766 @@
+#ifndef ACE_BTREE_T_CPP
+#define ACE_BTREE_T_CPP
+
+#include "ace/BTree_T.h"
+#include "ace/Malloc_Base.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/BTree_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Log_Category.h"
+
+#include <new>
+#include <utility>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc4(ACE_BTree)
+ACE_ALLOC_HOOK_DEFINE_Tc4(ACE_BTree_Iterator_Base)
+ACE_ALLOC_HOOK_DEFINE_Tc4(ACE_BTree_Iterator)
+ACE_ALLOC_HOOK_DEFINE_Tc4(ACE_BTree_Reverse_Iterator)
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt)
+  : allocator_ (bt.allocator_),
+    root_ (0),
+    head_ (0),
+    tail_ (0),
+    current_size_ (0)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &)");
+  ACE_READ_GUARD (ACE_LOCK, ace_mon, bt.lock_);
+
+  this->copy_i (bt);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator= (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator=");
+  if (this != &bt)
+    {
+      ACE_WRITE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+      ACE_READ_GUARD (ACE_LOCK, ace_mon2, bt.lock_);
+
+      this->close_i ();
+      this->allocator_ = bt.allocator_;
+      this->copy_i (bt);
+    }
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\ncurrent_size_ = %B"), this->current_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nleaf_max = %B"), size_t (LEAF_MAX)));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\ninner_max = %B"), size_t (INNER_MAX)));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nroot_ = %@\n"), this->root_));
+  this->allocator_->dump ();
+  this->lock_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::lower_bound (const EXT_ID &ext_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::lower_bound");
+  if (this->root_ == 0)
+    return this->end ();
+
+  Inner *path[MAX_DEPTH];
+  size_t slots[MAX_DEPTH];
+  size_t depth = 0;
+  Leaf *leaf = this->descend_i (ext_id, path, slots, depth);
+  size_t index = this->lower_bound_i (leaf, ext_id);
+
+  // Past the last entry of the leaf, the next one starts with a
+  // greater key.
+  if (index == leaf->count_)
+    {
+      leaf = leaf->next_;
+      index = 0;
+    }
+  return ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (*this, leaf, index);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> size_t
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::lower_bound_i (Leaf *leaf, const EXT_ID &k) const
+{
+  // Halve the range without branching on the comparison, which is
+  // unpredictable within a node.
+  ENTRY *const entries = leaf->entries ();
+  size_t n = leaf->count_;
+  if (n == 0)
+    return 0;
+
+  ENTRY *base = entries;
+  while (n > 1)
+    {
+      size_t const half = n / 2;
+      base = this->lessthan (base[half].key (), k) ? base + half : base;
+      n -= half;
+    }
+  return (base - entries) + this->lessthan (base->key (), k);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> size_t
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::child_index (Inner *inner, const EXT_ID &k) const
+{
+  // The number of keys not greater than <k>: the keys equal to a
+  // separator are on its right.
+  EXT_ID *const keys = inner->keys ();
+  size_t n = inner->count_;
+  EXT_ID *base = keys;
+  while (n > 1)
+    {
+      size_t const half = n / 2;
+      base = this->lessthan (k, base[half]) ? base : base + half;
+      n -= half;
+    }
+  return (base - keys) + !this->lessthan (k, *base);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> typename ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Leaf *
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::descend_i (const EXT_ID &k,
+                                                              Inner *path[],
+                                                              size_t slots[],
+                                                              size_t &depth) const
+{
+  Node *node = this->root_;
+  depth = 0;
+  while (!node->leaf_)
+    {
+      Inner *const inner = static_cast<Inner *> (node);
+      size_t const i = this->child_index (inner, k);
+      path[depth] = inner;
+      slots[depth] = i;
+      ++depth;
+      node = inner->children_[i];
+    }
+  return static_cast<Leaf *> (node);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::find_i (const EXT_ID &k,
+                                                           Leaf *&leaf,
+                                                           size_t &index) const
+{
+  leaf = 0;
+  Node *node = this->root_;
+  if (node == 0)
+    return;
+
+  while (!node->leaf_)
+    {
+      Inner *const inner = static_cast<Inner *> (node);
+      node = inner->children_[this->child_index (inner, k)];
+    }
+
+  Leaf *const candidate = static_cast<Leaf *> (node);
+  index = this->lower_bound_i (candidate, k);
+  if (index < candidate->count_
+      && !this->lessthan (k, candidate->entries ()[index].key ()))
+    leaf = candidate;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::insert_i (const EXT_ID &k,
+                                                             const INT_ID &t,
+                                                             ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::insert_i");
+
+  if (this->root_ == 0)
+    {
+      Leaf *const leaf = this->new_leaf ();
+      if (leaf == 0)
+        return -1;
+      this->root_ = this->head_ = this->tail_ = leaf;
+    }
+
+  Inner *path[MAX_DEPTH];
+  size_t slots[MAX_DEPTH];
+  size_t depth = 0;
+  Leaf *const leaf = this->descend_i (k, path, slots, depth);
+  size_t pos = this->lower_bound_i (leaf, k);
+
+  if (pos < leaf->count_ && !this->lessthan (k, leaf->entries ()[pos].key ()))
+    {
+      entry = leaf->entries () + pos;
+      return 1;
+    }
+
+  if (leaf->count_ < LEAF_MAX)
+    {
+      insert_at (leaf->entries (), leaf->count_, pos, ENTRY (k, t));
+      ++leaf->count_;
+      ++this->current_size_;
+      entry = leaf->entries () + pos;
+      return 0;
+    }
+
+  // The leaf splits, and so does every full inner node above it.
+  // Allocate all the nodes first so that a failure leaves the tree
+  // as it was.
+  size_t splits = 1;
+  while (splits <= depth && path[depth - splits]->count_ == INNER_MAX)
+    ++splits;
+  size_t const inners = splits - 1 + (splits > depth ? 1 : 0);
+
+  Leaf *const right = this->new_leaf ();
+  if (right == 0)
+    return -1;
+
+  Inner *spare[MAX_DEPTH + 1];
+  for (size_t s = 0; s != inners; ++s)
+    {
+      spare[s] = this->new_inner ();
+      if (spare[s] == 0)
+        {
+          while (s > 0)
+            this->allocator_->free (spare[--s]);
+          this->allocator_->free (right);
+          return -1;
+        }
+    }
+
+  // Move the upper half of the leaf to the new one, right after it
+  // in the chain.
+  size_t const half = (LEAF_MAX + 1) / 2;
+  move_to (leaf->entries () + half, LEAF_MAX - half, right->entries ());
+  right->count_ = LEAF_MAX - half;
+  leaf->count_ = half;
+  right->prev_ = leaf;
+  right->next_ = leaf->next_;
+  if (leaf->next_ != 0)
+    leaf->next_->prev_ = right;
+  else
+    this->tail_ = right;
+  leaf->next_ = right;
+
+  Leaf *target = leaf;
+  if (pos > half)
+    {
+      target = right;
+      pos -= half;
+    }
+  insert_at (target->entries (), target->count_, pos, ENTRY (k, t));
+  ++target->count_;
+  ++this->current_size_;
+  entry = target->entries () + pos;
+
+  // Insert the first key of each new node, with the node, in its
+  // parent, going up as long as the parents are full.
+  EXT_ID separator (right->entries ()[0].key ());
+  Node *child = right;
+  size_t used = 0;
+  for (size_t level = depth; ; )
+    {
+      if (level == 0)
+        {
+          Inner *const root = spare[used++];
+          new (root->keys ()) EXT_ID (std::move (separator));
+          root->children_[0] = this->root_;
+          root->children_[1] = child;
+          root->count_ = 1;
+          this->root_ = root;
+          break;
+        }
+
+      Inner *const parent = path[--level];
+      size_t i = slots[level];
+      if (parent->count_ < INNER_MAX)
+        {
+          insert_at (parent->keys (), parent->count_, i, std::move (separator));
+          insert_at (parent->children_, parent->count_ + 1, i + 1, std::move (child));
+          ++parent->count_;
+          break;
+        }
+
+      // Key <m> goes up, the keys after it and their children move
+      // to the new node.
+      Inner *const sibling = spare[used++];
+      size_t const m = INNER_MAX / 2;
+      EXT_ID up (std::move (parent->keys ()[m]));
+      parent->keys ()[m].~EXT_ID ();
+      move_to (parent->keys () + m + 1, INNER_MAX - m - 1, sibling->keys ());
+      for (size_t c = 0; c != INNER_MAX - m; ++c)
+        sibling->children_[c] = parent->children_[m + 1 + c];
+      sibling->count_ = INNER_MAX - m - 1;
+      parent->count_ = m;
+
+      Inner *into = parent;
+      if (i > m)
+        {
+          into = sibling;
+          i -= m + 1;
+        }
+      insert_at (into->keys (), into->count_, i, std::move (separator));
+      insert_at (into->children_, into->count_ + 1, i + 1, std::move (child));
+      ++into->count_;
+
+      separator = std::move (up);
+      child = sibling;
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::remove_i (const EXT_ID &k, INT_ID *t)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::remove_i");
+
+  if (this->root_ == 0)
+    return -1;
+
+  Inner *path[MAX_DEPTH];
+  size_t slots[MAX_DEPTH];
+  size_t depth = 0;
+  Leaf *const leaf = this->descend_i (k, path, slots, depth);
+  size_t const pos = this->lower_bound_i (leaf, k);
+  if (pos == leaf->count_ || this->lessthan (k, leaf->entries ()[pos].key ()))
+    return -1;
+
+  if (t != 0)
+    *t = leaf->entries ()[pos].item ();
+  erase_at (leaf->entries (), leaf->count_, pos);
+  --leaf->count_;
+  --this->current_size_;
+
+  // Refill the nodes that fell under their minimum from a sibling,
+  // or merge them with one, going up as long as merging leaves the
+  // parent under its minimum too.  The separators stay valid bounds
+  // when the first entry of a leaf goes, so they are left alone.
+  Node *node = leaf;
+  for (size_t level = depth;
+       level > 0 && node->count_ < (node->leaf_ ? LEAF_MIN : INNER_MIN);
+       )
+    {
+      Inner *const parent = path[--level];
+      size_t const i = slots[level];
+      size_t const min = node->leaf_ ? LEAF_MIN : INNER_MIN;
+      if (i > 0 && parent->children_[i - 1]->count_ > min)
+        {
+          this->borrow_left (parent, i);
+          break;
+        }
+      if (i < parent->count_ && parent->children_[i + 1]->count_ > min)
+        {
+          this->borrow_right (parent, i);
+          break;
+        }
+      this->merge_children (parent, i > 0 ? i - 1 : i);
+      node = parent;
+    }
+
+  if (this->root_->count_ == 0)
+    {
+      Node *const old_root = this->root_;
+      if (old_root->leaf_)
+        this->root_ = this->head_ = this->tail_ = 0;
+      else
+        this->root_ = static_cast<Inner *> (old_root)->children_[0];
+      this->allocator_->free (old_root);
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::borrow_left (Inner *parent, size_t i)
+{
+  Node *const node = parent->children_[i];
+  Node *const left = parent->children_[i - 1];
+  EXT_ID &separator = parent->keys ()[i - 1];
+
+  if (node->leaf_)
+    {
+      Leaf *const to = static_cast<Leaf *> (node);
+      Leaf *const from = static_cast<Leaf *> (left);
+      ENTRY &last = from->entries ()[from->count_ - 1];
+      insert_at (to->entries (), to->count_, 0, std::move (last));
+      last.~ENTRY ();
+      ++to->count_;
+      --from->count_;
+      separator = to->entries ()[0].key ();
+    }
+  else
+    {
+      Inner *const to = static_cast<Inner *> (node);
+      Inner *const from = static_cast<Inner *> (left);
+      insert_at (to->keys (), to->count_, 0, std::move (separator));
+      insert_at (to->children_, to->count_ + 1, 0, std::move (from->children_[from->count_]));
+      ++to->count_;
+      EXT_ID &last = from->keys ()[from->count_ - 1];
+      separator = std::move (last);
+      last.~EXT_ID ();
+      --from->count_;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::borrow_right (Inner *parent, size_t i)
+{
+  Node *const node = parent->children_[i];
+  Node *const right = parent->children_[i + 1];
+  EXT_ID &separator = parent->keys ()[i];
+
+  if (node->leaf_)
+    {
+      Leaf *const to = static_cast<Leaf *> (node);
+      Leaf *const from = static_cast<Leaf *> (right);
+      new (to->entries () + to->count_) ENTRY (std::move (from->entries ()[0]));
+      ++to->count_;
+      erase_at (from->entries (), from->count_, 0);
+      --from->count_;
+      separator = from->entries ()[0].key ();
+    }
+  else
+    {
+      Inner *const to = static_cast<Inner *> (node);
+      Inner *const from = static_cast<Inner *> (right);
+      new (to->keys () + to->count_) EXT_ID (std::move (separator));
+      to->children_[to->count_ + 1] = from->children_[0];
+      ++to->count_;
+      separator = std::move (from->keys ()[0]);
+      erase_at (from->keys (), from->count_, 0);
+      erase_at (from->children_, from->count_ + 1, 0);
+      --from->count_;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::merge_children (Inner *parent, size_t i)
+{
+  Node *const left = parent->children_[i];
+  Node *const right = parent->children_[i + 1];
+
+  if (left->leaf_)
+    {
+      Leaf *const to = static_cast<Leaf *> (left);
+      Leaf *const from = static_cast<Leaf *> (right);
+      move_to (from->entries (), from->count_, to->entries () + to->count_);
+      to->count_ += from->count_;
+      to->next_ = from->next_;
+      if (from->next_ != 0)
+        from->next_->prev_ = to;
+      else
+        this->tail_ = to;
+    }
+  else
+    {
+      // The separator comes down between the keys of the two nodes.
+      Inner *const to = static_cast<Inner *> (left);
+      Inner *const from = static_cast<Inner *> (right);
+      new (to->keys () + to->count_) EXT_ID (std::move (parent->keys ()[i]));
+      move_to (from->keys (), from->count_, to->keys () + to->count_ + 1);
+      for (size_t c = 0; c <= from->count_; ++c)
+        to->children_[to->count_ + 1 + c] = from->children_[c];
+      to->count_ += from->count_ + 1;
+    }
+
+  erase_at (parent->keys (), parent->count_, i);
+  erase_at (parent->children_, parent->count_ + 1, i + 1);
+  --parent->count_;
+  this->allocator_->free (right);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> typename ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Leaf *
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::new_leaf ()
+{
+  void *ptr = 0;
+  ACE_ALLOCATOR_RETURN (ptr, this->allocator_->malloc (sizeof (Leaf)), 0);
+
+  Leaf *const leaf = new (ptr) Leaf;
+  leaf->leaf_ = true;
+  leaf->count_ = 0;
+  leaf->prev_ = 0;
+  leaf->next_ = 0;
+  return leaf;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> typename ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Inner *
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::new_inner ()
+{
+  void *ptr = 0;
+  ACE_ALLOCATOR_RETURN (ptr, this->allocator_->malloc (sizeof (Inner)), 0);
+
+  Inner *const inner = new (ptr) Inner;
+  inner->leaf_ = false;
+  inner->count_ = 0;
+  return inner;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::delete_node (Node *node)
+{
+  if (node->leaf_)
+    {
+      ENTRY *const entries = static_cast<Leaf *> (node)->entries ();
+      for (size_t i = 0; i != node->count_; ++i)
+        entries[i].~ENTRY ();
+    }
+  else
+    {
+      Inner *const inner = static_cast<Inner *> (node);
+      for (size_t i = 0; i <= inner->count_; ++i)
+        this->delete_node (inner->children_[i]);
+      for (size_t i = 0; i != inner->count_; ++i)
+        inner->keys ()[i].~EXT_ID ();
+    }
+  this->allocator_->free (node);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::copy_i (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt)
+{
+  // The entries come in order, so each goes at the end of the last
+  // leaf.
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  for (Leaf *leaf = bt.head_; leaf != 0; leaf = leaf->next_)
+    for (size_t i = 0; i != leaf->count_; ++i)
+      {
+        ENTRY &e = leaf->entries ()[i];
+        if (this->insert_i (e.key (), e.item (), entry) == -1)
+          return -1;
+      }
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::close_i ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::close_i");
+
+  if (this->root_ != 0)
+    this->delete_node (this->root_);
+  this->root_ = 0;
+  this->head_ = 0;
+  this->tail_ = 0;
+  this->current_size_ = 0;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::test_invariant ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::test_invariant");
+  ACE_READ_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  if (this->root_ == 0)
+    {
+      if (this->head_ != 0 || this->tail_ != 0 || this->current_size_ != 0)
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("empty tree with leaves or entries\n")),
+                             -1);
+      return 0;
+    }
+
+  int leaf_depth = -1;
+  size_t entries = 0;
+  if (this->test_invariant_recurse (this->root_, 0, 0, 0, leaf_depth, entries) == -1)
+    return -1;
+
+  if (entries != this->current_size_)
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("%B entries in the leaves, current_size_ %B\n"),
+                          entries,
+                          this->current_size_),
+                         -1);
+
+  // The chain of leaves holds all the entries, in order.
+  size_t chained = 0;
+  Leaf *prev = 0;
+  for (Leaf *leaf = this->head_; leaf != 0; prev = leaf, leaf = leaf->next_)
+    {
+      if (leaf->prev_ != prev)
+        ACELIB_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("broken leaf chain\n")), -1);
+      if (prev != 0
+          && !this->lessthan (prev->entries ()[prev->count_ - 1].key (),
+                              leaf->entries ()[0].key ()))
+        ACELIB_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("leaves out of order\n")), -1);
+      chained += leaf->count_;
+    }
+  if (prev != this->tail_ || chained != this->current_size_)
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("%B entries in the leaf chain, current_size_ %B\n"),
+                          chained,
+                          this->current_size_),
+                         -1);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::test_invariant_recurse (Node *node,
+                                                                           const EXT_ID *lo,
+                                                                           const EXT_ID *hi,
+                                                                           int depth,
+                                                                           int &leaf_depth,
+                                                                           size_t &entries)
+{
+  bool const root = node == this->root_;
+  size_t const count = node->count_;
+
+  if (node->leaf_)
+    {
+      if (leaf_depth == -1)
+        leaf_depth = depth;
+      if (depth != leaf_depth)
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("leaves at depths %d and %d\n"),
+                              leaf_depth,
+                              depth),
+                             -1);
+      if (count > LEAF_MAX || count == 0 || (!root && count < LEAF_MIN))
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("leaf with %B entries\n"),
+                              count),
+                             -1);
+    }
+  else if (count > INNER_MAX || count == 0 || (!root && count < INNER_MIN))
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("inner node with %B keys\n"),
+                         count),
+                        -1);
+
+  for (size_t i = 0; i != count; ++i)
+    {
+      const EXT_ID &key = node->leaf_
+        ? static_cast<Leaf *> (node)->entries ()[i].key ()
+        : static_cast<Inner *> (node)->keys ()[i];
+      if ((lo != 0 && this->lessthan (key, *lo))
+          || (hi != 0 && !this->lessthan (key, *hi)))
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("key out of the bounds of its node\n")),
+                             -1);
+    }
+
+  if (node->leaf_)
+    {
+      Leaf *const leaf = static_cast<Leaf *> (node);
+      for (size_t i = 1; i < count; ++i)
+        if (!this->lessthan (leaf->entries ()[i - 1].key (), leaf->entries ()[i].key ()))
+          ACELIB_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("leaf out of order\n")), -1);
+      entries += count;
+      return 0;
+    }
+
+  Inner *const inner = static_cast<Inner *> (node);
+  EXT_ID *const keys = inner->keys ();
+  for (size_t i = 1; i < count; ++i)
+    if (!this->lessthan (keys[i - 1], keys[i]))
+      ACELIB_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("inner node out of order\n")), -1);
+
+  for (size_t i = 0; i <= count; ++i)
+    if (this->test_invariant_recurse (inner->children_[i],
+                                      i == 0 ? lo : &keys[i - 1],
+                                      i == count ? hi : &keys[i],
+                                      depth + 1,
+                                      leaf_depth,
+                                      entries) == -1)
+      return -1;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+template <class T> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::insert_at (T *a, size_t n, size_t pos, T &&v)
+{
+  if (pos == n)
+    {
+      new (a + n) T (std::move (v));
+      return;
+    }
+
+  new (a + n) T (std::move (a[n - 1]));
+  for (size_t i = n - 1; i > pos; --i)
+    a[i] = std::move (a[i - 1]);
+  a[pos] = std::move (v);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+template <class T> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::erase_at (T *a, size_t n, size_t pos)
+{
+  for (size_t i = pos; i + 1 < n; ++i)
+    a[i] = std::move (a[i + 1]);
+  a[n - 1].~T ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+template <class T> void
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::move_to (T *from, size_t n, T *to)
+{
+  for (size_t i = 0; i != n; ++i)
+    {
+      new (to + i) T (std::move (from[i]));
+      from[i].~T ();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+// template class ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> //
+/////////////////////////////////////////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                          int set_first)
+  : tree_ (&tree),
+    leaf_ (set_first ? tree.head_ : tree.tail_),
+    index_ (0)
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (ACE_BTree, int)");
+  if (!set_first && this->leaf_ != 0)
+    this->index_ = this->leaf_->count_ - 1;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                          ACE_BTree_Entry<EXT_ID, INT_ID> *entry)
+  : tree_ (&tree),
+    leaf_ (0),
+    index_ (0)
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (ACE_BTree, ACE_BTree_Entry)");
+  if (entry != 0)
+    tree.find_i (entry->key (), this->leaf_, this->index_);
+  if (this->leaf_ == 0)
+    this->index_ = 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (const EXT_ID &key,
+                                                                                          ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree)
+  : tree_ (&tree),
+    leaf_ (0),
+    index_ (0)
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (EXT_ID, ACE_BTree)");
+  tree.find_i (key, this->leaf_, this->index_);
+  if (this->leaf_ == 0)
+    this->index_ = 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump_i () const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump_i");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nleaf_ = %@, index_ = %B\n"), this->leaf_, this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* !ACE_BTREE_T_CPP */
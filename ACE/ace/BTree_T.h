@@ -0,0 +1,748 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    BTree_T.h
+ *
+ *  An ordered map kept in a B+ tree, with the interface of
+ *  ACE_RB_Tree.
+ */
+//=============================================================================
+
+#ifndef ACE_BTREE_T_H
+#define ACE_BTREE_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Global_Macros.h"
+#include "ace/Functor_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (ACE_BTREE_NODE_SIZE)
+/// Number of bytes of keys, entries and child pointers an ACE_BTree
+/// node is sized for.  A lookup reads a few cache lines of each node
+/// on its path, so larger nodes make the tree shallower at the cost
+/// of longer moves on insert and unbind.
+# define ACE_BTREE_NODE_SIZE 512
+#endif /* ACE_BTREE_NODE_SIZE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Iterator_Base;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Iterator;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Reverse_Iterator;
+
+// Forward decl.
+class ACE_Allocator;
+
+/**
+ * @class ACE_BTree_Entry
+ *
+ * @brief An entry of an ACE_BTree, stored in place in a leaf.
+ */
+template <class EXT_ID, class INT_ID>
+class ACE_BTree_Entry
+{
+public:
+  /// Constructor.
+  ACE_BTree_Entry (const EXT_ID &k, const INT_ID &t);
+
+  /// Key accessor.
+  EXT_ID &key ();
+
+  /// Read-only key accessor.
+  const EXT_ID &key () const;
+
+  /// Item accessor.
+  INT_ID &item ();
+
+  /// Read-only item accessor.
+  const INT_ID &item () const;
+
+private:
+  /// The key.
+  EXT_ID k_;
+
+  /// The item.
+  INT_ID t_;
+};
+
+/**
+ * @class ACE_BTree
+ *
+ * @brief Implements an ordered map in a B+ tree.
+ *
+ * The entries are kept, in key order, in arrays in the leaves of the
+ * tree, and the leaves are linked so that an iteration walks along
+ * the arrays.  The inner nodes only hold keys and child pointers.
+ * Nodes are sized by ACE_BTREE_NODE_SIZE, so a lookup touches a few
+ * contiguous nodes rather than one node per level of a binary tree,
+ * and the tree holds no per-entry allocation.
+ *
+ * The bind, find, unbind and iteration methods have the signatures
+ * and return values of those of ACE_RB_Tree, so users can switch
+ * with a typedef; the deprecated ACE_RB_Tree methods are not
+ * provided.  COMPARE_KEYS is a less-than function object, as for
+ * ACE_RB_Tree.  Both EXT_ID and INT_ID must be copy constructible
+ * and assignable.
+ *
+ * Iterator stability: entries move within and between nodes when
+ * the tree changes, so a bind, trybind or rebind that adds a key,
+ * and an unbind that removes one, invalidate every entry pointer
+ * and iterator on the tree, including those of entries that stay in
+ * it.  The calls that find the key already there, or do not find it
+ * to unbind, leave them valid, as do finds.  This differs from
+ * ACE_RB_Tree, whose nodes only go away when unbound; to unbind
+ * while iterating, collect the keys first.
+ *
+ * Nodes are allocated with the ACE_Allocator given to the
+ * constructor or to open(), ACE_Allocator::instance() by default.
+ */
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree
+{
+public:
+  friend class ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID KEY;
+  typedef INT_ID VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_BTree_Entry<EXT_ID, INT_ID> ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> ITERATOR;
+  typedef ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> REVERSE_ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> iterator;
+  typedef ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> reverse_iterator;
+
+  /// Constructor.
+  ACE_BTree (ACE_Allocator *alloc = nullptr);
+
+  /// Copy constructor.
+  ACE_BTree (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt);
+
+  /// Initialize a BTree.
+  int open (ACE_Allocator *alloc = nullptr);
+
+  /// Close down a BTree and release dynamically allocated
+  /// resources.
+  int close ();
+
+  /// Destructor.
+  ~ACE_BTree ();
+
+  // = insertion, removal, and search methods.
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is already in the
+   * tree then the entry is not changed.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an attempt is made to bind an
+   * existing entry, and returns -1 if failures occur.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id);
+
+  /**
+   * Same as a normal bind, except the tree entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id,
+            ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is not
+   * in the tree.  If @a ext_id is already in the tree then the @a int_id
+   * parameter is assigned the existing value in the tree.  Returns 0
+   * if a new entry is bound successfully, returns 1 if an attempt is
+   * made to bind an existing entry, and returns -1 if failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /**
+   * Same as a normal trybind, except the tree entry is also passed
+   * back to the caller.  The entry in this case will either be the
+   * newly created entry, or the existing one.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id,
+               ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Reassociate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * tree then behaves just like <bind>.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an existing entry was rebound,
+   * and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /**
+   * Same as a normal rebind, except the tree entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the tree
+   * then behaves just like <bind>.  Otherwise, store the old value of
+   * @a int_id into the "out" parameter and rebind the new parameters.
+   * Returns 0 if a new entry is bound successfully, returns 1 if an
+   * existing entry was rebound, and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the tree entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id,
+              ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the tree
+   * then behaves just like <bind>.  Otherwise, store the old values
+   * of @a ext_id and @a int_id into the "out" parameters and rebind the
+   * new parameters.  Returns 0 if a new entry is bound successfully,
+   * returns 1 if an existing entry was rebound, and returns -1 if
+   * failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the tree entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id,
+              ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Locate @a ext_id and pass out parameter via @a int_id.  If found,
+  /// return 0, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Locate @a ext_id and pass out parameter via @a entry.  If found,
+  /// return 0, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            ACE_BTree_Entry<EXT_ID, INT_ID> *&entry) const;
+
+  /**
+   * Unbind (remove) the @a ext_id from the tree.  Don't return the
+   * @a int_id to the caller (this is useful for collections where the
+   * @c int_ids are *not* dynamically allocated...)
+   */
+  int unbind (const EXT_ID &ext_id);
+
+  /// Break any association of @a ext_id.  Returns the value of @a int_id
+  /// in case the caller needs to deallocate memory.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Remove @a entry, which must be in the tree, from the tree.
+  int unbind (ACE_BTree_Entry<EXT_ID, INT_ID> *entry);
+
+  // = Public helper methods.
+
+  /// Returns the current number of entries in the tree.
+  size_t current_size () const;
+
+  /// Assignment operator.
+  void operator= (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt);
+
+  /**
+   * Returns a reference to the underlying <ACE_LOCK>.  This makes it
+   * possible to acquire the lock explicitly, which can be useful if
+   * you need to guard the state of an iterator.
+   */
+  ACE_LOCK &mutex ();
+
+  /// Get the allocator.
+  ACE_Allocator *allocator () const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator positioned at first entry in tree.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> begin ();
+
+  /// Return forward iterator positioned past the last entry in tree.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> end ();
+
+  /// Return reverse iterator positioned at last entry in tree.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> rbegin ();
+
+  /// Return reverse iterator positioned before the first entry in
+  /// tree.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> rend ();
+
+  /// Return forward iterator positioned at the first entry whose key
+  /// is not less than @a ext_id, to scan a range of keys.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> lower_bound (const EXT_ID &ext_id);
+
+  /// Tests that the keys are in order, that the nodes are filled
+  /// within their bounds, and that all the leaves are at the same
+  /// depth.  Returns 0 if the invariant holds, else -1.  This method
+  /// visits every node, and should only be called for testing
+  /// purposes.
+  int test_invariant ();
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Header shared by the leaves and the inner nodes.
+  struct Node
+  {
+    /// True for a leaf.
+    bool leaf_;
+
+    /// Number of entries of a leaf, of keys of an inner node.
+    size_t count_;
+  };
+
+  /// Maximum number of entries of a leaf.
+  static constexpr size_t LEAF_MAX =
+    ACE_BTREE_NODE_SIZE / sizeof (ENTRY) < 4
+      ? 4 : ACE_BTREE_NODE_SIZE / sizeof (ENTRY);
+
+  /// Minimum number of entries of a leaf other than the root.
+  static constexpr size_t LEAF_MIN = LEAF_MAX / 2;
+
+  /// Deepest a tree can get: below the root, every inner node has at
+  /// least two children.
+  static constexpr size_t MAX_DEPTH = sizeof (size_t) * 8;
+
+  /// Maximum number of keys of an inner node; it has one child more.
+  static constexpr size_t INNER_MAX =
+    ACE_BTREE_NODE_SIZE / (sizeof (EXT_ID) + sizeof (Node *)) < 3
+      ? 3 : ACE_BTREE_NODE_SIZE / (sizeof (EXT_ID) + sizeof (Node *));
+
+  /// Minimum number of keys of an inner node other than the root.
+  static constexpr size_t INNER_MIN = (INNER_MAX - 1) / 2;
+
+  /// A leaf: entries in key order, linked to its neighbours.
+  struct Leaf : Node
+  {
+    ENTRY *entries () { return reinterpret_cast<ENTRY *> (this->storage_); }
+
+    Leaf *prev_;
+    Leaf *next_;
+    alignas (ENTRY) unsigned char storage_[LEAF_MAX * sizeof (ENTRY)];
+  };
+
+  /// An inner node: child i holds the keys less than key i and not
+  /// less than key i - 1.
+  struct Inner : Node
+  {
+    EXT_ID *keys () { return reinterpret_cast<EXT_ID *> (this->storage_); }
+
+    Node *children_[INNER_MAX + 1];
+    alignas (EXT_ID) unsigned char storage_[INNER_MAX * sizeof (EXT_ID)];
+  };
+
+  // = Protected methods. These should only be called with locks held.
+
+  /// Returns 1 if @a k1 < @a k2, else 0.
+  int lessthan (const EXT_ID &k1, const EXT_ID &k2) const;
+
+  /// Index of the first entry of @a leaf whose key is not less than
+  /// @a k.
+  size_t lower_bound_i (Leaf *leaf, const EXT_ID &k) const;
+
+  /// Index of the child of @a inner that holds @a k.
+  size_t child_index (Inner *inner, const EXT_ID &k) const;
+
+  /// Returns the leaf that holds or would hold @a k, passing back the
+  /// inner nodes on the way down in @a path and the index of the
+  /// child taken in each in @a slots, @a depth of them.
+  Leaf *descend_i (const EXT_ID &k,
+                   Inner *path[],
+                   size_t slots[],
+                   size_t &depth) const;
+
+  /// Leaf and index of @a k, with @a leaf set to 0 when @a k is not
+  /// in the tree.
+  void find_i (const EXT_ID &k, Leaf *&leaf, size_t &index) const;
+
+  /// Performs bind, passing back the new or existing entry.  Returns
+  /// 0 if a new entry was bound, 1 if @a k was already in the tree,
+  /// -1 on failure, in which case the tree is left unchanged.
+  int insert_i (const EXT_ID &k,
+                const INT_ID &t,
+                ACE_BTree_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Removes @a k, passing its item back through @a t unless it is
+  /// 0.  Returns 0 if @a k was removed, -1 if it was not in the
+  /// tree.
+  int remove_i (const EXT_ID &k, INT_ID *t);
+
+  /// Move the last entry or key of child @a i - 1 of @a parent to
+  /// child @a i.
+  void borrow_left (Inner *parent, size_t i);
+
+  /// Move the first entry or key of child @a i + 1 of @a parent to
+  /// child @a i.
+  void borrow_right (Inner *parent, size_t i);
+
+  /// Merge child @a i + 1 of @a parent into child @a i, removing
+  /// key @a i from @a parent.
+  void merge_children (Inner *parent, size_t i);
+
+  /// Allocate an empty leaf, 0 on failure.
+  Leaf *new_leaf ();
+
+  /// Allocate an inner node without keys, 0 on failure.
+  Inner *new_inner ();
+
+  /// Destroy @a node and the nodes below it.
+  void delete_node (Node *node);
+
+  /// Copy the entries of @a bt.
+  int copy_i (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &bt);
+
+  /// Close down a tree.
+  int close_i ();
+
+  /// Recursive part of test_invariant(), checking that the keys of
+  /// @a node are within [@a lo, @a hi), either bound being 0 for
+  /// none.  @a depth is that of @a node, @a leaf_depth that of the
+  /// leaves, -1 until a leaf was seen.
+  int test_invariant_recurse (Node *node,
+                              const EXT_ID *lo,
+                              const EXT_ID *hi,
+                              int depth,
+                              int &leaf_depth,
+                              size_t &entries);
+
+  /// Make room at @a pos in the @a n constructed objects of @a a, a
+  /// raw array with room for one more, and move @a v there.
+  template <class T>
+  static void insert_at (T *a, size_t n, size_t pos, T &&v);
+
+  /// Remove the object at @a pos from the @a n constructed objects
+  /// of @a a, destroying the last one.
+  template <class T>
+  static void erase_at (T *a, size_t n, size_t pos);
+
+  /// Move the @a n objects at @a from to the raw array @a to,
+  /// destroying them at @a from.
+  template <class T>
+  static void move_to (T *from, size_t n, T *to);
+
+private:
+  /// Pointer to a memory allocator.
+  ACE_Allocator *allocator_;
+
+  /// Synchronization variable for the MT_SAFE ACE_BTree.
+  mutable ACE_LOCK lock_;
+
+  /// The root of the tree, 0 when it is empty.
+  Node *root_;
+
+  /// The leftmost leaf.
+  Leaf *head_;
+
+  /// The rightmost leaf.
+  Leaf *tail_;
+
+  /// Comparison functor for comparing nodes in the tree.
+  COMPARE_KEYS compare_keys_;
+
+  /// The current number of entries in the tree.
+  size_t current_size_;
+};
+
+/**
+ * @class ACE_BTree_Iterator_Base
+ *
+ * @brief Implements a common base class for iterators for an
+ * ACE_BTree.
+ *
+ * An iterator is a leaf and an index in it.  It is invalidated by
+ * the changes of the tree listed in ACE_BTree.
+ */
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Iterator_Base
+{
+public:
+  // = Iteration methods.
+
+  /// Returns 1 when the iteration has completed, otherwise 0.
+  int done () const;
+
+  /// STL-like iterator dereference operator: returns a reference
+  /// to the entry underneath the iterator.
+  ACE_BTree_Entry<EXT_ID, INT_ID> & operator* () const;
+
+  /// STL-like iterator dereference operator: returns a pointer
+  /// to the entry underneath the iterator.
+  ACE_BTree_Entry<EXT_ID, INT_ID> * operator-> () const;
+
+  /// Returns a const reference to the tree over which we're iterating.
+  const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree ();
+
+  /// Comparison operator: returns true if both iterators point to the same position.
+  bool operator== (const ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Comparison operator: returns true if the iterators point to different positions.
+  bool operator!= (const ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  typedef typename ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Leaf Leaf;
+
+  /// Create the singular iterator.
+  ACE_BTree_Iterator_Base ();
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and
+   * an integer indicating (if non-zero) to position the iterator
+   * at the first element in the tree (if this integer is 0, the
+   * iterator is positioned at the last element in the tree).
+   */
+  ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                           int set_first);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and
+   * a pointer to an entry in the tree.
+   */
+  ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                           ACE_BTree_Entry<EXT_ID, INT_ID> *entry);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and a key.
+   * The key must come first to distinguish the case of EXT_ID == int.
+   */
+  ACE_BTree_Iterator_Base (const EXT_ID &key,
+                           ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree);
+
+  /// Constructor, positioned on entry @a index of @a leaf.
+  ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                           Leaf *leaf,
+                           size_t index);
+
+  // = Internal methods
+
+  /// Move forward by one element in the tree.  Returns 0 when
+  /// there are no more elements in the tree, otherwise 1.
+  int forward_i ();
+
+  /// Move back by one element in the tree.  Returns 0 when
+  /// there are no more elements in the tree, otherwise 1.
+  int reverse_i ();
+
+  /// Dump the state of an object.
+  void dump_i () const;
+
+  // = Protected members.
+
+  /// Reference to the ACE_BTree over which we're iterating.
+  const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> *tree_;
+
+  /// Leaf of the entry under the iterator, 0 when done.
+  Leaf *leaf_;
+
+  /// Index of the entry under the iterator in its leaf.
+  size_t index_;
+};
+
+/**
+ * @class ACE_BTree_Iterator
+ *
+ * @brief Implements an iterator for an ACE_BTree.
+ */
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Iterator : public ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  /**
+   * Create the singular iterator.
+   * It is illegal to deference the iterator, no valid iterator is
+   * equal to a singular iterator, etc. etc.
+   */
+  ACE_BTree_Iterator ();
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and
+   * an integer indicating (if non-zero) to position the iterator
+   * at the first element in the tree (if this integer is 0, the
+   * iterator is positioned at the last element in the tree).
+   */
+  ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                      int set_first = 1);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate
+   * and a pointer to an entry in the tree.
+   */
+  ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                      ACE_BTree_Entry<EXT_ID, INT_ID> *entry);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and a key;
+   * the key comes first in order to distinguish the case of EXT_ID == int.
+   */
+  ACE_BTree_Iterator (const EXT_ID &key,
+                      ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree);
+
+  // = ACE-style iteration methods.
+
+  /// Move forward by one element in the tree.  Returns
+  /// 0 when all elements have been seen, else 1.
+  int advance ();
+
+  /// Passes back the <entry> under the iterator.  Returns 0 if
+  /// the iteration has completed, otherwise 1.
+  int next (ACE_BTree_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL-style iteration methods.
+
+  /// Prefix advance.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> & operator++ ();
+
+  /// Postfix advance.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> & operator-- ();
+
+  /// Postfix reverse.
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  friend class ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>;
+
+  /// Constructor, positioned on entry @a index of @a leaf.
+  ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                      typename ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Leaf *leaf,
+                      size_t index);
+};
+
+/**
+ * @class ACE_BTree_Reverse_Iterator
+ *
+ * @brief Implements a reverse iterator for an ACE_BTree.
+ */
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_BTree_Reverse_Iterator : public ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  /**
+   * Create the singular iterator.
+   * It is illegal to deference the iterator, no valid iterator is
+   * equal to a singular iterator, etc. etc.
+   */
+  ACE_BTree_Reverse_Iterator ();
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and
+   * an integer indicating (if non-zero) to position the iterator
+   * at the last element in the tree (if this integer is 0, the
+   * iterator is positioned at the first element in the tree).
+   */
+  ACE_BTree_Reverse_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                              int set_last = 1);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and
+   * a pointer to an entry in the tree.
+   */
+  ACE_BTree_Reverse_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                              ACE_BTree_Entry<EXT_ID, INT_ID> *entry);
+
+  /**
+   * Constructor.  Takes an ACE_BTree over which to iterate, and a key;
+   * the key comes first in order to distinguish the case of EXT_ID == int.
+   */
+  ACE_BTree_Reverse_Iterator (const EXT_ID &key,
+                              ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree);
+
+  // = ACE-style iteration methods.
+
+  /// Move forward by one element in the tree.  Returns
+  /// 0 when all elements have been seen, else 1.
+  int advance ();
+
+  /// Passes back the <entry> under the iterator.  Returns 0 if
+  /// the iteration has completed, otherwise 1.
+  int next (ACE_BTree_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL-style iteration methods.
+
+  /// Prefix advance.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> & operator++ ();
+
+  /// Postfix advance.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> & operator-- ();
+
+  /// Postfix reverse.
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/BTree_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/BTree_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("BTree_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_BTREE_T_H */
@@ -0,0 +1,634 @@
+// -*- C++ -*-
+#include "ace/Guard_T.h"
+#include "ace/Malloc_Base.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+//////////////////////////////////////////////////
+// template class ACE_BTree_Entry<EXT_ID, INT_ID> //
+//////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID> ACE_INLINE
+ACE_BTree_Entry<EXT_ID, INT_ID>::ACE_BTree_Entry (const EXT_ID &k, const INT_ID &t)
+  : k_ (k),
+    t_ (t)
+{
+}
+
+template <class EXT_ID, class INT_ID> ACE_INLINE EXT_ID &
+ACE_BTree_Entry<EXT_ID, INT_ID>::key ()
+{
+  return this->k_;
+}
+
+template <class EXT_ID, class INT_ID> ACE_INLINE const EXT_ID &
+ACE_BTree_Entry<EXT_ID, INT_ID>::key () const
+{
+  return this->k_;
+}
+
+template <class EXT_ID, class INT_ID> ACE_INLINE INT_ID &
+ACE_BTree_Entry<EXT_ID, INT_ID>::item ()
+{
+  return this->t_;
+}
+
+template <class EXT_ID, class INT_ID> ACE_INLINE const INT_ID &
+ACE_BTree_Entry<EXT_ID, INT_ID>::item () const
+{
+  return this->t_;
+}
+
+////////////////////////////////////////////////////////////////////////
+// template class ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> //
+////////////////////////////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree (ACE_Allocator *alloc)
+  : allocator_ (alloc),
+    root_ (0),
+    head_ (0),
+    tail_ (0),
+    current_size_ (0)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree");
+  if (this->allocator_ == 0)
+    this->allocator_ = ACE_Allocator::instance ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::~ACE_BTree ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::~ACE_BTree");
+
+  // Use the locked close method to prevent interference from other
+  // threads.
+  this->close ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::open (ACE_Allocator *alloc)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::open");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // Calling this->close_i () ensures we release previously allocated
+  // memory before allocating new memory.
+  this->close_i ();
+
+  if (alloc == 0)
+    alloc = ACE_Allocator::instance ();
+
+  this->allocator_ = alloc;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::close ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::close");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  return this->close_i ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::bind (const EXT_ID &ext_id,
+                                                         const INT_ID &int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::bind (const EXT_ID &, const INT_ID &)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  return this->insert_i (ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::bind (const EXT_ID &ext_id,
+                                                         const INT_ID &int_id,
+                                                         ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::bind (const EXT_ID &, const INT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  return this->insert_i (ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::trybind (const EXT_ID &ext_id,
+                                                            INT_ID &int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::trybind (const EXT_ID &, INT_ID &)");
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  return this->trybind (ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::trybind (const EXT_ID &ext_id,
+                                                            INT_ID &int_id,
+                                                            ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::trybind (const EXT_ID &, INT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->insert_i (ext_id, int_id, entry);
+  if (result == 1)
+    int_id = entry->item ();
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &)");
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  return this->rebind (ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id,
+                                                           ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->insert_i (ext_id, int_id, entry);
+  if (result == 1)
+    entry->item () = int_id;
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id,
+                                                           INT_ID &old_int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &, INT_ID &)");
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  return this->rebind (ext_id, int_id, old_int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id,
+                                                           INT_ID &old_int_id,
+                                                           ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &, INT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->insert_i (ext_id, int_id, entry);
+  if (result == 1)
+    {
+      old_int_id = entry->item ();
+      entry->item () = int_id;
+    }
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id,
+                                                           EXT_ID &old_ext_id,
+                                                           INT_ID &old_int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &, EXT_ID &, INT_ID &)");
+  ACE_BTree_Entry<EXT_ID, INT_ID> *entry = 0;
+  return this->rebind (ext_id, int_id, old_ext_id, old_int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                           const INT_ID &int_id,
+                                                           EXT_ID &old_ext_id,
+                                                           INT_ID &old_int_id,
+                                                           ACE_BTree_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &, const INT_ID &, EXT_ID &, INT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->insert_i (ext_id, int_id, entry);
+  if (result == 1)
+    {
+      old_ext_id = entry->key ();
+      old_int_id = entry->item ();
+      entry->key () = ext_id;
+      entry->item () = int_id;
+    }
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::find (const EXT_ID &ext_id,
+                                                         INT_ID &int_id) const
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::find (const EXT_ID &, INT_ID &)");
+  ACE_READ_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  Leaf *leaf = 0;
+  size_t index = 0;
+  this->find_i (ext_id, leaf, index);
+  if (leaf == 0)
+    return -1;
+
+  int_id = leaf->entries ()[index].item ();
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::find (const EXT_ID &ext_id,
+                                                         ACE_BTree_Entry<EXT_ID, INT_ID> *&entry) const
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::find (const EXT_ID &, ACE_BTree_Entry<EXT_ID, INT_ID> *&)");
+  ACE_READ_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  Leaf *leaf = 0;
+  size_t index = 0;
+  this->find_i (ext_id, leaf, index);
+  if (leaf == 0)
+    return -1;
+
+  entry = leaf->entries () + index;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (const EXT_ID &ext_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (const EXT_ID &)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  return this->remove_i (ext_id, 0);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (const EXT_ID &ext_id,
+                                                           INT_ID &int_id)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (const EXT_ID &, INT_ID &)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  return this->remove_i (ext_id, &int_id);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (ACE_BTree_Entry<EXT_ID, INT_ID> *entry)
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::unbind (ACE_BTree_Entry<EXT_ID, INT_ID> *)");
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // The entry is destroyed on the way, so keep its key.
+  EXT_ID const key (entry->key ());
+  return this->remove_i (key, 0);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE size_t
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::current_size () const
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::current_size");
+  return this->current_size_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_LOCK &
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::mutex ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::mutex");
+  return this->lock_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_Allocator *
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::allocator () const
+{
+  return this->allocator_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::begin ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::begin");
+  return ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (*this);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::end ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::end");
+  return ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rbegin ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rbegin");
+  return ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (*this);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rend ()
+{
+  ACE_TRACE ("ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::rend");
+  return ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::lessthan (const EXT_ID &k1, const EXT_ID &k2) const
+{
+  return this->compare_keys_ (k1, k2);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+// template class ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> //
+/////////////////////////////////////////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base ()
+  : tree_ (0),
+    leaf_ (0),
+    index_ (0)
+{
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator_Base (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                          Leaf *leaf,
+                                                                                          size_t index)
+  : tree_ (&tree),
+    leaf_ (leaf),
+    index_ (index)
+{
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::done () const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::done");
+  return this->leaf_ == 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Entry<EXT_ID, INT_ID> &
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator* () const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator*");
+  return this->leaf_->entries ()[this->index_];
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Entry<EXT_ID, INT_ID> *
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-> () const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator->");
+  return this->leaf_->entries () + this->index_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::tree ()
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::tree");
+  return *this->tree_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE bool
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator== (const ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &rbt) const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator==");
+  return this->leaf_ == rbt.leaf_ && this->index_ == rbt.index_;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE bool
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator!= (const ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &rbt) const
+{
+  ACE_TRACE ("ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator!=");
+  return !(*this == rbt);
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::forward_i ()
+{
+  if (this->leaf_ == 0)
+    return 0;
+
+  if (++this->index_ == this->leaf_->count_)
+    {
+      this->leaf_ = this->leaf_->next_;
+      this->index_ = 0;
+    }
+  return this->leaf_ != 0;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::reverse_i ()
+{
+  if (this->leaf_ == 0)
+    return 0;
+
+  if (this->index_ == 0)
+    {
+      this->leaf_ = this->leaf_->prev_;
+      this->index_ = this->leaf_ == 0 ? 0 : this->leaf_->count_ - 1;
+    }
+  else
+    --this->index_;
+  return this->leaf_ != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// template class ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> //
+////////////////////////////////////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator ()
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                int set_first)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (tree, set_first)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                ACE_BTree_Entry<EXT_ID, INT_ID> *entry)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (tree, entry)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator (const EXT_ID &key,
+                                                                                ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (key, tree)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                typename ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::Leaf *leaf,
+                                                                                size_t index)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (tree, leaf, index)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::advance ()
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::advance");
+  return this->forward_i ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::next (ACE_BTree_Entry<EXT_ID, INT_ID> *&next_entry) const
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::next");
+  if (this->leaf_ == 0)
+    return 0;
+
+  next_entry = this->leaf_->entries () + this->index_;
+  return 1;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE void
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump");
+  this->dump_i ();
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ ()
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ ()");
+  this->forward_i ();
+  return *this;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ (int)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ (int)");
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> retv (*this);
+  this->forward_i ();
+  return retv;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- ()
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- ()");
+  this->reverse_i ();
+  return *this;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- (int)
+{
+  ACE_TRACE ("ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- (int)");
+  ACE_BTree_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> retv (*this);
+  this->reverse_i ();
+  return retv;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// template class ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> //
+////////////////////////////////////////////////////////////////////////////////////////
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator ()
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                                int set_last)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (tree, set_last ? 0 : 1)
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator (const ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree,
+                                                                                                ACE_BTree_Entry<EXT_ID, INT_ID> *entry)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (tree, entry)
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator (const EXT_ID &key,
+                                                                                                ACE_BTree<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &tree)
+  : ACE_BTree_Iterator_Base<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> (key, tree)
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::ACE_BTree_Reverse_Iterator");
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::advance ()
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::advance");
+  return this->reverse_i ();
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::next (ACE_BTree_Entry<EXT_ID, INT_ID> *&next_entry) const
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::next");
+  if (this->leaf_ == 0)
+    return 0;
+
+  next_entry = this->leaf_->entries () + this->index_;
+  return 1;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE void
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::dump");
+  this->dump_i ();
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ ()
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ ()");
+  this->reverse_i ();
+  return *this;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ (int)
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator++ (int)");
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> retv (*this);
+  this->reverse_i ();
+  return retv;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> &
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- ()
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- ()");
+  this->forward_i ();
+  return *this;
+}
+
+template <class EXT_ID, class INT_ID, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>
+ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- (int)
+{
+  ACE_TRACE ("ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK>::operator-- (int)");
+  ACE_BTree_Reverse_Iterator<EXT_ID, INT_ID, COMPARE_KEYS, ACE_LOCK> retv (*this);
+  this->forward_i ();
+  return retv;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
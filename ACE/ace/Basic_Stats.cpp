@@ -37,6 +37,11 @@ ACE_Basic_Stats::accumulate (const ACE_Basic_Stats &rhs)
 
   this->samples_count_ += rhs.samples_count_;
   this->sum_ += rhs.sum_;
+
+  if (this->histogram_ != 0
+      && rhs.histogram_ != 0
+      && this->histogram_ != rhs.histogram_)
+    this->histogram_->add (*rhs.histogram_);
 }
 
 void
@@ -65,6 +70,9 @@ ACE_Basic_Stats::dump_results (
               l_avg,
               l_max, this->max_at_));
 
+  if (this->histogram_ != 0)
+    this->histogram_->dump_results (msg, sf);
+
 #else
   ACE_UNUSED_ARG (msg);
   ACE_UNUSED_ARG (sf);
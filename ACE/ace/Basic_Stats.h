@@ -13,6 +13,7 @@
 
 #include /**/ "ace/config-all.h"
 #include "ace/Basic_Types.h"
+#include "ace/HDR_Histogram.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -61,6 +62,17 @@ public:
   void dump_results (const ACE_TCHAR *msg,
                      scale_factor_type scale_factor) const;
 
+  /// Also record the samples in @a histogram
+  /**
+   * The histogram is not owned, and may be shared.  accumulate() adds
+   * the histogram of @a rhs to this one, and dump_results() prints
+   * its percentiles.  Pass 0 to stop recording.
+   */
+  void histogram (ACE_HDR_Histogram *histogram);
+
+  /// The histogram the samples are recorded in, if any
+  ACE_HDR_Histogram *histogram () const;
+
   /// The number of samples
   ACE_UINT32 samples_count_;
 
@@ -78,6 +90,9 @@ public:
 
   /// The sum of all the values
   ACE_UINT64 sum_;
+
+  /// The histogram the samples are recorded in, if any
+  ACE_HDR_Histogram *histogram_;
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
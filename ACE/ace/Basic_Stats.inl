@@ -9,6 +9,7 @@ ACE_Basic_Stats::ACE_Basic_Stats ()
   , max_ (0)
   , max_at_ (0)
   , sum_ (0)
+  , histogram_ (0)
 {
 }
 
@@ -45,6 +46,21 @@ ACE_Basic_Stats::sample (ACE_UINT64 value)
     }
 
   this->sum_ += value;
+
+  if (this->histogram_ != 0)
+    this->histogram_->record (value);
+}
+
+ACE_INLINE void
+ACE_Basic_Stats::histogram (ACE_HDR_Histogram *histogram)
+{
+  this->histogram_ = histogram;
+}
+
+ACE_INLINE ACE_HDR_Histogram *
+ACE_Basic_Stats::histogram () const
+{
+  return this->histogram_;
 }
 
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -77,30 +77,6 @@ ACE_SizeCDR::write_wchar (ACE_CDR::WChar x)
   return this->write_1 (reinterpret_cast<const ACE_CDR::Octet *> (&ox));
 }
 
-ACE_CDR::Boolean
-ACE_SizeCDR::write_string (ACE_CDR::ULong len,
-                             const ACE_CDR::Char *x)
-{
-  // Note: translator framework is not supported.
-  //
-  if (len != 0)
-    {
-      if (this->write_ulong (len + 1))
-        return this->write_char_array (x, len + 1);
-    }
-  else
-    {
-      // Be nice to programmers: treat nulls as empty strings not
-      // errors. (OMG-IDL supports languages that don't use the C/C++
-      // notion of null v. empty strings; nulls aren't part of the OMG-IDL
-      // string model.)
-      if (this->write_ulong (1))
-        return this->write_char (0);
-    }
-
-  return (this->good_bit_ = false);
-}
-
 ACE_CDR::Boolean
 ACE_SizeCDR::write_string (const ACE_CString &x)
 {
@@ -158,34 +134,6 @@ ACE_SizeCDR::write_wstring (ACE_CDR::ULong len,
    return (this->good_bit_ = false);
 }
 
-ACE_CDR::Boolean
-ACE_SizeCDR::write_1 (const ACE_CDR::Octet *)
-{
-  this->adjust (1);
-  return true;
-}
-
-ACE_CDR::Boolean
-ACE_SizeCDR::write_2 (const ACE_CDR::UShort *)
-{
-  this->adjust (ACE_CDR::SHORT_SIZE);
-  return true;
-}
-
-ACE_CDR::Boolean
-ACE_SizeCDR::write_4 (const ACE_CDR::ULong *)
-{
-  this->adjust (ACE_CDR::LONG_SIZE);
-  return true;
-}
-
-ACE_CDR::Boolean
-ACE_SizeCDR::write_8 (const ACE_CDR::ULongLong *)
-{
-  this->adjust (ACE_CDR::LONGLONG_SIZE);
-  return true;
-}
-
 ACE_CDR::Boolean
 ACE_SizeCDR::write_16 (const ACE_CDR::LongDouble *)
 {
@@ -211,43 +159,17 @@ ACE_SizeCDR::write_wchar_array_i (const ACE_CDR::WChar *,
 
 
 ACE_CDR::Boolean
-ACE_SizeCDR::write_array (const void *,
-                          size_t size,
-                          size_t align,
-                          ACE_CDR::ULong length)
-{
-  if (length == 0)
-    return true;
-
-  this->adjust (size * length, align);
-  return true;
-}
-
-ACE_CDR::Boolean
-ACE_SizeCDR::write_boolean_array (const ACE_CDR::Boolean*,
-                                  ACE_CDR::ULong length)
+ACE_SizeCDR::write_octet_array_mb (const ACE_Message_Block* mb)
 {
-  this->adjust (length, 1);
+  for (const ACE_Message_Block* i = mb;
+       i != 0;
+       i = i->cont ())
+    {
+      this->adjust (i->length (), ACE_CDR::OCTET_ALIGN);
+    }
   return true;
 }
 
-void
-ACE_SizeCDR::adjust (size_t size)
-{
-  adjust (size, size);
-}
-
-void
-ACE_SizeCDR::adjust (size_t size,
-                     size_t align)
-{
-#if !defined (ACE_LACKS_CDR_ALIGNMENT)
-  const size_t offset = ACE_align_binary (size_, align) - size_;
-  size_ += offset;
-#endif /* ACE_LACKS_CDR_ALIGNMENT */
-  size_ += size;
-}
-
 ACE_CDR::Boolean
 operator<< (ACE_SizeCDR &ss, const ACE_CString &x)
 {
@@ -115,6 +115,10 @@ public:
   ACE_CDR::Boolean write_longdouble_array (const ACE_CDR::LongDouble* x,
                                            ACE_CDR::ULong length);
 
+  /// Count the octets in the chain of message blocks @a mb, as
+  /// ACE_OutputCDR::write_octet_array_mb() writes them.
+  ACE_CDR::Boolean write_octet_array_mb (const ACE_Message_Block* mb);
+
   ///
   /// Adjust to @a size and count @a size octets.
   void adjust (size_t size);
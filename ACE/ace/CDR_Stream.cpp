@@ -2,6 +2,7 @@
 #include "ace/SString.h"
 #include "ace/Auto_Ptr.h"
 #include "ace/Truncate.h"
+#include "ace/Transcode.h"
 
 #if !defined (__ACE_INLINE__)
 # include "ace/CDR_Stream.inl"
@@ -176,6 +177,27 @@ ACE_OutputCDR::grow_and_adjust (size_t size,
                                 size_t align,
                                 char*& buf)
 {
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  ACE_Message_Block * const next = this->current_->cont ();
+  if (this->current_is_writable_
+      && next != 0
+      && next->length () == 0)
+    {
+      // An empty block after the current one was added by reserve(),
+      // when the stream was at another alignment than it is now.
+      next->reset ();
+      ptrdiff_t const nextalign =
+        reinterpret_cast<ptrdiff_t> (next->rd_ptr ()) % ACE_CDR::MAX_ALIGNMENT;
+      ptrdiff_t const curalign =
+        static_cast<ptrdiff_t> (this->current_alignment_) % ACE_CDR::MAX_ALIGNMENT;
+      ptrdiff_t offset = curalign - nextalign;
+      if (offset < 0)
+        offset += ACE_CDR::MAX_ALIGNMENT;
+      next->rd_ptr (static_cast<size_t> (offset));
+      next->wr_ptr (next->rd_ptr ());
+    }
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
   if (!this->current_is_writable_
       || this->current_->cont () == 0
       || this->current_->cont ()->size () < size + ACE_CDR::MAX_ALIGNMENT)
@@ -249,6 +271,76 @@ ACE_OutputCDR::grow_and_adjust (size_t size,
   return this->adjust (size, align, buf);
 }
 
+int
+ACE_OutputCDR::reserve (size_t size)
+{
+  size_t blocksize = size;
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  blocksize += ACE_CDR::MAX_ALIGNMENT;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  if (this->current_is_writable_
+      && this->current_->space () >= blocksize)
+    return 0;
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // The block is aligned again when writing moves on to it.
+  blocksize += ACE_CDR::MAX_ALIGNMENT;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  this->good_bit_ = false;
+  ACE_Message_Block* tmp = 0;
+  ACE_NEW_RETURN (tmp,
+                  ACE_Message_Block (blocksize,
+                                     ACE_Message_Block::MB_DATA,
+                                     0,
+                                     0,
+                                     this->current_->data_block ()->allocator_strategy (),
+                                     0,
+                                     0,
+                                     ACE_Time_Value::zero,
+                                     ACE_Time_Value::max_time,
+                                     this->current_->data_block ()->data_block_allocator ()),
+                  -1);
+
+  if (tmp != 0 && tmp->size () < blocksize)
+    {
+      delete tmp;
+      errno = ENOMEM;
+      return -1;
+    }
+
+  this->good_bit_ = true;
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // The new block must start with the same alignment as the
+  // stream.
+  ptrdiff_t const tmpalign =
+    reinterpret_cast<ptrdiff_t> (tmp->rd_ptr ()) % ACE_CDR::MAX_ALIGNMENT;
+  ptrdiff_t const curalign =
+    static_cast<ptrdiff_t> (this->current_alignment_) % ACE_CDR::MAX_ALIGNMENT;
+  ptrdiff_t offset = curalign - tmpalign;
+  if (offset < 0)
+    offset += ACE_CDR::MAX_ALIGNMENT;
+  tmp->rd_ptr (static_cast<size_t> (offset));
+  tmp->wr_ptr (tmp->rd_ptr ());
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  tmp->cont (this->current_->cont ());
+  this->current_->cont (tmp);
+
+  // Fill the rest of a writable block first; grow_and_adjust() moves
+  // on to the reserved block when a write does not fit anymore.
+  if (!this->current_is_writable_)
+    {
+      this->current_ = tmp;
+      this->current_is_writable_ = true;
+    }
+
+  return 0;
+}
+
 ACE_CDR::Boolean
 ACE_OutputCDR::write_wchar (ACE_CDR::WChar x)
 {
@@ -592,18 +684,10 @@ ACE_OutputCDR::write_wchar_array_i (const ACE_CDR::WChar *x,
     {
       if (ACE_OutputCDR::wchar_maxbytes_ == 2)
         {
-          ACE_CDR::UShort *sb = reinterpret_cast<ACE_CDR::UShort *> (buf);
-          for (size_t i = 0; i < length; ++i)
 #if !defined (ACE_ENABLE_SWAP_ON_WRITE)
-            sb[i] = static_cast<ACE_CDR::UShort> (x[i]);
+          ACE_Transcode::wchar_to_utf16 (x, length, buf, false);
 #else
-              if (!this->do_byte_swap_)
-              sb[i] = static_cast<ACE_CDR::UShort> (x[i]);
-            else
-              {
-                ACE_CDR::UShort sx = static_cast<ACE_CDR::UShort> (x[i]);
-                ACE_CDR::swap_2 (reinterpret_cast<char *> (&sx), &buf[i * 2]);
-              }
+          ACE_Transcode::wchar_to_utf16 (x, length, buf, this->do_byte_swap_);
 #endif /* ACE_ENABLE_SWAP_ON_WRITE */
         }
       else
@@ -1869,19 +1953,10 @@ ACE_InputCDR::read_wchar_array_i (ACE_CDR::WChar* x,
     {
       if (ACE_OutputCDR::wchar_maxbytes_ == 2)
         {
-          ACE_CDR::UShort *sb = reinterpret_cast<ACE_CDR::UShort *> (buf);
-          for (size_t i = 0; i < length; ++i)
 #if defined (ACE_DISABLE_SWAP_ON_READ)
-            x[i] = static_cast<ACE_CDR::WChar> (sb[i]);
+          ACE_Transcode::utf16_to_wchar (buf, length, x, false);
 #else
-            if (!this->do_byte_swap_)
-              x[i] = static_cast<ACE_CDR::WChar> (sb[i]);
-            else
-              {
-                ACE_CDR::UShort sx;
-                ACE_CDR::swap_2 (&buf[i * 2], reinterpret_cast<char *> (&sx));
-                x[i] = static_cast<ACE_CDR::WChar> (sx);
-              }
+          ACE_Transcode::utf16_to_wchar (buf, length, x, this->do_byte_swap_);
 #endif /* ACE_DISABLE_SWAP_ON_READ */
         }
       else
@@ -495,6 +495,20 @@ public:
               size_t align,
               char *&buf);
 
+  /**
+   * Make sure that the next @a size bytes written need no more than
+   * one allocation.  If there is not room for them, with any padding,
+   * in the current Message_Block, a block of that size is added to
+   * the chain after it.  Writing fills the rest of the current block
+   * first and goes on in the new one when a write does not fit.
+   * Writing more than @a size bytes grows the stream as usual.  Use
+   * it when the size of what follows is known, for example computed
+   * with ACE_SizeCDR, to allocate once instead of growing the stream
+   * block after block.  Sets the good_bit to false and returns -1 on
+   * failure.
+   */
+  int reserve (size_t size);
+
   /// Returns true if this stream is writing in non-native byte order
   /// and false otherwise. For example, it would be true if either
   /// ACE_ENABLE_SWAP_ON_WRITE is defined or a specific byte order was
@@ -0,0 +1,91 @@
+#include "ace/Cached_Time_Policy.h"
+#include "ace/TSC_Time_Policy.h"
+
+#include <atomic>
+
+#if !defined(__ACE_INLINE__)
+# include "ace/Cached_Time_Policy.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// The time a thread read last.
+  struct Cached_Time
+  {
+    /// Number of scopes the thread is in.
+    int depth_;
+
+    /// Whether sec_ and usec_ hold the time to return.
+    bool valid_;
+
+    time_t sec_;
+    suseconds_t usec_;
+  };
+
+  thread_local Cached_Time cached_time = { 0, false, 0, 0 };
+
+  /// Whether the reactors open a scope.
+  std::atomic<bool> reactor_scope_enabled (false);
+}
+
+ACE_Time_Value_T<ACE_Cached_Time_Policy>
+ACE_Cached_Time_Policy::operator() () const
+{
+  Cached_Time &cached = cached_time;
+  if (cached.depth_ == 0)
+    return ACE_Time_Value_T<ACE_Cached_Time_Policy> (ACE_TSC_Time_Policy () ());
+
+  if (!cached.valid_)
+    {
+      ACE_Time_Value const now = ACE_TSC_Time_Policy () ();
+      cached.sec_ = now.sec ();
+      cached.usec_ = now.usec ();
+      cached.valid_ = true;
+    }
+  return ACE_Time_Value_T<ACE_Cached_Time_Policy> (
+    ACE_Time_Value (cached.sec_, cached.usec_));
+}
+
+void
+ACE_Cached_Time_Policy::invalidate ()
+{
+  cached_time.valid_ = false;
+}
+
+void
+ACE_Cached_Time_Policy::reactor_scope (bool enable)
+{
+  reactor_scope_enabled.store (enable, std::memory_order_relaxed);
+}
+
+bool
+ACE_Cached_Time_Policy::reactor_scope ()
+{
+  return reactor_scope_enabled.load (std::memory_order_relaxed);
+}
+
+ACE_Cached_Time_Policy::Scope::Scope (bool open)
+  : open_ (open)
+{
+  if (this->open_)
+    {
+      Cached_Time &cached = cached_time;
+      ++cached.depth_;
+      cached.valid_ = false;
+    }
+}
+
+ACE_Cached_Time_Policy::Scope::~Scope ()
+{
+  if (this->open_)
+    {
+      // The enclosing scope, if any, has been waiting for this one.
+      Cached_Time &cached = cached_time;
+      --cached.depth_;
+      cached.valid_ = false;
+    }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
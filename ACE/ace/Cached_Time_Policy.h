@@ -0,0 +1,89 @@
+#ifndef ACE_CACHED_TIME_POLICY_H
+#define ACE_CACHED_TIME_POLICY_H
+// -*- C++ -*-
+/**
+ *  @file Cached_Time_Policy.h
+ */
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#include /**/ "ace/Time_Value_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Cached_Time_Policy
+ *
+ * @brief Implement a monotonic time policy that reads the clock once
+ * per event loop iteration.
+ *
+ * Within a Scope the first call of the thread reads
+ * ACE_TSC_Time_Policy and later calls return the same time until the
+ * next invalidate().  Outside a scope every call reads the clock.
+ *
+ * Once reactor_scope(true) has been called the reactors open a scope
+ * around each handle_events() call, and call invalidate() whenever
+ * they return from waiting, for events or for their token, so the
+ * timer queue, countdowns and timers scheduled by the handlers share
+ * a single clock read per event.  This is off by default because the
+ * time returned in a scope lags behind by as long as the handlers
+ * have been running; a handler that runs for long and schedules a
+ * timer afterwards should call invalidate() first.
+ */
+class ACE_Export ACE_Cached_Time_Policy
+{
+public:
+  /// Return the current time according to this policy
+  ACE_Time_Value_T<ACE_Cached_Time_Policy> operator() () const;
+
+  /// Noop. Just here to satisfy backwards compatibility demands.
+  void set_gettimeofday (ACE_Time_Value (*gettimeofday)());
+
+  /// Make the next call of the calling thread read the clock again.
+  static void invalidate ();
+
+  /// Have the reactors of the process open a Scope in handle_events(),
+  /// or stop them from doing so.
+  static void reactor_scope (bool enable);
+
+  /// Whether the reactors open a Scope in handle_events().
+  static bool reactor_scope ();
+
+  /**
+   * @class Scope
+   *
+   * @brief While an instance exists the calling thread reuses the
+   * time it read last.  Scopes nest.
+   */
+  class ACE_Export Scope
+  {
+  public:
+    /// Open a scope, unless @a open is false.
+    explicit Scope (bool open = true);
+    ~Scope ();
+
+  private:
+    Scope (const Scope &) = delete;
+    void operator= (const Scope &) = delete;
+
+    bool const open_;
+  };
+};
+
+#if defined ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT
+template class ACE_Export ACE_Time_Value_T<ACE_Cached_Time_Policy>;
+#endif /* ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT */
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Cached_Time_Policy.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_CACHED_TIME_POLICY_H */
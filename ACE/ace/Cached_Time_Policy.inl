@@ -0,0 +1,9 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE void
+ACE_Cached_Time_Policy::set_gettimeofday (ACE_Time_Value (*)())
+{
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
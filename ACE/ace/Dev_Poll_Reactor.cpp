@@ -38,6 +38,7 @@
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_time.h"
 #include "ace/Functor_T.h"
+#include "ace/Cached_Time_Policy.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -972,6 +973,9 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
     this->end_pfds_ = this->start_pfds_ + nfds;
 #endif  /* ACE_HAS_EVENT_POLL */
 
+  // Time has passed while waiting.
+  ACE_Cached_Time_Policy::invalidate ();
+
   // If timers are pending, override any timeout from the poll.
   return (nfds == 0 && timers_pending != 0 ? 1 : nfds);
 }
@@ -986,7 +990,12 @@ ACE_Dev_Poll_Reactor::handle_events (ACE_Time_Value *max_wait_time)
   //
   // The destructor of this object will automatically compute how much
   // time elapsed since this method was called.
-  ACE_Countdown_Time countdown (max_wait_time);
+  ACE_Countdown_Time_T<ACE_Cached_Time_Policy> countdown (max_wait_time);
+
+  // Share one clock read between the timer queue and the handlers,
+  // if asked to.
+  ACE_Cached_Time_Policy::Scope cached_time (
+    ACE_Cached_Time_Policy::reactor_scope ());
 
   Token_Guard guard (this->token_);
   int const result = guard.acquire_quietly (max_wait_time);
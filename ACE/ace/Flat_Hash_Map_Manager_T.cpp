@@ -0,0 +1,383 @@
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_Manager_T.cpp
+ */
+//=============================================================================
+
+#ifndef ACE_FLAT_HASH_MAP_MANAGER_T_CPP
+#define ACE_FLAT_HASH_MAP_MANAGER_T_CPP
+
+#include "ace/Flat_Hash_Map_Manager_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Flat_Hash_Map_Manager_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Malloc_Base.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Manager_Ex)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Iterator_Base_Ex)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Iterator_Ex)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Const_Iterator_Ex)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Reverse_Iterator_Ex)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex)
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("total_size_ = %d\n"), this->total_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("cur_size_ = %d\n"), this->cur_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("deleted_ = %d\n"), this->deleted_));
+  this->table_allocator_->dump ();
+  this->lock_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open (size_t size,
+                                                                                      ACE_Allocator *table_alloc,
+                                                                                      ACE_Allocator *entry_alloc)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // Calling this->close_i () to ensure we release previous allocated
+  // memory before allocating new one.
+  this->close_i ();
+
+  if (table_alloc == 0)
+    table_alloc = ACE_Allocator::instance ();
+
+  this->table_allocator_ = table_alloc;
+
+  if (entry_alloc == 0)
+    entry_alloc = table_alloc;
+
+  this->entry_allocator_ = entry_alloc;
+
+  if (size == 0)
+    return -1;
+
+  // Enough slots for <size> entries at the maximum load of 7/8.
+  size_t slots = GROUP_SIZE;
+  while (slots - slots / 8 < size)
+    slots *= 2;
+
+  return this->resize_i (slots);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close_i ()
+{
+  // Protect against "double-deletion" in case the destructor also
+  // gets called.
+  if (this->table_ != 0)
+    {
+      // Remove all the entries.
+      this->unbind_all_i ();
+
+      // Reset size.
+      this->total_size_ = 0;
+
+      // Free table memory, control bytes included.
+      this->table_allocator_->free (this->table_);
+
+      // Should be done last...
+      this->table_ = 0;
+      this->ctrl_ = 0;
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_all_i ()
+{
+  // Iterate through the entire table calling the destuctor of each
+  // <ACE_Hash_Map_Entry>.
+  for (size_t i = 0; i < this->total_size_; i++)
+    if (this->is_full (i))
+      ACE_DES_FREE_TEMPLATE2 (&this->table_[i], ACE_NOOP,
+                                ACE_Hash_Map_Entry, EXT_ID, INT_ID);
+
+  if (this->ctrl_ != 0)
+    ACE_OS::memset (this->ctrl_, EMPTY, this->total_size_);
+
+  this->cur_size_ = 0;
+  this->deleted_ = 0;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::resize_i (size_t size)
+{
+  // The control bytes follow the slots in the same block.
+  void *ptr = 0;
+  ACE_ALLOCATOR_RETURN (ptr,
+                        this->table_allocator_->malloc (size * (sizeof (ACE_Hash_Map_Entry<EXT_ID, INT_ID>) + 1)),
+                        -1);
+
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *const old_table = this->table_;
+  signed char *const old_ctrl = this->ctrl_;
+  size_t const old_size = this->total_size_;
+
+  this->table_ = static_cast<ACE_Hash_Map_Entry<EXT_ID, INT_ID> *> (ptr);
+  this->ctrl_ = reinterpret_cast<signed char *> (this->table_ + size);
+  this->total_size_ = size;
+  ACE_OS::memset (this->ctrl_, EMPTY, size);
+
+  // Move the entries over; the keys are all different so they go to
+  // the first free slot of their probe sequence.
+  size_t const mask = size / GROUP_SIZE - 1;
+  for (size_t i = 0; i < old_size; ++i)
+    if (old_ctrl[i] >= 0)
+      {
+        size_t group = 0;
+        signed char h7 = 0;
+        this->hash_i (old_table[i].ext_id_, group, h7);
+
+        ACE_UINT32 free_slots = match_free (this->ctrl_ + group * GROUP_SIZE);
+        for (size_t step = 1; free_slots == 0; ++step)
+          {
+            group = (group + step) & mask;
+            free_slots = match_free (this->ctrl_ + group * GROUP_SIZE);
+          }
+
+        size_t const index = group * GROUP_SIZE + lowest_bit (free_slots);
+        new (&this->table_[index]) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (old_table[i].ext_id_,
+                                                                       old_table[i].int_id_);
+        this->ctrl_[index] = h7;
+        ACE_DES_FREE_TEMPLATE2 (&old_table[i], ACE_NOOP,
+                                  ACE_Hash_Map_Entry, EXT_ID, INT_ID);
+      }
+
+  this->deleted_ = 0;
+  if (old_table != 0)
+    this->table_allocator_->free (old_table);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ssize_t
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::lookup_i (const EXT_ID &ext_id)
+{
+  if (this->total_size_ == 0)
+    {
+      errno = ENOENT;
+      return -1;
+    }
+
+  size_t group = 0;
+  signed char h7 = 0;
+  this->hash_i (ext_id, group, h7);
+
+  // The groups are visited at triangular offsets, which reaches all
+  // of them since their number is a power of two.  The load limit
+  // leaves empty slots, so the loop ends.
+  size_t const mask = this->total_size_ / GROUP_SIZE - 1;
+  for (size_t step = 1; ; ++step)
+    {
+      const signed char *ctrl = this->ctrl_ + group * GROUP_SIZE;
+
+      for (ACE_UINT32 candidates = match (ctrl, h7);
+           candidates != 0;
+           candidates &= candidates - 1)
+        {
+          size_t const index = group * GROUP_SIZE + lowest_bit (candidates);
+          if (this->equal (this->table_[index].ext_id_, ext_id))
+            return static_cast<ssize_t> (index);
+        }
+
+      // A key is only put past a group that had no empty slot.
+      if (match_empty (ctrl) != 0)
+        {
+          errno = ENOENT;
+          return -1;
+        }
+
+      group = (group + step) & mask;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ssize_t
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::insert_slot_i (const EXT_ID &ext_id,
+                                                                                               signed char &h7)
+{
+  size_t const total = this->total_size_;
+  if (this->cur_size_ + this->deleted_ >= total - total / 8)
+    {
+      // Double the table, unless it is mostly deleted slots that a
+      // rehash at the same size gets rid of.
+      size_t size = GROUP_SIZE;
+      if (total != 0)
+        size = this->cur_size_ < (total - total / 8) / 2 ? total : 2 * total;
+
+      if (this->resize_i (size) == -1)
+        return -1;
+    }
+
+  size_t group = 0;
+  this->hash_i (ext_id, group, h7);
+
+  size_t const mask = this->total_size_ / GROUP_SIZE - 1;
+  ACE_UINT32 free_slots = match_free (this->ctrl_ + group * GROUP_SIZE);
+  for (size_t step = 1; free_slots == 0; ++step)
+    {
+      group = (group + step) & mask;
+      free_slots = match_free (this->ctrl_ + group * GROUP_SIZE);
+    }
+
+  return static_cast<ssize_t> (group * GROUP_SIZE + lowest_bit (free_slots));
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::construct_i (size_t index,
+                                                                                             signed char h7,
+                                                                                             const EXT_ID &ext_id,
+                                                                                             const INT_ID &int_id,
+                                                                                             ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  entry = new (&this->table_[index]) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (ext_id,
+                                                                         int_id);
+  if (this->ctrl_[index] == DELETED)
+    --this->deleted_;
+  this->ctrl_[index] = h7;
+  ++this->cur_size_;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
+                                                                                        const INT_ID &int_id,
+                                                                                        ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ssize_t index = this->lookup_i (ext_id);
+  if (index != -1)
+    {
+      entry = &this->table_[index];
+      return 1;
+    }
+
+  signed char h7 = 0;
+  index = this->insert_slot_i (ext_id, h7);
+  if (index == -1)
+    return -1;
+
+  return this->construct_i (index, h7, ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::trybind_i (const EXT_ID &ext_id,
+                                                                                           INT_ID &int_id,
+                                                                                           ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  return this->bind_i (ext_id, int_id, entry);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (const EXT_ID &ext_id,
+                                                                                          INT_ID &int_id)
+{
+  ssize_t const index = this->lookup_i (ext_id);
+  if (index == -1)
+    {
+      errno = ENOENT;
+      return -1;
+    }
+
+  int_id = this->table_[index].int_id_;
+
+  return this->unbind_i (&this->table_[index]);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry)
+{
+  size_t const index = entry - this->table_;
+  if (entry < this->table_ || index >= this->total_size_ || !this->is_full (index))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  // Explicitly call the destructor.
+  ACE_DES_FREE_TEMPLATE2 (entry, ACE_NOOP,
+                            ACE_Hash_Map_Entry, EXT_ID, INT_ID);
+
+  // A group that still has an empty slot never had a key probed past
+  // it, so the slot can go back to empty instead of being left in
+  // the probe sequences as deleted.
+  if (match_empty (this->ctrl_ + index / GROUP_SIZE * GROUP_SIZE) != 0)
+    this->ctrl_[index] = EMPTY;
+  else
+    {
+      this->ctrl_[index] = DELETED;
+      ++this->deleted_;
+    }
+
+  --this->cur_size_;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                                          const INT_ID &int_id,
+                                                                                          ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ssize_t const index = this->lookup_i (ext_id);
+  if (index == -1)
+    return this->bind_i (ext_id, int_id, entry);
+
+  entry = &this->table_[index];
+  entry->ext_id_ = ext_id;
+  entry->int_id_ = int_id;
+  return 1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                                          const INT_ID &int_id,
+                                                                                          INT_ID &old_int_id,
+                                                                                          ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ssize_t const index = this->lookup_i (ext_id);
+  if (index == -1)
+    return this->bind_i (ext_id, int_id, entry);
+
+  entry = &this->table_[index];
+  old_int_id = entry->int_id_;
+  entry->ext_id_ = ext_id;
+  entry->int_id_ = int_id;
+  return 1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                                          const INT_ID &int_id,
+                                                                                          EXT_ID &old_ext_id,
+                                                                                          INT_ID &old_int_id,
+                                                                                          ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ssize_t const index = this->lookup_i (ext_id);
+  if (index == -1)
+    return this->bind_i (ext_id, int_id, entry);
+
+  entry = &this->table_[index];
+  old_ext_id = entry->ext_id_;
+  old_int_id = entry->int_id_;
+  entry->ext_id_ = ext_id;
+  entry->int_id_ = int_id;
+  return 1;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_FLAT_HASH_MAP_MANAGER_T_CPP */
@@ -0,0 +1,887 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_Manager_T.h
+ *
+ *  An open addressing hash map with the interface of
+ *  ACE_Hash_Map_Manager_Ex.
+ */
+//=============================================================================
+
+#ifndef ACE_FLAT_HASH_MAP_MANAGER_T_H
+#define ACE_FLAT_HASH_MAP_MANAGER_T_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Hash_Map_Manager_T.h"
+#include <iterator>
+
+#if !defined (ACE_FLAT_HASH_MAP_LACKS_SSE2) \
+    && (defined (__SSE2__) || defined (_M_X64) \
+        || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+/// Probe the control bytes of a group with SSE2 instructions.
+# define ACE_FLAT_HASH_MAP_HAS_SSE2
+# include <emmintrin.h>
+#endif /* !ACE_FLAT_HASH_MAP_LACKS_SSE2 && __SSE2__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Base_Ex;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Ex;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Iterator_Ex;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Reverse_Iterator_Ex;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex;
+
+/**
+ * @class ACE_Flat_Hash_Map_Manager_Ex
+ *
+ * @brief Define a map abstraction that efficiently associates
+ * <EXT_ID> type objects with <INT_ID> type objects, keeping the
+ * entries in one array instead of a chain of nodes per bucket.
+ *
+ * The map offers the bind, find, unbind and iterator operations of
+ * ACE_Hash_Map_Manager_Ex, with the same entry type and return
+ * values, so a user of ACE_Hash_Map_Manager_Ex can switch to it by
+ * changing a typedef.  The table is an array of slots, each holding
+ * an ACE_Hash_Map_Entry in place, and an array of one control byte
+ * per slot that is either empty, deleted, or 7 bits of the
+ * hash of the key in the slot.  The slots are probed 16 at a time:
+ * the control bytes of a group are compared with the hash of the key
+ * at once, with SSE2 instructions where available, and only the
+ * slots whose byte matches have their key compared.  Groups are
+ * visited in a quadratic sequence until one with an empty slot is
+ * found.  The table doubles when 7/8 of its slots are in use.
+ *
+ * Unlike ACE_Hash_Map_Manager_Ex, the entries move when the table
+ * grows: a bind that adds an entry may invalidate the entry pointers
+ * and iterators obtained before.  An unbind only marks the slot of
+ * the entry, so it leaves the other entries and the iterators where
+ * they are.  The <next_> and <prev_> fields of the entries are not
+ * used and are always 0.
+ *
+ * <EXT_ID> must support <operator==> through COMPARE_KEYS and be
+ * hashed by HASH_KEY; both <EXT_ID> and <INT_ID> must be copy
+ * constructible.  The table and its entries are allocated with the
+ * table allocator in one block; the entry allocator is only kept
+ * for interface compatibility.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Manager_Ex
+{
+public:
+  friend class ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID
+          KEY;
+  typedef INT_ID
+          VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          ITERATOR;
+  typedef ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          CONST_ITERATOR;
+  typedef ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          REVERSE_ITERATOR;
+  typedef ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          CONST_REVERSE_ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          iterator;
+  typedef ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          const_iterator;
+  typedef ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          reverse_iterator;
+  typedef ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          const_reverse_iterator;
+
+  // = STL-style typedefs/traits.
+  typedef EXT_ID                             key_type;
+  typedef INT_ID                             data_type;
+  typedef ACE_Hash_Map_Entry<EXT_ID, INT_ID> value_type;
+  typedef value_type &                       reference;
+  typedef value_type const &                 const_reference;
+  typedef value_type *                       pointer;
+  typedef value_type const *                 const_pointer;
+  typedef ptrdiff_t                          difference_type;
+  typedef size_t                             size_type;
+
+  /// Number of slots whose control bytes are probed together.
+  static const size_t GROUP_SIZE = 16;
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map_Manager_Ex that can hold
+   * ACE_DEFAULT_MAP_SIZE entries before it grows.
+   *
+   * @param table_alloc is the allocator of the table.  If
+   *        @a table_alloc is 0 it defaults to ACE_Allocator::instance().
+   * @param entry_alloc is ignored, the entries are in the table.
+   */
+  ACE_Flat_Hash_Map_Manager_Ex (ACE_Allocator *table_alloc = 0,
+                                ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map_Manager_Ex that can hold @a size
+   * entries before it grows.
+   *
+   * @param table_alloc is the allocator of the table.  If
+   *        @a table_alloc is 0 it defaults to ACE_Allocator::instance().
+   * @param entry_alloc is ignored, the entries are in the table.
+   */
+  ACE_Flat_Hash_Map_Manager_Ex (size_t size,
+                                ACE_Allocator *table_alloc = 0,
+                                ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map_Manager_Ex that can hold @a size
+   * entries before it grows, closing it first if it is open.
+   * @return -1 on failure, 0 on success
+   */
+  int open (size_t size = ACE_DEFAULT_MAP_SIZE,
+            ACE_Allocator *table_alloc = 0,
+            ACE_Allocator *entry_alloc = 0);
+
+  /// Close down the ACE_Flat_Hash_Map_Manager_Ex and release
+  /// dynamically allocated resources.
+  int close ();
+
+  /// Removes all the entries in the ACE_Flat_Hash_Map_Manager_Ex,
+  /// keeping the table.
+  int unbind_all ();
+
+  /// Cleanup the ACE_Flat_Hash_Map_Manager_Ex.
+  ~ACE_Flat_Hash_Map_Manager_Ex ();
+
+  /**
+   * Associate @a item with @a int_id.  If @a item is already in the
+   * map then the map is not changed.
+   *
+   * @retval 0 if a new entry is bound successfully.
+   * @retval 1 if an attempt is made to bind an existing entry.
+   * @retval -1 if a failure occurs; check @c errno for more information.
+   */
+  int bind (const EXT_ID &item,
+            const INT_ID &int_id);
+
+  /**
+   * Same as a normal bind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id,
+            ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is not
+   * in the map.  If @a ext_id is already in the map then the @a int_id
+   * parameter is assigned the existing value in the map.  Returns 0
+   * if a new entry is bound successfully, returns 1 if an attempt is
+   * made to bind an existing entry, and returns -1 if failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /**
+   * Same as a normal trybind, except the map entry is also passed
+   * back to the caller.  The entry in this case will either be the
+   * newly created entry, or the existing one.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id,
+               ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Reassociate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * map then behaves just like <bind>.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an existing entry was rebound,
+   * and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the map
+   * then behaves just like <bind>.  Otherwise, store the old value of
+   * @a int_id into the "out" parameter and rebind the new parameters.
+   * Returns 0 if a new entry is bound successfully, returns 1 if an
+   * existing entry was rebound, and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id,
+              ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the map
+   * then behaves just like <bind>.  Otherwise, store the old values
+   * of @a ext_id and @a int_id into the "out" parameters and rebind the
+   * new parameters.  Returns 0 if a new entry is bound successfully,
+   * returns 1 if an existing entry was rebound, and returns -1 if
+   * failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id,
+              ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Locate @a ext_id and pass out parameter via @a int_id.
+  /// Return 0 if found, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Returns 0 if the @a ext_id is in the mapping, otherwise -1.
+  int find (const EXT_ID &ext_id) const;
+
+  /// Locate @a ext_id and pass out parameter via @a entry.  If found,
+  /// return 0, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry) const;
+
+  /// Locate @a ext_id and pass out an iterator that points to its
+  /// corresponding value.
+  /**
+   * @param pos @a pos will be set to @c end() if not found.
+   */
+  void find (EXT_ID const & ext_id, iterator & pos) const;
+
+  /**
+   * Unbind (remove) the @a ext_id from the map.  Don't return the
+   * @a int_id to the caller (this is useful for collections where the
+   * @a int_ids are *not* dynamically allocated...)
+   */
+  int unbind (const EXT_ID &ext_id);
+
+  /// Break any association of @a ext_id.  Returns the value of @a int_id
+  /// in case the caller needs to deallocate memory. Return 0 if the
+  /// unbind was successful, and returns -1 if failures occur.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Remove @a entry, which must be in the map, without looking it
+  /// up.
+  /**
+   * @return 0 if the unbind was successful, and -1 if failures
+   *         occur.
+   */
+  int unbind (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry);
+
+  /// Remove entry from map pointed to by @c iterator @a pos, without
+  /// looking it up.
+  /**
+   * @return 0 if the unbind was successful, and -1 if failures
+   *         occur.
+   */
+  int unbind (iterator pos);
+
+  /// Returns the current number of entries in the map.
+  size_t current_size () const;
+
+  /// Return the number of slots of the table.
+  size_t total_size () const;
+
+  /**
+   * Returns a reference to the underlying <ACE_LOCK>.  This makes it
+   * possible to acquire the lock explicitly, which can be useful if
+   * you need to guard the state of an iterator.
+   */
+  ACE_LOCK &mutex ();
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  iterator begin ();
+  iterator end ();
+  const_iterator begin () const;
+  const_iterator end () const;
+
+  /// Return reverse iterator.
+  reverse_iterator rbegin ();
+  reverse_iterator rend ();
+  const_reverse_iterator rbegin () const;
+  const_reverse_iterator rend () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  // = The following methods do the actual work.
+
+  /// Returns 1 if <id1> == <id2>, else 0.  This is defined as a
+  /// separate method to facilitate template specialization.
+  int equal (const EXT_ID &id1, const EXT_ID &id2);
+
+  /// Compute the hash value of the @a ext_id.  This is defined as a
+  /// separate method to facilitate template specialization.
+  u_long hash (const EXT_ID &ext_id);
+
+  // = These methods assume locks are held by private methods.
+
+  /// Performs bind.  Must be called with locks held.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /// Performs bind.  Must be called with locks held.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs trybind.  Must be called with locks held.
+  int trybind_i (const EXT_ID &ext_id,
+                 INT_ID &int_id);
+
+  /// Performs trybind.  Must be called with locks held.
+  int trybind_i (const EXT_ID &ext_id,
+                 INT_ID &int_id,
+                 ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                INT_ID &old_int_id);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                INT_ID &old_int_id,
+                ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                EXT_ID &old_ext_id,
+                INT_ID &old_int_id);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                EXT_ID &old_ext_id,
+                INT_ID &old_int_id,
+                ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs a find of @a int_id using @a ext_id as the key.  Must be
+  /// called with locks held.
+  int find_i (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Performs a find using @a ext_id as the key.  Must be called with
+  /// locks held.
+  int find_i (const EXT_ID &ext_id);
+
+  /// Performs a find using @a ext_id as the key.  Must be called with
+  /// locks held.
+  int find_i (const EXT_ID &ext_id,
+              ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (const EXT_ID &ext_id,
+                INT_ID &int_id);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (const EXT_ID &ext_id);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry);
+
+  /// Resize the table to @a size slots, a power of two multiple of
+  /// GROUP_SIZE, moving the entries.  Must be called with locks held.
+  int resize_i (size_t size);
+
+  /// Close down a map.  Must be called with locks held.
+  int close_i ();
+
+  /// Removes all the entries in the map.  Must be called with locks
+  /// held.
+  int unbind_all_i ();
+
+  /// Pointer to a memory allocator used for the table.
+  ACE_Allocator *table_allocator_;
+
+  /// Additional allocator, kept for ACE_Hash_Map_Manager_Ex
+  /// compatibility.
+  ACE_Allocator *entry_allocator_;
+
+  /// Synchronization variable for the MT_SAFE
+  /// ACE_Flat_Hash_Map_Manager_Ex.
+  mutable ACE_LOCK lock_;
+
+  /// Function object used for hashing keys.
+  HASH_KEY hash_key_;
+
+  /// Function object used for comparing keys.
+  COMPARE_KEYS compare_keys_;
+
+protected:
+  /// Control byte of a slot that never held an entry since the table
+  /// was last cleared or resized.
+  static const signed char EMPTY = -128;
+
+  /// Control byte of a slot whose entry was unbound.
+  static const signed char DELETED = -2;
+
+  /// Hash @a ext_id and split the result in the first group to probe
+  /// and the 7 bits kept in the control byte.
+  void hash_i (const EXT_ID &ext_id,
+               size_t &group,
+               signed char &h7);
+
+  /// Index of the slot of @a ext_id, or -1 when it is not in the map.
+  ssize_t lookup_i (const EXT_ID &ext_id);
+
+  /// Index of a free slot to put an entry with @a ext_id in, growing
+  /// the table first when it is too full, or -1 when the table cannot
+  /// grow.  @a h7 is set to the control byte of the entry.
+  ssize_t insert_slot_i (const EXT_ID &ext_id,
+                         signed char &h7);
+
+  /// Construct an entry in slot @a index.
+  int construct_i (size_t index,
+                   signed char h7,
+                   const EXT_ID &ext_id,
+                   const INT_ID &int_id,
+                   ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Return true if slot @a index holds an entry.
+  bool is_full (size_t index) const;
+
+  /// Bit i of the result is set when control byte @a i of @a group
+  /// equals @a h7.
+  static ACE_UINT32 match (const signed char *group, signed char h7);
+
+  /// Bit i of the result is set when slot @a i of @a group is empty.
+  static ACE_UINT32 match_empty (const signed char *group);
+
+  /// Bit i of the result is set when slot @a i of @a group is empty
+  /// or deleted.
+  static ACE_UINT32 match_free (const signed char *group);
+
+  /// Index of the lowest bit set in @a mask, which is not 0.
+  static size_t lowest_bit (ACE_UINT32 mask);
+
+private:
+  /// The slots, @c total_size_ of them, followed by their control
+  /// bytes.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *table_;
+
+  /// Control bytes of the slots.
+  signed char *ctrl_;
+
+  /// Total number of slots, 0 or a power of two multiple of
+  /// GROUP_SIZE.
+  size_t total_size_;
+
+  /// Current number of entries in the table.
+  size_t cur_size_;
+
+  /// Number of slots marked DELETED; they stay in the probe
+  /// sequences until the table is resized.
+  size_t deleted_;
+
+  // = Disallow these operations.
+  void operator= (const ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) = delete;
+  ACE_Flat_Hash_Map_Manager_Ex (const ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) = delete;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Iterator_Base_Ex
+ *
+ * @brief Base iterator for the ACE_Flat_Hash_Map_Manager_Ex
+ *
+ * This class factors out common code from its templatized
+ * subclasses.  An iterator is a position in the table of the map; it
+ * stays valid across unbinds but not across a bind that grows the
+ * table.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Base_Ex
+{
+public:
+  // = STL-style typedefs/traits.
+  typedef ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Constructor, positioned on slot @a index of @a mm, -1 or
+  /// @c mm.total_size() being past the ends.
+  ACE_Flat_Hash_Map_Iterator_Base_Ex (const container_type &mm,
+                                      ssize_t index);
+
+  // = ITERATION methods.
+
+  /// Pass back the next <entry> that hasn't been seen in the Set.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done () const;
+
+  /// Returns a reference to the internal element @c this is pointing to.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID>& operator* () const;
+
+  /// Returns a pointer to the internal element @c this is pointing to.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID>* operator-> () const;
+
+  /// Check if two iterators point to the same position
+  bool operator== (const ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Move forward to the next entry.  Returns 0 when there's no more
+  /// item in the set after the current items, else 1.
+  int forward_i ();
+
+  /// Move backward to the previous entry.  Returns 0 when there's no
+  /// more item in the set before the current item, else 1.
+  int reverse_i ();
+
+  /// Dump the state of an object.
+  void dump_i () const;
+
+  /// Map we are iterating over.
+  const container_type *map_man_;
+
+  /// Slot we are on.
+  ssize_t index_;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Iterator_Ex
+ *
+ * @brief Forward iterator for the ACE_Flat_Hash_Map_Manager_Ex.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Flat_Hash_Map_Manager_Ex it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_Guard or ACE_Read_Guard on the ACE_Flat_Hash_Map_Manager_Ex's
+ * internal lock, which is accessible via its <mutex> method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Ex : public ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+    container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  ACE_Flat_Hash_Map_Iterator_Ex (container_type &mm,
+                                 bool tail = false);
+
+  /// Constructor, positioned on @a entry of @a mm.
+  ACE_Flat_Hash_Map_Iterator_Ex (container_type &mm,
+                                 ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry);
+
+  // = Iteration methods.
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance ();
+
+  /// Returns reference the map that is being iterated over.
+  container_type &map ();
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ ();
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- ();
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Const_Iterator_Ex
+ *
+ * @brief Const forward iterator for the ACE_Flat_Hash_Map_Manager_Ex.
+ *
+ * This class does not perform any internal locking, see
+ * ACE_Flat_Hash_Map_Iterator_Ex.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Iterator_Ex : public ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+    container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::const_reference reference;
+  typedef typename container_type::const_pointer   pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  ACE_Flat_Hash_Map_Const_Iterator_Ex (const container_type &mm,
+                                       bool tail = false);
+
+  // = Iteration methods.
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance ();
+
+  /// Returns reference the map that is being iterated over.
+  const container_type &map () const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ ();
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- ();
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Const_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Reverse_Iterator_Ex
+ *
+ * @brief Reverse iterator for the ACE_Flat_Hash_Map_Manager_Ex.
+ *
+ * This class does not perform any internal locking, see
+ * ACE_Flat_Hash_Map_Iterator_Ex.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Reverse_Iterator_Ex : public ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+    container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  ACE_Flat_Hash_Map_Reverse_Iterator_Ex (container_type &mm,
+                                         bool head = false);
+
+  // = Iteration methods.
+  /// Move backward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance ();
+
+  /// Returns reference the map that is being iterated over.
+  container_type &map ();
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ ();
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- ();
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex
+ *
+ * @brief Const reverse iterator for the ACE_Flat_Hash_Map_Manager_Ex.
+ *
+ * This class does not perform any internal locking, see
+ * ACE_Flat_Hash_Map_Iterator_Ex.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex : public ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+    container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::const_reference reference;
+  typedef typename container_type::const_pointer   pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex (const container_type &mm,
+                                               bool head = false);
+
+  // = Iteration methods.
+  /// Move backward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance ();
+
+  /// Returns reference the map that is being iterated over.
+  const container_type &map () const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ ();
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- ();
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Const_Reverse_Iterator_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Manager
+ *
+ * @brief Wrapper for backward compatibility with the
+ * ACE_Hash_Map_Manager template.
+ *
+ * This class hashes its keys with ACE_Hash<EXT_ID> and compares them
+ * with ACE_Equal_To<EXT_ID>.
+ */
+template <class EXT_ID, class INT_ID, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Manager : public ACE_Flat_Hash_Map_Manager_Ex<EXT_ID, INT_ID, ACE_Hash<EXT_ID>, ACE_Equal_To<EXT_ID>, ACE_LOCK>
+{
+public:
+  /// Initialize a map that can hold ACE_DEFAULT_MAP_SIZE entries
+  /// before it grows.
+  ACE_Flat_Hash_Map_Manager (ACE_Allocator *table_alloc = 0,
+                             ACE_Allocator *entry_alloc = 0);
+
+  /// Initialize a map that can hold @a size entries before it grows.
+  ACE_Flat_Hash_Map_Manager (size_t size,
+                             ACE_Allocator *table_alloc = 0,
+                             ACE_Allocator *entry_alloc = 0);
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#  include "ace/Flat_Hash_Map_Manager_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Flat_Hash_Map_Manager_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Flat_Hash_Map_Manager_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_FLAT_HASH_MAP_MANAGER_T_H */
@@ -0,0 +1,394 @@
+#include "ace/HDR_Histogram.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/HDR_Histogram.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/CDR_Stream.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Starts the encoded form, followed by a version number.
+  const ACE_CDR::ULong encoding_cookie = 0x48445201;
+
+  void
+  atomic_min (std::atomic<ACE_UINT64> &min, ACE_UINT64 value)
+  {
+    ACE_UINT64 current = min.load (std::memory_order_relaxed);
+    while (value < current
+           && !min.compare_exchange_weak (current, value,
+                                          std::memory_order_relaxed))
+      {
+      }
+  }
+
+  void
+  atomic_max (std::atomic<ACE_UINT64> &max, ACE_UINT64 value)
+  {
+    ACE_UINT64 current = max.load (std::memory_order_relaxed);
+    while (value > current
+           && !max.compare_exchange_weak (current, value,
+                                          std::memory_order_relaxed))
+      {
+      }
+  }
+
+  bool
+  write_varint (ACE_OutputCDR &cdr, ACE_UINT64 value)
+  {
+    while (value >= 0x80)
+      {
+        if (!cdr.write_octet (static_cast<ACE_CDR::Octet> (value | 0x80)))
+          return false;
+        value >>= 7;
+      }
+    return cdr.write_octet (static_cast<ACE_CDR::Octet> (value));
+  }
+
+  bool
+  read_varint (ACE_InputCDR &cdr, ACE_UINT64 &value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+      {
+        ACE_CDR::Octet byte = 0;
+        if (!cdr.read_octet (byte))
+          return false;
+        value |= ACE_UINT64 (byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+          return true;
+      }
+    return false;
+  }
+}
+
+ACE_HDR_Histogram::ACE_HDR_Histogram (ACE_UINT64 highest_trackable_value,
+                                      int significant_digits)
+  : highest_trackable_value_ (highest_trackable_value < 2
+                              ? 2
+                              : highest_trackable_value)
+  , significant_digits_ (significant_digits < 1
+                         ? 1
+                         : (significant_digits > 5 ? 5 : significant_digits))
+  , sub_bucket_half_count_magnitude_ (0)
+  , sub_bucket_half_count_ (0)
+  , sub_bucket_mask_ (0)
+  , counts_length_ (0)
+  , counts_ (0)
+  , total_count_ (0)
+  , min_ (ACE_UINT64_MAX)
+  , max_ (0)
+{
+  // Values up to this one are counted one by one.
+  ACE_UINT64 single_unit_resolution = 2;
+  for (int i = 0; i != this->significant_digits_; ++i)
+    single_unit_resolution *= 10;
+
+  int sub_bucket_count_magnitude = 0;
+  while ((ACE_UINT64 (1) << sub_bucket_count_magnitude) < single_unit_resolution)
+    ++sub_bucket_count_magnitude;
+
+  this->sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+  ACE_UINT64 const sub_bucket_count = ACE_UINT64 (1) << sub_bucket_count_magnitude;
+  this->sub_bucket_half_count_ = sub_bucket_count / 2;
+  this->sub_bucket_mask_ = sub_bucket_count - 1;
+
+  // Every bucket covers twice the range of the one before.
+  int bucket_count = 1;
+  for (ACE_UINT64 untrackable = sub_bucket_count;
+       untrackable <= this->highest_trackable_value_;
+       untrackable <<= 1)
+    {
+      ++bucket_count;
+      if (untrackable > ACE_UINT64_MAX / 2)
+        break;
+    }
+
+  size_t const length =
+    size_t (bucket_count + 1) << this->sub_bucket_half_count_magnitude_;
+  ACE_NEW (this->counts_, std::atomic<ACE_UINT64>[length]);
+  this->counts_length_ = length;
+  this->reset ();
+}
+
+ACE_HDR_Histogram::~ACE_HDR_Histogram ()
+{
+  delete [] this->counts_;
+}
+
+void
+ACE_HDR_Histogram::record_atomic (ACE_UINT64 value, ACE_UINT64 count)
+{
+  value = this->clamp (value);
+  this->counts_[this->counts_index (value)].fetch_add (
+    count, std::memory_order_relaxed);
+  this->total_count_.fetch_add (count, std::memory_order_relaxed);
+  atomic_min (this->min_, value);
+  atomic_max (this->max_, value);
+}
+
+void
+ACE_HDR_Histogram::add (const ACE_HDR_Histogram &rhs)
+{
+  if (&rhs == this || this->counts_ == 0)
+    return;
+
+  if (rhs.sub_bucket_half_count_magnitude_
+        == this->sub_bucket_half_count_magnitude_
+      && rhs.counts_length_ <= this->counts_length_)
+    {
+      // The buckets are the same.
+      ACE_UINT64 added = 0;
+      for (size_t i = 0; i != rhs.counts_length_; ++i)
+        {
+          ACE_UINT64 const count =
+            rhs.counts_[i].load (std::memory_order_relaxed);
+          if (count != 0)
+            {
+              this->counts_[i].fetch_add (count, std::memory_order_relaxed);
+              added += count;
+            }
+        }
+      this->total_count_.fetch_add (added, std::memory_order_relaxed);
+    }
+  else
+    {
+      for (size_t i = 0; i != rhs.counts_length_; ++i)
+        {
+          ACE_UINT64 const count =
+            rhs.counts_[i].load (std::memory_order_relaxed);
+          if (count != 0)
+            {
+              ACE_UINT64 const value = this->clamp (rhs.value_at_index (i));
+              this->counts_[this->counts_index (value)].fetch_add (
+                count, std::memory_order_relaxed);
+              this->total_count_.fetch_add (count, std::memory_order_relaxed);
+            }
+        }
+    }
+
+  if (rhs.total_count () != 0)
+    {
+      atomic_min (this->min_, this->clamp (rhs.min ()));
+      atomic_max (this->max_, this->clamp (rhs.max ()));
+    }
+}
+
+void
+ACE_HDR_Histogram::reset ()
+{
+  for (size_t i = 0; i != this->counts_length_; ++i)
+    this->counts_[i].store (0, std::memory_order_relaxed);
+  this->total_count_.store (0, std::memory_order_relaxed);
+  this->min_.store (ACE_UINT64_MAX, std::memory_order_relaxed);
+  this->max_.store (0, std::memory_order_relaxed);
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::value_at_index (size_t index) const
+{
+  int bucket =
+    static_cast<int> (index >> this->sub_bucket_half_count_magnitude_) - 1;
+  ACE_UINT64 sub_bucket = (index & (this->sub_bucket_half_count_ - 1))
+    + this->sub_bucket_half_count_;
+  if (bucket < 0)
+    {
+      sub_bucket -= this->sub_bucket_half_count_;
+      bucket = 0;
+    }
+  return sub_bucket << bucket;
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::lowest_equivalent_value (ACE_UINT64 value) const
+{
+  int const bucket = this->bucket_index (value);
+  return (value >> bucket) << bucket;
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::highest_equivalent_value (ACE_UINT64 value) const
+{
+  int const bucket = this->bucket_index (value);
+  return this->lowest_equivalent_value (value)
+    + ((ACE_UINT64 (1) << bucket) - 1);
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::mean () const
+{
+  ACE_UINT64 const total = this->total_count ();
+  if (total == 0)
+    return 0;
+
+  // Take the middle of each bucket.
+  double sum = 0;
+  for (size_t i = 0; i != this->counts_length_; ++i)
+    {
+      ACE_UINT64 const count = this->counts_[i].load (std::memory_order_relaxed);
+      if (count != 0)
+        {
+          ACE_UINT64 const lowest = this->value_at_index (i);
+          ACE_UINT64 const middle =
+            lowest + (this->highest_equivalent_value (lowest) - lowest) / 2;
+          sum += static_cast<double> (middle) * static_cast<double> (count);
+        }
+    }
+  return static_cast<ACE_UINT64> (sum / static_cast<double> (total));
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::value_at_percentile (double percentile) const
+{
+  ACE_UINT64 const total = this->total_count ();
+  if (total == 0)
+    return 0;
+
+  if (percentile > 100.0)
+    percentile = 100.0;
+  else if (percentile < 0.0)
+    percentile = 0.0;
+
+  ACE_UINT64 wanted = static_cast<ACE_UINT64> (
+    percentile / 100.0 * static_cast<double> (total) + 0.5);
+  if (wanted == 0)
+    wanted = 1;
+
+  ACE_UINT64 const max = this->max ();
+  ACE_UINT64 seen = 0;
+  for (size_t i = 0; i != this->counts_length_; ++i)
+    {
+      seen += this->counts_[i].load (std::memory_order_relaxed);
+      if (seen >= wanted)
+        {
+          ACE_UINT64 const value =
+            this->highest_equivalent_value (this->value_at_index (i));
+          return value < max ? value : max;
+        }
+    }
+  return max;
+}
+
+bool
+ACE_HDR_Histogram::encode (ACE_OutputCDR &cdr) const
+{
+  if (!(cdr.write_ulong (encoding_cookie)
+        && cdr.write_octet (static_cast<ACE_CDR::Octet> (this->significant_digits_))
+        && cdr.write_ulonglong (this->highest_trackable_value_)
+        && cdr.write_ulonglong (this->min ())
+        && cdr.write_ulonglong (this->max ())))
+    return false;
+
+  // The counts are written as zig-zag varints, where a negative number
+  // is a run of empty buckets, and end with a 0.
+  ACE_UINT64 zeros = 0;
+  for (size_t i = 0; i != this->counts_length_; ++i)
+    {
+      ACE_UINT64 const count = this->counts_[i].load (std::memory_order_relaxed);
+      if (count == 0)
+        {
+          ++zeros;
+          continue;
+        }
+      if (zeros != 0)
+        {
+          if (!write_varint (cdr, (zeros << 1) - 1))
+            return false;
+          zeros = 0;
+        }
+      if (!write_varint (cdr, count << 1))
+        return false;
+    }
+  return write_varint (cdr, 0);
+}
+
+bool
+ACE_HDR_Histogram::decode (ACE_InputCDR &cdr)
+{
+  ACE_CDR::ULong cookie = 0;
+  ACE_CDR::Octet digits = 0;
+  ACE_CDR::ULongLong highest = 0;
+  ACE_CDR::ULongLong min = 0;
+  ACE_CDR::ULongLong max = 0;
+  if (!(cdr.read_ulong (cookie)
+        && cdr.read_octet (digits)
+        && cdr.read_ulonglong (highest)
+        && cdr.read_ulonglong (min)
+        && cdr.read_ulonglong (max))
+      || cookie != encoding_cookie
+      || digits < 1 || digits > 5)
+    return false;
+
+  ACE_HDR_Histogram encoded (highest, digits);
+  if (encoded.counts_ == 0)
+    return false;
+
+  ACE_UINT64 total = 0;
+  size_t index = 0;
+  for (;;)
+    {
+      ACE_UINT64 value = 0;
+      if (!read_varint (cdr, value))
+        return false;
+      if (value == 0)
+        break;
+
+      if ((value & 1) != 0)
+        {
+          ACE_UINT64 const zeros = (value + 1) >> 1;
+          if (zeros > encoded.counts_length_ - index)
+            return false;
+          index += static_cast<size_t> (zeros);
+        }
+      else
+        {
+          if (index >= encoded.counts_length_)
+            return false;
+          encoded.counts_[index++].store (value >> 1,
+                                          std::memory_order_relaxed);
+          total += value >> 1;
+        }
+    }
+
+  if (total != 0)
+    {
+      encoded.total_count_.store (total, std::memory_order_relaxed);
+      encoded.min_.store (min, std::memory_order_relaxed);
+      encoded.max_.store (max, std::memory_order_relaxed);
+      this->add (encoded);
+    }
+  return true;
+}
+
+void
+ACE_HDR_Histogram::dump_results (
+  const ACE_TCHAR *msg,
+  ACE_HDR_Histogram::scale_factor_type sf) const
+{
+#ifndef ACE_NLOGGING
+  if (this->total_count () == 0)
+    {
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s : no data collected\n"), msg));
+      return;
+    }
+
+  ACE_UINT64 const p50 = this->value_at_percentile (50.0) / sf;
+  ACE_UINT64 const p99 = this->value_at_percentile (99.0) / sf;
+  ACE_UINT64 const p999 = this->value_at_percentile (99.9) / sf;
+  ACE_UINT64 const p9999 = this->value_at_percentile (99.99) / sf;
+
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s percentile: %Q/%Q/%Q/%Q (50/99/99.9/99.99)\n"),
+              msg, p50, p99, p999, p9999));
+#else
+  ACE_UNUSED_ARG (msg);
+  ACE_UNUSED_ARG (sf);
+#endif /* ACE_NLOGGING */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,176 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    HDR_Histogram.h
+ *
+ *  A latency histogram of constant size and relative precision, from
+ *  which percentiles can be read.
+ */
+//=============================================================================
+
+#ifndef ACE_HDR_HISTOGRAM_H
+#define ACE_HDR_HISTOGRAM_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_OutputCDR;
+class ACE_InputCDR;
+
+/// Count samples in buckets of constant relative width
+/**
+ * An ACE_Sample_History stores every sample, and an ACE_Basic_Stats
+ * keeps only the minimum, average and maximum; for long runs the
+ * first takes too much memory and the second hides the tail.  This
+ * class counts the samples in buckets whose width grows with the
+ * value (a High Dynamic Range histogram): every value up to
+ * @c highest_trackable_value is known to @c significant_digits
+ * decimal digits, in a fixed amount of memory, and any percentile
+ * can be read back.
+ *
+ * record() must only be called by one thread at a time.  The usual
+ * way to measure several threads is to give each its own histogram,
+ * and add() them into a total when done; add() and record_atomic()
+ * use atomic operations only, so several threads may add into the
+ * same total, also while the histograms added are still being
+ * recorded into.
+ *
+ * Histograms can be written to and read from CDR streams in a compact
+ * form, where runs of empty buckets take a few bytes, so that they
+ * can be collected from other processes and merged.
+ */
+class ACE_Export ACE_HDR_Histogram
+{
+public:
+#if !defined (ACE_WIN32)
+   typedef ACE_UINT32 scale_factor_type;
+#else
+   typedef ACE_UINT64 scale_factor_type;
+#endif
+
+  /// Constructor
+  /**
+   * Values larger than @a highest_trackable_value are counted as
+   * @a highest_trackable_value.  @a significant_digits goes from 1
+   * to 5; three digits, the default, keep the values within 0.1%.
+   */
+  ACE_HDR_Histogram (ACE_UINT64 highest_trackable_value = ACE_UINT64_MAX,
+                     int significant_digits = 3);
+
+  /// Destructor
+  ~ACE_HDR_Histogram ();
+
+  /// Record @a count samples of @a value.
+  void record (ACE_UINT64 value, ACE_UINT64 count = 1);
+
+  /// Record a sample from any thread.
+  void record_atomic (ACE_UINT64 value, ACE_UINT64 count = 1);
+
+  /// Add the samples of @a rhs.
+  /**
+   * Histograms of any range and precision can be added, but adding
+   * one with the same precision and no larger range only adds the
+   * bucket counts.
+   */
+  void add (const ACE_HDR_Histogram &rhs);
+
+  /// Forget all the samples.
+  void reset ();
+
+  /// The number of samples recorded so far
+  ACE_UINT64 total_count () const;
+
+  /// The smallest value recorded, or 0 without samples
+  ACE_UINT64 min () const;
+
+  /// The largest value recorded, or 0 without samples
+  ACE_UINT64 max () const;
+
+  /// The average of the values recorded
+  ACE_UINT64 mean () const;
+
+  /// The value that @a percentile percent of the samples do not exceed
+  /**
+   * The value is given to the precision of the histogram, that is
+   * the largest value of its bucket, but never more than max().
+   */
+  ACE_UINT64 value_at_percentile (double percentile) const;
+
+  /// The smallest value counted in the same bucket as @a value.
+  ACE_UINT64 lowest_equivalent_value (ACE_UINT64 value) const;
+
+  /// The largest value counted in the same bucket as @a value.
+  ACE_UINT64 highest_equivalent_value (ACE_UINT64 value) const;
+
+  ACE_UINT64 highest_trackable_value () const;
+
+  int significant_digits () const;
+
+  /// Write the histogram to @a cdr.
+  bool encode (ACE_OutputCDR &cdr) const;
+
+  /// Read a histogram written by encode() from @a cdr, and add its
+  /// samples to this one.
+  bool decode (ACE_InputCDR &cdr);
+
+  /// Print the 50th, 99th, 99.9th and 99.99th percentiles
+  /**
+   * Uses @a msg as a prefix and scales the values by
+   * @a scale_factor, as ACE_Basic_Stats::dump_results() does.
+   */
+  void dump_results (const ACE_TCHAR *msg,
+                     scale_factor_type scale_factor) const;
+
+private:
+  /// Index of the power of two above the sub buckets holding @a value.
+  int bucket_index (ACE_UINT64 value) const;
+
+  /// Index of the counter of @a value.
+  size_t counts_index (ACE_UINT64 value) const;
+
+  /// The smallest value counted in counter @a index.
+  ACE_UINT64 value_at_index (size_t index) const;
+
+  /// Bring @a value down to the range of the histogram.
+  ACE_UINT64 clamp (ACE_UINT64 value) const;
+
+  static int count_leading_zeros (ACE_UINT64 value);
+
+  ACE_UINT64 highest_trackable_value_;
+  int significant_digits_;
+
+  /// The first bucket has twice as many sub buckets as the others,
+  /// which only count the upper half of theirs.
+  int sub_bucket_half_count_magnitude_;
+  ACE_UINT64 sub_bucket_half_count_;
+  ACE_UINT64 sub_bucket_mask_;
+
+  size_t counts_length_;
+  std::atomic<ACE_UINT64> *counts_;
+
+  std::atomic<ACE_UINT64> total_count_;
+  std::atomic<ACE_UINT64> min_;
+  std::atomic<ACE_UINT64> max_;
+
+  ACE_HDR_Histogram (const ACE_HDR_Histogram &) = delete;
+  void operator= (const ACE_HDR_Histogram &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/HDR_Histogram.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_HDR_HISTOGRAM_H */
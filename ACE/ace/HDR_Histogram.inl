@@ -0,0 +1,95 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE int
+ACE_HDR_Histogram::count_leading_zeros (ACE_UINT64 value)
+{
+#if defined (__GNUC__) || defined (__clang__)
+  return __builtin_clzll (value);
+#else
+  int n = 0;
+  for (ACE_UINT64 bit = ACE_UINT64 (1) << 63; (value & bit) == 0; bit >>= 1)
+    ++n;
+  return n;
+#endif /* __GNUC__ || __clang__ */
+}
+
+ACE_INLINE int
+ACE_HDR_Histogram::bucket_index (ACE_UINT64 value) const
+{
+  // The mask keeps values in the first bucket at index 0.
+  return 64 - count_leading_zeros (value | this->sub_bucket_mask_)
+    - (this->sub_bucket_half_count_magnitude_ + 1);
+}
+
+ACE_INLINE size_t
+ACE_HDR_Histogram::counts_index (ACE_UINT64 value) const
+{
+  int const bucket = this->bucket_index (value);
+  ACE_UINT64 const sub_bucket = value >> bucket;
+  return static_cast<size_t> (
+    (ACE_UINT64 (bucket + 1) << this->sub_bucket_half_count_magnitude_)
+    + (sub_bucket - this->sub_bucket_half_count_));
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::clamp (ACE_UINT64 value) const
+{
+  return value > this->highest_trackable_value_
+    ? this->highest_trackable_value_
+    : value;
+}
+
+ACE_INLINE void
+ACE_HDR_Histogram::record (ACE_UINT64 value, ACE_UINT64 count)
+{
+  value = this->clamp (value);
+
+  // Only this thread writes, so there is no need for atomic
+  // increments; the atomic loads and stores keep readers safe.
+  std::atomic<ACE_UINT64> &counter = this->counts_[this->counts_index (value)];
+  counter.store (counter.load (std::memory_order_relaxed) + count,
+                 std::memory_order_relaxed);
+  this->total_count_.store (
+    this->total_count_.load (std::memory_order_relaxed) + count,
+    std::memory_order_relaxed);
+
+  if (value < this->min_.load (std::memory_order_relaxed))
+    this->min_.store (value, std::memory_order_relaxed);
+  if (value > this->max_.load (std::memory_order_relaxed))
+    this->max_.store (value, std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::total_count () const
+{
+  return this->total_count_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::min () const
+{
+  return this->total_count () == 0
+    ? 0
+    : this->min_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::max () const
+{
+  return this->max_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::highest_trackable_value () const
+{
+  return this->highest_trackable_value_;
+}
+
+ACE_INLINE int
+ACE_HDR_Histogram::significant_digits () const
+{
+  return this->significant_digits_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,581 @@
+#ifndef ACE_LOCK_FREE_MESSAGE_QUEUE_T_CPP
+#define ACE_LOCK_FREE_MESSAGE_QUEUE_T_CPP
+
+#include "ace/Lock_Free_Message_Queue_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Notification_Strategy.h"
+#include "ace/Truncate.h"
+#include "ace/OS_NS_Thread.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tyc(ACE_Lock_Free_Message_Queue)
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lock_Free_Message_Queue (size_t hwm,
+                                                                                      size_t lwm,
+                                                                                      ACE_Notification_Strategy *ns,
+                                                                                      size_t max_messages)
+  : ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> (hwm, lwm, ns),
+    slots_ (0),
+    mask_ (0),
+    enqueue_pos_ (0),
+    dequeue_pos_ (0),
+    bytes_ (0),
+    length_ (0),
+    count_ (0),
+    hwm_ (hwm),
+    lwm_ (lwm),
+    state_i_ (ACE_Message_Queue_Base::ACTIVATED),
+    enqueue_waiters_ (0),
+    dequeue_waiters_ (0)
+{
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lock_Free_Message_Queue");
+
+  size_t size = 2;
+  while (size < max_messages)
+    size *= 2;
+
+  ACE_NEW (this->slots_, Slot[size]);
+  this->mask_ = size - 1;
+  for (size_t i = 0; i != size; ++i)
+    {
+      this->slots_[i].sequence_.store (i, std::memory_order_relaxed);
+      this->slots_[i].item_ = 0;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lock_Free_Message_Queue ()
+{
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lock_Free_Message_Queue");
+  if (this->slots_ != 0)
+    this->flush_i ();
+  delete [] this->slots_;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::open (size_t hwm,
+                                                               size_t lwm,
+                                                               ACE_Notification_Strategy *ns)
+{
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::open");
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  this->flush_i ();
+  this->hwm_ = hwm;
+  this->lwm_ = lwm;
+  this->state_i_ = ACE_Message_Queue_Base::ACTIVATED;
+  return ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::open (hwm, lwm, ns);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::flush_i ()
+{
+  int number_flushed = 0;
+  ACE_Message_Block *item = 0;
+  size_t left = 0;
+  while (this->pop (item, left))
+    {
+      ++number_flushed;
+      item->release ();
+    }
+  return number_flushed;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head (ACE_Message_Block *&,
+                                                                            ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::reserve (size_t count,
+                                                                  size_t bytes,
+                                                                  size_t length)
+{
+  if (this->bytes_.load (std::memory_order_relaxed)
+      >= this->hwm_.load (std::memory_order_relaxed))
+    return false;
+
+  // The count is reserved before the messages are pushed and released
+  // after they are popped, so it never falls below the number of used
+  // slots and a reservation always finds its slots free.
+  size_t current = this->count_.load (std::memory_order_relaxed);
+  do
+    {
+      if (current + count > this->mask_ + 1)
+        return false;
+    }
+  while (!this->count_.compare_exchange_weak (current,
+                                              current + count,
+                                              std::memory_order_relaxed));
+
+  this->bytes_.fetch_add (bytes, std::memory_order_relaxed);
+  this->length_.fetch_add (length, std::memory_order_relaxed);
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::push (ACE_Message_Block *item)
+{
+  size_t pos = this->enqueue_pos_.load (std::memory_order_relaxed);
+  for (;;)
+    {
+      Slot &slot = this->slots_[pos & this->mask_];
+      ptrdiff_t const diff =
+        static_cast<ptrdiff_t> (slot.sequence_.load (std::memory_order_acquire)
+                                - pos);
+      if (diff == 0)
+        {
+          if (this->enqueue_pos_.compare_exchange_weak (pos,
+                                                        pos + 1,
+                                                        std::memory_order_relaxed))
+            {
+              slot.item_ = item;
+              slot.sequence_.store (pos + 1, std::memory_order_release);
+              return;
+            }
+        }
+      else if (diff < 0)
+        {
+          // A dequeuer took the message that was in the slot but did
+          // not mark it free yet.
+          ACE_OS::thr_yield ();
+          pos = this->enqueue_pos_.load (std::memory_order_relaxed);
+        }
+      else
+        pos = this->enqueue_pos_.load (std::memory_order_relaxed);
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::pop (ACE_Message_Block *&item,
+                                                              size_t &left)
+{
+  size_t pos = this->dequeue_pos_.load (std::memory_order_relaxed);
+  for (;;)
+    {
+      Slot &slot = this->slots_[pos & this->mask_];
+      ptrdiff_t const diff =
+        static_cast<ptrdiff_t> (slot.sequence_.load (std::memory_order_acquire)
+                                - (pos + 1));
+      if (diff == 0)
+        {
+          if (this->dequeue_pos_.compare_exchange_weak (pos,
+                                                        pos + 1,
+                                                        std::memory_order_relaxed))
+            {
+              item = slot.item_;
+              slot.sequence_.store (pos + this->mask_ + 1,
+                                    std::memory_order_release);
+              break;
+            }
+        }
+      else if (diff < 0)
+        return false;
+      else
+        pos = this->dequeue_pos_.load (std::memory_order_relaxed);
+    }
+
+  size_t bytes = 0;
+  size_t length = 0;
+  item->total_size_and_length (bytes, length);
+  this->bytes_.fetch_sub (bytes, std::memory_order_relaxed);
+  this->length_.fetch_sub (length, std::memory_order_relaxed);
+  left = this->count_.fetch_sub (1, std::memory_order_relaxed) - 1;
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wake_dequeuers ()
+{
+  // Pairs with the fence in wait_pop(): either the waiter sees the
+  // new message or this thread sees the waiter.
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  if (this->dequeue_waiters_.load (std::memory_order_relaxed) > 0)
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->not_empty_cond_.signal ();
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wake_enqueuers (size_t left)
+{
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  if (this->enqueue_waiters_.load (std::memory_order_relaxed) == 0)
+    return;
+
+  // The enqueuers waiting for bytes to drain are woken up at the low
+  // water mark, those waiting for a slot as soon as one is free.
+  size_t const bytes = this->bytes_.load (std::memory_order_relaxed);
+  if (bytes <= this->lwm_.load (std::memory_order_relaxed)
+      || (left == this->mask_
+          && bytes < this->hwm_.load (std::memory_order_relaxed)))
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->not_full_cond_.signal ();
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wait_reserve (size_t count,
+                                                                       size_t bytes,
+                                                                       size_t length,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  if (this->state_i_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  ++this->enqueue_waiters_;
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  int result = 0;
+  while (!this->reserve (count, bytes, length))
+    {
+      if (this->not_full_cond_.wait (timeout) == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+      if (this->state_i_.load () != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+    }
+  --this->enqueue_waiters_;
+
+  // Only one enqueuer is woken up at a time, pass the wakeup on while
+  // there is room.
+  if (result == 0
+      && this->enqueue_waiters_.load () > 0
+      && !this->is_full_i ())
+    this->not_full_cond_.signal ();
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wait_pop (ACE_Message_Block *&item,
+                                                                   size_t &left,
+                                                                   ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  if (this->state_i_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  ++this->dequeue_waiters_;
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  int result = 0;
+  while (!this->pop (item, left))
+    {
+      if (this->not_empty_cond_.wait (timeout) == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+      if (this->state_i_.load () != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+    }
+  --this->dequeue_waiters_;
+
+  if (result == 0
+      && this->dequeue_waiters_.load () > 0
+      && !this->is_empty_i ())
+    this->not_empty_cond_.signal ();
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail");
+
+  if (new_item == 0)
+    return -1;
+
+  if (this->state_i_.load (std::memory_order_relaxed)
+      == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t count = 0;
+  size_t bytes = 0;
+  size_t length = 0;
+  for (ACE_Message_Block *mb = new_item; mb != 0; mb = mb->next ())
+    {
+      ++count;
+      mb->total_size_and_length (bytes, length);
+    }
+
+  // A chain longer than the queue would never fit.
+  if (count > this->mask_ + 1)
+    {
+      errno = ENOSPC;
+      return -1;
+    }
+
+  if (!this->reserve (count, bytes, length)
+      && this->wait_reserve (count, bytes, length, timeout) == -1)
+    return -1;
+
+  for (ACE_Message_Block *mb = new_item; mb != 0; )
+    {
+      ACE_Message_Block *next = mb->next ();
+      mb->next (0);
+      mb->prev (0);
+      this->push (mb);
+      mb = next;
+    }
+  int const queue_count =
+    ACE_Utils::truncate_cast<int> (this->count_.load (std::memory_order_relaxed));
+
+  this->wake_dequeuers ();
+  if (this->notification_strategy_ != 0)
+    this->notification_strategy_->notify ();
+  return queue_count;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_prio (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline (ACE_Message_Block *new_item,
+                                                                           ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message_Block *&first_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head");
+
+  if (this->state_i_.load (std::memory_order_relaxed)
+      == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t left = 0;
+  if (!this->pop (first_item, left)
+      && this->wait_pop (first_item, left, timeout) == -1)
+    return -1;
+
+  this->wake_enqueuers (left);
+  return ACE_Utils::truncate_cast<int> (left);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio (ACE_Message_Block *&first_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail (ACE_Message_Block *&dequeued,
+                                                                       ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (dequeued, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline (ACE_Message_Block *&dequeued,
+                                                                           ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (dequeued, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_full_i ()
+{
+  return this->bytes_.load (std::memory_order_relaxed)
+           >= this->hwm_.load (std::memory_order_relaxed)
+    || this->count_.load (std::memory_order_relaxed) > this->mask_;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_empty_i ()
+{
+  return this->count_.load (std::memory_order_relaxed) == 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_full ()
+{
+  return this->is_full_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_empty ()
+{
+  return this->is_empty_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_bytes ()
+{
+  return this->bytes_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_length ()
+{
+  return this->length_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_count ()
+{
+  return this->count_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (size_t new_size)
+{
+  this->bytes_ = new_size;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_length (size_t new_length)
+{
+  this->length_ = new_length;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark ()
+{
+  return this->hwm_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark (size_t hwm)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+  this->hwm_ = hwm;
+  this->high_water_mark_ = hwm;
+  // Raising the mark may make room for the waiting enqueuers.
+  if (this->enqueue_waiters_.load () > 0 && !this->is_full_i ())
+    this->not_full_cond_.signal ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::low_water_mark ()
+{
+  return this->lwm_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::low_water_mark (size_t lwm)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+  this->lwm_ = lwm;
+  this->low_water_mark_ = lwm;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::state ()
+{
+  return this->state_i_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::deactivated ()
+{
+  return this->state_i_.load () == ACE_Message_Queue_Base::DEACTIVATED;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::deactivate_i (int pulse)
+{
+  int const previous_state =
+    ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::deactivate_i (pulse);
+  this->state_i_ = this->state_;
+  return previous_state;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::activate_i ()
+{
+  int const previous_state =
+    ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::activate_i ();
+  this->state_i_ = this->state_;
+  return previous_state;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::max_messages () const
+{
+  return this->mask_ + 1;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("state = %d\n")
+                 ACE_TEXT ("low_water_mark = %B\n")
+                 ACE_TEXT ("high_water_mark = %B\n")
+                 ACE_TEXT ("cur_bytes = %B\n")
+                 ACE_TEXT ("cur_length = %B\n")
+                 ACE_TEXT ("cur_count = %B\n")
+                 ACE_TEXT ("max_messages = %B\n"),
+                 this->state_i_.load (),
+                 this->lwm_.load (),
+                 this->hwm_.load (),
+                 this->bytes_.load (),
+                 this->length_.load (),
+                 this->count_.load (),
+                 this->mask_ + 1));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* !ACE_LOCK_FREE_MESSAGE_QUEUE_T_CPP */
@@ -0,0 +1,247 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+ *  @file    Lock_Free_Message_Queue_T.h
+ *
+ *  An ACE_Message_Queue that does not take its lock to enqueue or
+ *  dequeue a message unless it has to wait.
+ */
+//=============================================================================
+
+#ifndef ACE_LOCK_FREE_MESSAGE_QUEUE_T_H
+#define ACE_LOCK_FREE_MESSAGE_QUEUE_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Message_Queue.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include <atomic>
+
+#if !defined (ACE_LOCK_FREE_MESSAGE_QUEUE_SIZE)
+/// Default number of messages an ACE_Lock_Free_Message_Queue holds
+/// before it is full, whatever their size.
+# define ACE_LOCK_FREE_MESSAGE_QUEUE_SIZE 1024
+#endif /* ACE_LOCK_FREE_MESSAGE_QUEUE_SIZE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Lock_Free_Message_Queue
+ *
+ * @brief A bounded FIFO ACE_Message_Queue that any number of threads
+ * can enqueue to and dequeue from without taking a lock.
+ *
+ * The messages are kept in a fixed size array of slots, each tagged
+ * with a sequence number, so enqueue and dequeue only need one
+ * compare-and-swap on the shared position when the queue is neither
+ * full nor empty.  The queue is full when the bytes queued reach the
+ * high water mark, as for ACE_Message_Queue, or when all the slots
+ * are used.  A thread only takes the lock of the queue when it has
+ * to wait: it then sleeps on the same conditions ACE_Message_Queue
+ * uses, and the other side only signals them when it knows a thread
+ * is waiting.  Waiting enqueuers are woken up once the queue drained
+ * to the low water mark.  Timeouts, deactivate(), pulse() and the
+ * notification strategy behave as in ACE_Message_Queue, so the queue
+ * can be given to an ACE_Task or an ACE_Module.
+ *
+ * The messages always come out in the order they went in: the head,
+ * priority and deadline variants of enqueue and dequeue act on the
+ * tail and head.  The blocks of a chain are queued as separate
+ * messages.  peek_dequeue_head() and the iterators are not
+ * supported, since a message may be dequeued by another thread
+ * while it is being looked at.  The high water mark may be exceeded
+ * by the size of one message per enqueuing thread.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Lock_Free_Message_Queue
+  : public ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  /**
+   * @param hwm          High water mark, in bytes.
+   * @param lwm          Low water mark, in bytes.
+   * @param ns           Notification strategy called for every
+   *                     enqueued message.
+   * @param max_messages Number of slots, rounded up to a power of two.
+   */
+  ACE_Lock_Free_Message_Queue (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                               size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                               ACE_Notification_Strategy *ns = 0,
+                               size_t max_messages = ACE_LOCK_FREE_MESSAGE_QUEUE_SIZE);
+
+  /// Release the messages still queued.
+  virtual ~ACE_Lock_Free_Message_Queue ();
+
+  virtual int open (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                    size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                    ACE_Notification_Strategy *ns = 0);
+
+  /// Release all the queued messages, returns how many there were.
+  virtual int flush_i ();
+
+  /// Not supported, returns -1 with errno set to ENOTSUP.
+  virtual int peek_dequeue_head (ACE_Message_Block *&first_item,
+                                 ACE_Time_Value *timeout = 0);
+
+  /**
+   * Enqueue @a new_item, and the blocks chained to it, at the tail of
+   * the queue, waiting until @a timeout (an absolute time) for the
+   * queue not to be full.
+   *
+   * @retval >0 The number of messages on the queue.
+   * @retval -1 On failure, with errno EWOULDBLOCK when the timeout
+   *            elapsed or ESHUTDOWN when the queue was deactivated or
+   *            pulsed.
+   */
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail().
+  virtual int enqueue_head (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail().
+  virtual int enqueue_prio (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail().
+  virtual int enqueue_deadline (ACE_Message_Block *new_item,
+                                ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue the message at the head of the queue, waiting until
+   * @a timeout (an absolute time) for the queue not to be empty.
+   *
+   * @retval >=0 The number of messages left on the queue.
+   * @retval -1  On failure, with errno EWOULDBLOCK when the timeout
+   *             elapsed or ESHUTDOWN when the queue was deactivated or
+   *             pulsed.
+   */
+  virtual int dequeue_head (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as dequeue_head().
+  virtual int dequeue_prio (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as dequeue_head().
+  virtual int dequeue_tail (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as dequeue_head().
+  virtual int dequeue_deadline (ACE_Message_Block *&dequeued,
+                                ACE_Time_Value *timeout = 0);
+
+  virtual bool is_full ();
+  virtual bool is_empty ();
+
+  virtual size_t message_bytes ();
+  virtual size_t message_length ();
+  virtual size_t message_count ();
+
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  virtual size_t high_water_mark ();
+  virtual void high_water_mark (size_t hwm);
+  virtual size_t low_water_mark ();
+  virtual void low_water_mark (size_t lwm);
+
+  virtual int state ();
+  virtual int deactivated ();
+
+  /// Number of slots.
+  size_t max_messages () const;
+
+  virtual void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  virtual bool is_full_i ();
+  virtual bool is_empty_i ();
+  virtual int deactivate_i (int pulse = 0);
+  virtual int activate_i ();
+
+  /// Reserve room for @a count messages holding @a bytes bytes, false
+  /// when the queue is full.
+  bool reserve (size_t count, size_t bytes, size_t length);
+
+  /// Put @a item in a slot reserved by reserve().
+  void push (ACE_Message_Block *item);
+
+  /// Take the message at the head, false when the queue is empty.
+  /// @a left is set to the number of messages left.
+  bool pop (ACE_Message_Block *&item, size_t &left);
+
+  /// Wake a waiting dequeuer after messages were pushed.
+  void wake_dequeuers ();
+
+  /// Wake a waiting enqueuer once the queue drained to the low water
+  /// mark or a slot was freed in a full queue, @a left messages being
+  /// left.
+  void wake_enqueuers (size_t left);
+
+  /// Wait for room for @a count messages, then reserve it.
+  int wait_reserve (size_t count,
+                    size_t bytes,
+                    size_t length,
+                    ACE_Time_Value *timeout);
+
+  /// Wait for a message, then take it.
+  int wait_pop (ACE_Message_Block *&item,
+                size_t &left,
+                ACE_Time_Value *timeout);
+
+  struct Slot
+  {
+    /// Position the slot can be written at, or position + 1 once it
+    /// holds the message for that position.
+    std::atomic<size_t> sequence_;
+    ACE_Message_Block *item_;
+  };
+
+  Slot *slots_;
+  size_t mask_;
+
+  /// Next positions to enqueue and dequeue at, kept apart so the
+  /// enqueuers and dequeuers do not share a cache line.
+  alignas (64) std::atomic<size_t> enqueue_pos_;
+  alignas (64) std::atomic<size_t> dequeue_pos_;
+
+  alignas (64) std::atomic<size_t> bytes_;
+  std::atomic<size_t> length_;
+  std::atomic<size_t> count_;
+
+  std::atomic<size_t> hwm_;
+  std::atomic<size_t> lwm_;
+  std::atomic<int> state_i_;
+
+  /// Threads sleeping in wait_reserve() and wait_pop().
+  std::atomic<int> enqueue_waiters_;
+  std::atomic<int> dequeue_waiters_;
+
+private:
+  void operator= (const ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> &) = delete;
+  ACE_Lock_Free_Message_Queue (const ACE_Lock_Free_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Lock_Free_Message_Queue_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Lock_Free_Message_Queue_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_LOCK_FREE_MESSAGE_QUEUE_T_H */
@@ -284,6 +284,8 @@ public:
 
 private:
   friend class ACE_Log_Category_TSS;
+  /// Recreates the categories of the messages it writes.
+  friend class ACE_Log_Msg_Async;
 
   // disable copying
   ACE_Log_Category(const ACE_Log_Category&);
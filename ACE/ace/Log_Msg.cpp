@@ -32,6 +32,7 @@
 #endif /* ACE_HAS_TRACE */
 
 #include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
 #include "ace/Log_Msg_Callback.h"
 #include "ace/Log_Msg_IPC.h"
 #include "ace/Log_Msg_NT_Event_Log.h"
@@ -629,7 +630,8 @@ ACE_Log_Msg::ACE_Log_Msg ()
     tracing_enabled_ (true), // On by default?
     thr_desc_ (0),
     priority_mask_ (default_priority_mask_),
-    timestamp_ (0)
+    timestamp_ (0),
+    async_ring_ (0)
 {
   // ACE_TRACE ("ACE_Log_Msg::ACE_Log_Msg");
 
@@ -729,6 +731,11 @@ ACE_Log_Msg::~ACE_Log_Msg ()
 
   this->cleanup_ostream ();
 
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+  if (this->async_ring_ != 0)
+    ACE_Log_Msg_Async::release (this->async_ring_);
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
+
 #if defined (ACE_HAS_ALLOC_HOOKS)
   ACE_Allocator::instance()->free(this->msg_);
 #else
@@ -1019,6 +1026,18 @@ ACE_Log_Msg::log (const ACE_TCHAR *format_str,
   // errno!
   ACE_Errno_Guard guard (errno);
 
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+  // Leave the formatting and writing to the background thread if
+  // asynchronous logging is open.
+  if (ACE_Log_Msg_Async::enabled ()
+      && ACE_Log_Msg_Async::instance ()->capture (*this,
+                                                  format_str,
+                                                  log_priority,
+                                                  argp,
+                                                  category))
+    return 0;
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
+
   ACE_Log_Record log_record (log_priority,
                              ACE_OS::gettimeofday (),
                              this->getpid ());
@@ -184,6 +184,8 @@ class ACE_Log_Record;
 class ACE_Log_Category_TSS;
 template<typename M, typename T> class ACE_Atomic_Op;
 class ACE_Log_Formatter;
+class ACE_Log_Msg_Async;
+class ACE_Log_Msg_Async_Ring;
 
 /**
  * @class ACE_Log_Msg
@@ -632,6 +634,8 @@ public:
   ACE_ALLOC_HOOK_DECLARE;
 
 private:
+  friend class ACE_Log_Msg_Async;
+
   void cleanup_ostream ();
 
   /// Status of operation (-1 means failure, >= 0 means success).
@@ -697,6 +701,9 @@ private:
   /// Always timestamp?
   int timestamp_;
 
+  /// Messages of this thread waiting for ACE_Log_Msg_Async.
+  ACE_Log_Msg_Async_Ring *async_ring_;
+
   // = The following fields are *not* kept in thread-specific storage.
 
   // We only want one instance for the entire process!
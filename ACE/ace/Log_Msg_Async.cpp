@@ -0,0 +1,1557 @@
+#include "ace/Log_Msg_Async.h"
+
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+
+#include "ace/ACE.h"
+#include "ace/CDR_Base.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/Object_Manager.h"
+#include "ace/Static_Object_Lock.h"
+#include "ace/Thread.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Log_Msg_Async.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Kinds of the entries in a ring and in the binary file.
+  enum
+  {
+    ENTRY_PADDING = 0,
+    ENTRY_MESSAGE = 1,
+    ENTRY_FORMAT = 2,
+    ENTRY_NAMES = 3
+  };
+
+  /// Marks a null string argument.
+  const ACE_UINT32 NULL_STRING = 0xffffffff;
+
+  /// Version of the binary file format.
+  const char FILE_MAGIC[8] = { 'A', 'C', 'E', 'L', 'O', 'G', 'B', '1' };
+
+  /**
+   * A message in a ring.  It is followed by the arguments of the
+   * message, in the order the format string consumes them.  Besides
+   * the caller's arguments they hold the values the ACE directives
+   * refer to that may have changed by the time the message is
+   * formatted, like %N and %l.
+   */
+  struct Message
+  {
+    /// Bytes taken in the ring, including this header.
+    ACE_UINT32 size;
+    ACE_UINT32 kind;
+    const ACE_TCHAR *format;
+    /// Id of the category the message was logged in, its name
+    /// follows the arguments.  0 for no category.
+    ACE_UINT32 category_id;
+    ACE_INT64 sec;
+    ACE_INT32 usec;
+    ACE_INT32 priority;
+    ACE_INT32 errnum;
+    ACE_INT32 timestamp;
+    /// Bytes of arguments.
+    ACE_UINT32 length;
+  };
+
+  /// Messages start on this boundary in a ring.
+  const size_t ALIGNMENT = 8;
+
+  inline size_t
+  align (size_t size)
+  {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  const size_t MESSAGE_HEADER_SIZE = align (sizeof (Message));
+
+  /// Appends values to a buffer, remembers when it ran out of room.
+  class Arg_Writer
+  {
+  public:
+    Arg_Writer (char *buffer, size_t size)
+      : start_ (buffer), pos_ (buffer), end_ (buffer + size), ok_ (true)
+    {
+    }
+
+    template <typename T> void put (T value)
+    {
+      if (static_cast<size_t> (this->end_ - this->pos_) < sizeof value)
+        {
+          this->ok_ = false;
+          return;
+        }
+      ACE_OS::memcpy (this->pos_, &value, sizeof value);
+      this->pos_ += sizeof value;
+    }
+
+    void put_string (const char *s)
+    {
+      if (s == 0)
+        {
+          this->put (NULL_STRING);
+          return;
+        }
+      size_t length = 0;
+      while (length != ACE_MAXLOGMSGLEN && s[length] != '\0')
+        ++length;
+      this->put_bytes (s, length);
+    }
+
+    void put_bytes (const char *s, size_t length)
+    {
+      this->put (static_cast<ACE_UINT32> (length));
+      if (static_cast<size_t> (this->end_ - this->pos_) < length)
+        {
+          this->ok_ = false;
+          return;
+        }
+      ACE_OS::memcpy (this->pos_, s, length);
+      this->pos_ += length;
+    }
+
+    size_t length () const { return this->pos_ - this->start_; }
+    bool ok () const { return this->ok_; }
+
+  private:
+    char *start_;
+    char *pos_;
+    char *end_;
+    bool ok_;
+  };
+
+  /// Reads the values written by Arg_Writer, yields zeroes when they
+  /// run out.
+  class Arg_Reader
+  {
+  public:
+    Arg_Reader (const char *buffer, size_t size)
+      : pos_ (buffer), end_ (buffer + size)
+    {
+    }
+
+    template <typename T> T get ()
+    {
+      T value = T ();
+      if (static_cast<size_t> (this->end_ - this->pos_) >= sizeof value)
+        {
+          ACE_OS::memcpy (&value, this->pos_, sizeof value);
+          this->pos_ += sizeof value;
+        }
+      else
+        this->pos_ = this->end_;
+      return value;
+    }
+
+    /// Copy a string into @a buf, returns false for a null string.
+    bool get_string (ACE_TCHAR *buf, size_t size)
+    {
+      ACE_UINT32 const length = this->get<ACE_UINT32> ();
+      buf[0] = '\0';
+      if (length == NULL_STRING)
+        return false;
+      size_t const avail = this->end_ - this->pos_;
+      size_t const n = length < avail ? length : avail;
+      size_t const copy = n < size - 1 ? n : size - 1;
+      ACE_OS::memcpy (buf, this->pos_, copy);
+      buf[copy] = '\0';
+      this->pos_ += n;
+      return true;
+    }
+
+    const char *pos () const { return this->pos_; }
+    bool done () const { return this->pos_ == this->end_; }
+
+  private:
+    const char *pos_;
+    const char *end_;
+  };
+
+  /// Hand @a log_record to the sinks of @a log_msg, leaving out its
+  /// ostream and callback: the thread that logged had neither, see
+  /// ACE_Log_Msg_Async::capture().
+  void
+  write_record (ACE_Log_Msg &log_msg, ACE_Log_Record &log_record)
+  {
+    ACE_OSTREAM_TYPE *const ostream = log_msg.msg_ostream ();
+    log_msg.msg_ostream (0);
+    ACE_Log_Msg_Callback *const callback = log_msg.msg_callback (0);
+    log_msg.log (log_record, 0);
+    log_msg.msg_callback (callback);
+    log_msg.msg_ostream (ostream);
+  }
+
+  /// Everything the formatting of a message needs besides its
+  /// arguments.
+  struct Message_Context
+  {
+    const ACE_TCHAR *format;
+    ACE_Log_Priority priority;
+    ACE_Time_Value time;
+    int errnum;
+    int timestamp;
+    bool verbose;
+    long pid;
+    const char *tid;
+    const ACE_TCHAR *program_name;
+  };
+
+  /**
+   * Copy the arguments the ACE directives of @a format take into
+   * @a args.  Returns false when the format holds a directive that
+   * has to be formatted in the calling thread.
+   */
+  bool
+  encode_args (ACE_Log_Msg &log_msg,
+               const ACE_TCHAR *format,
+               va_list argp,
+               Arg_Writer &args)
+  {
+    for (const ACE_TCHAR *f = format; *f != '\0'; ++f)
+      {
+        if (*f != '%')
+          continue;
+        if (f[1] == '%')
+          {
+            ++f;
+            continue;
+          }
+
+        bool const pound = f[1] == '#';
+        bool is_long = false;
+        bool done = false;
+        ++f;
+        while (!done)
+          {
+            done = true;
+            switch (*f)
+              {
+              case '-': case '+': case '0': case ' ': case '#':
+              case '1': case '2': case '3': case '4': case '5':
+              case '6': case '7': case '8': case '9':
+              case '.': case 'h':
+                done = false;
+                break;
+              case 'L':
+                is_long = true;
+                done = false;
+                break;
+              case '*':
+                args.put (va_arg (argp, int));
+                done = false;
+                break;
+
+              case 'A':
+              case 'F': case 'f': case 'e': case 'E': case 'g': case 'G':
+                args.put (va_arg (argp, double));
+                break;
+              case 'l':
+                args.put (log_msg.linenum ());
+                break;
+              case 'N':
+                args.put_string (log_msg.file ());
+                break;
+              case 'n':
+                args.put_string (ACE_Log_Msg::program_name ());
+                break;
+              case 'p':
+              case 's':
+              case 'C':
+                args.put_string (va_arg (argp, char *));
+                break;
+              case 'R':
+                {
+                  int const status = va_arg (argp, int);
+                  log_msg.op_status (status);
+                  args.put (status);
+                }
+                break;
+              case 'S':
+              case 'c':
+              case 'w':
+                args.put (va_arg (argp, int));
+                break;
+              case 'D':
+              case 'T':
+                if (pound)
+                  {
+                    ACE_Time_Value const *tv =
+                      va_arg (argp, ACE_Time_Value *);
+                    args.put (static_cast<ACE_INT64> (tv->sec ()));
+                    args.put (static_cast<ACE_INT32> (tv->usec ()));
+                  }
+                break;
+              case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                if (is_long)
+                  args.put (va_arg (argp, long));
+                else
+                  args.put (va_arg (argp, int));
+                break;
+              case 'Q':
+                args.put (va_arg (argp, ACE_UINT64));
+                break;
+              case 'q':
+                args.put (va_arg (argp, ACE_INT64));
+                break;
+              case 'b':
+                args.put (va_arg (argp, ssize_t));
+                break;
+              case 'B':
+                args.put (va_arg (argp, size_t));
+                break;
+              case ':':
+                args.put (va_arg (argp, time_t));
+                break;
+              case '@':
+                args.put (va_arg (argp, void *));
+                break;
+
+              // Abort, call a function, print a stack trace, wide
+              // strings and indentation need the calling thread.
+              case 'a': case 'r': case '?': case 'W': case 'z': case 'Z':
+              case '{': case '}': case '$': case 'I':
+                return false;
+
+              // The context is in the message header.
+              case 'M': case 'm': case 'P': case 't':
+              default:
+                break;
+              }
+            if (!done)
+              ++f;
+          }
+        if (*f == '\0')
+          break;
+      }
+    return args.ok ();
+  }
+
+  /// Format one conversion into the message, keeping room for the
+  /// terminating NUL.
+  template <typename T>
+  void
+  append (ACE_TCHAR *&bp, size_t &bspace, const ACE_TCHAR *spec, T value)
+  {
+    int const len = ACE_OS::snprintf (bp, bspace, spec, value);
+    if (len <= 0)
+      return;
+    size_t const written =
+      static_cast<size_t> (len) < bspace ? static_cast<size_t> (len) : bspace - 1;
+    bp += written;
+    bspace -= written;
+  }
+
+  void
+  append_text (ACE_TCHAR *&bp, size_t &bspace, const ACE_TCHAR *s)
+  {
+    for (; bspace > 1 && *s != '\0'; ++s, --bspace)
+      *bp++ = *s;
+  }
+
+  ACE_TCHAR
+  priority_char (ACE_Log_Priority p)
+  {
+    switch (p)
+      {
+      case LM_SHUTDOWN: return 'S';
+      case LM_TRACE: return 'T';
+      case LM_DEBUG: return 'D';
+      case LM_INFO: return 'I';
+      case LM_NOTICE: return 'N';
+      case LM_WARNING: return 'W';
+      case LM_STARTUP: return 'U';
+      case LM_ERROR: return 'E';
+      case LM_CRITICAL: return 'C';
+      case LM_ALERT: return 'A';
+      case LM_EMERGENCY: return '!';
+      default: return '?';
+      }
+  }
+
+  /**
+   * Format a message the way ACE_Log_Msg::log() does into @a msg,
+   * which holds ACE_MAXLOGMSGLEN + 1 characters.
+   */
+  void
+  format_message (const Message_Context &ctx, Arg_Reader &args, ACE_TCHAR *msg)
+  {
+    ACE_TCHAR *bp = msg;
+    size_t bspace = ACE_MAXLOGMSGLEN + 1;
+
+    if (ctx.verbose && ctx.program_name != 0)
+      {
+        append_text (bp, bspace, ctx.program_name);
+        append_text (bp, bspace, ACE_TEXT ("|"));
+      }
+
+    if (ctx.timestamp > 0)
+      {
+        ACE_TCHAR day_and_time[27];
+        const ACE_TCHAR *s =
+          ACE::timestamp (ctx.time,
+                          day_and_time,
+                          sizeof (day_and_time) / sizeof (ACE_TCHAR),
+                          ctx.timestamp == 1);
+        append_text (bp, bspace, ctx.timestamp == 1 ? s : day_and_time);
+        append_text (bp, bspace, ACE_TEXT ("|"));
+      }
+
+    const ACE_TCHAR *format_str = ctx.format;
+    while (*format_str != '\0' && bspace > 1)
+      {
+        if (*format_str != '%')
+          {
+            *bp++ = *format_str++;
+            --bspace;
+            continue;
+          }
+        if (format_str[1] == '%')
+          {
+            *bp++ = '%';
+            --bspace;
+            format_str += 2;
+            continue;
+          }
+
+        const ACE_TCHAR *start_format = format_str;
+        ACE_TCHAR spec[128];
+        ACE_TCHAR *fp = spec;
+        ACE_TCHAR *const spec_end = spec + sizeof spec / sizeof (ACE_TCHAR) - 16;
+        bool is_long = false;
+        bool done = false;
+        *fp++ = *format_str++;
+        while (!done)
+          {
+            done = true;
+            switch (*format_str)
+              {
+              case '-': case '+': case '0': case ' ': case '#':
+              case '1': case '2': case '3': case '4': case '5':
+              case '6': case '7': case '8': case '9':
+              case '.': case 'h':
+                if (fp < spec_end)
+                  *fp++ = *format_str;
+                done = false;
+                break;
+              case 'L':
+                if (fp < spec_end)
+                  *fp++ = 'l';
+                is_long = true;
+                done = false;
+                break;
+              case '*':
+                {
+                  int const wp = args.get<int> ();
+                  int const len =
+                    ACE_OS::snprintf (fp, spec_end - fp, ACE_TEXT ("%d"), wp);
+                  if (len > 0 && fp + len < spec_end)
+                    fp += len;
+                  done = false;
+                }
+                break;
+
+              case 'A':
+                ACE_OS::strcpy (fp, ACE_TEXT ("f"));
+                append (bp, bspace, spec, args.get<double> ());
+                break;
+              case 'F': case 'f': case 'e': case 'E': case 'g': case 'G':
+                fp[0] = *format_str;
+                fp[1] = '\0';
+                append (bp, bspace, spec, args.get<double> ());
+                break;
+              case 'l':
+              case 'R':
+                ACE_OS::strcpy (fp, ACE_TEXT ("d"));
+                append (bp, bspace, spec, args.get<int> ());
+                break;
+              case 'N':
+              case 'n':
+                {
+                  ACE_TCHAR str[MAXPATHLEN + 1];
+                  if (!args.get_string (str, sizeof str / sizeof (ACE_TCHAR)))
+                    ACE_OS::strcpy (str, *format_str == 'N'
+                                           ? ACE_TEXT ("<unknown file>")
+                                           : ACE_TEXT ("<unknown>"));
+                  ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                  append (bp, bspace, spec, str);
+                }
+                break;
+              case 'P':
+                ACE_OS::strcpy (fp, ACE_TEXT ("d"));
+                append (bp, bspace, spec, static_cast<int> (ctx.pid));
+                break;
+              case 'p':
+              case 's':
+              case 'C':
+                {
+                  ACE_TCHAR str[ACE_MAXLOGMSGLEN + 1];
+                  if (!args.get_string (str, sizeof str / sizeof (ACE_TCHAR)))
+                    ACE_OS::strcpy (str, ACE_TEXT ("(null)"));
+                  if (*format_str == 'p')
+                    {
+                      ACE_OS::strcpy (fp, ACE_TEXT ("s: %s"));
+                      int const len =
+                        ACE_OS::snprintf (bp, bspace, spec, str,
+                                          ACE_OS::strerror (ACE::map_errno (ctx.errnum)));
+                      if (len > 0)
+                        {
+                          size_t const written =
+                            static_cast<size_t> (len) < bspace
+                              ? static_cast<size_t> (len) : bspace - 1;
+                          bp += written;
+                          bspace -= written;
+                        }
+                    }
+                  else
+                    {
+                      ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                      append (bp, bspace, spec, str);
+                    }
+                }
+                break;
+              case 'M':
+                if (spec[1] == '.' && spec[2] == '1')
+                  {
+                    ACE_OS::strcpy (spec + 1, ACE_TEXT ("c"));
+                    append (bp, bspace, spec,
+                            static_cast<int> (priority_char (ctx.priority)));
+                  }
+                else
+                  {
+                    ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                    append (bp, bspace, spec,
+                            ACE_Log_Record::priority_name (ctx.priority));
+                  }
+                break;
+              case 'm':
+                ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                append (bp, bspace, spec,
+                        ACE_OS::strerror (ACE::map_errno (ctx.errnum)));
+                break;
+              case 'S':
+                ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                append (bp, bspace, spec, ACE_OS::strsignal (args.get<int> ()));
+                break;
+              case 'D':
+              case 'T':
+                {
+                  ACE_Time_Value tv = ctx.time;
+                  if (spec[1] == '#')
+                    {
+                      ACE_INT64 const sec = args.get<ACE_INT64> ();
+                      ACE_INT32 const usec = args.get<ACE_INT32> ();
+                      tv.set (static_cast<time_t> (sec), usec);
+                    }
+                  ACE_TCHAR day_and_time[27];
+                  const ACE_TCHAR *s =
+                    ACE::timestamp (tv,
+                                    day_and_time,
+                                    sizeof (day_and_time) / sizeof (ACE_TCHAR),
+                                    true);
+                  ACE_OS::strcpy (fp, ACE_TEXT ("s"));
+                  append (bp, bspace, spec,
+                          *format_str == 'D' ? day_and_time : s);
+                }
+                break;
+              case 't':
+                append_text (bp, bspace, ctx.tid);
+                break;
+              case 'c':
+                ACE_OS::strcpy (fp, ACE_TEXT ("c"));
+                append (bp, bspace, spec, args.get<int> ());
+                break;
+              case 'w':
+                ACE_OS::strcpy (fp, ACE_TEXT ("u"));
+                append (bp, bspace, spec, args.get<int> ());
+                break;
+              case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                fp[0] = *format_str;
+                fp[1] = '\0';
+                if (is_long)
+                  append (bp, bspace, spec, args.get<long> ());
+                else
+                  append (bp, bspace, spec, args.get<int> ());
+                break;
+              case 'Q':
+                ACE_OS::strcpy (fp, &ACE_UINT64_FORMAT_SPECIFIER[1]);
+                append (bp, bspace, spec, args.get<ACE_UINT64> ());
+                break;
+              case 'q':
+                ACE_OS::strcpy (fp, &ACE_INT64_FORMAT_SPECIFIER[1]);
+                append (bp, bspace, spec, args.get<ACE_INT64> ());
+                break;
+              case 'b':
+                ACE_OS::strcpy (fp, &ACE_SSIZE_T_FORMAT_SPECIFIER[1]);
+                append (bp, bspace, spec, args.get<ssize_t> ());
+                break;
+              case 'B':
+                ACE_OS::strcpy (fp, &ACE_SIZE_T_FORMAT_SPECIFIER[1]);
+                append (bp, bspace, spec, args.get<size_t> ());
+                break;
+              case ':':
+                if (sizeof (time_t) == 8)
+                  ACE_OS::strcpy (fp, &ACE_INT64_FORMAT_SPECIFIER[1]);
+                else
+                  ACE_OS::strcpy (fp, ACE_TEXT ("d"));
+                append (bp, bspace, spec, args.get<time_t> ());
+                break;
+              case '@':
+                ACE_OS::strcpy (fp, ACE_TEXT ("p"));
+                append (bp, bspace, spec, args.get<void *> ());
+                break;
+
+              case '\0':
+                // A % at the end of the format, print it as is.
+                for (; start_format != format_str && bspace > 1; --bspace)
+                  *bp++ = *start_format++;
+                --format_str;
+                break;
+
+              default:
+                // Not a directive after all, print it as is.
+                for (; start_format != format_str && bspace > 1; --bspace)
+                  *bp++ = *start_format++;
+                if (bspace > 1)
+                  {
+                    *bp++ = *format_str;
+                    --bspace;
+                  }
+                break;
+              }
+            ++format_str;
+          }
+      }
+    *bp = '\0';
+  }
+
+  /// Write one entry of the binary file.
+  bool
+  write_entry (FILE *file,
+               ACE_UINT32 kind,
+               const char *head, size_t head_length,
+               const char *body, size_t body_length)
+  {
+    ACE_UINT32 header[2];
+    header[0] = kind;
+    header[1] = static_cast<ACE_UINT32> (head_length + body_length);
+    return ACE_OS::fwrite (header, sizeof header, 1, file) == 1
+      && (head_length == 0
+          || ACE_OS::fwrite (head, head_length, 1, file) == 1)
+      && (body_length == 0
+          || ACE_OS::fwrite (body, body_length, 1, file) == 1);
+  }
+}
+
+/**
+ * @class ACE_Log_Msg_Async_Ring
+ *
+ * @brief The messages of one thread that were not written yet.
+ *
+ * Only the owning thread appends to the ring and only the background
+ * thread removes from it, each updating its own position.
+ */
+class ACE_Log_Msg_Async_Ring
+{
+public:
+  explicit ACE_Log_Msg_Async_Ring (size_t size);
+  ~ACE_Log_Msg_Async_Ring ();
+
+  bool valid () const;
+
+  /// Largest message push() accepts.
+  size_t max_message () const;
+
+  /// Append the message of @a size bytes in staging_, waiting for
+  /// room.  Returns true when it had to wait.
+  bool push (size_t size);
+
+  /// The oldest message not written yet, 0 when there is none.
+  const Message *front ();
+
+  /// Remove the oldest message.
+  void pop ();
+
+  /// Is the position @a pos already written?
+  bool passed (ACE_UINT64 pos) const;
+
+  ACE_UINT64 tail () const;
+
+  /// Built by the owning thread before push().
+  char *staging_;
+  size_t staging_size_;
+
+  /// Set while the owning thread is in capture().
+  std::atomic<bool> busy_;
+
+  /// In the list of ACE_Log_Msg_Async, guarded by its lock.
+  bool linked_;
+
+  /// The owning thread exited, guarded by the lock of
+  /// ACE_Log_Msg_Async.
+  bool orphaned_;
+
+  /// The open() the ring was linked in.
+  unsigned long generation_;
+
+  ACE_Log_Msg_Async_Ring *next_;
+
+  /// Thread id of the owning thread, as %t prints it.
+  char tid_[32];
+
+private:
+  char *buffer_;
+  size_t capacity_;
+
+  /// Keep the positions each side updates on their own cache line.
+  char pad0_[64];
+  std::atomic<ACE_UINT64> tail_;
+  char pad1_[64];
+  std::atomic<ACE_UINT64> head_;
+  char pad2_[64];
+};
+
+ACE_Log_Msg_Async_Ring::ACE_Log_Msg_Async_Ring (size_t size)
+  : staging_ (0),
+    staging_size_ (2 * ACE_MAXLOGMSGLEN),
+    busy_ (false),
+    linked_ (false),
+    orphaned_ (false),
+    generation_ (0),
+    next_ (0),
+    buffer_ (0),
+    capacity_ (1024),
+    tail_ (0),
+    head_ (0)
+{
+  // A power of two with room for two of the largest messages.
+  while (this->capacity_ < size || this->capacity_ < 2 * this->staging_size_)
+    this->capacity_ *= 2;
+
+  ACE_NEW_NORETURN (this->buffer_, char[this->capacity_]);
+  ACE_NEW_NORETURN (this->staging_, char[this->staging_size_]);
+
+#if defined (ACE_HAS_GETTID)
+  ACE_OS::thr_gettid (this->tid_, sizeof this->tid_);
+#else
+  ACE_OS::thr_id (this->tid_, sizeof this->tid_);
+#endif /* ACE_HAS_GETTID */
+}
+
+ACE_Log_Msg_Async_Ring::~ACE_Log_Msg_Async_Ring ()
+{
+  delete [] this->buffer_;
+  delete [] this->staging_;
+}
+
+bool
+ACE_Log_Msg_Async_Ring::valid () const
+{
+  return this->buffer_ != 0 && this->staging_ != 0;
+}
+
+size_t
+ACE_Log_Msg_Async_Ring::max_message () const
+{
+  return this->capacity_ / 2;
+}
+
+bool
+ACE_Log_Msg_Async_Ring::push (size_t size)
+{
+  bool waited = false;
+  ACE_UINT64 tail = this->tail_.load (std::memory_order_relaxed);
+  size_t offset = static_cast<size_t> (tail & (this->capacity_ - 1));
+  size_t const contiguous = this->capacity_ - offset;
+  size_t const needed = size <= contiguous ? size : contiguous + size;
+
+  while (this->capacity_ -
+         (tail - this->head_.load (std::memory_order_acquire)) < needed)
+    {
+      waited = true;
+      ACE_OS::thr_yield ();
+    }
+
+  if (size > contiguous)
+    {
+      // Messages are never split, skip the end of the buffer.
+      Message *padding = reinterpret_cast<Message *> (this->buffer_ + offset);
+      padding->size = static_cast<ACE_UINT32> (contiguous);
+      padding->kind = ENTRY_PADDING;
+      tail += contiguous;
+      offset = 0;
+    }
+
+  ACE_OS::memcpy (this->buffer_ + offset, this->staging_, size);
+  this->tail_.store (tail + size, std::memory_order_release);
+  return waited;
+}
+
+const Message *
+ACE_Log_Msg_Async_Ring::front ()
+{
+  ACE_UINT64 head = this->head_.load (std::memory_order_relaxed);
+  while (head != this->tail_.load (std::memory_order_acquire))
+    {
+      const Message *message = reinterpret_cast<const Message *>
+        (this->buffer_ + (head & (this->capacity_ - 1)));
+      if (message->kind != ENTRY_PADDING)
+        return message;
+      head += message->size;
+      this->head_.store (head, std::memory_order_release);
+    }
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async_Ring::pop ()
+{
+  const Message *message = this->front ();
+  if (message != 0)
+    this->head_.store (this->head_.load (std::memory_order_relaxed)
+                       + message->size,
+                       std::memory_order_release);
+}
+
+bool
+ACE_Log_Msg_Async_Ring::passed (ACE_UINT64 pos) const
+{
+  return this->head_.load (std::memory_order_acquire) >= pos;
+}
+
+ACE_UINT64
+ACE_Log_Msg_Async_Ring::tail () const
+{
+  return this->tail_.load (std::memory_order_acquire);
+}
+
+/**
+ * @class ACE_Log_Msg_Async_Formats
+ *
+ * @brief Format strings of the binary file and the names in its
+ * header.
+ */
+class ACE_Log_Msg_Async_Formats
+{
+public:
+  /// Ids of the format strings written so far.
+  std::map<const ACE_TCHAR *, ACE_UINT32> ids_;
+
+  /// Format strings read so far.
+  std::map<ACE_UINT32, std::basic_string<ACE_TCHAR> > formats_;
+
+  std::basic_string<ACE_TCHAR> program_name_;
+  std::basic_string<ACE_TCHAR> host_name_;
+};
+
+ACE_Log_Msg_Async *ACE_Log_Msg_Async::instance_ = 0;
+std::atomic<bool> ACE_Log_Msg_Async::enabled_ (false);
+
+ACE_Log_Msg_Async *
+ACE_Log_Msg_Async::instance ()
+{
+  if (ACE_Log_Msg_Async::instance_ == 0)
+    {
+      ACE_MT (ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex, ace_mon,
+                                *ACE_Static_Object_Lock::instance (), 0));
+      if (ACE_Log_Msg_Async::instance_ == 0)
+        {
+          ACE_Log_Msg_Async *async = 0;
+          ACE_NEW_RETURN (async, ACE_Log_Msg_Async, 0);
+          ACE_Object_Manager::at_exit (async, 0, "ACE_Log_Msg_Async");
+          ACE_Log_Msg_Async::instance_ = async;
+        }
+    }
+  return ACE_Log_Msg_Async::instance_;
+}
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async ()
+  : rings_ (0),
+    generation_ (0),
+    ring_size_ (ACE_LOG_MSG_ASYNC_RING_SIZE),
+    stop_ (false),
+    running_ (false),
+    thread_handle_ (),
+    drain_log_msg_ (0),
+    captured_ (0),
+    full_waits_ (0),
+    binary_ (0),
+    formats_ (0),
+    msg_ (0)
+{
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async ()
+{
+  this->close ();
+
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+    // The rings still belong to their ACE_Log_Msg.
+    for (ACE_Log_Msg_Async_Ring *ring = this->rings_; ring != 0; )
+      {
+        ACE_Log_Msg_Async_Ring *next = ring->next_;
+        ring->linked_ = false;
+        ring->next_ = 0;
+        ring = next;
+      }
+    this->rings_ = 0;
+    ACE_Log_Msg_Async::instance_ = 0;
+  }
+
+  delete [] this->msg_;
+}
+
+int
+ACE_Log_Msg_Async::open (size_t ring_size,
+                         const ACE_TCHAR *binary_file,
+                         const ACE_Time_Value &idle_interval)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+  if (this->running_)
+    return 0;
+
+  if (this->msg_ == 0)
+    ACE_NEW_RETURN (this->msg_, ACE_TCHAR[ACE_MAXLOGMSGLEN + 1], -1);
+
+  if (binary_file != 0)
+    {
+      this->binary_ = ACE_OS::fopen (binary_file, ACE_TEXT ("wb"));
+      if (this->binary_ == 0)
+        return -1;
+      ACE_NEW_NORETURN (this->formats_, ACE_Log_Msg_Async_Formats);
+      if (this->formats_ == 0 || this->write_file_header () != 0)
+        {
+          ACE_OS::fclose (this->binary_);
+          this->binary_ = 0;
+          delete this->formats_;
+          this->formats_ = 0;
+          return -1;
+        }
+    }
+
+  this->ring_size_ = ring_size;
+  this->idle_interval_ = idle_interval;
+  this->stop_ = false;
+  ++this->generation_;
+
+  if (ACE_Thread::spawn (ACE_Log_Msg_Async::drain_thread,
+                         this,
+                         THR_NEW_LWP | THR_JOINABLE,
+                         0,
+                         &this->thread_handle_) == -1)
+    {
+      if (this->binary_ != 0)
+        {
+          ACE_OS::fclose (this->binary_);
+          this->binary_ = 0;
+          delete this->formats_;
+          this->formats_ = 0;
+        }
+      return -1;
+    }
+
+  this->running_ = true;
+  ACE_Log_Msg_Async::enabled_ = true;
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::close ()
+{
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+    if (!this->running_)
+      return 0;
+    ACE_Log_Msg_Async::enabled_ = false;
+  }
+
+  // Wait for the threads that saw asynchronous logging still open.
+  for (bool busy = true; busy; )
+    {
+      {
+        ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+        busy = false;
+        for (ACE_Log_Msg_Async_Ring *ring = this->rings_;
+             ring != 0 && !busy;
+             ring = ring->next_)
+          busy = ring->busy_.load ();
+      }
+      if (busy)
+        ACE_OS::thr_yield ();
+    }
+
+  this->stop_ = true;
+  ACE_Thread::join (this->thread_handle_);
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+  this->reap ();
+  this->running_ = false;
+  this->drain_log_msg_ = 0;
+  if (this->binary_ != 0)
+    {
+      ACE_OS::fclose (this->binary_);
+      this->binary_ = 0;
+      delete this->formats_;
+      this->formats_ = 0;
+    }
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::flush ()
+{
+  std::vector<std::pair<ACE_Log_Msg_Async_Ring *, ACE_UINT64> > pending;
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+    if (!this->running_ || ACE_Log_Msg::instance () == this->drain_log_msg_)
+      return 0;
+    for (ACE_Log_Msg_Async_Ring *ring = this->rings_;
+         ring != 0;
+         ring = ring->next_)
+      pending.push_back (std::make_pair (ring, ring->tail ()));
+  }
+
+  while (!pending.empty ())
+    {
+      ACE_OS::sleep (this->idle_interval_);
+
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+      if (!this->running_)
+        break;
+      std::vector<std::pair<ACE_Log_Msg_Async_Ring *, ACE_UINT64> > left;
+      for (size_t i = 0; i != pending.size (); ++i)
+        {
+          // A ring that is gone was written completely.
+          for (ACE_Log_Msg_Async_Ring *ring = this->rings_;
+               ring != 0;
+               ring = ring->next_)
+            {
+              if (ring == pending[i].first)
+                {
+                  if (!ring->passed (pending[i].second))
+                    left.push_back (pending[i]);
+                  break;
+                }
+            }
+        }
+      pending.swap (left);
+    }
+
+  // Let the sinks write out what they buffered.
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+  if (this->binary_ != 0)
+    ACE_OS::fflush (this->binary_);
+  return 0;
+}
+
+bool
+ACE_Log_Msg_Async::capture (ACE_Log_Msg &log_msg,
+                            const ACE_TCHAR *format,
+                            ACE_Log_Priority priority,
+                            va_list argp,
+                            ACE_Log_Category_TSS *category)
+{
+  if (&log_msg == this->drain_log_msg_.load (std::memory_order_relaxed))
+    return false;
+
+  // Whether the ostream and the callback of this thread still exist
+  // when the background thread writes the message cannot be told.
+  if (log_msg.msg_ostream () != 0 || log_msg.msg_callback () != 0)
+    return false;
+
+  ACE_Log_Msg_Async_Ring *ring = log_msg.async_ring_;
+  if (ring == 0)
+    {
+      ACE_NEW_NORETURN (ring, ACE_Log_Msg_Async_Ring (this->ring_size_));
+      if (ring == 0)
+        return false;
+      if (!ring->valid ())
+        {
+          delete ring;
+          return false;
+        }
+      log_msg.async_ring_ = ring;
+    }
+
+  // close() waits for the threads that are past this point.
+  ring->busy_.store (true);
+  if (!ACE_Log_Msg_Async::enabled_.load ())
+    {
+      ring->busy_.store (false, std::memory_order_release);
+      return false;
+    }
+
+  unsigned long const generation = this->generation_.load ();
+  if (ring->generation_ != generation)
+    {
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, false);
+      if (!ring->linked_)
+        {
+          ring->next_ = this->rings_;
+          this->rings_ = ring;
+          ring->linked_ = true;
+        }
+      ring->generation_ = generation;
+    }
+
+  Message *message = reinterpret_cast<Message *> (ring->staging_);
+  message->kind = ENTRY_MESSAGE;
+  message->format = format;
+  message->category_id = category == 0 ? 0 : category->id ();
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  message->sec = now.sec ();
+  message->usec = static_cast<ACE_INT32> (now.usec ());
+  message->priority = priority;
+  message->errnum = log_msg.errnum ();
+  message->timestamp = log_msg.timestamp_;
+
+  Arg_Writer args (ring->staging_ + MESSAGE_HEADER_SIZE,
+                   ring->staging_size_ - MESSAGE_HEADER_SIZE);
+  va_list ap;
+  va_copy (ap, argp);
+  bool captured = encode_args (log_msg, format, ap, args);
+  va_end (ap);
+
+  // The category object is freed when this thread exits, copy its
+  // name.
+  size_t const length = args.length ();
+  if (category != 0)
+    {
+      const char *name = category->name ();
+      args.put_bytes (name, ACE_OS::strlen (name) + 1);
+      captured = captured && args.ok ();
+    }
+
+  size_t const size = align (MESSAGE_HEADER_SIZE + args.length ());
+  if (captured && size <= ring->max_message ())
+    {
+      message->length = static_cast<ACE_UINT32> (length);
+      message->size = static_cast<ACE_UINT32> (size);
+      if (ring->push (size))
+        ++this->full_waits_;
+    }
+  else
+    captured = false;
+
+  ring->busy_.store (false, std::memory_order_release);
+  return captured;
+}
+
+void
+ACE_Log_Msg_Async::release (ACE_Log_Msg_Async_Ring *ring)
+{
+  ACE_Log_Msg_Async *async = ACE_Log_Msg_Async::instance_;
+  if (async == 0)
+    delete ring;
+  else
+    async->release_i (ring);
+}
+
+void
+ACE_Log_Msg_Async::release_i (ACE_Log_Msg_Async_Ring *ring)
+{
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+  if (ring->linked_ && this->running_)
+    {
+      // The background thread frees it once it is empty.
+      ring->orphaned_ = true;
+      return;
+    }
+
+  for (ACE_Log_Msg_Async_Ring **link = &this->rings_;
+       *link != 0;
+       link = &(*link)->next_)
+    {
+      if (*link == ring)
+        {
+          *link = ring->next_;
+          break;
+        }
+    }
+  delete ring;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::drain_thread (void *arg)
+{
+  static_cast<ACE_Log_Msg_Async *> (arg)->drain ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::drain ()
+{
+  this->drain_log_msg_ = ACE_Log_Msg::instance ();
+
+  std::vector<ACE_Log_Msg_Async_Ring *> rings;
+  for (;;)
+    {
+      bool const stopping = this->stop_.load ();
+      {
+        ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+        // Rings are only freed by this thread, or once it exited.
+        rings.clear ();
+        for (ACE_Log_Msg_Async_Ring *ring = this->rings_;
+             ring != 0;
+             ring = ring->next_)
+          rings.push_back (ring);
+      }
+
+      if (rings.empty () ||
+          this->drain_rings (&rings[0], rings.size ()) == 0)
+        {
+          if (stopping)
+            break;
+          {
+            ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+            this->reap ();
+            if (this->binary_ != 0)
+              ACE_OS::fflush (this->binary_);
+          }
+          ACE_OS::sleep (this->idle_interval_);
+        }
+    }
+}
+
+size_t
+ACE_Log_Msg_Async::drain_rings (ACE_Log_Msg_Async_Ring *rings[], size_t count)
+{
+  // Write the messages of all threads in the order they were logged,
+  // going back for new threads every now and then.
+  size_t written = 0;
+  for (; written != 1024; ++written)
+    {
+      ACE_Log_Msg_Async_Ring *oldest = 0;
+      const Message *first = 0;
+      for (size_t i = 0; i != count; ++i)
+        {
+          const Message *message = rings[i]->front ();
+          if (message != 0
+              && (first == 0
+                  || message->sec < first->sec
+                  || (message->sec == first->sec
+                      && message->usec < first->usec)))
+            {
+              oldest = rings[i];
+              first = message;
+            }
+        }
+      if (first == 0)
+        break;
+
+      this->write (*oldest, reinterpret_cast<const char *> (first));
+      oldest->pop ();
+    }
+  return written;
+}
+
+void
+ACE_Log_Msg_Async::write (ACE_Log_Msg_Async_Ring &ring, const char *record)
+{
+  const Message *message = reinterpret_cast<const Message *> (record);
+  const char *args = record + MESSAGE_HEADER_SIZE;
+  ACE_Log_Msg *log_msg = this->drain_log_msg_;
+  bool const verbose =
+    ACE_BIT_ENABLED (log_msg->flags (), ACE_Log_Msg::VERBOSE);
+
+  if (this->binary_ != 0)
+    {
+      std::map<const ACE_TCHAR *, ACE_UINT32>::iterator i =
+        this->formats_->ids_.find (message->format);
+      ACE_UINT32 id = 0;
+      if (i == this->formats_->ids_.end ())
+        {
+          id = static_cast<ACE_UINT32> (this->formats_->ids_.size ());
+          this->formats_->ids_[message->format] = id;
+          write_entry (this->binary_, ENTRY_FORMAT,
+                       reinterpret_cast<const char *> (&id), sizeof id,
+                       message->format,
+                       ACE_OS::strlen (message->format) * sizeof (ACE_TCHAR));
+        }
+      else
+        id = i->second;
+
+      char head[128];
+      Arg_Writer writer (head, sizeof head);
+      writer.put (id);
+      writer.put (message->priority);
+      writer.put (message->sec);
+      writer.put (message->usec);
+      writer.put (message->errnum);
+      writer.put (message->timestamp);
+      writer.put (static_cast<ACE_INT32> (verbose));
+      writer.put_string (ring.tid_);
+      write_entry (this->binary_, ENTRY_MESSAGE,
+                   head, writer.length (),
+                   args, message->length);
+    }
+  else
+    {
+      Message_Context ctx;
+      ctx.format = message->format;
+      ctx.priority = static_cast<ACE_Log_Priority> (message->priority);
+      ctx.time.set (static_cast<time_t> (message->sec), message->usec);
+      ctx.errnum = message->errnum;
+      ctx.timestamp = message->timestamp;
+      ctx.verbose = verbose;
+      ctx.pid = ACE_OS::getpid ();
+      ctx.tid = ring.tid_;
+      ctx.program_name = ACE_Log_Msg::program_name ();
+
+      Arg_Reader reader (args, message->length);
+      format_message (ctx, reader, this->msg_);
+
+      ACE_Log_Record log_record (ctx.priority, ctx.time, ctx.pid);
+      log_record.msg_data (this->msg_);
+
+      if (message->category_id == 0)
+        write_record (*log_msg, log_record);
+      else
+        {
+          // The category the message was logged in may be gone with
+          // its thread, log it in one with the same id and name.
+          Arg_Reader name (args + message->length,
+                           message->size - MESSAGE_HEADER_SIZE
+                           - message->length);
+          name.get<ACE_UINT32> ();
+          ACE_Log_Category category (name.pos ());
+          category.id_ = message->category_id;
+          ACE_Log_Category_TSS category_tss (&category, log_msg);
+          log_record.category (&category_tss);
+          write_record (*log_msg, log_record);
+          // It has no thread specific key to free.
+          category.id_ = 0;
+        }
+    }
+
+  ++this->captured_;
+}
+
+void
+ACE_Log_Msg_Async::reap ()
+{
+  ACE_Log_Msg_Async_Ring **link = &this->rings_;
+  while (*link != 0)
+    {
+      ACE_Log_Msg_Async_Ring *ring = *link;
+      if (ring->orphaned_ && ring->front () == 0)
+        {
+          *link = ring->next_;
+          delete ring;
+        }
+      else
+        link = &ring->next_;
+    }
+}
+
+int
+ACE_Log_Msg_Async::write_file_header ()
+{
+  char header[16];
+  Arg_Writer writer (header, sizeof header);
+  for (size_t i = 0; i != sizeof FILE_MAGIC; ++i)
+    writer.put (FILE_MAGIC[i]);
+  writer.put (static_cast<ACE_UINT8> (ACE_CDR_BYTE_ORDER));
+  writer.put (static_cast<ACE_UINT8> (sizeof (long)));
+  writer.put (static_cast<ACE_UINT8> (sizeof (size_t)));
+  writer.put (static_cast<ACE_UINT8> (sizeof (time_t)));
+  writer.put (static_cast<ACE_INT32> (ACE_OS::getpid ()));
+  if (ACE_OS::fwrite (header, writer.length (), 1, this->binary_) != 1)
+    return -1;
+
+  ACE_TCHAR host[MAXHOSTNAMELEN + 1];
+  if (ACE_OS::hostname (host, MAXHOSTNAMELEN) != 0)
+    ACE_OS::strcpy (host, ACE_TEXT ("<unknown>"));
+  const ACE_TCHAR *program = ACE_Log_Msg::program_name ();
+  if (program == 0)
+    program = ACE_TEXT ("<unknown>");
+
+  char names[2 * (MAXHOSTNAMELEN + 1) + MAXPATHLEN];
+  Arg_Writer name_writer (names, sizeof names);
+  name_writer.put_string (program);
+  name_writer.put_string (host);
+  return write_entry (this->binary_, ENTRY_NAMES,
+                      names, name_writer.length (), 0, 0) ? 0 : -1;
+}
+
+ACE_Log_Msg_Async_Reader::ACE_Log_Msg_Async_Reader ()
+  : file_ (0),
+    formats_ (0),
+    pid_ (0),
+    msg_ (0)
+{
+}
+
+ACE_Log_Msg_Async_Reader::~ACE_Log_Msg_Async_Reader ()
+{
+  if (this->file_ != 0)
+    ACE_OS::fclose (this->file_);
+  delete this->formats_;
+  delete [] this->msg_;
+}
+
+int
+ACE_Log_Msg_Async_Reader::open (const ACE_TCHAR *filename)
+{
+  if (this->msg_ == 0)
+    ACE_NEW_RETURN (this->msg_, ACE_TCHAR[ACE_MAXLOGMSGLEN + 1], -1);
+  if (this->formats_ == 0)
+    ACE_NEW_RETURN (this->formats_, ACE_Log_Msg_Async_Formats, -1);
+
+  this->file_ = ACE_OS::fopen (filename, ACE_TEXT ("rb"));
+  if (this->file_ == 0)
+    return -1;
+
+  char header[16];
+  if (ACE_OS::fread (header, sizeof header, 1, this->file_) != 1
+      || ACE_OS::memcmp (header, FILE_MAGIC, sizeof FILE_MAGIC) != 0
+      || header[8] != ACE_CDR_BYTE_ORDER
+      || header[9] != sizeof (long)
+      || header[10] != sizeof (size_t)
+      || header[11] != sizeof (time_t))
+    {
+      ACE_OS::fclose (this->file_);
+      this->file_ = 0;
+      errno = EINVAL;
+      return -1;
+    }
+  ACE_INT32 pid = 0;
+  ACE_OS::memcpy (&pid, header + 12, sizeof pid);
+  this->pid_ = pid;
+
+  // The names follow the header, so they are known before the first
+  // message is read.
+  ACE_UINT32 entry[2];
+  char names[2 * (MAXPATHLEN + 1)];
+  if (ACE_OS::fread (entry, sizeof entry, 1, this->file_) == 1
+      && entry[0] == ENTRY_NAMES
+      && entry[1] <= sizeof names
+      && (entry[1] == 0
+          || ACE_OS::fread (names, entry[1], 1, this->file_) == 1))
+    {
+      Arg_Reader reader (names, entry[1]);
+      ACE_TCHAR name[MAXPATHLEN + 1];
+      reader.get_string (name, sizeof name / sizeof (ACE_TCHAR));
+      this->formats_->program_name_ = name;
+      reader.get_string (name, sizeof name / sizeof (ACE_TCHAR));
+      this->formats_->host_name_ = name;
+    }
+  else
+    ACE_OS::fseek (this->file_, sizeof header, SEEK_SET);
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async_Reader::next (ACE_Log_Record &record)
+{
+  if (this->file_ == 0)
+    return -1;
+
+  std::vector<char> body;
+  for (;;)
+    {
+      ACE_UINT32 header[2];
+      size_t const got = ACE_OS::fread (header, 1, sizeof header, this->file_);
+      if (got == 0)
+        return 0;
+      if (got != sizeof header)
+        return -1;
+
+      body.resize (header[1] + 1);
+      if (header[1] != 0
+          && ACE_OS::fread (&body[0], header[1], 1, this->file_) != 1)
+        return -1;
+
+      Arg_Reader reader (&body[0], header[1]);
+      switch (header[0])
+        {
+        case ENTRY_NAMES:
+          {
+            ACE_TCHAR name[MAXPATHLEN + 1];
+            reader.get_string (name, sizeof name / sizeof (ACE_TCHAR));
+            this->formats_->program_name_ = name;
+            reader.get_string (name, sizeof name / sizeof (ACE_TCHAR));
+            this->formats_->host_name_ = name;
+          }
+          break;
+
+        case ENTRY_FORMAT:
+          {
+            ACE_UINT32 const id = reader.get<ACE_UINT32> ();
+            this->formats_->formats_[id].assign
+              (reinterpret_cast<const ACE_TCHAR *> (reader.pos ()),
+               (header[1] - sizeof id) / sizeof (ACE_TCHAR));
+          }
+          break;
+
+        case ENTRY_MESSAGE:
+          {
+            ACE_UINT32 const id = reader.get<ACE_UINT32> ();
+            std::map<ACE_UINT32, std::basic_string<ACE_TCHAR> >::const_iterator
+              format = this->formats_->formats_.find (id);
+            if (format == this->formats_->formats_.end ())
+              return -1;
+
+            Message_Context ctx;
+            ctx.format = format->second.c_str ();
+            ctx.priority =
+              static_cast<ACE_Log_Priority> (reader.get<ACE_INT32> ());
+            ACE_INT64 const sec = reader.get<ACE_INT64> ();
+            ACE_INT32 const usec = reader.get<ACE_INT32> ();
+            ctx.time.set (static_cast<time_t> (sec), usec);
+            ctx.errnum = reader.get<ACE_INT32> ();
+            ctx.timestamp = reader.get<ACE_INT32> ();
+            ctx.verbose = reader.get<ACE_INT32> () != 0;
+            ctx.pid = this->pid_;
+            char tid[32];
+            reader.get_string (tid, sizeof tid);
+            ctx.tid = tid;
+            ctx.program_name = this->formats_->program_name_.c_str ();
+
+            format_message (ctx, reader, this->msg_);
+
+            record.type (ctx.priority);
+            record.time_stamp (ctx.time);
+            record.pid (ctx.pid);
+            record.msg_data (this->msg_);
+            return 1;
+          }
+
+        default:
+          // Skip entries written by a later version.
+          break;
+        }
+    }
+}
+
+const ACE_TCHAR *
+ACE_Log_Msg_Async_Reader::host_name () const
+{
+  return this->formats_ == 0 ? 0 : this->formats_->host_name_.c_str ();
+}
+
+const ACE_TCHAR *
+ACE_Log_Msg_Async_Reader::program_name () const
+{
+  return this->formats_ == 0 ? 0 : this->formats_->program_name_.c_str ();
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
@@ -0,0 +1,250 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ *
+ *  Formatting and writing of ACE_Log_Msg messages in a background
+ *  thread.
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Cleanup.h"
+#include "ace/Log_Priority.h"
+#include "ace/Time_Value.h"
+#include "ace/os_include/os_stdarg.h"
+#include "ace/os_include/os_stdio.h"
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_USES_WCHAR) && \
+    !defined (ACE_LACKS_VA_FUNCTIONS)
+# define ACE_HAS_LOG_MSG_ASYNC
+#endif
+
+#if !defined (ACE_LOG_MSG_ASYNC_RING_SIZE)
+/// Default size in bytes of the buffer each logging thread writes its
+/// messages into.
+# define ACE_LOG_MSG_ASYNC_RING_SIZE 64 * 1024
+#endif /* ACE_LOG_MSG_ASYNC_RING_SIZE */
+
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+
+#include "ace/Thread_Mutex.h"
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Log_Msg;
+class ACE_Log_Record;
+class ACE_Log_Category_TSS;
+class ACE_Log_Msg_Async_Ring;
+class ACE_Log_Msg_Async_Formats;
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief Moves the formatting and writing of ACE_Log_Msg messages
+ * off the logging threads.
+ *
+ * While asynchronous logging is open, ACE_Log_Msg::log() does not
+ * format the message.  It copies the format pointer, the arguments
+ * and the context the directives refer to (errno, file, line, time)
+ * into a buffer owned by the calling thread, which only that thread
+ * writes and only the background thread reads, so no lock is taken.
+ * The background thread formats the messages the way ACE_Log_Msg
+ * would have and hands them to the sinks enabled in ACE_Log_Msg
+ * (stderr, logger daemon, syslog or the custom ACE_Log_Msg_Backend),
+ * in an ACE_Log_Category with the id and the name of the one they
+ * were logged in.  When a binary file is given to open() the
+ * messages are written to it without being formatted at all, the
+ * format strings only once, and ACE_Log_Msg_Async_Reader turns them
+ * back into ACE_Log_Record instances.
+ *
+ * The format strings must stay valid until the message is written,
+ * which holds for the string literals used with ACE_DEBUG and
+ * ACE_ERROR.  Messages using the %a, %r, %?, %W, %z, %Z, %{, %}, %$
+ * or %I directives are logged synchronously, as are messages logged
+ * by the background thread itself and by threads that set an ostream
+ * or a callback in their ACE_Log_Msg, which may be gone by the time
+ * the message is written.  A thread whose buffer is full
+ * waits until the background thread made room, so no message is
+ * lost.  The formatted message is not left in ACE_Log_Msg::msg().
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Cleanup
+{
+public:
+  /// Returns the Singleton, creating it when needed.
+  static ACE_Log_Msg_Async *instance ();
+
+  /// Is asynchronous logging open?
+  static bool enabled ();
+
+  /**
+   * Start the background thread and route the messages of all
+   * threads through it.
+   *
+   * @param ring_size     Size in bytes of the buffer allocated for
+   *                      each logging thread.
+   * @param binary_file   When given, the messages are appended to this
+   *                      file in the binary format instead of being
+   *                      handed to the ACE_Log_Msg sinks.
+   * @param idle_interval How long the background thread sleeps when
+   *                      no message is pending.
+   */
+  int open (size_t ring_size = ACE_LOG_MSG_ASYNC_RING_SIZE,
+            const ACE_TCHAR *binary_file = 0,
+            const ACE_Time_Value &idle_interval = ACE_Time_Value (0, 1000));
+
+  /// Write all pending messages, stop the background thread and go
+  /// back to synchronous logging.
+  int close ();
+
+  /// Wait until the messages logged by any thread before this call
+  /// have been written.
+  int flush ();
+
+  /// Number of messages that were logged asynchronously.
+  unsigned long captured () const;
+
+  /// Number of times a logging thread had to wait for room in its
+  /// buffer.
+  unsigned long full_waits () const;
+
+  /**
+   * Copy the message into the buffer of the calling thread.  Returns
+   * false when the message has to be logged synchronously.  Called by
+   * ACE_Log_Msg::log().
+   */
+  bool capture (ACE_Log_Msg &log_msg,
+                const ACE_TCHAR *format,
+                ACE_Log_Priority priority,
+                va_list argp,
+                ACE_Log_Category_TSS *category);
+
+  /// Called when the ACE_Log_Msg owning @a ring is destroyed, the
+  /// ring is freed once its messages have been written.
+  static void release (ACE_Log_Msg_Async_Ring *ring);
+
+  /// Closes asynchronous logging.
+  virtual ~ACE_Log_Msg_Async ();
+
+private:
+  ACE_Log_Msg_Async ();
+
+  /// Entry point of the background thread.
+  static ACE_THR_FUNC_RETURN drain_thread (void *arg);
+
+  /// Write messages until close() is called.
+  void drain ();
+
+  /// Write all messages pending in @a rings, returns the number
+  /// written.
+  size_t drain_rings (ACE_Log_Msg_Async_Ring *rings[], size_t count);
+
+  /// Format or store one message.
+  void write (ACE_Log_Msg_Async_Ring &ring, const char *record);
+
+  /// Free the rings whose thread exited once they are empty.
+  void reap ();
+
+  void release_i (ACE_Log_Msg_Async_Ring *ring);
+
+  /// Write the header of the binary file.
+  int write_file_header ();
+
+  static ACE_Log_Msg_Async *instance_;
+  static std::atomic<bool> enabled_;
+
+  ACE_Thread_Mutex lock_;
+
+  /// Rings of the threads that logged since open().
+  ACE_Log_Msg_Async_Ring *rings_;
+
+  /// Bumped by every open(), rings registered with an older one are
+  /// linked again.
+  std::atomic<unsigned long> generation_;
+
+  size_t ring_size_;
+
+  ACE_Time_Value idle_interval_;
+
+  /// Set by close() to stop the background thread.
+  std::atomic<bool> stop_;
+
+  bool running_;
+
+  ACE_hthread_t thread_handle_;
+
+  /// The ACE_Log_Msg of the background thread.
+  std::atomic<ACE_Log_Msg *> drain_log_msg_;
+
+  std::atomic<unsigned long> captured_;
+  std::atomic<unsigned long> full_waits_;
+
+  /// Binary file, if any, and the ids of the format strings written
+  /// to it.
+  FILE *binary_;
+  ACE_Log_Msg_Async_Formats *formats_;
+
+  /// Buffer for the formatted message.
+  ACE_TCHAR *msg_;
+};
+
+/**
+ * @class ACE_Log_Msg_Async_Reader
+ *
+ * @brief Reads the binary file written by ACE_Log_Msg_Async.
+ *
+ * The file is only readable on the kind of platform that wrote it.
+ */
+class ACE_Export ACE_Log_Msg_Async_Reader
+{
+public:
+  ACE_Log_Msg_Async_Reader ();
+  ~ACE_Log_Msg_Async_Reader ();
+
+  /// Open the file and check its header.
+  int open (const ACE_TCHAR *filename);
+
+  /**
+   * Format the next message into @a record.
+   *
+   * @retval 1 a message was read.
+   * @retval 0 the end of the file was reached.
+   * @retval -1 the file is damaged.
+   */
+  int next (ACE_Log_Record &record);
+
+  /// Name of the host the file was written on.
+  const ACE_TCHAR *host_name () const;
+
+  /// Name of the program that wrote the file.
+  const ACE_TCHAR *program_name () const;
+
+private:
+  FILE *file_;
+  ACE_Log_Msg_Async_Formats *formats_;
+  long pid_;
+  ACE_TCHAR *msg_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Log_Msg_Async.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
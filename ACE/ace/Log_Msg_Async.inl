@@ -0,0 +1,25 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE
+bool
+ACE_Log_Msg_Async::enabled ()
+{
+  return ACE_Log_Msg_Async::enabled_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE
+unsigned long
+ACE_Log_Msg_Async::captured () const
+{
+  return this->captured_.load ();
+}
+
+ACE_INLINE
+unsigned long
+ACE_Log_Msg_Async::full_waits () const
+{
+  return this->full_waits_.load ();
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -8,6 +8,13 @@
 #include "ace/Truncate.h"
 #include "ace/Lib_Find.h"
 
+#if defined (ACE_LINUX)
+#  include <sys/vfs.h>
+#  include <sys/syscall.h>
+#  include <linux/magic.h>
+#  include <linux/mempolicy.h>
+#endif /* ACE_LINUX */
+
 #if (ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1)
 #include "ace/Based_Pointer_T.h"
 #include "ace/Based_Pointer_Repository.h"
@@ -117,7 +124,11 @@ ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool (
     minimum_bytes_ (0),
     sa_ (0),
     file_mode_ (ACE_DEFAULT_FILE_PERMS),
-    install_signal_handler_ (true)
+    install_signal_handler_ (true),
+    huge_pages_ (ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES),
+    prefault_ (false),
+    numa_node_ (-1),
+    page_size_ (0)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool");
 
@@ -152,6 +163,13 @@ ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool (
         this->sa_ = options->sa_;
       this->file_mode_ = options->file_mode_;
       this->install_signal_handler_ = options->install_signal_handler_;
+      this->huge_pages_ = options->huge_pages_;
+      this->prefault_ = options->prefault_;
+      this->numa_node_ = options->numa_node_;
+#if defined (MAP_HUGETLB)
+      if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+        ACE_SET_BITS (flags_, MAP_HUGETLB);
+#endif /* MAP_HUGETLB */
     }
 
   if (backing_store_name == 0)
@@ -218,6 +236,22 @@ ACE_MMAP_Memory_Pool::commit_backing_store_name (size_t rounded_bytes,
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool::commit_backing_store_name");
 
+  if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+    {
+      // Files in hugetlbfs cannot be written to, only truncated to a
+      // multiple of the huge page size.
+      ACE_OFF_T const file_size = ACE_OS::filesize (this->mmap_.handle ());
+      if (file_size == -1
+          || ACE_OS::ftruncate (this->mmap_.handle (),
+                                file_size + static_cast<ACE_OFF_T> (rounded_bytes)) == -1)
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("(%P|%t) %p\n"),
+                              this->backing_store_name_),
+                             -1);
+      map_size = static_cast<size_t> (file_size) + rounded_bytes;
+      return 0;
+    }
+
 #if defined (__Lynx__)
   map_size = rounded_bytes;
 #else
@@ -274,6 +308,8 @@ ACE_MMAP_Memory_Pool::map_file (size_t map_size)
 #if (ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1)
     void* obase_addr = this->base_addr_;
 #endif /* ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1 */
+  void *const old_addr = this->mmap_.addr ();
+  size_t const old_size = this->mmap_.size ();
 
   // Unmap the existing mapping.
   this->mmap_.unmap ();
@@ -312,6 +348,12 @@ ACE_MMAP_Memory_Pool::map_file (size_t map_size)
     }
   else
     {
+      // Pages mapped at the same place before need no prefaulting.
+      if (this->apply_options (this->mmap_.addr () == old_addr
+                               ? old_size
+                               : 0) == -1)
+        return -1;
+
 #if (ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1)
       this->base_addr_ = this->mmap_.addr ();
 
@@ -327,6 +369,109 @@ ACE_MMAP_Memory_Pool::map_file (size_t map_size)
     }
 }
 
+int
+ACE_MMAP_Memory_Pool::apply_options (size_t old_size)
+{
+  ACE_TRACE ("ACE_MMAP_Memory_Pool::apply_options");
+
+  char *const addr = static_cast<char *> (this->mmap_.addr ());
+  size_t const size = this->mmap_.size ();
+
+#if defined (MADV_HUGEPAGE)
+  // This is only advice, which kernels without transparent huge pages
+  // refuse.
+  if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES
+      && ACE_OS::madvise (addr, size, MADV_HUGEPAGE) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%P|%t) ACE_MMAP_Memory_Pool: %p\n"),
+                   ACE_TEXT ("madvise")));
+#endif /* MADV_HUGEPAGE */
+
+  if (this->numa_node_ >= 0)
+    {
+#if defined (ACE_LINUX) && defined (SYS_mbind)
+      unsigned long nodes[16] = { 0 };
+      size_t const bits = 8 * sizeof nodes[0];
+      size_t const node = static_cast<size_t> (this->numa_node_);
+      if (node >= bits * (sizeof nodes / sizeof nodes[0]))
+        {
+          errno = EINVAL;
+          return -1;
+        }
+      nodes[node / bits] |= 1UL << (node % bits);
+
+      // Pages already allocated stay where they are; the policy
+      // places the ones faulted in from now on.  The kernel takes one
+      // bit more than the size of the mask.
+      if (::syscall (SYS_mbind,
+                     addr,
+                     size,
+                     MPOL_BIND,
+                     nodes,
+                     8 * sizeof nodes + 1,
+                     0) == -1)
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("(%P|%t) %p\n"),
+                              ACE_TEXT ("ACE_MMAP_Memory_Pool: mbind")),
+                             -1);
+#else
+      ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_LINUX && SYS_mbind */
+    }
+
+  if (this->prefault_ && size > old_size)
+    {
+      char *const start = addr + old_size;
+      size_t const len = size - old_size;
+#if defined (MADV_POPULATE_WRITE)
+      if (ACE_OS::madvise (start, len, MADV_POPULATE_WRITE) == 0)
+        return 0;
+#endif /* MADV_POPULATE_WRITE */
+
+      // Reading a byte of each page faults it in without changing
+      // what other processes sharing the pool see.
+      size_t const page = this->round_up (1);
+      volatile char sink = 0;
+      for (size_t offset = 0; offset < len; offset += page)
+        sink = start[offset];
+      ACE_UNUSED_ARG (sink);
+    }
+  return 0;
+}
+
+int
+ACE_MMAP_Memory_Pool::init_page_size ()
+{
+  ACE_TRACE ("ACE_MMAP_Memory_Pool::init_page_size");
+
+  if (this->huge_pages_ != ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+    return 0;
+
+#if defined (ACE_LINUX) && defined (MAP_HUGETLB)
+  struct statfs buf;
+  if (::fstatfs (this->mmap_.handle (), &buf) == -1)
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) %p\n"),
+                          this->backing_store_name_),
+                         -1);
+  if (buf.f_type != HUGETLBFS_MAGIC)
+    {
+      errno = EINVAL;
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("(%P|%t) %s is not in a hugetlbfs mount\n"),
+                            this->backing_store_name_),
+                           -1);
+    }
+
+  // The block size of hugetlbfs is its page size.
+  this->page_size_ = static_cast<size_t> (buf.f_bsize);
+  return 0;
+#else
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_LINUX && MAP_HUGETLB */
+}
+
 // Ask operating system for more shared memory, increasing the mapping
 // accordingly.  Note that this routine assumes that the appropriate
 // locks are held when it is called.
@@ -377,6 +522,12 @@ ACE_MMAP_Memory_Pool::init_acquire (size_t nbytes,
       // First time in, so need to acquire memory.
       first_time = 1;
 
+      if (this->init_page_size () == -1)
+        {
+          this->mmap_.remove ();
+          return 0;
+        }
+
       void *result = this->acquire (nbytes, rounded_bytes);
       // After the first time, reset the flag so that subsequent calls
       // will use MAP_FIXED
@@ -403,6 +554,10 @@ ACE_MMAP_Memory_Pool::init_acquire (size_t nbytes,
                            ACE_TEXT ("%p\n"),
                            ACE_TEXT ("MMAP_Memory_Pool::init_acquire, EEXIST")),
                           0);
+
+      if (this->init_page_size () == -1 || this->apply_options (0) == -1)
+        return 0;
+
       // After the first time, reset the flag so that subsequent calls
       // will use MAP_FIXED
       if (use_fixed_addr_ == ACE_MMAP_Memory_Pool_Options::FIRSTCALL_FIXED)
@@ -470,7 +625,10 @@ ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options (
   LPSECURITY_ATTRIBUTES sa,
   mode_t file_mode,
   bool unique,
-  bool install_signal_handler)
+  bool install_signal_handler,
+  int huge_pages,
+  bool prefault,
+  int numa_node)
   : base_addr_ (base_addr),
     use_fixed_addr_ (use_fixed_addr),
     write_each_page_ (write_each_page),
@@ -480,7 +638,10 @@ ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options (
     sa_ (sa),
     file_mode_ (file_mode),
     unique_ (unique),
-    install_signal_handler_ (install_signal_handler)
+    install_signal_handler_ (install_signal_handler),
+    huge_pages_ (huge_pages),
+    prefault_ (prefault),
+    numa_node_ (numa_node)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options");
   // for backwards compatibility
@@ -557,6 +718,8 @@ size_t
 ACE_MMAP_Memory_Pool::round_up (size_t nbytes)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool::round_up");
+  if (this->page_size_ != 0)
+    return (nbytes + this->page_size_ - 1) / this->page_size_ * this->page_size_;
   return ACE::round_to_pagesize (nbytes);
 }
 
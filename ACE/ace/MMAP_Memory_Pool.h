@@ -61,6 +61,28 @@ public:
     NEVER_FIXED = 2
   };
 
+  enum
+  {
+    /// Map the pool with the default page size.
+    NO_HUGE_PAGES = 0,
+
+    /**
+     * Advise the kernel to back the pool with transparent huge pages
+     * (madvise(MADV_HUGEPAGE)).  For a shared pool this takes effect
+     * when the backing store is in a tmpfs mounted with huge=advise;
+     * otherwise the advice is ignored.
+     */
+    TRANSPARENT_HUGE_PAGES = 1,
+
+    /**
+     * Map the pool with MAP_HUGETLB.  The backing store must be in a
+     * hugetlbfs mount, such as /dev/hugepages, with enough huge pages
+     * reserved.  The pool grows in multiples of the huge page size
+     * and @c write_each_page_ is ignored.
+     */
+    HUGETLB_PAGES = 2
+  };
+
   /// Constructor
   ACE_MMAP_Memory_Pool_Options (const void *base_addr = ACE_DEFAULT_BASE_ADDR,
                                 int use_fixed_addr = ALWAYS_FIXED,
@@ -71,7 +93,10 @@ public:
                                 LPSECURITY_ATTRIBUTES sa = 0,
                                 mode_t file_mode = ACE_DEFAULT_FILE_PERMS,
                                 bool unique_ = false,
-                                bool install_signal_handler = true);
+                                bool install_signal_handler = true,
+                                int huge_pages = NO_HUGE_PAGES,
+                                bool prefault = false,
+                                int numa_node = -1);
 
   /// Base address of the memory-mapped backing store.
   const void *base_addr_;
@@ -119,6 +144,18 @@ public:
   /// Should we install a signal handler
   bool install_signal_handler_;
 
+  /// One of NO_HUGE_PAGES, TRANSPARENT_HUGE_PAGES or HUGETLB_PAGES.
+  int huge_pages_;
+
+  /// Should the pages be faulted in when they are mapped, instead of
+  /// on first access?
+  bool prefault_;
+
+  /// NUMA node the pages of the pool are allocated from, or -1 to
+  /// leave it to the default policy.  Like the huge page advice this
+  /// takes effect for backing stores in tmpfs or hugetlbfs.
+  int numa_node_;
+
 private:
   ACE_MMAP_Memory_Pool_Options (const ACE_MMAP_Memory_Pool_Options &) = delete;
   ACE_MMAP_Memory_Pool_Options &operator= (const ACE_MMAP_Memory_Pool_Options &) = delete;
@@ -237,6 +274,14 @@ protected:
   /// Memory map the file up to @a map_size bytes.
   virtual int map_file (size_t map_size);
 
+  /// Apply the huge page, NUMA and prefault options to the mapping,
+  /// of which the first @a old_size bytes were mapped before.
+  int apply_options (size_t old_size);
+
+  /// Find the page size of a HUGETLB_PAGES backing store once it is
+  /// open.
+  int init_page_size ();
+
 #if !defined (ACE_WIN32)
   /**
    * Handle SIGSEGV and SIGBUS signals to remap memory properly.  When a
@@ -298,6 +343,19 @@ protected:
 
   /// Should we install a signal handler
   bool install_signal_handler_;
+
+  /// One of the huge page values of ACE_MMAP_Memory_Pool_Options.
+  int huge_pages_;
+
+  /// Fault the pages in as they are mapped?
+  bool prefault_;
+
+  /// NUMA node to allocate pages from, or -1.
+  int numa_node_;
+
+  /// Size of the pages the pool grows by, or 0 for the system page
+  /// size.
+  size_t page_size_;
 };
 
 /**
@@ -0,0 +1,222 @@
+/**
+ * @file Per_CPU_RW_Thread_Mutex.cpp
+ */
+
+#include "ace/Per_CPU_RW_Thread_Mutex.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Guard_T.h"
+
+#if defined (ACE_HAS_ALLOC_HOOKS)
+# include "ace/Malloc_Base.h"
+#endif /* ACE_HAS_ALLOC_HOOKS */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Per_CPU_RW_Thread_Mutex.inl"
+#endif /* __ACE_INLINE__ */
+
+#include <new>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Per_CPU_RW_Thread_Mutex)
+
+ACE_Per_CPU_RW_Thread_Mutex::ACE_Per_CPU_RW_Thread_Mutex (const ACE_TCHAR *,
+                                                          void *)
+  : buffer_ (0),
+    slots_ (&single_),
+    mask_ (0),
+    writer_ (NO_WRITER),
+    no_writer_ (lock_),
+    removed_ (false)
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::ACE_Per_CPU_RW_Thread_Mutex");
+  this->single_.readers_ = 0;
+
+  long const cpus = ACE_OS::num_processors_online ();
+  size_t count = 1;
+  while (count < static_cast<size_t> (cpus)
+         && count < ACE_PER_CPU_RW_MUTEX_MAX_SLOTS)
+    count *= 2;
+  if (count == 1)
+    return;
+
+  // One more than needed, to align them on a cache line.
+  ACE_NEW_NORETURN (this->buffer_, char[(count + 1) * sizeof (Slot)]);
+  if (this->buffer_ == 0)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("%p\n"),
+                     ACE_TEXT ("ACE_Per_CPU_RW_Thread_Mutex::ACE_Per_CPU_RW_Thread_Mutex")));
+      return;
+    }
+
+  size_t const offset =
+    reinterpret_cast<uintptr_t> (this->buffer_) % alignof (Slot);
+  char *const first =
+    offset == 0 ? this->buffer_ : this->buffer_ + alignof (Slot) - offset;
+  this->slots_ = reinterpret_cast<Slot *> (first);
+  for (size_t i = 0; i != count; ++i)
+    {
+      new (&this->slots_[i]) Slot;
+      this->slots_[i].readers_ = 0;
+    }
+  this->mask_ = count - 1;
+}
+
+ACE_Per_CPU_RW_Thread_Mutex::~ACE_Per_CPU_RW_Thread_Mutex ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::~ACE_Per_CPU_RW_Thread_Mutex");
+  this->remove ();
+}
+
+int
+ACE_Per_CPU_RW_Thread_Mutex::remove ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::remove");
+  if (this->removed_)
+    return 0;
+  this->removed_ = true;
+
+  this->slots_ = &this->single_;
+  this->mask_ = 0;
+  delete [] this->buffer_;
+  this->buffer_ = 0;
+
+  int result = 0;
+  if (this->no_writer_.remove () == -1)
+    result = -1;
+  if (this->lock_.remove () == -1)
+    result = -1;
+  if (this->writer_lock_.remove () == -1)
+    result = -1;
+  return result;
+}
+
+size_t
+ACE_Per_CPU_RW_Thread_Mutex::thread_index ()
+{
+  // Hand out consecutive numbers, so that as many threads as there
+  // are counters each get a counter of their own.
+  static std::atomic<size_t> next (0);
+  static thread_local size_t const index = next.fetch_add (1);
+  return index;
+}
+
+long
+ACE_Per_CPU_RW_Thread_Mutex::readers () const
+{
+  long sum = 0;
+  for (size_t i = 0; i <= this->mask_; ++i)
+    sum += this->slots_[i].readers_.load ();
+  return sum;
+}
+
+int
+ACE_Per_CPU_RW_Thread_Mutex::acquire_read_i ()
+{
+  for (;;)
+    {
+      {
+        ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+        while (this->writer_.load () != NO_WRITER)
+          if (this->no_writer_.wait () == -1)
+            return -1;
+      }
+
+      Slot &slot = this->slot ();
+      slot.readers_.fetch_add (1);
+      if (this->writer_.load () == NO_WRITER)
+        return 0;
+      slot.readers_.fetch_sub (1, std::memory_order_release);
+    }
+}
+
+int
+ACE_Per_CPU_RW_Thread_Mutex::acquire_write ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::acquire_write");
+  if (this->writer_lock_.acquire () == -1)
+    return -1;
+
+  // Stop readers coming in, then wait for those inside to leave.
+  // They only read, so they are usually gone after a few yields.
+  this->writer_.store (WRITER_WAITING);
+  while (this->readers () != 0)
+    ACE_OS::thr_yield ();
+  this->writer_.store (WRITER_HOLDS, std::memory_order_relaxed);
+  return 0;
+}
+
+int
+ACE_Per_CPU_RW_Thread_Mutex::tryacquire_write ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::tryacquire_write");
+  if (this->writer_lock_.tryacquire () == -1)
+    return -1;
+
+  this->writer_.store (WRITER_WAITING);
+  if (this->readers () != 0)
+    {
+      this->writer_done ();
+      errno = EBUSY;
+      return -1;
+    }
+  this->writer_.store (WRITER_HOLDS, std::memory_order_relaxed);
+  return 0;
+}
+
+int
+ACE_Per_CPU_RW_Thread_Mutex::tryacquire_write_upgrade ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::tryacquire_write_upgrade");
+  if (this->writer_lock_.tryacquire () == -1)
+    return -1;
+
+  // We are one of the readers; upgrade only if we are the only one.
+  this->writer_.store (WRITER_WAITING);
+  if (this->readers () != 1)
+    {
+      this->writer_done ();
+      errno = EBUSY;
+      return -1;
+    }
+  this->slot ().readers_.fetch_sub (1, std::memory_order_relaxed);
+  this->writer_.store (WRITER_HOLDS, std::memory_order_relaxed);
+  return 0;
+}
+
+void
+ACE_Per_CPU_RW_Thread_Mutex::writer_done ()
+{
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+    this->writer_.store (NO_WRITER);
+    this->no_writer_.broadcast ();
+  }
+  this->writer_lock_.release ();
+}
+
+void
+ACE_Per_CPU_RW_Thread_Mutex::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("slots_ = %B\nreaders_ = %d\nwriter_ = %d\n"),
+                 this->slots (),
+                 static_cast<int> (this->readers ()),
+                 this->writer_.load ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
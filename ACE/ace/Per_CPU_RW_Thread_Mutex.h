@@ -0,0 +1,198 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file    Per_CPU_RW_Thread_Mutex.h
+ *
+ *  A readers/writer lock for data that is read far more often than it
+ *  is written, whose readers do not contend with each other.
+ */
+//==========================================================================
+
+#ifndef ACE_PER_CPU_RW_THREAD_MUTEX_H
+#define ACE_PER_CPU_RW_THREAD_MUTEX_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+
+#include <atomic>
+
+#if !defined (ACE_PER_CPU_RW_MUTEX_MAX_SLOTS)
+/// Largest number of reader counters of an ACE_Per_CPU_RW_Thread_Mutex.
+# define ACE_PER_CPU_RW_MUTEX_MAX_SLOTS 64
+#endif /* ACE_PER_CPU_RW_MUTEX_MAX_SLOTS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Per_CPU_RW_Thread_Mutex
+ *
+ * @brief Readers/writer lock within a process with one reader count
+ * per CPU.
+ *
+ * An ACE_RW_Thread_Mutex keeps its readers in one word, which every
+ * acquire_read() and release() writes; with many threads on many
+ * CPUs the cache line holding it moves from CPU to CPU and readers
+ * serialize on it although they never wait for each other.  This
+ * lock has one counter, on its own cache line, per CPU: a reader
+ * only writes the counter of the CPU it runs on, so readers on
+ * different CPUs do not share any line written to.
+ *
+ * The cost is moved to writers, which announce themselves, then wait
+ * until the counters of all CPUs add up to zero.  A writer takes
+ * precedence over readers that arrive after it; those block until
+ * it releases the lock.  Use it where writes are rare, such as
+ * configuration and object tables that are looked up on every
+ * request.
+ *
+ * The interface is that of ACE_RW_Thread_Mutex, so it can be used
+ * with ACE_Read_Guard, ACE_Write_Guard and ACE_Lock_Adapter.  Like
+ * the locks it replaces, it is not recursive.
+ */
+class ACE_Export ACE_Per_CPU_RW_Thread_Mutex
+{
+public:
+  /// The arguments are accepted for compatibility with
+  /// ACE_RW_Thread_Mutex and ignored.
+  ACE_Per_CPU_RW_Thread_Mutex (const ACE_TCHAR *name = 0,
+                               void *arg = 0);
+
+  ~ACE_Per_CPU_RW_Thread_Mutex ();
+
+  /// Explicitly destroy the lock.  Only one thread may call this
+  /// method, when no thread holds the lock.
+  int remove ();
+
+  /// Acquire a read lock, but block while a writer holds or waits for
+  /// the lock.
+  int acquire_read ();
+
+  /// Acquire a write lock, but block while readers or another writer
+  /// hold the lock.
+  int acquire_write ();
+
+  /**
+   * Conditionally acquire a read lock.  If a writer holds or waits
+   * for the lock, returns -1 with @c errno set to @c EBUSY.
+   */
+  int tryacquire_read ();
+
+  /**
+   * Conditionally acquire a write lock.  If readers or a writer hold
+   * the lock, returns -1 with @c errno set to @c EBUSY.
+   */
+  int tryacquire_write ();
+
+  /**
+   * Conditionally upgrade a read lock to a write lock.  This only
+   * works if there are no other readers present, in which case the
+   * method returns 0.  Otherwise, the method returns -1 and sets
+   * @c errno to @c EBUSY.  The caller must already hold this lock as
+   * a read lock.
+   */
+  int tryacquire_write_upgrade ();
+
+  /// Note, for interface uniformity with other synchronization
+  /// wrappers we include the acquire() method.  This is implemented
+  /// as a write-lock to be safe...
+  int acquire ();
+
+  /// Note, for interface uniformity with other synchronization
+  /// wrappers we include the tryacquire() method.  This is
+  /// implemented as a write-lock to be safe...
+  int tryacquire ();
+
+  /// Release a read or write lock.
+  int release ();
+
+  /// Number of reader counters.
+  size_t slots () const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// The reader count of a CPU, alone on its cache line.
+  struct Slot
+  {
+    alignas (64) std::atomic<long> readers_;
+  };
+
+  enum Writer_State
+  {
+    NO_WRITER,
+    WRITER_WAITING,
+    WRITER_HOLDS
+  };
+
+  /// The counter the calling thread uses.
+  Slot &slot ();
+
+  /// A number for the calling thread, on platforms where the CPU it
+  /// runs on is not known.
+  static size_t thread_index ();
+
+  /// Wait for the writer that acquire_read() found, then try again.
+  int acquire_read_i ();
+
+  /// Sum of all the counters.
+  long readers () const;
+
+  /// Let blocked readers in again after a writer is done, and let the
+  /// next writer in.
+  void writer_done ();
+
+  /// The counter on a single CPU, or when there is no memory for
+  /// more.
+  Slot single_;
+
+  /// Storage for the counters, large enough to align them.
+  char *buffer_;
+
+  /// The counters, a power of two of them.
+  Slot *slots_;
+
+  /// Number of counters less one, to pick one from a CPU number.
+  size_t mask_;
+
+  /// One of Writer_State.
+  std::atomic<int> writer_;
+
+  /// Held by the writer, from the moment it announces itself until
+  /// it releases the lock.
+  ACE_Thread_Mutex writer_lock_;
+
+  /// Readers that find a writer wait on @c no_writer_ until it is
+  /// done.
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex no_writer_;
+
+  /// Keeps track of whether remove() has been called yet.
+  bool removed_;
+
+  void operator= (const ACE_Per_CPU_RW_Thread_Mutex &) = delete;
+  ACE_Per_CPU_RW_Thread_Mutex (const ACE_Per_CPU_RW_Thread_Mutex &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Per_CPU_RW_Thread_Mutex.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_PER_CPU_RW_THREAD_MUTEX_H */
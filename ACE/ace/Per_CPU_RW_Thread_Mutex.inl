@@ -0,0 +1,81 @@
+// -*- C++ -*-
+#include "ace/os_include/os_sched.h"
+#include "ace/OS_NS_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE ACE_Per_CPU_RW_Thread_Mutex::Slot &
+ACE_Per_CPU_RW_Thread_Mutex::slot ()
+{
+#if defined (ACE_LINUX)
+  // Read from the kernel's per thread data, without a system call.
+  int const cpu = ::sched_getcpu ();
+  if (cpu >= 0)
+    return this->slots_[static_cast<size_t> (cpu) & this->mask_];
+#endif /* ACE_LINUX */
+  return this->slots_[thread_index () & this->mask_];
+}
+
+ACE_INLINE int
+ACE_Per_CPU_RW_Thread_Mutex::acquire_read ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::acquire_read");
+  // Count ourselves in first, then look for a writer; the writer
+  // announces itself first, then counts readers.  Both are
+  // sequentially consistent, so at least one of them sees the other.
+  Slot &slot = this->slot ();
+  slot.readers_.fetch_add (1);
+  if (this->writer_.load () == NO_WRITER)
+    return 0;
+
+  slot.readers_.fetch_sub (1, std::memory_order_release);
+  return this->acquire_read_i ();
+}
+
+ACE_INLINE int
+ACE_Per_CPU_RW_Thread_Mutex::tryacquire_read ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::tryacquire_read");
+  Slot &slot = this->slot ();
+  slot.readers_.fetch_add (1);
+  if (this->writer_.load () == NO_WRITER)
+    return 0;
+
+  slot.readers_.fetch_sub (1, std::memory_order_release);
+  errno = EBUSY;
+  return -1;
+}
+
+ACE_INLINE int
+ACE_Per_CPU_RW_Thread_Mutex::release ()
+{
+// ACE_TRACE ("ACE_Per_CPU_RW_Thread_Mutex::release");
+  // Only the writer itself can see WRITER_HOLDS while it holds the
+  // lock.  A reader may run on another CPU than when it came in, so
+  // single counters can go below zero; only their sum matters.
+  if (this->writer_.load (std::memory_order_relaxed) == WRITER_HOLDS)
+    this->writer_done ();
+  else
+    this->slot ().readers_.fetch_sub (1, std::memory_order_release);
+  return 0;
+}
+
+ACE_INLINE int
+ACE_Per_CPU_RW_Thread_Mutex::acquire ()
+{
+  return this->acquire_write ();
+}
+
+ACE_INLINE int
+ACE_Per_CPU_RW_Thread_Mutex::tryacquire ()
+{
+  return this->tryacquire_write ();
+}
+
+ACE_INLINE size_t
+ACE_Per_CPU_RW_Thread_Mutex::slots () const
+{
+  return this->mask_ + 1;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -32,18 +32,24 @@
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 template <class ACE_CHAR_T> class ACE_String_Base;  // Forward declaration.
+template <class ACE_CHAR_T> class ACE_String_View;  // Forward declaration.
 
 typedef ACE_WCHAR_T ACE_WSTRING_TYPE;
 
 typedef ACE_String_Base<char> ACE_CString;
 typedef ACE_String_Base<ACE_WSTRING_TYPE> ACE_WString;
 
+typedef ACE_String_View<char> ACE_CString_View;
+typedef ACE_String_View<ACE_WSTRING_TYPE> ACE_WString_View;
+
 // This allows one to use W or C String based on the Unicode
 // setting
 #if defined (ACE_USES_WCHAR)
 typedef ACE_WString ACE_TString;
+typedef ACE_WString_View ACE_TString_View;
 #else /* ACE_USES_WCHAR */
 typedef ACE_CString ACE_TString;
+typedef ACE_CString_View ACE_TString_View;
 #endif /* ACE_USES_WCHAR */
 
 ACE_END_VERSIONED_NAMESPACE_DECL
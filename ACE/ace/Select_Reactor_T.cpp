@@ -14,6 +14,7 @@
 #include "ace/Sig_Handler.h"
 #include "ace/Thread.h"
 #include "ace/Timer_Heap.h"
+#include "ace/Cached_Time_Policy.h"
 #include "ace/OS_NS_errno.h"
 #include "ace/OS_NS_sys_select.h"
 #include "ace/OS_NS_sys_stat.h"
@@ -1109,6 +1110,9 @@ ACE_Select_Reactor_T<ACE_SELECT_REACTOR_TOKEN>::wait_for_multiple_events
         }
       while (number_of_active_handles == -1 && this->handle_error () > 0);
 
+      // Time has passed while waiting.
+      ACE_Cached_Time_Policy::invalidate ();
+
       if (number_of_active_handles > 0)
         {
 #if !defined (ACE_WIN32)
@@ -1404,7 +1408,12 @@ ACE_Select_Reactor_T<ACE_SELECT_REACTOR_TOKEN>::handle_events
   // Stash the current time -- the destructor of this object will
   // automatically compute how much time elapsed since this method was
   // called.
-  ACE_Countdown_Time countdown (max_wait_time);
+  ACE_Countdown_Time_T<ACE_Cached_Time_Policy> countdown (max_wait_time);
+
+  // Share one clock read between the timer queue and the handlers,
+  // if asked to.
+  ACE_Cached_Time_Policy::Scope cached_time (
+    ACE_Cached_Time_Policy::reactor_scope ());
 
 #if defined (ACE_MT_SAFE) && (ACE_MT_SAFE != 0)
 
@@ -16,6 +16,53 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 ACE_ALLOC_HOOK_DEFINE_Tc(ACE_String_Base)
 
+template <class ACE_CHAR_T> u_long
+ACE_String_View<ACE_CHAR_T>::hash () const
+{
+  return
+    ACE::hash_pjw (reinterpret_cast<const char *> (this->rep_),
+                   this->len_ * sizeof (ACE_CHAR_T));
+}
+
+template <class ACE_CHAR_T> typename ACE_String_View<ACE_CHAR_T>::size_type
+ACE_String_View<ACE_CHAR_T>::find (
+  const ACE_String_View<ACE_CHAR_T> &s,
+  typename ACE_String_View<ACE_CHAR_T>::size_type pos) const
+{
+  if (pos > this->len_ || s.len_ > this->len_ - pos)
+    return ACE_String_View<ACE_CHAR_T>::npos;
+
+  if (s.len_ == 0)
+    return pos;
+
+  size_type const last = this->len_ - s.len_;
+  for (size_type i = pos; i <= last; ++i)
+    if (this->rep_[i] == s.rep_[0]
+        && ACE_OS::memcmp (this->rep_ + i,
+                           s.rep_,
+                           s.len_ * sizeof (ACE_CHAR_T)) == 0)
+      return i;
+
+  return ACE_String_View<ACE_CHAR_T>::npos;
+}
+
+template <class ACE_CHAR_T> int
+ACE_String_View<ACE_CHAR_T>::compare (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  // Same order as ACE_String_Base::compare().
+  size_type const smaller_length = ace_min (this->len_, s.len_);
+
+  int result = ACE_OS::memcmp (this->rep_,
+                               s.rep_,
+                               smaller_length * sizeof (ACE_CHAR_T));
+
+  if (result == 0 && this->len_ != s.len_)
+    result = this->len_ > s.len_ ? 1 : -1;
+  return result;
+}
+
+// ----------------------------------------------
+
 template <class ACE_CHAR_T>
 ACE_CHAR_T ACE_String_Base<ACE_CHAR_T>::NULL_String_ = 0;
 
@@ -96,6 +143,42 @@ ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (const ACE_String_Base<ACE_CHAR_T>
   this->set (s.rep_, s.len_, true);
 }
 
+// Move constructor.
+
+template <class ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (ACE_String_Base<ACE_CHAR_T> &&s)
+  : allocator_ (s.allocator_ ? s.allocator_ : ACE_Allocator::instance ()),
+    len_ (0),
+    buf_len_ (0),
+    rep_ (&ACE_String_Base<ACE_CHAR_T>::NULL_String_),
+    release_ (false)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::ACE_String_Base");
+
+  // A buffer we do not own may not outlive <s>, so copy it.
+  if (s.release_)
+    this->swap (s);
+  else
+    {
+      this->set (s.rep_, s.len_, true);
+      s.clear (true);
+    }
+}
+
+template <class ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (const ACE_String_View<ACE_CHAR_T> &s,
+                                              ACE_Allocator *the_allocator)
+  : allocator_ (the_allocator ? the_allocator : ACE_Allocator::instance ()),
+    len_ (0),
+    buf_len_ (0),
+    rep_ (0),
+    release_ (false)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::ACE_String_Base");
+
+  this->set (s.fast_rep (), s.length (), true);
+}
+
 template <class ACE_CHAR_T>
 ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (
   typename ACE_String_Base<ACE_CHAR_T>::size_type len,
@@ -117,8 +200,20 @@ ACE_String_Base<ACE_CHAR_T>::~ACE_String_Base ()
 {
   ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::~ACE_String_Base");
 
-  if (this->buf_len_ != 0 && this->release_)
-      this->allocator_->free (this->rep_);
+  this->free_rep ();
+}
+
+template <class ACE_CHAR_T> ACE_CHAR_T *
+ACE_String_Base<ACE_CHAR_T>::allocate_rep (
+  typename ACE_String_Base<ACE_CHAR_T>::size_type &buf_len)
+{
+  if (buf_len <= INLINE_SIZE && this->rep_ != this->inline_)
+    {
+      buf_len = INLINE_SIZE;
+      return this->inline_;
+    }
+
+  return static_cast<ACE_CHAR_T *> (this->allocator_->malloc (buf_len * sizeof (ACE_CHAR_T)));
 }
 
 // this method might benefit from a little restructuring.
@@ -132,11 +227,9 @@ ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s,
   if (s != 0 && len != 0 && release && this->buf_len_ < new_buf_len)
     {
       ACE_CHAR_T *temp = 0;
-      ACE_ALLOCATOR (temp,
-                     (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)));
+      ACE_ALLOCATOR (temp, this->allocate_rep (new_buf_len));
 
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
       this->rep_ = temp;
       this->buf_len_ = new_buf_len;
@@ -150,11 +243,8 @@ ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s,
       // Free memory if necessary and figure out future ownership
       if (!release || s == 0 || len == 0)
         {
-          if (this->buf_len_ != 0 && this->release_)
-            {
-              this->allocator_->free (this->rep_);
-              this->release_ = false;
-            }
+          this->free_rep ();
+          this->release_ = false;
         }
       // Populate data.
       if (s == 0 || len == 0)
@@ -221,21 +311,19 @@ ACE_String_Base<ACE_CHAR_T>::append (const ACE_CHAR_T* s,
     }
     else // case 2. Memory reallocation is needed
     {
-      const size_type new_buf_len =
+      size_type new_buf_len =
         ace_max(this->len_ + slen + 1, this->buf_len_ + this->buf_len_ / 2);
 
       ACE_CHAR_T *t = 0;
 
-      ACE_ALLOCATOR_RETURN (t,
-        (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)), *this);
+      ACE_ALLOCATOR_RETURN (t, this->allocate_rep (new_buf_len), *this);
 
       // Copy memory from old string into new string.
       ACE_OS::memcpy (t, this->rep_, this->len_ * sizeof (ACE_CHAR_T));
 
       ACE_OS::memcpy (t + this->len_, s, slen * sizeof (ACE_CHAR_T));
 
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
       this->release_ = true;
       this->rep_ = t;
@@ -276,12 +364,11 @@ ACE_String_Base<ACE_CHAR_T>::fast_resize (size_t len)
   // Only reallocate if we don't have enough space...
   if (this->buf_len_ <= len)
     {
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
-      this->rep_ = static_cast<ACE_CHAR_T*>
-                     (this->allocator_->malloc ((len + 1) * sizeof (ACE_CHAR_T)));
-      this->buf_len_ = len + 1;
+      size_type new_buf_len = len + 1;
+      this->rep_ = this->allocate_rep (new_buf_len);
+      this->buf_len_ = new_buf_len;
       this->release_ = true;
     }
   this->len_ = 0;
@@ -295,8 +382,7 @@ ACE_String_Base<ACE_CHAR_T>::clear (bool release)
   // This can't use set(), because that would free memory if release=false
   if (release)
   {
-    if (this->buf_len_ != 0 && this->release_)
-      this->allocator_->free (this->rep_);
+    this->free_rep ();
 
     this->rep_ = &ACE_String_Base<ACE_CHAR_T>::NULL_String_;
     this->len_ = 0;
@@ -334,6 +420,26 @@ ACE_String_Base<ACE_CHAR_T>::operator= (const ACE_String_Base<ACE_CHAR_T> &s)
   return *this;
 }
 
+// Move assignment operator.
+template <class ACE_CHAR_T> ACE_String_Base<ACE_CHAR_T> &
+ACE_String_Base<ACE_CHAR_T>::operator= (ACE_String_Base<ACE_CHAR_T> &&s)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator=");
+
+  if (this != &s)
+    {
+      // Only a buffer <s> owns, from our allocator, can be taken
+      // over; our old buffer goes with <s>.
+      if (s.release_ && this->allocator_ == s.allocator_)
+        this->swap (s);
+      else
+        this->set (s.rep_, s.len_, true);
+      s.clear (true);
+    }
+
+  return *this;
+}
+
 template <class ACE_CHAR_T> void
 ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s, bool release)
 {
@@ -468,11 +574,24 @@ ACE_String_Base<ACE_CHAR_T>::rfind (
 template <class ACE_CHAR_T> void
 ACE_String_Base<ACE_CHAR_T>::swap (ACE_String_Base<ACE_CHAR_T> & str)
 {
+  bool const this_inline = this->rep_ == this->inline_;
+  bool const str_inline = str.rep_ == str.inline_;
+
   std::swap (this->allocator_ , str.allocator_);
   std::swap (this->len_       , str.len_);
   std::swap (this->buf_len_   , str.buf_len_);
   std::swap (this->rep_       , str.rep_);
   std::swap (this->release_   , str.release_);
+
+  // Inline characters stay with the buffers, which do not move.
+  if (this_inline || str_inline)
+    {
+      std::swap (this->inline_, str.inline_);
+      if (str_inline)
+        this->rep_ = this->inline_;
+      if (this_inline)
+        str.rep_ = str.inline_;
+    }
 }
 
 // ----------------------------------------------
@@ -661,6 +780,32 @@ ACE_String_Base<ACE_CHAR_T>::operator+= (const ACE_CHAR_T c)
   return r;
 }
 
+template <class ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T> &
+ACE_String_Base<ACE_CHAR_T>::operator+= (const ACE_String_View<ACE_CHAR_T> &s)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator+=(const ACE_String_View<ACE_CHAR_T> &)");
+  return this->append (s.fast_rep (), s.length ());
+}
+
+template <class ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T> &
+ACE_String_Base<ACE_CHAR_T>::operator= (const ACE_String_View<ACE_CHAR_T> &s)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator=(const ACE_String_View<ACE_CHAR_T> &)");
+
+  // A view of our own characters would be overwritten while it is
+  // being copied, so copy it aside first.
+  if (s.fast_rep () >= this->rep_ && s.fast_rep () < this->rep_ + this->buf_len_)
+    {
+      ACE_String_Base<ACE_CHAR_T> temp (s, this->allocator_);
+      this->swap (temp);
+    }
+  else
+    this->set (s.fast_rep (), s.length (), true);
+  return *this;
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 #endif  /* ACE_STRING_BASE_CPP */
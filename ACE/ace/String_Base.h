@@ -23,6 +23,19 @@
 #include "ace/String_Base_Const.h"
 #include <iterator>
 
+#if defined (ACE_HAS_CPP17)
+# include <string_view>
+#endif /* ACE_HAS_CPP17 */
+
+#if !defined (ACE_STRING_BASE_INLINE_BYTES)
+/// Bytes of characters, terminating nul included, an ACE_String_Base
+/// holds in itself rather than in memory from its allocator.  The
+/// default makes an ACE_CString 64 bytes and keeps strings of up to
+/// 23 chars out of the allocator.  0 keeps every string in memory
+/// from the allocator, as before this buffer was added.
+# define ACE_STRING_BASE_INLINE_BYTES 24
+#endif /* ACE_STRING_BASE_INLINE_BYTES */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Forward decl.
@@ -33,6 +46,117 @@ class ACE_String_Base_Iterator;
 template <class ACE_CHAR_T>
 class ACE_String_Base_Const_Iterator;
 
+// Forward decl.
+template <class ACE_CHAR_T>
+class ACE_String_Base;
+
+/**
+ * @class ACE_String_View
+ *
+ * @brief A non-owning reference to a run of characters.
+ *
+ * A view is a pointer and a length: it never allocates, and never
+ * copies the characters, which must outlive it and need not be nul
+ * terminated.  It converts implicitly from a nul terminated string
+ * and from an ACE_String_Base, so that a function taking a view
+ * accepts either without building a temporary string.
+ */
+template <class ACE_CHAR_T>
+class ACE_String_View : public ACE_String_Base_Const
+{
+public:
+  using ACE_String_Base_Const::size_type;
+
+  /// Empty view.
+  ACE_String_View ();
+
+  /// View of the nul terminated @a s, empty if @a s is 0.
+  ACE_String_View (const ACE_CHAR_T *s);
+
+  /// View of the @a len characters at @a s.
+  ACE_String_View (const ACE_CHAR_T *s, size_type len);
+
+  /// View of the characters of @a s, valid until @a s changes.
+  ACE_String_View (const ACE_String_Base<ACE_CHAR_T> &s);
+
+#if defined (ACE_HAS_CPP17)
+  /// View of the characters of @a s.
+  template <class TRAITS>
+  ACE_String_View (std::basic_string_view<ACE_CHAR_T, TRAITS> s)
+    : rep_ (s.data ()), len_ (s.size ())
+  {
+  }
+
+  /// Standard view of the same characters.
+  template <class TRAITS>
+  operator std::basic_string_view<ACE_CHAR_T, TRAITS> () const
+  {
+    return std::basic_string_view<ACE_CHAR_T, TRAITS> (this->rep_, this->len_);
+  }
+#endif /* ACE_HAS_CPP17 */
+
+  /// The first character; not necessarily nul terminated.
+  const ACE_CHAR_T *fast_rep () const;
+
+  /// Same as fast_rep().
+  const ACE_CHAR_T *data () const;
+
+  /// Number of characters.
+  size_type length () const;
+
+  /// Return @c true if the view has no characters.
+  bool is_empty () const;
+
+  /// Return the <slot'th> character (doesn't perform bounds checking).
+  const ACE_CHAR_T & operator[] (size_type slot) const;
+
+  /// Pointer to the first character.
+  const ACE_CHAR_T *begin () const;
+
+  /// Pointer past the last character.
+  const ACE_CHAR_T *end () const;
+
+  /**
+   * Return the view of a part of this one given an offset and length.
+   * If length == @c npos use the rest of the view.  Return an empty
+   * view if offset is past the end.
+   */
+  ACE_String_View<ACE_CHAR_T> substr (size_type offset,
+                                      size_type length = npos) const;
+
+  /// Find @a c starting at @a pos.  Returns the slot of the first
+  /// location that matches (will be >= pos), else @c npos.
+  size_type find (ACE_CHAR_T c, size_type pos = 0) const;
+
+  /// Find @a s starting at @a pos.  Returns the slot of the first
+  /// location that matches (will be >= pos), else @c npos.
+  size_type find (const ACE_String_View<ACE_CHAR_T> &s, size_type pos = 0) const;
+
+  /// Less than 0, 0 or greater than 0 as this view sorts before,
+  /// equal to or after @a s.
+  int compare (const ACE_String_View<ACE_CHAR_T> &s) const;
+
+  /// Equality comparison operator (must match entire string).
+  bool operator == (const ACE_String_View<ACE_CHAR_T> &s) const;
+
+  /// Inequality comparison operator.
+  bool operator != (const ACE_String_View<ACE_CHAR_T> &s) const;
+
+  /// Less than comparison operator.
+  bool operator < (const ACE_String_View<ACE_CHAR_T> &s) const;
+
+  /// Returns the same hash value as ACE_String_Base::hash() for the
+  /// same characters.
+  u_long hash () const;
+
+private:
+  /// The first character.
+  const ACE_CHAR_T *rep_;
+
+  /// Number of characters.
+  size_type len_;
+};
+
 /**
  * @class ACE_String_Base
  *
@@ -43,6 +167,12 @@ class ACE_String_Base_Const_Iterator;
  * ACE_Allocator with a persistable memory pool.  This class is
  * optimized for efficiency, so it doesn't provide any internal
  * locking.
+ * @note Strings of up to ACE_STRING_BASE_INLINE_BYTES bytes,
+ * terminating nul included, are kept in the object itself and do
+ * not call the allocator.  Their characters therefore move with the
+ * object: after a swap() or a move, a pointer obtained from
+ * fast_rep() or c_str() of a short string refers to the characters
+ * of the other object.
  * @note If an instance of this class is constructed from or
  * assigned an empty string (with first element of '\0'), then it
  * is not allocated new space.  Instead, its internal
@@ -69,6 +199,7 @@ public:
 
   friend class ACE_String_Base_Iterator <ACE_CHAR_T>;
   friend class ACE_String_Base_Const_Iterator <ACE_CHAR_T>;
+  friend class ACE_String_View <ACE_CHAR_T>;
 
   // ACE-style iterators
   typedef ACE_String_Base_Iterator <ACE_CHAR_T> ITERATOR;
@@ -135,6 +266,23 @@ public:
    */
   ACE_String_Base (const ACE_String_Base < ACE_CHAR_T > &s);
 
+  /**
+   *  Move constructor.  Takes over the buffer of @a s if @a s owns
+   *  one, else copies @a s.  Leaves @a s empty.
+   *
+   *  @param s Input ACE_String_Base string to move from
+   */
+  ACE_String_Base (ACE_String_Base < ACE_CHAR_T > &&s);
+
+  /**
+   *  Constructor that copies the characters of @a s.
+   *
+   *  @param s View of the characters to copy
+   *  @param the_allocator ACE_Allocator associated with string
+   */
+  explicit ACE_String_Base (const ACE_String_View < ACE_CHAR_T > &s,
+                            ACE_Allocator *the_allocator = 0);
+
   /**
    *  Constructor that copies @a c into dynamically allocated memory.
    *
@@ -200,6 +348,24 @@ public:
    */
   ACE_String_Base < ACE_CHAR_T > &operator = (const ACE_String_Base < ACE_CHAR_T > &s);
 
+  /**
+   *  Move assignment operator.  Takes over the buffer of @a s if @a s
+   *  owns one from the same allocator as this string, else copies
+   *  @a s.  Leaves @a s empty.
+   *
+   *  @param s Input ACE_String_Base string to move from.
+   *  @return Return this string.
+   */
+  ACE_String_Base < ACE_CHAR_T > &operator = (ACE_String_Base < ACE_CHAR_T > &&s);
+
+  /**
+   *  Assignment operator (does copy memory).
+   *
+   *  @param s View of the characters to assign to this object.
+   *  @return Return this string.
+   */
+  ACE_String_Base < ACE_CHAR_T > &operator = (const ACE_String_View < ACE_CHAR_T > &s);
+
   /**
    *  Assignment alternative method (does not copy memory).
    *
@@ -329,6 +495,15 @@ public:
    */
   ACE_String_Base < ACE_CHAR_T >& operator += (const ACE_CHAR_T c);
 
+  /**
+   *  Concat operator (copies memory).
+   *
+   *  @param s View of the characters to concatenate to this string.
+   *  @return The combined string (input append to the end of the old). New
+   *    string is zero terminated.
+   */
+  ACE_String_Base < ACE_CHAR_T >& operator += (const ACE_String_View < ACE_CHAR_T > &s);
+
   /**
    *  Append function (copies memory).
    *
@@ -402,6 +577,12 @@ public:
    */
   const ACE_CHAR_T *c_str () const;
 
+  /**
+   *  Return a view of the characters of this string, valid until it
+   *  changes.
+   */
+  ACE_String_View<ACE_CHAR_T> view () const;
+
   /**
    *  Comparison operator that will match substrings.  Returns the
    *  slot of the first location that matches, else @c npos.
@@ -472,6 +653,14 @@ public:
    */
   bool operator == (const ACE_CHAR_T *s) const;
 
+  /**
+   *  Equality comparison operator (must match entire string).
+   *
+   * @param s View of the characters to compare against stored string.
+   * @return @c true if equal, @c false otherwise.
+   */
+  bool operator == (const ACE_String_View<ACE_CHAR_T> &s) const;
+
   /**
    *  Less than comparison operator.
    *
@@ -504,6 +693,14 @@ public:
    */
   bool operator != (const ACE_CHAR_T *s) const;
 
+  /**
+   *  Inequality comparison operator.
+   *
+   *  @param s View of the characters to compare against stored string.
+   *  @return @c true if not equal, @c false otherwise.
+   */
+  bool operator != (const ACE_String_View<ACE_CHAR_T> &s) const;
+
   /**
    *  Performs a strncmp comparison.
    *
@@ -558,6 +755,19 @@ public:
   ACE_ALLOC_HOOK_DECLARE;
 
 protected:
+  /**
+   *  Return a new buffer of at least @a buf_len CHARs: the inline one
+   *  when it is large enough and not already in use, else one from
+   *  the allocator, or 0.  @a buf_len is set to the size of the
+   *  buffer returned.
+   */
+  ACE_CHAR_T *allocate_rep (size_type &buf_len);
+
+  /**
+   *  Free rep_ if this string owns it and it is not the inline buffer.
+   */
+  void free_rep ();
+
   /**
    *  Pointer to a memory allocator.
    */
@@ -588,6 +798,16 @@ protected:
    *  Represents the "NULL" string to simplify the internal logic.
    */
   static ACE_CHAR_T NULL_String_;
+
+  /**
+   *  Number of CHARs of the inline buffer.
+   */
+  enum { INLINE_SIZE = ACE_STRING_BASE_INLINE_BYTES / sizeof (ACE_CHAR_T) };
+
+  /**
+   *  The buffer of short strings, owned when rep_ points to it.
+   */
+  ACE_CHAR_T inline_[INLINE_SIZE > 0 ? INLINE_SIZE : 1];
 };
 
 /**
@@ -37,6 +37,19 @@ ACE_String_Base<ACE_CHAR_T>::capacity () const
   return this->buf_len_;
 }
 
+template <class ACE_CHAR_T> ACE_INLINE void
+ACE_String_Base<ACE_CHAR_T>::free_rep ()
+{
+  if (this->buf_len_ != 0 && this->release_ && this->rep_ != this->inline_)
+    this->allocator_->free (this->rep_);
+}
+
+template <class ACE_CHAR_T> ACE_INLINE ACE_String_View<ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T>::view () const
+{
+  return ACE_String_View<ACE_CHAR_T> (this->rep_, this->len_);
+}
+
 template <class ACE_CHAR_T> ACE_INLINE bool
 ACE_String_Base<ACE_CHAR_T>::is_empty () const
 {
@@ -118,6 +131,20 @@ ACE_String_Base<ACE_CHAR_T>::operator!= (const ACE_String_Base<ACE_CHAR_T> &s) c
   return !(*this == s);
 }
 
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_Base<ACE_CHAR_T>::operator== (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator==");
+  return this->view () == s;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_Base<ACE_CHAR_T>::operator!= (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator!=");
+  return !(this->view () == s);
+}
+
 template <class ACE_CHAR_T> ACE_INLINE bool
 ACE_String_Base<ACE_CHAR_T>::operator!= (const ACE_CHAR_T *s) const
 {
@@ -441,6 +468,124 @@ operator <= (const ACE_String_Base_Const_Iterator <ACE_CHAR_T> & rhs) const
 
 // ----------------------------------------------
 
+template <class ACE_CHAR_T> ACE_INLINE
+ACE_String_View<ACE_CHAR_T>::ACE_String_View ()
+  : rep_ (&ACE_String_Base<ACE_CHAR_T>::NULL_String_),
+    len_ (0)
+{
+}
+
+template <class ACE_CHAR_T> ACE_INLINE
+ACE_String_View<ACE_CHAR_T>::ACE_String_View (const ACE_CHAR_T *s)
+  : rep_ (s != 0 ? s : &ACE_String_Base<ACE_CHAR_T>::NULL_String_),
+    len_ (s != 0 ? ACE_OS::strlen (s) : 0)
+{
+}
+
+template <class ACE_CHAR_T> ACE_INLINE
+ACE_String_View<ACE_CHAR_T>::ACE_String_View (
+  const ACE_CHAR_T *s,
+  typename ACE_String_View<ACE_CHAR_T>::size_type len)
+  : rep_ (s != 0 ? s : &ACE_String_Base<ACE_CHAR_T>::NULL_String_),
+    len_ (s != 0 ? len : 0)
+{
+}
+
+template <class ACE_CHAR_T> ACE_INLINE
+ACE_String_View<ACE_CHAR_T>::ACE_String_View (const ACE_String_Base<ACE_CHAR_T> &s)
+  : rep_ (s.fast_rep ()),
+    len_ (s.length ())
+{
+}
+
+template <class ACE_CHAR_T> ACE_INLINE const ACE_CHAR_T *
+ACE_String_View<ACE_CHAR_T>::fast_rep () const
+{
+  return this->rep_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE const ACE_CHAR_T *
+ACE_String_View<ACE_CHAR_T>::data () const
+{
+  return this->rep_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE typename ACE_String_View<ACE_CHAR_T>::size_type
+ACE_String_View<ACE_CHAR_T>::length () const
+{
+  return this->len_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_View<ACE_CHAR_T>::is_empty () const
+{
+  return this->len_ == 0;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE const ACE_CHAR_T &
+ACE_String_View<ACE_CHAR_T>::operator[] (
+  typename ACE_String_View<ACE_CHAR_T>::size_type slot) const
+{
+  return this->rep_[slot];
+}
+
+template <class ACE_CHAR_T> ACE_INLINE const ACE_CHAR_T *
+ACE_String_View<ACE_CHAR_T>::begin () const
+{
+  return this->rep_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE const ACE_CHAR_T *
+ACE_String_View<ACE_CHAR_T>::end () const
+{
+  return this->rep_ + this->len_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE ACE_String_View<ACE_CHAR_T>
+ACE_String_View<ACE_CHAR_T>::substr (
+  typename ACE_String_View<ACE_CHAR_T>::size_type offset,
+  typename ACE_String_View<ACE_CHAR_T>::size_type length) const
+{
+  if (offset >= this->len_)
+    return ACE_String_View<ACE_CHAR_T> ();
+
+  size_type const rest = this->len_ - offset;
+  return ACE_String_View<ACE_CHAR_T> (this->rep_ + offset,
+                                      length < rest ? length : rest);
+}
+
+template <class ACE_CHAR_T> ACE_INLINE typename ACE_String_View<ACE_CHAR_T>::size_type
+ACE_String_View<ACE_CHAR_T>::find (
+  ACE_CHAR_T c,
+  typename ACE_String_View<ACE_CHAR_T>::size_type pos) const
+{
+  for (size_type i = pos; i < this->len_; ++i)
+    if (this->rep_[i] == c)
+      return i;
+  return ACE_String_View<ACE_CHAR_T>::npos;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_View<ACE_CHAR_T>::operator== (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  return this->len_ == s.len_
+    && ACE_OS::memcmp (this->rep_, s.rep_, this->len_ * sizeof (ACE_CHAR_T)) == 0;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_View<ACE_CHAR_T>::operator!= (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  return !(*this == s);
+}
+
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_View<ACE_CHAR_T>::operator< (const ACE_String_View<ACE_CHAR_T> &s) const
+{
+  return this->compare (s) < 0;
+}
+
+// ----------------------------------------------
+
 template <class ACE_CHAR_T> ACE_INLINE bool
 operator== (const ACE_CHAR_T *s,
             const ACE_String_Base<ACE_CHAR_T> &t)
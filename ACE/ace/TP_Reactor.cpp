@@ -5,6 +5,7 @@
 #include "ace/Log_Category.h"
 #include "ace/Functor_T.h"
 #include "ace/OS_NS_sys_time.h"
+#include "ace/Cached_Time_Policy.h"
 
 #if !defined (__ACE_INLINE__)
 #include "ace/TP_Reactor.inl"
@@ -142,7 +143,12 @@ ACE_TP_Reactor::handle_events (ACE_Time_Value *max_wait_time)
   // Stash the current time -- the destructor of this object will
   // automatically compute how much time elapsed since this method was
   // called.
-  ACE_Countdown_Time countdown (max_wait_time);
+  ACE_Countdown_Time_T<ACE_Cached_Time_Policy> countdown (max_wait_time);
+
+  // Share one clock read between the timer queue and the handlers,
+  // if asked to.
+  ACE_Cached_Time_Policy::Scope cached_time (
+    ACE_Cached_Time_Policy::reactor_scope ());
 
   //
   // The order of these events is very subtle, modify with care.
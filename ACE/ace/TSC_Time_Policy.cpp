@@ -0,0 +1,226 @@
+#include "ace/TSC_Time_Policy.h"
+#include "ace/Monotonic_Time_Policy.h"
+#include "ace/OS_NS_time.h"
+
+#if !defined(__ACE_INLINE__)
+# include "ace/TSC_Time_Policy.inl"
+#endif /* __ACE_INLINE__ */
+
+#if (defined (__GNUC__) || defined (__clang__)) \
+    && (defined (__x86_64__) || defined (__i386__)) \
+    && defined (ACE_HAS_CLOCK_GETTIME_MONOTONIC)
+# define ACE_TSC_TIME_POLICY_USES_TSC
+# include <cpuid.h>
+# include <x86intrin.h>
+# include <atomic>
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TSC_TIME_POLICY_USES_TSC)
+
+namespace
+{
+  /// Recalibrate after this many nanoseconds.
+  const ACE_UINT64 recalibrate_ns = 1000000000;
+
+  /// Length of the first calibration.
+  const ACE_UINT64 first_calibration_ns = 2000000;
+
+  ACE_UINT64
+  monotonic_ns ()
+  {
+    struct timespec ts;
+    ACE_OS::clock_gettime (CLOCK_MONOTONIC, &ts);
+    return static_cast<ACE_UINT64> (ts.tv_sec) * 1000000000
+      + static_cast<ACE_UINT64> (ts.tv_nsec);
+  }
+
+  /// Read the counter and the monotonic clock at the same moment, as
+  /// far as can be told: retry when it took long, as when the thread
+  /// was preempted in between.
+  void
+  sample (ACE_UINT64 &tsc, ACE_UINT64 &ns)
+  {
+    ACE_UINT64 best = ~ACE_UINT64 (0);
+    for (int i = 0; i != 4; ++i)
+      {
+        ACE_UINT64 const before = __rdtsc ();
+        ACE_UINT64 const now = monotonic_ns ();
+        ACE_UINT64 const after = __rdtsc ();
+        if (after - before < best)
+          {
+            best = after - before;
+            tsc = before + best / 2;
+            ns = now;
+          }
+      }
+  }
+
+  /**
+   * Converts counter values to nanoseconds: the time at @c tsc_ was
+   * @c ns_, and a tick lasts @c mult_ / 2^32 nanoseconds.  Updated
+   * under a sequence lock, so readers do not block.
+   */
+  struct Calibration
+  {
+    std::atomic<unsigned> seq_;
+    std::atomic<ACE_UINT64> tsc_;
+    std::atomic<ACE_UINT64> ns_;
+    std::atomic<ACE_UINT64> mult_;
+
+    /// The first sample, from which the rate is measured.
+    ACE_UINT64 origin_tsc_;
+    ACE_UINT64 origin_ns_;
+
+    /// Held by the thread recalibrating.
+    std::atomic<bool> busy_;
+
+    bool invariant_;
+
+    Calibration ();
+
+    ACE_UINT64 ns (ACE_UINT64 tsc);
+
+    void recalibrate ();
+  };
+
+  ACE_UINT64
+  scale (ACE_UINT64 ticks, ACE_UINT64 mult)
+  {
+    return (ticks >> 32) * mult
+      + (((ticks & 0xffffffffu) * (mult & 0xffffffffu)) >> 32)
+      + (ticks & 0xffffffffu) * (mult >> 32);
+  }
+
+  Calibration::Calibration ()
+    : seq_ (0),
+      tsc_ (0),
+      ns_ (0),
+      mult_ (0),
+      origin_tsc_ (0),
+      origin_ns_ (0),
+      busy_ (false),
+      invariant_ (false)
+  {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid (0x80000007, &eax, &ebx, &ecx, &edx) == 0
+        || (edx & (1u << 8)) == 0)
+      return;
+
+    sample (this->origin_tsc_, this->origin_ns_);
+    ACE_UINT64 tsc = 0, ns = 0;
+    do
+      sample (tsc, ns);
+    while (ns - this->origin_ns_ < first_calibration_ns
+           || tsc <= this->origin_tsc_);
+
+    this->tsc_ = tsc;
+    this->ns_ = ns;
+    this->mult_ = static_cast<ACE_UINT64> (
+      static_cast<double> (ns - this->origin_ns_) * 4294967296.0
+      / static_cast<double> (tsc - this->origin_tsc_));
+    this->invariant_ = true;
+  }
+
+  ACE_UINT64
+  Calibration::ns (ACE_UINT64 tsc)
+  {
+    for (;;)
+      {
+        unsigned const seq = this->seq_.load (std::memory_order_acquire);
+        ACE_UINT64 const base_tsc = this->tsc_.load (std::memory_order_relaxed);
+        ACE_UINT64 const base_ns = this->ns_.load (std::memory_order_relaxed);
+        ACE_UINT64 const mult = this->mult_.load (std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if ((seq & 1) != 0
+            || this->seq_.load (std::memory_order_relaxed) != seq)
+          continue;
+
+        // Another CPU may have read a counter a little behind ours
+        // and recalibrated since.
+        if (tsc < base_tsc)
+          return base_ns;
+        return base_ns + scale (tsc - base_tsc, mult);
+      }
+  }
+
+  void
+  Calibration::recalibrate ()
+  {
+    if (this->busy_.exchange (true, std::memory_order_acquire))
+      return;
+
+    ACE_UINT64 tsc = 0, ns = 0;
+    sample (tsc, ns);
+    if (tsc > this->origin_tsc_)
+      {
+        ACE_UINT64 const mult = static_cast<ACE_UINT64> (
+          static_cast<double> (ns - this->origin_ns_) * 4294967296.0
+          / static_cast<double> (tsc - this->origin_tsc_));
+
+        // Never go back behind what readers were given.
+        ACE_UINT64 const given = this->ns (tsc);
+        if (ns < given)
+          ns = given;
+
+        unsigned const seq = this->seq_.load (std::memory_order_relaxed);
+        this->seq_.store (seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        this->tsc_.store (tsc, std::memory_order_relaxed);
+        this->ns_.store (ns, std::memory_order_relaxed);
+        this->mult_.store (mult, std::memory_order_relaxed);
+        this->seq_.store (seq + 2, std::memory_order_release);
+      }
+
+    this->busy_.store (false, std::memory_order_release);
+  }
+
+  Calibration &
+  calibration ()
+  {
+    static Calibration calibration;
+    return calibration;
+  }
+}
+
+ACE_Time_Value_T<ACE_TSC_Time_Policy>
+ACE_TSC_Time_Policy::operator() () const
+{
+  Calibration &cal = calibration ();
+  if (!cal.invariant_)
+    return ACE_Time_Value_T<ACE_TSC_Time_Policy> (ACE_Monotonic_Time_Policy () ());
+
+  ACE_UINT64 const tsc = __rdtsc ();
+  ACE_UINT64 const ns = cal.ns (tsc);
+  if (ns - cal.ns_.load (std::memory_order_relaxed) > recalibrate_ns)
+    cal.recalibrate ();
+
+  return ACE_Time_Value_T<ACE_TSC_Time_Policy> (
+    ACE_Time_Value (static_cast<time_t> (ns / 1000000000),
+                    static_cast<suseconds_t> ((ns % 1000000000) / 1000)));
+}
+
+bool
+ACE_TSC_Time_Policy::uses_tsc ()
+{
+  return calibration ().invariant_;
+}
+
+#else /* !ACE_TSC_TIME_POLICY_USES_TSC */
+
+ACE_Time_Value_T<ACE_TSC_Time_Policy>
+ACE_TSC_Time_Policy::operator() () const
+{
+  return ACE_Time_Value_T<ACE_TSC_Time_Policy> (ACE_Monotonic_Time_Policy () ());
+}
+
+bool
+ACE_TSC_Time_Policy::uses_tsc ()
+{
+  return false;
+}
+
+#endif /* ACE_TSC_TIME_POLICY_USES_TSC */
+
+ACE_END_VERSIONED_NAMESPACE_DECL
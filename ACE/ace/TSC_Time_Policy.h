@@ -0,0 +1,62 @@
+#ifndef ACE_TSC_TIME_POLICY_H
+#define ACE_TSC_TIME_POLICY_H
+// -*- C++ -*-
+/**
+ *  @file TSC_Time_Policy.h
+ */
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#include /**/ "ace/Time_Value_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_TSC_Time_Policy
+ *
+ * @brief Implement a monotonic time policy that reads the CPU's time
+ * stamp counter.
+ *
+ * Returns the same time as ACE_Monotonic_Time_Policy, within a
+ * fraction of a millisecond, at the cost of reading the time stamp
+ * counter and a multiplication instead of a call to clock_gettime().
+ * The counter is calibrated against the monotonic clock on first use,
+ * which takes a few milliseconds, and again about once a second, so
+ * that the two do not drift apart.  Values never go backwards.
+ *
+ * The counter is only used on x86 CPUs whose counter runs at a
+ * constant rate in all power states (the "invariant TSC"), with a
+ * platform providing CLOCK_MONOTONIC.  Elsewhere this policy returns
+ * what ACE_Monotonic_Time_Policy does.
+ */
+class ACE_Export ACE_TSC_Time_Policy
+{
+public:
+  /// Return the current time according to this policy
+  ACE_Time_Value_T<ACE_TSC_Time_Policy> operator() () const;
+
+  /// Noop. Just here to satisfy backwards compatibility demands.
+  void set_gettimeofday (ACE_Time_Value (*gettimeofday)());
+
+  /// True if time is read from the time stamp counter, false if it is
+  /// read from the monotonic clock.
+  static bool uses_tsc ();
+};
+
+#if defined ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT
+template class ACE_Export ACE_Time_Value_T<ACE_TSC_Time_Policy>;
+#endif /* ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT */
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/TSC_Time_Policy.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TSC_TIME_POLICY_H */
@@ -13,7 +13,8 @@ ACE_Task_Base::ACE_Task_Base (ACE_Thread_Manager *thr_man)
   : thr_count_ (0),
     thr_mgr_ (thr_man),
     flags_ (0),
-    grp_id_ (-1)
+    grp_id_ (-1),
+    thread_placement_ (0)
 #if !defined (ACE_THREAD_T_IS_A_STRUCT)
     ,last_thread_id_ (0)
 #endif /* !ACE_THREAD_T_IS_A_STRUCT */
@@ -166,7 +167,8 @@ ACE_Task_Base::activate (long flags,
                                thread_handles,
                                stack,
                                stack_size,
-                               thr_name);
+                               thr_name,
+                               this->thread_placement_);
   else
     // thread names were specified
     grp_spawned =
@@ -181,7 +183,8 @@ ACE_Task_Base::activate (long flags,
                                stack_size,
                                thread_handles,
                                task,
-                               thr_name);
+                               thr_name,
+                               this->thread_placement_);
   if (grp_spawned == -1)
     {
       // If spawn_n fails, restore original thread count.
@@ -169,7 +169,7 @@ public:
    * @a n values indicating how big each of the corresponding @a stacks
    * are.
    *
-   *
+   * The threads run on the CPUs given to thread_placement(), if any.
    */
   virtual int activate (long flags = THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
                         int n_threads = 1,
@@ -217,6 +217,16 @@ public:
   /// Set the thread manager associated with this Task.
   void thr_mgr (ACE_Thread_Manager *);
 
+  /// Get the CPUs the threads spawned by activate() run on.
+  const ACE_Thread_Placement *thread_placement () const;
+
+  /**
+   * Set the CPUs the threads spawned by activate() run on, 0 to let
+   * the operating system choose.  @a placement is not copied and
+   * must outlive the calls to activate().
+   */
+  void thread_placement (const ACE_Thread_Placement *placement);
+
   /// True if queue is a reader, else false.
   int is_reader () const;
 
@@ -273,6 +283,9 @@ protected:
   /// This maintains the group id of the Task.
   int grp_id_;
 
+  /// CPUs the threads of the Task run on.
+  const ACE_Thread_Placement *thread_placement_;
+
 #if defined (ACE_MT_SAFE) && (ACE_MT_SAFE != 0)
   /// Protect the state of a Task during concurrent operations, but
   /// only if we're configured as MT safe...
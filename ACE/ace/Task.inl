@@ -38,6 +38,18 @@ ACE_Task_Base::thr_mgr (ACE_Thread_Manager *thr_mgr)
   this->thr_mgr_ = thr_mgr;
 }
 
+ACE_INLINE const ACE_Thread_Placement *
+ACE_Task_Base::thread_placement () const
+{
+  return this->thread_placement_;
+}
+
+ACE_INLINE void
+ACE_Task_Base::thread_placement (const ACE_Thread_Placement *placement)
+{
+  this->thread_placement_ = placement;
+}
+
 ACE_INLINE int
 ACE_Task_Base::is_reader () const
 {
@@ -1,7 +1,10 @@
 #include "ace/Thread_Adapter.h"
+#include "ace/ACE.h"
 #include "ace/Thread_Manager.h"
 #include "ace/Thread_Exit.h"
 #include "ace/Thread_Hook.h"
+#include "ace/Thread_Placement.h"
+#include "ace/Log_Category.h"
 #include "ace/Object_Manager_Base.h"
 #include "ace/Service_Config.h"
 
@@ -34,12 +37,27 @@ ACE_Thread_Adapter::ACE_Thread_Adapter (ACE_THR_FUNC user_func,
         , cancel_flags
         )
   , thr_mgr_ (tm)
+  , placement_ (0)
+  , placement_index_ (0)
 {
   ACE_OS_TRACE ("ACE_Thread_Adapter::ACE_Thread_Adapter");
 }
 
 ACE_Thread_Adapter::~ACE_Thread_Adapter ()
 {
+  delete this->placement_;
+}
+
+int
+ACE_Thread_Adapter::placement (const ACE_Thread_Placement &placement,
+                               size_t index)
+{
+  delete this->placement_;
+  ACE_NEW_RETURN (this->placement_,
+                  ACE_Thread_Placement (placement),
+                  -1);
+  this->placement_index_ = index;
+  return 0;
 }
 
 ACE_ALLOC_HOOK_DEFINE(ACE_Thread_Adapter);
@@ -110,6 +128,15 @@ ACE_Thread_Adapter::invoke_i ()
   // Pick up the cancel-related flags before deleting this.
   long cancel_flags = this->flags_;
 
+  // Move to our CPUs before the thread function touches any memory,
+  // so that it is allocated on their NUMA node.
+  if (this->placement_ != 0
+      && this->placement_->apply (this->placement_index_) == -1
+      && ACE::debug ())
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("(%P|%t) ACE_Thread_Adapter::invoke_i: %p\n"),
+                   ACE_TEXT ("apply placement")));
+
   // Delete ourselves since we don't need <this> anymore.  Make sure
   // not to access <this> anywhere below this point.
   delete this;
@@ -25,6 +25,7 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 // Forward decl.
 class ACE_Thread_Manager;
 class ACE_Thread_Descriptor;
+class ACE_Thread_Placement;
 
 /**
  * @class ACE_Thread_Adapter
@@ -67,6 +68,11 @@ public:
   /// Accessor for the optional ACE_Thread_Manager.
   ACE_Thread_Manager *thr_mgr ();
 
+  /// Make the new thread bind itself to the CPUs of thread @a index
+  /// of @a placement before it calls the user function.  A copy of
+  /// @a placement is kept.
+  int placement (const ACE_Thread_Placement &placement, size_t index);
+
   ACE_ALLOC_HOOK_DECLARE;
 
 protected:
@@ -81,6 +87,11 @@ private:
 private:
   /// Optional thread manager.
   ACE_Thread_Manager *thr_mgr_;
+
+  /// Optional CPUs to run on, and the index of the thread in its
+  /// group.
+  ACE_Thread_Placement *placement_;
+  size_t placement_index_;
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -8,6 +8,7 @@
 #include "ace/Time_Value.h"
 #include "ace/OS_NS_sys_time.h"
 #include "ace/Truncate.h"
+#include "ace/Thread_Placement.h"
 
 #if !defined (__ACE_INLINE__)
 #include "ace/Thread_Manager.inl"
@@ -577,7 +578,9 @@ ACE_Thread_Manager::spawn_i (ACE_THR_FUNC func,
                              void *stack,
                              size_t stack_size,
                              ACE_Task_Base *task,
-                             const char** thr_name)
+                             const char** thr_name,
+                             const ACE_Thread_Placement *placement,
+                             size_t placement_index)
 {
   // First, threads created by Thread Manager should not be daemon threads.
   // Using assertion is probably a bit too strong.  However, it helps
@@ -617,6 +620,11 @@ ACE_Thread_Manager::spawn_i (ACE_THR_FUNC func,
 # endif /* ACE_HAS_WIN32_STRUCTURAL_EXCEPTIONS */
   std::unique_ptr <ACE_Base_Thread_Adapter> auto_thread_args (static_cast<ACE_Base_Thread_Adapter *> (thread_args));
 
+  if (placement != 0
+      && !placement->empty ()
+      && thread_args->placement (*placement, placement_index) == -1)
+    return -1;
+
   ACE_TRACE ("ACE_Thread_Manager::spawn_i");
   ACE_hthread_t thr_handle;
 
@@ -694,7 +702,8 @@ ACE_Thread_Manager::spawn (ACE_THR_FUNC func,
                            int grp_id,
                            void *stack,
                            size_t stack_size,
-                           const char** thr_name)
+                           const char** thr_name,
+                           const ACE_Thread_Placement *placement)
 {
   ACE_TRACE ("ACE_Thread_Manager::spawn");
 
@@ -716,7 +725,8 @@ ACE_Thread_Manager::spawn (ACE_THR_FUNC func,
                      stack,
                      stack_size,
                      0,
-                     thr_name) == -1)
+                     thr_name,
+                     placement) == -1)
     return -1;
 
   return grp_id;
@@ -735,7 +745,8 @@ ACE_Thread_Manager::spawn_n (size_t n,
                              ACE_hthread_t thread_handles[],
                              void *stack[],
                              size_t stack_size[],
-                             const char* thr_name[])
+                             const char* thr_name[],
+                             const ACE_Thread_Placement *placement)
 {
   ACE_TRACE ("ACE_Thread_Manager::spawn_n");
   ACE_MT (ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1));
@@ -757,7 +768,9 @@ ACE_Thread_Manager::spawn_n (size_t n,
                          stack == 0 ? 0 : stack[i],
                          stack_size == 0 ? ACE_DEFAULT_THREAD_STACKSIZE : stack_size[i],
                          task,
-                         thr_name == 0 ? 0 : &thr_name [i]) == -1)
+                         thr_name == 0 ? 0 : &thr_name [i],
+                         placement,
+                         i) == -1)
         return -1;
     }
 
@@ -778,7 +791,8 @@ ACE_Thread_Manager::spawn_n (ACE_thread_t thread_ids[],
                              size_t stack_size[],
                              ACE_hthread_t thread_handles[],
                              ACE_Task_Base *task,
-                             const char* thr_name[])
+                             const char* thr_name[],
+                             const ACE_Thread_Placement *placement)
 {
   ACE_TRACE ("ACE_Thread_Manager::spawn_n");
   ACE_MT (ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1));
@@ -800,7 +814,9 @@ ACE_Thread_Manager::spawn_n (ACE_thread_t thread_ids[],
                          stack == 0 ? 0 : stack[i],
                          stack_size == 0 ? ACE_DEFAULT_THREAD_STACKSIZE : stack_size[i],
                          task,
-                         thr_name == 0 ? 0 : &thr_name [i]) == -1)
+                         thr_name == 0 ? 0 : &thr_name [i],
+                         placement,
+                         i) == -1)
         return -1;
     }
 
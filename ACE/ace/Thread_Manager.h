@@ -78,6 +78,7 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Task_Base;
 class ACE_Thread_Manager;
 class ACE_Thread_Descriptor;
+class ACE_Thread_Placement;
 
 /**
   * @class ACE_At_Thread_Exit
@@ -519,6 +520,10 @@ public:
    *                    specified as 0 and on platforms that do not have the
    *                    capability to name threads.
    *
+   * @param placement   The CPUs the spawned thread runs on, as the first
+   *                    thread of @a placement.  If 0, the thread runs
+   *                    wherever the operating system puts it.
+   *
    * @retval   -1 on failure; @c errno contains an error value.
    * @retval   The group id of the spawned thread.
    */
@@ -531,7 +536,8 @@ public:
              int grp_id = -1,
              void *stack = 0,
              size_t stack_size = ACE_DEFAULT_THREAD_STACKSIZE,
-             const char** thr_name = 0);
+             const char** thr_name = 0,
+             const ACE_Thread_Placement *placement = 0);
 
   /**
    * Spawn a specified number of threads, all of which execute @a func
@@ -591,6 +597,12 @@ public:
    *                    specified as 0 and on platforms that do not have the
    *                    capability to name threads.
    *
+   * @param placement   The CPUs the spawned threads run on.  Thread i of
+   *                    the @a n threads binds itself to the CPUs
+   *                    ACE_Thread_Placement::cpu_set() gives for i,
+   *                    before it calls @a func.  If 0, the threads run
+   *                    wherever the operating system puts them.
+   *
    * ACE_Thread_Manager can manipulate threads in groups based on
    * @a grp_id or @a task using functions such as kill_grp() or
    * cancel_task().
@@ -608,7 +620,8 @@ public:
                ACE_hthread_t thread_handles[] = 0,
                void *stack[] = 0,
                size_t stack_size[] = 0,
-               const char* thr_name[] = 0);
+               const char* thr_name[] = 0,
+               const ACE_Thread_Placement *placement = 0);
 
   /**
    * Spawn a specified number of threads, all of which execute @a func
@@ -672,6 +685,12 @@ public:
    *                    specified as 0 and on platforms that do not have the
    *                    capability to name threads.
    *
+   * @param placement   The CPUs the spawned threads run on.  Thread i of
+   *                    the @a n threads binds itself to the CPUs
+   *                    ACE_Thread_Placement::cpu_set() gives for i,
+   *                    before it calls @a func.  If 0, the threads run
+   *                    wherever the operating system puts them.
+   *
    * ACE_Thread_Manager can manipulate threads in groups based on
    * @a grp_id or @a task using functions such as kill_grp() or
    * cancel_task().
@@ -691,7 +710,8 @@ public:
                size_t stack_size[] = 0,
                ACE_hthread_t thread_handles[] = 0,
                ACE_Task_Base *task = 0,
-               const char* thr_name[] = 0);
+               const char* thr_name[] = 0,
+               const ACE_Thread_Placement *placement = 0);
 
   /**
    * Called to clean up when a thread exits.
@@ -1117,7 +1137,9 @@ protected:
                void *stack = 0,
                size_t stack_size = 0,
                ACE_Task_Base *task = 0,
-               const char** thr_name = 0);
+               const char** thr_name = 0,
+               const ACE_Thread_Placement *placement = 0,
+               size_t placement_index = 0);
 
   /// Run the registered hooks when the thread exits.
   void run_thread_exit_hooks (int i);
@@ -0,0 +1,279 @@
+#include "ace/Thread_Placement.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Thread_Placement.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Thread_Placement)
+
+ACE_Thread_Placement::ACE_Thread_Placement (Policy policy)
+  : count_ (0),
+    policy_ (policy)
+{
+  this->clear ();
+}
+
+void
+ACE_Thread_Placement::clear ()
+{
+  ACE_OS::memset (this->cpus_, 0, sizeof this->cpus_);
+  this->count_ = 0;
+}
+
+int
+ACE_Thread_Placement::add_cpu (size_t cpu)
+{
+  if (cpu >= ACE_THREAD_PLACEMENT_MAX_CPUS)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if (!this->is_set (cpu))
+    {
+      this->cpus_[cpu / 64] |= ACE_UINT64 (1) << (cpu % 64);
+      ++this->count_;
+    }
+  return 0;
+}
+
+int
+ACE_Thread_Placement::add_node (int node)
+{
+#if defined (ACE_LINUX)
+  ACE_TCHAR path[MAXPATHLEN];
+  ACE_OS::snprintf (path,
+                    MAXPATHLEN,
+                    ACE_TEXT ("/sys/devices/system/node/node%d/cpulist"),
+                    node);
+  FILE *fp = ACE_OS::fopen (path, ACE_TEXT ("r"));
+
+  // Kernels built without NUMA support have no node directory; all
+  // their CPUs are on node 0.
+  if (fp == 0 && node == 0)
+    fp = ACE_OS::fopen (ACE_TEXT ("/sys/devices/system/cpu/online"),
+                        ACE_TEXT ("r"));
+  if (fp == 0)
+    return -1;
+
+  char list[4096];
+  char *line = ACE_OS::fgets (list, sizeof list, fp);
+  ACE_OS::fclose (fp);
+  if (line == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+  return this->add_i (list);
+#else
+  ACE_UNUSED_ARG (node);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_LINUX */
+}
+
+int
+ACE_Thread_Placement::add (const ACE_TCHAR *cpus)
+{
+  if (cpus == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+  return this->add_i (ACE_TEXT_ALWAYS_CHAR (cpus));
+}
+
+int
+ACE_Thread_Placement::add_i (const char *cpus)
+{
+  const char *p = cpus;
+  for (;;)
+    {
+      while (*p == ' ' || *p == '\t' || *p == '\n')
+        ++p;
+      if (*p == '\0')
+        return 0;
+
+      bool const is_node = ACE_OS::strncmp (p, "node", 4) == 0;
+      if (is_node)
+        p += 4;
+
+      char *end = 0;
+      unsigned long const first = ACE_OS::strtoul (p, &end, 10);
+      if (end == p)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+      unsigned long last = first;
+      p = end;
+
+      if (is_node)
+        {
+          if (this->add_node (static_cast<int> (first)) == -1)
+            return -1;
+        }
+      else
+        {
+          if (*p == '-')
+            {
+              const char *start = ++p;
+              last = ACE_OS::strtoul (start, &end, 10);
+              if (end == start || last < first)
+                {
+                  errno = EINVAL;
+                  return -1;
+                }
+              p = end;
+            }
+          for (unsigned long cpu = first; cpu <= last; ++cpu)
+            if (this->add_cpu (cpu) == -1)
+              return -1;
+        }
+
+      while (*p == ' ' || *p == '\t' || *p == '\n')
+        ++p;
+      if (*p == ',')
+        ++p;
+      else if (*p != '\0')
+        {
+          errno = EINVAL;
+          return -1;
+        }
+    }
+}
+
+int
+ACE_Thread_Placement::cpu (size_t n) const
+{
+  if (this->count_ == 0)
+    return -1;
+
+  n %= this->count_;
+  for (size_t word = 0; word != ACE_THREAD_PLACEMENT_MAX_CPUS / 64; ++word)
+    {
+      ACE_UINT64 bits = this->cpus_[word];
+      for (int bit = 0; bits != 0; ++bit, bits >>= 1)
+        if ((bits & 1) != 0 && n-- == 0)
+          return static_cast<int> (word * 64 + bit);
+    }
+  return -1;
+}
+
+int
+ACE_Thread_Placement::cpu_set (size_t index, cpu_set_t &set) const
+{
+  if (this->count_ == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_OS::memset (&set, 0, sizeof set);
+
+  size_t first = 0;
+  size_t last = ACE_THREAD_PLACEMENT_MAX_CPUS - 1;
+  if (this->policy_ == ROUND_ROBIN)
+    first = last = static_cast<size_t> (this->cpu (index));
+
+  for (size_t cpu = first; cpu <= last; ++cpu)
+    if (this->is_set (cpu))
+      {
+#if defined (CPU_SET)
+        if (cpu < CPU_SETSIZE)
+          CPU_SET (cpu, &set);
+#elif defined (ACE_CPU_SETSIZE)
+        if (cpu < ACE_CPU_SETSIZE)
+          set.bit_array_[cpu / 32] |= ACE_UINT32 (1) << (cpu % 32);
+#else
+        ACE_NOTSUP_RETURN (-1);
+#endif /* CPU_SET */
+      }
+  return 0;
+}
+
+int
+ACE_Thread_Placement::apply (size_t index) const
+{
+  cpu_set_t set;
+  if (this->cpu_set (index, set) == -1)
+    return -1;
+
+#if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP) || defined (ACE_HAS_TASKCPUAFFINITYSET)
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+#else
+  // sched_setaffinity() takes the id of a kernel thread, 0 being the
+  // calling one.
+  ACE_hthread_t self = 0;
+#endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP || ACE_HAS_TASKCPUAFFINITYSET */
+
+  return ACE_OS::thr_set_affinity (self, sizeof set, &set);
+}
+
+void *
+ACE_Thread_Placement::allocate (size_t size)
+{
+#if !defined (ACE_LACKS_MMAP) && defined (MAP_ANONYMOUS)
+  // Anonymous pages are only given a frame when first written to, by
+  // the calling thread below.
+  void *p = ACE_OS::mmap (0,
+                          size,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS,
+                          ACE_INVALID_HANDLE);
+  if (p == MAP_FAILED)
+    return 0;
+#else
+  void *p = ACE_OS::malloc (size);
+  if (p == 0)
+    return 0;
+#endif /* !ACE_LACKS_MMAP && MAP_ANONYMOUS */
+
+  size_t const page = static_cast<size_t> (ACE_OS::getpagesize ());
+  char *bytes = static_cast<char *> (p);
+  for (size_t i = 0; i < size; i += page)
+    bytes[i] = 0;
+  return p;
+}
+
+void
+ACE_Thread_Placement::deallocate (void *p, size_t size)
+{
+  if (p == 0)
+    return;
+#if !defined (ACE_LACKS_MMAP) && defined (MAP_ANONYMOUS)
+  ACE_OS::munmap (p, size);
+#else
+  ACE_UNUSED_ARG (size);
+  ACE_OS::free (p);
+#endif /* !ACE_LACKS_MMAP && MAP_ANONYMOUS */
+}
+
+void
+ACE_Thread_Placement::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("policy_ = %s\ncpus_ ="),
+                 this->policy_ == ROUND_ROBIN ? ACE_TEXT ("ROUND_ROBIN")
+                                              : ACE_TEXT ("SHARED")));
+  for (size_t i = 0; i != this->count_; ++i)
+    ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT (" %d"), this->cpu (i)));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\n")));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,146 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Thread_Placement.h
+ *
+ *  Describes the CPUs the threads spawned by ACE_Thread_Manager and
+ *  ACE_Task_Base are allowed to run on.
+ */
+//=============================================================================
+
+#ifndef ACE_THREAD_PLACEMENT_H
+#define ACE_THREAD_PLACEMENT_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+#include "ace/os_include/os_sched.h"
+
+#if !defined (ACE_THREAD_PLACEMENT_MAX_CPUS)
+/// Number of CPUs an ACE_Thread_Placement can describe.
+# define ACE_THREAD_PLACEMENT_MAX_CPUS 1024
+#endif /* ACE_THREAD_PLACEMENT_MAX_CPUS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Thread_Placement
+ *
+ * @brief A set of CPUs, and how the threads of a group are spread
+ * over them.
+ *
+ * A placement is given to ACE_Thread_Manager::spawn_n() or
+ * ACE_Task_Base::thread_placement() before activate().  Each spawned
+ * thread moves itself to its CPUs before it calls its entry point,
+ * so the memory it touches first, its stack and the buffers it
+ * allocates with allocate(), comes from the NUMA node it runs on.
+ *
+ * The CPUs are given one by one, as a list such as "0-3,8,10-11",
+ * or as the CPUs of a NUMA node.  With the ROUND_ROBIN policy the
+ * n-th thread of a group is bound to the n-th CPU of the set,
+ * wrapping around, with SHARED every thread may run on all of them.
+ */
+class ACE_Export ACE_Thread_Placement
+{
+public:
+  enum Policy
+  {
+    /// Thread n of a group runs on CPU n modulo the number of CPUs.
+    ROUND_ROBIN,
+
+    /// All the threads may run on any of the CPUs.
+    SHARED
+  };
+
+  /// An empty placement, which leaves the threads where the operating
+  /// system puts them.
+  ACE_Thread_Placement (Policy policy = ROUND_ROBIN);
+
+  /// Add @a cpu to the set, returns -1 if it is out of range.
+  int add_cpu (size_t cpu);
+
+  /**
+   * Add the CPUs of NUMA node @a node, as listed by the operating
+   * system.  Returns -1 with errno ENOTSUP on platforms that do not
+   * tell which CPUs belong to a node.
+   */
+  int add_node (int node);
+
+  /**
+   * Add the CPUs of a comma separated list of CPU numbers, ranges such
+   * as "4-7" and NUMA nodes such as "node1".  Returns -1 with errno
+   * EINVAL when @a cpus cannot be parsed.
+   */
+  int add (const ACE_TCHAR *cpus);
+
+  /// Remove all the CPUs.
+  void clear ();
+
+  /// True if @a cpu is in the set.
+  bool is_set (size_t cpu) const;
+
+  /// True when the set has no CPU.
+  bool empty () const;
+
+  /// Number of CPUs in the set.
+  size_t cpu_count () const;
+
+  /// The @a n -th CPU of the set, wrapping around, or -1 when the set
+  /// is empty.
+  int cpu (size_t n) const;
+
+  Policy policy () const;
+  void policy (Policy policy);
+
+  /**
+   * Fill in @a set with the CPUs thread @a index of a group may run
+   * on.  Returns -1 with errno EINVAL when the set is empty.
+   */
+  int cpu_set (size_t index, cpu_set_t &set) const;
+
+  /// Bind the calling thread to the CPUs of thread @a index.
+  int apply (size_t index) const;
+
+  /**
+   * Allocate @a size bytes and write to every page from the calling
+   * thread, so that a thread bound to the CPUs of a NUMA node gets
+   * memory of that node.  Release with deallocate().
+   */
+  static void *allocate (size_t size);
+
+  /// Release memory returned by allocate().
+  static void deallocate (void *p, size_t size);
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Parse a list of narrow characters for add() and add_node().
+  int add_i (const char *cpus);
+
+  /// One bit per CPU.
+  ACE_UINT64 cpus_[ACE_THREAD_PLACEMENT_MAX_CPUS / 64];
+
+  /// Number of bits set in cpus_.
+  size_t count_;
+
+  Policy policy_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Thread_Placement.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_THREAD_PLACEMENT_H */
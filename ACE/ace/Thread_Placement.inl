@@ -0,0 +1,35 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE bool
+ACE_Thread_Placement::is_set (size_t cpu) const
+{
+  return cpu < ACE_THREAD_PLACEMENT_MAX_CPUS
+    && (this->cpus_[cpu / 64] & (ACE_UINT64 (1) << (cpu % 64))) != 0;
+}
+
+ACE_INLINE bool
+ACE_Thread_Placement::empty () const
+{
+  return this->count_ == 0;
+}
+
+ACE_INLINE size_t
+ACE_Thread_Placement::cpu_count () const
+{
+  return this->count_;
+}
+
+ACE_INLINE ACE_Thread_Placement::Policy
+ACE_Thread_Placement::policy () const
+{
+  return this->policy_;
+}
+
+ACE_INLINE void
+ACE_Thread_Placement::policy (Policy policy)
+{
+  this->policy_ = policy;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
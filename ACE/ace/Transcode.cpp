@@ -0,0 +1,296 @@
+#include "ace/Transcode.h"
+#include "ace/OS_NS_string.h"
+
+#if !defined (ACE_TRANSCODE_LACKS_SSE2) \
+    && (defined (__SSE2__) || defined (_M_X64) \
+        || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+# define ACE_TRANSCODE_HAS_SSE2
+# include <emmintrin.h>
+#endif /* !ACE_TRANSCODE_LACKS_SSE2 && __SSE2__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Bytes the ASCII fast paths check at a time.
+  size_t const block = 16;
+
+  /// Whether the @c block bytes at @a s are all ASCII.
+  inline bool
+  is_ascii_block (const char *s)
+  {
+#if defined (ACE_TRANSCODE_HAS_SSE2)
+    __m128i const v = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (s));
+    return _mm_movemask_epi8 (v) == 0;
+#else
+    ACE_UINT64 a;
+    ACE_UINT64 b;
+    ACE_OS::memcpy (&a, s, sizeof a);
+    ACE_OS::memcpy (&b, s + sizeof a, sizeof b);
+    return ((a | b) & ACE_UINT64_LITERAL (0x8080808080808080)) == 0;
+#endif /* ACE_TRANSCODE_HAS_SSE2 */
+  }
+
+  inline ACE_UINT16
+  swap_unit (ACE_UINT16 u)
+  {
+    return static_cast<ACE_UINT16> ((u << 8) | (u >> 8));
+  }
+}
+
+size_t
+ACE_Transcode::ascii_length (const char *s, size_t n)
+{
+  size_t i = 0;
+
+  while (i + block <= n && is_ascii_block (s + i))
+    {
+      i += block;
+    }
+
+  while (i < n && (s[i] & 0x80) == 0)
+    {
+      ++i;
+    }
+
+  return i;
+}
+
+size_t
+ACE_Transcode::latin1_utf8_length (const char *s, size_t n)
+{
+  // Each byte with its high bit set takes one more byte in UTF-8;
+  // count them a word at a time by summing the high bits.
+  ACE_UINT64 const high = ACE_UINT64_LITERAL (0x8080808080808080);
+  ACE_UINT64 const ones = ACE_UINT64_LITERAL (0x0101010101010101);
+
+  size_t length = n;
+  size_t i = 0;
+
+  for (; i + sizeof (ACE_UINT64) <= n; i += sizeof (ACE_UINT64))
+    {
+      ACE_UINT64 w;
+      ACE_OS::memcpy (&w, s + i, sizeof w);
+      length += static_cast<size_t> ((((w & high) >> 7) * ones) >> 56);
+    }
+
+  for (; i < n; ++i)
+    {
+      length += (s[i] & 0x80) != 0;
+    }
+
+  return length;
+}
+
+size_t
+ACE_Transcode::latin1_to_utf8 (const char *s, size_t n, char *dst)
+{
+  char *out = dst;
+  size_t i = 0;
+
+  while (i < n)
+    {
+      size_t end = n;
+
+      if (i + block <= n)
+        {
+          if (is_ascii_block (s + i))
+            {
+              ACE_OS::memcpy (out, s + i, block);
+              out += block;
+              i += block;
+              continue;
+            }
+
+          end = i + block;
+        }
+
+      for (; i < end; ++i)
+        {
+          unsigned char const c = static_cast<unsigned char> (s[i]);
+
+          if (c < 0x80)
+            {
+              *out++ = static_cast<char> (c);
+            }
+          else
+            {
+              *out++ = static_cast<char> (0xC0 | (c >> 6));
+              *out++ = static_cast<char> (0x80 | (c & 0x3F));
+            }
+        }
+    }
+
+  return static_cast<size_t> (out - dst);
+}
+
+size_t
+ACE_Transcode::utf8_to_latin1 (const char *s,
+                               size_t n,
+                               char *dst,
+                               size_t &written)
+{
+  char *out = dst;
+  size_t i = 0;
+
+  while (i < n)
+    {
+      size_t end = n;
+
+      if (i + block <= n)
+        {
+          if (is_ascii_block (s + i))
+            {
+              ACE_OS::memcpy (out, s + i, block);
+              out += block;
+              i += block;
+              continue;
+            }
+
+          end = i + block;
+        }
+
+      while (i < end)
+        {
+          unsigned char const c = static_cast<unsigned char> (s[i]);
+
+          if (c < 0x80)
+            {
+              *out++ = static_cast<char> (c);
+              ++i;
+              continue;
+            }
+
+          // Only the two byte sequences starting with 0xC2 and 0xC3
+          // encode Latin-1 characters; 0xC0 and 0xC1 start overlong
+          // ones.
+          if ((c != 0xC2 && c != 0xC3) || i + 1 >= n)
+            {
+              written = static_cast<size_t> (out - dst);
+              return i;
+            }
+
+          unsigned char const t = static_cast<unsigned char> (s[i + 1]);
+
+          if ((t & 0xC0) != 0x80)
+            {
+              written = static_cast<size_t> (out - dst);
+              return i;
+            }
+
+          *out++ = static_cast<char> (((c & 0x1F) << 6) | (t & 0x3F));
+          i += 2;
+        }
+    }
+
+  written = static_cast<size_t> (out - dst);
+  return n;
+}
+
+void
+ACE_Transcode::utf16_to_wchar (const char *s,
+                               size_t n,
+                               ACE_CDR::WChar *dst,
+                               bool swap)
+{
+  size_t i = 0;
+
+#if defined (ACE_TRANSCODE_HAS_SSE2)
+  if (sizeof (ACE_CDR::WChar) == 4)
+    {
+      __m128i const zero = _mm_setzero_si128 ();
+
+      for (; i + 8 <= n; i += 8)
+        {
+          __m128i v =
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *> (s + 2 * i));
+
+          if (swap)
+            {
+              v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+            }
+
+          _mm_storeu_si128 (reinterpret_cast<__m128i *> (dst + i),
+                            _mm_unpacklo_epi16 (v, zero));
+          _mm_storeu_si128 (reinterpret_cast<__m128i *> (dst + i + 4),
+                            _mm_unpackhi_epi16 (v, zero));
+        }
+    }
+#endif /* ACE_TRANSCODE_HAS_SSE2 */
+
+  // Separate loops keep the test out of them, so that compilers can
+  // vectorize each.
+  if (swap)
+    {
+      for (; i < n; ++i)
+        {
+          ACE_UINT16 u;
+          ACE_OS::memcpy (&u, s + 2 * i, sizeof u);
+          dst[i] = static_cast<ACE_CDR::WChar> (swap_unit (u));
+        }
+    }
+  else
+    {
+      for (; i < n; ++i)
+        {
+          ACE_UINT16 u;
+          ACE_OS::memcpy (&u, s + 2 * i, sizeof u);
+          dst[i] = static_cast<ACE_CDR::WChar> (u);
+        }
+    }
+}
+
+void
+ACE_Transcode::wchar_to_utf16 (const ACE_CDR::WChar *s,
+                               size_t n,
+                               char *dst,
+                               bool swap)
+{
+  size_t i = 0;
+
+#if defined (ACE_TRANSCODE_HAS_SSE2)
+  if (sizeof (ACE_CDR::WChar) == 4)
+    {
+      for (; i + 8 <= n; i += 8)
+        {
+          __m128i a =
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *> (s + i));
+          __m128i b =
+            _mm_loadu_si128 (reinterpret_cast<const __m128i *> (s + i + 4));
+
+          // Sign extend the low 16 bits of each character so that the
+          // saturating pack truncates them instead.
+          a = _mm_srai_epi32 (_mm_slli_epi32 (a, 16), 16);
+          b = _mm_srai_epi32 (_mm_slli_epi32 (b, 16), 16);
+
+          __m128i v = _mm_packs_epi32 (a, b);
+
+          if (swap)
+            {
+              v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+            }
+
+          _mm_storeu_si128 (reinterpret_cast<__m128i *> (dst + 2 * i), v);
+        }
+    }
+#endif /* ACE_TRANSCODE_HAS_SSE2 */
+
+  if (swap)
+    {
+      for (; i < n; ++i)
+        {
+          ACE_UINT16 const u = swap_unit (static_cast<ACE_UINT16> (s[i]));
+          ACE_OS::memcpy (dst + 2 * i, &u, sizeof u);
+        }
+    }
+  else
+    {
+      for (; i < n; ++i)
+        {
+          ACE_UINT16 const u = static_cast<ACE_UINT16> (s[i]);
+          ACE_OS::memcpy (dst + 2 * i, &u, sizeof u);
+        }
+    }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
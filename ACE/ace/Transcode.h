@@ -0,0 +1,90 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Transcode.h
+ *
+ *  Bulk conversions between the character encodings CDR streams and
+ *  codeset translators deal with, for whole strings and arrays at a
+ *  time instead of one character per call.
+ *
+ *  Where the compiler targets SSE2 the conversions work on 16 bytes
+ *  at a time; elsewhere on machine words. Define
+ *  ACE_TRANSCODE_LACKS_SSE2 to use the latter everywhere.
+ */
+//=============================================================================
+
+#ifndef ACE_TRANSCODE_H
+#define ACE_TRANSCODE_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/CDR_Base.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @namespace ACE_Transcode
+ *
+ * @brief Bulk character encoding conversions.
+ *
+ * UTF-16 code units are read and written in native byte order, or
+ * swapped when asked to, at any alignment.
+ */
+namespace ACE_Transcode
+{
+  /// Number of bytes at the start of @a s, of @a n, that are ASCII.
+  extern ACE_Export size_t ascii_length (const char *s, size_t n);
+
+  /// Number of bytes the @a n Latin-1 characters at @a s take in UTF-8.
+  extern ACE_Export size_t latin1_utf8_length (const char *s, size_t n);
+
+  /**
+   * Encode the @a n Latin-1 characters at @a s in UTF-8 into @a dst,
+   * which has room for latin1_utf8_length (@a s, @a n) bytes.
+   *
+   * @return The number of bytes written.
+   */
+  extern ACE_Export size_t latin1_to_utf8 (const char *s,
+                                           size_t n,
+                                           char *dst);
+
+  /**
+   * Decode the @a n bytes of UTF-8 at @a s into Latin-1 at @a dst,
+   * which has room for @a n characters, stopping before the first
+   * byte that does not start a well formed sequence for a Latin-1
+   * character.
+   *
+   * @return The number of bytes decoded, @a n if all of them were;
+   *         @a written is set to the number of characters written.
+   */
+  extern ACE_Export size_t utf8_to_latin1 (const char *s,
+                                           size_t n,
+                                           char *dst,
+                                           size_t &written);
+
+  /// Widen the @a n UTF-16 code units at @a s into @a dst, swapping
+  /// the bytes of each if @a swap.
+  extern ACE_Export void utf16_to_wchar (const char *s,
+                                         size_t n,
+                                         ACE_CDR::WChar *dst,
+                                         bool swap);
+
+  /// Narrow the @a n wide characters at @a s to UTF-16 code units at
+  /// @a dst, swapping the bytes of each if @a swap. Characters are
+  /// truncated to 16 bits.
+  extern ACE_Export void wchar_to_utf16 (const ACE_CDR::WChar *s,
+                                         size_t n,
+                                         char *dst,
+                                         bool swap);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_TRANSCODE_H */
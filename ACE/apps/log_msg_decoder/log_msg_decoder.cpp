@@ -0,0 +1,95 @@
+/**
+ * @file log_msg_decoder.cpp
+ *
+ * Print the messages of a binary file written by ACE_Log_Msg_Async.
+ *
+ * Usage: log_msg_decoder [-l] [-i] file...
+ *
+ *   -l  prefix every message with its time and priority
+ *       (ACE_Log_Msg::VERBOSE_LITE)
+ *   -i  print the program and host that wrote each file first
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Record.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+
+static int
+decode (const ACE_TCHAR *filename, u_long verbose_flag, bool info)
+{
+  ACE_Log_Msg_Async_Reader reader;
+  if (reader.open (filename) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), filename), 1);
+
+  if (info)
+    ACE_OS::fprintf (stdout,
+                     ACE_TEXT ("# %s: written by %s on %s\n"),
+                     filename,
+                     reader.program_name (),
+                     reader.host_name ());
+
+  ACE_Log_Record record;
+  int result = 0;
+  while ((result = reader.next (record)) == 1)
+    record.print (reader.host_name (), verbose_flag, stdout);
+
+  if (result != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%s: damaged record\n"), filename),
+                      1);
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  u_long verbose_flag = 0;
+  bool info = false;
+
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("li"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'l':
+        verbose_flag = ACE_Log_Msg::VERBOSE_LITE;
+        break;
+      case 'i':
+        info = true;
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Usage: %s [-l] [-i] file...\n"),
+                           argv[0]),
+                          1);
+      }
+
+  if (get_opts.opt_ind () == argc)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Usage: %s [-l] [-i] file...\n"),
+                       argv[0]),
+                      1);
+
+  int status = 0;
+  for (int i = get_opts.opt_ind (); i != argc; ++i)
+    status |= decode (argv[i], verbose_flag, info);
+  return status;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *argv[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("%s: asynchronous logging is not available ")
+                     ACE_TEXT ("on this platform\n"),
+                     argv[0]),
+                    1);
+}
+
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
@@ -0,0 +1,183 @@
+/**
+ * @file log_msg_async.cpp
+ *
+ * Measure how long ACE_DEBUG takes for the logging thread when the
+ * message is formatted and written synchronously, when it is handed
+ * to ACE_Log_Msg_Async and when ACE_Log_Msg_Async writes it to a
+ * binary file.
+ *
+ * Usage: log_msg_async [-t threads] [-n messages] [-f file]
+ *
+ * The text output goes to @a file, the binary output to @a file.bin.
+ * For each mode the log calls per second of each thread and the
+ * percentiles of the time spent in a single call are printed.
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/SString.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/streams.h"
+
+#include <algorithm>
+
+#if defined (ACE_HAS_LOG_MSG_ASYNC) && !defined (ACE_LACKS_IOSTREAM_TOTALLY)
+
+static int n_threads = 4;
+static int n_messages = 100000;
+static const ACE_TCHAR *file = ACE_TEXT ("log_msg_async.log");
+
+static ofstream *output = 0;
+static ACE_High_Res_Timer::global_scale_factor_type gsf = 1;
+
+struct Worker_Result
+{
+  /// Time spent in every call, in ACE_OS::gethrtime() ticks.
+  ACE_hrtime_t *samples;
+  ACE_hrtime_t total;
+};
+
+static Worker_Result *results = 0;
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  Worker_Result &result = *static_cast<Worker_Result *> (arg);
+  ACE_LOG_MSG->msg_ostream (output, false);
+
+  ACE_hrtime_t const begin = ACE_OS::gethrtime ();
+  for (int i = 0; i != n_messages; ++i)
+    {
+      ACE_hrtime_t const start = ACE_OS::gethrtime ();
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%D (%t) request %d of %s took %f ms\n"),
+                  i, ACE_TEXT ("benchmark"), i * 0.001));
+      result.samples[i] = ACE_OS::gethrtime () - start;
+    }
+  result.total = ACE_OS::gethrtime () - begin;
+  return 0;
+}
+
+static double
+usecs (ACE_hrtime_t ticks)
+{
+  return double (ticks) / gsf;
+}
+
+/// Log from all threads, with asynchronous logging open when
+/// @a async, writing the binary file @a binary_file when given.
+static void
+run (const ACE_TCHAR *mode, bool async, const ACE_TCHAR *binary_file = 0)
+{
+  // The messages go to the ostream of the workers, the results to
+  // stderr.
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::OSTREAM);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::STDERR);
+  if (async)
+    ACE_Log_Msg_Async::instance ()->open (ACE_LOG_MSG_ASYNC_RING_SIZE,
+                                          binary_file);
+  for (int t = 0; t != n_threads; ++t)
+    ACE_Thread_Manager::instance ()->spawn (worker, &results[t]);
+  ACE_Thread_Manager::instance ()->wait ();
+  if (async)
+    ACE_Log_Msg_Async::instance ()->close ();
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::STDERR);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::OSTREAM);
+
+  // Calls per second of every thread, and the percentiles over all
+  // calls.
+  size_t const count = size_t (n_threads) * n_messages;
+  ACE_hrtime_t *all = new ACE_hrtime_t[count];
+  double rate = 0;
+  for (int t = 0; t != n_threads; ++t)
+    {
+      std::copy (results[t].samples, results[t].samples + n_messages,
+                 all + size_t (t) * n_messages);
+      rate += n_messages / (usecs (results[t].total) / 1.0e6);
+    }
+  std::sort (all, all + count);
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%-8s %12.0f calls/s/thread  p50 %8.3f  p99 %8.3f  ")
+              ACE_TEXT ("p99.9 %8.3f  max %10.3f usecs\n"),
+              mode,
+              rate / n_threads,
+              usecs (all[count / 2]),
+              usecs (all[count * 99 / 100]),
+              usecs (all[count * 999 / 1000]),
+              usecs (all[count - 1])));
+  delete [] all;
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("t:n:f:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 't':
+        n_threads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'n':
+        n_messages = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'f':
+        file = get_opts.opt_arg ();
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Usage: %s [-t threads] [-n messages] ")
+                           ACE_TEXT ("[-f file]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return n_threads > 0 && n_messages > 0 ? 0 : -1;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  gsf = ACE_High_Res_Timer::global_scale_factor ();
+
+  output = new ofstream (ACE_TEXT_ALWAYS_CHAR (file));
+  results = new Worker_Result[n_threads];
+  for (int t = 0; t != n_threads; ++t)
+    results[t].samples = new ACE_hrtime_t[n_messages];
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%d threads, %d messages each\n"),
+              n_threads, n_messages));
+
+  run (ACE_TEXT ("sync"), false);
+  run (ACE_TEXT ("async"), true);
+  ACE_TString const binary = ACE_TString (file) + ACE_TEXT (".bin");
+  run (ACE_TEXT ("binary"), true, binary.c_str ());
+
+  for (int t = 0; t != n_threads; ++t)
+    delete [] results[t].samples;
+  delete [] results;
+  delete output;
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("Asynchronous logging is not available ")
+              ACE_TEXT ("on this platform\n")));
+  return 0;
+}
+
+#endif /* ACE_HAS_LOG_MSG_ASYNC && !ACE_LACKS_IOSTREAM_TOTALLY */
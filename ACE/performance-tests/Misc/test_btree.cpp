@@ -0,0 +1,175 @@
+/**
+ * @file test_btree.cpp
+ *
+ * Compare ACE_BTree with ACE_RB_Tree, from 10^3 entries up to 10^7.
+ *
+ * For each size the trees are filled with random keys, then every
+ * key is looked up, all the entries are walked in order, and every
+ * key is unbound.  The time per entry is printed in nanoseconds.
+ *
+ * Usage: test_btree [-m largest power of ten] [-r runs]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/BTree_T.h"
+#include "ace/RB_Tree.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_stdlib.h"
+
+typedef ACE_BTree<ACE_UINT64,
+                  ACE_UINT64,
+                  ACE_Less_Than<ACE_UINT64>,
+                  ACE_Null_Mutex> BTREE;
+
+typedef ACE_RB_Tree<ACE_UINT64,
+                    ACE_UINT64,
+                    ACE_Less_Than<ACE_UINT64>,
+                    ACE_Null_Mutex> RB_TREE;
+
+static int largest = 6;
+static int runs = 3;
+
+/// Timings of one tree, in nanoseconds per entry.
+struct Result
+{
+  double bind_;
+  double find_;
+  double walk_;
+  double unbind_;
+};
+
+static double
+per_op (ACE_High_Res_Timer &timer, size_t n)
+{
+  ACE_hrtime_t nsecs = 0;
+  timer.elapsed_time (nsecs);
+  return double (nsecs) / double (n);
+}
+
+static void
+keep_best (double value, double &best)
+{
+  if (best == 0 || value < best)
+    best = value;
+}
+
+/// Time the four phases on @a tree, keeping the best of the runs in
+/// @a best.  The sum of the values found is returned so that the
+/// lookups are not optimized away.
+template <class TREE>
+static ACE_UINT64
+run (TREE &tree, const ACE_UINT64 keys[], size_t n, Result &best)
+{
+  ACE_UINT64 sum = 0;
+  ACE_UINT64 value = 0;
+  ACE_High_Res_Timer timer;
+
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    tree.bind (keys[i], keys[i]);
+  timer.stop ();
+  keep_best (per_op (timer, n), best.bind_);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    if (tree.find (keys[i], value) == 0)
+      sum += value;
+  timer.stop ();
+  keep_best (per_op (timer, n), best.find_);
+
+  timer.reset ();
+  timer.start ();
+  for (typename TREE::iterator i = tree.begin (); i != tree.end (); ++i)
+    sum += (*i).item ();
+  timer.stop ();
+  keep_best (per_op (timer, n), best.walk_);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    tree.unbind (keys[i]);
+  timer.stop ();
+  keep_best (per_op (timer, n), best.unbind_);
+
+  return sum;
+}
+
+static void
+print (const ACE_TCHAR *name, const Result &r)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  %-8s %10.1f %10.1f %10.1f %10.1f\n"),
+              name, r.bind_, r.find_, r.walk_, r.unbind_));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("m:r:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'm':
+        largest = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'r':
+        runs = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-m largest power of ten] ")
+                           ACE_TEXT ("[-r runs]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  size_t n = 100;
+  for (int power = 3; power <= largest; ++power)
+    {
+      n *= 10;
+      ACE_UINT64 *keys = new ACE_UINT64[n];
+      ACE_OS::srand (static_cast<u_int> (power));
+      for (size_t i = 0; i != n; ++i)
+        keys[i] = (ACE_UINT64 (ACE_OS::rand ()) << 32)
+                  ^ (ACE_UINT64 (ACE_OS::rand ()) << 8)
+                  ^ i;
+
+      Result btree = { 0, 0, 0, 0 };
+      Result rb_tree = { 0, 0, 0, 0 };
+      ACE_UINT64 sum = 0;
+      for (int r = 0; r != runs; ++r)
+        {
+          {
+            BTREE tree;
+            sum += run (tree, keys, n, btree);
+          }
+          {
+            RB_TREE tree;
+            sum += run (tree, keys, n, rb_tree);
+          }
+        }
+      delete [] keys;
+
+      ACE_DEBUG ((LM_INFO,
+                  ACE_TEXT ("%B entries, ns per entry (checksum %Q)\n")
+                  ACE_TEXT ("  %-8s %10s %10s %10s %10s\n"),
+                  n, sum,
+                  ACE_TEXT ("tree"), ACE_TEXT ("bind"), ACE_TEXT ("find"),
+                  ACE_TEXT ("walk"), ACE_TEXT ("unbind")));
+      print (ACE_TEXT ("btree"), btree);
+      print (ACE_TEXT ("rb_tree"), rb_tree);
+    }
+  return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_hash_map.cpp
+ *
+ * Compare ACE_Flat_Hash_Map_Manager_Ex with ACE_Hash_Map_Manager_Ex
+ * and ACE_RB_Tree, from 10^3 entries up to 10^7.
+ *
+ * For each size the maps are filled with random keys, then every key
+ * is looked up, as many absent keys are looked up, and every key is
+ * unbound.  The time per operation is printed in nanoseconds.  The
+ * chained map is opened with as many buckets as entries, which is its
+ * best case.
+ *
+ * Usage: test_hash_map [-m largest power of ten] [-r runs]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Flat_Hash_Map_Manager_T.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/RB_Tree.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_stdlib.h"
+
+typedef ACE_Flat_Hash_Map_Manager_Ex<ACE_UINT64,
+                                     ACE_UINT64,
+                                     ACE_Hash<ACE_UINT64>,
+                                     ACE_Equal_To<ACE_UINT64>,
+                                     ACE_Null_Mutex> FLAT_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT64,
+                                ACE_UINT64,
+                                ACE_Hash<ACE_UINT64>,
+                                ACE_Equal_To<ACE_UINT64>,
+                                ACE_Null_Mutex> CHAINED_MAP;
+
+typedef ACE_RB_Tree<ACE_UINT64,
+                    ACE_UINT64,
+                    ACE_Less_Than<ACE_UINT64>,
+                    ACE_Null_Mutex> TREE_MAP;
+
+static int largest = 6;
+static int runs = 3;
+
+/// Timings of one map, in nanoseconds per operation.
+struct Result
+{
+  double bind_;
+  double hit_;
+  double miss_;
+  double unbind_;
+};
+
+/// A key that is absent from the maps: the keys of the maps are even.
+static ACE_UINT64
+missing (ACE_UINT64 key)
+{
+  return key | 1;
+}
+
+static double
+per_op (ACE_High_Res_Timer &timer, size_t n)
+{
+  ACE_hrtime_t nsecs = 0;
+  timer.elapsed_time (nsecs);
+  return double (nsecs) / double (n);
+}
+
+/// Time the four phases on @a map, keeping the best of the runs in
+/// @a best.  The sum of the values found is returned so that the
+/// lookups are not optimized away.
+template <class MAP>
+static ACE_UINT64
+run (MAP &map, const ACE_UINT64 keys[], size_t n, Result &best)
+{
+  ACE_UINT64 sum = 0;
+  ACE_UINT64 value = 0;
+  ACE_High_Res_Timer timer;
+
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    map.bind (keys[i], keys[i]);
+  timer.stop ();
+  double const bind = per_op (timer, n);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    if (map.find (keys[i], value) == 0)
+      sum += value;
+  timer.stop ();
+  double const hit = per_op (timer, n);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    if (map.find (missing (keys[i]), value) == 0)
+      sum += value;
+  timer.stop ();
+  double const miss = per_op (timer, n);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i != n; ++i)
+    map.unbind (keys[i]);
+  timer.stop ();
+  double const unbind = per_op (timer, n);
+
+  if (best.bind_ == 0 || bind < best.bind_)
+    best.bind_ = bind;
+  if (best.hit_ == 0 || hit < best.hit_)
+    best.hit_ = hit;
+  if (best.miss_ == 0 || miss < best.miss_)
+    best.miss_ = miss;
+  if (best.unbind_ == 0 || unbind < best.unbind_)
+    best.unbind_ = unbind;
+  return sum;
+}
+
+static void
+print (const ACE_TCHAR *name, const Result &r)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  %-8s %10.1f %10.1f %10.1f %10.1f\n"),
+              name, r.bind_, r.hit_, r.miss_, r.unbind_));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("m:r:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'm':
+        largest = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'r':
+        runs = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-m largest power of ten] ")
+                           ACE_TEXT ("[-r runs]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  size_t n = 100;
+  for (int power = 3; power <= largest; ++power)
+    {
+      n *= 10;
+      ACE_UINT64 *keys = new ACE_UINT64[n];
+      ACE_OS::srand (static_cast<u_int> (power));
+      for (size_t i = 0; i != n; ++i)
+        keys[i] = ((ACE_UINT64 (ACE_OS::rand ()) << 32)
+                   ^ (ACE_UINT64 (ACE_OS::rand ()) << 8)
+                   ^ i) << 1;
+
+      Result flat = { 0, 0, 0, 0 };
+      Result chained = { 0, 0, 0, 0 };
+      Result tree = { 0, 0, 0, 0 };
+      ACE_UINT64 sum = 0;
+      for (int r = 0; r != runs; ++r)
+        {
+          {
+            FLAT_MAP map;
+            sum += run (map, keys, n, flat);
+          }
+          {
+            CHAINED_MAP map (n);
+            sum += run (map, keys, n, chained);
+          }
+          {
+            TREE_MAP map;
+            sum += run (map, keys, n, tree);
+          }
+        }
+      delete [] keys;
+
+      ACE_DEBUG ((LM_INFO,
+                  ACE_TEXT ("%B entries, ns per operation (checksum %Q)\n")
+                  ACE_TEXT ("  %-8s %10s %10s %10s %10s\n"),
+                  n, sum,
+                  ACE_TEXT ("map"), ACE_TEXT ("bind"), ACE_TEXT ("find"),
+                  ACE_TEXT ("miss"), ACE_TEXT ("unbind")));
+      print (ACE_TEXT ("flat"), flat);
+      print (ACE_TEXT ("chained"), chained);
+      print (ACE_TEXT ("rb_tree"), tree);
+    }
+  return 0;
+}
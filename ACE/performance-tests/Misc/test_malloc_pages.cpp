@@ -0,0 +1,175 @@
+/**
+ * @file test_malloc_pages.cpp
+ *
+ * Time random access over a large ACE_Malloc heap in an
+ * ACE_MMAP_Memory_Pool, with default pages, transparent huge pages
+ * and hugetlbfs pages.
+ *
+ * One block filling most of the heap holds a random cycle of
+ * indexes, which is followed for a number of steps: every step is a
+ * dependent load from a random place, so the time per step is the
+ * latency of a TLB and cache miss.  The pool is prefaulted, so page
+ * faults are not timed.
+ *
+ * Transparent huge pages only back the pool when the backing store
+ * directory (-d, /dev/shm by default) is a tmpfs mounted with
+ * huge=advise.  The hugetlbfs run needs a hugetlbfs mount (-H) with
+ * enough huge pages reserved in /proc/sys/vm/nr_hugepages; it is
+ * skipped otherwise.
+ *
+ * Usage: test_malloc_pages [-s heap size in MB] [-n steps]
+ *                          [-d directory] [-H hugetlbfs directory]
+ *                          [-N NUMA node]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Malloc_T.h"
+#include "ace/MMAP_Memory_Pool.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+
+typedef ACE_Malloc<ACE_MMAP_MEMORY_POOL, ACE_Null_Mutex> MALLOC;
+
+static size_t heap_mb = 2048;
+static size_t steps = 20000000;
+static const ACE_TCHAR *directory = ACE_TEXT ("/dev/shm");
+static const ACE_TCHAR *hugetlb_directory = ACE_TEXT ("/dev/hugepages");
+static int numa_node = -1;
+
+/// Follow a random cycle through a heap made with @a huge_pages, and
+/// print the time per step.  Returns -1 if the heap cannot be made.
+static int
+run (const ACE_TCHAR *dir, int huge_pages, const ACE_TCHAR *what)
+{
+  ACE_TCHAR name[MAXPATHLEN];
+  ACE_OS::snprintf (name, MAXPATHLEN, ACE_TEXT ("%s/test_malloc_pages"), dir);
+  ACE_OS::unlink (name);
+
+  size_t const bytes = heap_mb * 1024 * 1024;
+  size_t const count = bytes / sizeof (ACE_UINT64) - 1024;
+
+  // Room for the whole block and the control block, so that the pool
+  // never grows.
+  ACE_MMAP_Memory_Pool_Options options
+    (0,
+     ACE_MMAP_Memory_Pool_Options::FIRSTCALL_FIXED,
+     false,
+     bytes,
+     0,
+     true,
+     0,
+     ACE_DEFAULT_FILE_PERMS,
+     false,
+     true,
+     huge_pages,
+     true,
+     numa_node);
+
+  MALLOC heap (name, 0, &options);
+  if (heap.bad ())
+    {
+      ACE_DEBUG ((LM_INFO, ACE_TEXT ("  %-24s %p, skipped\n"),
+                  what, name));
+      heap.remove ();
+      return -1;
+    }
+
+  ACE_UINT64 *next =
+    static_cast<ACE_UINT64 *> (heap.malloc (count * sizeof (ACE_UINT64)));
+  if (next == 0)
+    {
+      ACE_DEBUG ((LM_INFO, ACE_TEXT ("  %-24s heap too small, skipped\n"),
+                  what));
+      heap.remove ();
+      return -1;
+    }
+
+  // Sattolo's shuffle gives a single cycle through every slot.
+  for (size_t i = 0; i != count; ++i)
+    next[i] = i;
+  ACE_OS::srand (1);
+  for (size_t i = count - 1; i > 0; --i)
+    {
+      size_t const j =
+        ((size_t (ACE_OS::rand ()) << 31) ^ size_t (ACE_OS::rand ())) % i;
+      ACE_UINT64 const t = next[i];
+      next[i] = next[j];
+      next[j] = t;
+    }
+
+  ACE_High_Res_Timer timer;
+  ACE_UINT64 slot = 0;
+  timer.start ();
+  for (size_t i = 0; i != steps; ++i)
+    slot = next[slot];
+  timer.stop ();
+
+  ACE_hrtime_t nsecs = 0;
+  timer.elapsed_time (nsecs);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  %-24s %8.1f ns per access (end %Q)\n"),
+              what, double (nsecs) / double (steps), slot));
+
+  heap.remove ();
+  return 0;
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("s:n:d:H:N:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 's':
+        heap_mb = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+      case 'n':
+        steps = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+      case 'H':
+        hugetlb_directory = get_opts.opt_arg ();
+        break;
+      case 'N':
+        numa_node = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-s heap size in MB] ")
+                           ACE_TEXT ("[-n steps] [-d directory] ")
+                           ACE_TEXT ("[-H hugetlbfs directory] ")
+                           ACE_TEXT ("[-N NUMA node]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%B MB heap, %B random accesses\n"),
+              heap_mb, steps));
+  run (directory,
+       ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES,
+       ACE_TEXT ("default pages"));
+  run (directory,
+       ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES,
+       ACE_TEXT ("transparent huge pages"));
+  run (hugetlb_directory,
+       ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES,
+       ACE_TEXT ("hugetlbfs pages"));
+  return 0;
+}
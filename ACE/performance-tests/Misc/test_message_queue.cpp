@@ -0,0 +1,142 @@
+/**
+ * @file test_message_queue.cpp
+ *
+ * Measure the throughput of ACE_Message_Queue<ACE_MT_SYNCH> and of
+ * ACE_Lock_Free_Message_Queue<ACE_MT_SYNCH> with 1 to 32 producer
+ * and as many consumer threads.
+ *
+ * Usage: test_message_queue [-n messages per producer] [-t max threads]
+ *                           [-s slots]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Lock_Free_Message_Queue_T.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdlib.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static int n_messages = 100000;
+static int max_threads = 32;
+static size_t slots = ACE_LOCK_FREE_MESSAGE_QUEUE_SIZE;
+
+using MT_QUEUE = ACE_Message_Queue<ACE_MT_SYNCH>;
+using LF_QUEUE = ACE_Lock_Free_Message_Queue<ACE_MT_SYNCH>;
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  MT_QUEUE *queue = static_cast<MT_QUEUE *> (arg);
+  for (int i = 0; i != n_messages; ++i)
+    queue->enqueue_tail (new ACE_Message_Block (64));
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  MT_QUEUE *queue = static_cast<MT_QUEUE *> (arg);
+  for (;;)
+    {
+      ACE_Message_Block *mb = 0;
+      if (queue->dequeue_head (mb) == -1)
+        break;
+      bool const hangup = mb->msg_type () == ACE_Message_Block::MB_HANGUP;
+      mb->release ();
+      if (hangup)
+        break;
+    }
+  return 0;
+}
+
+/// Pass n_messages from each of @a threads producers to @a threads
+/// consumers, returns the messages per second.
+static double
+run (MT_QUEUE &queue, int threads)
+{
+  ACE_Thread_Manager producers;
+  ACE_Thread_Manager consumers;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  consumers.spawn_n (threads, consumer, &queue);
+  producers.spawn_n (threads, producer, &queue);
+  producers.wait ();
+  for (int i = 0; i != threads; ++i)
+    queue.enqueue_tail (new ACE_Message_Block (0, ACE_Message_Block::MB_HANGUP));
+  consumers.wait ();
+  timer.stop ();
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+  return double (threads) * n_messages / (double (usecs) / 1.0e6);
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:t:s:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        n_messages = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 't':
+        max_threads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 's':
+        slots = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Usage: %s [-n messages] ")
+                           ACE_TEXT ("[-t max threads] [-s slots]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  // Both queues hold the same number of messages.
+  size_t const hwm = slots * 64;
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%d messages per producer, high water mark %B\n")
+              ACE_TEXT ("threads    ACE_Message_Queue   ")
+              ACE_TEXT ("ACE_Lock_Free_Message_Queue (msgs/s)\n"),
+              n_messages, hwm));
+
+  for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+      MT_QUEUE mt_queue (hwm, hwm);
+      LF_QUEUE lf_queue (hwm, hwm, 0, slots);
+      double const mt_rate = run (mt_queue, threads);
+      double const lf_rate = run (lf_queue, threads);
+      ACE_DEBUG ((LM_INFO,
+                  ACE_TEXT ("%2d+%-2d %20.0f %20.0f\n"),
+                  threads, threads, mt_rate, lf_rate));
+    }
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,228 @@
+/**
+ * @file test_reactor_clock.cpp
+ *
+ * Count the clock reads and the CPU time per event of a reactor
+ * dispatch loop, with timer queues using the gettimeofday(), the
+ * monotonic, the TSC and the cached time policies.
+ *
+ * A handler reads a byte from a pipe, moves its idle timer forward,
+ * as a connection with a timeout would, and writes the byte back, so
+ * that every call to handle_events() dispatches one event.  On Linux
+ * with glibc, clock_gettime() and gettimeofday() are interposed to
+ * count the calls the loop makes to the system clock.
+ *
+ * Usage: test_reactor_clock [-n events] [-r runs]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/Profile_Timer.h"
+#include "ace/Pipe.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Timer_Heap_T.h"
+#include "ace/Event_Handler_Handle_Timeout_Upcall.h"
+#include "ace/Monotonic_Time_Policy.h"
+#include "ace/TSC_Time_Policy.h"
+#include "ace/Cached_Time_Policy.h"
+#include "ace/Synch_Traits.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_stdlib.h"
+
+static size_t events = 1000000;
+static int runs = 3;
+
+static unsigned long clock_calls = 0;
+
+#if defined (__linux__) && defined (__GLIBC__)
+# define COUNT_CLOCK_CALLS
+# include <dlfcn.h>
+
+extern "C" int
+clock_gettime (clockid_t id, struct timespec *ts) throw ()
+{
+  typedef int (*clock_gettime_fn) (clockid_t, struct timespec *);
+  static clock_gettime_fn const real =
+    reinterpret_cast<clock_gettime_fn> (::dlsym (RTLD_NEXT, "clock_gettime"));
+  ++clock_calls;
+  return real (id, ts);
+}
+
+extern "C" int
+gettimeofday (struct timeval *tv, void *tz) throw ()
+{
+  typedef int (*gettimeofday_fn) (struct timeval *, void *);
+  static gettimeofday_fn const real =
+    reinterpret_cast<gettimeofday_fn> (::dlsym (RTLD_NEXT, "gettimeofday"));
+  ++clock_calls;
+  return real (tv, tz);
+}
+#endif /* __linux__ && __GLIBC__ */
+
+/// Passes a byte through a pipe, and keeps an idle timer that never
+/// fires.
+class Ping_Handler : public ACE_Event_Handler
+{
+public:
+  Ping_Handler (ACE_Reactor *reactor, ACE_Pipe &pipe)
+    : ACE_Event_Handler (reactor),
+      pipe_ (pipe),
+      timer_id_ (-1),
+      count_ (0)
+  {
+  }
+
+  int start ()
+  {
+    this->timer_id_ = this->reactor ()->schedule_timer (this, 0, idle_);
+    char const c = 'x';
+    return this->timer_id_ == -1
+      || ACE_OS::write (this->pipe_.write_handle (), &c, 1) != 1 ? -1 : 0;
+  }
+
+  int handle_input (ACE_HANDLE handle) override
+  {
+    char c;
+    if (ACE_OS::read (handle, &c, 1) != 1)
+      return -1;
+    ++this->count_;
+
+    // Restart the idle timer.
+    this->reactor ()->cancel_timer (this->timer_id_);
+    this->timer_id_ = this->reactor ()->schedule_timer (this, 0, idle_);
+    return ACE_OS::write (this->pipe_.write_handle (), &c, 1) == 1 ? 0 : -1;
+  }
+
+  int handle_timeout (const ACE_Time_Value &, const void *) override
+  {
+    return 0;
+  }
+
+  size_t count () const { return this->count_; }
+
+private:
+  static const ACE_Time_Value idle_;
+
+  ACE_Pipe &pipe_;
+  long timer_id_;
+  size_t count_;
+};
+
+const ACE_Time_Value Ping_Handler::idle_ (60);
+
+/// Dispatch the events with a timer queue of @a TIME_POLICY, keeping
+/// the best of the runs.
+template <typename TIME_POLICY>
+static void
+run (const ACE_TCHAR *what)
+{
+  double best_elapsed = 0;
+  double best_cpu = 0;
+  unsigned long calls = 0;
+
+  for (int r = 0; r != runs; ++r)
+    {
+      ACE_Timer_Heap_T<ACE_Event_Handler *,
+                       ACE_Event_Handler_Handle_Timeout_Upcall,
+                       ACE_SYNCH_RECURSIVE_MUTEX,
+                       TIME_POLICY> timer_queue;
+      ACE_Select_Reactor select_reactor (0, &timer_queue);
+      ACE_Reactor reactor (&select_reactor);
+
+      ACE_Pipe pipe;
+      if (pipe.open () == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")));
+          return;
+        }
+
+      Ping_Handler handler (&reactor, pipe);
+      if (reactor.register_handler (pipe.read_handle (),
+                                    &handler,
+                                    ACE_Event_Handler::READ_MASK) == -1
+          || handler.start () == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("start")));
+          return;
+        }
+
+      ACE_Profile_Timer timer;
+      unsigned long const calls_before = clock_calls;
+      timer.start ();
+      while (handler.count () != events)
+        if (reactor.handle_events () == -1)
+          break;
+      timer.stop ();
+      unsigned long const run_calls = clock_calls - calls_before;
+
+      ACE_Profile_Timer::ACE_Elapsed_Time et;
+      timer.elapsed_time (et);
+      double const elapsed = et.real_time * 1e9 / double (events);
+      double const cpu = (et.user_time + et.system_time) * 1e9 / double (events);
+      if (best_elapsed == 0 || elapsed < best_elapsed)
+        best_elapsed = elapsed;
+      if (best_cpu == 0 || cpu < best_cpu)
+        best_cpu = cpu;
+      calls = run_calls;
+
+      reactor.remove_handler (pipe.read_handle (),
+                              ACE_Event_Handler::READ_MASK
+                              | ACE_Event_Handler::DONT_CALL);
+      reactor.cancel_timer (&handler);
+      pipe.close ();
+    }
+
+#if defined (COUNT_CLOCK_CALLS)
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  %-16s %6.2f clock calls %8.1f ns %8.1f ns CPU ")
+              ACE_TEXT ("per event\n"),
+              what, double (calls) / double (events), best_elapsed, best_cpu));
+#else
+  ACE_UNUSED_ARG (calls);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  %-16s %8.1f ns %8.1f ns CPU per event\n"),
+              what, best_elapsed, best_cpu));
+#endif /* COUNT_CLOCK_CALLS */
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:r:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        events = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+      case 'r':
+        runs = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-n events] [-r runs]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("%B events, best of %d runs\n"),
+              events, runs));
+  run<ACE_FPointer_Time_Policy> (ACE_TEXT ("gettimeofday"));
+#if defined (ACE_HAS_MONOTONIC_TIME_POLICY)
+  run<ACE_Monotonic_Time_Policy> (ACE_TEXT ("monotonic"));
+  run<ACE_TSC_Time_Policy> (ACE_TEXT ("tsc"));
+  // Without a scope the cached policy reads the TSC every time.
+  ACE_Cached_Time_Policy::reactor_scope (true);
+  run<ACE_Cached_Time_Policy> (ACE_TEXT ("cached"));
+#endif /* ACE_HAS_MONOTONIC_TIME_POLICY */
+  return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_string_alloc.cpp
+ *
+ * Count the heap allocations ACE_CString makes for the strings an
+ * ORB handles per request, and time them.
+ *
+ * Each simulated request builds the strings a TAO request carries
+ * through the ORB: the operation name, the target host and object
+ * key, a few service context names, and a string built from several
+ * of them.  The strings are then handed off by value, as they are
+ * when queued for another thread.  The default ACE_Allocator is
+ * replaced by one that counts every block, so the number of
+ * allocations per request is exact.
+ *
+ * Usage: test_string_alloc [-n requests]
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Malloc_Allocator.h"
+#include "ace/SString.h"
+#include "ace/OS_NS_stdlib.h"
+#include <utility>
+
+/// Counts the blocks handed out.
+class Counting_Allocator : public ACE_New_Allocator
+{
+public:
+  Counting_Allocator () : mallocs_ (0) {}
+
+  void *malloc (size_t nbytes) override
+  {
+    ++this->mallocs_;
+    return this->ACE_New_Allocator::malloc (nbytes);
+  }
+
+  size_t mallocs_;
+};
+
+static const char *const operations[] =
+  {
+    "get_value", "set_value", "_is_a", "ping", "shutdown"
+  };
+
+static const char *const contexts[] =
+  {
+    "CodeSets", "RTCorbaPriority", "BI_DIR_IIOP", "InvocationPolicies"
+  };
+
+/// The strings of a request, as they are queued.
+struct Request
+{
+  ACE_CString operation_;
+  ACE_CString host_;
+  ACE_CString object_key_;
+  ACE_CString target_;
+  ACE_CString contexts_[4];
+};
+
+static size_t
+run (size_t n)
+{
+  size_t sum = 0;
+  char key[32];
+  for (size_t i = 0; i != n; ++i)
+    {
+      Request request;
+      request.operation_ = ACE_CString (operations[i % 5]);
+      request.host_ = ACE_CString ("localhost");
+      ACE_OS::snprintf (key, sizeof key, "RootPOA/child/%u", u_int (i % 1000));
+      request.object_key_ = ACE_CString (key);
+
+      // "corbaloc:iiop:" + host + ":2809/" + key
+      ACE_CString target ("corbaloc:iiop:");
+      target += request.host_;
+      target += ":2809/";
+      target += request.object_key_;
+      request.target_ = std::move (target);
+
+      for (size_t c = 0; c != 4; ++c)
+        request.contexts_[c] = ACE_CString (contexts[c]);
+
+      // Hand the request over to the thread that dispatches it.
+      Request queued (std::move (request));
+      sum += queued.target_.length () + queued.operation_.length ();
+    }
+  return sum;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  size_t n = 1000000;
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        n = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-n requests]\n"),
+                           argv[0]),
+                          1);
+      }
+
+  Counting_Allocator alloc;
+  ACE_Allocator *const old_alloc = ACE_Allocator::instance (&alloc);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  size_t const sum = run (n);
+  timer.stop ();
+
+  ACE_Allocator::instance (old_alloc);
+
+  ACE_hrtime_t nsecs = 0;
+  timer.elapsed_time (nsecs);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%B requests (checksum %B): %.2f allocations ")
+              ACE_TEXT ("and %.1f ns per request\n"),
+              n, sum,
+              double (alloc.mallocs_) / double (n),
+              double (nsecs) / double (n)));
+  return 0;
+}
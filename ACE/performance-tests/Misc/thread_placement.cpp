@@ -0,0 +1,295 @@
+/**
+ * @file thread_placement.cpp
+ *
+ * Measure what binding threads to CPUs with ACE_Thread_Placement
+ * gains on a machine with two NUMA nodes, or two groups of CPUs that
+ * stand for them.
+ *
+ * Latency: two threads pass a counter back and forth through one
+ * cache line, unpinned, pinned to two CPUs of the same group and
+ * pinned to one CPU of each group.
+ *
+ * Throughput: threads read buffers over and over, unpinned, pinned
+ * with buffers first touched on their own group, and pinned with
+ * buffers first touched on the other group.
+ *
+ * Usage: thread_placement [-a cpus] [-b cpus] [-n round trips]
+ *                         [-s buffer KB] [-r reads per buffer]
+ *
+ * The groups default to NUMA nodes 0 and 1, or to the two halves of
+ * the CPUs of node 0 when there is a single node.
+ */
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Placement.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_Thread.h"
+
+#include <atomic>
+
+#if defined (ACE_HAS_THREADS)
+
+static ACE_Thread_Placement group_a;
+static ACE_Thread_Placement group_b;
+static int round_trips = 100000;
+static size_t buffer_size = 16 * 1024 * 1024;
+static int reads = 10;
+
+// = Latency
+
+/// The counter the two threads pass back and forth, alone on its
+/// cache line.
+alignas (64) static std::atomic<long> ball;
+
+static ACE_THR_FUNC_RETURN
+player (void *arg)
+{
+  long const parity = static_cast<long> (reinterpret_cast<intptr_t> (arg));
+  long const last = 2L * round_trips;
+  for (long next = parity; next < last; next += 2)
+    {
+      while (ball.load (std::memory_order_acquire) != next)
+        ACE_OS::thr_yield ();
+      ball.store (next + 1, std::memory_order_release);
+    }
+  return 0;
+}
+
+/// Average round trip between two threads placed on @a placement,
+/// 0 to leave them unpinned, in nanoseconds.
+static double
+ping_pong (const ACE_Thread_Placement *placement)
+{
+  ball = 0;
+  ACE_Thread_Manager tm;
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  for (intptr_t i = 0; i != 2; ++i)
+    {
+      ACE_Thread_Placement one (ACE_Thread_Placement::SHARED);
+      if (placement != 0)
+        one.add_cpu (placement->cpu (i));
+      tm.spawn (player,
+                reinterpret_cast<void *> (i),
+                THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                0, 0, ACE_DEFAULT_THREAD_PRIORITY, -1, 0,
+                ACE_DEFAULT_THREAD_STACKSIZE, 0,
+                placement == 0 ? 0 : &one);
+    }
+  tm.wait ();
+  timer.stop ();
+
+  ACE_hrtime_t nsecs = 0;
+  timer.elapsed_time (nsecs);
+  return double (nsecs) / round_trips;
+}
+
+// = Throughput
+
+/// What a reader is given: where its buffer is first touched, and
+/// where it then reads it.
+struct Reader
+{
+  ACE_Thread_Placement touch_;
+  ACE_Thread_Placement read_;
+  char *buffer_;
+  ACE_UINT64 sum_;
+};
+
+static ACE_THR_FUNC_RETURN
+toucher (void *arg)
+{
+  Reader *reader = static_cast<Reader *> (arg);
+  reader->buffer_ =
+    static_cast<char *> (ACE_Thread_Placement::allocate (buffer_size));
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+read_buffer (void *arg)
+{
+  Reader *reader = static_cast<Reader *> (arg);
+  ACE_UINT64 const *words =
+    reinterpret_cast<ACE_UINT64 const *> (reader->buffer_);
+  size_t const n = buffer_size / sizeof (ACE_UINT64);
+  ACE_UINT64 sum = 0;
+  for (int r = 0; r != reads; ++r)
+    for (size_t i = 0; i != n; ++i)
+      sum += words[i];
+  reader->sum_ = sum;
+  return 0;
+}
+
+/// Spawn @a n threads that each run @a func on their Reader, placed
+/// on its touch_ or read_ CPUs.
+static void
+spawn_readers (Reader readers[], int n, ACE_THR_FUNC func, bool touch)
+{
+  ACE_Thread_Manager tm;
+  for (int i = 0; i != n; ++i)
+    {
+      const ACE_Thread_Placement &where =
+        touch ? readers[i].touch_ : readers[i].read_;
+      tm.spawn (func,
+                &readers[i],
+                THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                0, 0, ACE_DEFAULT_THREAD_PRIORITY, -1, 0,
+                ACE_DEFAULT_THREAD_STACKSIZE, 0,
+                where.empty () ? 0 : &where);
+    }
+  tm.wait ();
+}
+
+/// Bytes read per second by one reader per CPU of group A, each
+/// reading a buffer first touched on @a touch_group, or unpinned
+/// when @a pinned is false.
+static double
+stream (bool pinned, const ACE_Thread_Placement &touch_group)
+{
+  int const n = static_cast<int> (group_a.cpu_count ());
+  Reader *readers = new Reader[n];
+  for (int i = 0; i != n; ++i)
+    {
+      readers[i].buffer_ = 0;
+      readers[i].sum_ = 0;
+      if (pinned)
+        {
+          readers[i].touch_.add_cpu (touch_group.cpu (i));
+          readers[i].read_.add_cpu (group_a.cpu (i));
+        }
+    }
+
+  spawn_readers (readers, n, toucher, true);
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  spawn_readers (readers, n, read_buffer, false);
+  timer.stop ();
+
+  for (int i = 0; i != n; ++i)
+    ACE_Thread_Placement::deallocate (readers[i].buffer_, buffer_size);
+  delete [] readers;
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+  return double (n) * reads * buffer_size / (double (usecs) / 1.0e6);
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("a:b:n:s:r:"));
+  int c;
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'a':
+        if (group_a.add (get_opts.opt_arg ()) == -1)
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("bad -a CPUs\n")), -1);
+        break;
+      case 'b':
+        if (group_b.add (get_opts.opt_arg ()) == -1)
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("bad -b CPUs\n")), -1);
+        break;
+      case 'n':
+        round_trips = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 's':
+        buffer_size = 1024 * ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+      case 'r':
+        reads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-a cpus] [-b cpus] ")
+                           ACE_TEXT ("[-n round trips] [-s buffer KB] ")
+                           ACE_TEXT ("[-r reads per buffer]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+/// Split the CPUs of node 0 in two groups when no group was given
+/// and there is no node 1.
+static void
+default_groups ()
+{
+  if (group_a.empty () && group_b.empty ()
+      && group_a.add_node (0) == 0
+      && group_b.add_node (1) == -1)
+    {
+      ACE_Thread_Placement node (group_a);
+      group_a.clear ();
+      group_b.clear ();
+      size_t const half = (node.cpu_count () + 1) / 2;
+      for (size_t i = 0; i != node.cpu_count (); ++i)
+        (i < half ? group_a : group_b).add_cpu (node.cpu (i));
+    }
+  if (group_b.empty ())
+    group_b = group_a;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+  default_groups ();
+  if (group_a.empty ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("No CPU to place the threads on\n")),
+                      1);
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("Groups of %B and %B CPUs\n"),
+              group_a.cpu_count (),
+              group_b.cpu_count ()));
+
+  ACE_Thread_Placement same;
+  same.add_cpu (group_a.cpu (0));
+  same.add_cpu (group_a.cpu (1));
+  ACE_Thread_Placement cross;
+  cross.add_cpu (group_a.cpu (0));
+  cross.add_cpu (group_b.cpu (0));
+
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("Round trip, ns\n")));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  unpinned     %10.1f\n"),
+              ping_pong (0)));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  same group   %10.1f  (CPUs %d, %d)\n"),
+              ping_pong (&same), same.cpu (0), same.cpu (1)));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  cross group  %10.1f  (CPUs %d, %d)\n"),
+              ping_pong (&cross), cross.cpu (0), cross.cpu (1)));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("Read throughput, MB/s, %B readers\n"),
+              group_a.cpu_count ()));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  unpinned     %10.1f\n"),
+              stream (false, group_a) / 1.0e6));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  local pages  %10.1f\n"),
+              stream (true, group_a) / 1.0e6));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("  remote pages %10.1f\n"),
+              stream (true, group_b) / 1.0e6));
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("threads not supported on this platform\n")),
+                    1);
+}
+
+#endif /* ACE_HAS_THREADS */
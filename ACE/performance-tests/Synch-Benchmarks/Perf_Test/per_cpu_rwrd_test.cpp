@@ -0,0 +1,41 @@
+#define  ACE_BUILD_SVC_DLL
+#include "ace/Per_CPU_RW_Thread_Mutex.h"
+#include "Performance_Test_Options.h"
+#include "Benchmark_Performance.h"
+
+#if defined (ACE_HAS_THREADS)
+
+// Like RWRD_Test, with a lock whose readers do not share a counter.
+class ACE_Svc_Export Per_CPU_RWRD_Test : public Benchmark_Performance
+{
+public:
+  virtual int svc ();
+
+private:
+  static ACE_Per_CPU_RW_Thread_Mutex rw_lock;
+};
+
+ACE_Per_CPU_RW_Thread_Mutex Per_CPU_RWRD_Test::rw_lock;
+
+int
+Per_CPU_RWRD_Test::svc ()
+{
+  int ni = this->thr_id ();
+  synch_count = 2;
+
+  while (!this->done ())
+    {
+      rw_lock.acquire_read ();
+      performance_test_options.thr_work_count[ni]++;
+      buffer++;
+      rw_lock.release ();
+    }
+
+  /* NOTREACHED */
+  return 0;
+}
+
+ACE_SVC_FACTORY_DECLARE (Per_CPU_RWRD_Test)
+ACE_SVC_FACTORY_DEFINE  (Per_CPU_RWRD_Test)
+
+#endif /* ACE_HAS_THREADS */
@@ -25,6 +25,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_main.h"
 #include "ace/OS_NS_arpa_inet.h"
 #include "ace/OS_NS_ctype.h"
@@ -216,7 +217,12 @@ Client::run (void)
         ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "get_response"), -1);
     }
 
-  ACE_Sample_History history (nsamples);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats latency;
+  latency.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (dump_history ? nsamples : 0);
 
   ACE_hrtime_t test_start = ACE_OS::gethrtime ();
   for (int i = 0; i != nsamples; ++i)
@@ -237,6 +243,7 @@ Client::run (void)
 
       ACE_hrtime_t end = ACE_OS::gethrtime ();
 
+      latency.sample (end - start);
       history.sample (end - start);
 
       if (VERBOSE && i % 500 == 0)
@@ -255,8 +262,6 @@ Client::run (void)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats latency;
-  history.collect_basic_stats (latency);
   latency.dump_results (ACE_TEXT("Client"), gsf);
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Client"),
                                          gsf,
@@ -0,0 +1,283 @@
+
+//=============================================================================
+/**
+ *  @file    BTree_Test.cpp
+ *
+ *    This test checks that <ACE_BTree> gives the same results as
+ *    <ACE_RB_Tree> for the same sequence of operations, and that the
+ *    tree stays balanced through splits, borrows and merges.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/BTree_T.h"
+#include "ace/RB_Tree.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/OS_NS_stdlib.h"
+
+using INT_BTREE = ACE_BTree<int, int, ACE_Less_Than<int>, ACE_Null_Mutex>;
+
+using INT_RB_TREE = ACE_RB_Tree<int, int, ACE_Less_Than<int>, ACE_Null_Mutex>;
+
+// Keys larger than the items, for fewer entries per leaf and more
+// levels.
+using STRING_BTREE = ACE_BTree<ACE_CString, int, ACE_Less_Than<ACE_CString>, ACE_Null_Mutex>;
+
+/// The return values of each operation must be those of
+/// ACE_RB_Tree.
+static int
+test_operations ()
+{
+  int status = 0;
+  INT_BTREE tree;
+  INT_BTREE::ENTRY *entry = 0;
+  int item = 0;
+
+  for (int i = 0; i != 10; ++i)
+    if (tree.bind (i, i * 10) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind %d failed\n"), i));
+        status = 1;
+      }
+
+  if (tree.bind (3, 99, entry) != 1 || entry->item () != 30)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind of an existing key\n")));
+      status = 1;
+    }
+
+  item = 99;
+  if (tree.trybind (4, item) != 1 || item != 40)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("trybind of an existing key\n")));
+      status = 1;
+    }
+
+  int old_item = 0;
+  if (tree.rebind (5, 55, old_item) != 1
+      || old_item != 50
+      || tree.find (5, item) != 0
+      || item != 55)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of an existing key\n")));
+      status = 1;
+    }
+
+  if (tree.rebind (20, 200, entry) != 0
+      || entry->key () != 20
+      || entry->item () != 200
+      || tree.current_size () != 11)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of a new key\n")));
+      status = 1;
+    }
+
+  if (tree.unbind (20, item) != 0
+      || item != 200
+      || tree.unbind (20) != -1
+      || tree.find (20, entry) != -1
+      || tree.current_size () != 10)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind\n")));
+      status = 1;
+    }
+
+  if (tree.find (7, entry) != 0
+      || tree.unbind (entry) != 0
+      || tree.find (7, item) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind of an entry\n")));
+      status = 1;
+    }
+
+  INT_BTREE::iterator pos = tree.lower_bound (7);
+  if (pos == tree.end () || (*pos).key () != 8)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("lower_bound of a missing key\n")));
+      status = 1;
+    }
+  if (tree.lower_bound (10) != tree.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("lower_bound past the last key\n")));
+      status = 1;
+    }
+
+  INT_BTREE copy (tree);
+  tree.close ();
+  if (tree.current_size () != 0
+      || tree.begin () != tree.end ()
+      || copy.current_size () != 9
+      || copy.test_invariant () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("close or copy\n")));
+      status = 1;
+    }
+  return status;
+}
+
+/// Every entry of @a tree must be in @a rb_tree with the same item,
+/// in the same order going forward and backward.
+static int
+compare (INT_BTREE &tree, INT_RB_TREE &rb_tree)
+{
+  int status = 0;
+  if (tree.current_size () != rb_tree.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%B entries, expected %B\n"),
+                  tree.current_size (), rb_tree.current_size ()));
+      status = 1;
+    }
+
+  INT_RB_TREE::iterator expected = rb_tree.begin ();
+  for (INT_BTREE::iterator i = tree.begin ();
+       i != tree.end () && status == 0;
+       ++i, ++expected)
+    if (expected == rb_tree.end ()
+        || (*i).key () != (*expected).key ()
+        || (*i).item () != (*expected).item ())
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("forward walk differs at %d\n"),
+                    (*i).key ()));
+        status = 1;
+      }
+
+  INT_RB_TREE::reverse_iterator rexpected = rb_tree.rbegin ();
+  for (INT_BTREE::reverse_iterator i = tree.rbegin ();
+       i != tree.rend () && status == 0;
+       ++i, ++rexpected)
+    if (rexpected == rb_tree.rend () || (*i).key () != (*rexpected).key ())
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("backward walk differs at %d\n"),
+                    (*i).key ()));
+        status = 1;
+      }
+
+  if (tree.test_invariant () != 0)
+    status = 1;
+  return status;
+}
+
+/// Apply the same random binds and unbinds to both trees, over a key
+/// range small enough for keys to come back after being unbound.
+static int
+test_random (size_t operations, int keys)
+{
+  int status = 0;
+  INT_BTREE tree;
+  INT_RB_TREE rb_tree;
+
+  ACE_OS::srand (42);
+  for (size_t i = 0; i != operations && status == 0; ++i)
+    {
+      int const key = ACE_OS::rand () % keys;
+      int const item = static_cast<int> (i);
+      int result = 0;
+      int expected = 0;
+      switch (ACE_OS::rand () % 4)
+        {
+        case 0:
+          result = tree.bind (key, item);
+          expected = rb_tree.bind (key, item);
+          break;
+        case 1:
+          result = tree.rebind (key, item);
+          expected = rb_tree.rebind (key, item);
+          break;
+        default:
+          result = tree.unbind (key);
+          expected = rb_tree.unbind (key);
+          break;
+        }
+      if (result != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("operation %B on %d returned %d, expected %d\n"),
+                      i, key, result, expected));
+          status = 1;
+        }
+      if (i % 1000 == 0 && tree.test_invariant () != 0)
+        status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B operations on %d keys: %B entries\n"),
+              operations, keys, tree.current_size ()));
+  return status | compare (tree, rb_tree);
+}
+
+/// Fill a tree in ascending and descending order, then empty it from
+/// the middle out, checking the invariant all along.
+static int
+test_sequential ()
+{
+  int status = 0;
+  STRING_BTREE tree;
+  char buf[16];
+  int const n = 3000;
+
+  for (int i = 0; i != n; ++i)
+    {
+      int const key = i % 2 == 0 ? i : n * 2 - i;
+      ACE_OS::sprintf (buf, "%08d", key);
+      if (tree.bind (ACE_CString (buf), key) != 0)
+        status = 1;
+    }
+  if (status != 0 || tree.current_size () != size_t (n) || tree.test_invariant () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("sequential binds\n")));
+      return 1;
+    }
+
+  ACE_CString prev;
+  size_t count = 0;
+  for (STRING_BTREE::iterator i = tree.begin (); i != tree.end (); ++i, ++count)
+    {
+      if (count > 0 && !(prev < (*i).key ()))
+        status = 1;
+      prev = (*i).key ();
+    }
+  if (status != 0 || count != size_t (n))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("walk of %B entries out of order\n"), count));
+      return 1;
+    }
+
+  for (int d = 0; d != n / 2; ++d)
+    for (int side = -1; side <= 1; side += 2)
+      {
+        int const key = n + side * d;
+        ACE_OS::sprintf (buf, "%08d", key);
+        bool const bound = key % 2 == 0 ? key < n : key > n;
+        int const expected = bound ? 0 : -1;
+        if (tree.unbind (ACE_CString (buf)) != expected)
+          {
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind of %d\n"), key));
+            status = 1;
+          }
+        if (d % 100 == 0 && tree.test_invariant () != 0)
+          status = 1;
+      }
+
+  if (tree.test_invariant () != 0)
+    status = 1;
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B entries left after unbinding the middle\n"),
+              tree.current_size ()));
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("BTree_Test"));
+
+  int status = test_operations ();
+  status |= test_random (20000, 100);
+  status |= test_random (200000, 50000);
+  status |= test_sequential ();
+
+  ACE_END_TEST;
+  return status;
+}
@@ -843,6 +843,85 @@ CDR_Test_Types::test_get_placeholder (ACE_InputCDR &cdr) const
 }
 
 
+static int
+reserve_stream ()
+{
+  ACE_OutputCDR os;
+  ACE_SizeCDR ss;
+
+  // Start the reserved part at an odd offset.
+  os.write_octet (1);
+  ss.write_octet (1);
+
+  ACE_CDR::Double d_array[1000];
+  for (int i = 0; i != 1000; ++i)
+    d_array[i] = i * 0.5;
+  ACE_Message_Block mb1 (100);
+  mb1.wr_ptr (100);
+  ACE_Message_Block mb2 (33);
+  mb2.wr_ptr (33);
+  mb1.cont (&mb2);
+
+  ss.write_ulong (1000);
+  ss.write_double_array (d_array, 1000);
+  ss.write_string ("reserved");
+  ss.write_octet_array_mb (&mb1);
+
+  if (os.reserve (ss.total_length () - 1) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("reserve")),
+                      1);
+
+  os.write_ulong (1000);
+  os.write_double_array (d_array, 1000);
+  os.write_string ("reserved");
+  // Blocks this small are copied into the stream.
+  os.write_octet_array_mb (&mb1);
+  mb1.cont (0);
+
+  if (os.total_length () != ss.total_length ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B octets written, %B sized\n"),
+                       os.total_length (),
+                       ss.total_length ()),
+                      1);
+
+  // The ulong went in the first block, the rest in the reserved one.
+  const ACE_Message_Block *reserved = os.begin ()->cont ();
+  if (os.begin ()->length () != 8
+      || reserved == 0
+      || reserved->cont () != 0
+      || os.current () != reserved)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserved stream of %B octets in ")
+                       ACE_TEXT ("more than two blocks\n"),
+                       os.total_length ()),
+                      1);
+
+  // The reserved block starts at the alignment of the stream.
+  if (reinterpret_cast<ptrdiff_t> (reserved->rd_ptr ())
+      % ACE_CDR::MAX_ALIGNMENT != 8 % ACE_CDR::MAX_ALIGNMENT)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserved block is misaligned\n")),
+                      1);
+
+  ACE_InputCDR is (os);
+  ACE_CDR::Octet o = 0;
+  ACE_CDR::ULong length = 0;
+  ACE_CDR::Double d_read[1000];
+  if (!is.read_octet (o)
+      || !is.read_ulong (length)
+      || length != 1000
+      || !is.read_double_array (d_read, 1000)
+      || d_read[999] != d_array[999])
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserved stream not read back\n")),
+                      1);
+
+  return 0;
+}
+
 int
 run_main (int argc, ACE_TCHAR *argv[])
 {
@@ -1027,7 +1106,14 @@ run_main (int argc, ACE_TCHAR *argv[])
     return 1;
 
   ACE_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("Placeholder/Replace - no errors\n\n")));
+              ACE_TEXT ("Placeholder/Replace - no errors\n\n")
+              ACE_TEXT ("Testing reserve\n\n")));
+
+  if (reserve_stream () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Reserve - no errors\n\n")));
 
   ACE_END_TEST;
   return 0;
@@ -0,0 +1,250 @@
+
+//=============================================================================
+/**
+ *  @file    Cached_Time_Policy_Test.cpp
+ *
+ *    This test checks <ACE_TSC_Time_Policy> against the monotonic
+ *    clock, that <ACE_Cached_Time_Policy> reuses the time it read only
+ *    within a scope, that a reactor opens a scope only when asked to,
+ *    and that a reactor whose timer queue uses it fires timers on
+ *    time and counts down its wait time.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/TSC_Time_Policy.h"
+#include "ace/Cached_Time_Policy.h"
+#include "ace/Monotonic_Time_Policy.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Timer_Heap_T.h"
+#include "ace/Event_Handler_Handle_Timeout_Upcall.h"
+#include "ace/Synch_Traits.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_MONOTONIC_TIME_POLICY)
+
+// The two clocks are read one after the other, and may be preempted
+// in between.
+static const ACE_Time_Value tolerance (0, 20000);
+
+static int
+test_tsc ()
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("TSC time policy %s the time stamp counter\n"),
+              ACE_TSC_Time_Policy::uses_tsc () ? ACE_TEXT ("uses")
+                                               : ACE_TEXT ("does not use")));
+
+  ACE_TSC_Time_Policy tsc;
+  ACE_Monotonic_Time_Policy monotonic;
+  int status = 0;
+
+  // Cover a recalibration.
+  for (int round = 0; round != 3; ++round)
+    {
+      ACE_Time_Value const a = monotonic ();
+      ACE_Time_Value const t = tsc ();
+      ACE_Time_Value const b = monotonic ();
+      if (t + tolerance < a || t > b + tolerance)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("TSC time %#T is not between %#T and %#T\n"),
+                      &t, &a, &b));
+          status = 1;
+        }
+
+      ACE_Time_Value last = tsc ();
+      for (int i = 0; i != 100000; ++i)
+        {
+          ACE_Time_Value const now = tsc ();
+          if (now < last)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("TSC time went back from %#T to %#T\n"),
+                          &last, &now));
+              status = 1;
+              break;
+            }
+          last = now;
+        }
+      ACE_OS::sleep (ACE_Time_Value (0, 600000));
+    }
+  return status;
+}
+
+static int
+test_cached ()
+{
+  ACE_Cached_Time_Policy cached;
+  ACE_Time_Value const pause (0, 20000);
+  int status = 0;
+
+  // Outside a scope every call reads the clock.
+  ACE_Time_Value const before = cached ();
+  ACE_OS::sleep (pause);
+  if (cached () == before)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("time cached outside a scope\n")));
+      status = 1;
+    }
+
+  {
+    ACE_Cached_Time_Policy::Scope scope;
+    ACE_Time_Value const first = cached ();
+    ACE_OS::sleep (pause);
+    if (cached () != first)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("time not cached in a scope\n")));
+        status = 1;
+      }
+
+    ACE_Cached_Time_Policy::invalidate ();
+    ACE_Time_Value const second = cached ();
+    if (second - first < pause)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("invalidate() did not read the clock\n")));
+        status = 1;
+      }
+
+    {
+      ACE_Cached_Time_Policy::Scope nested;
+      ACE_OS::sleep (pause);
+      cached ();
+    }
+
+    // The nested scope took time, which the outer one must see.
+    if (cached () - second < pause)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("time not read again after a nested scope\n")));
+        status = 1;
+      }
+  }
+  return status;
+}
+
+class Timer_Handler : public ACE_Event_Handler
+{
+public:
+  Timer_Handler () : fired_ (0), late_ (0), stale_ (0) {}
+
+  int handle_timeout (const ACE_Time_Value &, const void *arg) override
+  {
+    ACE_Time_Value const *due = static_cast<ACE_Time_Value const *> (arg);
+    if (ACE_Monotonic_Time_Policy () () + tolerance < *due)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("timer fired early\n")));
+        ++this->late_;
+      }
+
+    // Whether the handler sees time pass.
+    ACE_Cached_Time_Policy cached;
+    ACE_Time_Value const before = cached ();
+    ACE_OS::sleep (ACE_Time_Value (0, 1000));
+    if (cached () == before)
+      ++this->stale_;
+
+    ++this->fired_;
+    return 0;
+  }
+
+  int fired_;
+  int late_;
+  int stale_;
+};
+
+static int
+test_reactor (bool reactor_scope)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Reactor %s a scope\n"),
+              reactor_scope ? ACE_TEXT ("opens") : ACE_TEXT ("does not open")));
+  ACE_Cached_Time_Policy::reactor_scope (reactor_scope);
+
+  using timer_queue_type =
+    ACE_Timer_Heap_T<ACE_Event_Handler *,
+                     ACE_Event_Handler_Handle_Timeout_Upcall,
+                     ACE_SYNCH_RECURSIVE_MUTEX,
+                     ACE_Cached_Time_Policy>;
+  timer_queue_type timer_queue;
+  ACE_Select_Reactor select_reactor (0, &timer_queue);
+  ACE_Reactor reactor (&select_reactor);
+  int status = 0;
+
+  // The countdown covers waiting with nothing to do.
+  ACE_Time_Value wait (0, 50000);
+  ACE_Time_Value const start = ACE_Monotonic_Time_Policy () ();
+  while (wait != ACE_Time_Value::zero)
+    reactor.handle_events (wait);
+  ACE_Time_Value const waited = ACE_Monotonic_Time_Policy () () - start;
+  if (waited + tolerance < ACE_Time_Value (0, 50000))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("handle_events returned after %#T\n"), &waited));
+      status = 1;
+    }
+
+  const int timers = 5;
+  Timer_Handler handler;
+  ACE_Time_Value due[timers];
+  for (int i = 0; i != timers; ++i)
+    {
+      ACE_Time_Value const delay (0, (i + 1) * 10000);
+      due[i] = ACE_Monotonic_Time_Policy () () + delay;
+      if (reactor.schedule_timer (&handler, &due[i], delay) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("schedule_timer")), 1);
+    }
+
+  ACE_Time_Value limit (2);
+  while (handler.fired_ != timers && limit != ACE_Time_Value::zero)
+    reactor.handle_events (limit);
+  if (handler.fired_ != timers || handler.late_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d of %d timers fired, %d early\n"),
+                  handler.fired_, timers, handler.late_));
+      status = 1;
+    }
+
+  // The time stands still in the handlers only in a scope.
+  int const stale = reactor_scope ? handler.fired_ : 0;
+  if (handler.stale_ != stale)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("time stood still in %d handlers, expected %d\n"),
+                  handler.stale_, stale));
+      status = 1;
+    }
+
+  ACE_Cached_Time_Policy::reactor_scope (false);
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Cached_Time_Policy_Test"));
+
+  int status = test_tsc ();
+  status |= test_cached ();
+  status |= test_reactor (false);
+  status |= test_reactor (true);
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Cached_Time_Policy_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("monotonic time is not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_MONOTONIC_TIME_POLICY */
@@ -0,0 +1,283 @@
+
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_Manager_Test.cpp
+ *
+ *    This test checks that <ACE_Flat_Hash_Map_Manager_Ex> gives the
+ *    same results as <ACE_Hash_Map_Manager_Ex> for the same sequence
+ *    of operations, through growth, unbinds and iteration.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "STL_algorithm_Test_T.h"
+#include "ace/Flat_Hash_Map_Manager_T.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_stdlib.h"
+
+using FLAT_STRING_MAP = ACE_Flat_Hash_Map_Manager_Ex<const ACE_TCHAR *, const ACE_TCHAR *, ACE_Hash<const ACE_TCHAR *>, ACE_Equal_To<const ACE_TCHAR *>, ACE_Null_Mutex>;
+
+using FLAT_INT_MAP = ACE_Flat_Hash_Map_Manager_Ex<u_long, u_long, ACE_Hash<u_long>, ACE_Equal_To<u_long>, ACE_Null_Mutex>;
+
+using CHAINED_INT_MAP = ACE_Hash_Map_Manager_Ex<u_long, u_long, ACE_Hash<u_long>, ACE_Equal_To<u_long>, ACE_Null_Mutex>;
+
+struct String_Table
+{
+  const ACE_TCHAR *key_;
+  const ACE_TCHAR *value_;
+};
+
+static String_Table string_table[] =
+{
+  { ACE_TEXT ("hello"), ACE_TEXT ("guten Tag") },
+  { ACE_TEXT ("goodbye"), ACE_TEXT ("auf wiedersehen") },
+  { ACE_TEXT ("funny"), ACE_TEXT ("lustig") },
+  { 0, 0 }
+};
+
+/// The return values of each operation must be those of
+/// ACE_Hash_Map_Manager_Ex.
+static int
+test_operations ()
+{
+  int status = 0;
+  FLAT_STRING_MAP map (8);
+  const ACE_TCHAR *value = 0;
+  FLAT_STRING_MAP::ENTRY *entry = 0;
+
+  for (size_t i = 0; string_table[i].key_ != 0; ++i)
+    if (map.bind (string_table[i].key_, string_table[i].value_) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind %s failed\n"),
+                    string_table[i].key_));
+        status = 1;
+      }
+
+  if (map.bind (string_table[0].key_, ACE_TEXT ("other"), entry) != 1
+      || entry->int_id_ != string_table[0].value_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind of an existing key\n")));
+      status = 1;
+    }
+
+  value = ACE_TEXT ("other");
+  if (map.trybind (string_table[1].key_, value) != 1
+      || value != string_table[1].value_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("trybind of an existing key\n")));
+      status = 1;
+    }
+
+  const ACE_TCHAR *old_value = 0;
+  if (map.rebind (string_table[2].key_, ACE_TEXT ("drollig"), old_value) != 1
+      || old_value != string_table[2].value_
+      || map.find (string_table[2].key_, value) != 0
+      || ACE_OS::strcmp (value, ACE_TEXT ("drollig")) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of an existing key\n")));
+      status = 1;
+    }
+
+  if (map.rebind (ACE_TEXT ("new"), ACE_TEXT ("neu"), entry) != 0
+      || entry == 0
+      || ACE_OS::strcmp (entry->int_id_, ACE_TEXT ("neu")) != 0
+      || map.current_size () != 4)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of a new key\n")));
+      status = 1;
+    }
+
+  if (map.unbind (ACE_TEXT ("new"), value) != 0
+      || ACE_OS::strcmp (value, ACE_TEXT ("neu")) != 0
+      || map.unbind (ACE_TEXT ("new")) != -1
+      || map.find (ACE_TEXT ("new")) != -1
+      || map.current_size () != 3)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind\n")));
+      status = 1;
+    }
+
+  FLAT_STRING_MAP::iterator pos = map.end ();
+  map.find (string_table[0].key_, pos);
+  if (pos == map.end ()
+      || ACE_OS::strcmp ((*pos).ext_id_, string_table[0].key_) != 0
+      || map.unbind (pos) != 0
+      || map.find (string_table[0].key_) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind of an iterator\n")));
+      status = 1;
+    }
+  map.find (string_table[0].key_, pos);
+  if (pos != map.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("find of a missing key\n")));
+      status = 1;
+    }
+
+  test_STL_algorithm (map);
+
+  map.unbind_all ();
+  if (map.current_size () != 0 || map.begin () != map.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind_all\n")));
+      status = 1;
+    }
+  return status;
+}
+
+/// Every entry of @a flat must be in @a chained with the same value,
+/// once going forward and once going backward.
+static int
+compare (const FLAT_INT_MAP &flat, CHAINED_INT_MAP &chained)
+{
+  int status = 0;
+  if (flat.current_size () != chained.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%B entries, expected %B\n"),
+                  flat.current_size (), chained.current_size ()));
+      status = 1;
+    }
+
+  size_t forward = 0;
+  for (FLAT_INT_MAP::const_iterator i = flat.begin (); i != flat.end (); ++i)
+    {
+      u_long value = 0;
+      if (chained.find ((*i).ext_id_, value) != 0 || value != (*i).int_id_)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%lu is wrong\n"), (*i).ext_id_));
+          status = 1;
+        }
+      ++forward;
+    }
+
+  size_t backward = 0;
+  for (FLAT_INT_MAP::const_reverse_iterator i = flat.rbegin ();
+       i != flat.rend ();
+       ++i)
+    ++backward;
+
+  if (forward != chained.current_size () || backward != forward)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("iterated over %B and %B entries, expected %B\n"),
+                  forward, backward, chained.current_size ()));
+      status = 1;
+    }
+
+  for (CHAINED_INT_MAP::iterator i = chained.begin (); i != chained.end (); ++i)
+    if (flat.find ((*i).ext_id_) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%lu is missing\n"), (*i).ext_id_));
+        status = 1;
+      }
+  return status;
+}
+
+/// Apply the same random binds and unbinds to both maps, over a key
+/// range small enough for keys to come back after being unbound.
+static int
+test_random (size_t operations, u_long keys)
+{
+  int status = 0;
+  FLAT_INT_MAP flat (1);
+  CHAINED_INT_MAP chained;
+
+  ACE_OS::srand (42);
+  for (size_t i = 0; i != operations && status == 0; ++i)
+    {
+      u_long const key = static_cast<u_long> (ACE_OS::rand ()) % keys;
+      u_long const value = static_cast<u_long> (i);
+      int flat_result = 0;
+      int chained_result = 0;
+      switch (ACE_OS::rand () % 4)
+        {
+        case 0:
+          flat_result = flat.bind (key, value);
+          chained_result = chained.bind (key, value);
+          break;
+        case 1:
+          flat_result = flat.rebind (key, value);
+          chained_result = chained.rebind (key, value);
+          break;
+        default:
+          flat_result = flat.unbind (key);
+          chained_result = chained.unbind (key);
+          break;
+        }
+      if (flat_result != chained_result)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("operation %B on %lu returned %d, expected %d\n"),
+                      i, key, flat_result, chained_result));
+          status = 1;
+        }
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B operations on %lu keys: %B entries in %B slots\n"),
+              operations, keys, flat.current_size (), flat.total_size ()));
+  return status | compare (flat, chained);
+}
+
+/// Unbinding the entry an iterator is on must not disturb the walk
+/// over the others.
+static int
+test_unbind_while_iterating ()
+{
+  FLAT_INT_MAP map;
+  for (u_long i = 0; i != 1000; ++i)
+    map.bind (i, i * 2);
+
+  FLAT_INT_MAP::ITERATOR iter (map);
+  for (FLAT_INT_MAP::ENTRY *entry = 0; iter.next (entry); )
+    {
+      u_long const key = entry->ext_id_;
+      iter.advance ();
+      if (key % 2 == 0)
+        map.unbind (entry);
+    }
+
+  int status = 0;
+  if (map.current_size () != 500)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%B entries left, expected 500\n"),
+                  map.current_size ()));
+      status = 1;
+    }
+  for (u_long i = 0; i != 1000; ++i)
+    if ((map.find (i) == 0) != (i % 2 == 1))
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%lu is wrong\n"), i));
+        status = 1;
+      }
+
+  // The table keeps the deleted slots until it has to grow, then
+  // gets rid of them.
+  size_t const slots = map.total_size ();
+  for (u_long i = 0; i != 1000; i += 2)
+    map.bind (i, i * 2);
+  if (map.current_size () != 1000 || map.total_size () != slots)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B entries in %B slots, expected 1000 in %B\n"),
+                  map.current_size (), map.total_size (), slots));
+      status = 1;
+    }
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Flat_Hash_Map_Manager_Test"));
+
+  int status = test_operations ();
+  status |= test_random (20000, 100);
+  status |= test_random (200000, 50000);
+  status |= test_unbind_while_iterating ();
+
+  ACE_END_TEST;
+  return status;
+}
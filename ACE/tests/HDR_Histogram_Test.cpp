@@ -0,0 +1,241 @@
+
+//=============================================================================
+/**
+ *  @file    HDR_Histogram_Test.cpp
+ *
+ *    This test checks that <ACE_HDR_Histogram> keeps values to the
+ *    precision asked for, that histograms recorded by several threads
+ *    add up, also when added concurrently, that the encoded form reads
+ *    back to the same histogram, and that <ACE_Basic_Stats> records
+ *    into and merges its histograms.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/HDR_Histogram.h"
+#include "ace/Basic_Stats.h"
+#include "ace/CDR_Stream.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdlib.h"
+
+static int
+check (ACE_UINT64 got, ACE_UINT64 expected, ACE_UINT64 tolerance,
+       const ACE_TCHAR *what)
+{
+  ACE_UINT64 const diff = got > expected ? got - expected : expected - got;
+  if (diff > tolerance)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s is %Q instead of %Q\n"),
+                  what, got, expected));
+      return 1;
+    }
+  return 0;
+}
+
+static int
+test_precision ()
+{
+  int status = 0;
+  ACE_HDR_Histogram histogram (ACE_UINT64 (3600) * 1000000000, 3);
+
+  ACE_UINT64 const n = 1000000;
+  for (ACE_UINT64 i = 1; i <= n; ++i)
+    histogram.record (i);
+
+  status |= check (histogram.total_count (), n, 0, ACE_TEXT ("count"));
+  status |= check (histogram.min (), 1, 0, ACE_TEXT ("min"));
+  status |= check (histogram.max (), n, 0, ACE_TEXT ("max"));
+  status |= check (histogram.mean (), n / 2, n / 1000, ACE_TEXT ("mean"));
+  status |= check (histogram.value_at_percentile (50.0), n / 2, n / 1000,
+                   ACE_TEXT ("p50"));
+  status |= check (histogram.value_at_percentile (99.0), n / 100 * 99,
+                   n / 1000, ACE_TEXT ("p99"));
+  status |= check (histogram.value_at_percentile (99.99), n / 10000 * 9999,
+                   n / 1000, ACE_TEXT ("p99.99"));
+  status |= check (histogram.value_at_percentile (100.0), n, 0,
+                   ACE_TEXT ("p100"));
+
+  // Small values are exact.
+  ACE_HDR_Histogram small;
+  small.record (0);
+  small.record (7, 3);
+  status |= check (small.value_at_percentile (25.0), 0, 0,
+                   ACE_TEXT ("small p25"));
+  status |= check (small.value_at_percentile (50.0), 7, 0,
+                   ACE_TEXT ("small p50"));
+
+  // Every value is in a bucket no wider than a thousandth of it.
+  ACE_OS::srand (42);
+  for (int i = 0; i != 100000; ++i)
+    {
+      ACE_UINT64 const value =
+        (ACE_UINT64 (ACE_OS::rand ()) << 31 ^ ACE_UINT64 (ACE_OS::rand ()))
+        >> (ACE_OS::rand () % 60);
+      ACE_UINT64 const lowest = small.lowest_equivalent_value (value);
+      ACE_UINT64 const highest = small.highest_equivalent_value (value);
+      if (lowest > value || highest < value
+          || (highest - lowest) > value / 1000)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%Q is counted in [%Q, %Q]\n"),
+                      value, lowest, highest));
+          status = 1;
+          break;
+        }
+    }
+
+  // Values out of range are counted at the top.
+  ACE_HDR_Histogram bounded (1000000, 2);
+  bounded.record (ACE_UINT64 (1) << 40);
+  status |= check (bounded.max (), 1000000, 0, ACE_TEXT ("clamped max"));
+  return status;
+}
+
+static const size_t n_threads = 4;
+static const ACE_UINT64 n_samples = 200000;
+
+static ACE_HDR_Histogram *thread_histograms[n_threads];
+static ACE_HDR_Histogram shared_total;
+static ACE_HDR_Histogram shared_atomic;
+
+static ACE_THR_FUNC_RETURN
+recorder (void *arg)
+{
+  size_t const id = reinterpret_cast<size_t> (arg);
+  ACE_HDR_Histogram &mine = *thread_histograms[id];
+  for (ACE_UINT64 i = 0; i != n_samples; ++i)
+    {
+      mine.record ((id + 1) * 1000 + i % 1000);
+      shared_atomic.record_atomic (i);
+    }
+
+  // All the threads add into the same total at once.
+  shared_total.add (mine);
+  return 0;
+}
+
+static int
+test_threads ()
+{
+  int status = 0;
+  for (size_t i = 0; i != n_threads; ++i)
+    thread_histograms[i] = new ACE_HDR_Histogram;
+
+  ACE_Thread_Manager tm;
+  for (size_t i = 0; i != n_threads; ++i)
+    if (tm.spawn (recorder, reinterpret_cast<void *> (i)) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("spawn")), 1);
+  tm.wait ();
+
+  status |= check (shared_total.total_count (), n_threads * n_samples, 0,
+                   ACE_TEXT ("merged count"));
+  status |= check (shared_atomic.total_count (), n_threads * n_samples, 0,
+                   ACE_TEXT ("atomic count"));
+  status |= check (shared_total.min (), 1000, 0, ACE_TEXT ("merged min"));
+  status |= check (shared_total.max (), n_threads * 1000 + 999, 0,
+                   ACE_TEXT ("merged max"));
+  status |= check (shared_total.value_at_percentile (50.0), 2999, 3,
+                   ACE_TEXT ("merged p50"));
+
+  for (size_t i = 0; i != n_threads; ++i)
+    delete thread_histograms[i];
+  return status;
+}
+
+static int
+test_encoding ()
+{
+  int status = 0;
+  ACE_HDR_Histogram histogram;
+  ACE_OS::srand (7);
+  for (int i = 0; i != 100000; ++i)
+    histogram.record (10000 + ACE_OS::rand () % 5000 + (i % 1000 == 0 ? 1000000 : 0));
+
+  ACE_OutputCDR out;
+  if (!histogram.encode (out))
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("encode failed\n")), 1);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%Q samples encoded in %B bytes\n"),
+              histogram.total_count (), out.total_length ()));
+
+  ACE_InputCDR in (out);
+  ACE_HDR_Histogram decoded;
+  if (!decoded.decode (in))
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("decode failed\n")), 1);
+
+  static const double percentiles[] = { 0.0, 50.0, 99.0, 99.9, 99.99, 100.0 };
+  for (size_t i = 0; i != sizeof percentiles / sizeof percentiles[0]; ++i)
+    status |= check (decoded.value_at_percentile (percentiles[i]),
+                     histogram.value_at_percentile (percentiles[i]), 0,
+                     ACE_TEXT ("decoded percentile"));
+  status |= check (decoded.total_count (), histogram.total_count (), 0,
+                   ACE_TEXT ("decoded count"));
+  status |= check (decoded.min (), histogram.min (), 0, ACE_TEXT ("decoded min"));
+  status |= check (decoded.max (), histogram.max (), 0, ACE_TEXT ("decoded max"));
+
+  // Into a histogram of another precision, to its precision.
+  ACE_InputCDR again (out);
+  ACE_HDR_Histogram coarse (ACE_UINT64 (1) << 32, 2);
+  if (!coarse.decode (again))
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("decode failed\n")), 1);
+  status |= check (coarse.value_at_percentile (50.0),
+                   histogram.value_at_percentile (50.0),
+                   histogram.value_at_percentile (50.0) / 100,
+                   ACE_TEXT ("coarse p50"));
+
+  // Garbage is refused.
+  ACE_OutputCDR bad;
+  bad.write_ulong (42);
+  ACE_InputCDR bad_in (bad);
+  if (decoded.decode (bad_in))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("decoded garbage\n")));
+      status = 1;
+    }
+  return status;
+}
+
+static int
+test_basic_stats ()
+{
+  int status = 0;
+  ACE_HDR_Histogram h1, h2, total_histogram;
+  ACE_Basic_Stats s1, s2, total;
+  s1.histogram (&h1);
+  s2.histogram (&h2);
+  total.histogram (&total_histogram);
+
+  for (ACE_UINT64 i = 0; i != 1000; ++i)
+    {
+      s1.sample (100 + i);
+      s2.sample (5000 + i);
+    }
+  total.accumulate (s1);
+  total.accumulate (s2);
+
+  status |= check (total_histogram.total_count (), 2000, 0,
+                   ACE_TEXT ("stats count"));
+  status |= check (total_histogram.value_at_percentile (99.0), 5979, 5,
+                   ACE_TEXT ("stats p99"));
+  total.dump_results (ACE_TEXT ("Total"), 1);
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("HDR_Histogram_Test"));
+
+  int status = test_precision ();
+  status |= test_encoding ();
+  status |= test_basic_stats ();
+#if defined (ACE_HAS_THREADS)
+  status |= test_threads ();
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
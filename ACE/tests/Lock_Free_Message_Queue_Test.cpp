@@ -0,0 +1,490 @@
+
+//=============================================================================
+/**
+ *  @file    Lock_Free_Message_Queue_Test.cpp
+ *
+ *    This is a test of ACE_Lock_Free_Message_Queue: FIFO order and
+ *    message counting, the high and low water marks, the bound on the
+ *    number of messages, timeouts, deactivation and pulsing, many
+ *    threads enqueueing and dequeueing at once, and use by an
+ *    ACE_Task.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Lock_Free_Message_Queue_T.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+using LF_QUEUE = ACE_Lock_Free_Message_Queue<ACE_MT_SYNCH>;
+
+static const int n_producers = 4;
+static const int n_consumers = 4;
+static const int n_messages = 50000;
+
+static int
+fifo_test ()
+{
+  int status = 0;
+  LF_QUEUE mq (1024, 1024, 0, 16);
+
+  if (!mq.is_empty () || mq.max_messages () != 16)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("New queue is wrong\n")));
+      status = 1;
+    }
+
+  for (int i = 0; i != 10; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb, ACE_Message_Block (8), 1);
+      *reinterpret_cast<int *> (mb->wr_ptr ()) = i;
+      mb->wr_ptr (sizeof (int));
+      if (mq.enqueue_tail (mb) != i + 1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("Enqueue %d failed\n"), i));
+          status = 1;
+        }
+    }
+
+  // A chain counts as one message per block.
+  ACE_Message_Block *first = 0;
+  ACE_Message_Block *second = 0;
+  ACE_NEW_RETURN (first, ACE_Message_Block (8), 1);
+  ACE_NEW_RETURN (second, ACE_Message_Block (8), 1);
+  *reinterpret_cast<int *> (first->wr_ptr ()) = 10;
+  *reinterpret_cast<int *> (second->wr_ptr ()) = 11;
+  first->wr_ptr (sizeof (int));
+  second->wr_ptr (sizeof (int));
+  first->next (second);
+  mq.enqueue_head (first);
+
+  if (mq.message_count () != 12
+      || mq.message_bytes () != 12 * 8
+      || mq.message_length () != 12 * sizeof (int))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Queue holds %B messages, %B bytes\n"),
+                  mq.message_count (), mq.message_bytes ()));
+      status = 1;
+    }
+
+  for (int i = 0; i != 12; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      if (mq.dequeue_head (mb) != 11 - i)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("Dequeue %d failed\n"), i));
+          status = 1;
+          continue;
+        }
+      int const value = *reinterpret_cast<int *> (mb->rd_ptr ());
+      if (value != i || mb->next () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Dequeued %d, expected %d\n"), value, i));
+          status = 1;
+        }
+      mb->release ();
+    }
+
+  if (!mq.is_empty () || mq.message_bytes () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Queue not empty at end\n")));
+      status = 1;
+    }
+
+  ACE_Message_Block *mb = 0;
+  if (mq.peek_dequeue_head (mb) != -1 || errno != ENOTSUP)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("peek_dequeue_head supported?\n")));
+      status = 1;
+    }
+  return status;
+}
+
+/// Fill a queue of 100 bytes with 40 byte messages.
+static int
+watermark_test ()
+{
+  int status = 0;
+  LF_QUEUE mq (100, 40);
+
+  for (int i = 0; i != 3; ++i)
+    mq.enqueue_tail (new ACE_Message_Block (40));
+
+  if (!mq.is_full ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Queue of %B bytes not full\n"),
+                  mq.message_bytes ()));
+      status = 1;
+    }
+
+  ACE_Time_Value tv (ACE_OS::gettimeofday ());
+  ACE_Message_Block *extra = new ACE_Message_Block (40);
+  if (mq.enqueue_tail (extra, &tv) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Enqueue to full queue did not time out\n")));
+      status = 1;
+    }
+
+  // A new enqueuer gets in as soon as the queue is below the high
+  // water mark.
+  ACE_Message_Block *mb = 0;
+  mq.dequeue_head (mb);
+  mb->release ();
+  tv = ACE_OS::gettimeofday () + ACE_Time_Value (5);
+  if (mq.enqueue_tail (extra, &tv) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("Enqueue below the high water mark")));
+      extra->release ();
+      status = 1;
+    }
+
+  // Too many messages, whatever their size.
+  LF_QUEUE small (1024 * 1024, 1024 * 1024, 0, 4);
+  for (int i = 0; i != 4; ++i)
+    small.enqueue_tail (new ACE_Message_Block (1));
+  tv = ACE_OS::gettimeofday ();
+  extra = new ACE_Message_Block (1);
+  if (small.enqueue_tail (extra, &tv) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Enqueue to queue without slots did not ")
+                  ACE_TEXT ("time out\n")));
+      status = 1;
+    }
+  extra->release ();
+  return status;
+}
+
+static ACE_THR_FUNC_RETURN
+blocked_enqueuer (void *arg)
+{
+  LF_QUEUE *mq = static_cast<LF_QUEUE *> (arg);
+  ACE_Message_Block *mb = new ACE_Message_Block (40);
+  if (mq->enqueue_tail (mb) == -1)
+    mb->release ();
+  return 0;
+}
+
+/// A blocked enqueuer must wait until the low water mark is reached.
+static int
+low_water_mark_test ()
+{
+  int status = 0;
+  LF_QUEUE mq (100, 40);
+  for (int i = 0; i != 3; ++i)
+    mq.enqueue_tail (new ACE_Message_Block (40));
+
+  ACE_Thread_Manager::instance ()->spawn (blocked_enqueuer, &mq);
+  ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+  ACE_Message_Block *mb = 0;
+  mq.dequeue_head (mb);
+  mb->release ();
+  ACE_OS::sleep (ACE_Time_Value (0, 100000));
+  if (mq.message_count () != 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Enqueuer woken up above the low water mark\n")));
+      status = 1;
+    }
+
+  mq.dequeue_head (mb);
+  mb->release ();
+  ACE_Thread_Manager::instance ()->wait ();
+  if (mq.message_count () != 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Enqueuer not woken up at the low water mark\n")));
+      status = 1;
+    }
+  return status;
+}
+
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> shutdowns (0);
+
+static ACE_THR_FUNC_RETURN
+blocked_dequeuer (void *arg)
+{
+  LF_QUEUE *mq = static_cast<LF_QUEUE *> (arg);
+  ACE_Message_Block *mb = 0;
+  if (mq->dequeue_head (mb) == -1 && errno == ESHUTDOWN)
+    ++shutdowns;
+  return 0;
+}
+
+/// pulse() and deactivate() must wake up the waiting threads.
+static int
+deactivate_test ()
+{
+  int status = 0;
+  LF_QUEUE mq;
+
+  ACE_Time_Value tv (ACE_OS::gettimeofday ());
+  ACE_Message_Block *mb = 0;
+  if (mq.dequeue_head (mb, &tv) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Dequeue from empty queue did not time out\n")));
+      status = 1;
+    }
+
+  for (int i = 0; i != 2; ++i)
+    {
+      ACE_Thread_Manager::instance ()->spawn_n (2, blocked_dequeuer, &mq);
+      ACE_OS::sleep (ACE_Time_Value (0, 100000));
+      if (i == 0)
+        mq.pulse ();
+      else
+        mq.deactivate ();
+
+      ACE_Thread_Manager::instance ()->wait ();
+    }
+
+  if (shutdowns.value () != 4)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d of 4 dequeuers woken up with ESHUTDOWN\n"),
+                  static_cast<int> (shutdowns.value ())));
+      status = 1;
+    }
+
+  if (!mq.deactivated ()
+      || mq.enqueue_tail (new ACE_Message_Block (1)) != -1
+      || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Deactivated queue accepts messages\n")));
+      status = 1;
+    }
+
+  mq.activate ();
+  if (mq.enqueue_tail (new ACE_Message_Block (1)) != 1
+      || mq.close () != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Reactivated queue does not work\n")));
+      status = 1;
+    }
+  return status;
+}
+
+struct Stress
+{
+  LF_QUEUE queue;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> producer_id;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> received;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> errors;
+
+  Stress ()
+    : queue (64 * 1024, 32 * 1024, 0, 256),
+      producer_id (0),
+      received (0),
+      errors (0)
+  {
+  }
+};
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  Stress *stress = static_cast<Stress *> (arg);
+  int const id = static_cast<int> (stress->producer_id++);
+  for (int i = 0; i != n_messages; ++i)
+    {
+      ACE_Message_Block *mb = new ACE_Message_Block (2 * sizeof (int));
+      int *data = reinterpret_cast<int *> (mb->wr_ptr ());
+      data[0] = id;
+      data[1] = i;
+      mb->wr_ptr (2 * sizeof (int));
+      if (stress->queue.enqueue_tail (mb) == -1)
+        {
+          ++stress->errors;
+          mb->release ();
+        }
+    }
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  Stress *stress = static_cast<Stress *> (arg);
+
+  // Messages from one producer must reach every consumer in order.
+  int last[n_producers];
+  for (int i = 0; i != n_producers; ++i)
+    last[i] = -1;
+
+  for (;;)
+    {
+      ACE_Message_Block *mb = 0;
+      if (stress->queue.dequeue_head (mb) == -1)
+        break;
+      if (mb->msg_type () == ACE_Message_Block::MB_HANGUP)
+        {
+          mb->release ();
+          break;
+        }
+      int const *data = reinterpret_cast<int *> (mb->rd_ptr ());
+      if (data[0] < 0 || data[0] >= n_producers || data[1] <= last[data[0]])
+        ++stress->errors;
+      else
+        last[data[0]] = data[1];
+      ++stress->received;
+      mb->release ();
+    }
+  return 0;
+}
+
+static int
+stress_test ()
+{
+  Stress stress;
+  ACE_Thread_Manager consumers;
+  ACE_Thread_Manager producers;
+  if (consumers.spawn_n (n_consumers, consumer, &stress) == -1
+      || producers.spawn_n (n_producers, producer, &stress) == -1)
+    return 1;
+
+  // The consumers stop at the hangup messages queued after the
+  // producers are done.
+  producers.wait ();
+  for (int i = 0; i != n_consumers; ++i)
+    stress.queue.enqueue_tail
+      (new ACE_Message_Block (0, ACE_Message_Block::MB_HANGUP));
+  consumers.wait ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d producers, %d consumers: %d messages received\n"),
+              n_producers, n_consumers,
+              static_cast<int> (stress.received.value ())));
+
+  if (stress.received.value () != long (n_producers) * n_messages
+      || stress.errors.value () != 0
+      || !stress.queue.is_empty ()
+      || stress.queue.message_bytes () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Received %d of %d messages, %d errors\n"),
+                  static_cast<int> (stress.received.value ()),
+                  n_producers * n_messages,
+                  static_cast<int> (stress.errors.value ())));
+      return 1;
+    }
+  return 0;
+}
+
+/// An ACE_Task whose svc() thread drains the queue.
+class Counter_Task : public ACE_Task<ACE_MT_SYNCH>
+{
+public:
+  Counter_Task (LF_QUEUE *mq)
+    : ACE_Task<ACE_MT_SYNCH> (0, mq),
+      count_ (0)
+  {
+  }
+
+  int svc () override
+  {
+    ACE_Message_Block *mb = 0;
+    while (this->getq (mb) != -1)
+      {
+        bool const hangup = mb->msg_type () == ACE_Message_Block::MB_HANGUP;
+        mb->release ();
+        if (hangup)
+          break;
+        ++this->count_;
+      }
+    return 0;
+  }
+
+  int count_;
+};
+
+static int
+task_test ()
+{
+  LF_QUEUE mq;
+  Counter_Task task (&mq);
+  task.activate ();
+  for (int i = 0; i != 1000; ++i)
+    task.putq (new ACE_Message_Block (16));
+  task.putq (new ACE_Message_Block (0, ACE_Message_Block::MB_HANGUP));
+  task.wait ();
+
+  if (task.count_ != 1000)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Task received %d of 1000 messages\n"),
+                  task.count_));
+      return 1;
+    }
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Lock_Free_Message_Queue_Test"));
+
+  int status = 0;
+  if (fifo_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("FIFO test failed\n")));
+      status = 1;
+    }
+  if (watermark_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Watermark test failed\n")));
+      status = 1;
+    }
+  if (low_water_mark_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Low water mark test failed\n")));
+      status = 1;
+    }
+  if (deactivate_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Deactivate test failed\n")));
+      status = 1;
+    }
+  if (stress_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Stress test failed\n")));
+      status = 1;
+    }
+  if (task_test () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Task test failed\n")));
+      status = 1;
+    }
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Lock_Free_Message_Queue_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,411 @@
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *   This program tests ACE_Log_Msg_Async: messages logged while
+ *   asynchronous logging is open must read the same as when they are
+ *   formatted by the logging thread, none may be lost when many
+ *   threads log at once, the binary file must read back the same
+ *   messages, and a message logged in a category by a thread that
+ *   exits before it is written must still carry that category.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#include "ace/Log_Category.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Msg_Backend.h"
+#include "ace/Log_Msg_Callback.h"
+#include "ace/Log_Record.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Guard_T.h"
+#include "ace/SString.h"
+#include "ace/Vector_T.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/os_signal.h"
+
+#if defined (ACE_HAS_LOG_MSG_ASYNC)
+
+static const int n_threads = 4;
+static const int n_messages = 2000;
+
+/// Keeps the messages that reach the custom backend.  The
+/// asynchronous messages are only written to the sinks shared by all
+/// threads.
+class Collector : public ACE_Log_Msg_Backend
+{
+public:
+  int open (const ACE_TCHAR *) override { return 0; }
+  int reset () override { return 0; }
+  int close () override { return 0; }
+
+  ssize_t log (ACE_Log_Record &log_record) override
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+    this->messages_.push_back (ACE_TString (log_record.msg_data ()));
+    ACE_Log_Category_TSS *const category = log_record.category ();
+    this->categories_.push_back
+      (category == 0 ? ACE_CString () : ACE_CString (category->name ()));
+    this->category_ids_.push_back (category == 0 ? 0 : category->id ());
+    return 0;
+  }
+
+  size_t size ()
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, 0);
+    return this->messages_.size ();
+  }
+
+  ACE_TString take (size_t i)
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, ACE_TString ());
+    return this->messages_[i];
+  }
+
+  ACE_CString category (size_t i)
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, ACE_CString ());
+    return this->categories_[i];
+  }
+
+  unsigned int category_id (size_t i)
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, 0);
+    return this->category_ids_[i];
+  }
+
+  void clear ()
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+    this->messages_.clear ();
+    this->categories_.clear ();
+    this->category_ids_.clear ();
+  }
+
+private:
+  ACE_Thread_Mutex lock_;
+  ACE_Vector<ACE_TString> messages_;
+  ACE_Vector<ACE_CString> categories_;
+  ACE_Vector<unsigned int> category_ids_;
+};
+
+/// Set by a thread to see its own messages, which makes them
+/// synchronous.
+class Thread_Callback : public ACE_Log_Msg_Callback
+{
+public:
+  void log (ACE_Log_Record &) override {}
+};
+
+static Collector collector;
+static Thread_Callback thread_callback;
+static ACE_Log_Category short_lived_category ("Short_Lived");
+
+/// Log one message using most of the directives ACE_Log_Msg knows.
+/// The same calls are made synchronously and asynchronously.
+static void
+log_samples ()
+{
+  ACE_Time_Value const tv (1234567890, 123456);
+  errno = ENOENT;
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("ints %d %5i %-4u|%x %X %o %*d\n"),
+              -42, 7, 3u, 255, 255, 8, 6, 99));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("floats %f %.2e %g %A\n"),
+              3.25, 12345.678, 0.5, 1.5));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("strings [%s] [%-8s] [%C] [%s] %c%c\n"),
+              ACE_TEXT ("abc"), ACE_TEXT ("left"), "narrow",
+              static_cast<const ACE_TCHAR *> (0), 'o', 'k'));
+  ACE_DEBUG ((LM_NOTICE,
+              ACE_TEXT ("wide ints %Q %q %B %b %: %@\n"),
+              ACE_UINT64 (18446744073709551615ULL),
+              ACE_INT64 (-9223372036854775807LL),
+              size_t (4096), ssize_t (-1),
+              time_t (1700000000), (void *) &tv));
+  ACE_ERROR ((LM_WARNING,
+              ACE_TEXT ("context %M %.1M %N:%l pid %P thread %t\n")));
+  errno = EACCES;
+  ACE_ERROR ((LM_ERROR, ACE_TEXT ("errors %p; %m\n"), ACE_TEXT ("open")));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("time %#T date %#D signal %S status %R 100%%\n"),
+              &tv, &tv, SIGINT, -1));
+}
+
+static const size_t n_samples = 7;
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  int const id = static_cast<int> (reinterpret_cast<intptr_t> (arg));
+  for (int i = 0; i != n_messages; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("worker %d message %d\n"), id, i));
+  return 0;
+}
+
+/// Every worker's messages must all be there, in the order it logged
+/// them.
+static int
+check_workers ()
+{
+  int status = 0;
+  int next[n_threads] = { 0 };
+  size_t const n = collector.size ();
+  for (size_t i = 0; i != n; ++i)
+    {
+      ACE_TString const msg = collector.take (i);
+      const ACE_TCHAR *prefix = ACE_TEXT ("worker ");
+      if (msg.find (prefix) != 0)
+        continue;
+      ACE_TCHAR *end = 0;
+      long const id =
+        ACE_OS::strtol (msg.c_str () + ACE_OS::strlen (prefix), &end, 10);
+      int const seq =
+        ACE_OS::atoi (end + ACE_OS::strlen (ACE_TEXT (" message ")));
+      if (id < 0 || id >= n_threads)
+        continue;
+      if (seq != next[id])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("worker %d: message %d, expected %d\n"),
+                      static_cast<int> (id), seq, next[id]));
+          status = 1;
+        }
+      next[id] = seq + 1;
+    }
+  for (int id = 0; id != n_threads; ++id)
+    if (next[id] != n_messages)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("worker %d: %d of %d messages written\n"),
+                    id, next[id], n_messages));
+        status = 1;
+      }
+  return status;
+}
+
+static int
+compare (const ACE_Array<ACE_TString> &expected, const ACE_TCHAR *what)
+{
+  int status = 0;
+  if (collector.size () != expected.size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B messages, expected %B\n"),
+                  what, collector.size (), expected.size ()));
+      return 1;
+    }
+  for (size_t i = 0; i != expected.size (); ++i)
+    {
+      ACE_TString const got = collector.take (i);
+      if (got != expected[i])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: got <%s> expected <%s>\n"),
+                      what, got.c_str (), expected[i].c_str ()));
+          status = 1;
+        }
+    }
+  return status;
+}
+
+/// Logs in a category and exits, which frees the category's thread
+/// specific object, before the background thread writes the message.
+static ACE_THR_FUNC_RETURN
+short_lived (void *)
+{
+  short_lived_category.per_thr_obj ()->log
+    (LM_INFO, ACE_TEXT ("logged by a thread that is gone\n"));
+  return 0;
+}
+
+static int
+check_short_lived ()
+{
+  if (collector.size () != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("short lived thread: %B messages, expected 1\n"),
+                  collector.size ()));
+      return 1;
+    }
+  if (collector.take (0) != ACE_TEXT ("logged by a thread that is gone\n")
+      || collector.category (0) != "Short_Lived"
+      || collector.category_id (0) != short_lived_category.id ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("short lived thread: got <%s> in <%C> %u\n"),
+                  collector.take (0).c_str (),
+                  collector.category (0).c_str (),
+                  collector.category_id (0)));
+      return 1;
+    }
+  return 0;
+}
+
+/// A thread that set an ostream or a callback logs synchronously.
+static int
+check_thread_sinks (ACE_Log_Msg_Async *async, ACE_OSTREAM_TYPE *ostream)
+{
+  int status = 0;
+  for (int i = 0; i != 2; ++i)
+    {
+      const ACE_TCHAR *const sink =
+        i == 0 ? ACE_TEXT ("ostream") : ACE_TEXT ("callback");
+      if (i == 0)
+        ACE_LOG_MSG->msg_ostream (ostream);
+      else
+        ACE_LOG_MSG->msg_callback (&thread_callback);
+      unsigned long const captured = async->captured ();
+      ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("with a thread %s\n"), sink));
+      bool const sync =
+        collector.size () == 1 && async->captured () == captured;
+      ACE_LOG_MSG->msg_ostream (0);
+      ACE_LOG_MSG->msg_callback (0);
+      if (!sync)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("message with a thread %s was not ")
+                      ACE_TEXT ("written synchronously\n"),
+                      sink));
+          status = 1;
+        }
+      async->flush ();
+      collector.clear ();
+    }
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+  u_long const flags = ACE_LOG_MSG->flags ();
+  ACE_Log_Msg_Backend *const backend = ACE_Log_Msg::msg_backend (&collector);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::CUSTOM | ACE_Log_Msg::MSG_CALLBACK);
+  // A thread with an ostream never logs asynchronously, the threads
+  // spawned below inherit none.
+  ACE_OSTREAM_TYPE *const ostream = ACE_LOG_MSG->msg_ostream ();
+  ACE_LOG_MSG->msg_ostream (0);
+
+  // Formatted by this thread.
+  log_samples ();
+  ACE_Array<ACE_TString> expected (n_samples);
+  for (size_t i = 0; i != n_samples && i != collector.size (); ++i)
+    expected[i] = collector.take (i);
+  if (collector.size () != n_samples)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%B samples, expected %B\n"),
+                  collector.size (), n_samples));
+      status = 1;
+    }
+  collector.clear ();
+
+  // Formatted by the background thread.
+  ACE_Log_Msg_Async *async = ACE_Log_Msg_Async::instance ();
+  if (async->open () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")));
+      ACE_END_TEST;
+      return 1;
+    }
+  unsigned long const captured = async->captured ();
+  log_samples ();
+  async->flush ();
+  status |= compare (expected, ACE_TEXT ("async"));
+  if (async->captured () - captured != n_samples)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%lu of %B samples were asynchronous\n"),
+                  async->captured () - captured, n_samples));
+      status = 1;
+    }
+  collector.clear ();
+
+  status |= check_thread_sinks (async, ostream);
+
+  // Idle long enough for the thread to be gone before its message
+  // is written.
+  async->close ();
+  async->open (ACE_LOG_MSG_ASYNC_RING_SIZE, 0, ACE_Time_Value (1));
+  ACE_Thread_Manager::instance ()->spawn (short_lived);
+  ACE_Thread_Manager::instance ()->wait ();
+  async->flush ();
+  status |= check_short_lived ();
+  collector.clear ();
+
+  // Many threads at once, with buffers small enough to fill up.
+  async->close ();
+  async->open (1024);
+  for (intptr_t i = 0; i != n_threads; ++i)
+    ACE_Thread_Manager::instance ()->spawn (worker,
+                                            reinterpret_cast<void *> (i));
+  ACE_Thread_Manager::instance ()->wait ();
+  async->close ();
+  status |= check_workers ();
+  collector.clear ();
+
+  // The binary file is not formatted until it is read.
+  const ACE_TCHAR *file = ACE_TEXT ("log/Log_Msg_Async_Test.bin");
+  if (async->open (ACE_LOG_MSG_ASYNC_RING_SIZE, file) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), file));
+      status = 1;
+    }
+  else
+    {
+      log_samples ();
+      async->close ();
+      if (collector.size () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("binary file messages reached the sinks\n")));
+          status = 1;
+        }
+
+      ACE_Log_Msg_Async_Reader reader;
+      if (reader.open (file) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), file));
+          status = 1;
+        }
+      else
+        {
+          ACE_Log_Record record;
+          while (reader.next (record) == 1)
+            collector.log (record);
+          status |= compare (expected, ACE_TEXT ("binary"));
+        }
+      ACE_OS::unlink (file);
+    }
+
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM | ACE_Log_Msg::MSG_CALLBACK);
+  ACE_LOG_MSG->set_flags (flags);
+  ACE_Log_Msg::msg_backend (backend);
+  ACE_LOG_MSG->msg_ostream (ostream);
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("Asynchronous logging is not available\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_LOG_MSG_ASYNC */
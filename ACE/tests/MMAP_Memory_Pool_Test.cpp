@@ -0,0 +1,174 @@
+
+//=============================================================================
+/**
+ *  @file    MMAP_Memory_Pool_Test.cpp
+ *
+ *    This test checks the huge page, prefault and NUMA options of
+ *    <ACE_MMAP_Memory_Pool>: an <ACE_Malloc> heap using them must
+ *    grow and keep its contents like one without them, and a
+ *    HUGETLB_PAGES pool must refuse a backing store outside hugetlbfs.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Malloc_T.h"
+#include "ace/MMAP_Memory_Pool.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Lib_Find.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+#if !defined (ACE_LACKS_MMAP)
+
+using MALLOC = ACE_Malloc<ACE_MMAP_MEMORY_POOL, ACE_Null_Mutex>;
+
+static const size_t CHUNK = 256 * 1024;
+static const size_t CHUNKS = 16;
+
+// Large enough for all the chunks: growing a pool in place can map
+// over whatever the system put right after it.
+static const size_t POOL_SIZE = 2 * CHUNK * CHUNKS;
+
+/// Fill a heap made with @a options, then check every chunk.
+static int
+test_pool (const ACE_TCHAR *name,
+           const ACE_MMAP_Memory_Pool_Options &options,
+           const ACE_TCHAR *what)
+{
+  ACE_OS::unlink (name);
+  int status = 0;
+  {
+    MALLOC heap (name, 0, &options);
+    if (heap.bad ())
+      {
+        // A kernel without NUMA support cannot bind.
+        if (options.numa_node_ >= 0 && (errno == ENOSYS || errno == ENOTSUP))
+          {
+            ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("%s: no NUMA support\n"), what));
+            ACE_OS::unlink (name);
+            return 0;
+          }
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%s: %p\n"), what,
+                           ACE_TEXT ("heap")),
+                          1);
+      }
+
+    char *chunks[CHUNKS];
+    for (size_t i = 0; i != CHUNKS; ++i)
+      {
+        chunks[i] = static_cast<char *> (heap.malloc (CHUNK));
+        if (chunks[i] == 0)
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%s: %p\n"), what,
+                             ACE_TEXT ("malloc")),
+                            1);
+        ACE_OS::memset (chunks[i], static_cast<int> ('a' + i), CHUNK);
+      }
+
+    for (size_t i = 0; i != CHUNKS; ++i)
+      if (chunks[i][0] != static_cast<char> ('a' + i)
+          || chunks[i][CHUNK - 1] != static_cast<char> ('a' + i))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%s: chunk %B changed\n"),
+                      what, i));
+          status = 1;
+        }
+    heap.remove ();
+  }
+  ACE_OS::unlink (name);
+  return status;
+}
+
+static int
+test_hugetlb_refused (const ACE_TCHAR *name)
+{
+  ACE_OS::unlink (name);
+  ACE_MMAP_Memory_Pool_Options options
+    (0,
+     ACE_MMAP_Memory_Pool_Options::NEVER_FIXED,
+     true, 0, 0, true, 0, ACE_DEFAULT_FILE_PERMS, false, true,
+     ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES);
+  ACE_MMAP_Memory_Pool pool (name, &options);
+
+  // The failure is logged, which is expected here.
+  u_long const mask =
+    ACE_LOG_MSG->priority_mask (ACE_Log_Msg::PROCESS);
+  ACE_LOG_MSG->priority_mask (mask & ~LM_ERROR, ACE_Log_Msg::PROCESS);
+
+  size_t rounded = 0;
+  int first_time = 0;
+  void *const base = pool.init_acquire (1024, rounded, first_time);
+
+  ACE_LOG_MSG->priority_mask (mask, ACE_Log_Msg::PROCESS);
+
+  int status = 0;
+  if (base != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("HUGETLB_PAGES pool outside hugetlbfs\n")));
+      status = 1;
+    }
+  if (ACE_OS::access (name, F_OK) == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("refused backing store left behind\n")));
+      status = 1;
+    }
+  pool.release ();
+  ACE_OS::unlink (name);
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MMAP_Memory_Pool_Test"));
+
+  ACE_TCHAR name[MAXPATHLEN];
+  if (ACE::get_temp_dir (name, MAXPATHLEN - 32) == -1)
+    name[0] = 0;
+  ACE_OS::strcat (name, ACE_TEXT ("MMAP_Memory_Pool_Test"));
+
+  int status = 0;
+
+  ACE_MMAP_Memory_Pool_Options plain
+    (0, ACE_MMAP_Memory_Pool_Options::FIRSTCALL_FIXED, false, POOL_SIZE);
+  status |= test_pool (name, plain, ACE_TEXT ("default pages"));
+
+  ACE_MMAP_Memory_Pool_Options advised
+    (0,
+     ACE_MMAP_Memory_Pool_Options::FIRSTCALL_FIXED,
+     false, POOL_SIZE, 0, true, 0, ACE_DEFAULT_FILE_PERMS, false, true,
+     ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES,
+     true);
+  status |= test_pool (name, advised, ACE_TEXT ("prefaulted huge pages"));
+
+  ACE_MMAP_Memory_Pool_Options bound
+    (0,
+     ACE_MMAP_Memory_Pool_Options::FIRSTCALL_FIXED,
+     false, POOL_SIZE, 0, true, 0, ACE_DEFAULT_FILE_PERMS, false, true,
+     ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES,
+     true,
+     0);
+  status |= test_pool (name, bound, ACE_TEXT ("NUMA node 0"));
+
+  status |= test_hugetlb_refused (name);
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MMAP_Memory_Pool_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("mmap is not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* !ACE_LACKS_MMAP */
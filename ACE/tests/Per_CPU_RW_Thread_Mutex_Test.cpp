@@ -0,0 +1,271 @@
+
+//=============================================================================
+/**
+ *  @file    Per_CPU_RW_Thread_Mutex_Test.cpp
+ *
+ *    This test checks <ACE_Per_CPU_RW_Thread_Mutex>: readers must
+ *    share the lock, writers must hold it alone, the try methods must
+ *    fail with EBUSY instead of blocking, and the lock must work
+ *    through <ACE_Lock_Adapter>.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Per_CPU_RW_Thread_Mutex.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Guard_T.h"
+#include "ace/Lock_Adapter_T.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_stdlib.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#include <atomic>
+
+static size_t n_readers = 6;
+static size_t n_writers = 2;
+static size_t n_iterations = 20000;
+
+static ACE_Per_CPU_RW_Thread_Mutex rw_mutex;
+
+// Threads inside the lock.
+static std::atomic<long> current_readers (0);
+static std::atomic<long> current_writers (0);
+
+// Written by writers only, read by readers.
+static size_t shared_data[2];
+
+static std::atomic<long> errors (0);
+
+static ACE_THR_FUNC_RETURN
+reader (void *)
+{
+  for (size_t i = 0; i != n_iterations; ++i)
+    {
+      ACE_READ_GUARD_RETURN (ACE_Per_CPU_RW_Thread_Mutex, g, rw_mutex, 0);
+      ++current_readers;
+      if (current_writers.load () != 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) reader found a writer\n")));
+          ++errors;
+        }
+      if (shared_data[0] != shared_data[1])
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) reader saw a torn write\n")));
+          ++errors;
+        }
+      --current_readers;
+    }
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+writer (void *)
+{
+  for (size_t i = 0; i != n_iterations / 10; ++i)
+    {
+      ACE_WRITE_GUARD_RETURN (ACE_Per_CPU_RW_Thread_Mutex, g, rw_mutex, 0);
+      if (++current_writers != 1 || current_readers.load () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) writer is not alone\n")));
+          ++errors;
+        }
+      ++shared_data[0];
+      ACE_Thread::yield ();
+      ++shared_data[1];
+      --current_writers;
+    }
+  return 0;
+}
+
+// Readers that try to upgrade now and then.
+static ACE_THR_FUNC_RETURN
+upgrader (void *)
+{
+  for (size_t i = 0; i != n_iterations / 10; ++i)
+    {
+      if (rw_mutex.acquire_read () == -1)
+        {
+          ++errors;
+          break;
+        }
+      ++current_readers;
+      if (current_writers.load () != 0)
+        ++errors;
+      --current_readers;
+
+      if (rw_mutex.tryacquire_write_upgrade () == 0)
+        {
+          if (++current_writers != 1 || current_readers.load () != 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) upgraded writer is not alone\n")));
+              ++errors;
+            }
+          ++shared_data[0];
+          ++shared_data[1];
+          --current_writers;
+        }
+      else if (errno != EBUSY)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("tryacquire_write_upgrade")));
+          ++errors;
+        }
+      rw_mutex.release ();
+    }
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+try_write (void *)
+{
+  if (rw_mutex.tryacquire_write () != -1 || errno != EBUSY)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("tryacquire_write with a reader inside\n")));
+      ++errors;
+    }
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+try_read (void *)
+{
+  if (rw_mutex.tryacquire_read () != -1 || errno != EBUSY)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("tryacquire_read with a writer inside\n")));
+      ++errors;
+    }
+  return 0;
+}
+
+/// Run @a func in another thread, since the lock is not recursive.
+static void
+in_thread (ACE_THR_FUNC func)
+{
+  ACE_Thread_Manager tm;
+  tm.spawn (func);
+  tm.wait ();
+}
+
+static int
+test_try ()
+{
+  int status = 0;
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("%B reader counters\n"),
+              rw_mutex.slots ()));
+
+  if (rw_mutex.tryacquire_read () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("tryacquire_read")), 1);
+  in_thread (try_write);
+
+  // We are the only reader, so the upgrade must succeed.
+  if (rw_mutex.tryacquire_write_upgrade () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("tryacquire_write_upgrade")));
+      status = 1;
+    }
+  else
+    in_thread (try_read);
+  rw_mutex.release ();
+
+  if (rw_mutex.tryacquire_write () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("tryacquire_write")), 1);
+  in_thread (try_read);
+  in_thread (try_write);
+  rw_mutex.release ();
+
+  // Through the polymorphic interface.
+  ACE_Lock_Adapter<ACE_Per_CPU_RW_Thread_Mutex> adapter (rw_mutex);
+  ACE_Lock &lock = adapter;
+  if (lock.acquire_read () != 0 || lock.release () != 0
+      || lock.acquire_write () != 0 || lock.release () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("ACE_Lock")));
+      status = 1;
+    }
+  return status;
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("r:w:n:"));
+  int c;
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'r':
+        n_readers = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'w':
+        n_writers = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'n':
+        n_iterations = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-r n_readers] ")
+                           ACE_TEXT ("[-w n_writers] [-n iterations]\n"),
+                           argv[0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+run_main (int argc, ACE_TCHAR *argv[])
+{
+  ACE_START_TEST (ACE_TEXT ("Per_CPU_RW_Thread_Mutex_Test"));
+
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  int status = test_try ();
+
+  ACE_Thread_Manager *const tm = ACE_Thread_Manager::instance ();
+  if (tm->spawn_n (n_readers, reader) == -1
+      || tm->spawn_n (n_writers, writer) == -1
+      || tm->spawn_n (2, upgrader) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("spawn_n")), 1);
+  tm->wait ();
+
+  if (shared_data[0] != shared_data[1])
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("lost a write\n")));
+      status = 1;
+    }
+  if (errors.load () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%d errors\n"),
+                  static_cast<int> (errors.load ())));
+      status = 1;
+    }
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Per_CPU_RW_Thread_Mutex_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
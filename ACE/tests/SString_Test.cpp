@@ -16,6 +16,8 @@
 #include "ace/OS_NS_string.h"
 #include "ace/Auto_Ptr.h"
 #include "ace/SString.h"
+#include "ace/Malloc_Allocator.h"
+#include <utility>
 
 
 
@@ -155,6 +157,172 @@ int testConstIterator()
 }
 
 
+/// Counts the blocks it hands out, to see which strings are inline.
+class Counting_Allocator : public ACE_New_Allocator
+{
+public:
+  Counting_Allocator () : mallocs_ (0) {}
+
+  void *malloc (size_t nbytes) override
+  {
+    ++this->mallocs_;
+    return this->ACE_New_Allocator::malloc (nbytes);
+  }
+
+  size_t mallocs_;
+};
+
+static int testSmallString ()
+{
+  Counting_Allocator alloc;
+  int err = 0;
+  {
+    ACE_CString s1 ("short", &alloc);
+    ACE_CString s2 (s1);
+    s2 += " too";
+    if (alloc.mallocs_ != 0 || s2 != "short too")
+      {
+        ACE_ERROR ((LM_ERROR, "Short strings used %B blocks\n", alloc.mallocs_));
+        ++err;
+      }
+
+    // Growing past the inline buffer moves the characters to the heap,
+    // and back when assigned a short string.
+    ACE_CString long_str ("a string too long for the inline buffer", &alloc);
+    s1 += long_str;
+    if (alloc.mallocs_ != 2
+        || s1 != "shorta string too long for the inline buffer")
+      {
+        ACE_ERROR ((LM_ERROR, "Long strings used %B blocks\n", alloc.mallocs_));
+        ++err;
+      }
+    s1 = s2;
+    s1 += s1;
+    if (s1 != "short tooshort too")
+      {
+        ACE_ERROR ((LM_ERROR, "Appending to itself\n"));
+        ++err;
+      }
+
+    // A swap must carry the inline characters along.
+    s2.swap (long_str);
+    if (s2 != "a string too long for the inline buffer"
+        || long_str != "short too"
+        || long_str.c_str () == s2.c_str ())
+      {
+        ACE_ERROR ((LM_ERROR, "Swap of inline and heap strings\n"));
+        ++err;
+      }
+  }
+  return err;
+}
+
+static int testMove ()
+{
+  Counting_Allocator alloc;
+  int err = 0;
+
+  ACE_CString long_str ("a string too long for the inline buffer", &alloc);
+  const char *buf = long_str.c_str ();
+  ACE_CString moved (std::move (long_str));
+  if (moved.c_str () != buf || !long_str.empty () || alloc.mallocs_ != 1)
+    {
+      ACE_ERROR ((LM_ERROR, "Move construction copied\n"));
+      ++err;
+    }
+
+  ACE_CString target ("x", &alloc);
+  target = std::move (moved);
+  if (target.c_str () != buf || !moved.empty () || alloc.mallocs_ != 1)
+    {
+      ACE_ERROR ((LM_ERROR, "Move assignment copied\n"));
+      ++err;
+    }
+
+  ACE_CString short_str ("short");
+  ACE_CString moved_short (std::move (short_str));
+  if (moved_short != "short" || !short_str.empty ())
+    {
+      ACE_ERROR ((LM_ERROR, "Move of a short string\n"));
+      ++err;
+    }
+
+  // Moving a string that does not own its buffer copies it.
+  char chars[] = "not owned";
+  ACE_CString not_owned (chars, 0, false);
+  ACE_CString copy (std::move (not_owned));
+  if (copy.c_str () == chars || copy != "not owned")
+    {
+      ACE_ERROR ((LM_ERROR, "Move of a string not owning its buffer\n"));
+      ++err;
+    }
+  return err;
+}
+
+/// Takes any kind of string without building an ACE_CString.
+static size_t count_dots (ACE_CString_View s)
+{
+  size_t n = 0;
+  for (ACE_CString_View::size_type pos = s.find ('.');
+       pos != ACE_CString_View::npos;
+       pos = s.find ('.', pos + 1))
+    ++n;
+  return n;
+}
+
+static int testView ()
+{
+  int err = 0;
+  ACE_CString host ("www.example.com");
+  if (count_dots (host) != 2 || count_dots ("a.b") != 1 || count_dots (0) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, "View conversions\n"));
+      ++err;
+    }
+
+  ACE_CString_View v (host);
+  ACE_CString_View domain = v.substr (v.find ('.') + 1);
+  if (domain != ACE_CString_View ("example.com")
+      || domain.find ("com") != 8
+      || domain.find ("org") != ACE_CString_View::npos
+      || v.substr (100).length () != 0
+      || v.substr (4, 7) != ACE_CString_View ("example")
+      || !(v.substr (4, 7) < domain)
+      || domain.compare (ACE_CString_View ("example")) <= 0
+      || domain.hash () != ACE_CString ("example.com").hash ())
+    {
+      ACE_ERROR ((LM_ERROR, "View operations\n"));
+      ++err;
+    }
+
+  ACE_CString copy (domain);
+  copy += v.substr (0, 4);
+  if (copy != "example.comwww." || host.view () != v)
+    {
+      ACE_ERROR ((LM_ERROR, "String from a view\n"));
+      ++err;
+    }
+
+  // Assigning a part of a string to itself.
+  host = domain;
+  if (host != "example.com")
+    {
+      ACE_ERROR ((LM_ERROR, "Assignment of a view of the same string\n"));
+      ++err;
+    }
+
+#if defined (ACE_HAS_CPP17)
+  std::string_view sv = host.view ();
+  ACE_CString_View back (sv);
+  if (sv.size () != host.length () || back != host)
+    {
+      ACE_ERROR ((LM_ERROR, "std::string_view conversions\n"));
+      ++err;
+    }
+#endif /* ACE_HAS_CPP17 */
+  return err;
+}
+
 int
 run_main (int, ACE_TCHAR *[])
 {
@@ -430,6 +598,9 @@ run_main (int, ACE_TCHAR *[])
   int err = testConcatenation ();
   err += testIterator ();
   err += testConstIterator ();
+  err += testSmallString ();
+  err += testMove ();
+  err += testView ();
 
   ACE_END_TEST;
   return err;
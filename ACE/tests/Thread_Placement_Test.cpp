@@ -0,0 +1,275 @@
+
+//=============================================================================
+/**
+ *  @file    Thread_Placement_Test.cpp
+ *
+ *   This program tests ACE_Thread_Placement: CPU lists must parse to
+ *   the expected sets, and the threads spawned by ACE_Thread_Manager
+ *   and ACE_Task_Base with a placement must run on their CPUs.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#include "ace/Thread_Placement.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_Thread.h"
+
+/// Compare the CPUs of @a placement with @a expected, a list of CPU
+/// numbers ending with -1.
+static int
+check_cpus (const ACE_Thread_Placement &placement,
+            const int expected[],
+            const ACE_TCHAR *what)
+{
+  size_t n = 0;
+  while (expected[n] != -1)
+    ++n;
+
+  int status = 0;
+  if (placement.cpu_count () != n)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B CPUs, expected %B\n"),
+                  what, placement.cpu_count (), n));
+      status = 1;
+    }
+  for (size_t i = 0; i != n; ++i)
+    if (placement.cpu (i) != expected[i] || !placement.is_set (expected[i]))
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: CPU %B is %d, expected %d\n"),
+                    what, i, placement.cpu (i), expected[i]));
+        status = 1;
+      }
+  return status;
+}
+
+static int
+test_parse ()
+{
+  int status = 0;
+
+  ACE_Thread_Placement list;
+  const int list_cpus[] = { 0, 1, 2, 3, 8, 10, 11, -1 };
+  if (list.add (ACE_TEXT ("0-3,8, 10-11\n")) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("add")));
+      status = 1;
+    }
+  status |= check_cpus (list, list_cpus, ACE_TEXT ("list"));
+
+  // The n-th thread goes to the n-th CPU, wrapping around.
+  if (list.cpu (4) != 8 || list.cpu (7) != 0 || list.cpu (13) != 11)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("round robin CPUs are wrong\n")));
+      status = 1;
+    }
+
+  ACE_Thread_Placement more (list);
+  more.add_cpu (8);
+  more.add_cpu (ACE_THREAD_PLACEMENT_MAX_CPUS - 1);
+  const int more_cpus[] =
+    { 0, 1, 2, 3, 8, 10, 11, ACE_THREAD_PLACEMENT_MAX_CPUS - 1, -1 };
+  status |= check_cpus (more, more_cpus, ACE_TEXT ("add_cpu"));
+
+  const ACE_TCHAR *bad[] = { ACE_TEXT ("1-"),
+                             ACE_TEXT ("3-1"),
+                             ACE_TEXT ("1;2"),
+                             ACE_TEXT ("x"),
+                             ACE_TEXT ("99999") };
+  for (size_t i = 0; i != sizeof bad / sizeof bad[0]; ++i)
+    {
+      ACE_Thread_Placement p;
+      if (p.add (bad[i]) != -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("<%s> was accepted\n"), bad[i]));
+          status = 1;
+        }
+    }
+
+  list.clear ();
+  if (!list.empty () || list.cpu (0) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("clear left CPUs\n")));
+      status = 1;
+    }
+
+#if defined (ACE_LINUX)
+  ACE_Thread_Placement node;
+  if (node.add (ACE_TEXT ("node0")) != 0 || node.empty ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("node0")));
+      status = 1;
+    }
+#endif /* ACE_LINUX */
+
+  return status;
+}
+
+/// The CPUs the calling thread may run on, empty when the platform
+/// cannot tell.
+static ACE_Thread_Placement
+current_cpus ()
+{
+  ACE_Thread_Placement current;
+#if defined (CPU_ISSET)
+  cpu_set_t set;
+  ACE_OS::memset (&set, 0, sizeof set);
+# if defined (ACE_HAS_PTHREAD_GETAFFINITY_NP)
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+# else
+  ACE_hthread_t self = 0;
+# endif /* ACE_HAS_PTHREAD_GETAFFINITY_NP */
+  if (ACE_OS::thr_get_affinity (self, sizeof set, &set) == 0)
+    for (size_t cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET (cpu, &set))
+        current.add_cpu (cpu);
+#endif /* CPU_ISSET */
+  return current;
+}
+
+static const size_t n_threads = 6;
+static const size_t buffer_size = 256 * 1024;
+
+/// What each thread saw, in the order they ran.
+static ACE_Thread_Placement seen[n_threads];
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_slot;
+
+static ACE_THR_FUNC_RETURN
+worker (void *)
+{
+  long const slot = next_slot++;
+  if (slot < 0 || slot >= static_cast<long> (n_threads))
+    return 0;
+  seen[slot] = current_cpus ();
+
+  // A buffer of the thread's own node, that it can use.
+  char *buffer =
+    static_cast<char *> (ACE_Thread_Placement::allocate (buffer_size));
+  if (buffer == 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("allocate")));
+      seen[slot].clear ();
+      return 0;
+    }
+  ACE_OS::memset (buffer, 1, buffer_size);
+  ACE_Thread_Placement::deallocate (buffer, buffer_size);
+  return 0;
+}
+
+class Placed_Task : public ACE_Task_Base
+{
+public:
+  int svc () override
+  {
+    worker (0);
+    return 0;
+  }
+};
+
+/// The threads must have run on the CPUs @a placement gives them,
+/// whatever order they started in.
+static int
+check_threads (const ACE_Thread_Placement &placement,
+               const ACE_TCHAR *what)
+{
+  int status = 0;
+  size_t expected[ACE_THREAD_PLACEMENT_MAX_CPUS] = { 0 };
+  size_t got[ACE_THREAD_PLACEMENT_MAX_CPUS] = { 0 };
+  for (size_t i = 0; i != n_threads; ++i)
+    {
+      if (placement.policy () == ACE_Thread_Placement::SHARED)
+        {
+          if (seen[i].cpu_count () != placement.cpu_count ())
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("%s: thread runs on %B CPUs, ")
+                          ACE_TEXT ("expected %B\n"),
+                          what,
+                          seen[i].cpu_count (),
+                          placement.cpu_count ()));
+              status = 1;
+            }
+        }
+      else if (seen[i].cpu_count () != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: thread runs on %B CPUs, expected 1\n"),
+                      what, seen[i].cpu_count ()));
+          status = 1;
+        }
+      else
+        {
+          ++expected[placement.cpu (i)];
+          ++got[seen[i].cpu (0)];
+        }
+      seen[i].clear ();
+    }
+
+  for (size_t cpu = 0; cpu != ACE_THREAD_PLACEMENT_MAX_CPUS; ++cpu)
+    if (expected[cpu] != got[cpu])
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: %B threads ran on CPU %B, expected %B\n"),
+                    what, got[cpu], cpu, expected[cpu]));
+        status = 1;
+      }
+  next_slot = 0;
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Thread_Placement_Test"));
+
+  int status = test_parse ();
+
+  ACE_Thread_Placement cpus = current_cpus ();
+  if (cpus.empty ())
+    {
+      ACE_DEBUG ((LM_INFO,
+                  ACE_TEXT ("Thread affinity is not available\n")));
+      ACE_END_TEST;
+      return status;
+    }
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Placing threads on %B CPUs\n"),
+              cpus.cpu_count ()));
+
+  ACE_Thread_Manager *tm = ACE_Thread_Manager::instance ();
+  if (tm->spawn_n (n_threads,
+                   worker,
+                   0,
+                   THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                   ACE_DEFAULT_THREAD_PRIORITY,
+                   -1, 0, 0, 0, 0, 0,
+                   &cpus) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+  tm->wait ();
+  status |= check_threads (cpus, ACE_TEXT ("spawn_n"));
+
+  Placed_Task task;
+  task.thread_placement (&cpus);
+  if (task.activate (THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                     static_cast<int> (n_threads)) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")), 1);
+  task.wait ();
+  status |= check_threads (cpus, ACE_TEXT ("activate"));
+
+  cpus.policy (ACE_Thread_Placement::SHARED);
+  if (task.activate (THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                     static_cast<int> (n_threads)) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")), 1);
+  task.wait ();
+  status |= check_threads (cpus, ACE_TEXT ("shared"));
+
+  ACE_END_TEST;
+  return status;
+}
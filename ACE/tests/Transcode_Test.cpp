@@ -0,0 +1,275 @@
+
+//=============================================================================
+/**
+ *  @file    Transcode_Test.cpp
+ *
+ *    This test checks that the bulk conversions of <ACE_Transcode>
+ *    give the same results as converting one character at a time, for
+ *    every length and alignment around the blocks they work on.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Transcode.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+#include <vector>
+
+/// The longest strings to try, past a few blocks.
+static size_t const max_length = 70;
+
+static size_t
+encode_one_at_a_time (const char *s, size_t n, char *dst)
+{
+  size_t out = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      unsigned char const c = static_cast<unsigned char> (s[i]);
+      if (c < 0x80)
+        dst[out++] = static_cast<char> (c);
+      else
+        {
+          dst[out++] = static_cast<char> (0xC0 | (c >> 6));
+          dst[out++] = static_cast<char> (0x80 | (c & 0x3F));
+        }
+    }
+  return out;
+}
+
+static int
+test_ascii_length ()
+{
+  int status = 0;
+  char buf[max_length + 1];
+
+  for (size_t offset = 0; offset < 2; ++offset)
+    for (size_t n = 0; n + offset <= max_length; ++n)
+      for (size_t high = 0; high <= n; ++high)
+        {
+          ACE_OS::memset (buf, 'a', sizeof buf);
+          if (high < n)
+            buf[offset + high] = static_cast<char> (0x80 + high);
+
+          size_t const length = ACE_Transcode::ascii_length (buf + offset, n);
+          if (length != high)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("ascii_length of %B bytes with the ")
+                          ACE_TEXT ("first non ASCII at %B gave %B\n"),
+                          n, high, length));
+              status = 1;
+            }
+        }
+  return status;
+}
+
+/// Round trip strings of @a n random Latin-1 characters, of which
+/// one in @a non_ascii_one_in is non ASCII on average.
+static int
+test_latin1 (size_t n, int non_ascii_one_in)
+{
+  int status = 0;
+  std::vector<char> latin1 (n + 1);
+  std::vector<char> expected (2 * n + 1);
+  std::vector<char> utf8 (2 * n + 1);
+  std::vector<char> back (n + 1);
+
+  for (int round = 0; round < 20; ++round)
+    {
+      for (size_t i = 0; i < n; ++i)
+        {
+          int const r = ACE_OS::rand ();
+          latin1[i] = static_cast<char> (r % non_ascii_one_in == 0
+                                         ? 0x80 + (r >> 8) % 0x80
+                                         : 0x20 + (r >> 8) % 0x5F);
+        }
+
+      size_t const length = encode_one_at_a_time (&latin1[0], n,
+                                                  &expected[0]);
+      if (ACE_Transcode::latin1_utf8_length (&latin1[0], n) != length)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("latin1_utf8_length of %B chars is not %B\n"),
+                      n, length));
+          status = 1;
+          continue;
+        }
+
+      if (ACE_Transcode::latin1_to_utf8 (&latin1[0], n, &utf8[0]) != length
+          || ACE_OS::memcmp (&utf8[0], &expected[0], length) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("latin1_to_utf8 of %B chars is wrong\n"), n));
+          status = 1;
+          continue;
+        }
+
+      size_t written = 0;
+      if (ACE_Transcode::utf8_to_latin1 (&utf8[0], length, &back[0],
+                                         written) != length
+          || written != n
+          || ACE_OS::memcmp (&back[0], &latin1[0], n) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("utf8_to_latin1 of %B chars is wrong\n"), n));
+          status = 1;
+        }
+    }
+  return status;
+}
+
+struct Bad_Sequence
+{
+  const char *utf8_;
+  size_t decoded_;
+};
+
+/// Sequences decoding stops at, after an ASCII prefix long enough to
+/// take the block path.
+static Bad_Sequence const bad_sequences[] =
+{
+  { "\xC4\x80", 0 },           // U+0100, not Latin-1
+  { "\xE2\x82\xAC", 0 },       // U+20AC
+  { "\xC0\xA0", 0 },           // overlong space
+  { "\xC1\xBF", 0 },           // overlong U+007F
+  { "\xA9", 0 },               // continuation alone
+  { "\xC3", 0 },               // cut short
+  { "\xC3" "A", 0 },           // continuation missing
+  { "\xC3\xA9\xFF", 2 },       // e acute, then not UTF-8
+  { 0, 0 }
+};
+
+static int
+test_bad_utf8 ()
+{
+  int status = 0;
+  char const prefix[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  size_t const prefix_length = sizeof prefix - 1;
+
+  for (size_t i = 0; bad_sequences[i].utf8_ != 0; ++i)
+    for (size_t p = 0; p <= prefix_length; p += 9)
+      {
+        char buf[64];
+        size_t const n = ACE_OS::strlen (bad_sequences[i].utf8_);
+        ACE_OS::memcpy (buf, prefix, p);
+        ACE_OS::memcpy (buf + p, bad_sequences[i].utf8_, n);
+
+        char out[64];
+        size_t written = 0;
+        size_t const decoded =
+          ACE_Transcode::utf8_to_latin1 (buf, p + n, out, written);
+        size_t const expected = p + bad_sequences[i].decoded_;
+        size_t const expected_written =
+          p + (bad_sequences[i].decoded_ != 0 ? 1 : 0);
+
+        if (decoded != expected || written != expected_written)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("utf8_to_latin1 of bad sequence %B after ")
+                        ACE_TEXT ("%B bytes decoded %B into %B, expected ")
+                        ACE_TEXT ("%B into %B\n"),
+                        i, p, decoded, written, expected, expected_written));
+            status = 1;
+          }
+      }
+  return status;
+}
+
+static int
+test_utf16 ()
+{
+  int status = 0;
+  ACE_CDR::WChar wide[max_length];
+  ACE_CDR::WChar back[max_length];
+  char utf16[2 * max_length + 1];
+  char expected[2 * max_length + 1];
+
+  for (size_t i = 0; i < max_length; ++i)
+    {
+      // Spread over the whole 16 bits.
+      unsigned long const c = (i * 0x1357UL + 0xFF) & 0xFFFFUL;
+      wide[i] = static_cast<ACE_CDR::WChar> (c);
+    }
+
+  for (int swap = 0; swap < 2; ++swap)
+    for (size_t offset = 0; offset < 2; ++offset)
+      for (size_t n = 0; n <= max_length; ++n)
+        {
+          for (size_t i = 0; i < n; ++i)
+            {
+              ACE_UINT16 u = static_cast<ACE_UINT16> (wide[i]);
+              if (swap)
+                u = static_cast<ACE_UINT16> ((u << 8) | (u >> 8));
+              ACE_OS::memcpy (expected + 2 * i, &u, sizeof u);
+            }
+
+          ACE_Transcode::wchar_to_utf16 (wide, n, utf16 + offset, swap != 0);
+          if (ACE_OS::memcmp (utf16 + offset, expected, 2 * n) != 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("wchar_to_utf16 of %B chars at offset ")
+                          ACE_TEXT ("%B, swap %d is wrong\n"),
+                          n, offset, swap));
+              status = 1;
+            }
+
+          ACE_CDR::WChar const untouched = static_cast<ACE_CDR::WChar> (1);
+          for (size_t i = 0; i < max_length; ++i)
+            back[i] = untouched;
+
+          ACE_Transcode::utf16_to_wchar (utf16 + offset, n, back, swap != 0);
+          if (ACE_OS::memcmp (back, wide, n * sizeof (ACE_CDR::WChar)) != 0
+              || (n < max_length && back[n] != untouched))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("utf16_to_wchar of %B units at offset ")
+                          ACE_TEXT ("%B, swap %d is wrong\n"),
+                          n, offset, swap));
+              status = 1;
+            }
+        }
+
+  // Characters past 16 bits are truncated, as casting them would.
+  if (sizeof (ACE_CDR::WChar) == 4)
+    {
+      ACE_CDR::WChar large[9];
+      for (size_t i = 0; i < 9; ++i)
+        large[i] = static_cast<ACE_CDR::WChar> (0x1F600 + i);
+
+      ACE_Transcode::wchar_to_utf16 (large, 9, utf16, false);
+      for (size_t i = 0; i < 9; ++i)
+        {
+          ACE_UINT16 u;
+          ACE_OS::memcpy (&u, utf16 + 2 * i, sizeof u);
+          if (u != 0xF600 + i)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("wchar_to_utf16 of U+%x gave %x\n"),
+                          static_cast<unsigned int> (0x1F600 + i), u));
+              status = 1;
+            }
+        }
+    }
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Transcode_Test"));
+
+  int status = test_ascii_length ();
+  for (size_t n = 0; n <= max_length; ++n)
+    {
+      status |= test_latin1 (n, 2);
+      status |= test_latin1 (n, 40);
+    }
+  status |= test_latin1 (10000, 1000);
+  status |= test_bad_utf8 ();
+  status |= test_utf16 ();
+
+  ACE_END_TEST;
+  return status;
+}
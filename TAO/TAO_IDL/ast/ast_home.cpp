@@ -202,6 +202,8 @@ AST_Home::transfer_scope_elements (AST_Interface *dst)
       this->pd_decls[i] = nullptr;
       --this->pd_decls_used;
     }
+
+  this->reset_name_indexes ();
 }
 
 void
@@ -212,6 +212,8 @@ AST_Root::destroy ()
     }
 
   this->pd_name_referenced_used = 2;
+
+  this->reset_name_indexes ();
 }
 
 void
@@ -2540,6 +2540,11 @@ TAO_CodeGen::gen_stub_hdr_includes ()
       // Include Messaging skeleton file.
       this->gen_standard_include (this->client_header_,
                                   "tao/Messaging/Messaging.h");
+
+      // The awaitable invocations the async_ operations return.
+      this->gen_cond_file_include (be_global->gen_ami_coroutines (),
+                                   "tao/Messaging/Asynch_Awaitable.h",
+                                   this->client_header_);
     }
 
   // Include the AMI4CCM library entry point, if AMI4CCM is enabled.
@@ -2621,6 +2626,30 @@ TAO_CodeGen::gen_stub_hdr_includes ()
   // Must have knowledge of the base class.
   this->gen_seq_file_includes ();
 
+  // Fixed size structs may specialize TAO::CDR_Bulk_Traits.
+  this->gen_cond_file_include (
+      idl_global->aggregate_seen_ && be_global->cdr_support (),
+      "tao/CDR_Bulk_Traits_T.h",
+      this->client_header_);
+
+  // The types whose size in CDR is known without marshaling them
+  // have an operator<< (ACE_SizeCDR &, ...).
+  this->gen_cond_file_include (
+      be_global->cdr_support ()
+      && be_global->cdr_size_support ()
+      && (idl_global->aggregate_seen_
+          || idl_global->seq_seen_
+          || idl_global->array_seen_
+          || idl_global->enum_seen_),
+      "ace/CDR_Size.h",
+      this->client_header_);
+
+  // The read-only views of structs, and of the sequences in them.
+  this->gen_cond_file_include (
+      be_global->gen_views () && idl_global->aggregate_seen_,
+      "tao/Sequence_View_T.h",
+      this->client_header_);
+
   // _vars and _outs are typedefs of template class instantiations.
   this->gen_var_file_includes ();
 
@@ -2796,6 +2825,13 @@ TAO_CodeGen::gen_stub_src_includes ()
                                   "cstring");
     }
 
+  // std::swap() is used to move unions.
+  if (idl_global->union_seen_)
+    {
+      this->gen_standard_include (this->client_stubs_,
+                                  "utility");
+    }
+
   if (be_global->gen_amh_classes ())
     {
       // Necessary for the AIX compiler.
@@ -2831,6 +2867,11 @@ TAO_CodeGen::gen_skel_hdr_includes ()
         {
           this->gen_standard_include (this->server_header_,
                                       "tao/Messaging/AMH_Response_Handler.h");
+
+          // The task the coroutine upcalls return.
+          this->gen_cond_file_include (be_global->gen_amh_coroutines (),
+                                       "tao/Messaging/AMH_Task.h",
+                                       this->server_header_);
         }
     }
 }
@@ -3171,6 +3212,11 @@ TAO_CodeGen::gen_skel_arg_file_includes (TAO_OutStream * stream)
       stream,
       "tao/PortableServer/Var_Size_SArgument_T.h");
 
+  this->gen_cond_file_include (
+      be_global->gen_views (),
+      "tao/PortableServer/View_SArgument_T.h",
+      stream);
+
   // If we have a bound string and we have any generation enabled we must
   // include Any.h to get the <<= operator for BD_String
   this->gen_cond_file_include (
@@ -95,6 +95,7 @@ BE_GlobalData::BE_GlobalData ()
     exec_output_dir_ (nullptr),
     any_support_ (true),
     cdr_support_ (true),
+    cdr_size_support_ (true),
     tc_support_ (true),
     obv_opt_accessor_ (false),
     gen_impl_files_ (false),
@@ -137,6 +138,9 @@ BE_GlobalData::BE_GlobalData ()
     gen_template_export_ (false),
     gen_ostream_operators_ (false),
     gen_static_desc_operations_ (false),
+    gen_views_ (false),
+    gen_ami_coroutines_ (false),
+    gen_amh_coroutines_ (false),
     gen_custom_ending_ (true),
     gen_unique_guards_ (true),
     gen_ciao_svnt_ (false),
@@ -1376,6 +1380,42 @@ BE_GlobalData::gen_static_desc_operations (bool val)
   this->gen_static_desc_operations_ = val;
 }
 
+bool
+BE_GlobalData::gen_views () const
+{
+  return this->gen_views_;
+}
+
+void
+BE_GlobalData::gen_views (bool val)
+{
+  this->gen_views_ = val;
+}
+
+bool
+BE_GlobalData::gen_ami_coroutines () const
+{
+  return this->gen_ami_coroutines_;
+}
+
+void
+BE_GlobalData::gen_ami_coroutines (bool val)
+{
+  this->gen_ami_coroutines_ = val;
+}
+
+bool
+BE_GlobalData::gen_amh_coroutines () const
+{
+  return this->gen_amh_coroutines_;
+}
+
+void
+BE_GlobalData::gen_amh_coroutines (bool val)
+{
+  this->gen_amh_coroutines_ = val;
+}
+
 const char*
 BE_GlobalData::anyop_header_ending () const
 {
@@ -1689,6 +1729,18 @@ BE_GlobalData::cdr_support () const
   return this->cdr_support_;
 }
 
+void
+BE_GlobalData::cdr_size_support (bool val)
+{
+  this->cdr_size_support_ = val;
+}
+
+bool
+BE_GlobalData::cdr_size_support () const
+{
+  return this->cdr_size_support_;
+}
+
 void
 BE_GlobalData::tc_support (bool val)
 {
@@ -3199,6 +3251,14 @@ BE_GlobalData::parse_args (long &i, char **av)
             // Generate tie classes and files
             be_global->gen_tie_classes (true);
           }
+        else if (av[i][2] == 'H' && av[i][3] == 'c' && av[i][4] == 'o' && av[i][5] == 'r' && av[i][6] == 'o' && '\0' == av[i][7])
+          {
+            // AMH classes with coroutine upcalls.
+            be_global->gen_amh_classes (true);
+            be_global->gen_amh_coroutines (true);
+
+            break;
+          }
         else if (av[i][2] == 'H')
           {
             // AMH classes.
@@ -3234,6 +3294,20 @@ BE_GlobalData::parse_args (long &i, char **av)
             // Generate static description operations
             be_global->gen_static_desc_operations (true);
 
+            break;
+          }
+        else if (av[i][2] == 'v' && av[i][3] == 'i' && av[i][4] == 'e' && av[i][5] == 'w' && '\0' == av[i][6])
+          {
+            // Generate read-only views of structs.
+            be_global->gen_views (true);
+
+            break;
+          }
+        else if (av[i][2] == 'c' && av[i][3] == 'o' && av[i][4] == 'r' && av[i][5] == 'o' && '\0' == av[i][6])
+          {
+            // Generate awaitable AMI operations for coroutines.
+            be_global->gen_ami_coroutines (true);
+
             break;
           }
         else if (av[i][2] == 'e' && av[i][3] == 'x')
@@ -3633,6 +3707,11 @@ BE_GlobalData::parse_args (long &i, char **av)
                 // No cdr support.
                 be_global->cdr_support (false);
               }
+            else if (av[i][3] == 's' && av[i][4] == 'z')
+              {
+                // No cdr size operators.
+                be_global->cdr_size_support (false);
+              }
             else
               {
                 ACE_ERROR ((
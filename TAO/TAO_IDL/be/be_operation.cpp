@@ -44,7 +44,8 @@ be_operation::be_operation (AST_Type *rt,
              n),
     is_sendc_ami_ (false),
     is_excep_ami_ (false),
-    is_attr_op_ (false)
+    is_attr_op_ (false),
+    has_ami_awaitable_ (false)
 {
   if (this->imported ())
     {
@@ -138,3 +139,15 @@ be_operation::is_attr_op (bool val)
 {
   this->is_attr_op_ = val;
 }
+
+bool
+be_operation::has_ami_awaitable () const
+{
+  return this->has_ami_awaitable_;
+}
+
+void
+be_operation::has_ami_awaitable (bool val)
+{
+  this->has_ami_awaitable_ = val;
+}
@@ -18,6 +18,12 @@
 #include "be_visitor.h"
 #include "be_extern.h"
 
+#include "ast_array.h"
+#include "ast_expression.h"
+#include "ast_predefined_type.h"
+#include "ast_sequence.h"
+#include "ast_structure_fwd.h"
+
 #include "utl_identifier.h"
 #include "idl_defines.h"
 #include "global_extern.h"
@@ -41,7 +47,8 @@ be_structure::be_structure (UTL_ScopedName *n,
     be_decl (AST_Decl::NT_struct,
              n),
     be_type (AST_Decl::NT_struct,
-             n)
+             n),
+    in_has_view_ (false)
 {
   if (!this->imported ())
     {
@@ -70,7 +77,8 @@ be_structure::be_structure (AST_Decl::NodeType nt,
     be_decl (nt,
              n),
     be_type (nt,
-             n)
+             n),
+    in_has_view_ (false)
 {
   if (!this->imported ())
     {
@@ -144,6 +152,224 @@ be_structure::gen_ostream_operator (TAO_OutStream *os,
       << "}" << be_nl;
 }
 
+bool
+be_structure::cdr_bulk_layout (ACE_CDR::ULong &size,
+                               ACE_CDR::ULong &alignment)
+{
+  if (this->node_type () != AST_Decl::NT_struct
+      || this->is_local ()
+      || this->nfields () == 0)
+    {
+      return false;
+    }
+
+  ACE_CDR::ULong offset = 0;
+  alignment = 0;
+
+  for (ACE_CDR::ULong i = 0; i < this->nfields (); ++i)
+    {
+      AST_Field **f = nullptr;
+      this->field (f, i);
+
+      ACE_CDR::ULong member_size = 0;
+      ACE_CDR::ULong member_alignment = 0;
+      ACE_CDR::ULong count = 0;
+      be_structure *nested = nullptr;
+
+      if (!be_structure::cdr_bulk_member ((*f)->field_type (),
+                                          member_size,
+                                          member_alignment,
+                                          count,
+                                          nested))
+        {
+          return false;
+        }
+
+      if (alignment == 0)
+        {
+          // CDR aligns a struct as its first member.
+          alignment = member_alignment;
+        }
+      else if (member_alignment > alignment)
+        {
+          return false;
+        }
+
+      offset = (offset + member_alignment - 1) & ~(member_alignment - 1);
+      offset += member_size * count;
+    }
+
+  size = offset;
+  return size % alignment == 0;
+}
+
+bool
+be_structure::cdr_bulk_member (AST_Type *type,
+                               ACE_CDR::ULong &size,
+                               ACE_CDR::ULong &alignment,
+                               ACE_CDR::ULong &count,
+                               be_structure *&nested)
+{
+  AST_Type *ut = type->unaliased_type ();
+  count = 1;
+  nested = nullptr;
+
+  AST_Array *array = dynamic_cast<AST_Array*> (ut);
+
+  if (array != nullptr)
+    {
+      for (ACE_CDR::ULong i = 0; i < array->n_dims (); ++i)
+        {
+          AST_Expression *expr = array->dims ()[i];
+
+          if (expr == nullptr
+              || expr->ev () == nullptr
+              || expr->ev ()->et != AST_Expression::EV_ulong)
+            {
+              return false;
+            }
+
+          count *= expr->ev ()->u.ulval;
+        }
+
+      ut = array->base_type ()->unaliased_type ();
+    }
+
+  switch (ut->node_type ())
+    {
+    case AST_Decl::NT_pre_defined:
+      {
+        AST_PredefinedType *pdt = dynamic_cast<AST_PredefinedType*> (ut);
+
+        // Booleans are not marshaled as they are stored, chars and
+        // wide chars go through the codeset translators of the
+        // stream, and long double is not a C++ type everywhere.
+        switch (pdt->pt ())
+          {
+          case AST_PredefinedType::PT_octet:
+            size = 1;
+            break;
+          case AST_PredefinedType::PT_short:
+          case AST_PredefinedType::PT_ushort:
+            size = 2;
+            break;
+          case AST_PredefinedType::PT_long:
+          case AST_PredefinedType::PT_ulong:
+          case AST_PredefinedType::PT_float:
+            size = 4;
+            break;
+          case AST_PredefinedType::PT_longlong:
+          case AST_PredefinedType::PT_ulonglong:
+          case AST_PredefinedType::PT_double:
+            size = 8;
+            break;
+          default:
+            return false;
+          }
+
+        alignment = size;
+        return true;
+      }
+    case AST_Decl::NT_struct:
+      nested = dynamic_cast<be_structure*> (ut);
+      return nested != nullptr
+        && nested->cdr_bulk_layout (size, alignment);
+    default:
+      return false;
+    }
+}
+
+bool
+be_structure::has_view ()
+{
+  if (!be_global->gen_views ()
+      || this->node_type () != AST_Decl::NT_struct
+      || this->is_local ())
+    {
+      return false;
+    }
+
+  if (this->in_has_view_)
+    {
+      // A recursive struct, reached again through a sequence: it has
+      // a view if the rest of it does.
+      return true;
+    }
+
+  bool result = true;
+  this->in_has_view_ = true;
+
+  for (ACE_CDR::ULong i = 0; result && i < this->nfields (); ++i)
+    {
+      AST_Field **f = nullptr;
+      this->field (f, i);
+      result = view_member ((*f)->field_type ()) != VIEW_NONE;
+    }
+
+  this->in_has_view_ = false;
+  return result;
+}
+
+be_structure::View_Member
+be_structure::view_member (AST_Type *type)
+{
+  AST_Type *ut = type->unaliased_type ();
+
+  if (ut->node_type () == AST_Decl::NT_struct_fwd)
+    {
+      ut = dynamic_cast<AST_StructureFwd*> (ut)->full_definition ();
+    }
+
+  be_type *bt = dynamic_cast<be_type*> (ut);
+
+  if (bt == nullptr)
+    {
+      return VIEW_NONE;
+    }
+
+  switch (ut->node_type ())
+    {
+    case AST_Decl::NT_pre_defined:
+      return bt->cdr_sizable () ? VIEW_BASIC : VIEW_NONE;
+    case AST_Decl::NT_enum:
+      return VIEW_BASIC;
+    case AST_Decl::NT_string:
+      return VIEW_STRING;
+    case AST_Decl::NT_wstring:
+      return VIEW_WSTRING;
+    case AST_Decl::NT_struct:
+      {
+        be_structure *bs = dynamic_cast<be_structure*> (ut);
+        return bs != nullptr && bs->has_view () ? VIEW_STRUCT : VIEW_NONE;
+      }
+    case AST_Decl::NT_sequence:
+      switch (view_member (dynamic_cast<AST_Sequence*> (ut)->base_type ()))
+        {
+        case VIEW_BASIC:
+        case VIEW_STRING:
+        case VIEW_WSTRING:
+        case VIEW_STRUCT:
+          return VIEW_SEQUENCE;
+        default:
+          break;
+        }
+      break;
+    default:
+      break;
+    }
+
+  // Anything else is demarshaled into its C++ type, which needs a
+  // name: that of a typedef, or of a union.
+  if ((type->node_type () == AST_Decl::NT_typedef
+       || ut->node_type () == AST_Decl::NT_union)
+      && bt->cdr_sizable ())
+    {
+      return VIEW_DECODE;
+    }
+
+  return VIEW_NONE;
+}
+
 void
 be_structure::destroy ()
 {
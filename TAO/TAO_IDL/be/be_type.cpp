@@ -21,6 +21,10 @@
 
 #include "ast_valuetype.h"
 #include "ast_sequence.h"
+#include "ast_array.h"
+#include "ast_predefined_type.h"
+#include "ast_field.h"
+#include "ast_structure.h"
 
 #include "utl_identifier.h"
 #include "idl_defines.h"
@@ -38,7 +42,8 @@ be_type::be_type (AST_Decl::NodeType nt,
     tc_name_ (nullptr),
     common_varout_gen_ (false),
     seen_in_sequence_ (false),
-    seen_in_operation_ (false)
+    seen_in_operation_ (false),
+    in_cdr_sizable_ (false)
 {
   if (n != nullptr)
     {
@@ -375,6 +380,91 @@ be_type::base_node_type () const
   return const_cast<be_type*> (this)->node_type ();
 }
 
+bool
+be_type::cdr_sizable ()
+{
+  if (this->in_cdr_sizable_)
+    {
+      // A recursive type, reached again through a sequence: it is
+      // sizable if the rest of it is.
+      return true;
+    }
+
+  AST_Type *ut = this->unaliased_type ();
+
+  if (ut != this)
+    {
+      be_type *bt = dynamic_cast<be_type*> (ut);
+      return bt != nullptr && bt->cdr_sizable ();
+    }
+
+  if (this->is_local ())
+    {
+      return false;
+    }
+
+  bool sizable = false;
+  this->in_cdr_sizable_ = true;
+
+  switch (this->node_type ())
+    {
+    case AST_Decl::NT_pre_defined:
+      {
+        AST_PredefinedType *pdt = dynamic_cast<AST_PredefinedType*> (this);
+
+        switch (pdt->pt ())
+          {
+          case AST_PredefinedType::PT_any:
+          case AST_PredefinedType::PT_object:
+          case AST_PredefinedType::PT_value:
+          case AST_PredefinedType::PT_abstract:
+          case AST_PredefinedType::PT_pseudo:
+          case AST_PredefinedType::PT_void:
+            break;
+          default:
+            sizable = true;
+            break;
+          }
+      }
+      break;
+    case AST_Decl::NT_string:
+    case AST_Decl::NT_wstring:
+    case AST_Decl::NT_enum:
+      sizable = true;
+      break;
+    case AST_Decl::NT_struct:
+    case AST_Decl::NT_union:
+      {
+        AST_Structure *s = dynamic_cast<AST_Structure*> (this);
+        sizable = true;
+
+        for (ACE_CDR::ULong i = 0; sizable && i < s->nfields (); ++i)
+          {
+            AST_Field **f = nullptr;
+            s->field (f, i);
+            be_type *ft = dynamic_cast<be_type*> ((*f)->field_type ());
+            sizable = ft != nullptr && ft->cdr_sizable ();
+          }
+      }
+      break;
+    case AST_Decl::NT_sequence:
+    case AST_Decl::NT_array:
+      {
+        AST_Type *base = this->node_type () == AST_Decl::NT_sequence
+          ? dynamic_cast<AST_Sequence*> (this)->base_type ()
+          : dynamic_cast<AST_Array*> (this)->base_type ();
+        be_type *bt = dynamic_cast<be_type*> (base);
+        sizable = bt != nullptr && bt->cdr_sizable ();
+      }
+      break;
+    default:
+      break;
+    }
+
+  this->in_cdr_sizable_ = false;
+  return sizable;
+}
+
 // Cleanup method
 void
 be_type::destroy ()
@@ -14,6 +14,8 @@
 #include "be_helper.h"
 #include "be_module.h"
 #include "be_type.h"
+#include "be_structure.h"
+#include "be_visitor_context.h"
 #include "be_identifier_helper.h"
 #include "be_extern.h"
 #include "be_generator.h"
@@ -22,6 +24,9 @@
 #include "utl_identifier.h"
 #include "utl_string.h"
 
+#include "ast_argument.h"
+#include "ast_interface.h"
+#include "ast_operation.h"
 #include "ast_typedef.h"
 #include "ast_structure.h"
 #include "ast_structure_fwd.h"
@@ -565,10 +570,20 @@ be_util::usage ()
       LM_DEBUG,
       ACE_TEXT (" -GC \t\t\tGenerate the AMI classes\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -Gcoro\t\t\tWith -GC, generate async_ operations that ")
+      ACE_TEXT ("C++20 coroutines co_await (not generated by default)\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -GH \t\t\tGenerate the AMH classes\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -GHcoro\t\tGenerate the AMH classes with upcalls that ")
+      ACE_TEXT ("are C++20 coroutines (not generated by default)\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -GM \t\t\tGenerate the AMI4CCM classes\n")
@@ -680,6 +695,12 @@ be_util::usage ()
       ACE_TEXT (" -Gsd\t\t\tgenerate static description operations which can ")
       ACE_TEXT ("be useful for template programming (not generated by default)\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -Gview\t\t\tgenerate read-only views of structs over ")
+      ACE_TEXT ("received data, and pass them to servants for in arguments ")
+      ACE_TEXT ("(not generated by default)\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -Gse\t\t\tgenerate explicit export of sequence's ")
@@ -847,6 +868,11 @@ be_util::usage ()
       ACE_TEXT (" -Scdr\t\t\tsuppress CDR support")
       ACE_TEXT (" (support enabled by default)\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -Scsz\t\t\tsuppress CDR size operators")
+      ACE_TEXT (" (support enabled by default)\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -Sat\t\t\tsuppress arg traits")
@@ -1119,3 +1145,35 @@ be_util::set_arg_seen_bit (be_type *bt)
     }
 }
 
+be_structure *
+be_util::in_view_struct (AST_Argument *arg, be_visitor_context *ctx)
+{
+  if (!be_global->gen_views ()
+      || ctx->attribute () != nullptr
+      || arg->direction () != AST_Argument::dir_IN)
+    {
+      return nullptr;
+    }
+
+  AST_Decl *op = ScopeAsDecl (arg->defined_in ());
+
+  if (op == nullptr || op->node_type () != AST_Decl::NT_op)
+    {
+      return nullptr;
+    }
+
+  AST_Decl *owner = ScopeAsDecl (op->defined_in ());
+
+  if (owner == nullptr
+      || owner->node_type () != AST_Decl::NT_interface
+      || dynamic_cast<AST_Interface*> (owner)->is_local ()
+      || dynamic_cast<AST_Interface*> (owner)->is_abstract ())
+    {
+      return nullptr;
+    }
+
+  be_structure *bs =
+    dynamic_cast<be_structure*> (arg->field_type ()->unaliased_type ());
+
+  return bs != nullptr && bs->has_view () ? bs : nullptr;
+}
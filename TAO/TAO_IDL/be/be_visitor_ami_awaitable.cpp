@@ -0,0 +1,110 @@
+//=============================================================================
+/**
+*  @file   be_visitor_ami_awaitable.cpp
+*
+*  This visitor generates the inline definitions of the awaitable
+*  AMI operations at the end of the client header.
+*/
+//=============================================================================
+
+#include "be_visitor_ami_awaitable.h"
+#include "be_visitor_operation.h"
+#include "be_visitor_context.h"
+#include "be_root.h"
+#include "be_module.h"
+#include "be_interface.h"
+#include "be_operation.h"
+#include "be_helper.h"
+#include "ace/Log_Msg.h"
+
+be_visitor_ami_awaitable::be_visitor_ami_awaitable (
+  be_visitor_context *ctx)
+  : be_visitor_scope (ctx)
+{
+}
+
+be_visitor_ami_awaitable::~be_visitor_ami_awaitable ()
+{
+}
+
+int
+be_visitor_ami_awaitable::visit_root (be_root *node)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  *os << be_nl_2
+      << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__ << be_nl_2;
+
+  *os << "#if TAO_HAS_AMI_COROUTINES == 1";
+
+  if (this->visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "be_visitor_ami_awaitable::"
+                         "visit_root - visit scope failed\n"),
+                        -1);
+    }
+
+  *os << be_nl_2 << "#endif /* TAO_HAS_AMI_COROUTINES == 1 */";
+
+  return 0;
+}
+
+int
+be_visitor_ami_awaitable::visit_module (be_module *node)
+{
+  if (this->visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "be_visitor_ami_awaitable::"
+                         "visit_module - visit scope failed\n"),
+                        -1);
+    }
+
+  return 0;
+}
+
+int
+be_visitor_ami_awaitable::visit_interface (be_interface *node)
+{
+  if (node->imported ())
+    {
+      return 0;
+    }
+
+  if (this->visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "be_visitor_ami_awaitable::"
+                         "visit_interface - visit scope failed\n"),
+                        -1);
+    }
+
+  return 0;
+}
+
+int
+be_visitor_ami_awaitable::visit_operation (be_operation *node)
+{
+  if (!node->has_ami_awaitable ())
+    {
+      return 0;
+    }
+
+  be_visitor_context ctx (*this->ctx_);
+  ctx.node (node);
+  ctx.state (TAO_CodeGen::TAO_OPERATION_CS);
+  be_visitor_operation_ami_awaitable_ch visitor (&ctx);
+
+  if (node->accept (&visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "be_visitor_ami_awaitable::"
+                         "visit_operation - "
+                         "codegen for async operation failed\n"),
+                        -1);
+    }
+
+  return 0;
+}
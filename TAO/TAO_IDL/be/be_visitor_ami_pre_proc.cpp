@@ -214,6 +214,13 @@ be_visitor_ami_pre_proc::visit_operation (be_operation *node)
 
   parent->be_add_operation (sendc_op);
 
+  // The coroutine version makes the same invocation, but takes
+  // the arguments of the synchronous operation.
+  if (be_global->gen_ami_coroutines () && !node->has_native ())
+    {
+      node->has_ami_awaitable (true);
+    }
+
   return 0;
 }
 
@@ -960,6 +960,22 @@ be_visitor_arg_traits::visit_structure (be_structure *node)
       << "{" << be_nl
       << "};";
 
+  if (ACE_OS::strcmp (this->S_, "S") == 0 && node->has_view ())
+    {
+      *os << be_nl_2
+          << "template<>" << be_nl
+          << "class SArg_Traits< ::" << node->name () << "_View>"
+          << be_idt_nl
+          << ": public" << be_idt << be_idt_nl
+          << "View_SArg_Traits_T<" << be_idt << be_idt_nl
+          << "::" << node->name () << "," << be_nl
+          << "::" << node->name () << "_View," << be_nl
+          << this->insert_policy () << be_uidt_nl
+          << ">" << be_uidt << be_uidt << be_uidt << be_uidt_nl
+          << "{" << be_nl
+          << "};";
+    }
+
   /* Set this before visiting the scope so things like
 
       interface foo
@@ -10,6 +10,7 @@
 //=============================================================================
 
 #include "argument.h"
+#include "be_util.h"
 
 // ************************************************************
 // be_visitor_args_arglist for parameter list in method declarations and
@@ -371,6 +372,12 @@ int be_visitor_args_arglist::visit_structure (be_structure *node)
   switch (this->direction ())
     {
     case AST_Argument::dir_IN:
+      if (this->servant_view ())
+        {
+          *os << "const ::" << node->full_name () << "_View &";
+          break;
+        }
+
       *os << "const " << this->type_name (node) << " &";
       break;
     case AST_Argument::dir_INOUT:
@@ -496,3 +503,25 @@ be_visitor_args_arglist::unused (bool val)
 {
   this->unused_ = val;
 }
+
+bool
+be_visitor_args_arglist::servant_view ()
+{
+  switch (this->ctx_->state ())
+    {
+    case TAO_CodeGen::TAO_OPERATION_ARGLIST_SH:
+    case TAO_CodeGen::TAO_TIE_OPERATION_ARGLIST_SH:
+    case TAO_CodeGen::TAO_OPERATION_ARGLIST_IH:
+    case TAO_CodeGen::TAO_OPERATION_ARGLIST_IS:
+    case TAO_CodeGen::TAO_ROOT_TIE_SS:
+      break;
+    default:
+      return false;
+    }
+
+  AST_Argument *arg =
+    dynamic_cast<AST_Argument*> (this->ctx_->node ());
+
+  return arg != nullptr
+         && be_util::in_view_struct (arg, this->ctx_) != nullptr;
+}
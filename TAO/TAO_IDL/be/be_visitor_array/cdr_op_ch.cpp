@@ -118,6 +118,13 @@ be_visitor_array_cdr_op_ch::visit_array (be_array *node)
       << " operator>> (TAO_InputCDR &, " << arg_name.c_str ()
       << ");" << be_nl;
 
+  if (be_global->cdr_size_support () && node->cdr_sizable ())
+    {
+      *os << be_global->stub_export_macro () << " ::CORBA::Boolean"
+          << " operator<< (ACE_SizeCDR &strm, const "
+          << arg_name.c_str () << ");" << be_nl;
+    }
+
   // Using 'const' with xxx_forany prevents the compiler from
   // automatically converting back to xxx_slice *.
   if (be_global->gen_ostream_operators ())
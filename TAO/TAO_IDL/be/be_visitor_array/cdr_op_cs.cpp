@@ -183,6 +183,26 @@ be_visitor_array_cdr_op_cs::visit_array (be_array *node)
 
   *os << "}" << be_nl_2;
 
+  if (be_global->cdr_size_support () && node->cdr_sizable ())
+    {
+      *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
+          << "ACE_SizeCDR &strm," << be_nl
+          << "const " << fname << "_forany &_tao_array)" << be_uidt
+          << be_uidt_nl
+          << "{" << be_idt_nl;
+
+      if (bt->accept (this) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "be_visitor_array_cdr_op_cs::"
+                             "visit_array - "
+                             "Base type codegen failed\n"),
+                            -1);
+        }
+
+      *os << "}" << be_nl_2;
+    }
+
   this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_INPUT);
   *os << "::CORBA::Boolean operator>> (" << be_idt << be_idt_nl
       << "TAO_InputCDR &strm," << be_nl
@@ -516,7 +536,55 @@ be_visitor_array_cdr_op_cs::visit_string (be_string *node)
 int
 be_visitor_array_cdr_op_cs::visit_structure (be_structure *node)
 {
-  return this->visit_node (node);
+  be_array *array =
+    dynamic_cast<be_array*> (this->ctx_->node ());
+  ACE_CDR::ULong size = 0;
+  ACE_CDR::ULong alignment = 0;
+  ACE_CDR::ULong count = 0;
+  be_structure *nested = nullptr;
+
+  if (array == nullptr
+      || !be_structure::cdr_bulk_member (array,
+                                         size,
+                                         alignment,
+                                         count,
+                                         nested))
+    {
+      return this->visit_node (node);
+    }
+
+  // The elements may be marshaled as one block, see
+  // TAO::CDR_Bulk_Traits.
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  switch (this->ctx_->sub_state ())
+    {
+    case TAO_CodeGen::TAO_CDR_INPUT:
+      *os << "return" << be_idt_nl
+          << "TAO::demarshal_value_array (" << be_idt << be_idt_nl
+          << "strm," << be_nl
+          << "reinterpret_cast< ::" << node->name ()
+          << " *> (_tao_array.out ())," << be_nl;
+      break;
+    case TAO_CodeGen::TAO_CDR_OUTPUT:
+      *os << "return" << be_idt_nl
+          << "TAO::marshal_value_array (" << be_idt << be_idt_nl
+          << "strm," << be_nl
+          << "reinterpret_cast<const ::" << node->name ()
+          << " *> (_tao_array.in ())," << be_nl;
+      break;
+    default:
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_array_cdr_op_cs::"
+                         "visit_structure - "
+                         "bad substate in context\n"),
+                        -1);
+    }
+
+  *os << count << ");" << be_uidt
+      << be_uidt << be_uidt << be_uidt_nl;
+
+  return 0;
 }
 
 int
@@ -42,6 +42,16 @@ be_visitor_enum_cdr_op_cs::visit_enum (be_enum *node)
       << be_uidt_nl
       << "}" << be_nl_2;
 
+  if (be_global->cdr_size_support ())
+    {
+      *os << "::CORBA::Boolean operator<< (ACE_SizeCDR &strm, "
+          << node->name () << " _tao_enumerator)" << be_nl
+          << "{" << be_idt_nl
+          << "return strm << static_cast< ::CORBA::ULong> (_tao_enumerator);"
+          << be_uidt_nl
+          << "}" << be_nl_2;
+    }
+
   *os << "::CORBA::Boolean operator>> (TAO_InputCDR &strm, "
       << node->name () << " & _tao_enumerator)" << be_nl
       << "{" << be_idt_nl
@@ -56,7 +56,11 @@ int be_visitor_exception_ch::visit_exception (be_exception *node)
                         -1);
     }
 
-  // Constructors and destructor.
+  // Constructors and destructor.  No move operations are generated:
+  // the ORB only copies exceptions from lvalues, in _raise() and
+  // _tao_duplicate(), and the CORBA::Exception base owns copies of
+  // the repository id and name that a moved from exception would
+  // need to keep, so moving would still copy them.
   *os << be_nl_2
       << node->local_name () << " ();" << be_nl
       << node->local_name () << " (const " << node->local_name ()
@@ -45,6 +45,12 @@ be_visitor_amh_interface_sh::visit_interface (be_interface *node)
   *os << be_nl_2 << "// TAO_IDL - Generated from" << be_nl
       << "// " << __FILE__ << ":" << __LINE__ << be_nl_2;
 
+  // The upcalls of -GHcoro return a TAO::AMH_Task, which needs C++20.
+  if (be_global->gen_amh_coroutines ())
+    {
+      *os << "\n#if TAO_HAS_AMI_COROUTINES == 1" << be_nl_2;
+    }
+
   // We shall have a POA_ prefix only if we are at the topmost level.
   if (!node->is_nested ())
     {
@@ -142,6 +148,12 @@ be_visitor_amh_interface_sh::visit_interface (be_interface *node)
   *os << be_uidt_nl
       << "};";
 
+  if (be_global->gen_amh_coroutines ())
+    {
+      *os << be_nl
+          << "\n#endif /* TAO_HAS_AMI_COROUTINES == 1 */";
+    }
+
   return 0;
 }
 
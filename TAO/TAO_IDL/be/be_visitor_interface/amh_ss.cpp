@@ -43,7 +43,21 @@ be_visitor_amh_interface_ss::visit_interface (be_interface *node)
       return 0;
     }
 
-  return be_visitor_interface_ss::visit_interface (node);
+  if (!be_global->gen_amh_coroutines ())
+    {
+      return be_visitor_interface_ss::visit_interface (node);
+    }
+
+  // The coroutine upcalls need C++20, as in the skeleton header.
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  *os << be_nl_2 << "#if TAO_HAS_AMI_COROUTINES == 1";
+
+  int const status = be_visitor_interface_ss::visit_interface (node);
+
+  *os << be_nl_2 << "#endif /* TAO_HAS_AMI_COROUTINES == 1 */";
+
+  return status;
 }
 
 void
@@ -157,8 +157,10 @@ be_visitor_amh_operation_sh::generate_shared_prologue (
       return;
     }
 
-  // Step 1 : Generate return type: always void
-  *os << "virtual void ";
+  // Step 1 : Generate return type: void, or with -GHcoro the task
+  //          of a coroutine
+  *os << "virtual "
+      << (be_global->gen_amh_coroutines () ? "::TAO::AMH_Task " : "void ");
 
   // Step 2: Generate the method name
   *os << node->local_name() << " (" << be_idt << be_idt_nl;
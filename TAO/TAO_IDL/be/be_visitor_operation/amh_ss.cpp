@@ -48,8 +48,15 @@ be_visitor_amh_operation_ss::visit_operation (be_operation *node)
     node->count_arguments_with_direction (AST_Argument::dir_IN
                                           | AST_Argument::dir_INOUT);
 
+  bool const coroutine = be_global->gen_amh_coroutines ();
+
   if (argument_count != 0)
     {
+      if (coroutine)
+        {
+          this->open_argument_storage (os);
+        }
+
       // Declare variables for arguments.
       be_visitor_context vardecl_ctx = *this->ctx_;
       vardecl_ctx.state (TAO_CodeGen::TAO_OPERATION_ARG_DECL_SS);
@@ -80,6 +87,27 @@ be_visitor_amh_operation_ss::visit_operation (be_operation *node)
             }
         }
 
+      if (coroutine)
+        {
+          this->close_argument_storage (os);
+
+          for (UTL_ScopeActiveIterator si (node, UTL_Scope::IK_decls);
+               !si.is_done ();
+               si.next ())
+            {
+              be_argument *argument =
+                dynamic_cast<be_argument*> (si.item ());
+
+              if (argument == nullptr
+                  || argument->direction () == AST_Argument::dir_OUT)
+                {
+                  continue;
+                }
+
+              this->refer_to_argument (argument, os);
+            }
+        }
+
       *os << be_nl
           << "TAO_InputCDR & _tao_in ="
           << " *_tao_server_request.incoming ();" << be_nl_2
@@ -174,7 +202,8 @@ be_visitor_amh_operation_ss::visit_operation (be_operation *node)
       }
   }
 
-  if (this->generate_shared_epilogue (os) == -1)
+  if (this->generate_shared_epilogue (os,
+                                     coroutine && argument_count != 0) == -1)
     {
       return -1;
     }
@@ -219,6 +248,12 @@ be_visitor_amh_operation_ss::visit_attribute (be_attribute *node)
                             node->name ());
 
   int status = 0;
+  bool const coroutine = be_global->gen_amh_coroutines ();
+
+  if (coroutine)
+    {
+      this->open_argument_storage (os);
+    }
 
   {
     be_visitor_context ctx (*this->ctx_);
@@ -233,6 +268,12 @@ be_visitor_amh_operation_ss::visit_attribute (be_attribute *node)
       }
   }
 
+  if (coroutine)
+    {
+      this->close_argument_storage (os);
+      this->refer_to_argument (&the_argument, os);
+    }
+
   *os << be_nl
       << "TAO_InputCDR & _tao_in ="
       << " *_tao_server_request.incoming ();"
@@ -288,7 +329,7 @@ be_visitor_amh_operation_ss::visit_attribute (be_attribute *node)
       }
   }
 
-  if (-1 == this->generate_shared_epilogue (os))
+  if (-1 == this->generate_shared_epilogue (os, coroutine))
     {
       return -1;
     }
@@ -416,11 +457,46 @@ be_visitor_amh_operation_ss::generate_shared_section (be_decl *node,
 }
 
 int
-be_visitor_amh_operation_ss::generate_shared_epilogue (TAO_OutStream *os)
+be_visitor_amh_operation_ss::generate_shared_epilogue (TAO_OutStream *os,
+                                                       bool retain_arguments)
 {
-  *os << be_uidt_nl << ");"
+  *os << be_uidt_nl << ")";
+
+  // The task keeps the arguments until the coroutine returns.
+  if (retain_arguments)
+    {
+      *os << ".retain (_tao_args)";
+    }
+
+  *os << ";"
       << be_uidt << be_uidt_nl
       << "}";
 
   return 0;
 }
+
+void
+be_visitor_amh_operation_ss::open_argument_storage (TAO_OutStream *os)
+{
+  *os << be_nl
+      << "struct _tao_args_type" << be_nl
+      << "{" << be_idt;
+}
+
+void
+be_visitor_amh_operation_ss::close_argument_storage (TAO_OutStream *os)
+{
+  *os << be_uidt_nl
+      << "};" << be_nl_2
+      << "std::shared_ptr<_tao_args_type> _tao_args =" << be_idt_nl
+      << "std::make_shared<_tao_args_type> ();" << be_uidt_nl;
+}
+
+void
+be_visitor_amh_operation_ss::refer_to_argument (be_decl *argument,
+                                                TAO_OutStream *os)
+{
+  *os << be_nl
+      << "auto & " << argument->local_name ()
+      << " = _tao_args->" << argument->local_name () << ";";
+}
@@ -0,0 +1,166 @@
+
+//=============================================================================
+/**
+ *  @file    ami_awaitable_ch.cpp
+ *
+ *  Visitor generating the inline definition of the awaitable AMI
+ *  operation of an IDL operation in the client header.
+ */
+//=============================================================================
+
+#include "operation.h"
+
+be_visitor_operation_ami_awaitable_ch::be_visitor_operation_ami_awaitable_ch (
+    be_visitor_context *ctx)
+  : be_visitor_operation (ctx)
+{
+}
+
+be_visitor_operation_ami_awaitable_ch::~be_visitor_operation_ami_awaitable_ch ()
+{
+}
+
+int
+be_visitor_operation_ami_awaitable_ch::visit_operation (be_operation *node)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+  this->ctx_->node (node);
+
+  be_decl *parent =
+    dynamic_cast<be_scope*> (node->defined_in ())->decl ();
+
+  be_type *bt = dynamic_cast<be_type*> (node->return_type ());
+
+  if (parent == nullptr || bt == nullptr)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_awaitable_ch::"
+                         "visit_operation - "
+                         "bad scope or return type\n"),
+                        -1);
+    }
+
+  *os << be_nl_2 << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__;
+
+  *os << be_nl_2
+      << "inline auto" << be_nl
+      << parent->full_name () << "::async_"
+      << node->original_local_name ()->get_string ();
+
+  // The arguments of the synchronous operation.
+  be_visitor_context ctx (*this->ctx_);
+  be_visitor_operation_arglist oa_visitor (&ctx);
+
+  if (node->accept (&oa_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_awaitable_ch::"
+                         "visit_operation - "
+                         "codegen for argument list failed\n"),
+                        -1);
+    }
+
+  *os << be_nl << "{" << be_idt_nl
+      << "if (!this->is_evaluated ())" << be_idt_nl
+      << "{" << be_idt_nl
+      << "::CORBA::Object::tao_object_initialize (this);"
+      << be_uidt_nl
+      << "}" << be_uidt;
+
+  if (this->gen_pre_stub_info (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_awaitable_ch::"
+                         "visit_operation - "
+                         "codegen for exceptiondata failed\n"),
+                        -1);
+    }
+
+  // The awaitable holds the argument helpers a synchronous stub
+  // would declare, in the same order.
+  *os << be_nl_2
+      << "return ::TAO::Asynch_Awaitable<" << be_idt << be_idt_nl
+      << "TAO::Arg_Traits< ";
+
+  this->gen_arg_template_param_name (node, bt, os);
+
+  *os << ">::ret_val";
+
+  for (UTL_ScopeActiveIterator si (node, UTL_Scope::IK_decls);
+       !si.is_done ();
+       si.next ())
+    {
+      AST_Argument *arg = dynamic_cast<AST_Argument*> (si.item ());
+
+      *os << "," << be_nl
+          << "TAO::Arg_Traits< ";
+
+      this->gen_arg_template_param_name (arg, arg->field_type (), os);
+
+      *os << ">::";
+
+      switch (arg->direction ())
+        {
+        case AST_Argument::dir_IN:
+          *os << "in";
+          break;
+        case AST_Argument::dir_INOUT:
+          *os << "inout";
+          break;
+        case AST_Argument::dir_OUT:
+          *os << "out";
+          break;
+        }
+
+      *os << "_arg_val";
+    }
+
+  ACE_CString opname (node->original_local_name ()->get_string ());
+
+  *os << "> (" << be_uidt_nl
+      << "this," << be_nl
+      << "\"" << opname.c_str () << "\"," << be_nl
+      << opname.length () << "," << be_nl
+      << "TAO::TAO_CO_NONE";
+
+  if (be_global->gen_direct_collocation ())
+    {
+      *os << " | TAO::TAO_CO_DIRECT_STRATEGY";
+    }
+
+  if (be_global->gen_thru_poa_collocation ())
+    {
+      *os << " | TAO::TAO_CO_THRU_POA_STRATEGY";
+    }
+
+  *os << "," << be_nl
+      << (node->has_in_arguments () ? "true" : "false") << "," << be_nl;
+
+  if (node->exceptions ())
+    {
+      *os << "_tao_" << node->flat_name () << "_exceptiondata," << be_nl
+          << node->exceptions ()->length ();
+    }
+  else
+    {
+      *os << "nullptr," << be_nl
+          << "0";
+    }
+
+  for (UTL_ScopeActiveIterator si (node, UTL_Scope::IK_decls);
+       !si.is_done ();
+       si.next ())
+    {
+      AST_Argument *arg = dynamic_cast<AST_Argument*> (si.item ());
+
+      *os << "," << be_nl
+          << arg->local_name ();
+    }
+
+  *os << be_uidt_nl
+      << ");" << be_uidt_nl
+      << "}";
+
+  return 0;
+}
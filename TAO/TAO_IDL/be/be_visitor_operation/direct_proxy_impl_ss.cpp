@@ -97,6 +97,32 @@ be_visitor_operation_direct_proxy_impl_ss::visit_operation (
       << "throw ::CORBA::INTERNAL ();" << be_uidt_nl
       << "}" << be_uidt_nl << be_nl;
 
+  int index = 1;
+
+  // The servant reads struct arguments through views, over the
+  // arguments marshaled here.
+  for (UTL_ScopeActiveIterator si (node, UTL_Scope::IK_decls);
+       !si.is_done ();
+       si.next (), ++index)
+    {
+      AST_Argument *arg = dynamic_cast<AST_Argument*> (si.item ());
+      be_structure *view = be_util::in_view_struct (arg, this->ctx_);
+
+      if (view == nullptr)
+        {
+          continue;
+        }
+
+      *os << "TAO::SArg_Traits< ::" << view->full_name ()
+          << "_View>::in_arg_val _tao_view_" << index << ";" << be_nl
+          << "_tao_view_" << index << ".bind (((TAO::Arg_Traits< ";
+
+      this->gen_arg_template_param_name (arg, arg->field_type (), os);
+
+      *os << ">::in_arg_val *) args[" << index << "])->arg ());"
+          << be_nl << be_nl;
+    }
+
   if (!node->void_return_type ())
     {
       *os << "((TAO::Arg_Traits< ";
@@ -160,6 +186,13 @@ be_visitor_operation_direct_proxy_impl_ss::gen_invoke (
     {
       arg = dynamic_cast<AST_Argument*> (si.item ());
 
+      if (be_util::in_view_struct (arg, this->ctx_) != nullptr)
+        {
+          *os << (index == 1 ? "" : ",") << be_nl
+              << "_tao_view_" << index << ".arg ()";
+          continue;
+        }
+
       *os << (index == 1 ? "" : ",") << be_nl
           << "((TAO::Arg_Traits< ";
 
@@ -96,6 +96,28 @@ be_visitor_operation_ch::visit_operation (be_operation *node)
                         -1);
     }
 
+  /// The awaitable version for coroutines, defined inline at the
+  /// end of the header, once the argument traits are there.
+  if (node->has_ami_awaitable ()
+      && this->ctx_->state () == TAO_CodeGen::TAO_OPERATION_CH)
+    {
+      *os << be_nl_2
+          << "auto async_" << node->original_local_name ()->get_string ();
+
+      ctx = *this->ctx_;
+      ctx.state (TAO_CodeGen::TAO_OPERATION_ARGLIST_CH);
+      be_visitor_operation_arglist aa_visitor (&ctx);
+
+      if (node->accept (&aa_visitor) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%N:%l) be_visitor_operation_ch::"
+                             "visit_operation - "
+                             "codegen for async argument list failed\n"),
+                            -1);
+        }
+    }
+
   be_interface *intf =
     dynamic_cast<be_interface*> (node->defined_in ());
 
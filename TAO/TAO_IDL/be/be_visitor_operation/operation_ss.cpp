@@ -305,9 +305,19 @@ be_visitor_operation_ss::gen_skel_body_arglist (be_operation * node,
       *os << be_nl
           << "TAO::SArg_Traits< ";
 
-      this->gen_arg_template_param_name (arg,
-                                         arg->field_type (),
-                                         os);
+      be_structure *view =
+        be_util::in_view_struct (arg, this->ctx_);
+
+      if (view != nullptr)
+        {
+          *os << "::" << view->full_name () << "_View";
+        }
+      else
+        {
+          this->gen_arg_template_param_name (arg,
+                                             arg->field_type (),
+                                             os);
+        }
 
       *os << ">::";
 
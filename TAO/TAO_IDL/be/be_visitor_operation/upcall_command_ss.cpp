@@ -252,6 +252,38 @@ be_visitor_operation_upcall_command_ss::gen_upcall (
             }
         }
 
+      be_structure *view = be_util::in_view_struct (arg, this->ctx_);
+
+      if (view != nullptr)
+        {
+          // The servant reads the struct through a view of the request.
+          os << "TAO::SArg_Traits< ::" << view->full_name ()
+             << "_View>::in_arg_type arg_" << index << " =" << be_idt_nl;
+
+          if (be_global->gen_thru_poa_collocation ())
+            {
+              os << "TAO::Portable_Server::get_in_view_arg< ";
+
+              this->gen_arg_template_param_name (arg,
+                                                 arg->field_type (),
+                                                 &os);
+
+              os << ", ::" << view->full_name () << "_View> (" << be_idt_nl
+                 << "this->operation_details_," << be_nl
+                 << "this->args_," << be_nl
+                 << index << ");" << be_uidt_nl;
+            }
+          else
+            {
+              os << "static_cast<TAO::SArg_Traits< ::" << view->full_name ()
+                 << "_View>::in_arg_val *> (this->args_[" << index
+                 << "])->arg ();" << be_nl;
+            }
+
+          os << be_uidt_nl;
+          continue;
+        }
+
       os << "TAO::SArg_Traits< ";
 
       this->gen_arg_template_param_name (arg,
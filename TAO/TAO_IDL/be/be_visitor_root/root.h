@@ -56,5 +56,6 @@
 #include "be_visitor_traits.h"
 #include "be_visitor_arg_traits.h"
 #include "be_visitor_template_export.h"
+#include "be_visitor_ami_awaitable.h"
 #include "be_visitor_context.h"
 #include "be_visitor_native.h"
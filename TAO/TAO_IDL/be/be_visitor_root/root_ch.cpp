@@ -109,6 +109,15 @@ be_visitor_root_ch::visit_root (be_root *node)
                         -1);
     }
 
+  if (this->gen_ami_awaitables (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_root_ch::")
+                         ACE_TEXT ("visit_root - failed to ")
+                         ACE_TEXT ("generate awaitable AMI operations\n")),
+                        -1);
+    }
+
 
   (void) tao_cg->end_client_header ();
 
@@ -336,3 +345,15 @@ be_visitor_root_ch::gen_cdr_ops (be_root *node)
   return status;
 }
 
+int
+be_visitor_root_ch::gen_ami_awaitables (be_root *node)
+{
+  if (!be_global->ami_call_back () || !be_global->gen_ami_coroutines ())
+    {
+      return 0;
+    }
+
+  be_visitor_context ctx = *this->ctx_;
+  be_visitor_ami_awaitable awaitable_visitor (&ctx);
+  return node->accept (&awaitable_visitor);
+}
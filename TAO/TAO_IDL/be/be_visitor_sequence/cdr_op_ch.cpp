@@ -109,6 +109,16 @@ be_visitor_sequence_cdr_op_ch::visit_sequence (be_sequence *node)
 
   *os << " &_tao_sequence);" << be_uidt << be_uidt;
 
+  if (!alt && be_global->cdr_size_support () && node->cdr_sizable ())
+    {
+      *os << be_nl
+          << be_global->stub_export_macro () << " ::CORBA::Boolean"
+          << " operator<< (" << be_idt << be_idt_nl
+          << "ACE_SizeCDR &strm," << be_nl
+          << "const " << node->name () << " &_tao_sequence);"
+          << be_uidt << be_uidt;
+    }
+
   if (be_global->gen_ostream_operators ())
     {
       *os << be_nl_2
@@ -138,7 +138,21 @@ be_visitor_sequence_cdr_op_cs::visit_sequence (be_sequence *node)
           << "return TAO::marshal_sequence(strm, _tao_sequence);"
           << be_uidt_nl
           << "}" << be_nl_2;
+
+      if (be_global->cdr_size_support () && node->cdr_sizable ())
+        {
+          *os << "::CORBA::Boolean operator<< ("
+              << be_idt << be_idt_nl
+              << "ACE_SizeCDR &strm," << be_nl
+              << "const " << node->name () << " &_tao_sequence)"
+              << be_uidt
+              << be_uidt_nl
+              << "{" << be_idt_nl
+              << "return TAO::marshal_sequence(strm, _tao_sequence);"
+              << be_uidt_nl
+              << "}" << be_nl_2;
         }
+    }
 
   //  Set the sub state as generating code for the input operator.
   this->ctx_->sub_state(TAO_CodeGen::TAO_CDR_INPUT);
@@ -52,6 +52,13 @@ be_visitor_structure_cdr_op_ch::visit_structure (be_structure *node)
       << " operator>> (TAO_InputCDR &, "
       << node->name () << " &);" << be_nl;
 
+  if (be_global->cdr_size_support () && node->cdr_sizable ())
+    {
+      *os << be_global->stub_export_macro () << " ::CORBA::Boolean"
+          << " operator<< (ACE_SizeCDR &, const " << node->name ()
+          << " &);" << be_nl;
+    }
+
   if (be_global->gen_ostream_operators ())
     {
       *os << be_global->stub_export_macro () << " std::ostream&"
@@ -74,6 +81,167 @@ be_visitor_structure_cdr_op_ch::visit_structure (be_structure *node)
     }
 
 
+  ACE_CDR::ULong size = 0;
+  ACE_CDR::ULong alignment = 0;
+
+  if (node->cdr_bulk_layout (size, alignment))
+    {
+      this->gen_bulk_traits (node, size, alignment);
+    }
+
   node->cli_hdr_cdr_op_gen (true);
   return 0;
 }
+
+void
+be_visitor_structure_cdr_op_ch::gen_bulk_traits (be_structure *node,
+                                                 ACE_CDR::ULong size,
+                                                 ACE_CDR::ULong alignment)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  *os << be_nl_2 << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__ << be_nl;
+
+  *os << be_global->core_versioning_begin () << be_nl;
+
+  *os << "namespace TAO" << be_nl
+      << "{" << be_idt_nl
+      << "template<>" << be_nl
+      << "struct CDR_Bulk_Traits< ::" << node->name () << ">" << be_nl
+      << "{" << be_idt_nl
+      << "static bool const is_bulk =" << be_idt_nl
+      << "sizeof ( ::" << node->name () << ") == " << size;
+
+  // The C++ compiler checks that the members are where CDR puts
+  // them; if not, they are marshaled one at a time.  Swapping the
+  // bytes of a member is done in one call for all of them when they
+  // all have the same primitive type size.
+  ACE_CDR::ULong offset = 0;
+  ACE_CDR::ULong uniform_size = 0;
+  bool uniform = true;
+
+  for (ACE_CDR::ULong i = 0; i < node->nfields (); ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+
+      ACE_CDR::ULong member_size = 0;
+      ACE_CDR::ULong member_alignment = 0;
+      ACE_CDR::ULong count = 0;
+      be_structure *nested = nullptr;
+
+      be_structure::cdr_bulk_member ((*f)->field_type (),
+                                     member_size,
+                                     member_alignment,
+                                     count,
+                                     nested);
+
+      offset = (offset + member_alignment - 1) & ~(member_alignment - 1);
+
+      *os << be_nl
+          << "&& offsetof ( ::" << node->name () << ", "
+          << (*f)->local_name () << ") == " << offset;
+
+      if (nested != nullptr)
+        {
+          *os << be_nl
+              << "&& CDR_Bulk_Traits< ::" << nested->name ()
+              << ">::is_bulk";
+          uniform = false;
+        }
+      else if (uniform_size == 0)
+        {
+          uniform_size = member_size;
+        }
+      else if (uniform_size != member_size)
+        {
+          uniform = false;
+        }
+
+      offset += member_size * count;
+    }
+
+  *os << ";" << be_uidt_nl
+      << "static ::CORBA::ULong const alignment = " << alignment << ";"
+      << be_nl_2
+      << "static void swap (" << be_idt << be_idt_nl
+      << "char const *orig," << be_nl
+      << "char *target," << be_nl
+      << "::CORBA::ULong length)" << be_uidt << be_uidt_nl
+      << "{" << be_idt_nl;
+
+  if (uniform && uniform_size == 1)
+    {
+      *os << "ACE_OS::memcpy (target, orig, length * " << size << ");";
+    }
+  else if (uniform)
+    {
+      *os << "ACE_CDR::swap_" << uniform_size << "_array (orig, target, "
+          << "length * " << size / uniform_size << ");";
+    }
+  else
+    {
+      *os << "for ( ::CORBA::ULong i = 0; i < length; ++i)" << be_idt_nl
+          << "{" << be_idt_nl
+          << "char const *o = orig + i * " << size << ";" << be_nl
+          << "char *t = target + i * " << size << ";";
+
+      offset = 0;
+
+      for (ACE_CDR::ULong i = 0; i < node->nfields (); ++i)
+        {
+          AST_Field **f = nullptr;
+          node->field (f, i);
+
+          ACE_CDR::ULong member_size = 0;
+          ACE_CDR::ULong member_alignment = 0;
+          ACE_CDR::ULong count = 0;
+          be_structure *nested = nullptr;
+
+          be_structure::cdr_bulk_member ((*f)->field_type (),
+                                         member_size,
+                                         member_alignment,
+                                         count,
+                                         nested);
+
+          offset = (offset + member_alignment - 1) & ~(member_alignment - 1);
+
+          *os << be_nl;
+
+          if (nested != nullptr)
+            {
+              *os << "CDR_Bulk_Traits< ::" << nested->name ()
+                  << ">::swap (o + " << offset << ", t + " << offset
+                  << ", " << count << ");";
+            }
+          else if (member_size == 1)
+            {
+              *os << "ACE_OS::memcpy (t + " << offset << ", o + "
+                  << offset << ", " << count << ");";
+            }
+          else if (count == 1)
+            {
+              *os << "ACE_CDR::swap_" << member_size << " (o + " << offset
+                  << ", t + " << offset << ");";
+            }
+          else
+            {
+              *os << "ACE_CDR::swap_" << member_size << "_array (o + "
+                  << offset << ", t + " << offset << ", " << count << ");";
+            }
+
+          offset += member_size * count;
+        }
+
+      *os << be_uidt_nl
+          << "}" << be_uidt;
+    }
+
+  *os << be_uidt_nl
+      << "}" << be_uidt_nl
+      << "};" << be_uidt_nl
+      << "}" << be_nl;
+
+  *os << be_global->core_versioning_end () << be_nl;
+}
@@ -50,40 +50,20 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
 
   *os << be_global->core_versioning_begin () << be_nl;
 
-  //  Set the sub state as generating code for the output operator.
-  this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_OUTPUT);
-
-  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
-      << "TAO_OutputCDR &strm," << be_nl
-      << "const " << node->name () << " &_tao_aggregate)" << be_uidt
-      << be_uidt_nl
-      << "{" << be_idt_nl;
-
-  be_visitor_context new_ctx (*this->ctx_);
-  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
-
-  if (field_decl.visit_scope (node) == -1)
+  if (this->gen_output_operator (node, false) == -1)
     {
-      ACE_ERROR_RETURN ((LM_ERROR,
-                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
-                         ACE_TEXT ("visit_structure - ")
-                         ACE_TEXT ("codegen for field decl failed\n")),
-                        -1);
+      return -1;
     }
 
-  *os << "return" << be_idt_nl;
-
-  if (this->visit_scope (node) == -1)
+  if (be_global->cdr_size_support ()
+      && node->cdr_sizable ()
+      && this->gen_output_operator (node, true) == -1)
     {
-      ACE_ERROR_RETURN ((LM_ERROR,
-                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
-                         ACE_TEXT ("visit_structure - ")
-                         ACE_TEXT ("codegen for scope failed\n")),
-                        -1);
+      return -1;
     }
 
-  *os << ";" << be_uidt << be_uidt_nl
-      << "}" << be_nl_2;
+  be_visitor_context new_ctx (*this->ctx_);
+  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
 
   // Set the substate as generating code for the input operator.
   this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_INPUT);
@@ -153,6 +133,68 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
   return 0;
 }
 
+int
+be_visitor_structure_cdr_op_cs::gen_output_operator (be_structure *node,
+                                                     bool sizing)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  //  Set the sub state as generating code for the output operator.
+  this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_OUTPUT);
+
+  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
+      << (sizing ? "ACE_SizeCDR" : "TAO_OutputCDR") << " &strm," << be_nl
+      << "const " << node->name () << " &";
+
+  ACE_CDR::ULong size = 0;
+  ACE_CDR::ULong alignment = 0;
+
+  if (sizing && node->cdr_bulk_layout (size, alignment))
+    {
+      // The size of a struct laid out as in memory is a constant.
+      *os << ")" << be_uidt
+          << be_uidt_nl
+          << "{" << be_idt_nl
+          << "strm.adjust (" << size << ", " << alignment << ");" << be_nl
+          << "return strm.good_bit ();" << be_uidt_nl
+          << "}" << be_nl_2;
+
+      return 0;
+    }
+
+  *os << "_tao_aggregate)" << be_uidt
+      << be_uidt_nl
+      << "{" << be_idt_nl;
+
+  be_visitor_context new_ctx (*this->ctx_);
+  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
+
+  if (field_decl.visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
+                         ACE_TEXT ("gen_output_operator - ")
+                         ACE_TEXT ("codegen for field decl failed\n")),
+                        -1);
+    }
+
+  *os << "return" << be_idt_nl;
+
+  if (this->visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
+                         ACE_TEXT ("gen_output_operator - ")
+                         ACE_TEXT ("codegen for scope failed\n")),
+                        -1);
+    }
+
+  *os << ";" << be_uidt << be_uidt_nl
+      << "}" << be_nl_2;
+
+  return 0;
+}
+
 int
 be_visitor_structure_cdr_op_cs::post_process (be_decl *bd)
 {
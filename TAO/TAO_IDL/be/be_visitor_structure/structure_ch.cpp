@@ -84,6 +84,21 @@ int be_visitor_structure_ch::visit_structure (be_structure *node)
         }
     }
 
+  if (be_global->gen_views ())
+    {
+      be_visitor_context ctx (*this->ctx_);
+      be_visitor_structure_view_ch visitor (&ctx);
+
+      if (visitor.visit_structure (node) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("be_visitor_structure_ch::")
+                             ACE_TEXT ("visit_structure - ")
+                             ACE_TEXT ("view declaration failed\n")),
+                            -1);
+        }
+    }
+
   node->cli_hdr_gen (true);
   return 0;
 }
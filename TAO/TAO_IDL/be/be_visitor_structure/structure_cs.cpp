@@ -79,6 +79,21 @@ be_visitor_structure_cs::visit_structure (be_structure *node)
                         -1);
     }
 
+  if (be_global->gen_views ())
+    {
+      be_visitor_context ctx (*this->ctx_);
+      be_visitor_structure_view_cs visitor (&ctx);
+
+      if (visitor.visit_structure (node) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%N:%l) be_visitor_structure_cs::"
+                             "visit_structure - "
+                             "view definition failed\n"),
+                            -1);
+        }
+    }
+
   node->cli_stub_gen (true);
   return 0;
 }
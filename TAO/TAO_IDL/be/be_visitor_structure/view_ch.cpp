@@ -0,0 +1,209 @@
+
+//=============================================================================
+/**
+ *  @file    view_ch.cpp
+ *
+ *  Visitor generating the declaration of the read-only view of a
+ *  Structure (-Gview) in the client header.
+ */
+//=============================================================================
+
+#include "structure.h"
+
+#include "ast_sequence.h"
+#include "ast_structure_fwd.h"
+
+// ******************************************************
+// for client header
+// ******************************************************
+
+be_visitor_structure_view_ch::be_visitor_structure_view_ch (
+    be_visitor_context *ctx)
+  : be_visitor_structure (ctx)
+{
+}
+
+be_visitor_structure_view_ch::~be_visitor_structure_view_ch ()
+{
+}
+
+int
+be_visitor_structure_view_ch::visit_structure (be_structure *node)
+{
+  if (!node->has_view ())
+    {
+      return 0;
+    }
+
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  *os << be_nl_2;
+
+  *os << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__;
+
+  *os << be_nl_2
+      << "class " << be_global->stub_export_macro () << " "
+      << node->local_name () << "_View" << be_idt_nl
+      << ": public ::TAO::View_Base" << be_uidt_nl
+      << "{" << be_nl
+      << "public:" << be_idt_nl
+      << node->local_name () << "_View ();" << be_nl;
+
+  ACE_CDR::ULong const nfields = node->nfields ();
+
+  for (ACE_CDR::ULong i = 0; i < nfields; ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+      AST_Type *ft = (*f)->field_type ();
+      Identifier *name = (*f)->local_name ();
+
+      *os << be_nl;
+
+      switch (be_structure::view_member (ft))
+        {
+        case be_structure::VIEW_BASIC:
+        case be_structure::VIEW_STRING:
+        case be_structure::VIEW_WSTRING:
+          *os << view_type (ft) << " " << name << " () const;";
+          break;
+        case be_structure::VIEW_STRUCT:
+        case be_structure::VIEW_SEQUENCE:
+          *os << "const " << view_type (ft) << " &" << name
+              << " () const;";
+          break;
+        default:
+          if (ft->unaliased_type ()->node_type () == AST_Decl::NT_array)
+            {
+              *os << "void " << name << " (::" << ft->full_name ()
+                  << " _tao_x) const;";
+            }
+          else
+            {
+              *os << "void " << name << " (::" << ft->full_name ()
+                  << " &_tao_x) const;";
+            }
+          break;
+        }
+    }
+
+  *os << be_nl_2
+      << "/// Demarshal a copy of the whole struct." << be_nl
+      << "void _decode (::" << node->name ()
+      << " &_tao_aggregate) const;" << be_nl_2
+      << "::CORBA::Boolean _tao_bind (TAO_InputCDR &strm);" << be_nl
+      << "void _tao_bind (const ::TAO::View_Base &outer, size_t pos);"
+      << be_nl
+      << "static ::CORBA::Boolean _tao_skip (TAO_InputCDR &strm);"
+      << be_uidt_nl << be_nl
+      << "private:" << be_idt_nl
+      << "static ::CORBA::Boolean _tao_skip_member (" << be_idt << be_idt_nl
+      << "TAO_InputCDR &strm," << be_nl
+      << "::CORBA::ULong member);" << be_uidt << be_uidt_nl
+      << "size_t _tao_offset (::CORBA::ULong member) const;" << be_nl
+      << "void _tao_reset ();" << be_nl_2
+      << "mutable size_t _tao_offsets[" << nfields << "];" << be_nl
+      << "mutable ::CORBA::ULong _tao_known;";
+
+  for (ACE_CDR::ULong i = 0; i < nfields; ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+      AST_Type *ft = (*f)->field_type ();
+
+      if (!view_cached (ft))
+        {
+          continue;
+        }
+
+      *os << be_nl << "mutable ";
+
+      switch (be_structure::view_member (ft))
+        {
+        case be_structure::VIEW_STRING:
+          *os << "::CORBA::String_var";
+          break;
+        case be_structure::VIEW_WSTRING:
+          *os << "::CORBA::WString_var";
+          break;
+        default:
+          *os << view_type (ft);
+          break;
+        }
+
+      *os << " _tao_cache_" << (*f)->local_name () << ";";
+    }
+
+  *os << be_uidt_nl
+      << "};";
+
+  return 0;
+}
+
+ACE_CString
+be_visitor_structure_view_ch::view_type (AST_Type *type)
+{
+  AST_Type *ut = type->unaliased_type ();
+
+  if (ut->node_type () == AST_Decl::NT_struct_fwd)
+    {
+      ut = dynamic_cast<AST_StructureFwd*> (ut)->full_definition ();
+    }
+
+  ACE_CString result;
+
+  switch (be_structure::view_member (type))
+    {
+    case be_structure::VIEW_STRING:
+      result = "const ::CORBA::Char *";
+      break;
+    case be_structure::VIEW_WSTRING:
+      result = "const ::CORBA::WChar *";
+      break;
+    case be_structure::VIEW_STRUCT:
+      result = "::";
+      result += ut->full_name ();
+      result += "_View";
+      break;
+    case be_structure::VIEW_SEQUENCE:
+      {
+        AST_Type *bt = dynamic_cast<AST_Sequence*> (ut)->base_type ();
+        ACE_CString const element = view_type (bt);
+
+        result = "::TAO::Sequence_View< ";
+        result += element;
+
+        if (bt->unaliased_type ()->node_type () == AST_Decl::NT_enum)
+          {
+            result += ", ::TAO::View_Enum_Traits< ";
+            result += element;
+            result += ">";
+          }
+
+        result += ">";
+      }
+      break;
+    default:
+      result = "::";
+      result += type->full_name ();
+      break;
+    }
+
+  return result;
+}
+
+bool
+be_visitor_structure_view_ch::view_cached (AST_Type *type)
+{
+  switch (be_structure::view_member (type))
+    {
+    case be_structure::VIEW_STRING:
+    case be_structure::VIEW_WSTRING:
+    case be_structure::VIEW_STRUCT:
+    case be_structure::VIEW_SEQUENCE:
+      return true;
+    default:
+      return false;
+    }
+}
@@ -0,0 +1,362 @@
+
+//=============================================================================
+/**
+ *  @file    view_cs.cpp
+ *
+ *  Visitor generating the definition of the read-only view of a
+ *  Structure (-Gview) in the client stub.
+ */
+//=============================================================================
+
+#include "structure.h"
+
+#include "ast_predefined_type.h"
+
+// ***************************************************************************
+// For client stubs.
+// ***************************************************************************
+
+be_visitor_structure_view_cs::be_visitor_structure_view_cs (
+    be_visitor_context *ctx)
+  : be_visitor_structure (ctx)
+{
+}
+
+be_visitor_structure_view_cs::~be_visitor_structure_view_cs ()
+{
+}
+
+int
+be_visitor_structure_view_cs::visit_structure (be_structure *node)
+{
+  if (!node->has_view ())
+    {
+      return 0;
+    }
+
+  TAO_OutStream *os = this->ctx_->stream ();
+  ACE_CDR::ULong const nfields = node->nfields ();
+
+  *os << be_nl_2;
+
+  *os << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__;
+
+  *os << be_nl_2
+      << node->name () << "_View::" << node->local_name ()
+      << "_View ()" << be_idt_nl
+      << ": _tao_known (0)" << be_uidt_nl
+      << "{" << be_nl
+      << "}";
+
+  for (ACE_CDR::ULong i = 0; i < nfields; ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+      this->gen_accessor (os, node, *f, i);
+    }
+
+  *os << be_nl_2
+      << "void" << be_nl
+      << node->name () << "_View::_decode (" << be_idt << be_idt_nl
+      << "::" << node->name () << " &_tao_aggregate) const" << be_uidt
+      << be_uidt_nl
+      << "{" << be_idt_nl
+      << "::TAO::View_Reader _tao_strm (*this, this->_tao_start ());"
+      << be_nl_2
+      << "if (!(_tao_strm >> _tao_aggregate))" << be_idt_nl
+      << "{" << be_idt_nl
+      << "throw ::CORBA::MARSHAL ();" << be_uidt_nl
+      << "}" << be_uidt << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "::CORBA::Boolean" << be_nl
+      << node->name () << "_View::_tao_bind (TAO_InputCDR &strm)" << be_nl
+      << "{" << be_idt_nl
+      << "this->_tao_reset ();" << be_nl
+      << "return" << be_idt_nl
+      << "this->_tao_bind_members (strm," << be_nl
+      << "                         this->_tao_offsets," << be_nl
+      << "                         this->_tao_known," << be_nl
+      << "                         " << nfields << "," << be_nl
+      << "                         _tao_skip_member);" << be_uidt
+      << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "void" << be_nl
+      << node->name () << "_View::_tao_bind (" << be_idt << be_idt_nl
+      << "const ::TAO::View_Base &outer," << be_nl
+      << "size_t pos)" << be_uidt << be_uidt_nl
+      << "{" << be_idt_nl
+      << "this->_tao_reset ();" << be_nl
+      << "this->_tao_bind_i (outer, pos);" << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "::CORBA::Boolean" << be_nl
+      << node->name () << "_View::_tao_skip (TAO_InputCDR &strm)" << be_nl
+      << "{" << be_idt_nl
+      << "return _tao_skip_members (strm, " << nfields
+      << ", _tao_skip_member);" << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "::CORBA::Boolean" << be_nl
+      << node->name () << "_View::_tao_skip_member (" << be_idt << be_idt_nl
+      << "TAO_InputCDR &strm," << be_nl
+      << "::CORBA::ULong member)" << be_uidt << be_uidt_nl
+      << "{" << be_idt_nl
+      << "switch (member)" << be_idt_nl
+      << "{";
+
+  for (ACE_CDR::ULong i = 0; i < nfields; ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+
+      *os << be_nl
+          << "case " << i << ":" << be_idt;
+
+      this->gen_skip (os, (*f)->field_type ());
+
+      *os << be_uidt;
+    }
+
+  *os << be_nl
+      << "default:" << be_idt_nl
+      << "return false;" << be_uidt_nl
+      << "}" << be_uidt << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "size_t" << be_nl
+      << node->name () << "_View::_tao_offset (::CORBA::ULong member) const"
+      << be_nl
+      << "{" << be_idt_nl
+      << "return" << be_idt_nl
+      << "this->_tao_member_offset (member," << be_nl
+      << "                          this->_tao_offsets," << be_nl
+      << "                          this->_tao_known," << be_nl
+      << "                          _tao_skip_member);" << be_uidt
+      << be_uidt_nl
+      << "}";
+
+  *os << be_nl_2
+      << "void" << be_nl
+      << node->name () << "_View::_tao_reset ()" << be_nl
+      << "{" << be_idt_nl
+      << "this->_tao_known = 0;";
+
+  for (ACE_CDR::ULong i = 0; i < nfields; ++i)
+    {
+      AST_Field **f = nullptr;
+      node->field (f, i);
+
+      switch (be_structure::view_member ((*f)->field_type ()))
+        {
+        case be_structure::VIEW_STRUCT:
+        case be_structure::VIEW_SEQUENCE:
+          *os << be_nl
+              << "this->_tao_cache_" << (*f)->local_name ()
+              << "._tao_unbind ();";
+          break;
+        default:
+          break;
+        }
+    }
+
+  *os << be_uidt_nl
+      << "}";
+
+  return 0;
+}
+
+void
+be_visitor_structure_view_cs::gen_skip (TAO_OutStream *os, AST_Type *type)
+{
+  AST_Type *ut = type->unaliased_type ();
+
+  switch (be_structure::view_member (type))
+    {
+    case be_structure::VIEW_BASIC:
+      if (ut->node_type () == AST_Decl::NT_enum)
+        {
+          *os << be_nl << "return strm.skip_ulong ();";
+          return;
+        }
+
+      switch (dynamic_cast<AST_PredefinedType*> (ut)->pt ())
+        {
+        case AST_PredefinedType::PT_long:
+          *os << be_nl << "return strm.skip_long ();";
+          return;
+        case AST_PredefinedType::PT_ulong:
+          *os << be_nl << "return strm.skip_ulong ();";
+          return;
+        case AST_PredefinedType::PT_longlong:
+          *os << be_nl << "return strm.skip_longlong ();";
+          return;
+        case AST_PredefinedType::PT_ulonglong:
+          *os << be_nl << "return strm.skip_ulonglong ();";
+          return;
+        case AST_PredefinedType::PT_short:
+          *os << be_nl << "return strm.skip_short ();";
+          return;
+        case AST_PredefinedType::PT_ushort:
+          *os << be_nl << "return strm.skip_ushort ();";
+          return;
+        case AST_PredefinedType::PT_float:
+          *os << be_nl << "return strm.skip_float ();";
+          return;
+        case AST_PredefinedType::PT_double:
+          *os << be_nl << "return strm.skip_double ();";
+          return;
+        case AST_PredefinedType::PT_longdouble:
+          *os << be_nl << "return strm.skip_longdouble ();";
+          return;
+        case AST_PredefinedType::PT_char:
+          *os << be_nl << "return strm.skip_char ();";
+          return;
+        case AST_PredefinedType::PT_wchar:
+          *os << be_nl << "return strm.skip_wchar ();";
+          return;
+        case AST_PredefinedType::PT_boolean:
+          *os << be_nl << "return strm.skip_boolean ();";
+          return;
+        default:
+          *os << be_nl << "return strm.skip_octet ();";
+          return;
+        }
+    case be_structure::VIEW_STRING:
+      *os << be_nl << "return strm.skip_string ();";
+      return;
+    case be_structure::VIEW_WSTRING:
+      *os << be_nl << "return strm.skip_wstring ();";
+      return;
+    case be_structure::VIEW_STRUCT:
+    case be_structure::VIEW_SEQUENCE:
+      *os << be_nl
+          << "return "
+          << be_visitor_structure_view_ch::view_type (type)
+          << "::_tao_skip (strm);";
+      return;
+    default:
+      break;
+    }
+
+  // Demarshal the member into a temporary.
+  *os << be_nl
+      << "{" << be_idt_nl
+      << "::" << type->full_name () << " _tao_x;" << be_nl;
+
+  if (ut->node_type () == AST_Decl::NT_array)
+    {
+      *os << "::" << type->full_name () << "_forany _tao_fx (_tao_x);"
+          << be_nl
+          << "return strm >> _tao_fx;";
+    }
+  else
+    {
+      *os << "return strm >> _tao_x;";
+    }
+
+  *os << be_uidt_nl
+      << "}";
+}
+
+void
+be_visitor_structure_view_cs::gen_accessor (TAO_OutStream *os,
+                                            be_structure *node,
+                                            AST_Field *f,
+                                            ACE_CDR::ULong index)
+{
+  AST_Type *ft = f->field_type ();
+  AST_Type *ut = ft->unaliased_type ();
+  Identifier *name = f->local_name ();
+  ACE_CString const type = be_visitor_structure_view_ch::view_type (ft);
+
+  *os << be_nl_2;
+
+  switch (be_structure::view_member (ft))
+    {
+    case be_structure::VIEW_BASIC:
+      *os << type << be_nl
+          << node->name () << "_View::" << name << " () const" << be_nl
+          << "{" << be_idt_nl
+          << "return" << be_idt_nl
+          << "::TAO::"
+          << (ut->node_type () == AST_Decl::NT_enum
+                ? "View_Enum_Traits< "
+                : "View_Element_Traits< ")
+          << type << ">::get (" << be_idt << be_idt_nl
+          << "*this," << be_nl
+          << "this->_tao_offset (" << index << "));" << be_uidt << be_uidt
+          << be_uidt << be_uidt_nl
+          << "}";
+      return;
+    case be_structure::VIEW_STRING:
+    case be_structure::VIEW_WSTRING:
+      *os << type << be_nl
+          << node->name () << "_View::" << name << " () const" << be_nl
+          << "{" << be_idt_nl
+          << "return" << be_idt_nl
+          << "this->"
+          << (be_structure::view_member (ft) == be_structure::VIEW_STRING
+                ? "_tao_string"
+                : "_tao_wstring")
+          << " (this->_tao_offset (" << index << ")," << be_nl
+          << "                    this->_tao_cache_" << name << ");"
+          << be_uidt << be_uidt_nl
+          << "}";
+      return;
+    case be_structure::VIEW_STRUCT:
+    case be_structure::VIEW_SEQUENCE:
+      *os << "const " << type << " &" << be_nl
+          << node->name () << "_View::" << name << " () const" << be_nl
+          << "{" << be_idt_nl
+          << "if (!this->_tao_cache_" << name << "._tao_is_bound ())"
+          << be_idt_nl
+          << "{" << be_idt_nl
+          << "this->_tao_cache_" << name << "._tao_bind (" << be_idt
+          << be_idt_nl
+          << "*this," << be_nl
+          << "this->_tao_offset (" << index << "));" << be_uidt << be_uidt
+          << be_uidt_nl
+          << "}" << be_uidt_nl << be_nl
+          << "return this->_tao_cache_" << name << ";" << be_uidt_nl
+          << "}";
+      return;
+    default:
+      break;
+    }
+
+  bool const array = ut->node_type () == AST_Decl::NT_array;
+
+  *os << "void" << be_nl
+      << node->name () << "_View::" << name << " (" << be_idt << be_idt_nl
+      << "::" << ft->full_name () << (array ? " " : " &") << "_tao_x) const"
+      << be_uidt << be_uidt_nl
+      << "{" << be_idt_nl
+      << "::TAO::View_Reader _tao_strm (*this, this->_tao_offset ("
+      << index << "));" << be_nl;
+
+  if (array)
+    {
+      *os << "::" << ft->full_name () << "_forany _tao_fx (_tao_x);"
+          << be_nl_2
+          << "if (!(_tao_strm >> _tao_fx))";
+    }
+  else
+    {
+      *os << be_nl
+          << "if (!(_tao_strm >> _tao_x))";
+    }
+
+  *os << be_idt_nl
+      << "{" << be_idt_nl
+      << "throw ::CORBA::MARSHAL ();" << be_uidt_nl
+      << "}" << be_uidt << be_uidt_nl
+      << "}";
+}
@@ -38,6 +38,14 @@ be_visitor_structure_fwd_ch::visit_structure_fwd (be_structure_fwd *node)
   // This will be a no-op if it has already been done for this node.
   fd->gen_common_varout (os);
 
+  // The views of other structs may refer to the view of this one
+  // before it is declared.
+  if (fd->has_view () && !fd->cli_hdr_gen ())
+    {
+      *os << be_nl_2
+          << "class " << fd->local_name () << "_View;";
+    }
+
   node->cli_hdr_gen (true);
   return 0;
 }
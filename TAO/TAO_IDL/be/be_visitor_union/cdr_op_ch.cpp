@@ -46,6 +46,13 @@ be_visitor_union_cdr_op_ch::visit_union (be_union *node)
       << " operator>> (TAO_InputCDR &, "
       << node->name () << " &);" << be_nl;
 
+  if (be_global->cdr_size_support () && node->cdr_sizable ())
+    {
+      *os << be_global->stub_export_macro () << " ::CORBA::Boolean"
+          << " operator<< (ACE_SizeCDR &, const " << node->name ()
+          << " &);" << be_nl;
+    }
+
   if (be_global->gen_ostream_operators ())
     {
       *os << be_global->stub_export_macro () << " std::ostream&"
@@ -75,37 +75,54 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
 
   *os << be_global->core_versioning_begin () << be_nl;
 
-  //  Set the sub state as generating code for the output operator.
-  this->ctx_->sub_state(TAO_CodeGen::TAO_CDR_OUTPUT);
+  if (this->gen_output_operator (node, false) == -1)
+    {
+      return -1;
+    }
 
-  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
-      << "TAO_OutputCDR &strm," << be_nl
-      << "const " << node->name () << " &_tao_union" << be_uidt_nl
+  if (be_global->cdr_size_support ()
+      && node->cdr_sizable ()
+      && this->gen_output_operator (node, true) == -1)
+    {
+      return -1;
+    }
+
+  bool const boolDisc = node->udisc_type () == AST_Expression::EV_bool;
+
+  // Set the substate as generating code for the input operator.
+  this->ctx_->sub_state(TAO_CodeGen::TAO_CDR_INPUT);
+  *os << "::CORBA::Boolean operator>> (" << be_idt << be_idt_nl
+      << "TAO_InputCDR &strm," << be_nl
+      << node->name () << " &_tao_union" << be_uidt_nl
       << ")" << be_uidt_nl
       << "{" << be_idt_nl;
 
-  bool boolDisc = false;
+  be_type* disc_type =
+    dynamic_cast<be_type*> (node->disc_type ());
+
+  // Generate a temporary to store the discriminant
+  *os << disc_type->full_name ()
+      << " " << "_tao_discriminant;" << be_nl;
 
   switch (node->udisc_type ())
     {
       case AST_Expression::EV_bool:
-        boolDisc = true;
-        *os << "::ACE_OutputCDR::from_boolean tmp (_tao_union._d ());" << be_nl
-            << "if ( !(strm << tmp) )" << be_idt_nl;
+        *os << "::ACE_InputCDR::to_boolean tmp (_tao_discriminant);" << be_nl
+            << "if ( !(strm >> tmp) )" << be_idt_nl;
 
         break;
       case AST_Expression::EV_char:
-        *os << "::ACE_OutputCDR::from_char tmp (_tao_union._d ());" << be_nl
-            << "if ( !(strm << tmp) )" << be_idt_nl;
+        *os << "::ACE_InputCDR::to_char tmp (_tao_discriminant);" << be_nl
+            << "if ( !(strm >> tmp) )" << be_idt_nl;
 
         break;
       case AST_Expression::EV_wchar:
-        *os << "::ACE_OutputCDR::from_wchar tmp (_tao_union._d ());" << be_nl
-            << "if ( !(strm << tmp) )" << be_idt_nl;
+        *os << "::ACE_InputCDR::to_wchar tmp (_tao_discriminant);" << be_nl
+            << "if ( !(strm >> tmp) )" << be_idt_nl;
 
         break;
       default:
-        *os << "if ( !(strm << _tao_union._d ()) )" << be_idt_nl;
+        *os << "if ( !(strm >> _tao_discriminant) )" << be_idt_nl;
 
         break;
     }
@@ -115,9 +132,17 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
       << "}" << be_uidt_nl << be_nl
       << "::CORBA::Boolean result = true;" << be_nl_2;
 
-  if (!boolDisc)
+  if (boolDisc)
     {
-      *os << "switch (_tao_union._d ())" << be_nl
+      if (node->gen_empty_default_label ())
+        {
+          *os << "_tao_union._default ();" << be_nl
+              << "_tao_union._d (_tao_discriminant);" << be_nl;
+        }
+    }
+  else
+    {
+      *os << "switch (_tao_discriminant)" << be_nl
           << "{" << be_idt;
     }
 
@@ -138,8 +163,12 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
   // an enum, this does no harm.
   if (!boolDisc && node->gen_empty_default_label ())
     {
-      *os << be_nl << "default:" << be_idt_nl;
-      *os << "break;"<< be_uidt;
+      *os << be_nl;
+      *os << "default:" << be_idt_nl;
+      *os << "_tao_union._default ();" << be_nl;
+      *os << "// For maximum interop compatibility, force the same value as transmitted" << be_nl;
+      *os << "_tao_union._d (_tao_discriminant);" << be_nl;
+      *os << "break;" << be_uidt;
     }
 
   if (!boolDisc)
@@ -148,42 +177,58 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
     }
 
   *os << "return result;" << be_uidt_nl
-      << "}" << be_nl_2;
+      << "}" << be_nl;
 
-  // Set the substate as generating code for the input operator.
-  this->ctx_->sub_state(TAO_CodeGen::TAO_CDR_INPUT);
-  *os << "::CORBA::Boolean operator>> (" << be_idt << be_idt_nl
-      << "TAO_InputCDR &strm," << be_nl
-      << node->name () << " &_tao_union" << be_uidt_nl
+  bool use_underscore = (this->ctx_->tdef () == nullptr);
+
+  if (be_global->gen_ostream_operators ())
+    {
+      node->gen_ostream_operator (os, use_underscore);
+    }
+
+  *os << be_global->core_versioning_end () << be_nl;
+
+  node->cli_stub_cdr_op_gen (true);
+  return 0;
+}
+
+int
+be_visitor_union_cdr_op_cs::gen_output_operator (be_union *node,
+                                                 bool sizing)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  //  Set the sub state as generating code for the output operator.
+  this->ctx_->sub_state(TAO_CodeGen::TAO_CDR_OUTPUT);
+
+  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
+      << (sizing ? "ACE_SizeCDR" : "TAO_OutputCDR") << " &strm," << be_nl
+      << "const " << node->name () << " &_tao_union" << be_uidt_nl
       << ")" << be_uidt_nl
       << "{" << be_idt_nl;
 
-  be_type* disc_type =
-    dynamic_cast<be_type*> (node->disc_type ());
-
-  // Generate a temporary to store the discriminant
-  *os << disc_type->full_name ()
-      << " " << "_tao_discriminant;" << be_nl;
+  bool boolDisc = false;
 
   switch (node->udisc_type ())
     {
       case AST_Expression::EV_bool:
-        *os << "::ACE_InputCDR::to_boolean tmp (_tao_discriminant);" << be_nl
-            << "if ( !(strm >> tmp) )" << be_idt_nl;
+        boolDisc = true;
+        *os << "::ACE_OutputCDR::from_boolean tmp (_tao_union._d ());" << be_nl
+            << "if ( !(strm << tmp) )" << be_idt_nl;
 
         break;
       case AST_Expression::EV_char:
-        *os << "::ACE_InputCDR::to_char tmp (_tao_discriminant);" << be_nl
-            << "if ( !(strm >> tmp) )" << be_idt_nl;
+        *os << "::ACE_OutputCDR::from_char tmp (_tao_union._d ());" << be_nl
+            << "if ( !(strm << tmp) )" << be_idt_nl;
 
         break;
       case AST_Expression::EV_wchar:
-        *os << "::ACE_InputCDR::to_wchar tmp (_tao_discriminant);" << be_nl
-            << "if ( !(strm >> tmp) )" << be_idt_nl;
+        *os << "::ACE_OutputCDR::from_wchar tmp (_tao_union._d ());" << be_nl
+            << "if ( !(strm << tmp) )" << be_idt_nl;
 
         break;
       default:
-        *os << "if ( !(strm >> _tao_discriminant) )" << be_idt_nl;
+        *os << "if ( !(strm << _tao_union._d ()) )" << be_idt_nl;
 
         break;
     }
@@ -193,17 +238,9 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
       << "}" << be_uidt_nl << be_nl
       << "::CORBA::Boolean result = true;" << be_nl_2;
 
-  if (boolDisc)
-    {
-      if (node->gen_empty_default_label ())
-        {
-          *os << "_tao_union._default ();" << be_nl
-              << "_tao_union._d (_tao_discriminant);" << be_nl;
-        }
-    }
-  else
+  if (!boolDisc)
     {
-      *os << "switch (_tao_discriminant)" << be_nl
+      *os << "switch (_tao_union._d ())" << be_nl
           << "{" << be_idt;
     }
 
@@ -211,7 +248,7 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
     {
       ACE_ERROR_RETURN ((LM_ERROR,
                          "(%N:%l) be_visitor_union_cdr_op_cs::"
-                         "visit_union - "
+                         "gen_output_operator - "
                          "codegen for scope failed\n"),
                         -1);
     }
@@ -224,12 +261,8 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
   // an enum, this does no harm.
   if (!boolDisc && node->gen_empty_default_label ())
     {
-      *os << be_nl;
-      *os << "default:" << be_idt_nl;
-      *os << "_tao_union._default ();" << be_nl;
-      *os << "// For maximum interop compatibility, force the same value as transmitted" << be_nl;
-      *os << "_tao_union._d (_tao_discriminant);" << be_nl;
-      *os << "break;" << be_uidt;
+      *os << be_nl << "default:" << be_idt_nl;
+      *os << "break;"<< be_uidt;
     }
 
   if (!boolDisc)
@@ -238,17 +271,7 @@ be_visitor_union_cdr_op_cs::visit_union (be_union *node)
     }
 
   *os << "return result;" << be_uidt_nl
-      << "}" << be_nl;
-
-  bool use_underscore = (this->ctx_->tdef () == nullptr);
-
-  if (be_global->gen_ostream_operators ())
-    {
-      node->gen_ostream_operator (os, use_underscore);
-    }
-
-  *os << be_global->core_versioning_end () << be_nl;
+      << "}" << be_nl_2;
 
-  node->cli_stub_cdr_op_gen (true);
   return 0;
 }
@@ -48,17 +48,21 @@ int be_visitor_union_ch::visit_union (be_union *node)
       << "{" << be_nl
       << "public:" << be_idt_nl
 
-    // Generate default and copy constructors.
+    // Generate default, copy and move constructors.
       << node->local_name () << " ();" << be_nl
       << node->local_name () << " (const " << node->local_name ()
       << " &);" << be_nl
+      << node->local_name () << " (" << node->local_name ()
+      << " &&) noexcept;" << be_nl
     // Generate destructor.
       << "~" << node->local_name () << " ();";
 
-    // Generate assignment operator.
+    // Generate assignment operators.
   *os << be_nl_2
       << node->local_name () << " &operator= (const "
-      << node->local_name () << " &);";
+      << node->local_name () << " &);" << be_nl
+      << node->local_name () << " &operator= ("
+      << node->local_name () << " &&) noexcept;";
 
   // Retrieve the disriminant type.
   be_type *bt = dynamic_cast<be_type*> (node->disc_type ());
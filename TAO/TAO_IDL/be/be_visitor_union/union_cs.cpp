@@ -188,6 +188,17 @@ int be_visitor_union_cs::visit_union (be_union *node)
 
   *os << be_uidt_nl << "}" << be_nl_2;
 
+  // The move constructor swaps the members of a default constructed
+  // union, which all have trivial types or are held by pointer, with
+  // those of the other one, which is left as if default constructed.
+  *os << node->name () << "::" << node->local_name ()
+      << " ( ::" << node->name () << " &&u) noexcept" << be_idt_nl
+      << ": " << node->local_name () << " ()" << be_uidt_nl
+      << "{" << be_idt_nl
+      << "std::swap (this->disc_, u.disc_);" << be_nl
+      << "std::swap (this->u_, u.u_);" << be_uidt_nl
+      << "}" << be_nl_2;
+
   *os << node->name () << "::~" << node->local_name ()
       << " ()" << be_nl
       << "{" << be_idt_nl
@@ -263,6 +274,17 @@ int be_visitor_union_cs::visit_union (be_union *node)
   *os << be_nl << "return *this;" << be_uidt_nl;
   *os << "}" << be_nl_2;
 
+  // Move assignment operator, the other union is left with the value
+  // of this one and frees it.
+  *os << node->name () << " &" << be_nl;
+  *os << node->name () << "::operator= ( ::"
+      << node->name () << " &&u) noexcept" << be_nl;
+  *os << "{" << be_idt_nl
+      << "std::swap (this->disc_, u.disc_);" << be_nl
+      << "std::swap (this->u_, u.u_);" << be_nl
+      << "return *this;" << be_uidt_nl;
+  *os << "}" << be_nl_2;
+
   // The reset method.
   this->ctx_->state (TAO_CodeGen::TAO_UNION_PUBLIC_RESET_CS);
 
@@ -592,6 +592,24 @@ public:
   /// Set the gen_static_desc_operations_ member.
   void gen_static_desc_operations (bool val);
 
+  /// Get the gen_views_ member.
+  bool gen_views () const;
+
+  /// Set the gen_views_ member.
+  void gen_views (bool val);
+
+  /// Get the gen_ami_coroutines_ member.
+  bool gen_ami_coroutines () const;
+
+  /// Set the gen_ami_coroutines_ member.
+  void gen_ami_coroutines (bool val);
+
+  /// Get the gen_amh_coroutines_ member.
+  bool gen_amh_coroutines () const;
+
+  /// Set the gen_amh_coroutines_ member.
+  void gen_amh_coroutines (bool val);
+
 
   /**
    * Set the directory where all the IDL-Compiler-Generated files are
@@ -657,6 +675,12 @@ public:
   /// Check cdr support.
   bool cdr_support () const;
 
+  /// Set support for sizing values in CDR before marshaling them.
+  void cdr_size_support (bool);
+
+  /// Check support for sizing values in CDR before marshaling them.
+  bool cdr_size_support () const;
+
   /// Set TypeCode support.
   void tc_support (bool);
 
@@ -1116,6 +1140,9 @@ private:
   /// do we support cdr?
   bool cdr_support_;
 
+  /// do we generate operator<< (ACE_SizeCDR &, ...)?
+  bool cdr_size_support_;
+
   /// do we support typecodes?
   bool tc_support_;
 
@@ -1262,6 +1289,18 @@ private:
   /// Generate static description operations for each interface
   bool gen_static_desc_operations_;
 
+  /// Generate read-only views of structs over received CDR data,
+  /// and pass them to servants for in arguments.
+  bool gen_views_;
+
+  /// Generate async_ operations that C++20 coroutines co_await,
+  /// next to the AMI sendc_ operations.
+  bool gen_ami_coroutines_;
+
+  /// Make the upcalls of the AMH skeletons C++20 coroutines
+  /// returning a TAO::AMH_Task.
+  bool gen_amh_coroutines_;
+
   /**
    * True by default, but a command line option can turn this off so
    * custom ending will not be applied to files in $TAO_ROOT/,
@@ -58,10 +58,15 @@ public:
   bool is_attr_op () const;
   void is_attr_op (bool val);
 
+  /// Does the stub get an async_ operation for coroutines?
+  bool has_ami_awaitable () const;
+  void has_ami_awaitable (bool val);
+
 protected:
   bool is_sendc_ami_;
   bool is_excep_ami_;
   bool is_attr_op_;
+  bool has_ami_awaitable_;
 };
 
 #endif
@@ -43,11 +43,52 @@ public:
   virtual void gen_ostream_operator (TAO_OutStream *os,
                                      bool use_underscore);
 
+  /// Whether sequences and arrays of this struct can be marshaled as
+  /// one block of memory, because its members are all of primitive
+  /// types, structs and arrays of them that CDR aligns as C++ does,
+  /// the first of them with the largest alignment, and nothing follows
+  /// the last.  Sets the CDR @a size and @a alignment of a value.
+  bool cdr_bulk_layout (ACE_CDR::ULong &size,
+                        ACE_CDR::ULong &alignment);
+
+  /// The CDR size and alignment of a member of type @a type in such a
+  /// struct, and the number of elements if it is an array.  @a nested
+  /// is set to the struct of the elements, or null for a primitive.
+  static bool cdr_bulk_member (AST_Type *type,
+                               ACE_CDR::ULong &size,
+                               ACE_CDR::ULong &alignment,
+                               ACE_CDR::ULong &count,
+                               be_structure *&nested);
+
+  /// How the view of a struct (-Gview) gives access to a member.
+  enum View_Member
+  {
+    VIEW_NONE,      ///< It cannot, and the struct has no view.
+    VIEW_BASIC,     ///< Primitive type or enum, returned by value.
+    VIEW_STRING,    ///< String, pointing into the stream.
+    VIEW_WSTRING,   ///< Wide string, decoded on access.
+    VIEW_STRUCT,    ///< The view of the struct.
+    VIEW_SEQUENCE,  ///< A TAO::Sequence_View of its elements.
+    VIEW_DECODE     ///< Demarshaled into the C++ mapping on access.
+  };
+
+  /// Whether a read-only view of this struct is generated: with
+  /// -Gview, for structs that are not local and whose members all
+  /// have a View_Member other than VIEW_NONE.
+  bool has_view ();
+
+  /// How the view of a struct gives access to a member of @a type.
+  static View_Member view_member (AST_Type *type);
+
   /// Cleanup method.
   virtual void destroy ();
 
   /// Visiting.
   virtual int accept (be_visitor *visitor);
+
+private:
+  /// Set while has_view() looks at our members, for recursive types.
+  bool in_has_view_;
 };
 
 #endif
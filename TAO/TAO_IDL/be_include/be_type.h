@@ -82,6 +82,13 @@ public:
    */
   virtual AST_Decl::NodeType base_node_type () const;
 
+  /// Whether the size of a value of this type in CDR can be computed
+  /// without marshaling it, so that operator<< (ACE_SizeCDR &, ...)
+  /// is generated for it: true for primitive types other than Any
+  /// and object references, strings, enums, and structs, unions,
+  /// sequences and arrays of such types.
+  bool cdr_sizable ();
+
   /// Clean up allocated members.
   virtual void destroy ();
 
@@ -106,6 +113,9 @@ protected:
 
   /// Has this declaration been used as a return type or parameter?
   bool seen_in_operation_;
+
+  /// Set while cdr_sizable() looks at our members, for recursive types.
+  bool in_cdr_sizable_;
 };
 
 #endif // end of if !defined
@@ -19,7 +19,10 @@
 class TAO_OutStream;
 class be_module;
 class be_type;
+class be_structure;
+class be_visitor_context;
 class AST_Decl;
+class AST_Argument;
 class AST_Generator;
 
 class be_util
@@ -71,6 +74,13 @@ public:
 
   // Called by each node upon construction.
   static void set_arg_seen_bit (be_type *);
+
+  /// The struct type of @a arg, if the skeletons pass it to the
+  /// servant as the view of the struct (-Gview): an @c in argument
+  /// of an operation, not an attribute, of a non-local interface.
+  /// Else null.
+  static be_structure *in_view_struct (AST_Argument *arg,
+                                       be_visitor_context *ctx);
 };
 
 #endif // if !defined
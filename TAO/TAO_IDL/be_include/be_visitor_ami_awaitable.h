@@ -0,0 +1,41 @@
+/* -*- c++ -*- */
+//=============================================================================
+/**
+ *  @file    be_visitor_ami_awaitable.h
+ *
+ *  This visitor generates, at the end of the client header, the
+ *  inline definitions of the async_ operations that -Gcoro adds
+ *  to the stubs, once the argument traits they use are declared.
+ */
+//=============================================================================
+
+#ifndef TAO_BE_VISITOR_AMI_AWAITABLE_H
+#define TAO_BE_VISITOR_AMI_AWAITABLE_H
+
+#include "be_visitor_scope.h"
+
+/**
+ * @class be_visitor_ami_awaitable
+ *
+ * @brief Definitions of the awaitable AMI operations.
+ *
+ * Walks the modules and interfaces of the IDL file for the
+ * operations marked by the AMI preprocessor.
+ */
+class be_visitor_ami_awaitable : public be_visitor_scope
+{
+public:
+  be_visitor_ami_awaitable (be_visitor_context *ctx);
+
+  virtual ~be_visitor_ami_awaitable ();
+
+  virtual int visit_root (be_root *node);
+
+  virtual int visit_module (be_module *node);
+
+  virtual int visit_interface (be_interface *node);
+
+  virtual int visit_operation (be_operation *node);
+};
+
+#endif // TAO_BE_VISITOR_AMI_AWAITABLE_H
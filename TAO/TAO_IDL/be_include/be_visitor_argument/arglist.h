@@ -105,6 +105,10 @@ public:
 private:
   int emit_common (be_type *node);
 
+  /// True if the argument is passed to the servant as a view of the
+  /// struct (-Gview).
+  bool servant_view ();
+
 private:
   bool unused_;
 };
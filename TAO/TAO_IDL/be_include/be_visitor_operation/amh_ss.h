@@ -33,7 +33,15 @@ protected:
                                 const char *skel_prefix);
   int generate_shared_section (be_decl *node,
                                TAO_OutStream *os);
-  int generate_shared_epilogue (TAO_OutStream *os);
+  int generate_shared_epilogue (TAO_OutStream *os,
+                                bool retain_arguments = false);
+
+  /// With -GHcoro the in and inout arguments are members of a
+  /// struct the task of the upcall retains, so that they outlive the
+  /// skeleton until the coroutine returns.
+  void open_argument_storage (TAO_OutStream *os);
+  void close_argument_storage (TAO_OutStream *os);
+  void refer_to_argument (be_decl *argument, TAO_OutStream *os);
 };
 
 #endif /* AMH_OPERATION_SS_H */
@@ -0,0 +1,38 @@
+
+//=============================================================================
+/**
+ *  @file    ami_awaitable_ch.h
+ *
+ *  Visitor generating the inline definition of the awaitable AMI
+ *  operation of an IDL operation in the client header.
+ */
+//=============================================================================
+
+
+#ifndef _BE_VISITOR_OPERATION_AMI_AWAITABLE_CH_H_
+#define _BE_VISITOR_OPERATION_AMI_AWAITABLE_CH_H_
+
+// ************************************************************
+// Operation visitor for awaitable AMI operations
+// ************************************************************
+
+/**
+ * @class be_visitor_operation_ami_awaitable_ch
+ *
+ * @brief be_visitor_operation_ami_awaitable_ch
+ *
+ * Generates the async_ operation -Gcoro declares next to the
+ * synchronous one, which makes the invocation its sendc_ operation
+ * would and returns a TAO::Asynch_Awaitable for it.
+ */
+class be_visitor_operation_ami_awaitable_ch : public be_visitor_operation
+{
+public:
+  be_visitor_operation_ami_awaitable_ch (be_visitor_context *ctx);
+
+  ~be_visitor_operation_ami_awaitable_ch ();
+
+  virtual int visit_operation (be_operation *node);
+};
+
+#endif /* _BE_VISITOR_OPERATION_AMI_AWAITABLE_CH_H_ */
@@ -48,6 +48,7 @@ private:
   int gen_template_exports (be_root *node);
   int gen_any_ops (be_root *node);
   int gen_cdr_ops (be_root *node);
+  int gen_ami_awaitables (be_root *node);
 
 private:
   /// Can't use base class be_visitor_decl's member since
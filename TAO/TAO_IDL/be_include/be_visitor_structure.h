@@ -28,6 +28,8 @@
 #include "be_visitor_structure/any_op_cs.h"
 #include "be_visitor_structure/cdr_op_ch.h"
 #include "be_visitor_structure/cdr_op_cs.h"
+#include "be_visitor_structure/view_ch.h"
+#include "be_visitor_structure/view_cs.h"
 
 
 #endif // TAO_BE_VISITOR_STRUCTURE_H
@@ -36,6 +36,13 @@ public:
 
   /// visit structure
   virtual int visit_structure (be_structure *node);
+
+private:
+  /// Specialize TAO::CDR_Bulk_Traits for @a node, which has a CDR
+  /// layout of @a size and @a alignment.
+  void gen_bulk_traits (be_structure *node,
+                        ACE_CDR::ULong size,
+                        ACE_CDR::ULong alignment);
 };
 
 #endif /* _BE_VISITOR_STRUCTURE_CDR_OP_CH_H_ */
@@ -39,6 +39,11 @@ public:
 
   /// any post processing that needs to be done after a scope element is handled
   virtual int post_process (be_decl *);
+
+private:
+  /// Generate operator<< for TAO_OutputCDR, or for ACE_SizeCDR when
+  /// @a sizing.
+  int gen_output_operator (be_structure *node, bool sizing);
 };
 
 #endif /* _BE_VISITOR_STRUCTURE_CDR_OP_CS_H_ */
@@ -0,0 +1,46 @@
+/* -*- c++ -*- */
+
+//=============================================================================
+/**
+ *  @file    view_ch.h
+ *
+ *  Concrete visitor for the Structure class
+ *  This one provides code generation for the read-only view of the
+ *  structure (-Gview) in the client header.
+ */
+//=============================================================================
+
+
+#ifndef _BE_VISITOR_STRUCTURE_VIEW_CH_H_
+#define _BE_VISITOR_STRUCTURE_VIEW_CH_H_
+
+/**
+ * @class be_visitor_structure_view_ch
+ *
+ * @brief be_visitor_structure_view_ch
+ *
+ * This is a concrete visitor to generate the declaration of the view
+ * of a structure in the client header.
+ */
+class be_visitor_structure_view_ch : public be_visitor_structure
+{
+public:
+  /// constructor
+  be_visitor_structure_view_ch (be_visitor_context *ctx);
+
+  /// destructor
+  ~be_visitor_structure_view_ch ();
+
+  /// visit structure
+  virtual int visit_structure (be_structure *node);
+
+  /// The C++ type returned by the view for a member of @a type, for
+  /// the members that are not demarshaled on access.
+  static ACE_CString view_type (AST_Type *type);
+
+  /// Whether the view keeps an object for the member of @a type, to
+  /// return it by reference.
+  static bool view_cached (AST_Type *type);
+};
+
+#endif /* _BE_VISITOR_STRUCTURE_VIEW_CH_H_ */
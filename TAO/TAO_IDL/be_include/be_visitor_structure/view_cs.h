@@ -0,0 +1,48 @@
+/* -*- c++ -*- */
+
+//=============================================================================
+/**
+ *  @file    view_cs.h
+ *
+ *  Concrete visitor for the Structure class
+ *  This one provides code generation for the read-only view of the
+ *  structure (-Gview) in the client stub.
+ */
+//=============================================================================
+
+
+#ifndef _BE_VISITOR_STRUCTURE_VIEW_CS_H_
+#define _BE_VISITOR_STRUCTURE_VIEW_CS_H_
+
+/**
+ * @class be_visitor_structure_view_cs
+ *
+ * @brief be_visitor_structure_view_cs
+ *
+ * This is a concrete visitor to generate the definition of the view
+ * of a structure in the client stub.
+ */
+class be_visitor_structure_view_cs : public be_visitor_structure
+{
+public:
+  /// constructor
+  be_visitor_structure_view_cs (be_visitor_context *ctx);
+
+  /// destructor
+  ~be_visitor_structure_view_cs ();
+
+  /// visit structure
+  virtual int visit_structure (be_structure *node);
+
+private:
+  /// Generate the skipping of a member of @a type, read from strm.
+  void gen_skip (TAO_OutStream *os, AST_Type *type);
+
+  /// Generate the accessor of member @a f, number @a index.
+  void gen_accessor (TAO_OutStream *os,
+                     be_structure *node,
+                     AST_Field *f,
+                     ACE_CDR::ULong index);
+};
+
+#endif /* _BE_VISITOR_STRUCTURE_VIEW_CS_H_ */
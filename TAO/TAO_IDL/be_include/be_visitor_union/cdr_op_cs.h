@@ -41,6 +41,10 @@ public:
   virtual int post_process (be_decl *);
 
 private:
+  /// Generate operator<< for TAO_OutputCDR, or for ACE_SizeCDR when
+  /// @a sizing.
+  int gen_output_operator (be_union *node, bool sizing);
+
   BoolUnionBranch latest_branch_;
 };
 
@@ -83,6 +83,9 @@ trademarks or registered trademarks of Sun Microsystems, Inc.
 
 extern long DRV_nfiles;
 extern char *DRV_files[];
+extern long DRV_jobs;
+extern long DRV_job_slice;
+extern bool DRV_builtin_cpp;
 
 void process_long_option(long ac, char **av, long &i);
 
@@ -155,6 +158,9 @@ DRV_usage ()
     ACE_TEXT (" --default-idl-version\tPrint the default IDL version and exit\n")
     ACE_TEXT (" --list-idl-versions\tPrint IDL versions supported and exit\n")
     ACE_TEXT (" --syntax-only\t\tJust check the syntax, do not create files\n")
+    ACE_TEXT (" --builtin-cpp\t\tUse the built-in preprocessor instead of")
+    ACE_TEXT (" spawning one\n\t\t\tfor each file\n")
+    ACE_TEXT (" --jobs N\t\tCompile the files in N processes at once\n")
     ACE_TEXT (" --bison-trace\t\tEnable Bison Tracing (sets yydebug to 1)\n")
     ACE_TEXT (" --dump-builtins\tDump the compiler and user defined IDL.\n")
     ACE_TEXT (" --just-dump-builtins\tJust dump the compiler defined IDL and exit.\n")
@@ -614,6 +620,49 @@ process_long_option(long ac, char **av, long &i)
     {
       idl_global->syntax_only_ = true;
     }
+  else if (!ACE_OS::strcmp (long_option, "builtin-cpp"))
+    {
+      DRV_builtin_cpp = true;
+    }
+  else if (!ACE_OS::strcmp (long_option, "jobs"))
+    {
+      DRV_jobs = no_more_args ? 0 : ACE_OS::atoi (av[++i]);
+      if (DRV_jobs < 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+            ACE_TEXT ("--jobs requires a number of processes.\n")
+            ));
+          idl_global->parse_args_exit (1);
+        }
+    }
+  else if (!ACE_OS::strcmp (long_option, "job-slice"))
+    {
+      // Given by the first process to those it spawns for --jobs:
+      // compile every Nth file from the Kth, as "K,N".
+      long slice = -1;
+      long jobs = 0;
+      if (!no_more_args)
+        {
+          char *comma = nullptr;
+          slice = ACE_OS::strtol (av[++i], &comma, 10);
+          if (*comma == ',')
+            {
+              jobs = ACE_OS::strtol (comma + 1, nullptr, 10);
+            }
+        }
+      if (slice < 0 || slice >= jobs)
+        {
+          ACE_ERROR ((LM_ERROR,
+            ACE_TEXT ("--job-slice requires an argument K,N with K < N.\n")
+            ));
+          idl_global->parse_args_exit (1);
+        }
+      else
+        {
+          DRV_job_slice = slice;
+          DRV_jobs = jobs;
+        }
+    }
   else if (!ACE_OS::strcmp (long_option, "default-idl-version"))
     {
       ACE_DEBUG ((LM_INFO, ACE_TEXT ("%C\n"),
@@ -0,0 +1,2286 @@
+//=============================================================================
+/**
+ *  @file    drv_cpp.cpp
+ *
+ *  The C preprocessor built into the IDL compiler, used instead of
+ *  spawning an external one for each file with --builtin-cpp.
+ *
+ *  It implements what IDL files use of the C preprocessor: #include,
+ *  object-like and function-like macros, conditionals, #line, #error
+ *  and #warning, and passes #pragma through to the lexer, writing the
+ *  same line markers as the C preprocessor.  It takes the -D, -U and
+ *  -I options given to the preprocessor; only __TAO_IDL, __FILE__ and
+ *  __LINE__ are predefined.
+ *
+ *  The files read, where included files were found and the macros
+ *  guarding them are kept for the life of the process, so the includes
+ *  shared by the files given on one command line are read and searched
+ *  for only once, and a guarded file included again is not read again.
+ */
+//=============================================================================
+
+#include "idl_defines.h"
+#include "global_extern.h"
+#include "drv_extern.h"
+
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/os_ctype.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+extern unsigned long DRV_argcount;
+extern ACE_TCHAR const * DRV_arglist[];
+
+namespace
+{
+  /// Deepest nesting of #include accepted.
+  int const DRV_MAX_INCLUDE_DEPTH = 200;
+
+  /// Largest gap in line numbers filled with empty lines rather than
+  /// with a line marker, as the C preprocessor does.
+  long const DRV_MAX_EMPTY_LINES = 8;
+
+  /// A preprocessing token.
+  struct DRV_Token
+  {
+    enum Kind
+    {
+      IDENT,
+      NUMBER,
+      LITERAL,
+      PUNCT,
+      SPACE,
+      PLACEMARKER
+    };
+
+    DRV_Token (Kind kind, const std::string &text)
+      : kind (kind),
+        text (text)
+    {
+    }
+
+    bool is (const char *punct) const
+    {
+      return this->kind == PUNCT && this->text == punct;
+    }
+
+    Kind kind;
+    std::string text;
+
+    /// Macros whose expansion produced the token, which are not
+    /// expanded again in it.
+    std::set<std::string> hide;
+  };
+
+  typedef std::vector<DRV_Token> DRV_Tokens;
+  typedef std::deque<DRV_Token> DRV_Token_Queue;
+
+  struct DRV_Macro
+  {
+    bool function_like;
+    bool variadic;
+    std::vector<std::string> params;
+    DRV_Tokens body;
+  };
+
+  /// A line with its continuations spliced and comments removed.
+  struct DRV_Line
+  {
+    std::string text;
+
+    /// Physical line the line starts on.
+    long number;
+  };
+
+  /// A file read.
+  struct DRV_Source
+  {
+    std::vector<DRV_Line> lines;
+
+    /// Number of the line after the last one.
+    long end;
+
+    /// The macro of the #ifndef the whole file is in, if any.
+    std::string guard;
+  };
+
+  /// The files read, by path.
+  std::map<std::string, DRV_Source> DRV_sources;
+
+  /// Where included files were found, by directory searched first
+  /// and name; empty if they were not.
+  std::map<std::string, std::string> DRV_found;
+
+  /// The include directories DRV_found was filled with.
+  std::vector<std::string> DRV_found_dirs;
+
+  /// Thrown to give up on the file.
+  struct DRV_Cpp_Fatal
+  {
+  };
+
+  bool
+  DRV_ident_start (char c)
+  {
+    return ACE_OS::ace_isalpha (c) || c == '_' || c == '$';
+  }
+
+  bool
+  DRV_ident_char (char c)
+  {
+    return ACE_OS::ace_isalnum (c) || c == '_' || c == '$';
+  }
+
+  bool
+  DRV_space (char c)
+  {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
+  }
+
+  /// Index after the character or string literal starting at @a i.
+  size_t
+  DRV_skip_literal (const std::string &s, size_t i)
+  {
+    char const quote = s[i++];
+
+    while (i < s.size () && s[i] != quote)
+      {
+        i += (s[i] == '\\' && i + 1 < s.size ()) ? 2 : 1;
+      }
+
+    return i < s.size () ? i + 1 : i;
+  }
+
+  /// Index after the preprocessing number starting at @a i.
+  size_t
+  DRV_skip_number (const std::string &s, size_t i)
+  {
+    for (++i; i < s.size (); ++i)
+      {
+        char const c = s[i];
+
+        if ((c == '+' || c == '-')
+            && ACE_OS::strchr ("eEpP", s[i - 1]) != nullptr)
+          {
+            continue;
+          }
+
+        if (!DRV_ident_char (c) && c != '.')
+          {
+            break;
+          }
+      }
+
+    return i;
+  }
+
+  /// Split @a s into tokens, appended to @a out.
+  void
+  DRV_tokenize (const std::string &s, DRV_Tokens &out)
+  {
+    static const char *const puncts[] =
+      {
+        "##", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||", "::", "..."
+      };
+
+    size_t i = 0;
+    size_t const n = s.size ();
+
+    while (i < n)
+      {
+        char const c = s[i];
+        size_t const start = i;
+
+        if (DRV_space (c) || c == '\n')
+          {
+            while (i < n && (DRV_space (s[i]) || s[i] == '\n'))
+              {
+                ++i;
+              }
+
+            out.push_back (DRV_Token (DRV_Token::SPACE, " "));
+            continue;
+          }
+
+        if (c == 'L' && i + 1 < n && (s[i + 1] == '"' || s[i + 1] == '\''))
+          {
+            i = DRV_skip_literal (s, i + 1);
+            out.push_back (DRV_Token (DRV_Token::LITERAL,
+                                      s.substr (start, i - start)));
+          }
+        else if (DRV_ident_start (c))
+          {
+            while (i < n && DRV_ident_char (s[i]))
+              {
+                ++i;
+              }
+
+            out.push_back (DRV_Token (DRV_Token::IDENT,
+                                      s.substr (start, i - start)));
+          }
+        else if (ACE_OS::ace_isdigit (c)
+                 || (c == '.' && i + 1 < n && ACE_OS::ace_isdigit (s[i + 1])))
+          {
+            i = DRV_skip_number (s, i);
+            out.push_back (DRV_Token (DRV_Token::NUMBER,
+                                      s.substr (start, i - start)));
+          }
+        else if (c == '"' || c == '\'')
+          {
+            i = DRV_skip_literal (s, i);
+            out.push_back (DRV_Token (DRV_Token::LITERAL,
+                                      s.substr (start, i - start)));
+          }
+        else
+          {
+            size_t len = 1;
+
+            for (size_t p = 0; p < sizeof puncts / sizeof puncts[0]; ++p)
+              {
+                size_t const l = ACE_OS::strlen (puncts[p]);
+
+                if (s.compare (i, l, puncts[p]) == 0)
+                  {
+                    len = l;
+                    break;
+                  }
+              }
+
+            i += len;
+            out.push_back (DRV_Token (DRV_Token::PUNCT, s.substr (start, len)));
+          }
+      }
+  }
+
+  /// Index of the first token from @a i that is not a space.
+  size_t
+  DRV_next_token (const DRV_Tokens &tokens, size_t i)
+  {
+    while (i < tokens.size () && tokens[i].kind == DRV_Token::SPACE)
+      {
+        ++i;
+      }
+
+    return i;
+  }
+
+  void
+  DRV_trim (DRV_Tokens &tokens)
+  {
+    while (!tokens.empty () && tokens.back ().kind == DRV_Token::SPACE)
+      {
+        tokens.pop_back ();
+      }
+
+    tokens.erase (tokens.begin (),
+                  tokens.begin () + DRV_next_token (tokens, 0));
+  }
+
+  /// The text of @a tokens, with a space between tokens that would
+  /// otherwise read as one.
+  std::string
+  DRV_join (const DRV_Tokens &tokens)
+  {
+    static const char glue[] = "+-*/%<>=!&|^:#.";
+    std::string s;
+    char prev = '\0';
+
+    for (DRV_Tokens::const_iterator t = tokens.begin ();
+         t != tokens.end ();
+         ++t)
+      {
+        if (t->kind == DRV_Token::SPACE)
+          {
+            s += ' ';
+            prev = '\0';
+            continue;
+          }
+
+        char const next = t->text[0];
+
+        if (prev != '\0'
+            && ((DRV_ident_char (prev) && DRV_ident_char (next))
+                || (ACE_OS::strchr (glue, prev) != nullptr
+                    && ACE_OS::strchr (glue, next) != nullptr)))
+          {
+            s += ' ';
+          }
+
+        s += t->text;
+        prev = t->text[t->text.size () - 1];
+      }
+
+    return s;
+  }
+
+  /// Recognize a directive in @a text, setting its @a name and the
+  /// @a rest of the line.
+  bool
+  DRV_directive (const std::string &text, std::string &name, std::string &rest)
+  {
+    size_t i = 0;
+
+    while (i < text.size () && DRV_space (text[i]))
+      {
+        ++i;
+      }
+
+    if (i == text.size () || text[i] != '#')
+      {
+        return false;
+      }
+
+    for (++i; i < text.size () && DRV_space (text[i]); ++i)
+      {
+      }
+
+    size_t const start = i;
+
+    if (i < text.size () && ACE_OS::ace_isdigit (text[i]))
+      {
+        // A line marker, as written by a preprocessor.
+        name = "line";
+        rest = text.substr (start);
+        return true;
+      }
+
+    while (i < text.size () && DRV_ident_char (text[i]))
+      {
+        ++i;
+      }
+
+    name = text.substr (start, i - start);
+    rest = text.substr (i);
+    return true;
+  }
+
+  /// The name tested by the #ifndef or #if !defined in @a rest.
+  std::string
+  DRV_guard_name (const std::string &name, const std::string &rest)
+  {
+    DRV_Tokens t;
+    DRV_tokenize (rest, t);
+    size_t i = DRV_next_token (t, 0);
+
+    if (name == "if")
+      {
+        if (i == t.size () || !t[i].is ("!"))
+          {
+            return std::string ();
+          }
+
+        i = DRV_next_token (t, i + 1);
+
+        if (i == t.size () || t[i].text != "defined")
+          {
+            return std::string ();
+          }
+
+        i = DRV_next_token (t, i + 1);
+        bool const paren = i < t.size () && t[i].is ("(");
+
+        if (paren)
+          {
+            i = DRV_next_token (t, i + 1);
+          }
+
+        if (i == t.size () || t[i].kind != DRV_Token::IDENT)
+          {
+            return std::string ();
+          }
+
+        size_t end = DRV_next_token (t, i + 1);
+
+        if (paren)
+          {
+            if (end == t.size () || !t[end].is (")"))
+              {
+                return std::string ();
+              }
+
+            end = DRV_next_token (t, end + 1);
+          }
+
+        return end == t.size () ? t[i].text : std::string ();
+      }
+
+    if (name == "ifndef"
+        && i < t.size ()
+        && t[i].kind == DRV_Token::IDENT
+        && DRV_next_token (t, i + 1) == t.size ())
+      {
+        return t[i].text;
+      }
+
+    return std::string ();
+  }
+
+  /// Find the macro guarding all of @a src, if any.
+  void
+  DRV_find_guard (DRV_Source &src)
+  {
+    size_t first = 0;
+    size_t last = src.lines.size ();
+    std::string name;
+    std::string rest;
+
+    // Blank lines may surround the guarded part.
+    while (first < last
+           && src.lines[first].text.find_first_not_of (" \t\v\f\r")
+                == std::string::npos)
+      {
+        ++first;
+      }
+
+    while (last > first
+           && src.lines[last - 1].text.find_first_not_of (" \t\v\f\r")
+                == std::string::npos)
+      {
+        --last;
+      }
+
+    if (first == last
+        || !DRV_directive (src.lines[first].text, name, rest))
+      {
+        return;
+      }
+
+    std::string const guard = DRV_guard_name (name, rest);
+
+    if (guard.empty ())
+      {
+        return;
+      }
+
+    int depth = 0;
+
+    for (size_t i = first; i < last; ++i)
+      {
+        if (!DRV_directive (src.lines[i].text, name, rest))
+          {
+            continue;
+          }
+
+        if (name == "if" || name == "ifdef" || name == "ifndef")
+          {
+            ++depth;
+          }
+        else if ((name == "else" || name == "elif") && depth == 1)
+          {
+            return;
+          }
+        else if (name == "endif" && --depth == 0)
+          {
+            if (i + 1 != last)
+              {
+                return;
+              }
+          }
+      }
+
+    if (depth == 0)
+      {
+        src.guard = guard;
+      }
+  }
+
+  /// Read the file at @a path into @a src, splicing continued lines
+  /// and replacing comments with a space.
+  bool
+  DRV_read_source (const std::string &path, DRV_Source &src)
+  {
+    FILE *const file = ACE_OS::fopen (path.c_str (), "rb");
+
+    if (file == nullptr)
+      {
+        return false;
+      }
+
+    std::string data;
+    char buffer[16 * 1024];
+    size_t bytes;
+
+    while ((bytes = ACE_OS::fread (buffer, 1, sizeof buffer, file)) != 0)
+      {
+        data.append (buffer, bytes);
+      }
+
+    ACE_OS::fclose (file);
+
+    long number = 1;
+    DRV_Line line;
+    line.number = number;
+    bool in_comment = false;
+    char quote = '\0';
+    size_t const n = data.size ();
+
+    for (size_t i = 0; i < n; ++i)
+      {
+        char const c = data[i];
+
+        if (c == '\r' && i + 1 < n && data[i + 1] == '\n')
+          {
+            continue;
+          }
+
+        if (c == '\\'
+            && ((i + 1 < n && data[i + 1] == '\n')
+                || (i + 2 < n && data[i + 1] == '\r' && data[i + 2] == '\n')))
+          {
+            i += data[i + 1] == '\r' ? 2 : 1;
+            ++number;
+            continue;
+          }
+
+        if (c == '\n')
+          {
+            ++number;
+
+            if (in_comment)
+              {
+                // What follows a comment alone on its lines starts
+                // on the line the comment ends.
+                if (line.text.find_first_not_of (" \t\v\f\r")
+                      == std::string::npos)
+                  {
+                    line.text.clear ();
+                    line.number = number;
+                  }
+
+                continue;
+              }
+
+            src.lines.push_back (line);
+            line.text.clear ();
+            line.number = number;
+            quote = '\0';
+            continue;
+          }
+
+        if (in_comment)
+          {
+            if (c == '*' && i + 1 < n && data[i + 1] == '/')
+              {
+                in_comment = false;
+                ++i;
+              }
+
+            continue;
+          }
+
+        if (quote != '\0')
+          {
+            line.text += c;
+
+            if (c == '\\' && i + 1 < n && data[i + 1] != '\n')
+              {
+                line.text += data[++i];
+              }
+            else if (c == quote)
+              {
+                quote = '\0';
+              }
+
+            continue;
+          }
+
+        if (c == '/' && i + 1 < n && data[i + 1] == '*')
+          {
+            in_comment = true;
+            line.text += ' ';
+            ++i;
+            continue;
+          }
+
+        if (c == '/' && i + 1 < n && data[i + 1] == '/')
+          {
+            // To the end of the line, which may be continued.
+            while (i + 1 < n && data[i + 1] != '\n')
+              {
+                if (data[i + 1] == '\\' && i + 2 < n && data[i + 2] == '\n')
+                  {
+                    ++number;
+                    ++i;
+                  }
+
+                ++i;
+              }
+
+            continue;
+          }
+
+        if (c == '"' || c == '\'')
+          {
+            quote = c;
+          }
+
+        line.text += c;
+      }
+
+    if (!line.text.empty ())
+      {
+        src.lines.push_back (line);
+        ++number;
+      }
+
+    src.end = number;
+    DRV_find_guard (src);
+    return true;
+  }
+
+  /// The file at @a path, read once per process.
+  DRV_Source *
+  DRV_source (const std::string &path)
+  {
+    std::map<std::string, DRV_Source>::iterator const i =
+      DRV_sources.find (path);
+
+    if (i != DRV_sources.end ())
+      {
+        return &i->second;
+      }
+
+    DRV_Source src;
+
+    if (!DRV_read_source (path, src))
+      {
+        return nullptr;
+      }
+
+    return &DRV_sources.insert (std::make_pair (path, src)).first->second;
+  }
+
+  /// The directory part of @a path, empty if it has none.
+  std::string
+  DRV_dir_name (const std::string &path)
+  {
+#if defined (ACE_WIN32)
+    size_t const slash = path.find_last_of ("/\\");
+#else
+    size_t const slash = path.find_last_of ('/');
+#endif /* ACE_WIN32 */
+
+    return slash == std::string::npos ? std::string () : path.substr (0, slash);
+  }
+
+  std::string
+  DRV_in_dir (const std::string &dir, const std::string &name)
+  {
+    return dir.empty () ? name : dir + '/' + name;
+  }
+
+  bool
+  DRV_absolute (const std::string &name)
+  {
+#if defined (ACE_WIN32)
+    return name[0] == '/' || name[0] == '\\'
+           || (name.size () > 1 && name[1] == ':');
+#else
+    return name[0] == '/';
+#endif /* ACE_WIN32 */
+  }
+
+  class DRV_Cpp;
+
+  /// Gives the macro expansion of a line the next lines, when a
+  /// macro call goes on over them.
+  class DRV_Line_Source
+  {
+  public:
+    DRV_Line_Source (const DRV_Source &src, size_t &index)
+      : src_ (src),
+        index_ (index)
+    {
+    }
+
+    bool fetch (DRV_Token_Queue &in)
+    {
+      size_t const next = this->index_ + 1;
+      std::string name;
+      std::string rest;
+
+      if (next >= this->src_.lines.size ()
+          || DRV_directive (this->src_.lines[next].text, name, rest))
+        {
+          return false;
+        }
+
+      this->index_ = next;
+      DRV_Tokens tokens;
+      DRV_tokenize (this->src_.lines[next].text, tokens);
+      in.push_back (DRV_Token (DRV_Token::SPACE, " "));
+      in.insert (in.end (), tokens.begin (), tokens.end ());
+      return true;
+    }
+
+  private:
+    const DRV_Source &src_;
+    size_t &index_;
+  };
+
+  /// Evaluates the expression of #if and #elif.
+  class DRV_Expression
+  {
+  public:
+    DRV_Expression (const DRV_Tokens &tokens)
+      : tokens_ (tokens),
+        pos_ (0),
+        error_ (nullptr)
+    {
+    }
+
+    /// The value, or the @a error in the expression.
+    long long value (const char *&error)
+    {
+      long long const v = this->conditional (true);
+
+      if (this->error_ == nullptr && this->pos_ != this->tokens_.size ())
+        {
+          this->error_ = this->tokens_[this->pos_].is (")")
+                           ? "missing '(' in expression"
+                           : "missing binary operator in expression";
+        }
+
+      error = this->error_;
+      return v;
+    }
+
+  private:
+    bool next_is (const char *punct) const
+    {
+      return this->pos_ < this->tokens_.size ()
+             && this->tokens_[this->pos_].is (punct);
+    }
+
+    void fail (const char *error)
+    {
+      if (this->error_ == nullptr)
+        {
+          this->error_ = error;
+        }
+
+      this->pos_ = this->tokens_.size ();
+    }
+
+    long long conditional (bool live)
+    {
+      long long const c = this->binary (1, live);
+
+      if (!this->next_is ("?"))
+        {
+          return c;
+        }
+
+      ++this->pos_;
+      long long const a = this->conditional (live && c != 0);
+
+      if (!this->next_is (":"))
+        {
+          this->fail ("'?' without following ':'");
+          return 0;
+        }
+
+      ++this->pos_;
+      long long const b = this->conditional (live && c == 0);
+      return c != 0 ? a : b;
+    }
+
+    static int precedence (const DRV_Token &t)
+    {
+      static const struct
+      {
+        const char *op;
+        int precedence;
+      } ops[] =
+        {
+          { "||", 1 }, { "&&", 2 }, { "|", 3 }, { "^", 4 }, { "&", 5 },
+          { "==", 6 }, { "!=", 6 },
+          { "<", 7 }, { ">", 7 }, { "<=", 7 }, { ">=", 7 },
+          { "<<", 8 }, { ">>", 8 },
+          { "+", 9 }, { "-", 9 },
+          { "*", 10 }, { "/", 10 }, { "%", 10 }
+        };
+
+      if (t.kind == DRV_Token::PUNCT)
+        {
+          for (size_t i = 0; i < sizeof ops / sizeof ops[0]; ++i)
+            {
+              if (t.text == ops[i].op)
+                {
+                  return ops[i].precedence;
+                }
+            }
+        }
+
+      return 0;
+    }
+
+    long long binary (int min_precedence, bool live)
+    {
+      long long lhs = this->unary (live);
+
+      while (this->pos_ < this->tokens_.size ())
+        {
+          const DRV_Token &t = this->tokens_[this->pos_];
+          int const p = precedence (t);
+
+          if (p == 0 || p < min_precedence)
+            {
+              break;
+            }
+
+          std::string const op = t.text;
+          ++this->pos_;
+
+          bool const rlive =
+            op == "&&" ? live && lhs != 0
+            : op == "||" ? live && lhs == 0
+            : live;
+
+          long long const rhs = this->binary (p + 1, rlive);
+          lhs = this->apply (op, lhs, rhs, rlive);
+        }
+
+      return lhs;
+    }
+
+    long long apply (const std::string &op,
+                     long long lhs,
+                     long long rhs,
+                     bool live)
+    {
+      if (op == "||") return lhs != 0 || rhs != 0;
+      if (op == "&&") return lhs != 0 && rhs != 0;
+      if (op == "|") return lhs | rhs;
+      if (op == "^") return lhs ^ rhs;
+      if (op == "&") return lhs & rhs;
+      if (op == "==") return lhs == rhs;
+      if (op == "!=") return lhs != rhs;
+      if (op == "<") return lhs < rhs;
+      if (op == ">") return lhs > rhs;
+      if (op == "<=") return lhs <= rhs;
+      if (op == ">=") return lhs >= rhs;
+      if (op == "<<") return lhs << (rhs & 63);
+      if (op == ">>") return lhs >> (rhs & 63);
+      if (op == "+") return lhs + rhs;
+      if (op == "-") return lhs - rhs;
+      if (op == "*") return lhs * rhs;
+
+      if (rhs == 0)
+        {
+          if (live)
+            {
+              this->fail ("division by zero in #if");
+            }
+
+          return 0;
+        }
+
+      return op == "/" ? lhs / rhs : lhs % rhs;
+    }
+
+    long long unary (bool live)
+    {
+      if (this->pos_ == this->tokens_.size ())
+        {
+          this->fail (this->tokens_.empty ()
+                      ? "#if with no expression"
+                      : "expected a value at the end of the expression");
+          return 0;
+        }
+
+      const DRV_Token &t = this->tokens_[this->pos_++];
+
+      if (t.is ("("))
+        {
+          long long const v = this->conditional (live);
+
+          if (!this->next_is (")"))
+            {
+              this->fail ("missing ')' in expression");
+              return 0;
+            }
+
+          ++this->pos_;
+          return v;
+        }
+
+      if (t.is ("!")) return this->unary (live) == 0;
+      if (t.is ("~")) return ~this->unary (live);
+      if (t.is ("-")) return -this->unary (live);
+      if (t.is ("+")) return this->unary (live);
+
+      switch (t.kind)
+        {
+        case DRV_Token::NUMBER:
+          return this->number (t.text);
+        case DRV_Token::LITERAL:
+          return this->character (t.text);
+        case DRV_Token::IDENT:
+          // Names left after expanding macros are 0.
+          return t.text == "true" ? 1 : 0;
+        default:
+          this->fail ("token is not valid in preprocessor expressions");
+          return 0;
+        }
+    }
+
+    long long number (const std::string &text)
+    {
+      std::string digits (text);
+
+      while (!digits.empty ()
+             && ACE_OS::strchr ("uUlL", digits[digits.size () - 1]) != nullptr)
+        {
+          digits.erase (digits.size () - 1);
+        }
+
+      int base = 10;
+      size_t start = 0;
+
+      if (digits.size () > 1 && digits[0] == '0')
+        {
+          if (digits[1] == 'x' || digits[1] == 'X')
+            {
+              base = 16;
+              start = 2;
+            }
+          else if (digits[1] == 'b' || digits[1] == 'B')
+            {
+              base = 2;
+              start = 2;
+            }
+          else
+            {
+              base = 8;
+            }
+        }
+
+      const char *const begin = digits.c_str () + start;
+      char *end = nullptr;
+      unsigned long long const v = std::strtoull (begin, &end, base);
+
+      if (end == begin || *end != '\0')
+        {
+          this->fail ("invalid integer constant in #if");
+          return 0;
+        }
+
+      return static_cast<long long> (v);
+    }
+
+    long long character (const std::string &text)
+    {
+      size_t i = text[0] == 'L' ? 1 : 0;
+
+      if (text[i] != '\'' || text.size () < i + 3)
+        {
+          this->fail ("string literal in #if");
+          return 0;
+        }
+
+      ++i;
+
+      if (text[i] != '\\')
+        {
+          return static_cast<unsigned char> (text[i]);
+        }
+
+      char const c = text[++i];
+
+      switch (c)
+        {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'a': return '\a';
+        case 'b': return '\b';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        case 'x':
+          return std::strtol (text.c_str () + i + 1, nullptr, 16);
+        default:
+          if (c >= '0' && c <= '7')
+            {
+              return std::strtol (text.c_str () + i, nullptr, 8);
+            }
+
+          return static_cast<unsigned char> (c);
+        }
+    }
+
+    const DRV_Tokens &tokens_;
+    size_t pos_;
+    const char *error_;
+  };
+
+  /// Preprocesses one file.
+  class DRV_Cpp
+  {
+  public:
+    DRV_Cpp ()
+      : line_ (1),
+        directive_line_ (0),
+        errors_ (0)
+    {
+    }
+
+    /// Take a -D, -U or -I option given to the preprocessor.
+    void option (const char *arg);
+
+    /// Preprocess @a in_file into the output.
+    void run (const char *in_file);
+
+    const std::string &output () const
+    {
+      return this->output_;
+    }
+
+    int errors () const
+    {
+      return this->errors_;
+    }
+
+  private:
+    struct Conditional
+    {
+      /// Lines are processed in the current group.
+      bool active;
+
+      /// A group of the conditional was active, or it is in an
+      /// inactive group.
+      bool taken;
+
+      bool seen_else;
+
+      /// The directive that opened the conditional, and its line.
+      std::string name;
+      long line;
+    };
+
+    void process (const std::string &path, int depth);
+
+    void directive (const std::string &name,
+                    const std::string &rest,
+                    const std::string &path,
+                    std::vector<Conditional> &conditionals,
+                    long next_line,
+                    long &delta,
+                    int depth);
+
+    void include (const std::string &rest,
+                  const std::string &path,
+                  long next_line,
+                  int depth);
+
+    bool find (const std::string &name,
+               bool quoted,
+               const std::string &dir,
+               std::string &found);
+
+    void define (const std::string &rest);
+
+    void line_directive (const std::string &rest,
+                         long next_line,
+                         long &delta);
+
+    bool evaluate (const std::string &rest);
+
+    bool has_macro (const std::string &text) const;
+
+    void expand (DRV_Token_Queue &in,
+                 DRV_Tokens &out,
+                 DRV_Line_Source *more);
+
+    void substitute (const DRV_Macro &macro,
+                     const std::vector<DRV_Tokens> &args,
+                     const std::set<std::string> &hide,
+                     DRV_Tokens &out);
+
+    static void paste (DRV_Tokens &os, const DRV_Tokens &rhs);
+
+    static DRV_Token stringize (const DRV_Tokens &arg);
+
+    static int param (const DRV_Macro &macro, const DRV_Token &t);
+
+    /// Continue the output on @a number of the current file.
+    void sync (long number);
+
+    void marker (long number, const char *flag);
+
+    void error (const std::string &message);
+
+    void warning (const std::string &message);
+
+    std::map<std::string, DRV_Macro> macros_;
+    std::vector<std::string> include_dirs_;
+
+    /// Files with #pragma once.
+    std::set<std::string> once_;
+
+    std::string output_;
+
+    /// Name of the current file, for line markers and messages.
+    std::string file_;
+
+    /// Number of the next output line in the current file.
+    long line_;
+
+    /// Line of the current file being processed, for messages and
+    /// __LINE__.
+    long directive_line_;
+
+    int errors_;
+  };
+
+  void
+  DRV_Cpp::option (const char *arg)
+  {
+    if (arg == nullptr || arg[0] != '-')
+      {
+        return;
+      }
+
+    std::string value;
+
+    for (const char *c = arg + 2; *c != '\0'; ++c)
+      {
+        if (*c != '"' || arg[1] != 'I')
+          {
+            value += *c;
+          }
+      }
+
+    switch (arg[1])
+      {
+      case 'D':
+        {
+          if (value.size () > 1 && value[0] == '"'
+              && value[value.size () - 1] == '"')
+            {
+              value = value.substr (1, value.size () - 2);
+            }
+
+          size_t const eq = value.find ('=');
+
+          if (eq == std::string::npos)
+            {
+              this->define (value + " 1");
+            }
+          else
+            {
+              this->define (value.substr (0, eq) + ' ' + value.substr (eq + 1));
+            }
+        }
+        break;
+      case 'U':
+        this->macros_.erase (value);
+        break;
+      case 'I':
+        {
+          size_t const start = value.find_first_not_of (' ');
+
+          if (start == std::string::npos || value == "-")
+            {
+              break;
+            }
+
+          value.erase (0, start);
+
+          while (value.size () > 1
+                 && (value[value.size () - 1] == '/'
+                     || value[value.size () - 1] == '\\'))
+            {
+              value.erase (value.size () - 1);
+            }
+
+          this->include_dirs_.push_back (value);
+        }
+        break;
+      default:
+        break;
+      }
+  }
+
+  void
+  DRV_Cpp::run (const char *in_file)
+  {
+    // Where includes were found depends on the directories searched,
+    // to which orb.idl adds.
+    if (this->include_dirs_ != DRV_found_dirs)
+      {
+        DRV_found.clear ();
+        DRV_found_dirs = this->include_dirs_;
+      }
+
+    this->file_ = in_file;
+    this->marker (1, nullptr);
+    this->process (in_file, 0);
+  }
+
+  void
+  DRV_Cpp::process (const std::string &path, int depth)
+  {
+    // The file was read when it was looked for.
+    const DRV_Source &src = *DRV_source (path);
+    std::vector<Conditional> conditionals;
+
+    // Presumed line number less physical line number, set by #line.
+    long delta = 0;
+
+    for (size_t i = 0; i < src.lines.size (); ++i)
+      {
+        const DRV_Line &line = src.lines[i];
+        bool const active =
+          conditionals.empty () || conditionals.back ().active;
+        std::string name;
+        std::string rest;
+
+        this->directive_line_ = line.number + delta;
+
+        if (DRV_directive (line.text, name, rest))
+          {
+            long const next_line =
+              (i + 1 < src.lines.size () ? src.lines[i + 1].number : src.end);
+
+            if (active
+                || name == "if" || name == "ifdef" || name == "ifndef"
+                || name == "elif" || name == "else" || name == "endif")
+              {
+                this->directive (name, rest, path, conditionals,
+                                 next_line, delta, depth);
+              }
+
+            continue;
+          }
+
+        if (!active
+            || line.text.find_first_not_of (" \t\v\f\r") == std::string::npos)
+          {
+            continue;
+          }
+
+        this->sync (line.number + delta);
+
+        if (!this->has_macro (line.text))
+          {
+            this->output_ += line.text;
+          }
+        else
+          {
+            DRV_Tokens tokens;
+            DRV_tokenize (line.text, tokens);
+            DRV_Token_Queue in (tokens.begin (), tokens.end ());
+            DRV_Tokens out;
+            DRV_Line_Source more (src, i);
+            this->expand (in, out, &more);
+            this->output_ += DRV_join (out);
+          }
+
+        this->output_ += '\n';
+        ++this->line_;
+      }
+
+    if (!conditionals.empty ())
+      {
+        this->directive_line_ = conditionals.back ().line;
+        this->error ("unterminated #" + conditionals.back ().name);
+      }
+  }
+
+  void
+  DRV_Cpp::directive (const std::string &name,
+                      const std::string &rest,
+                      const std::string &path,
+                      std::vector<Conditional> &conditionals,
+                      long next_line,
+                      long &delta,
+                      int depth)
+  {
+    if (name == "if" || name == "ifdef" || name == "ifndef")
+      {
+        Conditional c;
+        c.seen_else = false;
+        c.name = name;
+        c.line = this->directive_line_;
+
+        if (!conditionals.empty () && !conditionals.back ().active)
+          {
+            c.active = false;
+            c.taken = true;
+          }
+        else
+          {
+            if (name == "if")
+              {
+                c.active = this->evaluate (rest);
+              }
+            else
+              {
+                DRV_Tokens t;
+                DRV_tokenize (rest, t);
+                size_t const i = DRV_next_token (t, 0);
+
+                if (i == t.size () || t[i].kind != DRV_Token::IDENT)
+                  {
+                    this->error ("no macro name given in #" + name
+                                 + " directive");
+                    c.active = false;
+                  }
+                else
+                  {
+                    c.active = (this->macros_.count (t[i].text) != 0
+                                || t[i].text == "__FILE__"
+                                || t[i].text == "__LINE__")
+                               == (name == "ifdef");
+                  }
+              }
+
+            c.taken = c.active;
+          }
+
+        conditionals.push_back (c);
+      }
+    else if (name == "elif" || name == "else")
+      {
+        if (conditionals.empty () || conditionals.back ().seen_else)
+          {
+            this->error ("#" + name + " without #if");
+            return;
+          }
+
+        Conditional &c = conditionals.back ();
+
+        if (c.taken)
+          {
+            c.active = false;
+          }
+        else
+          {
+            c.active = name == "else" || this->evaluate (rest);
+            c.taken = c.active;
+          }
+
+        c.seen_else = name == "else";
+      }
+    else if (name == "endif")
+      {
+        if (conditionals.empty ())
+          {
+            this->error ("#endif without #if");
+            return;
+          }
+
+        conditionals.pop_back ();
+      }
+    else if (name == "include")
+      {
+        this->include (rest, path, next_line + delta, depth);
+      }
+    else if (name == "define")
+      {
+        this->define (rest);
+      }
+    else if (name == "undef")
+      {
+        DRV_Tokens t;
+        DRV_tokenize (rest, t);
+        size_t const i = DRV_next_token (t, 0);
+
+        if (i == t.size () || t[i].kind != DRV_Token::IDENT)
+          {
+            this->error ("no macro name given in #undef directive");
+            return;
+          }
+
+        this->macros_.erase (t[i].text);
+      }
+    else if (name == "line")
+      {
+        this->line_directive (rest, next_line, delta);
+      }
+    else if (name == "pragma" || name == "ident")
+      {
+        DRV_Tokens t;
+        DRV_tokenize (rest, t);
+        DRV_trim (t);
+
+        if (name == "pragma" && t.size () == 1 && t[0].text == "once")
+          {
+            this->once_.insert (path);
+            return;
+          }
+
+        // Left to the lexer.
+        this->sync (this->directive_line_);
+        this->output_ += '#' + name + rest + '\n';
+        ++this->line_;
+      }
+    else if (name == "error" || name == "warning")
+      {
+        DRV_Tokens t;
+        DRV_tokenize (rest, t);
+        DRV_trim (t);
+        std::string const message = '#' + name + ' ' + DRV_join (t);
+
+        if (name == "error")
+          {
+            this->error (message);
+          }
+        else
+          {
+            this->warning (message);
+          }
+      }
+    else if (!name.empty ())
+      {
+        this->error ("invalid preprocessing directive #" + name);
+      }
+  }
+
+  void
+  DRV_Cpp::include (const std::string &rest,
+                    const std::string &path,
+                    long next_line,
+                    int depth)
+  {
+    DRV_Tokens t;
+    DRV_tokenize (rest, t);
+    DRV_trim (t);
+
+    if (!t.empty () && t[0].kind == DRV_Token::IDENT)
+      {
+        // #include MACRO
+        DRV_Token_Queue in (t.begin (), t.end ());
+        DRV_Tokens out;
+        this->expand (in, out, nullptr);
+        DRV_trim (out);
+        t.swap (out);
+      }
+
+    std::string spec;
+
+    for (DRV_Tokens::const_iterator i = t.begin (); i != t.end (); ++i)
+      {
+        spec += i->text;
+      }
+
+    bool const quoted = spec.size () > 2 && spec[0] == '"'
+                        && spec[spec.size () - 1] == '"';
+    bool const angled = spec.size () > 2 && spec[0] == '<'
+                        && spec[spec.size () - 1] == '>';
+
+    if (!quoted && !angled)
+      {
+        this->error ("#include expects \"FILENAME\" or <FILENAME>");
+        return;
+      }
+
+    std::string const name = spec.substr (1, spec.size () - 2);
+    std::string found;
+
+    if (!this->find (name, quoted, DRV_dir_name (path), found))
+      {
+        this->error (name + ": No such file or directory");
+        throw DRV_Cpp_Fatal ();
+      }
+
+    // A file included again is skipped, without reading it again,
+    // if it has #pragma once or is all in an #ifndef of a macro
+    // still defined.
+    const DRV_Source &src = *DRV_source (found);
+
+    if (this->once_.count (found) != 0
+        || (!src.guard.empty () && this->macros_.count (src.guard) != 0))
+      {
+        return;
+      }
+
+    if (depth >= DRV_MAX_INCLUDE_DEPTH)
+      {
+        this->error ("#include nested too deeply");
+        throw DRV_Cpp_Fatal ();
+      }
+
+    std::string const file = this->file_;
+    this->file_ = found;
+    this->marker (1, "1");
+    this->process (found, depth + 1);
+    this->file_ = file;
+    this->marker (next_line, "2");
+  }
+
+  bool
+  DRV_Cpp::find (const std::string &name,
+                 bool quoted,
+                 const std::string &dir,
+                 std::string &found)
+  {
+    if (name.empty ())
+      {
+        return false;
+      }
+
+    std::string const key =
+      (quoted ? "\"" + dir : std::string ("<")) + '\n' + name;
+    std::map<std::string, std::string>::const_iterator const i =
+      DRV_found.find (key);
+
+    if (i != DRV_found.end ())
+      {
+        found = i->second;
+        return !found.empty ();
+      }
+
+    std::vector<std::string> candidates;
+
+    if (DRV_absolute (name))
+      {
+        candidates.push_back (name);
+      }
+    else
+      {
+        // "" includes are looked for next to the including file first.
+        if (quoted)
+          {
+            candidates.push_back (DRV_in_dir (dir, name));
+          }
+
+        for (size_t d = 0; d < this->include_dirs_.size (); ++d)
+          {
+            candidates.push_back (DRV_in_dir (this->include_dirs_[d], name));
+          }
+      }
+
+    found.clear ();
+
+    for (size_t c = 0; c < candidates.size (); ++c)
+      {
+        if (DRV_source (candidates[c]) != nullptr)
+          {
+            found = candidates[c];
+            break;
+          }
+      }
+
+    DRV_found[key] = found;
+    return !found.empty ();
+  }
+
+  void
+  DRV_Cpp::define (const std::string &rest)
+  {
+    DRV_Tokens t;
+    DRV_tokenize (rest, t);
+    size_t i = DRV_next_token (t, 0);
+
+    if (i == t.size () || t[i].kind != DRV_Token::IDENT)
+      {
+        this->error ("macro names must be identifiers");
+        return;
+      }
+
+    std::string const name = t[i].text;
+
+    if (name == "defined")
+      {
+        this->error ("\"defined\" cannot be used as a macro name");
+        return;
+      }
+
+    DRV_Macro macro;
+    macro.function_like = i + 1 < t.size () && t[i + 1].is ("(");
+    macro.variadic = false;
+    ++i;
+
+    if (macro.function_like)
+      {
+        // The parameters.
+        for (i = DRV_next_token (t, i + 1); ; i = DRV_next_token (t, i + 1))
+          {
+            if (i < t.size () && t[i].is (")") && macro.params.empty ())
+              {
+                break;
+              }
+
+            if (i < t.size () && t[i].is ("..."))
+              {
+                macro.variadic = true;
+                macro.params.push_back ("__VA_ARGS__");
+                i = DRV_next_token (t, i + 1);
+              }
+            else if (i < t.size () && t[i].kind == DRV_Token::IDENT)
+              {
+                macro.params.push_back (t[i].text);
+                i = DRV_next_token (t, i + 1);
+              }
+            else
+              {
+                this->error ("expected parameter name in macro \"" + name + '"');
+                return;
+              }
+
+            if (i < t.size () && t[i].is (")"))
+              {
+                break;
+              }
+
+            if (macro.variadic || i == t.size () || !t[i].is (","))
+              {
+                this->error ("expected ',' or ')' in the parameters of macro \""
+                             + name + '"');
+                return;
+              }
+          }
+
+        ++i;
+      }
+
+    macro.body.assign (t.begin () + i, t.end ());
+    DRV_trim (macro.body);
+
+    if ((!macro.body.empty () && macro.body.front ().is ("##"))
+        || (!macro.body.empty () && macro.body.back ().is ("##")))
+      {
+        this->error ("'##' cannot appear at either end of a macro expansion");
+        return;
+      }
+
+    this->macros_[name] = macro;
+  }
+
+  void
+  DRV_Cpp::line_directive (const std::string &rest,
+                           long next_line,
+                           long &delta)
+  {
+    DRV_Tokens t;
+    DRV_tokenize (rest, t);
+    DRV_Token_Queue in (t.begin (), t.end ());
+    DRV_Tokens out;
+    this->expand (in, out, nullptr);
+
+    size_t i = DRV_next_token (out, 0);
+
+    if (i == out.size () || out[i].kind != DRV_Token::NUMBER)
+      {
+        this->error ("#line directive requires a simple digit sequence");
+        return;
+      }
+
+    long const number = std::atol (out[i].text.c_str ());
+    i = DRV_next_token (out, i + 1);
+
+    if (i < out.size () && out[i].kind == DRV_Token::LITERAL
+        && out[i].text[0] == '"')
+      {
+        std::string file;
+        const std::string &text = out[i].text;
+
+        for (size_t c = 1; c + 1 < text.size (); ++c)
+          {
+            if (text[c] == '\\' && c + 2 < text.size ())
+              {
+                ++c;
+              }
+
+            file += text[c];
+          }
+
+        this->file_ = file;
+      }
+
+    delta = number - next_line;
+    this->marker (number, nullptr);
+  }
+
+  bool
+  DRV_Cpp::evaluate (const std::string &rest)
+  {
+    DRV_Tokens t;
+    DRV_tokenize (rest, t);
+
+    // Replace defined X and defined (X) before expanding macros.
+    DRV_Token_Queue in;
+
+    for (size_t i = 0; i < t.size (); ++i)
+      {
+        if (t[i].kind != DRV_Token::IDENT || t[i].text != "defined")
+          {
+            in.push_back (t[i]);
+            continue;
+          }
+
+        size_t j = DRV_next_token (t, i + 1);
+        bool const paren = j < t.size () && t[j].is ("(");
+
+        if (paren)
+          {
+            j = DRV_next_token (t, j + 1);
+          }
+
+        if (j == t.size () || t[j].kind != DRV_Token::IDENT)
+          {
+            this->error ("operator \"defined\" requires an identifier");
+            return false;
+          }
+
+        bool const defined = this->macros_.count (t[j].text) != 0
+                             || t[j].text == "__FILE__"
+                             || t[j].text == "__LINE__";
+
+        if (paren)
+          {
+            j = DRV_next_token (t, j + 1);
+
+            if (j == t.size () || !t[j].is (")"))
+              {
+                this->error ("missing ')' after \"defined\"");
+                return false;
+              }
+          }
+
+        in.push_back (DRV_Token (DRV_Token::NUMBER, defined ? "1" : "0"));
+        i = j;
+      }
+
+    DRV_Tokens expanded;
+    this->expand (in, expanded, nullptr);
+
+    DRV_Tokens e;
+
+    for (DRV_Tokens::const_iterator i = expanded.begin ();
+         i != expanded.end ();
+         ++i)
+      {
+        if (i->kind != DRV_Token::SPACE)
+          {
+            e.push_back (*i);
+          }
+      }
+
+    const char *error = nullptr;
+    long long const value = DRV_Expression (e).value (error);
+
+    if (error != nullptr)
+      {
+        this->error (error);
+        return false;
+      }
+
+    return value != 0;
+  }
+
+  bool
+  DRV_Cpp::has_macro (const std::string &text) const
+  {
+    size_t i = 0;
+    size_t const n = text.size ();
+
+    while (i < n)
+      {
+        char const c = text[i];
+
+        if (c == '"' || c == '\'')
+          {
+            i = DRV_skip_literal (text, i);
+          }
+        else if (ACE_OS::ace_isdigit (c))
+          {
+            i = DRV_skip_number (text, i);
+          }
+        else if (DRV_ident_start (c))
+          {
+            size_t const start = i;
+
+            while (i < n && DRV_ident_char (text[i]))
+              {
+                ++i;
+              }
+
+            if (c == 'L' && i - start == 1 && i < n
+                && (text[i] == '"' || text[i] == '\''))
+              {
+                continue;
+              }
+
+            std::string const name (text, start, i - start);
+
+            if (this->macros_.count (name) != 0
+                || name == "__FILE__"
+                || name == "__LINE__")
+              {
+                return true;
+              }
+          }
+        else
+          {
+            ++i;
+          }
+      }
+
+    return false;
+  }
+
+  void
+  DRV_Cpp::expand (DRV_Token_Queue &in,
+                   DRV_Tokens &out,
+                   DRV_Line_Source *more)
+  {
+    while (!in.empty ())
+      {
+        DRV_Token t = in.front ();
+        in.pop_front ();
+
+        if (t.kind != DRV_Token::IDENT || t.hide.count (t.text) != 0)
+          {
+            out.push_back (t);
+            continue;
+          }
+
+        if (t.text == "__LINE__" || t.text == "__FILE__")
+          {
+            char line[32];
+            ACE_OS::snprintf (line, sizeof line, "%ld", this->directive_line_);
+            out.push_back (t.text == "__LINE__"
+                             ? DRV_Token (DRV_Token::NUMBER, line)
+                             : stringize (DRV_Tokens (
+                                 1,
+                                 DRV_Token (DRV_Token::IDENT, this->file_))));
+            continue;
+          }
+
+        std::map<std::string, DRV_Macro>::const_iterator const m =
+          this->macros_.find (t.text);
+
+        if (m == this->macros_.end ())
+          {
+            out.push_back (t);
+            continue;
+          }
+
+        const DRV_Macro &macro = m->second;
+        std::set<std::string> hide;
+        std::vector<DRV_Tokens> args;
+
+        if (!macro.function_like)
+          {
+            hide = t.hide;
+          }
+        else
+          {
+            // Only a call of the macro is replaced.
+            size_t j = 0;
+
+            for (;;)
+              {
+                while (j < in.size () && in[j].kind == DRV_Token::SPACE)
+                  {
+                    ++j;
+                  }
+
+                if (j < in.size () || more == nullptr || !more->fetch (in))
+                  {
+                    break;
+                  }
+              }
+
+            if (j == in.size () || !in[j].is ("("))
+              {
+                out.push_back (t);
+                continue;
+              }
+
+            in.erase (in.begin (), in.begin () + j + 1);
+            args.push_back (DRV_Tokens ());
+            int nesting = 0;
+            bool closed = false;
+
+            for (;;)
+              {
+                if (in.empty () && (more == nullptr || !more->fetch (in)))
+                  {
+                    break;
+                  }
+
+                DRV_Token a = in.front ();
+                in.pop_front ();
+
+                if (a.is ("("))
+                  {
+                    ++nesting;
+                  }
+                else if (a.is (")") && nesting-- == 0)
+                  {
+                    std::set_intersection (
+                      t.hide.begin (), t.hide.end (),
+                      a.hide.begin (), a.hide.end (),
+                      std::inserter (hide, hide.begin ()));
+                    closed = true;
+                    break;
+                  }
+                else if (a.is (",") && nesting == 0
+                         && !(macro.variadic
+                              && args.size () == macro.params.size ()))
+                  {
+                    args.push_back (DRV_Tokens ());
+                    continue;
+                  }
+
+                args.back ().push_back (a);
+              }
+
+            if (!closed)
+              {
+                this->error ("unterminated argument list invoking macro \""
+                             + t.text + '"');
+                out.push_back (t);
+                continue;
+              }
+
+            for (size_t a = 0; a < args.size (); ++a)
+              {
+                DRV_trim (args[a]);
+              }
+
+            if (macro.params.empty () && args.size () == 1 && args[0].empty ())
+              {
+                args.clear ();
+              }
+            else if (macro.variadic && args.size () + 1 == macro.params.size ())
+              {
+                args.push_back (DRV_Tokens ());
+              }
+
+            if (args.size () != macro.params.size ())
+              {
+                char counts[64];
+                ACE_OS::snprintf (counts, sizeof counts,
+                                  "\" passed %lu arguments, but takes %lu",
+                                  static_cast<unsigned long> (args.size ()),
+                                  static_cast<unsigned long> (
+                                    macro.params.size ()));
+                this->error ("macro \"" + t.text + counts);
+                out.push_back (t);
+                continue;
+              }
+          }
+
+        hide.insert (t.text);
+        DRV_Tokens replacement;
+        this->substitute (macro, args, hide, replacement);
+        in.insert (in.begin (), replacement.begin (), replacement.end ());
+      }
+  }
+
+  void
+  DRV_Cpp::substitute (const DRV_Macro &macro,
+                       const std::vector<DRV_Tokens> &args,
+                       const std::set<std::string> &hide,
+                       DRV_Tokens &out)
+  {
+    const DRV_Tokens &body = macro.body;
+    DRV_Tokens os;
+
+    for (size_t i = 0; i < body.size (); ++i)
+      {
+        const DRV_Token &b = body[i];
+        size_t const next = DRV_next_token (body, i + 1);
+
+        if (macro.function_like && b.is ("#") && next < body.size ()
+            && param (macro, body[next]) >= 0)
+          {
+            os.push_back (stringize (args[param (macro, body[next])]));
+            i = next;
+            continue;
+          }
+
+        if (b.is ("##") && next < body.size ())
+          {
+            int const p = param (macro, body[next]);
+
+            if (p < 0)
+              {
+                paste (os, DRV_Tokens (1, body[next]));
+              }
+            else if (args[p].empty ())
+              {
+                paste (os, DRV_Tokens (1, DRV_Token (DRV_Token::PLACEMARKER,
+                                                     std::string ())));
+              }
+            else
+              {
+                paste (os, args[p]);
+              }
+
+            i = next;
+            continue;
+          }
+
+        int const p = param (macro, b);
+
+        if (p < 0)
+          {
+            os.push_back (b);
+          }
+        else if (next < body.size () && body[next].is ("##"))
+          {
+            // Operands of ## are not expanded.
+            if (args[p].empty ())
+              {
+                os.push_back (DRV_Token (DRV_Token::PLACEMARKER,
+                                         std::string ()));
+              }
+            else
+              {
+                os.insert (os.end (), args[p].begin (), args[p].end ());
+              }
+          }
+        else
+          {
+            DRV_Token_Queue arg (args[p].begin (), args[p].end ());
+            this->expand (arg, os, nullptr);
+          }
+      }
+
+    for (DRV_Tokens::iterator t = os.begin (); t != os.end (); ++t)
+      {
+        if (t->kind != DRV_Token::PLACEMARKER)
+          {
+            t->hide.insert (hide.begin (), hide.end ());
+            out.push_back (*t);
+          }
+      }
+  }
+
+  void
+  DRV_Cpp::paste (DRV_Tokens &os, const DRV_Tokens &rhs)
+  {
+    while (!os.empty () && os.back ().kind == DRV_Token::SPACE)
+      {
+        os.pop_back ();
+      }
+
+    if (os.empty () || os.back ().kind == DRV_Token::PLACEMARKER)
+      {
+        if (!os.empty ())
+          {
+            os.pop_back ();
+          }
+
+        os.insert (os.end (), rhs.begin (), rhs.end ());
+        return;
+      }
+
+    if (rhs.front ().kind != DRV_Token::PLACEMARKER)
+      {
+        std::string const text = os.back ().text + rhs.front ().text;
+        os.pop_back ();
+        DRV_tokenize (text, os);
+      }
+
+    os.insert (os.end (), rhs.begin () + 1, rhs.end ());
+  }
+
+  DRV_Token
+  DRV_Cpp::stringize (const DRV_Tokens &arg)
+  {
+    std::string s ("\"");
+
+    for (DRV_Tokens::const_iterator t = arg.begin (); t != arg.end (); ++t)
+      {
+        if (t->kind == DRV_Token::SPACE)
+          {
+            s += ' ';
+            continue;
+          }
+
+        bool const escape = t->kind == DRV_Token::LITERAL
+                            || t->kind == DRV_Token::IDENT;
+
+        for (size_t c = 0; c < t->text.size (); ++c)
+          {
+            if (escape && (t->text[c] == '"' || t->text[c] == '\\'))
+              {
+                s += '\\';
+              }
+
+            s += t->text[c];
+          }
+      }
+
+    return DRV_Token (DRV_Token::LITERAL, s + '"');
+  }
+
+  int
+  DRV_Cpp::param (const DRV_Macro &macro, const DRV_Token &t)
+  {
+    if (t.kind != DRV_Token::IDENT)
+      {
+        return -1;
+      }
+
+    for (size_t i = 0; i < macro.params.size (); ++i)
+      {
+        if (macro.params[i] == t.text)
+          {
+            return static_cast<int> (i);
+          }
+      }
+
+    return -1;
+  }
+
+  void
+  DRV_Cpp::sync (long number)
+  {
+    if (number == this->line_)
+      {
+        return;
+      }
+
+    if (number > this->line_ && number - this->line_ <= DRV_MAX_EMPTY_LINES)
+      {
+        this->output_.append (number - this->line_, '\n');
+        this->line_ = number;
+      }
+    else
+      {
+        this->marker (number, nullptr);
+      }
+  }
+
+  void
+  DRV_Cpp::marker (long number, const char *flag)
+  {
+    char buf[32];
+    ACE_OS::snprintf (buf, sizeof buf, "# %ld \"", number);
+    this->output_ += buf;
+
+    for (size_t c = 0; c < this->file_.size (); ++c)
+      {
+        if (this->file_[c] == '\\' || this->file_[c] == '"')
+          {
+            this->output_ += '\\';
+          }
+
+        this->output_ += this->file_[c];
+      }
+
+    this->output_ += '"';
+
+    if (flag != nullptr)
+      {
+        this->output_ += ' ';
+        this->output_ += flag;
+      }
+
+    this->output_ += '\n';
+    this->line_ = number;
+  }
+
+  void
+  DRV_Cpp::error (const std::string &message)
+  {
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("Error - %C: \"%C\", line %d: %C\n"),
+                idl_global->prog_name (),
+                this->file_.c_str (),
+                static_cast<int> (this->directive_line_),
+                message.c_str ()));
+    ++this->errors_;
+  }
+
+  void
+  DRV_Cpp::warning (const std::string &message)
+  {
+    if (idl_global->compile_flags () & IDL_CF_NOWARNINGS)
+      {
+        return;
+      }
+
+    ACE_ERROR ((LM_WARNING,
+                ACE_TEXT ("Warning - %C: \"%C\", line %d: %C\n"),
+                idl_global->prog_name (),
+                this->file_.c_str (),
+                static_cast<int> (this->directive_line_),
+                message.c_str ()));
+  }
+}
+
+bool
+DRV_cpp_builtin (char const *in_file, char const *out_file)
+{
+  DRV_Cpp cpp;
+
+  // The first argument is the external preprocessor, the others
+  // are passed on; -D, -U and -I apply.
+  for (unsigned long i = 1; i < DRV_argcount; ++i)
+    {
+      cpp.option (ACE_TEXT_ALWAYS_CHAR (DRV_arglist[i]));
+    }
+
+  if (DRV_source (in_file) == nullptr)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%C: cannot open cpp input file \"%C\": %m\n"),
+                  idl_global->prog_name (),
+                  in_file));
+      return false;
+    }
+
+  try
+    {
+      cpp.run (in_file);
+    }
+  catch (const DRV_Cpp_Fatal &)
+    {
+    }
+
+  // The input file is a temporary copy, never read again.
+  DRV_sources.erase (in_file);
+
+  if (cpp.errors () != 0)
+    {
+      return false;
+    }
+
+  ACE_HANDLE const fd = ACE_OS::open (out_file,
+                                      O_WRONLY | O_CREAT | O_EXCL,
+                                      ACE_DEFAULT_FILE_PERMS);
+
+  if (fd == ACE_INVALID_HANDLE)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%C: cannot open temp file \"%C\" for writing: %m\n"),
+                  idl_global->prog_name (),
+                  out_file));
+      return false;
+    }
+
+  const std::string &output = cpp.output ();
+  ssize_t const written = ACE_OS::write (fd, output.data (), output.size ());
+
+  if (ACE_OS::close (fd) == -1
+      || written != static_cast<ssize_t> (output.size ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%C: cannot write temp file \"%C\": %m\n"),
+                  idl_global->prog_name (),
+                  out_file));
+      return false;
+    }
+
+  return true;
+}
@@ -92,6 +92,9 @@ unsigned long const DRV_MAX_ARGCOUNT = 1024;
 unsigned long DRV_argcount = 0;
 ACE_TCHAR const * DRV_arglist[DRV_MAX_ARGCOUNT] = { nullptr };
 
+// Preprocess with DRV_cpp_builtin() instead of spawning cpp.
+bool DRV_builtin_cpp = false;
+
 static char const * output_arg_format = nullptr;
 static long output_arg_index = 0;
 
@@ -1058,6 +1061,183 @@ DRV_stripped_name (char *fn)
     return n;
 }
 
+// Pass the input through the external preprocessor, writing its
+// output to the file t_file.
+static void
+DRV_cpp_spawn (char const *t_file, char const *t_ifile)
+{
+  // We use ACE instead of the (low level) fork facilities, this also
+  // works on NT.
+  ACE_Process process;
+
+  DRV_cpp_expand_output_arg (t_file);
+  DRV_cpp_putarg (t_ifile);
+  DRV_cpp_putarg (nullptr); // Null terminate the DRV_arglist.
+
+  // For complex builds, the default
+  // command line buffer size of 1024
+  // is often not enough. We determine
+  // the required space and arg nr
+  // dynamically here.
+  ACE_Process_Options cpp_options (true,       // Inherit environment.
+                                   DRV_cpp_calc_total_argsize (),
+                                   16 * 1024,
+                                   512,
+                                   DRV_argcount);
+
+  if (cpp_options.command_line (DRV_arglist) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%C: command line processing \"%s\" failed\n"),
+                  idl_global->prog_name (),
+                  DRV_arglist[0]));
+
+      (void) ACE_OS::unlink (t_ifile);
+      (void) ACE_OS::unlink (t_file);
+      throw Bailout ();
+    }
+
+  ACE_HANDLE fd = ACE_INVALID_HANDLE;
+
+  if (output_arg_format == nullptr)
+    {
+      // If the following open() fails, then we're either being hit with a
+      // symbolic link attack, or another process opened the file before
+      // us.
+#if defined (ACE_OPENVMS)
+      //FUZZ: disable check_for_lack_ACE_OS
+      fd = ::open (t_file, O_WRONLY | O_CREAT | O_EXCL,
+                   ACE_DEFAULT_FILE_PERMS,
+                   "shr=get,put,upd", "ctx=rec", "fop=dfw");
+      //FUZZ: enable check_for_lack_ACE_OS
+#else
+      fd = ACE_OS::open (t_file,
+                         O_WRONLY | O_CREAT | O_EXCL,
+                         ACE_DEFAULT_FILE_PERMS);
+#endif
+
+      if (fd == ACE_INVALID_HANDLE)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "%C: cannot open temp file"
+                      " \"%C\" for writing: %m\n",
+                      idl_global->prog_name (),
+                      t_file));
+
+          (void) ACE_OS::unlink (t_file);
+          (void) ACE_OS::unlink (t_ifile);
+          throw Bailout ();
+        }
+
+      if (cpp_options.set_handles (ACE_INVALID_HANDLE, fd) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, "%C: cannot set stdout for child process: %m\n",
+                      idl_global->prog_name ()));
+
+          throw Bailout ();
+        }
+    }
+
+  if (idl_global->compile_flags () & IDL_CF_INFORMATIVE)
+    {
+      ACE_DEBUG ((LM_DEBUG, "%C: spawning: %s\n",
+                  idl_global->prog_name (),
+                  cpp_options.command_line_buf ()));
+    }
+
+  if (process.spawn (cpp_options) == ACE_INVALID_PID)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "%C: spawn of \"%s\" failed\n",
+                  idl_global->prog_name (),
+                  DRV_arglist[0]));
+
+
+      (void) ACE_OS::unlink (t_file);
+      (void) ACE_OS::unlink (t_ifile);
+      throw Bailout ();
+    }
+
+  if (fd != ACE_INVALID_HANDLE)
+    {
+      // Close the output file on the parent process.
+      if (ACE_OS::close (fd) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+            "%C: cannot close temp file \"%C\" on parent: %m\n",
+                      idl_global->prog_name (),
+                      t_file));
+
+          (void) ACE_OS::unlink (t_file);
+          (void) ACE_OS::unlink (t_ifile);
+          throw Bailout ();
+        }
+    }
+
+  // Remove the null termination and the
+  // input file from the DRV_arglist,
+  // the next file will the previous args.
+  DRV_argcount -= 2;
+  ACE::strdelete (
+    const_cast<ACE_TCHAR *> (DRV_arglist[DRV_argcount]));
+  DRV_arglist[DRV_argcount] = nullptr;
+  ACE_exitcode status = 0;
+
+  if (process.wait (&status) == ACE_INVALID_PID)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "%C: wait for child process failed\n",
+                  idl_global->prog_name ()));
+
+      (void) ACE_OS::unlink (t_file);
+      (void) ACE_OS::unlink (t_ifile);
+      throw Bailout ();
+    }
+
+  if (WIFEXITED ((status)))
+    {
+      // Child terminated normally?
+      if (WEXITSTATUS ((status)) != 0)
+        {
+          errno = WEXITSTATUS ((status));
+
+          ACE_ERROR ((LM_ERROR,
+                      "%C: preprocessor \"%s\" "
+                      "returned with an error\n",
+                      idl_global->prog_name (),
+                      DRV_arglist[0]));
+
+          (void) ACE_OS::unlink (t_file);
+          (void) ACE_OS::unlink (t_ifile);
+          throw Bailout ();
+        }
+    }
+  else
+    {
+      // Child didn't call exit(); perhaps it received a signal?
+      errno = EINTR;
+
+      ACE_ERROR ((LM_ERROR,
+                  "%C: preprocessor \"%s\" appears "
+                  "to have been interrupted\n",
+                  idl_global->prog_name (),
+                  DRV_arglist[0]));
+
+      (void) ACE_OS::unlink (t_file);
+      (void) ACE_OS::unlink (t_ifile);
+      throw Bailout ();
+    }
+  // TODO: Manage problems in the
+  // pre-processor, in the previous
+  // version the current process
+  // would exit if the pre-processor
+  // returned with error.
+
+#if defined (ACE_OPENVMS)
+  cpp_options.release_handles();
+#endif
+}
+
 // Pass input through preprocessor.
 void
 DRV_pre_proc (const char *myfile)
@@ -1198,37 +1378,6 @@ DRV_pre_proc (const char *myfile)
 
   idl_global->set_real_filename (real_tmp);
 
-  // We use ACE instead of the (low level) fork facilities, this also
-  // works on NT.
-  ACE_Process process;
-
-  DRV_cpp_expand_output_arg (t_file);
-  DRV_cpp_putarg (t_ifile);
-  DRV_cpp_putarg (nullptr); // Null terminate the DRV_arglist.
-
-  // For complex builds, the default
-  // command line buffer size of 1024
-  // is often not enough. We determine
-  // the required space and arg nr
-  // dynamically here.
-  ACE_Process_Options cpp_options (true,       // Inherit environment.
-                                   DRV_cpp_calc_total_argsize (),
-                                   16 * 1024,
-                                   512,
-                                   DRV_argcount);
-
-  if (cpp_options.command_line (DRV_arglist) != 0)
-    {
-      ACE_ERROR ((LM_ERROR,
-                  ACE_TEXT ("%C: command line processing \"%s\" failed\n"),
-                  idl_global->prog_name (),
-                  DRV_arglist[0]));
-
-      (void) ACE_OS::unlink (tmp_ifile);
-      (void) ACE_OS::unlink (tmp_file);
-      throw Bailout ();
-    }
-
   // Rename temporary files so that they have extensions accepted
   // by the preprocessor.  Renaming is (supposed to be) an atomic
   // operation so we shouldn't be susceptible to attack.
@@ -1264,116 +1413,16 @@ DRV_pre_proc (const char *myfile)
   // Remove any existing output file.
   (void) ACE_OS::unlink (t_file);
 
-  ACE_HANDLE fd = ACE_INVALID_HANDLE;
-
-  if (output_arg_format == nullptr)
+  if (DRV_builtin_cpp)
     {
-      // If the following open() fails, then we're either being hit with a
-      // symbolic link attack, or another process opened the file before
-      // us.
-#if defined (ACE_OPENVMS)
-      //FUZZ: disable check_for_lack_ACE_OS
-      fd = ::open (t_file, O_WRONLY | O_CREAT | O_EXCL,
-                   ACE_DEFAULT_FILE_PERMS,
-                   "shr=get,put,upd", "ctx=rec", "fop=dfw");
-      //FUZZ: enable check_for_lack_ACE_OS
-#else
-      fd = ACE_OS::open (t_file,
-                         O_WRONLY | O_CREAT | O_EXCL,
-                         ACE_DEFAULT_FILE_PERMS);
-#endif
-
-      if (fd == ACE_INVALID_HANDLE)
+      if (idl_global->compile_flags () & IDL_CF_INFORMATIVE)
         {
-          ACE_ERROR ((LM_ERROR,
-                      "%C: cannot open temp file"
-                      " \"%C\" for writing: %m\n",
-                      idl_global->prog_name (),
-                      t_file));
-
-          (void) ACE_OS::unlink (t_file);
-          (void) ACE_OS::unlink (t_ifile);
-          throw Bailout ();
-        }
-
-      if (cpp_options.set_handles (ACE_INVALID_HANDLE, fd) == -1)
-        {
-          ACE_ERROR ((LM_ERROR, "%C: cannot set stdout for child process: %m\n",
+          ACE_DEBUG ((LM_DEBUG, "%C: using the built-in preprocessor\n",
                       idl_global->prog_name ()));
-
-          throw Bailout ();
         }
-    }
-
-  if (idl_global->compile_flags () & IDL_CF_INFORMATIVE)
-    {
-      ACE_DEBUG ((LM_DEBUG, "%C: spawning: %s\n",
-                  idl_global->prog_name (),
-                  cpp_options.command_line_buf ()));
-    }
 
-  if (process.spawn (cpp_options) == ACE_INVALID_PID)
-    {
-      ACE_ERROR ((LM_ERROR,
-                  "%C: spawn of \"%s\" failed\n",
-                  idl_global->prog_name (),
-                  DRV_arglist[0]));
-
-
-      (void) ACE_OS::unlink (t_file);
-      (void) ACE_OS::unlink (t_ifile);
-      throw Bailout ();
-    }
-
-  if (fd != ACE_INVALID_HANDLE)
-    {
-      // Close the output file on the parent process.
-      if (ACE_OS::close (fd) == -1)
-        {
-          ACE_ERROR ((LM_ERROR,
-            "%C: cannot close temp file \"%C\" on parent: %m\n",
-                      idl_global->prog_name (),
-                      t_file));
-
-          (void) ACE_OS::unlink (t_file);
-          (void) ACE_OS::unlink (t_ifile);
-          throw Bailout ();
-        }
-    }
-
-  // Remove the null termination and the
-  // input file from the DRV_arglist,
-  // the next file will the previous args.
-  DRV_argcount -= 2;
-  ACE::strdelete (
-    const_cast<ACE_TCHAR *> (DRV_arglist[DRV_argcount]));
-  DRV_arglist[DRV_argcount] = nullptr;
-  ACE_exitcode status = 0;
-
-  if (process.wait (&status) == ACE_INVALID_PID)
-    {
-      ACE_ERROR ((LM_ERROR,
-                  "%C: wait for child process failed\n",
-                  idl_global->prog_name ()));
-
-      (void) ACE_OS::unlink (t_file);
-      (void) ACE_OS::unlink (t_ifile);
-      throw Bailout ();
-    }
-
-  if (WIFEXITED ((status)))
-    {
-      // Child terminated normally?
-      if (WEXITSTATUS ((status)) != 0)
+      if (!DRV_cpp_builtin (t_ifile, t_file))
         {
-          errno = WEXITSTATUS ((status));
-
-          ACE_ERROR ((LM_ERROR,
-                      "%C: preprocessor \"%s\" "
-                      "returned with an error\n",
-                      idl_global->prog_name (),
-                      DRV_arglist[0]));
-
           (void) ACE_OS::unlink (t_file);
           (void) ACE_OS::unlink (t_ifile);
           throw Bailout ();
@@ -1381,28 +1430,8 @@ DRV_pre_proc (const char *myfile)
     }
   else
     {
-      // Child didn't call exit(); perhaps it received a signal?
-      errno = EINTR;
-
-      ACE_ERROR ((LM_ERROR,
-                  "%C: preprocessor \"%s\" appears "
-                  "to have been interrupted\n",
-                  idl_global->prog_name (),
-                  DRV_arglist[0]));
-
-      (void) ACE_OS::unlink (t_file);
-      (void) ACE_OS::unlink (t_ifile);
-      throw Bailout ();
+      DRV_cpp_spawn (t_file, t_ifile);
     }
-  // TODO: Manage problems in the
-  // pre-processor, in the previous
-  // version the current process
-  // would exit if the pre-processor
-  // returned with error.
-
-#if defined (ACE_OPENVMS)
-  cpp_options.release_handles();
-#endif
 
   FILE * const yyin = ACE_OS::fopen (t_file, "r");
 
@@ -69,6 +69,7 @@ trademarks or registered trademarks of Sun Microsystems, Inc.
 extern void DRV_parse_args (long, char **);
 extern void DRV_usage ();
 extern void DRV_pre_proc (char const * myfile);
+extern bool DRV_cpp_builtin (char const * in_file, char const * out_file);
 extern void DRV_store_env_include_paths ();
 extern void DRV_cpp_init ();
 extern ACE_CString& DRV_add_include_path (ACE_CString&,
@@ -107,6 +107,10 @@ public:
   bool case_compare_quiet (Identifier *other);
   // Like the above but suppressing error or warning I/O
 
+  unsigned long case_hash ();
+  // Hash of the string ignoring case, never 0. Identifiers that
+  // case_compare() equal have the same hash.
+
   Identifier *copy ();
   // Create a deep copy.
 
@@ -129,6 +133,9 @@ private:
 
   // Did the IDL string have a leading underscore?
   bool escaped_;
+
+  // Cache of case_hash (), 0 until computed.
+  unsigned long case_hash_;
 };
 
 #endif          // _UTL_IDENTIFIER_UTL_IDENTIFIER_HH
@@ -0,0 +1,78 @@
+/**
+ * Header File for the Name Index of Scopes
+ *
+ * Source File Counterpart is util/utl_name_index.cpp.
+ */
+
+#ifndef UTL_NAME_INDEX_HEADER
+#define UTL_NAME_INDEX_HEADER
+
+#include "TAO_IDL_FE_Export.h"
+
+#include <unordered_map>
+#include <vector>
+
+class AST_Decl;
+class Identifier;
+
+/**
+ * Index of one of the arrays of a UTL_Scope by name.
+ *
+ * Gives the entries of the array that may have a name, ignoring case,
+ * in the order of the array, so that a lookup in a big scope compares
+ * the name with those entries only instead of with all of them. The
+ * entries of arrays shorter than THRESHOLD are not indexed: they are
+ * all given.
+ *
+ * The owner calls sync() before searching the array, and reset()
+ * after replacing, moving or renaming entries.
+ */
+class TAO_IDL_FE_Export UTL_Name_Index
+{
+public:
+  UTL_Name_Index ();
+
+  /**
+   * Bring the index up to date with the first @a used entries of
+   * @a array, indexing those appended since the last call.
+   */
+  ///{
+  void sync (AST_Decl **array, long used);
+  void sync (Identifier **array, long used);
+  ///}
+
+  /// Forget the entries, to index them again on the next sync().
+  void reset ();
+
+  /// First entry that may be named @a id, or -1 if there is none.
+  long first (Identifier *id) const;
+
+  /// Entry after @a i that may have the same name, or -1.
+  long next (long i) const;
+
+  /// Hash of @a id as indexed, 0 for no name.
+  static unsigned long hash (Identifier *id);
+
+private:
+  void add (unsigned long hash);
+
+  /// Arrays shorter than this are not indexed.
+  static const long THRESHOLD = 16;
+
+  struct Chain
+  {
+    long first;
+    long last;
+  };
+
+  /// First and last entry of each hash.
+  std::unordered_map<unsigned long, Chain> chains_;
+
+  /// Next entry with the same hash as each entry, or -1.
+  std::vector<long> next_;
+
+  /// Entries as of the last sync().
+  long used_;
+};
+
+#endif // UTL_NAME_INDEX_HEADER
@@ -80,6 +80,7 @@ trademarks or registered trademarks of Sun Microsystems, Inc.
 // function defined in the parent "AST_" class.
 
 #include "fe_utils.h"
+#include "utl_name_index.h"
 
 // This is for AIX w/IBM C++.
 class Identifier;
@@ -288,6 +289,10 @@ protected:
   // Set the appropriate *_seen_ flag if we are seeing a spec-defined
   // sequence of a basic type.
 
+  void reset_name_indexes ();
+  // Called after changing the storage below other than by the
+  // add_to_* and replace_* operations.
+
 protected:
   // Data.
 
@@ -299,6 +304,7 @@ protected:
   AST_Decl **pd_decls;                // Store declarations
   long pd_decls_allocated;            // How many allocated?
   long pd_decls_used;                 // How many used?
+  UTL_Name_Index pd_decls_index;      // Finds them by name
 
   // Storage for local manifest types in this scope.
   AST_Decl **pd_local_types;          // Store types
@@ -309,6 +315,7 @@ protected:
   AST_Decl **pd_referenced;           // Store references
   long pd_referenced_allocated;       // How many allocated?
   long  pd_referenced_used;           // How many used?
+  UTL_Name_Index pd_referenced_index; // Finds them by name
 
   // Storage for identifiers used in this scope. CORBA 2.3 introduced
   // stricter rules for clashes during name resolution, and the information
@@ -316,6 +323,7 @@ protected:
   Identifier **pd_name_referenced;    // Store name references
   long pd_name_referenced_allocated;  // How many allocated?
   long pd_name_referenced_used;       // How many used?
+  UTL_Name_Index pd_name_referenced_index; // Finds them
 
   // Have we seen a #pragma prefix declaration in this scope?
   bool has_prefix_;
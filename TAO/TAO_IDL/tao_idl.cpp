@@ -80,9 +80,12 @@ trademarks or registered trademarks of Sun Microsystems, Inc.
 
 #include "tao/Version.h"
 #include "ace/Argv_Type_Converter.h"
+#include "ace/Process_Manager.h"
 #include "ace/OS_NS_stdio.h"
 #include "ace/OS_NS_unistd.h"
 
+#include <vector>
+
 #if !defined (ACE_LACKS_IOSTREAM_TOTALLY)
 // FUZZ: disable check_for_streams_include
 #  include "ace/streams.h"
@@ -95,6 +98,11 @@ char *DRV_files[NFILES];
 long DRV_nfiles = 0;
 long DRV_file_index = -1;
 
+// Number of processes compiling the files (--jobs), and the files
+// this one compiles (--job-slice) if it is one of them.
+long DRV_jobs = 1;
+long DRV_job_slice = -1;
+
 void
 DRV_version ()
 {
@@ -311,6 +319,75 @@ DRV_drive (const char *s)
   DRV_refresh ();
 }
 
+// Compile the files in DRV_jobs processes, each spawned with the
+// command line of this one and a --job-slice of the files, and
+// return the number of errors they found.
+static int
+DRV_spawn_jobs (int argc, ACE_TCHAR *argv[])
+{
+  long const jobs = DRV_jobs < DRV_nfiles ? DRV_jobs : DRV_nfiles;
+  ACE_Process_Manager manager (static_cast<size_t> (jobs));
+  int errors = 0;
+
+  for (long slice = 0; slice < jobs; ++slice)
+    {
+      ACE_TCHAR slice_arg[64];
+      ACE_OS::sprintf (slice_arg, ACE_TEXT ("%ld,%ld"), slice, jobs);
+
+      // Ahead of the arguments, which may end with files after "--".
+      std::vector<const ACE_TCHAR *> args;
+      args.push_back (argv[0]);
+      args.push_back (ACE_TEXT ("--job-slice"));
+      args.push_back (slice_arg);
+      args.insert (args.end (), argv + 1, argv + argc);
+      args.push_back (nullptr);
+
+      size_t length = 0;
+      for (size_t i = 0; i + 1 < args.size (); ++i)
+        {
+          length += ACE_OS::strlen (args[i]) + 1;
+        }
+
+      // As for cpp, the default command line buffer may be too small.
+      ACE_Process_Options options (true,       // Inherit environment.
+                                   length + 1,
+                                   16 * 1024,
+                                   512,
+                                   args.size () + 1);
+
+      if (options.command_line (&args[0]) != 0
+          || manager.spawn (options) == ACE_INVALID_PID)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%C: spawn of \"%s\" failed\n"),
+                      idl_global->prog_name (),
+                      argv[0]));
+          ++errors;
+        }
+    }
+
+  while (manager.managed () != 0)
+    {
+      ACE_exitcode status = 0;
+
+      if (manager.wait (0, &status) == ACE_INVALID_PID)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%C: wait for child process failed\n"),
+                      idl_global->prog_name ()));
+          return errors + 1;
+        }
+
+      // Count the failed children, a sum of exit statuses may wrap.
+      if (!WIFEXITED ((status)) || WEXITSTATUS ((status)) != 0)
+        {
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
 /*
 ** LOGIC:
 **
@@ -360,6 +437,17 @@ ACE_TMAIN (int argc, ACE_TCHAR *argv[])
           throw Bailout (status);
         }
 
+      // With --jobs, the files are compiled by other processes.
+      if (DRV_jobs > 1
+          && DRV_job_slice < 0
+          && DRV_nfiles > 1
+          && !idl_global->multi_file_input ()
+          && !(idl_global->compile_flags () & IDL_CF_ONLY_PREPROC))
+        {
+          throw Bailout (DRV_spawn_jobs (atc.get_argc (),
+                                         atc.get_TCHAR_argv ()));
+        }
+
       AST_Generator *gen = be_util::generator_init ();
 
       if (nullptr == gen)
@@ -425,7 +513,8 @@ ACE_TMAIN (int argc, ACE_TCHAR *argv[])
                                "#include \"%s\"\n",
                                DRV_files[DRV_file_index]);
             }
-          else
+          else if (DRV_job_slice < 0
+                   || DRV_file_index % DRV_jobs == DRV_job_slice)
             {
               DRV_drive (DRV_files[DRV_file_index]);
             }
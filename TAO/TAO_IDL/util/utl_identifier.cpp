@@ -71,23 +71,27 @@ trademarks or registered trademarks of Sun Microsystems, Inc.
 // FUZZ: disable check_for_streams_include
 #include "ace/streams.h"
 #include "ace/OS_NS_string.h"
+#include "ace/OS_NS_ctype.h"
 
 Identifier::Identifier ()
   : pv_string (nullptr),
-    escaped_ (false)
+    escaped_ (false),
+    case_hash_ (0)
 {
 }
 
 Identifier::Identifier (const char *s)
   : pv_string (nullptr),
-    escaped_ (false)
+    escaped_ (false),
+    case_hash_ (0)
 {
   preprocess_and_replace_string (s);
 }
 
 Identifier::Identifier (const Identifier &other)
   : pv_string (nullptr),
-    escaped_ (other.escaped ())
+    escaped_ (other.escaped ()),
+    case_hash_ (0)
 {
   *this = other;
 }
@@ -122,6 +126,7 @@ Identifier::replace_string (const char * s)
       delete [] this->pv_string;
     }
   this->pv_string = s ? ACE::strnew (s) : nullptr;
+  this->case_hash_ = 0;
 }
 
 void
@@ -205,6 +210,26 @@ Identifier::case_compare_quiet (Identifier *o)
   return UTL_String::compare_quiet (this->pv_string, o->pv_string);
 }
 
+unsigned long
+Identifier::case_hash ()
+{
+  if (this->case_hash_ == 0)
+    {
+      // Folds case as UTL_String::strcmp_caseless() does.
+      unsigned long h = 5381;
+      for (const char *c = this->pv_string;
+           c != nullptr && *c != '\0';
+           ++c)
+        {
+          h = h * 33 + static_cast<unsigned char> (ACE_OS::ace_toupper (*c));
+        }
+
+      this->case_hash_ = h != 0 ? h : 1;
+    }
+
+  return this->case_hash_;
+}
+
 Identifier *
 Identifier::copy ()
 {
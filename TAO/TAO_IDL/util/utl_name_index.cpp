@@ -0,0 +1,112 @@
+/**
+ * Source File for the Name Index of Scopes
+ *
+ * Header File Counterpart is include/utl_name_index.h
+ */
+
+#include "utl_name_index.h"
+#include "utl_identifier.h"
+#include "ast_decl.h"
+
+UTL_Name_Index::UTL_Name_Index ()
+  : used_ (0)
+{
+}
+
+void
+UTL_Name_Index::sync (AST_Decl **array, long used)
+{
+  if (used < this->used_)
+    {
+      this->reset ();
+    }
+
+  if (used >= THRESHOLD)
+    {
+      for (long i = static_cast<long> (this->next_.size ()); i < used; ++i)
+        {
+          this->add (UTL_Name_Index::hash (array[i]->local_name ()));
+        }
+    }
+
+  this->used_ = used;
+}
+
+void
+UTL_Name_Index::sync (Identifier **array, long used)
+{
+  if (used < this->used_)
+    {
+      this->reset ();
+    }
+
+  if (used >= THRESHOLD)
+    {
+      for (long i = static_cast<long> (this->next_.size ()); i < used; ++i)
+        {
+          this->add (UTL_Name_Index::hash (array[i]));
+        }
+    }
+
+  this->used_ = used;
+}
+
+void
+UTL_Name_Index::reset ()
+{
+  this->chains_.clear ();
+  this->next_.clear ();
+  this->used_ = 0;
+}
+
+long
+UTL_Name_Index::first (Identifier *id) const
+{
+  if (this->next_.empty ())
+    {
+      return this->used_ > 0 ? 0 : -1;
+    }
+
+  std::unordered_map<unsigned long, Chain>::const_iterator const c =
+    this->chains_.find (UTL_Name_Index::hash (id));
+
+  return c == this->chains_.end () ? -1 : c->second.first;
+}
+
+long
+UTL_Name_Index::next (long i) const
+{
+  if (this->next_.empty ())
+    {
+      return i + 1 < this->used_ ? i + 1 : -1;
+    }
+
+  return this->next_[i];
+}
+
+unsigned long
+UTL_Name_Index::hash (Identifier *id)
+{
+  return id == nullptr ? 0 : id->case_hash ();
+}
+
+void
+UTL_Name_Index::add (unsigned long hash)
+{
+  long const i = static_cast<long> (this->next_.size ());
+  this->next_.push_back (-1);
+
+  std::pair<std::unordered_map<unsigned long, Chain>::iterator, bool> c =
+    this->chains_.insert (std::make_pair (hash, Chain ()));
+
+  if (c.second)
+    {
+      c.first->second.first = i;
+    }
+  else
+    {
+      this->next_[c.first->second.last] = i;
+    }
+
+  c.first->second.last = i;
+}
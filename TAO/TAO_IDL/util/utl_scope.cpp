@@ -222,6 +222,8 @@ UTL_Scope::destroy ()
   this->pd_name_referenced = nullptr;
   this->pd_name_referenced_allocated = 0;
   this->pd_name_referenced_used = 0;
+
+  this->reset_name_indexes ();
 }
 
 // Protected operations.
@@ -467,6 +469,14 @@ UTL_Scope::check_for_predef_seq (AST_Decl *d)
     }
 }
 
+void
+UTL_Scope::reset_name_indexes ()
+{
+  this->pd_decls_index.reset ();
+  this->pd_referenced_index.reset ();
+  this->pd_name_referenced_index.reset ();
+}
+
 // Protected Front End Scope Management Protocol.
 //
 // All members of the protocol defined in UTL_Scope simply return NULL
@@ -980,11 +990,14 @@ UTL_Scope::lookup_pseudo (Identifier *e)
       return nullptr;
     }
 
-  for (UTL_ScopeActiveIterator i (start_scope, IK_decls);
-       !i.is_done ();
-       i.next ())
+  start_scope->pd_decls_index.sync (start_scope->pd_decls,
+                                    start_scope->pd_decls_used);
+
+  for (long i = start_scope->pd_decls_index.first (e);
+       i != -1;
+       i = start_scope->pd_decls_index.next (i))
     {
-      AST_Decl *d = i.item ();
+      AST_Decl *d = start_scope->pd_decls[i];
 
       if (e->case_compare (d->local_name ()))
         {
@@ -1127,11 +1140,13 @@ UTL_Scope::lookup_by_name_local (Identifier *e,
 
   // We search only the decls here, the local types are done
   // below as a last resort.
-  for (UTL_ScopeActiveIterator i (this, IK_decls);
-       !i.is_done ();
-       i.next ())
+  this->pd_decls_index.sync (this->pd_decls, this->pd_decls_used);
+
+  for (long i = this->pd_decls_index.first (e);
+       i != -1;
+       i = this->pd_decls_index.next (i))
     {
-      d = i.item ()->adjust_found (true, full_def_only);
+      d = this->pd_decls[i]->adjust_found (true, full_def_only);
 
       if (d != nullptr)
         {
@@ -1334,11 +1349,13 @@ UTL_Scope::lookup_by_name_r (UTL_ScopedName *e,
       bool in_corba =
         (ACE_OS::strcmp (e->head ()->get_string (), "CORBA") == 0);
 
-      for (UTL_ScopeActiveIterator i (work, IK_decls);
-           !i.is_done ();
-           i.next ())
+      work->pd_decls_index.sync (work->pd_decls, work->pd_decls_used);
+
+      for (long i = work->pd_decls_index.first (e->head ());
+           i != -1;
+           i = work->pd_decls_index.next (i))
         {
-          d = i.item ()->adjust_found (true, full_def_only);
+          d = work->pd_decls[i]->adjust_found (true, full_def_only);
           if (d
           // Right now we populate the global scope with all the CORBA basic
           // types, so something like 'ULong' in an IDL file will find a
@@ -1465,6 +1482,7 @@ UTL_Scope::add_to_referenced (AST_Decl *e,
         }
       this->pd_referenced [i] = e;
       ++this->pd_referenced_used;
+      this->pd_referenced_index.reset ();
     }
 
   // Now, if recursive is specified and "this" is not a common ancestor
@@ -1520,6 +1538,7 @@ UTL_Scope::replace_referenced (AST_Decl *old_decl,
       if (this->pd_referenced[i] == old_decl)
         {
           this->pd_referenced[i] = new_decl;
+          this->pd_referenced_index.reset ();
           break;
         }
     }
@@ -1534,6 +1553,7 @@ UTL_Scope::replace_scope (AST_Decl *old_decl,
       if (this->pd_decls[i] == old_decl)
         {
           this->pd_decls[i] = new_decl;
+          this->pd_decls_index.reset ();
           break;
         }
     }
@@ -1556,20 +1576,21 @@ UTL_Scope::add_to_scope (AST_Decl *e,
   // First, make sure there's no clash between e, that was
   // just declared, and some other identifier referenced
   // in this scope.
-  AST_Decl **tmp = this->pd_decls;
-  for (long i = this->pd_decls_used;
-       i--; // NOTE i-- test
-       ++tmp)
+  this->pd_decls_index.sync (this->pd_decls, this->pd_decls_used);
+
+  for (long i = this->pd_decls_index.first (decl_name);
+       i != -1;
+       i = this->pd_decls_index.next (i))
     {
       // A local declaration doesn't use a scoped name.
-      Identifier *ref_name = (*tmp)->local_name ();
+      Identifier *ref_name = this->pd_decls[i]->local_name ();
       char *ref_string = ref_name->get_string ();
 
       // If the names compare exactly, it's a redefini8tion
       // error, unless they're both modules (which can be
       // reopened) or we have a belated definition of a
       // forward-declared interface.
-      AST_Decl::NodeType scope_elem_nt = (*tmp)->node_type ();
+      AST_Decl::NodeType scope_elem_nt = this->pd_decls[i]->node_type ();
 
       if (this->redef_clash (new_nt, scope_elem_nt)
           && decl_name->compare (ref_name))
@@ -1649,6 +1670,7 @@ UTL_Scope::add_to_scope (AST_Decl *e,
       long odecls_allocated = this->pd_decls_allocated;
       this->pd_decls_allocated += INCREMENT;
 
+      AST_Decl **tmp = nullptr;
       ACE_NEW (tmp, AST_Decl *[pd_decls_allocated]);
       for (long i = 0; i < odecls_allocated; ++i)
         {
@@ -1675,6 +1697,7 @@ UTL_Scope::add_to_scope (AST_Decl *e,
         }
       this->pd_decls [i] = e;
       ++this->pd_decls_used;
+      this->pd_decls_index.reset ();
     }
 }
 
@@ -1717,21 +1740,27 @@ UTL_Scope::referenced (AST_Decl *e,
   Identifier *test = e->local_name ();
   AST_Decl::NodeType nt = e->node_type ();
 
-  AST_Decl **tmp = this->pd_referenced;
-  for (long i = this->pd_referenced_used;
-       i--; // NOTE test with i--
-       ++tmp)
+  // A node has the same name wherever it is referenced, so
+  // only the references by the same name need be compared.
+  this->pd_referenced_index.sync (this->pd_referenced,
+                                  this->pd_referenced_used);
+
+  for (long i = this->pd_referenced_index.first (test);
+       i != -1;
+       i = this->pd_referenced_index.next (i))
     {
+      AST_Decl *ref = this->pd_referenced[i];
+
       // Same node?
-      if (*tmp == e)
+      if (ref == e)
         {
           return true;
         }
 
       // Are we definging a forward declared struct, union, or interface,
       // or reopening a module?
-      if (!this->redef_clash (nt, (*tmp)->node_type ())
-          && (*tmp)->local_name ()->compare (test))
+      if (!this->redef_clash (nt, ref->node_type ())
+          && ref->local_name ()->compare (test))
         {
           return false;
         }
@@ -1745,11 +1774,15 @@ UTL_Scope::referenced (AST_Decl *e,
   // so we can catch these name reolution clashes.
   if (id)
     {
-      Identifier **name_tmp = this->pd_name_referenced;
-      for (long j = this->pd_name_referenced_used;
-           j--; // NOTE test with j--
-           ++name_tmp)
+      this->pd_name_referenced_index.sync (this->pd_name_referenced,
+                                           this->pd_name_referenced_used);
+
+      for (long j = this->pd_name_referenced_index.first (id);
+           j != -1;
+           j = this->pd_name_referenced_index.next (j))
         {
+          Identifier **name_tmp = this->pd_name_referenced + j;
+
           // If we are a module, there is no clash, if we
           // are an interface, this is not the right place to
           // catch a clash, and if it wasn't defined in this
@@ -0,0 +1,987 @@
+#include "orbsvcs/Log_Macros.h"
+#include "Binary_Backing_Store.h"
+#include "Server_Info.h"
+#include "Activator_Info.h"
+#include "ace/CDR_Stream.h"
+#include "ace/File_Lock.h"
+#include "ace/Mem_Map.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+
+namespace {
+  const char REPO_MAGIC[] = { 'I', 'm', 'R', 'B' };
+  const ACE_CDR::Octet REPO_VERSION = 1;
+
+  /// magic, byte order, version, generation and padding
+  const size_t HEADER_SIZE = 16;
+  /// record kind and size
+  const size_t RECORD_HEADER_SIZE = 8;
+  /// records start at a multiple of this
+  const size_t RECORD_ALIGN = 8;
+  /// stale records tolerated before the log is compacted
+  const size_t COMPACT_SLACK = 1024;
+
+  enum RecordKind
+  {
+    SERVER_RECORD = 1,
+    ACTIVATOR_RECORD = 2,
+    REMOVE_SERVER_RECORD = 3,
+    REMOVE_ACTIVATOR_RECORD = 4
+  };
+
+  /// start a record, returns where its size goes
+  char* begin_record (ACE_OutputCDR& out, ACE_CDR::ULong kind, size_t& start)
+  {
+    start = out.total_length ();
+    out.write_ulong (kind);
+    return out.write_long_placeholder ();
+  }
+
+  /// pad the record and fill in its size
+  void end_record (ACE_OutputCDR& out, char* size_pos, size_t start)
+  {
+    out.align_write_ptr (RECORD_ALIGN);
+    out.replace (static_cast<ACE_CDR::ULong> (out.total_length () - start),
+                 size_pos);
+  }
+
+  void write_values (ACE_OutputCDR& out,
+                     const XML_Backing_Store::NameValues& values)
+  {
+    out.write_ulong (static_cast<ACE_CDR::ULong> (values.size ()));
+    XML_Backing_Store::NameValues::const_iterator nv;
+    for (nv = values.begin (); nv != values.end (); ++nv)
+      {
+        out.write_string (nv->first);
+        out.write_string (nv->second);
+      }
+  }
+
+  /// read a sequence length, every element takes at least 4 octets
+  bool read_length (ACE_InputCDR& in, ACE_CDR::ULong& len)
+  {
+    return in.read_ulong (len) && len <= in.length () / 4;
+  }
+
+  bool read_values (ACE_InputCDR& in, XML_Backing_Store::NameValues& values)
+  {
+    ACE_CDR::ULong len = 0;
+    if (!read_length (in, len))
+      {
+        return false;
+      }
+    values.reserve (len);
+    for (ACE_CDR::ULong i = 0; i < len; ++i)
+      {
+        ACE_CString name;
+        ACE_CString value;
+        if (!in.read_string (name) || !in.read_string (value))
+          {
+            return false;
+          }
+        values.push_back (std::make_pair (name, value));
+      }
+    return true;
+  }
+}
+
+//---------------------------------------------------------------------------
+
+Binary_Repository_File::Binary_Repository_File (const ACE_TString& filename,
+                                                unsigned int debug)
+: filename_ (filename),
+  debug_ (debug),
+  lock_ (),
+  rewriting_ (false),
+  byte_order_ (ACE_CDR::BYTE_ORDER_NATIVE),
+  generation_ (0),
+  offset_ (HEADER_SIZE),
+  records_ (0),
+  rewrite_ (),
+  rewrite_records_ (0)
+{
+}
+
+Binary_Repository_File::~Binary_Repository_File (void)
+{
+}
+
+const ACE_TString&
+Binary_Repository_File::filename (void) const
+{
+  return this->filename_;
+}
+
+int
+Binary_Repository_File::acquire (void)
+{
+  if (this->rewriting_)
+    {
+      return 0;
+    }
+  if (this->lock_.get () == 0 || this->lock_->acquire_write () != 0)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) Couldn't lock %s\n"),
+                      this->filename_.c_str ()));
+      return -1;
+    }
+  return 0;
+}
+
+void
+Binary_Repository_File::release (void)
+{
+  if (!this->rewriting_)
+    {
+      this->lock_->release ();
+    }
+}
+
+int
+Binary_Repository_File::open (void)
+{
+  ACE_File_Lock *lock = 0;
+  ACE_NEW_RETURN (lock,
+                  ACE_File_Lock (this->filename_.c_str (),
+                                 O_RDWR | O_CREAT,
+                                 ACE_DEFAULT_FILE_PERMS,
+                                 false),
+                  -1);
+  this->lock_.reset (lock);
+  if (lock->get_handle () == ACE_INVALID_HANDLE)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) Couldn't open %s\n"),
+                      this->filename_.c_str ()));
+      return -1;
+    }
+
+  if (this->acquire () != 0)
+    {
+      return -1;
+    }
+
+  int result = 0;
+  ACE_CDR::ULong generation = 0;
+  if (this->read_header (generation) != 0)
+    {
+      ACE_OFF_T const size = ACE_OS::filesize (lock->get_handle ());
+      if (size < static_cast<ACE_OFF_T> (HEADER_SIZE))
+        {
+          // new file
+          ACE_OutputCDR out (HEADER_SIZE + ACE_CDR::MAX_ALIGNMENT,
+                             this->byte_order_);
+          this->encode_header (out, 1);
+          result = this->write_at (lock->get_handle (), out, 0);
+        }
+      else if (this->restore_backup () == 0)
+        {
+          // a rewrite was interrupted
+          result = this->read_header (generation);
+        }
+      else
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) %s is not an ImR binary repository\n"),
+                          this->filename_.c_str ()));
+          result = -1;
+        }
+    }
+
+  this->release ();
+  return result;
+}
+
+int
+Binary_Repository_File::erase (void)
+{
+  if (this->acquire () != 0)
+    {
+      return -1;
+    }
+
+  ACE_CDR::ULong generation = 0;
+  this->read_header (generation);
+
+  // a new generation tells a peer to drop what it loaded
+  ACE_OutputCDR out (HEADER_SIZE + ACE_CDR::MAX_ALIGNMENT, this->byte_order_);
+  this->encode_header (out, generation + 1);
+  ACE_HANDLE const handle = this->lock_->get_handle ();
+  int result = ACE_OS::ftruncate (handle, 0);
+  if (result == 0)
+    {
+      result = this->write_at (handle, out, 0);
+    }
+  ACE_OS::unlink ((this->filename_ + ACE_TEXT (".bak")).c_str ());
+  this->records_ = 0;
+
+  if (this->debug_ > 9)
+    {
+      ORBSVCS_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) Erased %s\n"),
+                      this->filename_.c_str ()));
+    }
+
+  this->release ();
+  return result;
+}
+
+void
+Binary_Repository_File::encode_header (ACE_OutputCDR& out,
+                                       ACE_CDR::ULong generation) const
+{
+  out.write_octet_array (reinterpret_cast<const ACE_CDR::Octet*> (REPO_MAGIC),
+                         sizeof (REPO_MAGIC));
+  out.write_octet (static_cast<ACE_CDR::Octet> (this->byte_order_));
+  out.write_octet (REPO_VERSION);
+  out.write_ulong (generation);
+  out.write_ulong (0);
+}
+
+int
+Binary_Repository_File::read_header (ACE_CDR::ULong& generation)
+{
+  ACE_CDR::ULongLong buf[HEADER_SIZE / sizeof (ACE_CDR::ULongLong)];
+  char *const header = reinterpret_cast<char*> (buf);
+  if (ACE_OS::pread (this->lock_->get_handle (), header, HEADER_SIZE, 0)
+      != static_cast<ssize_t> (HEADER_SIZE) ||
+      ACE_OS::memcmp (header, REPO_MAGIC, sizeof (REPO_MAGIC)) != 0 ||
+      static_cast<ACE_CDR::Octet> (header[5]) != REPO_VERSION)
+    {
+      return -1;
+    }
+
+  this->byte_order_ = header[4];
+  ACE_InputCDR in (header + 8, HEADER_SIZE - 8, this->byte_order_);
+  return in.read_ulong (generation) ? 0 : -1;
+}
+
+int
+Binary_Repository_File::restore_backup (void)
+{
+  const ACE_TString bfname = this->filename_ + ACE_TEXT (".bak");
+  ACE_HANDLE const bak = ACE_OS::open (bfname.c_str (), O_RDONLY);
+  if (bak == ACE_INVALID_HANDLE)
+    {
+      return -1;
+    }
+
+  int result = -1;
+  ACE_OFF_T const size = ACE_OS::filesize (bak);
+  if (size >= static_cast<ACE_OFF_T> (HEADER_SIZE))
+    {
+      ACE_Mem_Map map (bak, static_cast<size_t> (size), PROT_READ,
+                       ACE_MAP_PRIVATE);
+      const char *data = static_cast<const char*> (map.addr ());
+      if (map.addr () != MAP_FAILED && data != 0 &&
+          ACE_OS::memcmp (data, REPO_MAGIC, sizeof (REPO_MAGIC)) == 0)
+        {
+          ACE_HANDLE const handle = this->lock_->get_handle ();
+          if (ACE_OS::ftruncate (handle, 0) == 0 &&
+              ACE_OS::pwrite (handle, data, static_cast<size_t> (size), 0)
+              == static_cast<ssize_t> (size) &&
+              ACE_OS::fsync (handle) == 0)
+            {
+              ORBSVCS_ERROR ((LM_WARNING,
+                              ACE_TEXT ("(%P|%t) Restored %s from %s\n"),
+                              this->filename_.c_str (), bfname.c_str ()));
+              result = 0;
+            }
+        }
+    }
+  ACE_OS::close (bak);
+  if (result == 0)
+    {
+      ACE_OS::unlink (bfname.c_str ());
+    }
+  return result;
+}
+
+int
+Binary_Repository_File::load (XML_Backing_Store& repo, bool& full)
+{
+  if (this->acquire () != 0)
+    {
+      return -1;
+    }
+
+  ACE_CDR::ULong generation = 0;
+  if (this->read_header (generation) != 0)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) Couldn't read the header of %s\n"),
+                      this->filename_.c_str ()));
+      this->release ();
+      return -1;
+    }
+
+  // the log was compacted or erased by a peer
+  if (generation != this->generation_)
+    {
+      full = true;
+    }
+
+  std::set<ACE_CString> servers;
+  std::set<ACE_CString> activators;
+  if (full)
+    {
+      this->generation_ = generation;
+      this->offset_ = HEADER_SIZE;
+      this->records_ = 0;
+
+      Locator_Repository::SIMap::ENTRY* sientry = 0;
+      Locator_Repository::SIMap::ITERATOR siit (repo.servers ());
+      for (; siit.next (sientry); siit.advance ())
+        {
+          servers.insert (sientry->ext_id_);
+        }
+      Locator_Repository::AIMap::ENTRY* aientry = 0;
+      Locator_Repository::AIMap::ITERATOR aiit (repo.activators ());
+      for (; aiit.next (aientry); aiit.advance ())
+        {
+          activators.insert (aientry->ext_id_);
+        }
+    }
+
+  ACE_HANDLE const handle = this->lock_->get_handle ();
+  ACE_OFF_T const size = ACE_OS::filesize (handle);
+  ACE_OFF_T end = this->offset_;
+  size_t count = 0;
+  int result = 0;
+  if (size > this->offset_)
+    {
+      // only map the part that was not loaded yet
+      ACE_OFF_T const granularity =
+        static_cast<ACE_OFF_T> (ACE_OS::allocation_granularity ());
+      ACE_OFF_T const map_offset = this->offset_ - this->offset_ % granularity;
+      ACE_Mem_Map map (handle,
+                       static_cast<size_t> (size - map_offset),
+                       PROT_READ,
+                       ACE_MAP_PRIVATE,
+                       0,
+                       map_offset);
+      if (map.addr () == MAP_FAILED || map.addr () == 0)
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Couldn't map %s\n"),
+                          this->filename_.c_str ()));
+          result = -1;
+        }
+      else
+        {
+          const char *const base =
+            static_cast<const char*> (map.addr ()) - map_offset;
+          while (end + static_cast<ACE_OFF_T> (RECORD_HEADER_SIZE) <= size)
+            {
+              ACE_InputCDR header (base + end, RECORD_HEADER_SIZE,
+                                   this->byte_order_);
+              ACE_CDR::ULong kind = 0;
+              ACE_CDR::ULong len = 0;
+              header.read_ulong (kind);
+              header.read_ulong (len);
+              if (len < RECORD_HEADER_SIZE || len % RECORD_ALIGN != 0 ||
+                  static_cast<ACE_OFF_T> (len) > size - end)
+                {
+                  break;
+                }
+
+              ACE_InputCDR in (base + end + RECORD_HEADER_SIZE,
+                               len - RECORD_HEADER_SIZE,
+                               this->byte_order_);
+              if (this->decode (repo, kind, in, servers, activators) != 0)
+                {
+                  break;
+                }
+              end += len;
+              ++count;
+            }
+        }
+    }
+
+  if (result == 0 && end < size)
+    {
+      // the writer of the last record died before it was done
+      ORBSVCS_ERROR ((LM_WARNING,
+                      ACE_TEXT ("(%P|%t) Dropping %d bytes at the end of %s\n"),
+                      static_cast<int> (size - end),
+                      this->filename_.c_str ()));
+      ACE_OS::ftruncate (handle, end);
+    }
+
+  this->offset_ = end;
+  this->records_ += count;
+  this->release ();
+
+  if (this->debug_ > 9)
+    {
+      ORBSVCS_DEBUG ((LM_INFO,
+                      ACE_TEXT ("(%P|%t) Loaded %d records from %s%s\n"),
+                      static_cast<int> (count),
+                      this->filename_.c_str (),
+                      full ? ACE_TEXT ("") : ACE_TEXT (" (changes only)")));
+    }
+
+  if (full && result == 0)
+    {
+      std::set<ACE_CString>::const_iterator name;
+      for (name = servers.begin (); name != servers.end (); ++name)
+        {
+          repo.unload (*name, false);
+        }
+      for (name = activators.begin (); name != activators.end (); ++name)
+        {
+          repo.unload (*name, true);
+        }
+    }
+
+  return result;
+}
+
+int
+Binary_Repository_File::decode (XML_Backing_Store& repo,
+                                ACE_CDR::ULong kind,
+                                ACE_InputCDR& in,
+                                std::set<ACE_CString>& servers,
+                                std::set<ACE_CString>& activators)
+{
+  switch (kind)
+    {
+    case SERVER_RECORD:
+      {
+        Server_Info *si = 0;
+        ACE_NEW_RETURN (si, Server_Info, -1);
+        std::unique_ptr<Server_Info> owner (si);
+
+        ACE_CString altkey;
+        ACE_CDR::ULong mode = 0;
+        ACE_CDR::Long limit = 0;
+        ACE_CDR::Long pid = 0;
+        ACE_CDR::Boolean started = false;
+        ACE_CDR::Boolean jacorb = false;
+        ACE_CDR::ULong len = 0;
+        if (!(in.read_string (si->server_id) &&
+              in.read_string (si->poa_name) &&
+              in.read_string (si->key_name_) &&
+              in.read_string (si->activator) &&
+              in.read_string (si->cmdline) &&
+              in.read_string (si->dir) &&
+              in.read_string (si->partial_ior) &&
+              in.read_string (si->ior) &&
+              in.read_string (altkey) &&
+              in.read_ulong (mode) &&
+              in.read_long (limit) &&
+              in.read_boolean (started) &&
+              in.read_boolean (jacorb) &&
+              in.read_long (pid) &&
+              read_length (in, len)))
+          {
+            return -1;
+          }
+        si->activation_mode_ =
+          static_cast<ImplementationRepository::ActivationMode> (mode);
+        si->start_limit_ = limit;
+        si->is_jacorb = jacorb;
+        si->pid = pid;
+
+        si->env_vars.length (len);
+        for (ACE_CDR::ULong i = 0; i < len; ++i)
+          {
+            ACE_CString name;
+            ACE_CString value;
+            if (!in.read_string (name) || !in.read_string (value))
+              {
+                return -1;
+              }
+            si->env_vars[i].name = name.c_str ();
+            si->env_vars[i].value = value.c_str ();
+          }
+
+        if (!read_length (in, len))
+          {
+            return -1;
+          }
+        si->peers.length (len);
+        for (ACE_CDR::ULong i = 0; i < len; ++i)
+          {
+            ACE_CString peer;
+            if (!in.read_string (peer))
+              {
+                return -1;
+              }
+            si->peers[i] = peer.c_str ();
+          }
+
+        NameValues extra;
+        if (!read_values (in, extra))
+          {
+            return -1;
+          }
+
+        if (altkey.length () > 0 &&
+            repo.servers ().find (altkey, si->alt_info_) != 0)
+          {
+            Server_Info *base_si = 0;
+            ACE_NEW_RETURN (base_si, Server_Info, -1);
+            base_si->key_name_ = altkey;
+            si->alt_info_.reset (base_si);
+            repo.servers ().bind (altkey, si->alt_info_);
+          }
+
+        servers.erase (si->key_name_);
+        repo.load_server (owner.release (), started, extra);
+        break;
+      }
+    case ACTIVATOR_RECORD:
+      {
+        ACE_CString name;
+        ACE_CString ior;
+        ACE_CDR::Long token = 0;
+        NameValues extra;
+        if (!(in.read_string (name) &&
+              in.read_long (token) &&
+              in.read_string (ior) &&
+              read_values (in, extra)))
+          {
+            return -1;
+          }
+        activators.erase (Locator_Repository::lcase (name));
+        repo.load_activator (name, token, ior, extra);
+        break;
+      }
+    case REMOVE_SERVER_RECORD:
+    case REMOVE_ACTIVATOR_RECORD:
+      {
+        ACE_CString name;
+        if (!in.read_string (name))
+          {
+            return -1;
+          }
+        repo.unload (name, kind == REMOVE_ACTIVATOR_RECORD);
+        break;
+      }
+    default:
+      // written by a newer version, skip it
+      break;
+    }
+  return 0;
+}
+
+int
+Binary_Repository_File::write (const Server_Info& info,
+                               const NameValues& extra)
+{
+  ACE_OutputCDR out (ACE_DEFAULT_CDR_BUFSIZE, this->byte_order_);
+  size_t start = 0;
+  char *const size_pos = begin_record (out, SERVER_RECORD, start);
+
+  ACE_CString altkey;
+  if (!info.alt_info_.null ())
+    {
+      altkey = info.alt_info_->key_name_;
+    }
+
+  out.write_string (info.server_id);
+  out.write_string (info.poa_name);
+  out.write_string (info.key_name_);
+  out.write_string (info.activator);
+  out.write_string (info.cmdline);
+  out.write_string (info.dir);
+  out.write_string (info.partial_ior);
+  out.write_string (info.ior);
+  out.write_string (altkey);
+  out.write_ulong (static_cast<ACE_CDR::ULong> (info.activation_mode_));
+  out.write_long (info.start_limit_);
+  out.write_boolean (!CORBA::is_nil (info.server.in ()));
+  out.write_boolean (info.is_jacorb);
+  out.write_long (info.pid);
+
+  CORBA::ULong const elen = info.env_vars.length ();
+  out.write_ulong (elen);
+  for (CORBA::ULong i = 0; i < elen; ++i)
+    {
+      out.write_string (info.env_vars[i].name.in ());
+      out.write_string (info.env_vars[i].value.in ());
+    }
+
+  CORBA::ULong const plen = info.peers.length ();
+  out.write_ulong (plen);
+  for (CORBA::ULong i = 0; i < plen; ++i)
+    {
+      out.write_string (info.peers[i].in ());
+    }
+
+  write_values (out, extra);
+  end_record (out, size_pos, start);
+
+  if (!out.good_bit ())
+    {
+      return -1;
+    }
+  return this->append (out);
+}
+
+int
+Binary_Repository_File::write (const Activator_Info& info,
+                               const NameValues& extra)
+{
+  ACE_OutputCDR out (ACE_DEFAULT_CDR_BUFSIZE, this->byte_order_);
+  size_t start = 0;
+  char *const size_pos = begin_record (out, ACTIVATOR_RECORD, start);
+  out.write_string (info.name);
+  out.write_long (info.token);
+  out.write_string (info.ior);
+  write_values (out, extra);
+  end_record (out, size_pos, start);
+
+  if (!out.good_bit ())
+    {
+      return -1;
+    }
+  return this->append (out);
+}
+
+int
+Binary_Repository_File::write_remove (const ACE_CString& name, bool activator)
+{
+  ACE_OutputCDR out (ACE_DEFAULT_CDR_BUFSIZE, this->byte_order_);
+  size_t start = 0;
+  char *const size_pos =
+    begin_record (out,
+                  activator ? REMOVE_ACTIVATOR_RECORD : REMOVE_SERVER_RECORD,
+                  start);
+  out.write_string (name);
+  end_record (out, size_pos, start);
+
+  if (!out.good_bit ())
+    {
+      return -1;
+    }
+  return this->append (out);
+}
+
+int
+Binary_Repository_File::append (const ACE_OutputCDR& out)
+{
+  if (this->rewrite_.get () != 0)
+    {
+      // both streams are aligned at the start of a record
+      for (const ACE_Message_Block *mb = out.begin (); mb != 0; mb = mb->cont ())
+        {
+          this->rewrite_->write_octet_array (
+            reinterpret_cast<const ACE_CDR::Octet*> (mb->rd_ptr ()),
+            mb->length ());
+        }
+      ++this->rewrite_records_;
+      return this->rewrite_->good_bit () ? 0 : -1;
+    }
+
+  if (this->acquire () != 0)
+    {
+      return -1;
+    }
+
+  ACE_OFF_T const end = ACE_OS::filesize (this->lock_->get_handle ());
+  int const result = this->write_at (this->lock_->get_handle (), out, end);
+  if (result == 0)
+    {
+      // no need to load our own record again unless a peer appended
+      // records that were not loaded yet
+      if (end == this->offset_)
+        {
+          this->offset_ = end + static_cast<ACE_OFF_T> (out.total_length ());
+        }
+      ++this->records_;
+    }
+  else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) Couldn't write to file %s\n"),
+                      this->filename_.c_str ()));
+    }
+
+  this->release ();
+  return result;
+}
+
+int
+Binary_Repository_File::write_at (ACE_HANDLE handle,
+                                  const ACE_OutputCDR& out,
+                                  ACE_OFF_T offset)
+{
+  for (const ACE_Message_Block *mb = out.begin (); mb != 0; mb = mb->cont ())
+    {
+      size_t const len = mb->length ();
+      if (len > 0 &&
+          ACE_OS::pwrite (handle, mb->rd_ptr (), len, offset)
+          != static_cast<ssize_t> (len))
+        {
+          return -1;
+        }
+      offset += static_cast<ACE_OFF_T> (len);
+    }
+  return 0;
+}
+
+bool
+Binary_Repository_File::needs_compaction (size_t live) const
+{
+  return this->records_ > 2 * live + COMPACT_SLACK;
+}
+
+int
+Binary_Repository_File::begin_rewrite (XML_Backing_Store& repo)
+{
+  if (this->acquire () != 0)
+    {
+      return -1;
+    }
+  this->rewriting_ = true;
+
+  bool full = false;
+  if (this->load (repo, full) != 0)
+    {
+      this->rewriting_ = false;
+      this->release ();
+      return -1;
+    }
+
+  // the header stays invalid until the records are written
+  ACE_OutputCDR *out = 0;
+  ACE_NEW_NORETURN (out, ACE_OutputCDR (ACE_DEFAULT_CDR_BUFSIZE * 16,
+                                         this->byte_order_));
+  if (out == 0)
+    {
+      this->rewriting_ = false;
+      this->release ();
+      return -1;
+    }
+  this->rewrite_.reset (out);
+  for (size_t i = 0; i < HEADER_SIZE / 4; ++i)
+    {
+      out->write_ulong (0);
+    }
+  this->rewrite_records_ = 0;
+  return 0;
+}
+
+int
+Binary_Repository_File::commit_rewrite (void)
+{
+  if (this->rewrite_.get () == 0)
+    {
+      return -1;
+    }
+
+  std::unique_ptr<ACE_OutputCDR> out (this->rewrite_.release ());
+  ACE_CDR::ULong const generation = this->generation_ + 1;
+  ACE_OutputCDR header (HEADER_SIZE + ACE_CDR::MAX_ALIGNMENT,
+                        this->byte_order_);
+  this->encode_header (header, generation);
+
+  // The new log goes to the backup first, open() restores it when the
+  // rewrite of the log itself does not complete.  The header of the log
+  // is cleared before and written after the records, so a log that was
+  // not completely rewritten is never mistaken for a valid one.  Once
+  // the new header is on disk the backup is not needed anymore.
+  const ACE_TString bfname = this->filename_ + ACE_TEXT (".bak");
+  ACE_HANDLE const bak = ACE_OS::open (bfname.c_str (),
+                                       O_WRONLY | O_CREAT | O_TRUNC,
+                                       ACE_DEFAULT_FILE_PERMS);
+  int result = -1;
+  if (bak != ACE_INVALID_HANDLE)
+    {
+      if (this->write_at (bak, *out, 0) == 0 &&
+          this->write_at (bak, header, 0) == 0 &&
+          ACE_OS::fsync (bak) == 0)
+        {
+          ACE_HANDLE const handle = this->lock_->get_handle ();
+          const char cleared[HEADER_SIZE] = { 0 };
+          if (ACE_OS::pwrite (handle, cleared, HEADER_SIZE, 0)
+              == static_cast<ssize_t> (HEADER_SIZE) &&
+              ACE_OS::fsync (handle) == 0 &&
+              ACE_OS::ftruncate (handle, HEADER_SIZE) == 0 &&
+              this->write_at (handle, *out, 0) == 0 &&
+              ACE_OS::fsync (handle) == 0 &&
+              this->write_at (handle, header, 0) == 0 &&
+              ACE_OS::fsync (handle) == 0)
+            {
+              result = 0;
+            }
+        }
+      ACE_OS::close (bak);
+    }
+
+  if (result == 0)
+    {
+      ACE_OS::unlink (bfname.c_str ());
+      if (this->debug_ > 9)
+        {
+          ORBSVCS_DEBUG ((LM_INFO,
+                          ACE_TEXT ("(%P|%t) Compacted %s from %d to %d records\n"),
+                          this->filename_.c_str (),
+                          static_cast<int> (this->records_),
+                          static_cast<int> (this->rewrite_records_)));
+        }
+      this->generation_ = generation;
+      this->offset_ = static_cast<ACE_OFF_T> (out->total_length ());
+      this->records_ = this->rewrite_records_;
+    }
+  else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) Couldn't rewrite %s\n"),
+                      this->filename_.c_str ()));
+    }
+
+  this->rewriting_ = false;
+  this->release ();
+  return result;
+}
+
+//---------------------------------------------------------------------------
+
+Binary_Backing_Store::Binary_Backing_Store (const Options& opts,
+                                            CORBA::ORB_ptr orb)
+: XML_Backing_Store (opts, orb, true),
+  file_ (opts.persist_file_name (), opts.debug ())
+{
+}
+
+Binary_Backing_Store::~Binary_Backing_Store (void)
+{
+}
+
+const ACE_TCHAR*
+Binary_Backing_Store::repo_mode () const
+{
+  return this->file_.filename ().c_str ();
+}
+
+int
+Binary_Backing_Store::init_repo (PortableServer::POA_ptr)
+{
+  if (this->file_.open () != 0)
+    {
+      return -1;
+    }
+
+  if (this->opts_.repository_erase ())
+    {
+      this->file_.erase ();
+    }
+
+  bool full = true;
+  if (this->file_.load (*this, full) != 0)
+    {
+      return -1;
+    }
+
+  const ACE_TString& import_file = this->opts_.import_file_name ();
+  if (import_file.length () > 0)
+    {
+      if (this->servers ().current_size () != 0 ||
+          this->activators ().current_size () != 0)
+        {
+          ORBSVCS_ERROR ((LM_WARNING,
+                          ACE_TEXT ("(%P|%t) %s is not empty, not importing %s\n"),
+                          this->file_.filename ().c_str (),
+                          import_file.c_str ()));
+        }
+      else if (this->load_file (import_file) != 0)
+        {
+          ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                 ACE_TEXT ("(%P|%t) Couldn't import %s\n"),
+                                 import_file.c_str ()),
+                                -1);
+        }
+      else if (this->compact () != 0)
+        {
+          return -1;
+        }
+    }
+  else if (this->file_.needs_compaction (this->servers ().current_size () +
+                                         this->activators ().current_size ()))
+    {
+      this->compact ();
+    }
+
+  const ACE_TString& export_file = this->opts_.export_file_name ();
+  if (export_file.length () > 0)
+    {
+      this->persist_xml (export_file);
+    }
+
+  if (this->opts_.debug () > 9)
+    {
+      ORBSVCS_DEBUG ((LM_INFO,
+                      ACE_TEXT ("(%P|%t) ImR Repository initialized\n")));
+    }
+  return 0;
+}
+
+int
+Binary_Backing_Store::persistent_update (const Server_Info_Ptr& info, bool)
+{
+  const int err = this->file_.write (*info, NameValues ());
+  if (err != 0)
+    {
+      return err;
+    }
+  if (this->file_.needs_compaction (this->servers ().current_size () +
+                                    this->activators ().current_size ()))
+    {
+      return this->compact ();
+    }
+  return 0;
+}
+
+int
+Binary_Backing_Store::persistent_update (const Activator_Info_Ptr& info, bool)
+{
+  const int err = this->file_.write (*info, NameValues ());
+  if (err != 0)
+    {
+      return err;
+    }
+  if (this->file_.needs_compaction (this->servers ().current_size () +
+                                    this->activators ().current_size ()))
+    {
+      return this->compact ();
+    }
+  return 0;
+}
+
+int
+Binary_Backing_Store::persistent_remove (const ACE_CString& name,
+                                         bool activator)
+{
+  return this->file_.write_remove (name, activator);
+}
+
+int
+Binary_Backing_Store::compact (void)
+{
+  if (this->file_.begin_rewrite (*this) != 0)
+    {
+      return -1;
+    }
+
+  const NameValues none;
+  Locator_Repository::SIMap::ENTRY* sientry = 0;
+  Locator_Repository::SIMap::ITERATOR siit (this->servers ());
+  for (; siit.next (sientry); siit.advance ())
+    {
+      this->file_.write (*sientry->int_id_, none);
+    }
+
+  Locator_Repository::AIMap::ENTRY* aientry = 0;
+  Locator_Repository::AIMap::ITERATOR aiit (this->activators ());
+  for (; aiit.next (aientry); aiit.advance ())
+    {
+      this->file_.write (*aientry->int_id_, none);
+    }
+
+  return this->file_.commit_rewrite ();
+}
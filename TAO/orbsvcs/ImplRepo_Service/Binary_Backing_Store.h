@@ -0,0 +1,187 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+*  @file Binary_Backing_Store.h
+*
+*  This class defines an implementation of the backing store as a single
+*  append-only file of CDR encoded records.
+*/
+//=============================================================================
+
+#ifndef BINARY_BACKING_STORE_H
+#define BINARY_BACKING_STORE_H
+
+#include "ace/config-lite.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "XML_Backing_Store.h"
+
+#include <memory>
+#include <set>
+
+class ACE_File_Lock;
+class ACE_InputCDR;
+class ACE_OutputCDR;
+
+/**
+* @class Binary_Repository_File
+*
+* @brief A log of server, activator and removal records
+*
+* Every change to the repository appends one record to the end of the
+* file, so an update costs a single write no matter how many servers
+* are registered, and a restart maps the file and decodes it in one
+* pass without an XML parser.  The file starts with a header holding
+* the byte order of the records and a generation that is bumped each
+* time the log is compacted.  A reader remembers how far it got, a
+* later load() only decodes the records appended since then unless
+* the generation changed.
+*
+* The whole file is guarded by an ACE_File_Lock, so two locators may
+* share it.  A record that was only partially written when its writer
+* died is dropped by the next load().
+*
+* There is no index of the records by name.  The locator keeps every
+* server and activator in memory, so a load has to decode each live
+* record anyway, and compaction keeps the log to at most twice as
+* many records as there are live ones, plus a fixed slack.  The
+* offset of the end of the loaded records is what lets a peer skip
+* the records it has.
+*/
+class Binary_Repository_File
+{
+public:
+  typedef XML_Backing_Store::NameValues NameValues;
+
+  Binary_Repository_File (const ACE_TString& filename, unsigned int debug);
+  ~Binary_Repository_File (void);
+
+  /// open the file, writing an empty log when it does not exist yet
+  int open (void);
+
+  /// drop all records
+  int erase (void);
+
+  /// decode the records into the repo
+  /// @param repo the repository to load
+  /// @param full on input, set to reload the whole log instead of only
+  ///        the records added since the last load.  Set on return when
+  ///        the whole log had to be reloaded.  Servers and activators
+  ///        that are not in the log anymore are unloaded from the repo
+  ///        after a full reload.
+  int load (XML_Backing_Store& repo, bool& full);
+
+  /// append a server record
+  int write (const Server_Info& info, const NameValues& extra);
+
+  /// append an activator record
+  int write (const Activator_Info& info, const NameValues& extra);
+
+  /// append a record that removes a server or activator
+  int write_remove (const ACE_CString& name, bool activator);
+
+  /// true once the log holds many more records than the repo has
+  /// entries
+  bool needs_compaction (size_t live) const;
+
+  /// start replacing the log, the records written up to the
+  /// commit_rewrite() make up the new log.  The file stays locked
+  /// until then and records appended by a peer are loaded into the
+  /// repo first.
+  int begin_rewrite (XML_Backing_Store& repo);
+
+  /// write the new log
+  int commit_rewrite (void);
+
+  const ACE_TString& filename (void) const;
+
+private:
+  /// write the header into the stream
+  void encode_header (ACE_OutputCDR& out, ACE_CDR::ULong generation) const;
+
+  /// read the header at the start of the file
+  int read_header (ACE_CDR::ULong& generation);
+
+  /// decode one record into the repo
+  int decode (XML_Backing_Store& repo,
+              ACE_CDR::ULong kind,
+              ACE_InputCDR& in,
+              std::set<ACE_CString>& servers,
+              std::set<ACE_CString>& activators);
+
+  /// append the stream at the end of the file, or to the log being
+  /// rewritten
+  int append (const ACE_OutputCDR& out);
+
+  /// write the stream to the file at the given offset
+  int write_at (ACE_HANDLE handle,
+                const ACE_OutputCDR& out,
+                ACE_OFF_T offset);
+
+  /// copy the contents of the backup over a damaged file
+  int restore_backup (void);
+
+  int acquire (void);
+  void release (void);
+
+  const ACE_TString filename_;
+  const unsigned int debug_;
+  std::unique_ptr<ACE_File_Lock> lock_;
+  /// the lock is held by a rewrite
+  bool rewriting_;
+  int byte_order_;
+  /// generation of the log that was loaded
+  ACE_CDR::ULong generation_;
+  /// end of the records that were loaded
+  ACE_OFF_T offset_;
+  /// number of records in the log
+  size_t records_;
+  /// the new log while it is rewritten
+  std::unique_ptr<ACE_OutputCDR> rewrite_;
+  size_t rewrite_records_;
+};
+
+/**
+* @class Binary_Backing_Store
+*
+* @brief Backing store keeping all ImR persistent information in a
+* Binary_Repository_File
+*
+*/
+class Binary_Backing_Store : public XML_Backing_Store
+{
+public:
+  Binary_Backing_Store (const Options& opts,
+                        CORBA::ORB_ptr orb);
+
+  virtual ~Binary_Backing_Store (void);
+
+  /// indicate the binary filename as the persistence mode for the repository
+  virtual const ACE_TCHAR* repo_mode () const;
+
+protected:
+  /// load the binary file, importing the XML file named in the options
+  /// when it is empty
+  virtual int init_repo (PortableServer::POA_ptr imr_poa);
+
+  /// perform server persistent update
+  virtual int persistent_update (const Server_Info_Ptr& info, bool add);
+
+  /// perform activator persistent update
+  virtual int persistent_update (const Activator_Info_Ptr& info, bool add);
+
+  /// perform persistent remove
+  virtual int persistent_remove (const ACE_CString& name, bool activator);
+
+private:
+  /// rewrite the log with one record per server and activator
+  int compact (void);
+
+  Binary_Repository_File file_;
+};
+
+#endif /* BINARY_BACKING_STORE_H */
@@ -6,6 +6,7 @@
 #include "UpdateableServerInfo.h"
 
 #include "Locator_Repository.h"
+#include "Binary_Backing_Store.h"
 #include "Config_Backing_Store.h"
 #include "Shared_Backing_Store.h"
 #include "XML_Backing_Store.h"
@@ -86,7 +87,9 @@ ImR_Locator_i::init_with_orb (CORBA::ORB_ptr orb)
 
   this->dsi_forwarder_.init (orb);
   this->adapter_.init (& this->dsi_forwarder_);
-  this->pinger_.init (orb, this->opts_->ping_interval ());
+  this->pinger_.init (orb,
+                      this->opts_->ping_interval (),
+                      this->opts_->ping_window ());
 
   this->opts_->pinger (&this->pinger_);
 
@@ -127,6 +130,11 @@ ImR_Locator_i::init_with_orb (CORBA::ORB_ptr orb)
         repository_.reset(new XML_Backing_Store(*this->opts_, orb));
         break;
       }
+    case Options::REPO_BINARY_FILE:
+      {
+        repository_.reset(new Binary_Backing_Store(*this->opts_, orb));
+        break;
+      }
     case Options::REPO_SHARED_FILES:
       {
         repository_.reset(new Shared_Backing_Store(*this->opts_, orb, this));
@@ -163,13 +171,17 @@ ImR_Locator_i::init_with_orb (CORBA::ORB_ptr orb)
       return result;
     }
 
-  Locator_Repository::SIMap::ENTRY* entry = 0;
-  Locator_Repository::SIMap::ITERATOR it (this->repository_->servers ());
+  // Ping all the known servers at once instead of one after the other,
+  // the pinger spreads the pings over its ping window.
+  Server_Info_Vector servers;
+  SyncListener_Vector listeners;
+  this->start_alive_checks (servers, listeners);
+  this->wait_alive_checks (listeners);
 
-  for (;it.next (entry) != 0; it.advance ())
+  for (size_t i = 0; i < servers.size (); ++i)
     {
-      UpdateableServerInfo info (this->repository_, entry->int_id_);
-      bool const is_alive = this->server_is_alive (info);
+      UpdateableServerInfo info (this->repository_, servers[i]);
+      bool const is_alive = listeners[i]->alive ();
       Server_Info *active = info.edit()->active_info ();
       if (this->debug_ > 0)
         {
@@ -1639,18 +1651,43 @@ ImR_Locator_i::connect_server (UpdateableServerInfo& info)
     }
 }
 
-bool
-ImR_Locator_i::server_is_alive (UpdateableServerInfo& info)
+void
+ImR_Locator_i::start_alive_checks (Server_Info_Vector &servers,
+                                   SyncListener_Vector &listeners)
 {
-  this->connect_server (info);
-  SyncListener *listener = 0;
-  ACE_NEW_RETURN (listener,
-                  SyncListener (info->ping_id(),
-                                this->orb_.in(),
-                                this->pinger_),
-                  false);
-  LiveListener_ptr llp(listener);
-  return listener->is_alive();
+  Locator_Repository::SIMap::ENTRY* entry = 0;
+  Locator_Repository::SIMap::ITERATOR it (this->repository_->servers ());
+
+  for (;it.next (entry) != 0; it.advance ())
+    {
+      UpdateableServerInfo info (this->repository_, entry->int_id_);
+      this->connect_server (info);
+      SyncListener *listener = 0;
+      ACE_NEW (listener,
+               SyncListener (info->ping_id(),
+                             this->orb_.in(),
+                             this->pinger_));
+      SyncListener_ptr slp (listener);
+      listener->start ();
+      servers.push_back (entry->int_id_);
+      listeners.push_back (slp);
+    }
+}
+
+void
+ImR_Locator_i::wait_alive_checks (SyncListener_Vector &listeners)
+{
+  // As when the servers were checked one by one there is no overall
+  // limit, a server that is slow to answer or still waits for a slot
+  // in the ping window must not be mistaken for a dead one.
+  for (size_t i = 0; i < listeners.size (); ++i)
+    {
+      while (!listeners[i]->poll ())
+        {
+          ACE_Time_Value delay (10,0);
+          this->orb_->perform_work (delay);
+        }
+    }
 }
 
 int
@@ -1763,7 +1800,8 @@ SyncListener::SyncListener (const char *server,
    pinger_ (pinger),
    status_ (LS_UNKNOWN),
    got_it_ (false),
-   callback_ (false)
+   callback_ (false),
+   batch_ (false)
 {
 }
 
@@ -1792,12 +1830,53 @@ SyncListener::is_alive (void)
   return this->status_ != LS_DEAD;
 }
 
+void
+SyncListener::start (void)
+{
+  this->batch_ = true;
+  this->callback_ = true;
+  this->poll ();
+}
+
+bool
+SyncListener::poll (void)
+{
+  if (!this->got_it_ && this->callback_)
+    {
+      this->callback_ = false;
+      if (!this->pinger_.add_poll_listener (this))
+        {
+          this->status_ = LS_DEAD;
+          this->got_it_ = true;
+        }
+    }
+  return this->got_it_;
+}
+
+bool
+SyncListener::alive (void) const
+{
+  return this->status_ != LS_DEAD;
+}
+
 bool
 SyncListener::status_changed (LiveStatus status)
 {
   this->callback_ = true;
   this->status_ = status;
-  this->got_it_ = (status != LS_TRANSIENT);
+  if (this->batch_)
+    {
+      // Only the outcome of a ping counts, not the state reported when
+      // the listener is added.
+      this->got_it_ = (status != LS_TRANSIENT &&
+                       status != LS_UNKNOWN &&
+                       status != LS_INIT &&
+                       status != LS_PING_AWAY);
+    }
+  else
+    {
+      this->got_it_ = (status != LS_TRANSIENT);
+    }
   return true;
 }
 
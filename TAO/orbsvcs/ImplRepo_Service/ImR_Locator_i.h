@@ -13,6 +13,7 @@
 #include "Locator_Options.h"
 #include "UpdateableServerInfo.h"
 #include "ace/Auto_Ptr.h"
+#include "ace/Vector_T.h"
 #include "AsyncAccessManager.h"
 #include "tao/IORTable/IORTable.h"
 
@@ -27,6 +28,8 @@ class ACE_Reactor;
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 class INS_Locator;
+class SyncListener;
+typedef TAO_Intrusive_Ref_Count_Handle<SyncListener> SyncListener_ptr;
 
 /// Gets a request from a client and depending on the POA name,
 /// requests an activator to take care of activating the
@@ -186,7 +189,17 @@ private:
                            bool manual_start,
                            ImR_ResponseHandler *rh);
 
-  bool server_is_alive (UpdateableServerInfo& info);
+  typedef ACE_Vector<Server_Info_Ptr> Server_Info_Vector;
+  typedef ACE_Vector<SyncListener_ptr> SyncListener_Vector;
+
+  /// Connect to every server in the repository and start a liveness
+  /// check for it, without waiting for the outcome.
+  void start_alive_checks (Server_Info_Vector &servers,
+                           SyncListener_Vector &listeners);
+
+  /// Run the ORB until all the checks started by start_alive_checks
+  /// have an outcome.
+  void wait_alive_checks (SyncListener_Vector &listeners);
 
   void unregister_activator_i (const char* activator);
 
@@ -260,6 +273,17 @@ class SyncListener : public LiveListener
 
   bool is_alive (void);
 
+  /// Start a check without waiting for its outcome, the ORB has to
+  /// be run until poll returns true.
+  void start (void);
+
+  /// Returns true once the outcome of the check started by start
+  /// is known.
+  bool poll (void);
+
+  /// False only if the check found the server dead.
+  bool alive (void) const;
+
   bool status_changed (LiveStatus status);
 
  private:
@@ -268,6 +292,7 @@ class SyncListener : public LiveListener
   LiveStatus status_;
   bool got_it_;
   bool callback_;
+  bool batch_;
 };
 
 //----------------------------------------------------------------------------
@@ -7,8 +7,6 @@
 #include "tao/ORB_Core.h"
 #include "ace/Reactor.h"
 #include "ace/OS_NS_sys_time.h"
-#include "ace/Timer_Queue.h"
-#include "ace/Timer_Queue_Iterator.h"
 
 LiveListener::LiveListener (const char *server)
   : server_ (server),
@@ -136,7 +134,9 @@ LiveEntry::LiveEntry (LiveCheck *owner,
     listeners_ (),
     lock_ (),
     callback_ (0),
-    pid_ (pid)
+    pid_ (pid),
+    queue_ (0),
+    due_tick_ (0)
 {
   if (ImR_Locator_i::debug () > 4)
     {
@@ -148,6 +148,7 @@ LiveEntry::LiveEntry (LiveCheck *owner,
 
 LiveEntry::~LiveEntry (void)
 {
+  this->owner_->dequeue (this);
   if (this->callback_.in () != 0)
     {
       PingReceiver *rec = dynamic_cast<PingReceiver *>(this->callback_.in());
@@ -155,13 +156,18 @@ LiveEntry::~LiveEntry (void)
         {
           rec->cancel ();
         }
+      this->owner_->ping_done ();
     }
 }
 
 void
 LiveEntry::release_callback (void)
 {
-  this->callback_ = 0;
+  if (this->callback_.in () != 0)
+    {
+      this->callback_ = 0;
+      this->owner_->ping_done ();
+    }
 }
 
 void
@@ -448,6 +454,7 @@ void
 LiveEntry::do_ping (PortableServer::POA_ptr poa)
 {
   this->callback_ = new PingReceiver (this, poa);
+  this->owner_->ping_started ();
   PortableServer::ObjectId_var oid = poa->activate_object (this->callback_.in());
   CORBA::Object_var obj = poa->id_to_reference (oid.in());
   ImplementationRepository::AMI_ServerObjectHandler_var cb =
@@ -653,25 +660,16 @@ LC_TimeoutGuard::~LC_TimeoutGuard (void)
 
   if (owner_->want_timeout_)
     {
-      ACE_Time_Value delay = ACE_Time_Value::zero;
-      if (owner_->deferred_timeout_ != ACE_Time_Value::zero)
-        {
-          ACE_Time_Value const now (ACE_OS::gettimeofday());
-          if (owner_->deferred_timeout_ > now)
-            delay = owner_->deferred_timeout_ - now;
-        }
-      ++owner_->token_;
       if (ImR_Locator_i::debug () > 2)
         {
           ORBSVCS_DEBUG ((LM_DEBUG,
                           ACE_TEXT ("(%P|%t) LC_TimeoutGuard(%d)::dtor, ")
-                          ACE_TEXT ("scheduling new timeout(%d), delay = %d,%d\n"),
-                          this->token_, owner_->token_, delay.sec(), delay.usec()));
+                          ACE_TEXT ("scheduling new timeout, due = %d,%d\n"),
+                          this->token_, owner_->deferred_timeout_.sec(),
+                          owner_->deferred_timeout_.usec()));
         }
-      owner_->reactor()->schedule_timer (owner_,
-                                         reinterpret_cast<void *>(owner_->token_),
-                                         delay);
       owner_->want_timeout_ = false;
+      owner_->arm_timer (owner_->deferred_timeout_);
     }
   else
     {
@@ -699,12 +697,19 @@ LiveCheck::LiveCheck ()
    token_ (100),
    handle_timeout_busy_ (0),
    want_timeout_ (false),
-   deferred_timeout_ (ACE_Time_Value::zero)
+   deferred_timeout_ (ACE_Time_Value::zero),
+   current_tick_ (0),
+   ping_window_ (0),
+   in_flight_ (0),
+   timer_id_ (-1),
+   timer_due_ ()
 {
 }
 
 LiveCheck::~LiveCheck (void)
 {
+  // Deleting the entries below must not arm any timer.
+  this->running_ = false;
   for (LiveEntryMap::iterator em (this->entry_map_); !em.done(); em++)
     {
       delete em->int_id_;
@@ -739,9 +744,12 @@ LiveCheck::in_handle_timeout (void)
 
 void
 LiveCheck::init (CORBA::ORB_ptr orb,
-                 const ACE_Time_Value &pi)
+                 const ACE_Time_Value &pi,
+                 int ping_window)
 {
   this->ping_interval_ = pi;
+  this->ping_window_ = ping_window;
+  this->current_tick_ = this->tick_of (ACE_OS::gettimeofday ());
   ACE_Reactor *r = orb->orb_core()->reactor();
   this->reactor (r);
   CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
@@ -754,6 +762,7 @@ LiveCheck::shutdown (void)
 {
   this->running_ = false;
   this->reactor()->cancel_timer (this);
+  this->timer_id_ = -1;
 }
 
 const ACE_Time_Value &
@@ -777,61 +786,278 @@ LiveCheck::handle_timeout (const ACE_Time_Value &,
   if (!this->running_)
     return -1;
 
+  if (token == this->token_)
+    {
+      // This is the armed timer, whatever is left queued needs a new one.
+      this->timer_id_ = -1;
+    }
+
   LC_TimeoutGuard tg (this, token);
   if (tg.blocked ())
-    return 0;
+    {
+      // Let the outer handle_timeout rearm us once it is done.
+      this->defer_timeout (ACE_Time_Value::zero);
+      return 0;
+    }
 
-  LiveEntryMap::iterator le_end = this->entry_map_.end();
-  for (LiveEntryMap::iterator le = this->entry_map_.begin();
-       le != le_end;
-       ++le)
+  this->expire (ACE_OS::gettimeofday ());
+
+  ACE_Time_Value due;
+  if (this->next_due (due))
+    {
+      this->defer_timeout (due);
+    }
+
+  return 0;
+}
+
+void
+LiveCheck::expire (const ACE_Time_Value &now)
+{
+  // Entries parked because of a full ping window go first.
+  while (!this->waiting_.is_empty () && !this->window_full ())
     {
-      LiveEntry *entry = le->item ();
-      if (entry->validate_ping (this->want_timeout_, this->deferred_timeout_))
+      LiveEntry *entry = this->waiting_.pop_front ();
+      entry->queue_ = 0;
+      this->dispatch (entry);
+    }
+
+  ACE_UINT64 const now_tick = this->tick_of (now);
+  if (now_tick <= this->current_tick_)
+    {
+      // Nothing new is due, or the clock was set back.
+      this->current_tick_ = now_tick;
+      return;
+    }
+
+  // Collect the due entries first, dispatching them may queue entries
+  // again. After a long pause each slot is visited only once.
+  ACE_UINT64 const last = now_tick - this->current_tick_ < wheel_size_ ?
+    now_tick : this->current_tick_ + wheel_size_;
+  PingQueue due;
+  for (ACE_UINT64 t = this->current_tick_ + 1; t <= last; ++t)
+    {
+      PingQueue &slot = this->wheel_[t % wheel_size_];
+      LiveEntry *next = 0;
+      for (LiveEntry *entry = slot.head (); entry != 0; entry = next)
         {
-          entry->do_ping (poa_.in ());
-          if (ImR_Locator_i::debug () > 2)
+          next = entry->next ();
+          // Entries for a later turn of the wheel stay where they are.
+          if (entry->due_tick_ <= now_tick)
             {
-              ORBSVCS_DEBUG ((LM_DEBUG,
-                              ACE_TEXT ("(%P|%t) LiveCheck::handle_timeout(%d)")
-                              ACE_TEXT (", ping sent to server <%C>\n"),
-                              token, entry->server_name ()));
+              slot.unsafe_remove (entry);
+              due.push_back (entry);
+              entry->queue_ = &due;
             }
         }
-      else
+    }
+  this->current_tick_ = now_tick;
+
+  while (!due.is_empty ())
+    {
+      LiveEntry *entry = due.pop_front ();
+      entry->queue_ = 0;
+      this->dispatch (entry);
+    }
+}
+
+void
+LiveCheck::dispatch (LiveEntry *entry)
+{
+  if (this->window_full ())
+    {
+      this->waiting_.push_back (entry);
+      entry->queue_ = &this->waiting_;
+      return;
+    }
+
+  bool want_reping = false;
+  ACE_Time_Value next;
+  if (entry->validate_ping (want_reping, next))
+    {
+      if (ImR_Locator_i::debug () > 2)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) LiveCheck::dispatch")
+                          ACE_TEXT (", sending ping to server <%C>\n"),
+                          entry->server_name ()));
+        }
+      // A per client entry may be deleted by do_ping, don't touch it after.
+      entry->do_ping (this->poa_.in ());
+    }
+  else if (want_reping)
+    {
+      this->enqueue (entry, next);
+    }
+  else
+    {
+      if (ImR_Locator_i::debug () > 4)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) LiveCheck::dispatch")
+                          ACE_TEXT (", ping skipped for server <%C> may_ping <%d>\n"),
+                          entry->server_name (), entry->may_ping ()));
+        }
+      LiveStatus const status = entry->status ();
+      if (status != LS_PING_AWAY && status != LS_TRANSIENT &&
+          this->remove_per_client_entry (entry))
+        {
+          delete entry;
+        }
+    }
+}
+
+void
+LiveCheck::enqueue (LiveEntry *entry, const ACE_Time_Value &due)
+{
+  ACE_UINT64 ms = 0;
+  due.msec (ms);
+  ACE_UINT64 tick = (ms + tick_msec_ - 1) / tick_msec_;
+  if (tick <= this->current_tick_)
+    {
+      tick = this->current_tick_ + 1;
+    }
+
+  if (entry->queue_ != 0)
+    {
+      if (entry->queue_ == &this->waiting_ || entry->due_tick_ <= tick)
+        {
+          // Already queued for an earlier ping, which all its listeners share.
+          return;
+        }
+      this->dequeue (entry);
+    }
+
+  PingQueue &slot = this->wheel_[tick % wheel_size_];
+  slot.push_back (entry);
+  entry->queue_ = &slot;
+  entry->due_tick_ = tick;
+}
+
+void
+LiveCheck::dequeue (LiveEntry *entry)
+{
+  if (entry->queue_ != 0)
+    {
+      entry->queue_->unsafe_remove (entry);
+      entry->queue_ = 0;
+    }
+}
+
+bool
+LiveCheck::next_due (ACE_Time_Value &due) const
+{
+  if (!this->waiting_.is_empty () && !this->window_full ())
+    {
+      due = ACE_Time_Value::zero;
+      return true;
+    }
+
+  for (ACE_UINT64 t = this->current_tick_ + 1;
+       t <= this->current_tick_ + wheel_size_;
+       ++t)
+    {
+      if (!this->wheel_[t % wheel_size_].is_empty ())
+        {
+          ACE_UINT64 const ms = t * tick_msec_;
+          due.set (static_cast<time_t> (ms / 1000),
+                   static_cast<suseconds_t> ((ms % 1000) * 1000));
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+LiveCheck::arm_timer (const ACE_Time_Value &due)
+{
+  if (!this->running_)
+    return;
+
+  ACE_Time_Value const now (ACE_OS::gettimeofday());
+  ACE_Time_Value const when = due > now ? due : now;
+  if (this->timer_id_ != -1)
+    {
+      if (this->timer_due_ <= when)
         {
           if (ImR_Locator_i::debug () > 4)
             {
               ORBSVCS_DEBUG ((LM_DEBUG,
-                              ACE_TEXT ("(%P|%t) LiveCheck::handle_timeout(%d)")
-                              ACE_TEXT (", ping skipped for server <%C> may_ping <%d>\n"),
-                              token, entry->server_name (), entry->may_ping ()));
+                              ACE_TEXT ("(%P|%t) LiveCheck::arm_timer ")
+                              ACE_TEXT ("already scheduled\n")));
             }
+          return;
         }
+      this->reactor ()->cancel_timer (this->timer_id_);
     }
 
-  PerClientStack::iterator pe_end = this->per_client_.end();
-  for (PerClientStack::iterator pe = this->per_client_.begin();
-       pe != pe_end;
-       ++pe)
+  ++this->token_;
+  if (ImR_Locator_i::debug () > 2)
     {
-      LiveEntry *entry = *pe;
-      if (entry != 0)
+      ACE_Time_Value const delay = when - now;
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) LiveCheck::arm_timer (%d),")
+                      ACE_TEXT (" delay <%d,%d>\n"),
+                      this->token_, delay.sec(), delay.usec()));
+    }
+  this->timer_id_ =
+    this->reactor()->schedule_timer (this,
+                                     reinterpret_cast<void *>(this->token_),
+                                     when - now);
+  this->timer_due_ = when;
+}
+
+void
+LiveCheck::defer_timeout (const ACE_Time_Value &due)
+{
+  if (!this->want_timeout_ || due < this->deferred_timeout_)
+    {
+      this->want_timeout_ = true;
+      this->deferred_timeout_ = due;
+    }
+}
+
+bool
+LiveCheck::window_full (void) const
+{
+  return this->ping_window_ > 0 && this->in_flight_ >= this->ping_window_;
+}
+
+ACE_UINT64
+LiveCheck::tick_of (const ACE_Time_Value &t) const
+{
+  ACE_UINT64 ms = 0;
+  t.msec (ms);
+  return ms / tick_msec_;
+}
+
+void
+LiveCheck::ping_started (void)
+{
+  ++this->in_flight_;
+}
+
+void
+LiveCheck::ping_done (void)
+{
+  --this->in_flight_;
+  if (this->running_ && !this->waiting_.is_empty () && !this->window_full ())
+    {
+      if (this->in_handle_timeout ())
         {
-          if (entry->validate_ping (this->want_timeout_, this->deferred_timeout_))
-            {
-              entry->do_ping (poa_.in ());
-            }
-          LiveStatus const status = entry->status ();
-          if (status != LS_PING_AWAY && status != LS_TRANSIENT)
-            {
-              this->per_client_.remove (entry);
-              delete entry;
-            }
+          this->defer_timeout (ACE_Time_Value::zero);
+        }
+      else
+        {
+          this->arm_timer (ACE_Time_Value::zero);
         }
     }
+}
 
-  return 0;
+int
+LiveCheck::pings_in_flight (void) const
+{
+  return this->in_flight_;
 }
 
 bool
@@ -1077,20 +1303,7 @@ LiveCheck::add_per_client_listener (LiveListener *l,
   if (this->per_client_.insert_tail(entry) == 0)
     {
       entry->add_listener (l);
-
-      if (!this->in_handle_timeout ())
-        {
-          ++this->token_;
-          this->reactor()->schedule_timer (this,
-                                           reinterpret_cast<void *>(this->token_),
-                                           ACE_Time_Value::zero);
-        }
-      else
-        {
-          this->want_timeout_ = true;
-          this->deferred_timeout_ = ACE_Time_Value::zero;
-        }
-      return true;
+      return this->schedule_ping (entry);
     }
   return false;
 }
@@ -1160,50 +1373,12 @@ LiveCheck::schedule_ping (LiveEntry *entry)
       return status != LS_DEAD;
     }
 
-  ACE_Time_Value const now (ACE_OS::gettimeofday());
   ACE_Time_Value const next = entry->next_check ();
+  this->enqueue (entry, next);
 
   if (!this->in_handle_timeout ())
     {
-      ACE_Time_Value delay = ACE_Time_Value::zero;
-      if (next > now)
-        {
-          delay = next - now;
-        }
-
-      ACE_Timer_Queue *tq = this->reactor ()->timer_queue ();
-      if (!tq->is_empty ())
-        {
-          for (ACE_Timer_Queue_Iterator_T<ACE_Event_Handler*> &i = tq->iter ();
-               !i.isdone (); i.next())
-            {
-              if (i.item ()->get_type () == this)
-                {
-                  if (next >= tq->earliest_time ())
-                    {
-                      if (ImR_Locator_i::debug () > 2)
-                        {
-                          ORBSVCS_DEBUG ((LM_DEBUG,
-                                          ACE_TEXT ("(%P|%t) LiveCheck::schedule_ping ")
-                                          ACE_TEXT ("already scheduled\n")));
-                        }
-                      return true;
-                    }
-                  break;
-                }
-            }
-        }
-      ++this->token_;
-      if (ImR_Locator_i::debug () > 2)
-        {
-          ORBSVCS_DEBUG ((LM_DEBUG,
-                          ACE_TEXT ("(%P|%t) LiveCheck::schedule_ping (%d),")
-                          ACE_TEXT (" delay <%d,%d>\n"),
-                          this->token_, delay.sec(), delay.usec()));
-        }
-      this->reactor()->schedule_timer (this,
-                                       reinterpret_cast<void *>(this->token_),
-                                       delay);
+      this->arm_timer (next);
     }
   else
     {
@@ -1212,11 +1387,7 @@ LiveCheck::schedule_ping (LiveEntry *entry)
           ORBSVCS_DEBUG ((LM_DEBUG,
                           ACE_TEXT ("(%P|%t) LiveCheck::schedule_ping deferred because we are in handle timeout\n")));
         }
-      if (!this->want_timeout_ || next < this->deferred_timeout_)
-        {
-          this->want_timeout_ = true;
-          this->deferred_timeout_ = next;
-        }
+      this->defer_timeout (next);
     }
   return true;
 }
@@ -16,6 +16,8 @@
 #include "ace/Hash_Map_Manager.h"
 #include "ace/SString.h"
 #include "ace/Event_Handler.h"
+#include "ace/Intrusive_List.h"
+#include "ace/Intrusive_List_Node.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -107,10 +109,15 @@ typedef TAO_Intrusive_Ref_Count_Handle<LiveListener> LiveListener_ptr;
  * This holds the liveliness status and determines the next allowed time
  * for a ping. Instances of the LiveEntry class are retained until the
  * locator is no longer interested in the target server.
+ *
+ * While a ping is wanted the entry is linked into one of the queues of its
+ * owner, see LiveCheck.
  */
-class Locator_Export LiveEntry
+class Locator_Export LiveEntry : public ACE_Intrusive_List_Node<LiveEntry>
 {
  public:
+  friend class LiveCheck;
+
   LiveEntry (LiveCheck *owner,
              const char *server,
              bool may_ping,
@@ -160,6 +167,12 @@ class Locator_Export LiveEntry
 
   static const int reping_msec_ [];
   static int reping_limit_;
+
+  /// The owner queue this entry is linked in, 0 when not queued.
+  ACE_Intrusive_List<LiveEntry> *queue_;
+
+  /// The timer wheel tick at which the entry is due.
+  ACE_UINT64 due_tick_;
 };
 
 //---------------------------------------------------------------------------
@@ -243,17 +256,25 @@ class Locator_Export LC_TimeoutGuard
  * needs to determine the liveliness of a server, registers a LiveListener
  * for the desired server. A ping to the server is then scheduled, based on the
  * limits determined by the entry's state.
+ *
+ * Entries waiting for a ping are kept in a hashed timer wheel, so a timeout
+ * only visits the entries that are due instead of every known server, and a
+ * single reactor timer is armed for the earliest non empty slot. An entry is
+ * queued at most once, all the listeners of a server share its ping. When a
+ * ping window is set, due entries wait in a FIFO until a reply frees a slot.
  */
 class Locator_Export LiveCheck : public ACE_Event_Handler
 {
  public:
   friend class LC_TimeoutGuard;
+  friend class LiveEntry;
 
   LiveCheck ();
   ~LiveCheck (void);
 
   void init (CORBA::ORB_ptr orb,
-             const ACE_Time_Value &interval);
+             const ACE_Time_Value &interval,
+             int ping_window = 0);
   void shutdown (void);
   int handle_timeout (const ACE_Time_Value &current_time,
                       const void *act = 0);
@@ -274,12 +295,46 @@ class Locator_Export LiveCheck : public ACE_Event_Handler
   LiveStatus is_alive (const char *server);
   const ACE_Time_Value &ping_interval () const;
 
+  /// Account for a ping sent or answered, used for the ping window.
+  void ping_started (void);
+  void ping_done (void);
+
+  /// Number of pings awaiting a reply.
+  int pings_in_flight (void) const;
+
  private:
   void enter_handle_timeout (void);
   void exit_handle_timeout (void);
   bool in_handle_timeout (void);
   void remove_deferred_servers (void);
 
+  typedef ACE_Intrusive_List<LiveEntry> PingQueue;
+
+  /// Link the entry in the wheel slot for the given time, unless it is
+  /// already queued for an earlier time.
+  void enqueue (LiveEntry *entry, const ACE_Time_Value &due);
+
+  /// Unlink the entry from whatever queue holds it.
+  void dequeue (LiveEntry *entry);
+
+  /// Ping the entries that are due at the given time.
+  void expire (const ACE_Time_Value &now);
+
+  /// Ping a due entry, or park it until the ping window has room.
+  void dispatch (LiveEntry *entry);
+
+  /// Find the time of the next non empty wheel slot.
+  bool next_due (ACE_Time_Value &due) const;
+
+  /// Make sure the reactor calls handle_timeout no later than due.
+  void arm_timer (const ACE_Time_Value &due);
+
+  /// Ask for a timeout once the current handle_timeout is done.
+  void defer_timeout (const ACE_Time_Value &due);
+
+  bool window_full (void) const;
+  ACE_UINT64 tick_of (const ACE_Time_Value &t) const;
+
   typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
                                   LiveEntry *,
                                   ACE_Hash<ACE_CString>,
@@ -303,6 +358,25 @@ class Locator_Export LiveCheck : public ACE_Event_Handler
   /// Contains a list of servers which got removed during the handle_timeout,
   /// these will be removed at the end of the handle_timeout.
   NamePidStack removed_entries_;
+
+  /// Slots of the timer wheel, one per tick_msec_ milliseconds.
+  static const size_t wheel_size_ = 1024;
+  static const ACE_UINT64 tick_msec_ = 10;
+  PingQueue wheel_[wheel_size_];
+
+  /// The last tick for which the wheel was expired.
+  ACE_UINT64 current_tick_;
+
+  /// Due entries waiting for room in the ping window.
+  PingQueue waiting_;
+
+  /// Maximum number of pings in flight, zero for no limit.
+  int ping_window_;
+  int in_flight_;
+
+  /// The reactor timer currently armed and when it fires.
+  long timer_id_;
+  ACE_Time_Value timer_due_;
 };
 
 #endif /* IMR_LIVECHECK_H_  */
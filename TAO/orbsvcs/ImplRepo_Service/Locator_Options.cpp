@@ -32,9 +32,13 @@ Options::Options ()
 , ping_external_ (false)
 , ping_interval_ (DEFAULT_PING_INTERVAL)
 , ping_timeout_ (DEFAULT_PING_TIMEOUT)
+, ping_window_ (0)
 , startup_timeout_ (DEFAULT_START_TIMEOUT)
 , readonly_ (false)
 , service_command_ (SC_NONE)
+, binary_repo_ (false)
+, import_file_name_ ()
+, export_file_name_ ()
 , unregister_if_address_reused_ (false)
 , lockout_ (false)
 , imr_type_ (STANDALONE_IMR)
@@ -191,6 +195,57 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
           this->repo_mode_ = REPO_XML_FILE;
           xml_persistence_used = true;
         }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("-b")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR, "Error: -b option needs a filename\n"));
+              this->print_usage ();
+              return -1;
+            }
+
+          this->persist_file_name_ = shifter.get_current ();
+          this->repo_mode_ = REPO_BINARY_FILE;
+          binary_persistence_used = true;
+        }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--binary")) == 0)
+        {
+          this->binary_repo_ = true;
+        }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--import")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                ACE_TEXT ("Error: --import option needs a filename\n")));
+              this->print_usage ();
+              return -1;
+            }
+
+          this->import_file_name_ = shifter.get_current ();
+        }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--export")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                ACE_TEXT ("Error: --export option needs a filename\n")));
+              this->print_usage ();
+              return -1;
+            }
+
+          this->export_file_name_ = shifter.get_current ();
+        }
       else if (ACE_OS::strcasecmp (shifter.get_current (),
                                    ACE_TEXT ("--primary")) == 0)
         {
@@ -279,6 +334,20 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
           this->ping_timeout_ =
             ACE_Time_Value (0, 1000 * ACE_OS::atoi (shifter.get_current ()));
         }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--pingwindow")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Error: --pingwindow option needs a value\n")));
+              this->print_usage ();
+              return -1;
+            }
+          this->ping_window_ = ACE_OS::atoi (shifter.get_current ());
+        }
       else if (ACE_OS::strcasecmp (shifter.get_current (),
                                    ACE_TEXT ("--ftendpoint")) == 0)
         {
@@ -327,6 +396,26 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
       return -1;
     }
 
+  if (this->binary_repo_ && !directory_persistence_used)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                  "Error: --binary is used but the "
+                  "--directory option is not passed\n"));
+      this->print_usage ();
+      return -1;
+    }
+
+  if ((this->import_file_name_.length () > 0 ||
+       this->export_file_name_.length () > 0) &&
+      this->repo_mode_ != REPO_BINARY_FILE && !this->binary_repo_)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                  "Error: --import and --export need a binary "
+                  "repository (-b or --directory with --binary)\n"));
+      this->print_usage ();
+      return -1;
+    }
+
   if ((binary_persistence_used + directory_persistence_used +
        xml_persistence_used)
       > 1)
@@ -373,7 +462,7 @@ Options::print_usage () const
     ACE_TEXT ("Usage:\n")
     ACE_TEXT ("\n")
     ACE_TEXT ("ImplRepo_Service [-c cmd] [-d 0..5] [-e] [-m] [-o file]\n")
-    ACE_TEXT (" [-r|-p file|-x file|--directory dir [--primary|--backup] ]\n")
+    ACE_TEXT (" [-r|-p file|-x file|-b file|--directory dir [--primary|--backup] [--binary] ]\n")
     ACE_TEXT (" [-s] [-t secs] [-v msecs]\n")
     ACE_TEXT ("  -c command      Runs nt service commands ('install' or 'remove')\n")
     ACE_TEXT ("  -d level        Sets the debug level (default 0)\n")
@@ -383,8 +472,12 @@ Options::print_usage () const
     ACE_TEXT ("  -o file         Outputs the ImR's IOR to a file\n")
     ACE_TEXT ("  -p file         Use file for storing/loading settings\n")
     ACE_TEXT ("  -x file         Use XML file for storing/loading settings\n")
+    ACE_TEXT ("  -b file         Use a binary file for storing/loading settings\n")
     ACE_TEXT ("  --directory dir Use individual XML files for storing/loading\n")
     ACE_TEXT ("                  settings in the provided directory\n")
+    ACE_TEXT ("  --binary        Use one binary file in the --directory dir\n")
+    ACE_TEXT ("  --import file   Load the XML file into an empty binary repository\n")
+    ACE_TEXT ("  --export file   Write the binary repository to an XML file\n")
     ACE_TEXT ("  --primary       Replicate the ImplRepo as the primary ImR\n")
     ACE_TEXT ("  --backup        Replicate the ImplRepo as the backup ImR\n")
     ACE_TEXT ("  -r              Use the registry for storing/loading settings\n")
@@ -392,6 +485,8 @@ Options::print_usage () const
     ACE_TEXT ("  -t secs         Server startup timeout.(Default = %ds)\n")
     ACE_TEXT ("  -v msecs        Server verification interval.(Default = %dms)\n")
     ACE_TEXT ("  -n msecs        Ping request timeout.(Default = %dms)\n")
+    ACE_TEXT ("  --pingwindow n  Maximum number of pings awaiting a reply.\n")
+    ACE_TEXT ("                  (Default = 0, no limit)\n")
     ACE_TEXT ("  -i              Ping servers started without activators too.\n")
     ACE_TEXT ("  --lockout       Prevent excessive restart attempts until manual reset.\n")
     ACE_TEXT ("  --UnregisterIfAddressReused,\n")
@@ -452,6 +547,11 @@ Options::save_registry_options ()
     (LPBYTE) &tmp, sizeof (DWORD));
   ACE_ASSERT (err == ERROR_SUCCESS);
 
+  tmp = this->ping_window_;
+  err = ACE_TEXT_RegSetValueEx (key, ACE_TEXT ("PingWindow"), 0, REG_DWORD,
+    (LPBYTE) &tmp, sizeof (DWORD));
+  ACE_ASSERT (err == ERROR_SUCCESS);
+
   tmp = this->readonly_ ? 1 : 0;
   err = ACE_TEXT_RegSetValueEx (key, ACE_TEXT ("Lock"), 0, REG_DWORD,
     (LPBYTE) &tmp, sizeof (DWORD));
@@ -467,6 +567,11 @@ Options::save_registry_options ()
     (LPBYTE) &tmp, sizeof (DWORD));
   ACE_ASSERT (err == ERROR_SUCCESS);
 
+  tmp = this->binary_repo_ ? 1 : 0;
+  err = ACE_TEXT_RegSetValueEx (key, ACE_TEXT ("BinaryRepository"), 0, REG_DWORD,
+    (LPBYTE) &tmp, sizeof (DWORD));
+  ACE_ASSERT (err == ERROR_SUCCESS);
+
   tmp = static_cast<DWORD> (this->startup_timeout_.sec());
   err = ACE_TEXT_RegSetValueEx (key, ACE_TEXT ("Timeout"), 0, REG_DWORD,
     (LPBYTE) &tmp, sizeof (DWORD));
@@ -573,6 +678,16 @@ Options::load_registry_options ()
       ping_timeout_.msec (static_cast<long> (tmp));
     }
 
+  tmp = 0;
+  sz = sizeof(tmp);
+  err = ACE_TEXT_RegQueryValueEx (key, ACE_TEXT ("PingWindow"), 0, &type,
+    (LPBYTE) &tmp, &sz);
+  if (err == ERROR_SUCCESS)
+    {
+      ACE_ASSERT (type == REG_DWORD);
+      ping_window_ = static_cast<int> (tmp);
+    }
+
   tmp = 0;
   sz = sizeof(tmp);
   err = ACE_TEXT_RegQueryValueEx (key, ACE_TEXT ("Lock"), 0, &type,
@@ -601,6 +716,16 @@ Options::load_registry_options ()
       ACE_ASSERT (type == REG_DWORD);
     }
 
+  tmp = 0;
+  sz = sizeof(tmp);
+  err = ACE_TEXT_RegQueryValueEx (key, ACE_TEXT ("BinaryRepository"), 0, &type,
+    (LPBYTE) &tmp, &sz);
+  if (err == ERROR_SUCCESS)
+    {
+      ACE_ASSERT (type == REG_DWORD);
+      this->binary_repo_ = tmp != 0;
+    }
+
   tmp = 0;
   sz = sizeof(tmp);
   err = ACE_TEXT_RegQueryValueEx (key, ACE_TEXT ("Timeout"), 0, &type,
@@ -729,6 +854,12 @@ Options::ping_timeout () const
   return this->ping_timeout_;
 }
 
+int
+Options::ping_window () const
+{
+  return this->ping_window_;
+}
+
 LiveCheck *
 Options::pinger () const
 {
@@ -753,6 +884,24 @@ Options::repository_erase () const
   return this->erase_repo_;
 }
 
+bool
+Options::binary_repository () const
+{
+  return this->binary_repo_;
+}
+
+const ACE_TString&
+Options::import_file_name () const
+{
+  return this->import_file_name_;
+}
+
+const ACE_TString&
+Options::export_file_name () const
+{
+  return this->export_file_name_;
+}
+
 bool
 Options::readonly () const
 {
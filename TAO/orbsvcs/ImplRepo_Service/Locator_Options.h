@@ -80,13 +80,24 @@ public:
     REPO_XML_FILE,
     REPO_SHARED_FILES,
     REPO_HEAP_FILE,
-    REPO_REGISTRY
+    REPO_REGISTRY,
+    REPO_BINARY_FILE
   };
   RepoMode repository_mode () const;
 
   /// Do we wish to clear out the repository
   bool repository_erase () const;
 
+  /// Keep the shared repository in a single binary file
+  /// instead of one XML file per entry.
+  bool binary_repository () const;
+
+  /// XML repository file to load into an empty binary repository.
+  const ACE_TString& import_file_name () const;
+
+  /// XML file to write the binary repository to after it is loaded.
+  const ACE_TString& export_file_name () const;
+
   /// Returns the timeout value for program starting.
   ACE_Time_Value startup_timeout () const;
 
@@ -109,6 +120,9 @@ public:
   /// When pinging, this is the timeout
   ACE_Time_Value ping_timeout () const;
 
+  /// The maximum number of pings awaiting a reply, zero for no limit.
+  int ping_window () const;
+
   LiveCheck *pinger () const;
   void pinger (LiveCheck *);
 
@@ -165,6 +179,9 @@ private:
   /// The amount of time to wait for a "are you started yet?" ping reply.
   ACE_Time_Value ping_timeout_;
 
+  /// The number of pings that may be awaiting a reply at any time.
+  int ping_window_;
+
   /// The amount of time to wait for a server to response after starting it.
   ACE_Time_Value startup_timeout_;
 
@@ -180,6 +197,13 @@ private:
   /// The persistent XML file name.
   ACE_TString persist_file_name_;
 
+  /// Use the binary format for the shared repository.
+  bool binary_repo_;
+
+  /// XML files to import from or export to.
+  ACE_TString import_file_name_;
+  ACE_TString export_file_name_;
+
   /// Should check the server address and remove previous server if
   /// the address is reused.
   bool unregister_if_address_reused_;
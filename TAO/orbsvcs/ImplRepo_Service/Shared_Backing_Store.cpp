@@ -1,5 +1,6 @@
 #include "orbsvcs/Log_Macros.h"
 #include "Shared_Backing_Store.h"
+#include "Binary_Backing_Store.h"
 #include "Server_Info.h"
 #include "Activator_Info.h"
 #include "AsyncAccessManager.h"
@@ -216,6 +217,11 @@ Shared_Backing_Store::Shared_Backing_Store(const Options& opts,
                                            ImR_Locator_i *loc_impl)
 : XML_Backing_Store (opts, orb, true),
   listing_file_ (opts.persist_file_name() + ACE_TEXT("imr_listing.xml")),
+  binary_ (opts.binary_repository () ?
+           new Binary_Repository_File (opts.persist_file_name () +
+                                       ACE_TEXT ("imr_repository.bin"),
+                                       opts.debug ()) :
+           0),
   imr_type_ (opts.imr_type ()),
   sync_needed_ (NO_SYNC),
   sync_files_ (),
@@ -364,6 +370,35 @@ Shared_Backing_Store::verify_unique_id (const ACE_CString& key,
 int
 Shared_Backing_Store::persistent_remove (const ACE_CString& name,
                                          bool activator)
+{
+  if (this->binary_.get () != 0)
+    {
+      const int err = this->binary_->write_remove (name, activator);
+      if (err != 0)
+        {
+          return err;
+        }
+    }
+  else
+    {
+      const int err = this->remove_files (name, activator);
+      if (err != 0)
+        {
+          return err;
+        }
+    }
+
+  ImplementationRepository::UpdateInfo info;
+  info.name = CORBA::string_dup (name.c_str ());
+  info.action.kind (activator ?
+                    ImplementationRepository::repo_activator :
+                    ImplementationRepository::repo_server);
+  this->replicator_.send_entity (info);
+  return 0;
+}
+
+int
+Shared_Backing_Store::remove_files (const ACE_CString& name, bool activator)
 {
   Lockable_File listing_lf;
   int err = this->persist_listings (listing_lf);
@@ -389,19 +424,27 @@ Shared_Backing_Store::persistent_remove (const ACE_CString& name,
     Lockable_File file(fname, O_WRONLY, true);
   }
   listing_lf.release();
-
-  ImplementationRepository::UpdateInfo info;
-  info.name = CORBA::string_dup (name.c_str ());
-  info.action.kind (activator ?
-                    ImplementationRepository::repo_activator :
-                    ImplementationRepository::repo_server);
-  this->replicator_.send_entity (info);
   return 0;
 }
 
 int
 Shared_Backing_Store::persistent_update (const Server_Info_Ptr& info, bool add)
 {
+  if (this->binary_.get () != 0)
+    {
+      UniqueId uid;
+      this->find_unique_id (info->key_name_, this->server_uids_, uid);
+      this->repo_values_[REPO_TYPE].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_type_str.c_str ());
+      this->repo_values_[REPO_ID].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_id_str.c_str ());
+      const int err = this->binary_->write (*info, this->repo_values_);
+      if (err != 0)
+        {
+          return err;
+        }
+      this->send_update (info->key_name_, false, uid);
+      return this->compact_binary (false);
+    }
+
   Lockable_File listing_lf;
   if (add)
     {
@@ -452,14 +495,7 @@ Shared_Backing_Store::persistent_update (const Server_Info_Ptr& info, bool add)
     }
   server_file.release ();
 
-  ImplementationRepository::UpdateInfo entity;
-  entity.name = static_cast<const char *> (ACE_TEXT_ALWAYS_CHAR (name.c_str ()));
-  ImplementationRepository::RepoInfo rinfo;
-  rinfo.kind = ImplementationRepository::repo_server;
-  rinfo.repo.repo_id = uid.repo_id;
-  rinfo.repo.repo_type = uid.repo_type;
-  entity.action.info (rinfo);
-  this->replicator_.send_entity (entity);
+  this->send_update (ACE_TEXT_ALWAYS_CHAR (name.c_str ()), false, uid);
 
   return 0;
 }
@@ -468,6 +504,22 @@ Shared_Backing_Store::persistent_update (const Server_Info_Ptr& info, bool add)
 int
 Shared_Backing_Store::persistent_update(const Activator_Info_Ptr& info, bool add)
 {
+  if (this->binary_.get () != 0)
+    {
+      const ACE_CString name = lcase (info->name);
+      UniqueId uid;
+      this->find_unique_id (name, this->activator_uids_, uid);
+      this->repo_values_[REPO_TYPE].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_type_str.c_str ());
+      this->repo_values_[REPO_ID].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_id_str.c_str ());
+      const int err = this->binary_->write (*info, this->repo_values_);
+      if (err != 0)
+        {
+          return err;
+        }
+      this->send_update (name, true, uid);
+      return this->compact_binary (false);
+    }
+
   Lockable_File listing_lf;
   if (add)
     {
@@ -517,21 +569,77 @@ Shared_Backing_Store::persistent_update(const Activator_Info_Ptr& info, bool add
   ACE_OS::fclose (bfp);
   activator_file.release ();
 
+  this->send_update (name, true, uid);
+
+  return 0;
+}
+
+void
+Shared_Backing_Store::send_update (const ACE_CString& name,
+                                   bool activator,
+                                   const UniqueId& uid)
+{
   ImplementationRepository::UpdateInfo entity;
   entity.name = CORBA::string_dup (name.c_str ());
   ImplementationRepository::RepoInfo rinfo;
-  rinfo.kind = ImplementationRepository::repo_activator;
+  rinfo.kind = activator ?
+    ImplementationRepository::repo_activator :
+    ImplementationRepository::repo_server;
   rinfo.repo.repo_id = uid.repo_id;
   rinfo.repo.repo_type = uid.repo_type;
   entity.action.info (rinfo);
   this->replicator_.send_entity (entity);
+}
 
-  return 0;
+int
+Shared_Backing_Store::compact_binary (bool force)
+{
+  if (!force &&
+      !this->binary_->needs_compaction (this->servers ().current_size () +
+                                        this->activators ().current_size ()))
+    {
+      return 0;
+    }
+
+  // also loads what the peer replica appended, a peer that loaded the
+  // old log reloads the whole new one
+  if (this->binary_->begin_rewrite (*this) != 0)
+    {
+      return -1;
+    }
+
+  Locator_Repository::SIMap::ENTRY* sientry = 0;
+  Locator_Repository::SIMap::ITERATOR siit (this->servers ());
+  for (; siit.next (sientry); siit.advance ())
+    {
+      UniqueId uid;
+      this->find_unique_id (sientry->ext_id_, this->server_uids_, uid);
+      this->repo_values_[REPO_TYPE].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_type_str.c_str ());
+      this->repo_values_[REPO_ID].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_id_str.c_str ());
+      this->binary_->write (*sientry->int_id_, this->repo_values_);
+    }
+
+  Locator_Repository::AIMap::ENTRY* aientry = 0;
+  Locator_Repository::AIMap::ITERATOR aiit (this->activators ());
+  for (; aiit.next (aientry); aiit.advance ())
+    {
+      UniqueId uid;
+      this->find_unique_id (aientry->ext_id_, this->activator_uids_, uid);
+      this->repo_values_[REPO_TYPE].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_type_str.c_str ());
+      this->repo_values_[REPO_ID].second = ACE_TEXT_ALWAYS_CHAR (uid.repo_id_str.c_str ());
+      this->binary_->write (*aientry->int_id_, this->repo_values_);
+    }
+
+  return this->binary_->commit_rewrite ();
 }
 
 const ACE_TCHAR*
 Shared_Backing_Store::repo_mode() const
 {
+  if (this->binary_.get () != 0)
+    {
+      return this->binary_->filename ().c_str ();
+    }
   return this->listing_file_.c_str();
 }
 
@@ -593,9 +701,20 @@ Shared_Backing_Store::init_repo(PortableServer::POA_ptr)
       this->connect_replicas ();
     }
 
+  if (this->binary_.get () != 0 && this->binary_->open () != 0)
+    {
+      return -1;
+    }
+
   // only start the repo clean if no replica is running
   if (this->opts_.repository_erase() &&
-      !this->replicator_.peer_available ())
+      !this->replicator_.peer_available () &&
+      this->binary_.get () != 0)
+    {
+      this->binary_->erase ();
+    }
+  else if (this->opts_.repository_erase() &&
+           !this->replicator_.peer_available ())
     {
       Lockable_File listing_lf;
       const XMLHandler_Ptr listings = get_listings(listing_lf, false);
@@ -633,6 +752,11 @@ Shared_Backing_Store::init_repo(PortableServer::POA_ptr)
   // Ignore persistent_load return since files don't have to exist
   this->persistent_load (false);
 
+  if (this->binary_.get () != 0)
+    {
+      this->init_binary ();
+    }
+
   if (this->opts_.debug() > 9)
     {
       ORBSVCS_DEBUG((LM_INFO,
@@ -642,8 +766,73 @@ Shared_Backing_Store::init_repo(PortableServer::POA_ptr)
   return 0;
 }
 
+int
+Shared_Backing_Store::init_binary (void)
+{
+  const bool empty = this->servers ().current_size () == 0 &&
+    this->activators ().current_size () == 0;
+  const ACE_TString& import_file = this->opts_.import_file_name ();
+  if (empty && import_file.length () > 0)
+    {
+      if (this->load_file (import_file) != 0)
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Couldn't import %s\n"),
+                          import_file.c_str ()));
+        }
+    }
+  else if (empty && !this->opts_.repository_erase () &&
+           this->load_listings (false) == 0)
+    {
+      // the directory holds a repository written without --binary
+      ORBSVCS_DEBUG ((LM_INFO,
+                      ACE_TEXT ("(%P|%t) Converting %s to %s\n"),
+                      this->listing_file_.c_str (),
+                      this->binary_->filename ().c_str ()));
+    }
+  else if (import_file.length () > 0)
+    {
+      ORBSVCS_ERROR ((LM_WARNING,
+                      ACE_TEXT ("(%P|%t) %s is not empty, not importing %s\n"),
+                      this->binary_->filename ().c_str (),
+                      import_file.c_str ()));
+    }
+
+  if (empty && (this->servers ().current_size () != 0 ||
+                this->activators ().current_size () != 0))
+    {
+      // write what was imported
+      if (this->compact_binary (true) != 0)
+        {
+          return -1;
+        }
+    }
+  else
+    {
+      this->compact_binary (false);
+    }
+
+  const ACE_TString& export_file = this->opts_.export_file_name ();
+  if (export_file.length () > 0)
+    {
+      this->persist_xml (export_file);
+    }
+  return 0;
+}
+
 int
 Shared_Backing_Store::persistent_load (bool only_changes)
+{
+  if (this->binary_.get () != 0)
+    {
+      bool full = !only_changes;
+      return this->binary_->load (*this, full);
+    }
+  return this->load_listings (only_changes);
+}
+
+int
+Shared_Backing_Store::load_listings (bool only_changes)
 {
   Lockable_File listing_lf;
   const XMLHandler_Ptr listings = this->get_listings (listing_lf, only_changes);
@@ -729,6 +918,12 @@ Shared_Backing_Store::sync_load ()
         }
       err = this->persistent_load (false);
     }
+  else if (this->sync_needed_ == INC_SYNC && this->binary_.get () != 0)
+    {
+      // the changes are at the end of the binary repository
+      this->sync_files_.clear ();
+      err = this->persistent_load (true);
+    }
   else if (this->sync_needed_ == INC_SYNC)
     {
       if (this->sync_files_.empty ())
@@ -970,6 +1165,16 @@ Shared_Backing_Store::load_activator (const ACE_CString& activator_name,
   XML_Backing_Store::load_activator (activator_name, token, ior, extra_params);
 }
 
+void
+Shared_Backing_Store::unload (const ACE_CString& name, bool activator)
+{
+  if (!activator)
+    {
+      this->opts_.pinger ()->remove_server (name.c_str (), 0);
+    }
+  XML_Backing_Store::unload (name, activator);
+}
+
 void
 Shared_Backing_Store::notify_remote_access (const char * id,
                                           ImplementationRepository::AAM_Status s)
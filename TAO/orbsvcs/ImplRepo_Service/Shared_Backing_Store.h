@@ -27,12 +27,15 @@
 #include "ace/Vector_T.h"
 #include "ACEXML/common/DefaultHandler.h"
 
+#include <memory>
 #include <set>
 
 namespace {
   class Lockable_File;
 }
 
+class Binary_Repository_File;
+
 /**
 * @class Shared_Backing_Store
 *
@@ -98,6 +101,10 @@ public:
                                const ACE_CString& ior,
                                const NameValues& extra_params);
 
+  /// remove a server or activator that was removed by the peer
+  /// replica, also stops pinging the server
+  virtual void unload (const ACE_CString& name, bool activator);
+
   virtual void notify_remote_access (const char * id,
                                      ImplementationRepository::AAM_Status s);
 
@@ -236,6 +243,27 @@ private:
   ///        loaded
   int persistent_load(bool only_changes);
 
+  /// load the files named in the listings file
+  /// @param only_changes if only changes to the repo should be
+  ///        loaded
+  int load_listings(bool only_changes);
+
+  /// remove the file of a server or activator and update the
+  /// listings file
+  int remove_files (const ACE_CString& name, bool activator);
+
+  /// rewrite the binary repository once it holds mostly stale records
+  /// @param force rewrite it even if it does not
+  int compact_binary (bool force);
+
+  /// import into an empty binary repository and export it as needed
+  int init_binary (void);
+
+  /// tell the peer replica that a server or activator was persisted
+  void send_update (const ACE_CString& name,
+                    bool activator,
+                    const UniqueId& uid);
+
   /// persistent the listings file
   /// @param listing_lf a Lockable_File for the listings file
   ///        that will be locked when the function returns
@@ -251,6 +279,9 @@ private:
 
   /// the path and filename for the listings file
   const ACE_TString listing_file_;
+  /// the binary repository that replaces the listings file and the
+  /// server and activator files when --binary is used
+  std::unique_ptr<Binary_Repository_File> binary_;
   /// the imr type of this Shared_Backing_Store
   const Options::ImrType imr_type_;
   /// the current type of sync needed by the repo
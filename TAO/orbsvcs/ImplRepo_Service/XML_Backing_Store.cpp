@@ -52,11 +52,17 @@ XML_Backing_Store::persistent_update(const Activator_Info_Ptr& , bool )
 int
 XML_Backing_Store::persist ()
 {
-  FILE* fp = ACE_OS::fopen (this->filename_.c_str (), "w");
+  return this->persist_xml (this->filename_);
+}
+
+int
+XML_Backing_Store::persist_xml (const ACE_TString& filename)
+{
+  FILE* fp = ACE_OS::fopen (filename.c_str (), "w");
   if (fp == 0)
     {
       ORBSVCS_ERROR ((LM_ERROR, ACE_TEXT ("Couldn't write to file %C\n"),
-        this->filename_.c_str()));
+        filename.c_str()));
       return -1;
     }
   ACE_OS::fprintf (fp,"<?xml version=\"1.0\"?>\n");
@@ -327,3 +333,16 @@ XML_Backing_Store::load_activator (const ACE_CString& activator_name,
   Activator_Info_Ptr info (ai);
   this->activators().rebind(Locator_Repository::lcase (activator_name), info);
 }
+
+void
+XML_Backing_Store::unload (const ACE_CString& name, bool activator)
+{
+  if (activator)
+    {
+      this->activators ().unbind (Locator_Repository::lcase (name));
+    }
+  else
+    {
+      this->servers ().unbind (name);
+    }
+}
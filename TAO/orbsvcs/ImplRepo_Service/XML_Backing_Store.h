@@ -69,6 +69,11 @@ public:
                                long token,
                                const ACE_CString& ior,
                                const NameValues& extra_params);
+
+  /// remove a server or activator that is no longer persisted
+  /// @param name the server key name or the activator name
+  /// @param activator indicates if name is an activator
+  virtual void unload (const ACE_CString& name, bool activator);
 protected:
   /// perform XML backing store specific initialization
   /// (loads servers and activators from the backing store)
@@ -130,6 +135,9 @@ protected:
   /// @param si the server info in question
   void create_server(bool server_started, const Server_Info_Ptr& si);
 
+  /// persist all servers and activators to the given XML file
+  int persist_xml (const ACE_TString& filename);
+
 protected:
   /// the filename indicated in the Options for the backing store
   const ACE_TString filename_;
@@ -345,6 +345,9 @@ TAO_ECG_CDR_Message_Receiver::handle_input (
       if (result != 1)
         return result;
 
+      if (header.batched)
+        return this->process_batch (header, data_buf, cdr_processor);
+
       TAO_InputCDR cdr (data_buf, header.request_size, header.byte_order);
       if (cdr_processor->decode (cdr) == -1)
         return -1;
@@ -475,6 +478,48 @@ TAO_ECG_CDR_Message_Receiver::process_fragment (
   return 1;
 }
 
+int
+TAO_ECG_CDR_Message_Receiver::process_batch (
+                                   const Mcast_Header &header,
+                                   char * data_buf,
+                                   TAO_ECG_CDR_Processor *cdr_processor)
+{
+  int result = 1;
+
+  CORBA::ULong offset = 0;
+  while (offset + TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+         <= header.request_size)
+    {
+      // Every record starts at an 8-byte boundary, with the size of
+      // the message that follows it.
+      TAO_InputCDR record_cdr (
+        data_buf + offset,
+        TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE,
+        header.byte_order);
+      offset += TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE;
+
+      CORBA::ULong message_size = 0;
+      if (!record_cdr.read_ulong (message_size)
+          || message_size > header.request_size - offset)
+        {
+          ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             "Invalid record in batched mcast message.\n"),
+                            -1);
+        }
+
+      TAO_InputCDR cdr (data_buf + offset,
+                        message_size,
+                        header.byte_order);
+      if (cdr_processor->decode (cdr) == -1)
+        result = -1;
+
+      offset += static_cast<CORBA::ULong> (
+        ACE_align_binary (message_size, ACE_CDR::MAX_ALIGNMENT));
+    }
+
+  return result;
+}
+
 TAO_ECG_CDR_Message_Receiver::Request_Map::ENTRY*
 TAO_ECG_CDR_Message_Receiver::get_source_entry (const ACE_INET_Addr &from)
 {
@@ -527,14 +572,17 @@ TAO_ECG_CDR_Message_Receiver::Mcast_Header::read (char *header,
                                                   CORBA::Boolean checkcrc)
 {
   // Decode.
-  this->byte_order = header[0];
-  if(this->byte_order != 0 && this->byte_order != 1)
+  CORBA::Octet const flags = static_cast<CORBA::Octet> (header[0]);
+  if ((flags & ~(0x01 | TAO_ECG_CDR_Message_Sender::ECG_BATCH_FLAG)) != 0)
     {
-      ORBSVCS_ERROR_RETURN ((LM_ERROR, "Reading mcast packet header: byte "
-                                   "order is neither 0 nor 1, it is %d.\n",
-                         this->byte_order),
+      ORBSVCS_ERROR_RETURN ((LM_ERROR, "Reading mcast packet header: "
+                                   "unknown flags in byte order octet %d.\n",
+                         flags),
                         -1);
     }
+  this->byte_order = flags & 0x01;
+  this->batched =
+    ACE_BIT_ENABLED (flags, TAO_ECG_CDR_Message_Sender::ECG_BATCH_FLAG);
 
   TAO_InputCDR header_cdr (header,
                            TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE,
@@ -586,6 +634,7 @@ TAO_ECG_CDR_Message_Receiver::Mcast_Header::read (char *header,
   if (this->request_size < this->fragment_size
       || this->fragment_offset >= this->request_size
       || this->fragment_id >= this->fragment_count
+      || (this->batched && this->fragment_count != 1)
       || (this->fragment_count == 1
           && (this->fragment_size != this->request_size
               || this->request_size != data_bytes_received)))
@@ -137,6 +137,11 @@ private:
  * dropped.
  * Once all the fragments have been received the message is sent
  * up to the calling classes, and the memory reclaimed.
+ *
+ * = BATCHED MESSAGES
+ * A datagram carrying several batched messages (see
+ * ECG_CDR_Message_Sender.h) is a single, complete request; each
+ * message in it is passed to the calling classes in turn.
  */
 class TAO_RTEvent_Serv_Export TAO_ECG_CDR_Message_Receiver
 {
@@ -204,6 +209,12 @@ private:
                         char * data_buf,
                         TAO_ECG_CDR_Processor *cdr_processor);
 
+  /// Unpacks the messages in a batched datagram and passes each one
+  /// to @a cdr_processor.  Returns 1 if all the messages were
+  /// accepted and -1 on error.
+  int process_batch (const Mcast_Header &header,
+                     char * data_buf,
+                     TAO_ECG_CDR_Processor *cdr_processor);
 
   Request_Map::ENTRY* get_source_entry (const ACE_INET_Addr &from);
 
@@ -238,6 +249,7 @@ private:
 struct TAO_ECG_CDR_Message_Receiver::Mcast_Header
 {
   int byte_order;
+  CORBA::Boolean batched;
   CORBA::ULong request_id;
   CORBA::ULong request_size;
   CORBA::ULong fragment_size;
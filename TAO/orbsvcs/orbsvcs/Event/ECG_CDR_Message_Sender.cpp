@@ -4,6 +4,8 @@
 #include "ace/SOCK_Dgram.h"
 #include "ace/INET_Addr.h"
 #include "ace/ACE.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_string.h"
 
 #if !defined(__ACE_INLINE__)
 #include "orbsvcs/Event/ECG_CDR_Message_Sender.inl"
@@ -13,6 +15,11 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+TAO_ECG_CDR_Message_Sender::~TAO_ECG_CDR_Message_Sender ()
+{
+  ACE_Message_Block::release (this->batch_);
+}
+
 void
 TAO_ECG_CDR_Message_Sender::init (
       TAO_ECG_Refcounted_Endpoint endpoint_rptr)
@@ -28,6 +35,51 @@ TAO_ECG_CDR_Message_Sender::init (
   this->endpoint_rptr_ = endpoint_rptr;
 }
 
+void
+TAO_ECG_CDR_Message_Sender::shutdown ()
+{
+  // Try not to lose the events still waiting in the batch.
+  if (this->batch_count_ != 0 && this->endpoint_rptr_.get () != nullptr)
+    {
+      try
+        {
+          this->flush ();
+        }
+      catch (const CORBA::Exception&)
+        {
+          // Nothing we can do at this point, the events are lost.
+        }
+    }
+
+  // Release the endpoint.
+  TAO_ECG_Refcounted_Endpoint empty_endpoint_rptr;
+  this->endpoint_rptr_ = empty_endpoint_rptr;
+}
+
+void
+TAO_ECG_CDR_Message_Sender::batching (CORBA::Boolean enable)
+{
+  if (enable)
+    {
+      if (this->batch_ == nullptr)
+        {
+          ACE_NEW_THROW_EX (this->batch_,
+                            ACE_Message_Block (
+                              TAO_ECG_CDR_Message_Sender::ECG_MAX_MTU
+                              + ACE_CDR::MAX_ALIGNMENT),
+                            CORBA::NO_MEMORY ());
+          ACE_CDR::mb_align (this->batch_);
+        }
+      return;
+    }
+
+  if (this->batch_count_ != 0)
+    this->flush ();
+
+  ACE_Message_Block::release (this->batch_);
+  this->batch_ = nullptr;
+}
+
 void
 TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
                                            const ACE_INET_Addr &addr)
@@ -39,8 +91,30 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
       throw CORBA::INTERNAL ();
     }
 
+  ++this->message_count_;
+
   CORBA::ULong max_fragment_payload = this->mtu () -
     TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE;
+
+  if (this->batch_ != nullptr)
+    {
+      CORBA::ULong const message_size =
+        static_cast<CORBA::ULong> (cdr.total_length ());
+      CORBA::ULong const record_size = static_cast<CORBA::ULong> (
+        ACE_align_binary (TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+                          + message_size,
+                          ACE_CDR::MAX_ALIGNMENT));
+      if (record_size <= max_fragment_payload)
+        {
+          this->batch_message (cdr, addr, message_size);
+          return;
+        }
+
+      // The message must be fragmented, send the pending messages
+      // first so the ordering is preserved.
+      if (this->batch_count_ != 0)
+        this->flush ();
+    }
   // ACE_ASSERT (max_fragment_payload != 0);
 
 #if defined (ACE_HAS_BROKEN_DGRAM_SENDV)
@@ -174,6 +248,104 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
 
 }
 
+void
+TAO_ECG_CDR_Message_Sender::batch_message (const TAO_OutputCDR &cdr,
+                                           const ACE_INET_Addr &addr,
+                                           CORBA::ULong message_size)
+{
+  CORBA::ULong const max_payload = this->mtu () -
+    TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE;
+  CORBA::ULong const record_size = static_cast<CORBA::ULong> (
+    ACE_align_binary (TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+                      + message_size,
+                      ACE_CDR::MAX_ALIGNMENT));
+
+  if (this->batch_count_ != 0
+      && (this->batch_addr_ != addr
+          || this->batch_->length () + record_size > max_payload))
+    {
+      this->flush ();
+    }
+
+  if (this->batch_count_ == 0)
+    this->batch_addr_ = addr;
+
+  // The record header is written in the native byte order, which is
+  // also the byte order of the datagram header.
+  char *wr_ptr = this->batch_->wr_ptr ();
+  ACE_OS::memcpy (wr_ptr, &message_size, sizeof (message_size));
+  ACE_OS::memset (wr_ptr + sizeof (message_size),
+                  0,
+                  TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+                  - sizeof (message_size));
+  wr_ptr += TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE;
+
+  for (const ACE_Message_Block* b = cdr.begin ();
+       b != cdr.end ();
+       b = b->cont ())
+    {
+      ACE_OS::memcpy (wr_ptr, b->rd_ptr (), b->length ());
+      wr_ptr += b->length ();
+    }
+
+  // Pad the record so the next one starts at an 8-byte boundary.
+  ACE_OS::memset (wr_ptr,
+                  0,
+                  record_size
+                  - TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+                  - message_size);
+
+  this->batch_->wr_ptr (record_size);
+  ++this->batch_count_;
+
+  // Do not wait for the flush if no other record can fit.
+  if (max_payload - this->batch_->length ()
+      < TAO_ECG_CDR_Message_Sender::ECG_BATCH_RECORD_HEADER_SIZE
+        + ACE_CDR::MAX_ALIGNMENT)
+    {
+      this->flush ();
+    }
+}
+
+void
+TAO_ECG_CDR_Message_Sender::flush ()
+{
+  if (this->batch_count_ == 0)
+    return;
+
+  if (this->endpoint_rptr_.get () == nullptr)
+    {
+      ORBSVCS_ERROR ((LM_ERROR, "Attempt to invoke flush() "
+                            "on non-initialized sender object.\n"));
+      throw CORBA::INTERNAL ();
+    }
+
+  CORBA::ULong const batch_size =
+    static_cast<CORBA::ULong> (this->batch_->length ());
+
+  // Reserve the first iovec for the header...
+  iovec iov[2];
+  iov[1].iov_base = this->batch_->rd_ptr ();
+  iov[1].iov_len  = batch_size;
+
+  // Reset the batch before sending it, if the send fails the events
+  // are dropped, just like unbatched events would be.
+  this->batch_count_ = 0;
+  this->batch_->reset ();
+  ACE_CDR::mb_align (this->batch_);
+
+  this->send_fragment (this->batch_addr_,
+                       this->endpoint_rptr_->next_request_id (),
+                       batch_size,
+                       batch_size,
+                       0,
+                       0,
+                       1,
+                       iov,
+                       2,
+                       TAO_ECG_CDR_Message_Sender::ECG_BATCH_FLAG);
+}
+
 
 void
 TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
@@ -184,14 +356,15 @@ TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
                                            CORBA::ULong fragment_id,
                                            CORBA::ULong fragment_count,
                                            iovec iov[],
-                                           int iovcnt)
+                                           int iovcnt,
+                                           CORBA::Octet flags)
 {
   CORBA::ULong header[TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE
                      / sizeof(CORBA::ULong)
                      + ACE_CDR::MAX_ALIGNMENT];
   char* buf = reinterpret_cast<char*> (header);
   TAO_OutputCDR cdr (buf, sizeof(header));
-  cdr.write_boolean (TAO_ENCAP_BYTE_ORDER);
+  cdr.write_octet (static_cast<CORBA::Octet> (TAO_ENCAP_BYTE_ORDER | flags));
   // Insert some known values in the padding bytes, so we can smoke
   // test the message on the receiving end.
   cdr.write_octet ('A'); cdr.write_octet ('B'); cdr.write_octet ('C');
@@ -238,6 +411,7 @@ TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
   ssize_t n = this->dgram ().send (iov,
                                    iovcnt,
                                    addr);
+  ++this->datagram_count_;
   size_t expected_n = 0;
   for (int i = 0; i < iovcnt; ++i)
     expected_n += iov[i].iov_len;
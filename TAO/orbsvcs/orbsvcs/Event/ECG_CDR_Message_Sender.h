@@ -24,6 +24,10 @@
 
 #include "ace/INET_Addr.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Message_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 /**
@@ -69,6 +73,27 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  *
  * // Ensures the header ends at an 8-byte boundary.
  * }; // size (in CDR stream) = 32
+ *
+ * <H2>BATCHED MESSAGES</H2>
+ * When batching is enabled small messages are not sent immediately,
+ * instead they are packed into a single datagram (of at most mtu ()
+ * bytes) that is sent when it fills up, when a message for a
+ * different destination arrives or when flush () is called.
+ * A batched datagram uses a single, unfragmented request (its
+ * fragment_count is always 1) and sets bit 2 (ECG_BATCH_FLAG) in the
+ * byte_order_flags octet of the header.  Its payload is a sequence of
+ * records, each one starting at an 8-byte boundary:
+ * struct Record {
+ * unsigned long message_size;
+ * // The size of the message, excluding this record header
+ * octet padding[4];
+ * octet message[message_size];
+ * // Followed by up to 7 octets of padding.
+ * };
+ * The message_size field uses the byte order of the datagram header.
+ * Messages that do not fit in a single datagram are never batched,
+ * any pending batch is flushed and the message is fragmented as
+ * usual.
  */
 class TAO_RTEvent_Serv_Export TAO_ECG_CDR_Message_Sender
 {
@@ -78,13 +103,17 @@ public:
     ECG_HEADER_SIZE = 32,
     ECG_MIN_MTU = 32 + 8,
     ECG_MAX_MTU = 65536, // Really optimistic...
-    ECG_DEFAULT_MTU = 1024
+    ECG_DEFAULT_MTU = 1024,
+    ECG_BATCH_FLAG = 0x04,
+    ECG_BATCH_RECORD_HEADER_SIZE = 8
   };
 
   /// Initialization and termination methods.
   //@{
   TAO_ECG_CDR_Message_Sender (CORBA::Boolean crc = 0);
 
+  ~TAO_ECG_CDR_Message_Sender ();
+
   /// Set the endpoint for sending messages.
   /**
    * If init () is successful, shutdown () must be called when the
@@ -110,6 +139,23 @@ public:
    */
   int mtu (CORBA::ULong mtu);
   CORBA::ULong mtu () const;
+
+  /**
+   * Enable or disable packing of several small messages into a
+   * single datagram.  Disabling batching flushes any pending
+   * messages.
+   */
+  void batching (CORBA::Boolean enable);
+  CORBA::Boolean batching () const;
+
+  /// Number of messages waiting in the current batch.
+  CORBA::ULong pending_messages () const;
+
+  /// Number of messages passed to send_message() so far.
+  CORBA::ULongLong message_count () const;
+
+  /// Number of datagrams (fragments or batches) sent so far.
+  CORBA::ULongLong datagram_count () const;
   //@}
 
   /// The main method - send a CDR message.
@@ -129,7 +175,17 @@ public:
   void send_message (const TAO_OutputCDR &cdr,
                      const ACE_INET_Addr &addr);
 
+  /// Send any messages in the current batch.
+  void flush ();
+
 private:
+  /// Append @a cdr to the current batch, flushing the batch first if
+  /// it is addressed to another destination or there is not enough
+  /// room left in it.
+  void batch_message (const TAO_OutputCDR &cdr,
+                      const ACE_INET_Addr &addr,
+                      CORBA::ULong message_size);
+
   /// Return the datagram...
   ACE_SOCK_Dgram& dgram ();
 
@@ -146,7 +202,8 @@ private:
                       CORBA::ULong fragment_id,
                       CORBA::ULong fragment_count,
                       iovec iov[],
-                      int iovcnt);
+                      int iovcnt,
+                      CORBA::Octet flags = 0);
 
   /**
    * Count the number of fragments that will be required to send the
@@ -169,6 +226,22 @@ private:
 
   /// Should crc checksum be calculated and sent?
   CORBA::Boolean checksum_;
+
+  /// Buffer used to pack messages when batching is enabled, 0 if
+  /// batching is disabled.
+  ACE_Message_Block *batch_;
+
+  /// Destination of the messages in <batch_>.
+  ACE_INET_Addr batch_addr_;
+
+  /// Number of messages in <batch_>.
+  CORBA::ULong batch_count_;
+
+  /// Statistics.
+  //@{
+  CORBA::ULongLong message_count_;
+  CORBA::ULongLong datagram_count_;
+  //@}
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -8,17 +8,13 @@ TAO_ECG_CDR_Message_Sender::TAO_ECG_CDR_Message_Sender (CORBA::Boolean crc)
   :  endpoint_rptr_ ()
      , mtu_ (TAO_ECG_CDR_Message_Sender::ECG_DEFAULT_MTU)
      , checksum_ (crc)
+     , batch_ (nullptr)
+     , batch_count_ (0)
+     , message_count_ (0)
+     , datagram_count_ (0)
 {
 }
 
-ACE_INLINE void
-TAO_ECG_CDR_Message_Sender::shutdown (void)
-{
-  // Release the endpoint.
-  TAO_ECG_Refcounted_Endpoint empty_endpoint_rptr;
-  this->endpoint_rptr_ = empty_endpoint_rptr;
-}
-
 ACE_INLINE ACE_SOCK_Dgram&
 TAO_ECG_CDR_Message_Sender::dgram (void)
 {
@@ -46,8 +42,34 @@ TAO_ECG_CDR_Message_Sender::mtu (CORBA::ULong new_mtu)
   if (new_mtu < TAO_ECG_CDR_Message_Sender::ECG_MIN_MTU
       || new_mtu >= TAO_ECG_CDR_Message_Sender::ECG_MAX_MTU)
     return -1;
+  if (this->batch_count_ != 0)
+    this->flush ();
   this->mtu_ = new_mtu;
   return 0;
 }
 
+ACE_INLINE CORBA::Boolean
+TAO_ECG_CDR_Message_Sender::batching () const
+{
+  return this->batch_ != 0;
+}
+
+ACE_INLINE CORBA::ULong
+TAO_ECG_CDR_Message_Sender::pending_messages () const
+{
+  return this->batch_count_;
+}
+
+ACE_INLINE CORBA::ULongLong
+TAO_ECG_CDR_Message_Sender::message_count () const
+{
+  return this->message_count_;
+}
+
+ACE_INLINE CORBA::ULongLong
+TAO_ECG_CDR_Message_Sender::datagram_count () const
+{
+  return this->datagram_count_;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
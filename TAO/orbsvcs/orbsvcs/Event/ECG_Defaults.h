@@ -49,6 +49,14 @@
 # define TAO_ECG_DEFAULT_NON_BLOCKING 1 /* write sockets are non-blocking */
 #endif /* TAO_ECG_DEFAULT_NON_BLOCKING */
 
+#ifndef TAO_ECG_DEFAULT_MTU
+# define TAO_ECG_DEFAULT_MTU 0 /* don't set, use default */
+#endif /* TAO_ECG_DEFAULT_MTU */
+
+#ifndef TAO_ECG_DEFAULT_BATCH_INTERVAL
+# define TAO_ECG_DEFAULT_BATCH_INTERVAL 0 /* usecs, no batching */
+#endif /* TAO_ECG_DEFAULT_BATCH_INTERVAL */
+
 #ifndef TAO_ECG_DEFAULT_IIOP_CONSUMEREC_CONTROL
 # define TAO_ECG_DEFAULT_IIOP_CONSUMEREC_CONTROL 0 /* null */
 #endif /* TAO_ECG_DEFAULT_IIOP_CONSUMEREC_CONTROL */
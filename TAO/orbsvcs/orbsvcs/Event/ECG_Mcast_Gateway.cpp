@@ -190,6 +190,31 @@ TAO_ECG_Mcast_Gateway::init (int argc, ACE_TCHAR* argv[])
             }
         }
 
+      else if (ACE_OS::strcasecmp (arg, ACE_TEXT ("-ECGMTU")) == 0)
+        {
+          arg_shifter.consume_arg ();
+
+          if (arg_shifter.is_parameter_next ())
+            {
+              const ACE_TCHAR* opt = arg_shifter.get_current ();
+              this->mtu_ =
+                static_cast<CORBA::ULong> (ACE_OS::strtoul (opt, nullptr, 0));
+              arg_shifter.consume_arg ();
+            }
+        }
+
+      else if (ACE_OS::strcasecmp (arg, ACE_TEXT ("-ECGBatchInterval")) == 0)
+        {
+          arg_shifter.consume_arg ();
+
+          if (arg_shifter.is_parameter_next ())
+            {
+              const ACE_TCHAR* opt = arg_shifter.get_current ();
+              this->batch_interval_ = ACE_OS::strtoul (opt, nullptr, 0);
+              arg_shifter.consume_arg ();
+            }
+        }
+
       else
         {
           arg_shifter.ignore_arg ();
@@ -220,6 +245,8 @@ TAO_ECG_Mcast_Gateway::init (const char * address_server_arg,
   this->nic_.set (ACE_TEXT_CHAR_TO_TCHAR(attr.nic.c_str ()));
   this->ip_multicast_loop_ = attr.ip_multicast_loop;
   this->non_blocking_ = attr.non_blocking;
+  this->mtu_ = attr.mtu;
+  this->batch_interval_ = attr.batch_interval;
 
   return this->validate_configuration ();
 }
@@ -276,6 +303,15 @@ TAO_ECG_Mcast_Gateway::validate_configuration ()
       return -1;
     }
 
+  if (this->mtu_ != 0
+      && (this->mtu_ < TAO_ECG_CDR_Message_Sender::ECG_MIN_MTU
+          || this->mtu_ >= TAO_ECG_CDR_Message_Sender::ECG_MAX_MTU))
+    {
+      ORBSVCS_DEBUG ((LM_ERROR,
+                  "MTU option value is out of range.\n"));
+      return -1;
+    }
+
   return 0;
 }
 
@@ -483,7 +519,8 @@ PortableServer::Servant_var<TAO_ECG_UDP_Sender>
 TAO_ECG_Mcast_Gateway::init_sender (
                                RtecEventChannelAdmin::EventChannel_ptr ec,
                                RtecUDPAdmin::AddrServer_ptr address_server,
-                               TAO_ECG_Refcounted_Endpoint endpoint_rptr)
+                               TAO_ECG_Refcounted_Endpoint endpoint_rptr,
+                               ACE_Reactor * reactor)
 {
   PortableServer::Servant_var<TAO_ECG_UDP_Sender>
     sender (TAO_ECG_UDP_Sender::create ());
@@ -497,6 +534,26 @@ TAO_ECG_Mcast_Gateway::init_sender (
   TAO_EC_Auto_Command<UDP_Sender_Shutdown> sender_shutdown;
   sender_shutdown.set_command (UDP_Sender_Shutdown (sender));
 
+  if (this->mtu_ != 0
+      && sender->mtu (this->mtu_) == -1)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                  "Error setting the MTU of the mcast sender.\n"));
+      throw CORBA::INTERNAL ();
+    }
+
+  if (this->batch_interval_ != 0)
+    {
+      ACE_Time_Value const flush_interval (
+        0, static_cast<suseconds_t> (this->batch_interval_));
+      if (sender->batching (flush_interval, reactor) == -1)
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                      "Error enabling batching in the mcast sender.\n"));
+          throw CORBA::INTERNAL ();
+        }
+    }
+
   if (this->consumer_qos_.dependencies.length () > 0)
     {
       // Client supplied consumer qos.  Use it.
@@ -621,7 +678,8 @@ TAO_ECG_Mcast_Gateway::run (CORBA::ORB_ptr orb,
 
       sender = this->init_sender (ec,
                                   address_server.in (),
-                                  endpoint_rptr);
+                                  endpoint_rptr,
+                                  orb->orb_core ()->reactor ());
       if (!sender.in ())
         {
           throw CORBA::INTERNAL ();
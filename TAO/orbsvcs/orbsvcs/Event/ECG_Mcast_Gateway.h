@@ -112,6 +112,19 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  *  NOTE: Certain device drivers block the process if the physical
  *        link fails.
  *
+ * -ECGMTU <mtu>
+ *  Valid values: a number between 40 and 65535
+ *  Maximum size of the datagrams sent by the gateway, larger events
+ *  are fragmented.  This option matters only if the gateway is
+ *  acting as a sender of mcast messages.
+ *
+ * -ECGBatchInterval <usecs>
+ *  Valid values: a number >= 0
+ *  If non-zero, the sender packs as many events as fit in one
+ *  datagram (see -ECGMTU) and sends partially filled datagrams every
+ *  <usecs> microseconds.  Receivers always accept batched datagrams.
+ *  The default (0) sends each event in its own datagram.
+ *
  * 2) Create an instance of TAO_ECG_Mcast_Gateway in your code, on the stack or
  *    dynamically, and use init () method to configure it.  No
  *    configuration files involved.  See service config options above for the
@@ -191,6 +204,8 @@ public:
     ACE_CString nic;
     int ip_multicast_loop;
     int non_blocking;
+    CORBA::ULong mtu;
+    u_long batch_interval;
   };
 
   /// Configure TAO_ECG_Mcast_Gateway programatically.  This method should
@@ -238,7 +253,8 @@ private:
   PortableServer::Servant_var<TAO_ECG_UDP_Sender>
         init_sender (RtecEventChannelAdmin::EventChannel_ptr ec,
                      RtecUDPAdmin::AddrServer_ptr address_server,
-                     TAO_ECG_Refcounted_Endpoint endpoint_rptr);
+                     TAO_ECG_Refcounted_Endpoint endpoint_rptr,
+                     ACE_Reactor * reactor);
 
   PortableServer::Servant_var<TAO_ECG_UDP_Receiver>
         init_receiver (RtecEventChannelAdmin::EventChannel_ptr ec,
@@ -263,6 +279,8 @@ private:
   ACE_TString nic_;
   int ip_multicast_loop_;
   int non_blocking_;
+  CORBA::ULong mtu_;
+  u_long batch_interval_;
 
   RtecEventChannelAdmin::ConsumerQOS consumer_qos_;
   //@}
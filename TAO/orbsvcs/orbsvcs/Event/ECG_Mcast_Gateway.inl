@@ -11,6 +11,8 @@ TAO_ECG_Mcast_Gateway::TAO_ECG_Mcast_Gateway (void)
   , nic_ (static_cast<const ACE_TCHAR *> (TAO_ECG_DEFAULT_NIC))
   , ip_multicast_loop_ (TAO_ECG_DEFAULT_IP_MULTICAST_LOOP)
   , non_blocking_ (TAO_ECG_DEFAULT_NON_BLOCKING)
+  , mtu_ (TAO_ECG_DEFAULT_MTU)
+  , batch_interval_ (TAO_ECG_DEFAULT_BATCH_INTERVAL)
   , consumer_qos_ ()
 {
   this->consumer_qos_.dependencies.length (0);
@@ -25,6 +27,8 @@ TAO_ECG_Mcast_Gateway::Attributes::Attributes (void)
   , nic (static_cast<const char *> (TAO_ECG_DEFAULT_NIC))
   , ip_multicast_loop (TAO_ECG_DEFAULT_IP_MULTICAST_LOOP)
   , non_blocking (TAO_ECG_DEFAULT_NON_BLOCKING)
+  , mtu (TAO_ECG_DEFAULT_MTU)
+  , batch_interval (TAO_ECG_DEFAULT_BATCH_INTERVAL)
 {
 }
 
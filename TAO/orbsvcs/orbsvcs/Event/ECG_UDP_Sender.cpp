@@ -10,6 +10,7 @@
 #include "orbsvcs/Event/ECG_UDP_Sender.h"
 #include "orbsvcs/Event_Utilities.h"
 #include "tao/CDR.h"
+#include "ace/Reactor.h"
 
 #if !defined(__ACE_INLINE__)
 #include "orbsvcs/Event/ECG_UDP_Sender.inl"
@@ -151,9 +152,61 @@ TAO_ECG_UDP_Sender::shutdown ()
   this->lcl_ec_ = RtecEventChannelAdmin::EventChannel::_nil ();
 
   this->deactivator_.deactivate ();
+
+  if (this->timer_id_ != -1)
+    {
+      this->reactor_->cancel_timer (this->timer_id_);
+      this->timer_id_ = -1;
+    }
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
   this->cdr_sender_.shutdown ();
 }
 
+int
+TAO_ECG_UDP_Sender::batching (const ACE_Time_Value &flush_interval,
+                              ACE_Reactor *reactor)
+{
+  if (this->timer_id_ != -1)
+    {
+      this->reactor_->cancel_timer (this->timer_id_);
+      this->timer_id_ = -1;
+    }
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+
+  if (flush_interval == ACE_Time_Value::zero)
+    {
+      this->cdr_sender_.batching (false);
+      return 0;
+    }
+
+  if (reactor == nullptr)
+    {
+      ORBSVCS_ERROR ((LM_ERROR, "TAO_ECG_UDP_Sender::batching(): "
+                            "nil reactor argument.\n"));
+      return -1;
+    }
+
+  this->reactor_ = reactor;
+  this->timer_id_ = this->reactor_->schedule_timer (&this->flush_adapter_,
+                                                    nullptr,
+                                                    flush_interval,
+                                                    flush_interval);
+  if (this->timer_id_ == -1)
+    return -1;
+
+  this->cdr_sender_.batching (true);
+  return 0;
+}
+
+void
+TAO_ECG_UDP_Sender::flush ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->cdr_sender_.flush ();
+}
+
 void
 TAO_ECG_UDP_Sender::push (const RtecEventComm::EventSet &events)
 {
@@ -165,9 +218,9 @@ TAO_ECG_UDP_Sender::push (const RtecEventComm::EventSet &events)
       return;
     }
 
-  // Send each event in a separate message.
-  // @@ TODO It is interesting to group events destined to the
-  // same mcast group in a single message.
+  // Send each event in a separate message, when batching is enabled
+  // the cdr sender packs consecutive messages for the same mcast
+  // group in a single datagram.
   for (u_int i = 0; i < events.length (); ++i)
     {
       // To avoid loops we keep a TTL field on the events and skip the
@@ -225,8 +278,33 @@ TAO_ECG_UDP_Sender::push (const RtecEventComm::EventSet &events)
           inet_addr.set (udp_addr.port, udp_addr.ipaddr);
         }
 
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
       this->cdr_sender_.send_message (cdr, inet_addr);
     }
 }
 
+// ****************************************************************
+
+TAO_ECG_UDP_Sender_Flush_Adapter::TAO_ECG_UDP_Sender_Flush_Adapter (
+      TAO_ECG_UDP_Sender *adaptee)
+  :  adaptee_ (adaptee)
+{
+}
+
+int
+TAO_ECG_UDP_Sender_Flush_Adapter::handle_timeout (
+      const ACE_Time_Value &,
+      const void *)
+{
+  try
+    {
+      this->adaptee_->flush ();
+    }
+  catch (const CORBA::Exception&)
+    {
+      // Ignore all exceptions, the events are lost.
+    }
+  return 0;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
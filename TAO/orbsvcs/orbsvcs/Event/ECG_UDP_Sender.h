@@ -49,13 +49,41 @@
 #include "orbsvcs/Event/EC_Lifetime_Utils_T.h"
 #include "orbsvcs/Event/ECG_CDR_Message_Sender.h"
 
+#include "ace/Event_Handler.h"
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_SOCK_Dgram;
+class ACE_Reactor;
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_ECG_UDP_Out_Endpoint;
+class TAO_ECG_UDP_Sender;
+
+/**
+ * @class TAO_ECG_UDP_Sender_Flush_Adapter
+ *
+ * @brief Forwards timeout events to the UDP Sender.
+ *
+ * When batching is enabled the sender uses the reactor to
+ * periodically send any partially filled batch of events.
+ */
+class TAO_RTEvent_Serv_Export TAO_ECG_UDP_Sender_Flush_Adapter
+  : public ACE_Event_Handler
+{
+public:
+  /// Constructor
+  TAO_ECG_UDP_Sender_Flush_Adapter (TAO_ECG_UDP_Sender *adaptee);
+
+  // = Documented in ACE_Event_Handler.
+  virtual int handle_timeout (const ACE_Time_Value &tv,
+                              const void *arg = 0);
+
+private:
+  /// The adapted object
+  TAO_ECG_UDP_Sender *adaptee_;
+};
 
 /**
  * @class TAO_ECG_UDP_Sender_Disconnect_Command
@@ -164,6 +192,25 @@ public:
 
   /// Get the local endpoint used to send the events.
   int get_local_addr (ACE_INET_Addr& addr);
+
+  /**
+   * Pack several events in each datagram.  Events are sent when a
+   * datagram fills up, and a timer scheduled with @a reactor sends
+   * any partially filled datagram every @a flush_interval.
+   * A zero @a flush_interval disables batching.
+   * Returns -1 if the timer cannot be scheduled.
+   */
+  int batching (const ACE_Time_Value &flush_interval,
+                ACE_Reactor *reactor);
+
+  /// Send the events waiting in the current batch, if any.
+  void flush ();
+
+  /// Number of events and datagrams sent so far.
+  //@{
+  CORBA::ULongLong event_count () const;
+  CORBA::ULongLong datagram_count () const;
+  //@}
   //@}
 
   /// The PushConsumer methods.
@@ -203,6 +250,19 @@ private:
   /// Helper for fragmenting and sending cdr-encoded events using udp.
   TAO_ECG_CDR_Message_Sender cdr_sender_;
 
+  /// Serializes access to <cdr_sender_> when batching is enabled,
+  /// the batch is flushed from the reactor thread.
+  TAO_SYNCH_MUTEX lock_;
+
+  /// The Adapter for the flush timer.
+  TAO_ECG_UDP_Sender_Flush_Adapter flush_adapter_;
+
+  /// The reactor used for the flush timer.
+  ACE_Reactor *reactor_;
+
+  /// The flush timer id, -1 if no timer is scheduled.
+  long timer_id_;
+
   typedef TAO_EC_Auto_Command<TAO_ECG_UDP_Sender_Disconnect_Command>
   ECG_Sender_Auto_Proxy_Disconnect;
   /// Manages our connection to Supplier Proxy.
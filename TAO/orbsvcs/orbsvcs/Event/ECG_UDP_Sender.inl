@@ -19,6 +19,9 @@ TAO_ECG_UDP_Sender::TAO_ECG_UDP_Sender (CORBA::Boolean crc)
   , lcl_ec_ ()
   , addr_server_ ()
   , cdr_sender_ (crc)
+  , flush_adapter_ (this)
+  , reactor_ (nullptr)
+  , timer_id_ (-1)
   , auto_proxy_disconnect_ ()
 {
 }
@@ -40,6 +43,18 @@ TAO_ECG_UDP_Sender::get_local_addr (ACE_INET_Addr& addr)
 {
   return this->cdr_sender_.get_local_addr (addr);
 }
+
+ACE_INLINE CORBA::ULongLong
+TAO_ECG_UDP_Sender::event_count () const
+{
+  return this->cdr_sender_.message_count ();
+}
+
+ACE_INLINE CORBA::ULongLong
+TAO_ECG_UDP_Sender::datagram_count () const
+{
+  return this->cdr_sender_.datagram_count ();
+}
 //***************************************************************************
 
 ACE_INLINE
@@ -424,7 +424,7 @@ int
 TAO_FT_Naming_Server::parse_args (int argc,
                                   ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:c:do:p:s:f:m:z:r:u:v:g:h:l:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:c:do:p:s:f:m:z:r:u:j:v:g:h:l:"));
 
   // Define the arguments for primary and backup
   get_opts.long_option (ACE_TEXT ("primary"), ACE_Get_Opt::NO_ARG);
@@ -518,6 +518,11 @@ TAO_FT_Naming_Server::parse_args (int argc,
         this->persistence_dir_ = get_opts.opt_arg ();
         u_opt_used = 1;
         break;
+      case 'j':
+        size = ACE_OS::atoi (get_opts.opt_arg ());
+        if (size >= 0)
+          this->journal_size_ = size;
+        break;
       case 'v':
         this->use_object_group_persistence_ = 1;
         this->object_group_dir_ = get_opts.opt_arg ();
@@ -586,6 +591,7 @@ TAO_FT_Naming_Server::parse_args (int argc,
                            ACE_TEXT ("-v <storable_object_group_persistence")
                            ACE_TEXT ("_directory>\n")
                            ACE_TEXT ("-r <redundant_persistence_directory>\n")
+                           ACE_TEXT ("-j <storable_journal_size>\n")
                            ACE_TEXT ("-z <relative round trip timeout>\n")
                            ACE_TEXT ("\n"),
                            argv [0]),
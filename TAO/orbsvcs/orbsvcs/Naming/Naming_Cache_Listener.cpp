@@ -0,0 +1,17 @@
+#include "orbsvcs/Naming/Naming_Cache_Listener.h"
+#include "orbsvcs/Naming/Naming_Client.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Cache_Listener::TAO_Naming_Cache_Listener (TAO_Naming_Client &client)
+  : client_ (client)
+{
+}
+
+void
+TAO_Naming_Cache_Listener::invalidate (const CosNaming::NameComponent &n)
+{
+  this->client_.invalidate (n);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
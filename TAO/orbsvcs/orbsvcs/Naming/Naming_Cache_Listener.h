@@ -0,0 +1,57 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Naming_Cache_Listener.h
+ *
+ *  Servant that feeds Naming Service invalidations into the resolve
+ *  cache of a TAO_Naming_Client.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_CACHE_LISTENER_H
+#define TAO_NAMING_CACHE_LISTENER_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Naming_CacheS.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Naming/naming_skel_export.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Naming_Client;
+
+/**
+ * @class TAO_Naming_Cache_Listener
+ *
+ * @brief Drops the cached resolutions of a TAO_Naming_Client when the
+ * Naming Service reports a binding as replaced or removed.
+ *
+ * Activate the listener in a POA of the client process and pass the
+ * resulting reference to NamingCache::Notifier::subscribe.  The
+ * TAO_Naming_Client must outlive the listener.
+ */
+class TAO_Naming_Skel_Export TAO_Naming_Cache_Listener
+  : public virtual POA_NamingCache::Listener
+{
+public:
+  /// Constructor.
+  TAO_Naming_Cache_Listener (TAO_Naming_Client &client);
+
+  /// Forwards to TAO_Naming_Client::invalidate.
+  virtual void invalidate (const CosNaming::NameComponent &n);
+
+private:
+  TAO_Naming_Client &client_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_NAMING_CACHE_LISTENER_H */
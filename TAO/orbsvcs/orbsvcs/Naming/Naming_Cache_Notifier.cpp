@@ -0,0 +1,91 @@
+#include "orbsvcs/Naming/Naming_Cache_Notifier.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/debug.h"
+#include "ace/Guard_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Cache_Notifier::TAO_Naming_Cache_Notifier ()
+{
+}
+
+TAO_Naming_Cache_Notifier::~TAO_Naming_Cache_Notifier ()
+{
+}
+
+void
+TAO_Naming_Cache_Notifier::subscribe (NamingCache::Listener_ptr l)
+{
+  if (CORBA::is_nil (l))
+    throw CORBA::BAD_PARAM ();
+
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, guard, this->lock_,
+                      CORBA::INTERNAL ());
+  this->listeners_.push_back (NamingCache::Listener::_duplicate (l));
+}
+
+void
+TAO_Naming_Cache_Notifier::unsubscribe (NamingCache::Listener_ptr l)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, guard, this->lock_,
+                      CORBA::INTERNAL ());
+  for (size_t i = 0; i != this->listeners_.size (); ++i)
+    {
+      if (this->listeners_[i]->_is_equivalent (l))
+        {
+          this->remove_i (i);
+          return;
+        }
+    }
+}
+
+void
+TAO_Naming_Cache_Notifier::notify (const CosNaming::NameComponent &n)
+{
+  // Push outside of the lock, a slow listener must not hold up
+  // subscriptions.
+  Listeners listeners;
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+    if (this->listeners_.size () == 0)
+      return;
+    listeners = this->listeners_;
+  }
+
+  for (size_t i = 0; i != listeners.size (); ++i)
+    {
+      try
+        {
+          listeners[i]->invalidate (n);
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          if (TAO_debug_level > 0)
+            ex._tao_print_exception (
+              "TAO_Naming_Cache_Notifier::notify, dropping listener");
+
+          ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+          for (size_t j = 0; j != this->listeners_.size (); ++j)
+            {
+              if (this->listeners_[j].in () == listeners[i].in ())
+                {
+                  this->remove_i (j);
+                  break;
+                }
+            }
+        }
+    }
+}
+
+void
+TAO_Naming_Cache_Notifier::remove_i (size_t index)
+{
+  size_t const last = this->listeners_.size () - 1;
+  if (index != last)
+    this->listeners_[index] = this->listeners_[last];
+  // pop_back() does not destroy the element, release it here.
+  this->listeners_[last] = NamingCache::Listener::_nil ();
+  this->listeners_.pop_back ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,69 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Naming_Cache_Notifier.h
+ *
+ *  Server side of the invalidation channel for client resolve caches.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_CACHE_NOTIFIER_H
+#define TAO_NAMING_CACHE_NOTIFIER_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Naming_CacheS.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Naming/naming_serv_export.h"
+#include "ace/Vector_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Naming_Cache_Notifier
+ *
+ * @brief Pushes NamingCache::Listener::invalidate to the subscribed
+ * clients whenever a naming context replaces or removes a binding.
+ *
+ * The naming contexts find the notifier through
+ * TAO_Naming_Context::cache_notifier.  Listeners that cannot be
+ * reached are unsubscribed.
+ */
+class TAO_Naming_Serv_Export TAO_Naming_Cache_Notifier
+  : public virtual POA_NamingCache::Notifier
+{
+public:
+  /// Constructor.
+  TAO_Naming_Cache_Notifier (void);
+
+  /// Destructor.
+  ~TAO_Naming_Cache_Notifier (void);
+
+  // = NamingCache::Notifier idl interface methods.
+  virtual void subscribe (NamingCache::Listener_ptr l);
+  virtual void unsubscribe (NamingCache::Listener_ptr l);
+
+  /// Tell every listener that the binding of @a n has changed.
+  void notify (const CosNaming::NameComponent &n);
+
+private:
+  typedef ACE_Vector<NamingCache::Listener_var> Listeners;
+
+  /// Remove the listener at @a index, the lock must be held.
+  void remove_i (size_t index);
+
+  Listeners listeners_;
+
+  TAO_SYNCH_MUTEX lock_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_NAMING_CACHE_NOTIFIER_H */
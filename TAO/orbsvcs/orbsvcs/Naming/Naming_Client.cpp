@@ -1,9 +1,27 @@
 #include "orbsvcs/Naming/Naming_Client.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Log_Macros.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// Append @a s to @a key, escaping the INS separators.
+  void
+  append_escaped (ACE_CString &key, const char *s)
+  {
+    for (; *s != '\0'; ++s)
+      {
+        if (*s == '/' || *s == '.' || *s == '\\')
+          key += '\\';
+        key += *s;
+      }
+  }
+}
+
 CosNaming::NamingContext_ptr
 TAO_Naming_Client::operator -> () const
 {
@@ -41,9 +59,145 @@ TAO_Naming_Client::init (CORBA::ORB_ptr orb, ACE_Time_Value *timeout)
   return 0;
 }
 
+void
+TAO_Naming_Client::cache (const ACE_Time_Value &ttl, size_t max_entries)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+  this->cache_ttl_ = max_entries == 0 ? ACE_Time_Value::zero : ttl;
+  this->cache_max_ = max_entries;
+  if (this->cache_ttl_ == ACE_Time_Value::zero)
+    {
+      ++this->generation_;
+      this->cache_.unbind_all ();
+    }
+}
+
+CORBA::Object_ptr
+TAO_Naming_Client::resolve (const CosNaming::Name &n)
+{
+  ACE_CString key;
+  unsigned long generation = 0;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_,
+                      CORBA::Object::_nil ());
+    if (this->cache_ttl_ == ACE_Time_Value::zero)
+      {
+        guard.release ();
+        return this->naming_context_->resolve (n);
+      }
+
+    TAO_Naming_Client::cache_key (n, key);
+    Cache::ENTRY *entry = 0;
+    if (this->cache_.find (key, entry) == 0)
+      {
+        if (ACE_OS::gettimeofday () < entry->int_id_.expiry_)
+          return CORBA::Object::_duplicate (entry->int_id_.ref_.in ());
+        this->cache_.unbind (entry);
+      }
+    generation = this->generation_;
+  }
+
+  // Do not hold the lock across the remote call, other threads may
+  // use the cache meanwhile.
+  CORBA::Object_var obj = this->naming_context_->resolve (n);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, obj._retn ());
+  if (generation != this->generation_
+      || this->cache_ttl_ == ACE_Time_Value::zero)
+    return obj._retn ();
+
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  if (this->cache_.current_size () >= this->cache_max_)
+    {
+      this->purge_i (now);
+      if (this->cache_.current_size () >= this->cache_max_)
+        this->cache_.unbind_all ();
+    }
+
+  Cache_Entry value;
+  value.ref_ = CORBA::Object::_duplicate (obj.in ());
+  value.name_ = n;
+  value.expiry_ = now + this->cache_ttl_;
+  this->cache_.rebind (key, value);
+
+  return obj._retn ();
+}
+
+void
+TAO_Naming_Client::invalidate (const CosNaming::NameComponent &n)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+  ++this->generation_;
+
+  Cache::ITERATOR end = this->cache_.end ();
+  for (Cache::ITERATOR i = this->cache_.begin (); i != end; )
+    {
+      Cache::ENTRY &entry = *i;
+      // Step past the entry before it may be unbound.
+      ++i;
+
+      const CosNaming::Name &name = entry.int_id_.name_;
+      for (CORBA::ULong c = 0; c != name.length (); ++c)
+        {
+          if (ACE_OS::strcmp (name[c].id.in (), n.id.in ()) == 0
+              && ACE_OS::strcmp (name[c].kind.in (), n.kind.in ()) == 0)
+            {
+              this->cache_.unbind (&entry);
+              break;
+            }
+        }
+    }
+}
+
+void
+TAO_Naming_Client::invalidate (const CosNaming::Name &n)
+{
+  ACE_CString key;
+  TAO_Naming_Client::cache_key (n, key);
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+  ++this->generation_;
+  this->cache_.unbind (key);
+}
+
+void
+TAO_Naming_Client::invalidate_all ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+  ++this->generation_;
+  this->cache_.unbind_all ();
+}
+
+void
+TAO_Naming_Client::cache_key (const CosNaming::Name &n, ACE_CString &key)
+{
+  for (CORBA::ULong c = 0; c != n.length (); ++c)
+    {
+      if (c != 0)
+        key += '/';
+      append_escaped (key, n[c].id.in ());
+      key += '.';
+      append_escaped (key, n[c].kind.in ());
+    }
+}
+
+void
+TAO_Naming_Client::purge_i (const ACE_Time_Value &now)
+{
+  Cache::ITERATOR end = this->cache_.end ();
+  for (Cache::ITERATOR i = this->cache_.begin (); i != end; )
+    {
+      Cache::ENTRY &entry = *i;
+      ++i;
+      if (!(now < entry.int_id_.expiry_))
+        this->cache_.unbind (&entry);
+    }
+}
+
 TAO_Naming_Client::TAO_Naming_Client ()
+  : cache_max_ (ACE_DEFAULT_MAP_SIZE),
+    generation_ (0)
 {
-  // Do nothing
 }
 
 TAO_Naming_Client::~TAO_Naming_Client ()
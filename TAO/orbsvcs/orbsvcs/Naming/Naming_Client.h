@@ -20,6 +20,11 @@
 #include "tao/ORB.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Naming/naming_export.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Functor_String.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/Time_Value.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -34,6 +39,12 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  * <resolve>, etc. can be directly called on a
  * <TAO_Naming_Client> object, and will be forwarded to the root
  * Naming Context.
+ *
+ * Optionally the wrapper keeps the references returned by its own
+ * <resolve> for a limited time, see <cache>.  Entries are dropped
+ * when they expire or when the Naming Service reports, through a
+ * TAO_Naming_Cache_Listener, that a binding they depend upon was
+ * replaced or removed.
  */
 class TAO_Naming_Export TAO_Naming_Client
 {
@@ -61,9 +72,66 @@ public:
    */
   CosNaming::NamingContext_ptr get_context () const;
 
+  /**
+   * Keep the references returned by <resolve> for @a ttl, holding
+   * at most @a max_entries of them.  A zero @a ttl, the default,
+   * or a zero @a max_entries disables the cache and empties it.
+   */
+  void cache (const ACE_Time_Value &ttl,
+              size_t max_entries = ACE_DEFAULT_MAP_SIZE);
+
+  /**
+   * Resolve @a n relative to the root Naming Context.  If the cache
+   * is enabled and holds an unexpired reference for @a n that
+   * reference is returned without contacting the Naming Service.
+   */
+  CORBA::Object_ptr resolve (const CosNaming::Name &n);
+
+  /// Drop every cached name that contains the component @a n.
+  void invalidate (const CosNaming::NameComponent &n);
+
+  /// Drop the cached reference for @a n.
+  void invalidate (const CosNaming::Name &n);
+
+  /// Empty the cache.
+  void invalidate_all ();
+
 protected:
   /// Reference to the root Naming Context.
   CosNaming::NamingContext_var naming_context_;
+
+private:
+  struct Cache_Entry
+  {
+    CORBA::Object_var ref_;
+    CosNaming::Name name_;
+    ACE_Time_Value expiry_;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                  Cache_Entry,
+                                  ACE_Hash<ACE_CString>,
+                                  ACE_Equal_To<ACE_CString>,
+                                  ACE_Null_Mutex> Cache;
+
+  /// Stringify @a n into @a key, escaping as in the INS syntax.
+  static void cache_key (const CosNaming::Name &n, ACE_CString &key);
+
+  /// Remove the entries that expired before @a now.
+  void purge_i (const ACE_Time_Value &now);
+
+  Cache cache_;
+
+  /// How long a resolved reference is kept, zero when not caching.
+  ACE_Time_Value cache_ttl_;
+
+  size_t cache_max_;
+
+  /// Bumped by every invalidation so that a resolve racing with an
+  /// invalidation does not put back the reference just dropped.
+  unsigned long generation_;
+
+  TAO_SYNCH_MUTEX lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -7,12 +7,15 @@
 //=============================================================================
 
 #include "orbsvcs/Naming/Naming_Context_Interface.h"
+#include "orbsvcs/Naming/Naming_Cache_Notifier.h"
 #include "ace/ACE.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_ctype.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+TAO_Naming_Cache_Notifier *TAO_Naming_Context::cache_notifier_ = 0;
+
 TAO_Naming_Context::TAO_Naming_Context (TAO_Naming_Context_Impl *impl)
   : impl_ (impl)
 {
@@ -39,6 +42,7 @@ void
 TAO_Naming_Context::rebind (const CosNaming::Name &n, CORBA::Object_ptr obj)
 {
   impl_->rebind (n, obj);
+  this->notify_cache (n);
 }
 
 void
@@ -53,6 +57,7 @@ TAO_Naming_Context::rebind_context (const CosNaming::Name &n,
                                     CosNaming::NamingContext_ptr nc)
 {
   impl_->rebind_context (n, nc);
+  this->notify_cache (n);
 }
 
 CORBA::Object_ptr
@@ -65,6 +70,7 @@ void
 TAO_Naming_Context::unbind (const CosNaming::Name &n)
 {
   impl_->unbind (n);
+  this->notify_cache (n);
 }
 
 CosNaming::NamingContext_ptr
@@ -463,6 +469,27 @@ TAO_Naming_Context::stale (bool value)
   this->impl_->stale (value);
 }
 
+void
+TAO_Naming_Context::cache_notifier (TAO_Naming_Cache_Notifier *notifier)
+{
+  cache_notifier_ = notifier;
+}
+
+TAO_Naming_Cache_Notifier *
+TAO_Naming_Context::cache_notifier ()
+{
+  return cache_notifier_;
+}
+
+void
+TAO_Naming_Context::notify_cache (const CosNaming::Name &n)
+{
+  // A compound name is forwarded as a simple name to the context
+  // holding the binding, which then sends the notification.
+  if (cache_notifier_ != 0 && n.length () == 1)
+    cache_notifier_->notify (n[0]);
+}
+
 TAO_Naming_Context_Impl::~TAO_Naming_Context_Impl ()
 {
 }
@@ -21,6 +21,7 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Naming_Context_Impl;
+class TAO_Naming_Cache_Notifier;
 
 // This is to remove "inherits via dominance" warnings from MSVC.
 #if defined (_MSC_VER)
@@ -182,7 +183,24 @@ public:
   /// Returns the Default POA of this Servant object
   virtual PortableServer::POA_ptr _default_POA (void);
 
+  /**
+   * Install the notifier that is told about every rebind,
+   * rebind_context and unbind made through the contexts of this
+   * process.  Passing 0 stops the notifications.
+   */
+  static void cache_notifier (TAO_Naming_Cache_Notifier *notifier);
+
+  /// Returns the installed notifier, or 0.
+  static TAO_Naming_Cache_Notifier *cache_notifier (void);
+
 private:
+  /// Tell the cache notifier, if any, that the binding of @a n has
+  /// changed.
+  void notify_cache (const CosNaming::Name &n);
+
+  /// See cache_notifier().
+  static TAO_Naming_Cache_Notifier *cache_notifier_;
+
   enum Hint
     {
       HINT_ID,
@@ -11,6 +11,7 @@
 #include "orbsvcs/Naming/Transient_Naming_Context.h"
 #include "orbsvcs/Naming/Persistent_Naming_Context_Factory.h"
 #include "orbsvcs/Naming/Storable_Naming_Context_Factory.h"
+#include "orbsvcs/Naming/Naming_Cache_Notifier.h"
 
 #if !defined (CORBA_E_MICRO)
 #include "orbsvcs/Naming/Persistent_Context_Index.h"
@@ -41,6 +42,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_Naming_Server::TAO_Naming_Server (size_t bsize)
   : ior_multicast_ (0),
     pid_file_name_ (0),
+    cache_notifier_file_name_ (0),
+    cache_notifier_ (0),
     iors_ (0),
     bundle_size_ (bsize),
     context_size_ (ACE_DEFAULT_MAP_SIZE),
@@ -52,6 +55,7 @@ TAO_Naming_Server::TAO_Naming_Server (size_t bsize)
     use_storable_context_ (0),
     use_servant_activator_ (false),
     servant_activator_ (0),
+    journal_size_ (0),
 #endif /* CORBA_E_MICRO */
     use_redundancy_(0),
     round_trip_timeout_ (0),
@@ -74,6 +78,8 @@ TAO_Naming_Server::TAO_Naming_Server (CORBA::ORB_ptr orb,
                                       size_t bsize)
   : ior_multicast_ (0),
     pid_file_name_ (0),
+    cache_notifier_file_name_ (0),
+    cache_notifier_ (0),
     iors_ (0),
     bundle_size_ (bsize),
     context_size_ (ACE_DEFAULT_MAP_SIZE),
@@ -85,6 +91,7 @@ TAO_Naming_Server::TAO_Naming_Server (CORBA::ORB_ptr orb,
     use_storable_context_ (use_storable_context),
     use_servant_activator_ (false),
     servant_activator_ (0),
+    journal_size_ (0),
 #endif /* CORBA_E_MICRO */
     use_redundancy_(0),
     round_trip_timeout_ (0),
@@ -177,9 +184,9 @@ TAO_Naming_Server::parse_args (int argc,
                                ACE_TCHAR *argv[])
 {
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_COMPACT)
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:u:r:z:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:di:o:p:s:f:m:u:r:j:z:"));
 #else
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:z:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:di:o:p:s:f:m:z:"));
 #endif /* TAO_HAS_MINIMUM_POA */
 
   int c;
@@ -214,6 +221,9 @@ TAO_Naming_Server::parse_args (int argc,
       case 'p':
         this->pid_file_name_ = get_opts.opt_arg ();
         break;
+      case 'i': // outputs the cache notifier ior to a file.
+        this->cache_notifier_file_name_ = get_opts.opt_arg ();
+        break;
       case 's':
         size = ACE_OS::atoi (get_opts.opt_arg ());
         if (size >= 0)
@@ -253,6 +263,11 @@ TAO_Naming_Server::parse_args (int argc,
         this->persistence_dir_ = get_opts.opt_arg ();
         u_opt_used = 1;
         break;
+      case 'j':
+        size = ACE_OS::atoi (get_opts.opt_arg ());
+        if (size >= 0)
+          this->journal_size_ = size;
+        break;
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
 #endif /* !CORBA_E_MICRO */
       case 'z':
@@ -268,7 +283,8 @@ TAO_Naming_Server::parse_args (int argc,
 #endif /* CORBA_E_MICRO */
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_MICRO)
           ACE_TEXT ("-u <storable_persistence_directory (not used with -f)> ")
-          ACE_TEXT ("-r <redundant_persistence_directory> ");
+          ACE_TEXT ("-r <redundant_persistence_directory> ")
+          ACE_TEXT ("-j <storable_journal_size> ");
 #else
           ACE_TEXT ("");
 #endif /* TAO_HAS_MINIMUM_POA && !CORBA_E_MICRO */
@@ -277,6 +293,7 @@ TAO_Naming_Server::parse_args (int argc,
                            ACE_TEXT ("usage:  %s ")
                            ACE_TEXT ("-d ")
                            ACE_TEXT ("-o <ior_output_file> ")
+                           ACE_TEXT ("-i <cache_notifier_ior_file> ")
                            ACE_TEXT ("-p <pid_file_name> ")
                            ACE_TEXT ("-s <context_size> ")
                            ACE_TEXT ("-b <base_address> ")
@@ -437,6 +454,12 @@ TAO_Naming_Server::init_with_orb (int argc,
       return -1;
     }
 
+  if (this->cache_notifier_file_name_ != 0
+      && this->init_cache_notifier () != 0)
+    {
+      return -1;
+    }
+
   if (this->pid_file_name_ != 0)
     {
       FILE *pidf = ACE_OS::fopen (this->pid_file_name_, ACE_TEXT("w"));
@@ -533,7 +556,8 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
                                                   0,
                                                   contextFactory.get (),
                                                   persFactory.get (),
-                                                  use_redundancy_));
+                                                  use_redundancy_,
+                                                  journal_size_));
           }
           catch (const CORBA::Exception& ex)
           {
@@ -783,6 +807,9 @@ TAO_Naming_Server::fini ()
       this->ior_multicast_ = 0;
     }
 
+  // The notifier lives in the root POA, which the ns_poa may be.
+  this->fini_cache_notifier ();
+
   for (size_t i = 0; i < bundle_size_; i++ )
     {
       this->iors_[i].ref_ = CORBA::Object::_nil();
@@ -956,6 +983,66 @@ TAO_Naming_Server::write(size_t ndx) const
   return 0;
 }
 
+int
+TAO_Naming_Server::init_cache_notifier ()
+{
+  try
+    {
+      ACE_NEW_RETURN (this->cache_notifier_,
+                      TAO_Naming_Cache_Notifier,
+                      -1);
+
+      PortableServer::ObjectId_var id =
+        this->root_poa_->activate_object (this->cache_notifier_);
+      CORBA::Object_var obj = this->root_poa_->id_to_reference (id.in ());
+      CORBA::String_var ior = this->orb_->object_to_string (obj.in ());
+
+      FILE *iorf = ACE_OS::fopen (this->cache_notifier_file_name_,
+                                  ACE_TEXT("w"));
+      if (iorf == 0)
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT("Unable to open %s for writing:(%u) %p\n"),
+                               this->cache_notifier_file_name_,
+                               ACE_ERRNO_GET,
+                               ACE_TEXT("TAO_Naming_Server::init_cache_notifier")),
+                              -1);
+      ACE_OS::fprintf (iorf, "%s\n", ior.in ());
+      ACE_OS::fclose (iorf);
+
+      TAO_Naming_Context::cache_notifier (this->cache_notifier_);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("TAO_Naming_Server::init_cache_notifier");
+      return -1;
+    }
+
+  return 0;
+}
+
+void
+TAO_Naming_Server::fini_cache_notifier ()
+{
+  if (this->cache_notifier_ == 0)
+    return;
+
+  if (TAO_Naming_Context::cache_notifier () == this->cache_notifier_)
+    TAO_Naming_Context::cache_notifier (0);
+
+  try
+    {
+      PortableServer::ObjectId_var id =
+        this->root_poa_->servant_to_id (this->cache_notifier_);
+      this->root_poa_->deactivate_object (id.in ());
+    }
+  catch (const CORBA::Exception&)
+    {
+      // Ignore
+    }
+  this->cache_notifier_->_remove_ref ();
+  this->cache_notifier_ = 0;
+}
+
 void
 TAO_Naming_Server::assign (size_t ndx, bool take, CORBA::Object_ptr obj)
 {
@@ -33,6 +33,7 @@ class TAO_Storable_Naming_Context_Activator;
 
 class TAO_Storable_Naming_Context_Factory;
 class TAO_Persistent_Naming_Context_Factory;
+class TAO_Naming_Cache_Notifier;
 
 /**
  * @class TAO_Naming_Server
@@ -174,6 +175,14 @@ protected:
   /// parses the arguments.
   virtual int parse_args (int argc, ACE_TCHAR *argv[]);
 
+  /// Activate the resolve cache notifier, install it in the naming
+  /// contexts and write its IOR to <cache_notifier_file_name_>.
+  int init_cache_notifier (void);
+
+  /// Stop the notifications and deactivate the resolve cache
+  /// notifier, if any.
+  void fini_cache_notifier (void);
+
   /// Write the provided ior_string to the file. Return 0 if success.
   int write_ior_to_file (const char* ior_string,
                          const char* file_name);
@@ -205,6 +214,13 @@ protected:
   /// File to output the process id.
   const ACE_TCHAR *pid_file_name_;
 
+  /// File to output the IOR of the resolve cache notifier, no
+  /// notifier is created when 0.
+  const ACE_TCHAR *cache_notifier_file_name_;
+
+  /// Pushes binding changes to the clients caching resolutions.
+  TAO_Naming_Cache_Notifier *cache_notifier_;
+
   /// Although this class only manages the root context info
   /// the FT class adds primary/backup IORs for the root context
   /// as well as IORs for LB groups as well.
@@ -253,6 +269,10 @@ protected:
    * init_with_orb() and init_new_naming().
    */
   TAO_Storable_Naming_Context_Activator *servant_activator_;
+
+  /// Number of binding changes journaled per storable context before
+  /// the context file is rewritten.  Zero disables the journal.
+  ACE_UINT32 journal_size_;
 #endif /* !CORBA_E_MICRO */
 
   /**
@@ -18,6 +18,7 @@ const char * TAO_Storable_Naming_Context::root_name_;
 ACE_UINT32 TAO_Storable_Naming_Context::gcounter_;
 ACE_Auto_Ptr<TAO::Storable_Base> TAO_Storable_Naming_Context::gfl_;
 int TAO_Storable_Naming_Context::redundant_;
+ACE_UINT32 TAO_Storable_Naming_Context::journal_size_ = 0;
 
 TAO_Storable_IntId::TAO_Storable_IntId ()
   : ref_ (CORBA::string_dup ("")),
@@ -247,6 +248,84 @@ void TAO_Storable_Naming_Context::Write (TAO::Storable_Base& wrtr)
   ACE_TRACE("Write");
   TAO_Storable_Naming_Context_ReaderWriter rw(wrtr);
   rw.write(*this);
+
+  // The context file now holds every change recorded in the journal.
+  ACE_Auto_Ptr<TAO::Storable_Base>
+    jfl (this->factory_->create_stream (this->journal_name (), "r", false));
+  if (jfl.get () != 0 && jfl->exists ())
+    jfl->remove ();
+  this->journal_count_ = 0;
+}
+
+void
+TAO_Storable_Naming_Context::Write_Binding (File_Open_Lock_and_Check& flck,
+                                            const CosNaming::NameComponent& name)
+{
+  ACE_TRACE("Write_Binding");
+
+  // Time to compact?
+  if (this->journal_count_ >= journal_size_)
+    {
+      this->Write (flck.peer ());
+      return;
+    }
+
+  ACE_Auto_Ptr<TAO::Storable_Base>
+    jfl (this->factory_->create_stream (this->journal_name (), "wca", false));
+  if (jfl.get () == 0 || jfl->open () != 0)
+    throw CORBA::PERSIST_STORE ();
+
+  TAO_Storable_Naming_Context_ReaderWriter rw (*jfl);
+  rw.write_journal_entry (*this,
+                          this->journal_count_ + 1,
+                          name.id.in (),
+                          name.kind.in ());
+  ++this->journal_count_;
+
+  // Redundant servers expect the change on disk before the context
+  // file lock is released, as for a rewrite of the context file.
+  if (redundant_)
+    jfl->sync ();
+
+  // The context file itself is untouched; don't copy it to the backup.
+  flck.unmodified ();
+}
+
+ACE_CString
+TAO_Storable_Naming_Context::journal_name () const
+{
+  return this->context_name_ + ".journal";
+}
+
+void
+TAO_Storable_Naming_Context::load_journal ()
+{
+  ACE_TRACE("load_journal");
+  this->journal_count_ = 0;
+
+  ACE_Auto_Ptr<TAO::Storable_Base>
+    jfl (this->factory_->create_stream (this->journal_name (), "r", false));
+  if (jfl.get () == 0 || !jfl->exists ())
+    return;
+
+  if (jfl->open () != 0)
+    throw CORBA::PERSIST_STORE ();
+
+  TAO_Storable_Naming_Context_ReaderWriter rw (*jfl);
+  int const entries = rw.read_journal (*this);
+  if (entries < 0)
+    {
+      // Keep what could be replayed and compact on the next change so
+      // that nothing is ever appended after the damaged entry.
+      if (TAO_debug_level > 0)
+        ORBSVCS_DEBUG ((LM_DEBUG,
+                        ACE_TEXT ("(%P|%t) NameService: journal %C ends ")
+                        ACE_TEXT ("with an incomplete entry\n"),
+                        this->journal_name ().c_str ()));
+      this->journal_count_ = journal_size_;
+    }
+  else
+    this->journal_count_ = static_cast<ACE_UINT32> (entries);
 }
 
 // Helpers function to load a new context into the binding_map
@@ -255,7 +334,10 @@ TAO_Storable_Naming_Context::load_map (TAO::Storable_Base& storable)
 {
   ACE_TRACE("load_map");
   TAO_Storable_Naming_Context_ReaderWriter rw (storable);
-  return rw.read (*this);
+  int const result = rw.read (*this);
+  if (result == 0)
+    this->load_journal ();
+  return result;
 }
 
 TAO_Storable_Naming_Context::
@@ -310,7 +392,7 @@ File_Open_Lock_and_Check::object_obsolete ()
 
   // Query the underlying context if it is obsolete with respect
   // to the provided file last-changed time
-  return (context_->is_obsolete (fl_->last_changed ()));
+  return (context_->is_obsolete (this->last_changed ()));
 }
 
 void
@@ -320,7 +402,31 @@ File_Open_Lock_and_Check::mark_object_current ()
   // Reset the stale flag
   context_->stale (false);
   // Set the last update time to the file last update time
-  this->set_object_last_changed (fl_->last_changed ());
+  this->set_object_last_changed (this->last_changed ());
+}
+
+time_t
+TAO_Storable_Naming_Context::
+File_Open_Lock_and_Check::last_changed ()
+{
+  time_t changed = fl_->last_changed ();
+
+  // Changes appended to the journal leave the context file as it was.
+  if (TAO_Storable_Naming_Context::journal_size_ != 0)
+    {
+      ACE_Auto_Ptr<TAO::Storable_Base>
+        jfl (context_->factory_->create_stream (context_->journal_name (),
+                                                "r",
+                                                false));
+      if (jfl.get () != 0 && jfl->exists ())
+        {
+          time_t const journal_changed = jfl->last_changed ();
+          if (journal_changed > changed)
+            changed = journal_changed;
+        }
+    }
+
+  return changed;
 }
 
 void
@@ -397,6 +503,7 @@ TAO_Storable_Naming_Context::TAO_Storable_Naming_Context (
     hash_table_size_ (hash_table_size),
     last_changed_ (0),
     last_check_ (0),
+    journal_count_ (0),
     write_occurred_ (0)
 {
   ACE_TRACE("TAO_Storable_Naming_Context");
@@ -648,7 +755,7 @@ TAO_Storable_Naming_Context::rebind (const CosNaming::Name& n,
           CosNaming::NamingContext::not_object,
           n);
 
-      this->Write (flck.peer());
+      this->Write_Binding (flck, n[0]);
     }
 }
 
@@ -689,7 +796,7 @@ TAO_Storable_Naming_Context::bind_context (const CosNaming::Name &n,
       else if (result == -1)
         throw CORBA::INTERNAL ();
 
-      this->Write(flck.peer());
+      this->Write_Binding (flck, n[0]);
     }
 }
 
@@ -730,7 +837,7 @@ TAO_Storable_Naming_Context::rebind_context (const CosNaming::Name &n,
           CosNaming::NamingContext::not_context,
           n);
 
-      this->Write(flck.peer());
+      this->Write_Binding (flck, n[0]);
     }
 }
 
@@ -796,7 +903,7 @@ TAO_Storable_Naming_Context::unbind (const CosNaming::Name& n)
           CosNaming::NamingContext::missing_node,
           n);
 
-      this->Write(flck.peer());
+      this->Write_Binding (flck, n[0]);
     }
 }
 
@@ -831,7 +938,7 @@ TAO_Storable_Naming_Context::bind (const CosNaming::Name& n,
       else if (result == -1)
         throw CORBA::INTERNAL ();
 
-      this->Write (flck.peer());
+      this->Write_Binding (flck, n[0]);
     }
 }
 
@@ -1051,7 +1158,8 @@ TAO_Storable_Naming_Context::recreate_all (
                                int reentering,
                                TAO_Storable_Naming_Context_Factory *cxt_factory,
                                TAO::Storable_Factory *pers_factory,
-                               int use_redundancy)
+                               int use_redundancy,
+                               ACE_UINT32 journal_size)
 {
   ACE_TRACE("recreate_all");
 
@@ -1060,6 +1168,9 @@ TAO_Storable_Naming_Context::recreate_all (
   // Whether we are redundant is global
   redundant_ = use_redundancy;
 
+  // So is the journal size
+  journal_size_ = journal_size;
+
   // Save the root name for later use
   root_name_ = poa_id;
 
@@ -259,7 +259,8 @@ public:
                               int reentering,
                               TAO_Storable_Naming_Context_Factory *cxt_factory,
                               TAO::Storable_Factory *pers_factory,
-                              int use_redundancy);
+                              int use_redundancy,
+                              ACE_UINT32 journal_size = 0);
 
 
   /**
@@ -419,6 +420,14 @@ protected:
   /// Flag to tell us whether we are redundant or not
   static int redundant_;
 
+  /// Number of binding changes appended to a context journal before
+  /// the context file is rewritten.  Zero rewrites the context file on
+  /// every change.
+  static ACE_UINT32 journal_size_;
+
+  /// Number of entries currently in the journal of this context.
+  ACE_UINT32 journal_count_;
+
   static const char * root_name_;
 
   /// The pointer to the global file used to allocate new contexts
@@ -469,6 +478,10 @@ private:
   /// Default constructor
   File_Open_Lock_and_Check(void);
 
+  /// The later of the times the context file and its journal were
+  /// last changed.
+  time_t last_changed (void);
+
   TAO_Storable_Naming_Context * context_;
 
 }; // end of embedded class File_Open_Lock_and_Check
@@ -478,8 +491,23 @@ private:
 
   int load_map(TAO::Storable_Base& storable);
 
+  /// Rewrite the whole context file and discard the journal.
   void Write(TAO::Storable_Base& wrtr);
 
+  /// Persist the change just made to the binding named by <name>.
+  /// The change is appended to the journal unless journaling is
+  /// disabled or the journal is full, in which case the context file
+  /// held by <flck> is compacted by Write().
+  void Write_Binding(File_Open_Lock_and_Check& flck,
+                     const CosNaming::NameComponent& name);
+
+  /// Name of the journal file that accompanies the context file.
+  ACE_CString journal_name (void) const;
+
+  /// Apply the journal, if any, on top of the bindings just read from
+  /// the context file.
+  void load_journal (void);
+
   /// Is set by the Write operation.  Used to determine
   int write_occurred_;
 };
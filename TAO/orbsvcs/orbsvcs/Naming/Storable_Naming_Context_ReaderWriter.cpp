@@ -18,6 +18,10 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+/// Written after every journal entry; a journal whose last entry
+/// lacks it was cut short while being appended.
+static const char journal_mark[] = "end";
+
 TAO_Storable_Naming_Context_ReaderWriter::
 TAO_Storable_Naming_Context_ReaderWriter (TAO::Storable_Base & stream)
   : stream_(stream)
@@ -55,75 +59,14 @@ TAO_Storable_Naming_Context_ReaderWriter::write (TAO_Storable_Naming_Context & c
   while (!(it == itend))
     {
       TAO_NS_Persistence_Record record;
-
-      ACE_CString name;
-      CosNaming::BindingType bt = (*it).int_id_.type_;
-      if (bt ==  CosNaming::ncontext)
-        {
-        CORBA::Object_var
-          obj = context.orb_->string_to_object ((*it).int_id_.ref_.in ());
-        if (obj->_is_collocated ())
-          {
-            // This is a local (i.e. non federated context) we therefore
-            // store only the ObjectID (persistence filename) for the object.
-
-            // The driving force behind storing ObjectIDs rather than IORs for
-            // local contexts is to provide for a redundant naming service.
-            // That is, a naming service that runs simultaneously on multiple
-            // machines sharing a file system. It allows multiple redundant
-            // copies to be started and stopped independently.
-            // The original target platform was Tru64 Clusters where there was
-            // a cluster address. In that scenario, clients may get different
-            // servers on each request, hence the requirement to keep
-            // synchronized to the disk. It also works on non-cluster system
-            // where the client picks one of the redundant servers and uses it,
-            // while other systems can pick different servers. (However in this
-            // scenario, if a server fails and a client must pick a new server,
-            // that client may not use any saved context IORs, instead starting
-            // from the root to resolve names. So this latter mode is not quite
-            // transparent to clients.) [Rich Seibel (seibel_r) of ociweb.com]
-
-            PortableServer::ObjectId_var
-              oid = context.poa_->reference_to_id (obj.in ());
-            CORBA::String_var
-              nm = PortableServer::ObjectId_to_string (oid.in ());
-            const char
-              *newname = nm.in ();
-            name.set (newname); // The local ObjectID (persistance filename)
-            record.type (TAO_NS_Persistence_Record::LOCAL_NCONTEXT);
-          }
-        else
-          {
-            // Since this is a foreign (federated) context, we can not store
-            // the objectID (because it isn't in our storage), if we did, when
-            // we restore, we would end up either not finding a permanent
-            // record (and thus ending up incorrectly assuming the context was
-            // destroyed) or loading another context altogether (just because
-            // the contexts shares its objectID filename which is very likely).
-            // [Simon Massey  (sma) of prismtech.com]
-
-            name.set ((*it).int_id_.ref_.in ()); // The federated context IOR
-            record.type (TAO_NS_Persistence_Record::REMOTE_NCONTEXT);
-          }
-      }
-    else // if (bt == CosNaming::nobject) // shouldn't be any other, can there?
-      {
-        name.set ((*it).int_id_.ref_.in ()); // The non-context object IOR
-        record.type (TAO_NS_Persistence_Record::OBJREF);
-      }
-    record.ref(name);
-
-    const char *myid = (*it).ext_id_.id();
-    ACE_CString id(myid);
-    record.id(id);
-
-    const char *mykind = (*it).ext_id_.kind();
-    ACE_CString kind(mykind);
-    record.kind(kind);
-
-    write_record (record);
-    it.advance();
-  }
+      this->make_record (context,
+                         (*it).ext_id_.id (),
+                         (*it).ext_id_.kind (),
+                         (*it).int_id_,
+                         record);
+      write_record (record);
+      it.advance();
+    }
 
   context.write_occurred_ = 1;
 }
@@ -154,38 +97,202 @@ TAO_Storable_Naming_Context_ReaderWriter::read (TAO_Storable_Naming_Context & co
   for (unsigned int i= 0u; i<header.size(); ++i)
     {
       this->read_record(record);
+      this->bind_record (context, *bindings_map, record);
+    }
+  context.storable_context_ = bindings_map;
+  context.context_ = context.storable_context_;
+  if (stream_.good ())
+    return 0;
+  else
+    return -1;
+}
 
-      if (TAO_NS_Persistence_Record::LOCAL_NCONTEXT == record.type ())
+void
+TAO_Storable_Naming_Context_ReaderWriter::make_record (
+  TAO_Storable_Naming_Context & context,
+  const char * id,
+  const char * kind,
+  const TAO_Storable_IntId & int_id,
+  TAO_NS_Persistence_Record & record)
+{
+  ACE_CString name;
+  CosNaming::BindingType bt = int_id.type_;
+  if (bt ==  CosNaming::ncontext)
+    {
+      CORBA::Object_var
+        obj = context.orb_->string_to_object (int_id.ref_.in ());
+      if (obj->_is_collocated ())
         {
+          // This is a local (i.e. non federated context) we therefore
+          // store only the ObjectID (persistence filename) for the object.
+
+          // The driving force behind storing ObjectIDs rather than IORs for
+          // local contexts is to provide for a redundant naming service.
+          // That is, a naming service that runs simultaneously on multiple
+          // machines sharing a file system. It allows multiple redundant
+          // copies to be started and stopped independently.
+          // The original target platform was Tru64 Clusters where there was
+          // a cluster address. In that scenario, clients may get different
+          // servers on each request, hence the requirement to keep
+          // synchronized to the disk. It also works on non-cluster system
+          // where the client picks one of the redundant servers and uses it,
+          // while other systems can pick different servers. (However in this
+          // scenario, if a server fails and a client must pick a new server,
+          // that client may not use any saved context IORs, instead starting
+          // from the root to resolve names. So this latter mode is not quite
+          // transparent to clients.) [Rich Seibel (seibel_r) of ociweb.com]
+
           PortableServer::ObjectId_var
-            id = PortableServer::string_to_ObjectId (record.ref ().c_str ());
+            oid = context.poa_->reference_to_id (obj.in ());
+          CORBA::String_var
+            nm = PortableServer::ObjectId_to_string (oid.in ());
           const char
-            *intf = context.interface_->_interface_repository_id ();
-          CORBA::Object_var
-            objref = context.poa_->create_reference_with_id (id.in (), intf);
-          bindings_map->bind ( record.id ().c_str (),
-                               record.kind ().c_str (),
-                               objref.in (),
-                               CosNaming::ncontext );
+            *newname = nm.in ();
+          name.set (newname); // The local ObjectID (persistance filename)
+          record.type (TAO_NS_Persistence_Record::LOCAL_NCONTEXT);
         }
       else
         {
-          CORBA::Object_var
-            objref = context.orb_->string_to_object (record.ref ().c_str ());
-          bindings_map->bind ( record.id ().c_str (),
-                               record.kind ().c_str (),
-                               objref.in (),
-                               ((TAO_NS_Persistence_Record::REMOTE_NCONTEXT == record.type ())
-                                ? CosNaming::ncontext    // REMOTE_NCONTEXT
-                                : CosNaming::nobject )); // OBJREF
+          // Since this is a foreign (federated) context, we can not store
+          // the objectID (because it isn't in our storage), if we did, when
+          // we restore, we would end up either not finding a permanent
+          // record (and thus ending up incorrectly assuming the context was
+          // destroyed) or loading another context altogether (just because
+          // the contexts shares its objectID filename which is very likely).
+          // [Simon Massey  (sma) of prismtech.com]
+
+          name.set (int_id.ref_.in ()); // The federated context IOR
+          record.type (TAO_NS_Persistence_Record::REMOTE_NCONTEXT);
         }
     }
-  context.storable_context_ = bindings_map;
-  context.context_ = context.storable_context_;
-  if (stream_.good ())
-    return 0;
+  else // if (bt == CosNaming::nobject) // shouldn't be any other, can there?
+    {
+      name.set (int_id.ref_.in ()); // The non-context object IOR
+      record.type (TAO_NS_Persistence_Record::OBJREF);
+    }
+  record.ref (name);
+  record.id (id);
+  record.kind (kind);
+}
+
+void
+TAO_Storable_Naming_Context_ReaderWriter::bind_record (
+  TAO_Storable_Naming_Context & context,
+  TAO_Storable_Bindings_Map & bindings_map,
+  const TAO_NS_Persistence_Record & record)
+{
+  if (TAO_NS_Persistence_Record::LOCAL_NCONTEXT == record.type ())
+    {
+      PortableServer::ObjectId_var
+        id = PortableServer::string_to_ObjectId (record.ref ().c_str ());
+      const char
+        *intf = context.interface_->_interface_repository_id ();
+      CORBA::Object_var
+        objref = context.poa_->create_reference_with_id (id.in (), intf);
+      bindings_map.bind ( record.id ().c_str (),
+                          record.kind ().c_str (),
+                          objref.in (),
+                          CosNaming::ncontext );
+    }
+  else
+    {
+      CORBA::Object_var
+        objref = context.orb_->string_to_object (record.ref ().c_str ());
+      bindings_map.bind ( record.id ().c_str (),
+                          record.kind ().c_str (),
+                          objref.in (),
+                          ((TAO_NS_Persistence_Record::REMOTE_NCONTEXT == record.type ())
+                           ? CosNaming::ncontext    // REMOTE_NCONTEXT
+                           : CosNaming::nobject )); // OBJREF
+    }
+}
+
+void
+TAO_Storable_Naming_Context_ReaderWriter::write_journal_entry (
+  TAO_Storable_Naming_Context & context,
+  ACE_UINT32 entry,
+  const char * id,
+  const char * kind)
+{
+  TAO_NS_Persistence_Record record;
+
+  TAO_Storable_IntId int_id;
+  TAO_Storable_ExtId ext_id (id, kind);
+  if (context.storable_context_ != 0
+      && context.storable_context_->map ().find (ext_id, int_id) == 0)
+    {
+      this->make_record (context, id, kind, int_id, record);
+    }
   else
+    {
+      // The binding was removed; an UNDEFINED record tells the reader
+      // to unbind it.
+      record.id (id);
+      record.kind (kind);
+    }
+
+  // Each entry is framed by its sequence number and a trailing mark
+  // so that an entry cut short by a crash is recognized on replay.
+  stream_ << entry;
+  this->write_record (record);
+  stream_ << ACE_CString (journal_mark);
+  stream_.flush ();
+
+  context.write_occurred_ = 1;
+}
+
+int
+TAO_Storable_Naming_Context_ReaderWriter::read_journal (
+  TAO_Storable_Naming_Context & context)
+{
+  // assume file already open for reading and read () already called
+  TAO_Storable_Bindings_Map *bindings_map = context.storable_context_;
+  if (bindings_map == 0)
     return -1;
+
+  stream_.rewind ();
+
+  int entries = 0;
+  for (;;)
+    {
+      ACE_UINT32 entry = 0;
+      try
+        {
+          stream_ >> entry;
+        }
+      catch (const TAO::Storable_Read_Exception &ex)
+        {
+          // Running out of data between two entries is the normal end
+          // of the journal.
+          if (ex.get_state () == TAO::Storable_Base::eofbit)
+            return entries;
+          return -1;
+        }
+
+      if (entry != static_cast<ACE_UINT32> (entries + 1))
+        return -1;
+
+      TAO_NS_Persistence_Record record;
+      ACE_CString mark;
+      try
+        {
+          this->read_record (record);
+          stream_ >> mark;
+        }
+      catch (const TAO::Storable_Read_Exception &)
+        {
+          return -1;
+        }
+
+      if (mark != journal_mark)
+        return -1;
+
+      bindings_map->unbind (record.id ().c_str (), record.kind ().c_str ());
+      if (TAO_NS_Persistence_Record::UNDEFINED != record.type ())
+        this->bind_record (context, *bindings_map, record);
+
+      ++entries;
+    }
 }
 
 void
@@ -29,6 +29,8 @@ namespace TAO
 }
 
 class TAO_Storable_Naming_Context;
+class TAO_Storable_Bindings_Map;
+class TAO_Storable_IntId;
 class TAO_NS_Persistence_Record;
 class TAO_NS_Persistence_Header;
 class TAO_NS_Persistence_Global;
@@ -43,6 +45,19 @@ public:
 
   void write (TAO_Storable_Naming_Context & context);
 
+  /// Append the current state of the binding <id>/<kind> to the
+  /// journal of <context> as entry number <entry>.  A binding that no
+  /// longer exists is recorded as removed.
+  void write_journal_entry (TAO_Storable_Naming_Context & context,
+                            ACE_UINT32 entry,
+                            const char * id,
+                            const char * kind);
+
+  /// Apply the journal entries to the bindings loaded by read ().
+  /// Returns the number of entries applied, or -1 if the journal
+  /// ends with an incomplete or out of sequence entry.
+  int read_journal (TAO_Storable_Naming_Context & context);
+
   void write_global (const TAO_NS_Persistence_Global & global);
   void read_global (TAO_NS_Persistence_Global & global);
 
@@ -54,6 +69,15 @@ private:
   void write_record (const TAO_NS_Persistence_Record & record);
   void read_record (TAO_NS_Persistence_Record & record);
 
+  void make_record (TAO_Storable_Naming_Context & context,
+                    const char * id,
+                    const char * kind,
+                    const TAO_Storable_IntId & int_id,
+                    TAO_NS_Persistence_Record & record);
+  void bind_record (TAO_Storable_Naming_Context & context,
+                    TAO_Storable_Bindings_Map & bindings_map,
+                    const TAO_NS_Persistence_Record & record);
+
   TAO::Storable_Base &stream_;
 };
 
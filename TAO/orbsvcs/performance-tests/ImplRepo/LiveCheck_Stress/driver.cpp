@@ -0,0 +1,251 @@
+/**
+ * @file driver.cpp
+ *
+ * Register thousands of stand-in servers with the LiveCheck of the
+ * Implementation Repository locator and measure how long it takes
+ * until every listener knows whether its server is alive.
+ */
+
+#include "LiveCheck.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/Vector_T.h"
+
+int nservers = 5000;
+int nlisteners = 2;
+int ping_window = 0;
+int dead_every = 10;
+int time_limit = 60;
+
+int parse_args (int argc, ACE_TCHAR *argv[]);
+
+/// Stands in for the ServerObject of a server started by the ImR.
+class Stand_In : public virtual POA_ImplementationRepository::ServerObject
+{
+public:
+  Stand_In (void) : pings_ (0) {}
+
+  void ping (void) { ++this->pings_; }
+  void shutdown (void) {}
+
+  int pings_;
+};
+
+/// Counts the outcomes and keeps track of the ping window.
+class Stress_Listener : public LiveListener
+{
+public:
+  Stress_Listener (const char *server, LiveCheck &pinger)
+    : LiveListener (server),
+      pinger_ (pinger)
+  {
+  }
+
+  bool status_changed (LiveStatus status)
+  {
+    if (pinger_.pings_in_flight () > max_in_flight)
+      max_in_flight = pinger_.pings_in_flight ();
+
+    switch (status)
+      {
+      case LS_ALIVE:
+        ++alive;
+        return true;
+      case LS_DEAD:
+      case LS_LAST_TRANSIENT:
+      case LS_TIMEDOUT:
+        ++dead;
+        return true;
+      default:
+        return false;
+      }
+  }
+
+  static int alive;
+  static int dead;
+  static int max_in_flight;
+
+private:
+  LiveCheck &pinger_;
+};
+
+int Stress_Listener::alive = 0;
+int Stress_Listener::dead = 0;
+int Stress_Listener::max_in_flight = 0;
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+      PortableServer::POAManager_var mgr = poa->the_POAManager ();
+      mgr->activate ();
+
+      LiveCheck pinger;
+      pinger.init (orb.in (), ACE_Time_Value (60, 0), ping_window);
+
+      // Every dead_every'th server is deactivated again before it is
+      // pinged, so its ping fails.
+      ACE_Vector<Stand_In *> servants;
+      int expected_pings = 0;
+      for (int i = 0; i != nservers; ++i)
+        {
+          Stand_In *servant = 0;
+          ACE_NEW_RETURN (servant, Stand_In, 1);
+          servants.push_back (servant);
+          PortableServer::ObjectId_var oid = poa->activate_object (servant);
+          obj = poa->id_to_reference (oid.in ());
+          ImplementationRepository::ServerObject_var ref =
+            ImplementationRepository::ServerObject::_narrow (obj.in ());
+          if (dead_every > 0 && i % dead_every == 0)
+            {
+              poa->deactivate_object (oid.in ());
+            }
+          else
+            {
+              ++expected_pings;
+            }
+
+          char name[32];
+          ACE_OS::sprintf (name, "server_%d", i);
+          pinger.add_server (name, true, ref.in (), 0);
+        }
+
+      ACE_Vector<LiveListener_ptr> listeners;
+      ACE_hrtime_t const start = ACE_OS::gethrtime ();
+      for (int i = 0; i != nservers; ++i)
+        {
+          char name[32];
+          ACE_OS::sprintf (name, "server_%d", i);
+          for (int l = 0; l != nlisteners; ++l)
+            {
+              Stress_Listener *listener = 0;
+              ACE_NEW_RETURN (listener, Stress_Listener (name, pinger), 1);
+              LiveListener_ptr llp (listener);
+              listeners.push_back (llp);
+              pinger.add_listener (listener);
+            }
+        }
+
+      int const expected = nservers * nlisteners;
+      ACE_Time_Value const deadline =
+        ACE_OS::gettimeofday () + ACE_Time_Value (time_limit, 0);
+      while (Stress_Listener::alive + Stress_Listener::dead < expected &&
+             ACE_OS::gettimeofday () < deadline)
+        {
+          ACE_Time_Value tv (1, 0);
+          orb->perform_work (tv);
+        }
+      ACE_hrtime_t const end = ACE_OS::gethrtime ();
+
+      int pings = 0;
+      for (size_t i = 0; i != servants.size (); ++i)
+        {
+          pings += servants[i]->pings_;
+        }
+
+      double const usecs =
+        double (end - start) / ACE_High_Res_Timer::global_scale_factor ();
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "servers = %d, listeners per server = %d, window = %d\n"
+                  "outcomes: %d alive, %d dead of %d\n"
+                  "pings answered: %d, max in flight: %d\n"
+                  "time: %.3f ms, %.0f servers/s\n",
+                  nservers, nlisteners, ping_window,
+                  Stress_Listener::alive, Stress_Listener::dead, expected,
+                  pings, Stress_Listener::max_in_flight,
+                  usecs / 1.0e3, nservers * 1.0e6 / usecs));
+
+      if (Stress_Listener::alive + Stress_Listener::dead != expected)
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: not all listeners got an outcome\n"));
+          status = 1;
+        }
+      if (pings != expected_pings)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: expected one ping per live server, got %d\n",
+                      pings));
+          status = 1;
+        }
+      if (ping_window > 0 && Stress_Listener::max_in_flight > ping_window)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %d pings in flight exceeds the window\n",
+                      Stress_Listener::max_in_flight));
+          status = 1;
+        }
+
+      pinger.shutdown ();
+      listeners.clear ();
+
+      for (size_t i = 0; i != servants.size (); ++i)
+        {
+          servants[i]->_remove_ref ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("LiveCheck_Stress");
+      return 1;
+    }
+  return status;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:l:w:d:t:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nservers = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'l':
+        nlisteners = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'w':
+        ping_window = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        dead_every = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        time_limit = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Usage: %s "
+                           "-n servers "
+                           "-l listeners_per_server "
+                           "-w ping_window (0 is unlimited) "
+                           "-d every_nth_server_dead (0 for none) "
+                           "-t time_limit_secs"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
@@ -0,0 +1,10 @@
+#! /bin/sh
+#
+# Ping thousands of stand-in servers through the ImR LiveCheck, with
+# and without a ping window.  Collocation is disabled so that every
+# ping is a real asynchronous request over the loopback interface.
+
+for w in 0 100; do
+  echo "Ping window $w"
+  ./driver -ORBCollocation no -n 10000 -w $w
+done
@@ -0,0 +1,381 @@
+/**
+ * @file driver.cpp
+ *
+ * Fill the repositories of the Implementation Repository locator with
+ * servers and measure how long a restarted locator takes to load them
+ * from the XML files and from the binary file, and how long the backup
+ * of a fault tolerant pair takes to load the changes of the primary.
+ */
+
+#include "Binary_Backing_Store.h"
+#include "Shared_Backing_Store.h"
+#include "LiveCheck.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/ARGV.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_stat.h"
+
+int nservers = 5000;
+int nchanges = 100;
+const ACE_TCHAR *directory = ACE_TEXT ("Repository_Startup");
+
+int parse_args (int argc, ACE_TCHAR *argv[]);
+
+ACE_High_Res_Timer::global_scale_factor_type gsf = 1;
+
+double
+msecs (ACE_hrtime_t start, ACE_hrtime_t end)
+{
+  return double (end - start) / gsf / 1.0e3;
+}
+
+/// Parse the locator options for one repository.
+bool
+make_options (Options &opts, const ACE_TCHAR *a, const ACE_TCHAR *b = 0,
+              const ACE_TCHAR *c = 0, const ACE_TCHAR *d = 0,
+              const ACE_TCHAR *e = 0)
+{
+  ACE_ARGV args;
+  args.add (ACE_TEXT ("driver"));
+  const ACE_TCHAR *list[] = { a, b, c, d, e };
+  for (size_t i = 0; i != sizeof (list) / sizeof (list[0]); ++i)
+    {
+      if (list[i] != 0)
+        args.add (list[i]);
+    }
+  return opts.init (args.argc (), args.argv ()) == 0;
+}
+
+/// Create the repository selected by the options and load it.
+Locator_Repository *
+open_repo (const Options &opts, CORBA::ORB_ptr orb,
+           PortableServer::POA_ptr poa)
+{
+  Locator_Repository *repo = 0;
+  switch (opts.repository_mode ())
+    {
+    case Options::REPO_XML_FILE:
+      ACE_NEW_RETURN (repo, XML_Backing_Store (opts, orb), 0);
+      break;
+    case Options::REPO_BINARY_FILE:
+      ACE_NEW_RETURN (repo, Binary_Backing_Store (opts, orb), 0);
+      break;
+    case Options::REPO_SHARED_FILES:
+      ACE_NEW_RETURN (repo, Shared_Backing_Store (opts, orb, 0), 0);
+      break;
+    default:
+      return 0;
+    }
+
+  if (repo->init (poa, poa, "IOR:") != 0)
+    {
+      delete repo;
+      return 0;
+    }
+  return repo;
+}
+
+/// Register count servers named after prefix, returns the time it
+/// took.
+double
+fill (Locator_Repository &repo, const char *prefix, int count)
+{
+  ImplementationRepository::StartupOptions startup;
+  startup.command_line = CORBA::string_dup ("server -ORBUseIMR 1");
+  startup.working_directory = CORBA::string_dup ("/tmp");
+  startup.activation = ImplementationRepository::NORMAL;
+  startup.activator = CORBA::string_dup ("activator");
+  startup.start_limit = 1;
+  startup.environment.length (1);
+  startup.environment[0].name = CORBA::string_dup ("PATH");
+  startup.environment[0].value = CORBA::string_dup ("/bin:/usr/bin");
+
+  ACE_hrtime_t const start = ACE_OS::gethrtime ();
+  for (int i = 0; i != count; ++i)
+    {
+      char name[64];
+      ACE_OS::sprintf (name, "JACORB:%s_%d/RootPOA/poa_%d", prefix, i, i);
+      repo.add_server (name, startup);
+    }
+  return msecs (start, ACE_OS::gethrtime ());
+}
+
+/// Restart the repository, returns the time it took or -1.  The
+/// restarted repository is kept in kept unless that is 0.
+double
+restart (const Options &opts, CORBA::ORB_ptr orb,
+         PortableServer::POA_ptr poa, Locator_Repository **kept = 0)
+{
+  ACE_hrtime_t const start = ACE_OS::gethrtime ();
+  Locator_Repository *repo = open_repo (opts, orb, poa);
+  ACE_hrtime_t const end = ACE_OS::gethrtime ();
+  if (repo == 0)
+    return -1;
+
+  size_t const loaded = repo->servers ().current_size ();
+  if (kept != 0)
+    *kept = repo;
+  else
+    delete repo;
+  if (loaded != static_cast<size_t> (nservers))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: %s loaded %d of %d servers\n",
+                  opts.persist_file_name ().c_str (),
+                  static_cast<int> (loaded), nservers));
+      return -1;
+    }
+  return msecs (start, end);
+}
+
+/// Register nchanges servers with the primary, and notify the backup
+/// of them as the primary does, or of missed notifications.  Returns
+/// the time the backup took to load the changes, or -1.
+double
+sync (Locator_Repository &primary, Locator_Repository &backup,
+      const char *prefix, bool missed, CORBA::ORB_ptr orb)
+{
+  // The primary gives the new servers the next ids, which name their
+  // files in an XML repository.
+  CORBA::Long const first_id =
+    static_cast<CORBA::Long> (primary.servers ().current_size ()) + 1;
+  fill (primary, prefix, nchanges);
+
+  ImplementationRepository::UpdateInfoSeq updates (nchanges);
+  updates.length (nchanges);
+  for (int i = 0; i != nchanges; ++i)
+    {
+      char name[64];
+      ACE_OS::sprintf (name, "JACORB:%s_%d/RootPOA/poa_%d", prefix, i, i);
+      updates[i].name = CORBA::string_dup (name);
+      ImplementationRepository::RepoInfo info;
+      info.kind = ImplementationRepository::repo_server;
+      info.repo.repo_type = Options::STANDALONE_IMR;
+      info.repo.repo_id = first_id + i;
+      updates[i].action.info (info);
+    }
+
+  Shared_Backing_Store *shared =
+    dynamic_cast<Shared_Backing_Store *> (&backup);
+  if (shared == 0)
+    return -1;
+
+  // The backup loads the changes from its reactor.
+  ACE_hrtime_t const start = ACE_OS::gethrtime ();
+  shared->updates_available (updates, missed);
+  ACE_Time_Value tv (ACE_Time_Value::zero);
+  orb->perform_work (tv);
+  ACE_hrtime_t const end = ACE_OS::gethrtime ();
+
+  size_t const expected = primary.servers ().current_size ();
+  size_t const loaded = backup.servers ().current_size ();
+  if (loaded != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: the backup of %s has %d of %d servers\n",
+                  backup.repo_mode (),
+                  static_cast<int> (loaded), static_cast<int> (expected)));
+      return -1;
+    }
+  return msecs (start, end);
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      gsf = ACE_High_Res_Timer::global_scale_factor ();
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+
+      ACE_OS::mkdir (directory);
+      ACE_TString const base = ACE_TString (directory) + ACE_TEXT ("/");
+      ACE_TString const bin_file = base + ACE_TEXT ("repo.bin");
+      ACE_TString const xml_file = base + ACE_TEXT ("repo.xml");
+      ACE_TString const import_file = base + ACE_TEXT ("imported.bin");
+      ACE_TString const xml_dir = base + ACE_TEXT ("xml_dir");
+      ACE_TString const bin_dir = base + ACE_TEXT ("bin_dir");
+      ACE_OS::mkdir (xml_dir.c_str ());
+      ACE_OS::mkdir (bin_dir.c_str ());
+
+      LiveCheck pinger;
+      pinger.init (orb.in (), ACE_Time_Value (60, 0));
+
+      // Single file repositories.  Filling the XML file directly
+      // rewrites it for every server, so it is exported from the
+      // binary one.
+      Options bin_fill;
+      Options bin_export;
+      Options bin_opts;
+      Options xml_opts;
+      Options import_opts;
+      if (!make_options (bin_fill, ACE_TEXT ("-e"), ACE_TEXT ("-b"),
+                         bin_file.c_str ()) ||
+          !make_options (bin_export, ACE_TEXT ("-b"), bin_file.c_str (),
+                         ACE_TEXT ("--export"), xml_file.c_str ()) ||
+          !make_options (bin_opts, ACE_TEXT ("-b"), bin_file.c_str ()) ||
+          !make_options (xml_opts, ACE_TEXT ("-x"), xml_file.c_str ()) ||
+          !make_options (import_opts, ACE_TEXT ("-e"), ACE_TEXT ("-b"),
+                         import_file.c_str (), ACE_TEXT ("--import"),
+                         xml_file.c_str ()))
+        return 1;
+
+      Locator_Repository *repo = open_repo (bin_fill, orb.in (), poa.in ());
+      if (repo == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot create %s\n",
+                           bin_file.c_str ()), 1);
+      double const bin_fill_ms = fill (*repo, "server", nservers);
+      delete repo;
+      repo = open_repo (bin_export, orb.in (), poa.in ());
+      delete repo;
+
+      double const xml_ms = restart (xml_opts, orb.in (), poa.in ());
+      double const bin_ms = restart (bin_opts, orb.in (), poa.in ());
+      double const import_ms = restart (import_opts, orb.in (), poa.in ());
+
+      // Shared directories, as used by a fault tolerant pair.
+      Options xml_dir_fill;
+      Options xml_dir_opts;
+      Options bin_dir_fill;
+      Options bin_dir_opts;
+      if (!make_options (xml_dir_fill, ACE_TEXT ("-e"),
+                         ACE_TEXT ("--directory"), xml_dir.c_str ()) ||
+          !make_options (xml_dir_opts, ACE_TEXT ("--directory"),
+                         xml_dir.c_str ()) ||
+          !make_options (bin_dir_fill, ACE_TEXT ("-e"),
+                         ACE_TEXT ("--directory"), bin_dir.c_str (),
+                         ACE_TEXT ("--binary")) ||
+          !make_options (bin_dir_opts, ACE_TEXT ("--directory"),
+                         bin_dir.c_str (), ACE_TEXT ("--binary")))
+        return 1;
+      xml_dir_fill.pinger (&pinger);
+      xml_dir_opts.pinger (&pinger);
+      bin_dir_fill.pinger (&pinger);
+      bin_dir_opts.pinger (&pinger);
+
+      // The repository that is filled stays up as the primary, the
+      // restarted one is its backup.
+      Locator_Repository *primary =
+        open_repo (xml_dir_fill, orb.in (), poa.in ());
+      if (primary == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot create %s\n",
+                           xml_dir.c_str ()), 1);
+      double const xml_dir_fill_ms = fill (*primary, "server", nservers);
+
+      Locator_Repository *backup = 0;
+      double const xml_dir_ms =
+        restart (xml_dir_opts, orb.in (), poa.in (), &backup);
+      double xml_sync_ms = -1;
+      double xml_full_sync_ms = -1;
+      if (backup != 0)
+        {
+          xml_sync_ms = sync (*primary, *backup, "changed", false,
+                              orb.in ());
+          xml_full_sync_ms = sync (*primary, *backup, "missed", true,
+                                   orb.in ());
+        }
+      delete backup;
+      delete primary;
+
+      primary = open_repo (bin_dir_fill, orb.in (), poa.in ());
+      if (primary == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot create %s\n",
+                           bin_dir.c_str ()), 1);
+      double const bin_dir_fill_ms = fill (*primary, "server", nservers);
+
+      backup = 0;
+      double const bin_dir_ms =
+        restart (bin_dir_opts, orb.in (), poa.in (), &backup);
+      double bin_sync_ms = -1;
+      double bin_full_sync_ms = -1;
+      if (backup != 0)
+        {
+          bin_sync_ms = sync (*primary, *backup, "changed", false,
+                              orb.in ());
+          bin_full_sync_ms = sync (*primary, *backup, "missed", true,
+                                   orb.in ());
+        }
+      delete backup;
+      delete primary;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "servers = %d, changes = %d\n"
+                  "                 register     restart        sync"
+                  "   full sync\n"
+                  "-x                      -  %10.3f           -"
+                  "           - ms\n"
+                  "-b            %10.3f  %10.3f           -"
+                  "           - ms\n"
+                  "-b --import             -  %10.3f           -"
+                  "           - ms\n"
+                  "--directory   %10.3f  %10.3f  %10.3f  %10.3f ms\n"
+                  "--binary      %10.3f  %10.3f  %10.3f  %10.3f ms\n",
+                  nservers, nchanges,
+                  xml_ms,
+                  bin_fill_ms, bin_ms,
+                  import_ms,
+                  xml_dir_fill_ms, xml_dir_ms, xml_sync_ms, xml_full_sync_ms,
+                  bin_dir_fill_ms, bin_dir_ms, bin_sync_ms,
+                  bin_full_sync_ms));
+
+      if (xml_ms < 0 || bin_ms < 0 || import_ms < 0 ||
+          xml_dir_ms < 0 || bin_dir_ms < 0 ||
+          xml_sync_ms < 0 || xml_full_sync_ms < 0 ||
+          bin_sync_ms < 0 || bin_full_sync_ms < 0)
+        status = 1;
+
+      pinger.shutdown ();
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Repository_Startup");
+      return 1;
+    }
+  return status;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:c:d:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nservers = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'c':
+        nchanges = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Usage: %s "
+                           "-n servers "
+                           "-c changes "
+                           "-d directory"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
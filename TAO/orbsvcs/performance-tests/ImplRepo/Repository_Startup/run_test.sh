@@ -0,0 +1,9 @@
+#! /bin/sh
+#
+# Compare the restart and backup sync times of the XML and the binary
+# repositories of the ImR locator for a growing number of servers.
+
+for n in 1000 10000; do
+  echo "Servers $n"
+  ./driver -n $n
+done
@@ -0,0 +1,194 @@
+/**
+ * @file driver.cpp
+ *
+ * Measure the resolve() throughput of TAO_Naming_Client with and
+ * without its resolve cache, and check that a rebind reaches the
+ * cache through the invalidation channel.
+ */
+
+#include "orbsvcs/Naming/Naming_Server.h"
+#include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Naming/Naming_Cache_Listener.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/ARGV.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+
+int nbindings = 100;
+int niterations = 100000;
+int ttl_msec = 10000;
+const ACE_TCHAR *notifier_file = ACE_TEXT ("notifier.ior");
+
+int parse_args (int argc, ACE_TCHAR *argv[]);
+
+void
+make_name (CosNaming::Name &name, int i)
+{
+  char id[32];
+  ACE_OS::sprintf (id, "name_%d", i);
+  name.length (1);
+  name[0].id = CORBA::string_dup (id);
+}
+
+/// Resolve <niterations> names and return the rate in resolves/s.
+double
+run_resolves (TAO_Naming_Client &client)
+{
+  CosNaming::Name name;
+  ACE_hrtime_t const start = ACE_OS::gethrtime ();
+  for (int i = 0; i != niterations; ++i)
+    {
+      make_name (name, i % nbindings);
+      CORBA::Object_var obj = client.resolve (name);
+    }
+  ACE_hrtime_t const end = ACE_OS::gethrtime ();
+
+  double const usecs =
+    double (end - start) / ACE_High_Res_Timer::global_scale_factor ();
+  return niterations * 1.0e6 / usecs;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      ACE_ARGV server_args;
+      server_args.add (argv[0]);
+      server_args.add (ACE_TEXT ("-i"));
+      server_args.add (notifier_file);
+
+      TAO_Naming_Server server;
+      if (server.init_with_orb (server_args.argc (),
+                                server_args.argv (),
+                                orb.in ()) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot start the naming server\n"), 1);
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+      PortableServer::POAManager_var mgr = poa->the_POAManager ();
+      mgr->activate ();
+
+      TAO_Naming_Client client;
+      if (client.init (orb.in ()) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot find the naming service\n"), 1);
+
+      // Bind every name to the root context itself, any object
+      // reference will do.
+      CosNaming::NamingContext_var root = client.get_context ();
+      CosNaming::Name name;
+      for (int i = 0; i != nbindings; ++i)
+        {
+          make_name (name, i);
+          root->rebind (name, root.in ());
+        }
+
+      double const uncached = run_resolves (client);
+
+      client.cache (ACE_Time_Value (ttl_msec / 1000,
+                                    (ttl_msec % 1000) * 1000),
+                    nbindings);
+      double const cached = run_resolves (client);
+
+      // Subscribe to the notifier and replace one binding, the cache
+      // must let go of the old reference.
+      TAO_Naming_Cache_Listener listener (client);
+      PortableServer::ObjectId_var id = poa->activate_object (&listener);
+      obj = poa->id_to_reference (id.in ());
+      NamingCache::Listener_var listener_ref =
+        NamingCache::Listener::_narrow (obj.in ());
+
+      ACE_CString ior ("file://");
+      ior += ACE_TEXT_ALWAYS_CHAR (notifier_file);
+      obj = orb->string_to_object (ior.c_str ());
+      NamingCache::Notifier_var notifier =
+        NamingCache::Notifier::_narrow (obj.in ());
+      notifier->subscribe (listener_ref.in ());
+
+      make_name (name, 0);
+      CosNaming::NamingContext_var replacement = root->new_context ();
+      root->rebind (name, replacement.in ());
+
+      // The invalidation is a oneway, give it time to arrive.
+      bool invalidated = false;
+      for (int i = 0; i != 100 && !invalidated; ++i)
+        {
+          ACE_Time_Value tv (0, 10000);
+          orb->perform_work (tv);
+          obj = client.resolve (name);
+          invalidated = obj->_is_equivalent (replacement.in ());
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "bindings = %d, iterations = %d, ttl = %d ms\n"
+                  "without cache: %.0f resolves/s\n"
+                  "with cache: %.0f resolves/s\n"
+                  "invalidation: %C\n",
+                  nbindings, niterations, ttl_msec,
+                  uncached, cached,
+                  invalidated ? "ok" : "stale reference"));
+
+      notifier->unsubscribe (listener_ref.in ());
+      poa->deactivate_object (id.in ());
+      replacement->destroy ();
+
+      root = CosNaming::NamingContext::_nil ();
+      server.fini ();
+      orb->destroy ();
+
+      if (!invalidated)
+        return 1;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Resolve_Cache");
+      return 1;
+    }
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:i:t:f:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nbindings = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        ttl_msec = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'f':
+        notifier_file = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Usage: %s "
+                           "-n bindings "
+                           "-i iterations "
+                           "-t ttl_msec "
+                           "-f notifier_ior_file"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
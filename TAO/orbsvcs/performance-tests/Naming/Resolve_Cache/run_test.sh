@@ -0,0 +1,11 @@
+#! /bin/sh
+#
+# Compare the resolve() rate of TAO_Naming_Client with and without
+# its cache.  Collocation is disabled so that every uncached resolve
+# is a real round trip to the Naming Service.
+
+for n in 10 1000; do
+  echo "Bindings $n"
+  ./driver -ORBCollocation no -n $n -i 100000
+done
+rm -f notifier.ior
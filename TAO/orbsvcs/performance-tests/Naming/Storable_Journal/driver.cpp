@@ -0,0 +1,166 @@
+/**
+ * @file driver.cpp
+ *
+ * Measure the bind rate and the restart time of the flat file naming
+ * context store, with and without a journal.
+ */
+
+#include "orbsvcs/Naming/Naming_Server.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/ARGV.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_stat.h"
+
+int nbindings = 10000;
+int journal_size = 0;
+const ACE_TCHAR *directory = ACE_TEXT ("Journal_Store");
+
+int parse_args (int argc, ACE_TCHAR *argv[]);
+
+/// Start a Naming Server using the flat file store in <directory>.
+TAO_Naming_Server *
+start_server (const ACE_TCHAR *program, CORBA::ORB_ptr orb)
+{
+  ACE_TCHAR journal[32];
+  ACE_OS::sprintf (journal, ACE_TEXT ("%d"), journal_size);
+
+  ACE_ARGV server_args;
+  server_args.add (program);
+  server_args.add (ACE_TEXT ("-u"));
+  server_args.add (directory);
+  server_args.add (ACE_TEXT ("-j"));
+  server_args.add (journal);
+
+  TAO_Naming_Server *server = 0;
+  ACE_NEW_RETURN (server, TAO_Naming_Server, 0);
+  if (server->init_with_orb (server_args.argc (),
+                             server_args.argv (),
+                             orb) != 0)
+    {
+      delete server;
+      return 0;
+    }
+  return server;
+}
+
+void
+make_name (CosNaming::Name &name, int i)
+{
+  char id[32];
+  ACE_OS::sprintf (id, "name_%d", i);
+  name.length (1);
+  name[0].id = CORBA::string_dup (id);
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      ACE_OS::mkdir (directory);
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      TAO_Naming_Server *server = start_server (argv[0], orb.in ());
+      if (server == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot start the naming server\n"), 1);
+
+      // Bind every name to the root context itself, any object
+      // reference will do.
+      CosNaming::NamingContext_var root =
+        CosNaming::NamingContext::_duplicate (server->operator-> ());
+      CosNaming::Name name;
+
+      ACE_hrtime_t const bind_start = ACE_OS::gethrtime ();
+      for (int i = 0; i != nbindings; ++i)
+        {
+          make_name (name, i);
+          root->bind (name, root.in ());
+        }
+      ACE_hrtime_t const bind_end = ACE_OS::gethrtime ();
+
+      root = CosNaming::NamingContext::_nil ();
+      server->fini ();
+      delete server;
+
+      // Restart, this loads the root context with all its bindings.
+      ACE_hrtime_t const restart_start = ACE_OS::gethrtime ();
+      server = start_server (argv[0], orb.in ());
+      ACE_hrtime_t const restart_end = ACE_OS::gethrtime ();
+      if (server == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot restart the naming server\n"), 1);
+
+      root = CosNaming::NamingContext::_duplicate (server->operator-> ());
+      for (int i = 0; i < nbindings; i += (nbindings / 10) + 1)
+        {
+          make_name (name, i);
+          CORBA::Object_var obj = root->resolve (name);
+        }
+
+      double const bind_usecs = double (bind_end - bind_start) / gsf;
+      double const restart_usecs = double (restart_end - restart_start) / gsf;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "bindings = %d, journal size = %d\n"
+                  "bind: %.0f binds/s\n"
+                  "restart: %.3f ms\n",
+                  nbindings, journal_size,
+                  nbindings * 1.0e6 / bind_usecs,
+                  restart_usecs / 1.0e3));
+
+      root = CosNaming::NamingContext::_nil ();
+      server->fini ();
+      delete server;
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Storable_Journal");
+      return 1;
+    }
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:j:d:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nbindings = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'j':
+        journal_size = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Usage: %s "
+                           "-n bindings "
+                           "-j journal_size (0 disables) "
+                           "-d directory"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
@@ -0,0 +1,14 @@
+#! /bin/sh
+#
+# Compare the bind rate and the restart time of the flat file naming
+# context store with and without a journal, for a few binding counts.
+
+for n in 1000 10000 50000; do
+  for j in 0 1000; do
+    rm -rf Journal_Store
+    mkdir Journal_Store
+    echo "Bindings $n, journal size $j"
+    ./driver -n $n -j $j -d Journal_Store
+  done
+done
+rm -rf Journal_Store
@@ -0,0 +1,334 @@
+/**
+ * @file driver.cpp
+ *
+ * Measure the throughput of two Event Channels federated over
+ * loopback multicast, with and without batching in the UDP sender.
+ */
+
+#include "orbsvcs/Event_Service_Constants.h"
+#include "orbsvcs/Event_Utilities.h"
+#include "orbsvcs/RtecEventCommS.h"
+
+#include "orbsvcs/Event/EC_Event_Channel.h"
+#include "orbsvcs/Event/EC_Default_Factory.h"
+#include "orbsvcs/Event/ECG_Simple_Address_Server.h"
+#include "orbsvcs/Event/ECG_Simple_Mcast_EH.h"
+#include "orbsvcs/Event/ECG_UDP_Sender.h"
+#include "orbsvcs/Event/ECG_UDP_Receiver.h"
+#include "orbsvcs/Event/ECG_UDP_Out_Endpoint.h"
+
+#include "tao/ORB_Core.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Task.h"
+#include "ace/OS_NS_unistd.h"
+
+int nevents = 100000;
+int payload_size = 64;
+u_long batch_interval = 0;
+CORBA::ULong mtu = TAO_ECG_CDR_Message_Sender::ECG_DEFAULT_MTU;
+const char *mcast_address = "224.9.9.2:12345";
+
+int parse_args (int argc, ACE_TCHAR *argv[]);
+
+/// Run the ORB event loop in a separate thread.
+class ORB_Task : public ACE_Task_Base
+{
+public:
+  ORB_Task (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc ()
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception&)
+      {
+        return -1;
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+/// Count the events received from the federated Event Channel.
+class Counting_Consumer : public POA_RtecEventComm::PushConsumer
+{
+public:
+  Counting_Consumer ()
+    : count_ (0)
+    , last_ (0)
+  {
+  }
+
+  virtual void push (const RtecEventComm::EventSet &events)
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->mutex_);
+    this->last_ = ACE_OS::gethrtime ();
+    this->count_ += events.length ();
+  }
+
+  virtual void disconnect_push_consumer ()
+  {
+  }
+
+  CORBA::ULong count ()
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->mutex_, 0);
+    return this->count_;
+  }
+
+  ACE_hrtime_t last ()
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->mutex_, 0);
+    return this->last_;
+  }
+
+private:
+  TAO_SYNCH_MUTEX mutex_;
+  CORBA::ULong count_;
+  ACE_hrtime_t last_;
+};
+
+/// Minimal supplier, the driver pushes the events through the proxy.
+class Null_Supplier : public POA_RtecEventComm::PushSupplier
+{
+public:
+  virtual void disconnect_push_supplier ()
+  {
+  }
+};
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  TAO_EC_Default_Factory::init_svcs ();
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa =
+        PortableServer::POA::_narrow (object.in ());
+      PortableServer::POAManager_var poa_manager =
+        poa->the_POAManager ();
+      poa_manager->activate ();
+
+      // Two Event Channels, events pushed into the first one are
+      // federated into the second one.
+      TAO_EC_Event_Channel_Attributes attributes (poa.in (), poa.in ());
+      TAO_EC_Event_Channel supplier_ec_impl (attributes);
+      supplier_ec_impl.activate ();
+      RtecEventChannelAdmin::EventChannel_var supplier_ec =
+        supplier_ec_impl._this ();
+
+      TAO_EC_Event_Channel consumer_ec_impl (attributes);
+      consumer_ec_impl.activate ();
+      RtecEventChannelAdmin::EventChannel_var consumer_ec =
+        consumer_ec_impl._this ();
+
+      PortableServer::Servant_var<TAO_ECG_Simple_Address_Server> as_impl =
+        TAO_ECG_Simple_Address_Server::create ();
+      if (as_impl->init (mcast_address) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot initialize the address server\n"),
+                          1);
+      RtecUDPAdmin::AddrServer_var address_server = as_impl->_this ();
+
+      // The sender side.
+      TAO_ECG_Refcounted_Endpoint endpoint (new TAO_ECG_UDP_Out_Endpoint);
+      if (endpoint->dgram ().open (ACE_Addr::sap_any) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot open send endpoint\n"), 1);
+
+      PortableServer::Servant_var<TAO_ECG_UDP_Sender> sender =
+        TAO_ECG_UDP_Sender::create ();
+      sender->init (supplier_ec.in (), address_server.in (), endpoint);
+      if (sender->mtu (mtu) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Invalid MTU <%u>\n", mtu), 1);
+      if (batch_interval != 0
+          && sender->batching (ACE_Time_Value (0, batch_interval),
+                               orb->orb_core ()->reactor ()) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot enable batching\n"), 1);
+
+      ACE_ConsumerQOS_Factory sender_qos;
+      sender_qos.start_disjunction_group (1);
+      sender_qos.insert (ACE_ES_EVENT_SOURCE_ANY, ACE_ES_EVENT_ANY, 0);
+      RtecEventChannelAdmin::ConsumerQOS sub = sender_qos.get_ConsumerQOS ();
+      sub.is_gateway = true;
+      sender->connect (sub);
+
+      // The receiver side, it must not ignore the datagrams sent by
+      // this process, so no endpoint is given to it.
+      PortableServer::Servant_var<TAO_ECG_UDP_Receiver> receiver =
+        TAO_ECG_UDP_Receiver::create ();
+      receiver->init (consumer_ec.in (),
+                      TAO_ECG_Refcounted_Endpoint (),
+                      address_server.in ());
+
+      TAO_ECG_Simple_Mcast_EH mcast_eh (receiver.in ());
+      mcast_eh.reactor (orb->orb_core ()->reactor ());
+      if (mcast_eh.open (mcast_address) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot open mcast handler\n"), 1);
+
+      ACE_SupplierQOS_Factory receiver_qos;
+      receiver_qos.insert (ACE_ES_EVENT_SOURCE_ANY, ACE_ES_EVENT_ANY, 0, 1);
+      RtecEventChannelAdmin::SupplierQOS pub =
+        receiver_qos.get_SupplierQOS ();
+      pub.is_gateway = true;
+      receiver->connect (pub);
+
+      // The application consumer and supplier.
+      Counting_Consumer consumer_impl;
+      RtecEventComm::PushConsumer_var consumer = consumer_impl._this ();
+      RtecEventChannelAdmin::ConsumerAdmin_var consumer_admin =
+        consumer_ec->for_consumers ();
+      RtecEventChannelAdmin::ProxyPushSupplier_var supplier_proxy =
+        consumer_admin->obtain_push_supplier ();
+      ACE_ConsumerQOS_Factory consumer_qos;
+      consumer_qos.start_disjunction_group (1);
+      consumer_qos.insert_type (ACE_ES_EVENT_UNDEFINED, 0);
+      supplier_proxy->connect_push_consumer (consumer.in (),
+                                             consumer_qos.get_ConsumerQOS ());
+
+      Null_Supplier supplier_impl;
+      RtecEventComm::PushSupplier_var supplier = supplier_impl._this ();
+      RtecEventChannelAdmin::SupplierAdmin_var supplier_admin =
+        supplier_ec->for_suppliers ();
+      RtecEventChannelAdmin::ProxyPushConsumer_var consumer_proxy =
+        supplier_admin->obtain_push_consumer ();
+      ACE_SupplierQOS_Factory supplier_qos;
+      supplier_qos.insert (1, ACE_ES_EVENT_UNDEFINED, 0, 1);
+      consumer_proxy->connect_push_supplier (supplier.in (),
+                                             supplier_qos.get_SupplierQOS ());
+
+      ORB_Task orb_task (orb.in ());
+      if (orb_task.activate (THR_NEW_LWP | THR_JOINABLE, 1) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, "Cannot activate ORB thread\n"), 1);
+
+      RtecEventComm::EventSet events (1);
+      events.length (1);
+      events[0].header.type = ACE_ES_EVENT_UNDEFINED;
+      events[0].header.source = 1;
+      events[0].header.ttl = 1;
+      events[0].data.payload.length (payload_size);
+
+      ACE_hrtime_t const start = ACE_OS::gethrtime ();
+      for (int i = 0; i != nevents; ++i)
+        {
+          consumer_proxy->push (events);
+        }
+      ACE_hrtime_t const send_end = ACE_OS::gethrtime ();
+
+      // Wait until all the events arrive, or no progress is made for
+      // a second (some datagrams may be dropped).
+      CORBA::ULong received = consumer_impl.count ();
+      for (;;)
+        {
+          ACE_OS::sleep (ACE_Time_Value (1, 0));
+          CORBA::ULong const now = consumer_impl.count ();
+          if (now == received || now >= CORBA::ULong (nevents))
+            {
+              received = now;
+              break;
+            }
+          received = now;
+        }
+      ACE_hrtime_t const recv_end =
+        received != 0 ? consumer_impl.last () : send_end;
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      double const send_usecs = double (send_end - start) / gsf;
+      double const recv_usecs = double (recv_end - start) / gsf;
+      CORBA::ULongLong const datagrams = sender->datagram_count ();
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "batch interval = %u usecs, mtu = %u, payload = %d bytes\n"
+                  "events sent = %d, events received = %u, datagrams = %Q\n"
+                  "sender: %.0f events/s, %.0f datagrams/s\n"
+                  "receiver: %.0f events/s\n",
+                  batch_interval, mtu, payload_size,
+                  nevents, received, datagrams,
+                  nevents * 1.0e6 / send_usecs,
+                  datagrams * 1.0e6 / send_usecs,
+                  received * 1.0e6 / recv_usecs));
+
+      consumer_proxy->disconnect_push_consumer ();
+      supplier_proxy->disconnect_push_supplier ();
+
+      receiver->shutdown ();
+      mcast_eh.shutdown ();
+      sender->shutdown ();
+
+      orb->shutdown (false);
+      orb_task.wait ();
+
+      supplier_ec->destroy ();
+      consumer_ec->destroy ();
+
+      poa->destroy (true, true);
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Mcast_Batching");
+      return 1;
+    }
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:s:b:m:a:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nevents = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        payload_size = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'b':
+        batch_interval = ACE_OS::strtoul (get_opts.opt_arg (), nullptr, 0);
+        break;
+
+      case 'm':
+        mtu = ACE_OS::strtoul (get_opts.opt_arg (), nullptr, 0);
+        break;
+
+      case 'a':
+        mcast_address = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Usage: %s "
+                           "-n events "
+                           "-s payload_size "
+                           "-b batch_interval (usecs, 0 disables) "
+                           "-m mtu "
+                           "-a mcast_address"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
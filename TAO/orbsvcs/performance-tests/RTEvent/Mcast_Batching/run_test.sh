@@ -0,0 +1,13 @@
+#! /bin/sh
+#
+# Compare the federation throughput with and without batching, for
+# a few event payload sizes.
+
+EVENTS=100000
+
+for s in 16 64 256; do
+  echo "Payload $s bytes, unbatched"
+  ./driver -n $EVENTS -s $s -b 0
+  echo "Payload $s bytes, batched"
+  ./driver -n $EVENTS -s $s -b 1000 -m 1400
+done
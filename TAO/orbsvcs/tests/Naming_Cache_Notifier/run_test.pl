@@ -0,0 +1,27 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $iorbase = "notifier.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+$server->DeleteFile ($iorbase);
+
+$SV = $server->CreateProcess ("server", "-o $server_iorfile");
+
+$test = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval() + 45);
+
+$server->DeleteFile ($iorbase);
+
+if ($test != 0) {
+    print STDERR "ERROR: test returned $test\n";
+    exit 1;
+}
+
+exit 0;
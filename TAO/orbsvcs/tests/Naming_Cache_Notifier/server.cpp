@@ -0,0 +1,159 @@
+/**
+ * @file server.cpp
+ *
+ * Start and stop a Naming Service with a resolve cache notifier twice
+ * in one process.  Each fini() has to withdraw the notifier from the
+ * naming contexts and deactivate it.  A client cache of zero entries
+ * has to resolve every name again.
+ */
+
+#include "orbsvcs/Naming/Naming_Server.h"
+#include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Naming/Naming_Context_Interface.h"
+#include "ace/ARGV.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_unistd.h"
+
+const ACE_TCHAR *ior_file = ACE_TEXT ("notifier.ior");
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_file = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <notifier_ior_file> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Check that a cache of zero entries does not hide a rebind.
+int
+check_zero_cache (CORBA::ORB_ptr orb)
+{
+  TAO_Naming_Client client;
+  if (client.init (orb) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: cannot reach the Naming Service\n"),
+                      1);
+
+  client.cache (ACE_Time_Value (60), 0);
+
+  CosNaming::Name name (1);
+  name.length (1);
+  name[0].id = CORBA::string_dup ("entry");
+
+  CosNaming::NamingContext_var first = client->new_context ();
+  CosNaming::NamingContext_var second = client->new_context ();
+
+  client->bind (name, first.in ());
+  CORBA::Object_var resolved = client.resolve (name);
+  client->rebind (name, second.in ());
+  resolved = client.resolve (name);
+  client->unbind (name);
+
+  first->destroy ();
+  second->destroy ();
+
+  if (!resolved->_is_equivalent (second.in ()))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: a cache of zero entries kept a reference\n"),
+                      1);
+  return 0;
+}
+
+/// Run a Naming Service with a notifier and stop it again.
+int
+run_once (CORBA::ORB_ptr orb, int round)
+{
+  ACE_OS::unlink (ior_file);
+
+  ACE_ARGV args;
+  args.add (ACE_TEXT ("Naming_Service"));
+  args.add (ACE_TEXT ("-i"));
+  args.add (ior_file);
+
+  TAO_Naming_Server server;
+  if (server.init_with_orb (args.argc (), args.argv (), orb) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: round %d: cannot start the Naming Service\n",
+                       round),
+                      1);
+
+  int status = 0;
+  if (TAO_Naming_Context::cache_notifier () == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: round %d: no notifier installed\n",
+                  round));
+      status = 1;
+    }
+
+  status |= check_zero_cache (orb);
+
+  ACE_TString ior (ACE_TEXT ("file://"));
+  ior += ior_file;
+  CORBA::Object_var notifier =
+    orb->string_to_object (ior.c_str ());
+
+  server.fini ();
+
+  if (TAO_Naming_Context::cache_notifier () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: round %d: notifier still installed after fini\n",
+                  round));
+      status = 1;
+    }
+
+  if (!notifier->_non_existent ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: round %d: notifier still active after fini\n",
+                  round));
+      status = 1;
+    }
+
+  ACE_OS::unlink (ior_file);
+  return status;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      for (int round = 1; round <= 2; ++round)
+        status |= run_once (orb.in (), round);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
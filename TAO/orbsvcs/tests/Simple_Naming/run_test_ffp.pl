@@ -98,7 +98,10 @@ $hostname = $test->HostName ();
 
 sub run_test
 {
-    $prog = "@_";
+    # The server executable and any extra server options, such as a
+    # journal size.
+    $prog = shift;
+    my $journal = "@_";
 
     $test_number = 0;
 
@@ -121,7 +124,7 @@ sub run_test
     # Run server and client for each of the tests.  Client uses ior in a
     # file to bootstrap to the server.
     foreach $o (@opts) {
-        name_server ($server_opts[$test_number]);
+        name_server ("$server_opts[$test_number] $journal");
 
         print STDERR "\n          ".$comments[$test_number];
 
@@ -156,10 +159,17 @@ sub run_test
 @server_exes = ("$ENV{TAO_ROOT}/orbsvcs/Naming_Service/tao_cosnaming",
                 "$ENV{TAO_ROOT}/orbsvcs/FT_Naming_Service/tao_ft_naming");
 
+# Rewrite each context file on every change, then journal the
+# changes with a small journal so that both appending and compacting
+# happen across the server restarts.
+@journal_opts = ("", "-j 2");
+
 foreach $e (@server_exes) {
-    print STDERR "Testing Naming Service Executable: $e\n";
-    run_test($e);
-    print STDERR "======================================\n";
+    foreach $j (@journal_opts) {
+        print STDERR "Testing Naming Service Executable: $e $j\n";
+        run_test($e, $j);
+        print STDERR "======================================\n";
+    }
 }
 
 exit $status;
@@ -0,0 +1,25 @@
+#include "Echo.h"
+#include "ace/OS_NS_unistd.h"
+
+Echo::Echo (CORBA::ORB_ptr orb, const ACE_Time_Value &delay)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , delay_ (delay)
+{
+}
+
+CORBA::LongLong
+Echo::ping (CORBA::LongLong value)
+{
+  if (this->delay_ != ACE_Time_Value::zero)
+    {
+      ACE_OS::sleep (this->delay_);
+    }
+
+  return value;
+}
+
+void
+Echo::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
@@ -0,0 +1,62 @@
+#include "Relay.h"
+
+Sync_Relay::Sync_Relay (CORBA::ORB_ptr orb,
+                        Test::Echo_ptr backend,
+                        bool shutdown_backend)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , backend_ (Test::Echo::_duplicate (backend))
+  , shutdown_backend_ (shutdown_backend)
+{
+}
+
+CORBA::LongLong
+Sync_Relay::ping (CORBA::LongLong value)
+{
+  return this->backend_->ping (value);
+}
+
+void
+Sync_Relay::shutdown ()
+{
+  if (this->shutdown_backend_)
+    {
+      this->backend_->shutdown ();
+    }
+
+  this->orb_->shutdown (false);
+}
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+Coroutine_Relay::Coroutine_Relay (CORBA::ORB_ptr orb,
+                                  Test::Echo_ptr backend,
+                                  bool shutdown_backend)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , backend_ (Test::Echo::_duplicate (backend))
+  , shutdown_backend_ (shutdown_backend)
+{
+}
+
+TAO::AMH_Task
+Coroutine_Relay::ping (Test::AMH_EchoResponseHandler_ptr _tao_rh,
+                       CORBA::LongLong value)
+{
+  // An exception of the backend goes back to the client as the reply.
+  CORBA::LongLong const result =
+    co_await this->backend_->async_ping (value);
+
+  _tao_rh->ping (result);
+}
+
+TAO::AMH_Task
+Coroutine_Relay::shutdown (Test::AMH_EchoResponseHandler_ptr)
+{
+  if (this->shutdown_backend_)
+    {
+      this->backend_->shutdown ();
+    }
+
+  this->orb_->shutdown (false);
+
+  co_return;
+}
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
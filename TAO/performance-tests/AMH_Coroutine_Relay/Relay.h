@@ -0,0 +1,68 @@
+
+#ifndef RELAY_H
+#define RELAY_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Forward each request to the backend with a synchronous call,
+/// which holds the thread that dispatched the request until the
+/// backend replies.
+class Sync_Relay
+  : public virtual POA_Test::Echo
+{
+public:
+  /// Constructor
+  Sync_Relay (CORBA::ORB_ptr orb,
+              Test::Echo_ptr backend,
+              bool shutdown_backend);
+
+  // = The skeleton methods
+  virtual CORBA::LongLong ping (CORBA::LongLong value);
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The server the requests are forwarded to.
+  Test::Echo_var backend_;
+
+  /// Shutdown the backend too.
+  bool const shutdown_backend_;
+};
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+/// Forward each request to the backend from a coroutine AMH upcall,
+/// which gives back the thread that dispatched the request while it
+/// awaits the reply of the backend.
+class Coroutine_Relay
+  : public virtual POA_Test::AMH_Echo
+{
+public:
+  /// Constructor
+  Coroutine_Relay (CORBA::ORB_ptr orb,
+                   Test::Echo_ptr backend,
+                   bool shutdown_backend);
+
+  // = The AMH skeleton methods
+  virtual TAO::AMH_Task ping (Test::AMH_EchoResponseHandler_ptr _tao_rh,
+                              CORBA::LongLong value);
+
+  virtual TAO::AMH_Task shutdown (Test::AMH_EchoResponseHandler_ptr _tao_rh);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The server the requests are forwarded to.
+  Test::Echo_var backend_;
+
+  /// Shutdown the backend too.
+  bool const shutdown_backend_;
+};
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+#include /**/ "ace/post.h"
+#endif /* RELAY_H */
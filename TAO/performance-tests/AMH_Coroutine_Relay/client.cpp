@@ -0,0 +1,175 @@
+//=============================================================================
+/**
+ *  @file   client.cpp
+ *
+ *  Drive the relay from a number of threads, each making synchronous
+ *  calls, and report the rate of requests the relay sustains.
+ *
+ *  Usage: client [-k ior] [-n requests] [-c clients] [-x]
+ */
+//=============================================================================
+
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Task.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include <vector>
+
+const ACE_TCHAR *ior = ACE_TEXT("file://relay.ior");
+int requests = 20000;
+int clients = 64;
+int do_shutdown = 1;
+
+int status = 0;
+
+/// A client making synchronous calls on its own thread.
+class Client_Task : public ACE_Task_Base
+{
+public:
+  Client_Task (Test::Echo_ptr echo, int count)
+    : echo_ (Test::Echo::_duplicate (echo))
+    , count_ (count)
+  {
+  }
+
+  virtual int svc ()
+  {
+    try
+      {
+        for (int i = 0; i != this->count_; ++i)
+          {
+            if (this->echo_->ping (i) != i)
+              {
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT ("ERROR: bad reply to %d\n"), i));
+                status = 1;
+              }
+          }
+      }
+    catch (const CORBA::Exception &ex)
+      {
+        ex._tao_print_exception ("Client_Task:");
+        status = 1;
+      }
+    return 0;
+  }
+
+private:
+  Test::Echo_var echo_;
+  int const count_;
+};
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:n:c:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        requests = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'c':
+        clients = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-n <requests> "
+                           "-c <clients> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return clients > 0 ? 0 : -1;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Echo_var echo =
+        Test::Echo::_narrow (object.in ());
+
+      if (CORBA::is_nil (echo.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Echo reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      int const per_client = requests / clients;
+      requests = per_client * clients;
+
+      // Set up the connections.
+      echo->ping (0);
+
+      std::vector<Client_Task *> tasks (clients);
+      for (int i = 0; i != clients; ++i)
+        tasks[i] = new Client_Task (echo.in (), per_client);
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+
+      for (int i = 0; i != clients; ++i)
+        tasks[i]->activate (THR_NEW_LWP | THR_JOINABLE);
+      for (int i = 0; i != clients; ++i)
+        tasks[i]->wait ();
+
+      timer.stop ();
+      ACE_hrtime_t elapsed;
+      timer.elapsed_time (elapsed);
+
+      for (int i = 0; i != clients; ++i)
+        delete tasks[i];
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("  %d requests from %d clients %10.0f requests/s\n"),
+                  requests,
+                  clients,
+                  double (requests) * 1.0e9 / double (elapsed)));
+
+      if (do_shutdown)
+        {
+          echo->shutdown ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,207 @@
+//=============================================================================
+/**
+ *  @file   relay.cpp
+ *
+ *  The middle tier, forwarding the requests of the client to the
+ *  backend either with synchronous calls from a pool of threads or
+ *  with the coroutine AMH upcalls tao_idl -GHcoro generates.
+ *
+ *  Usage: relay [-k backend ior] [-o iorfile] [-n threads] [-c] [-x]
+ */
+//=============================================================================
+
+#include "Relay.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/OS_NS_stdio.h"
+
+const ACE_TCHAR *backend_ior = ACE_TEXT("file://backend.ior");
+const ACE_TCHAR *ior_output_file = ACE_TEXT("relay.ior");
+int nthreads = 16;
+int use_coroutines = 0;
+int shutdown_backend = 1;
+
+/// Run the ORB event loop in a pool of threads.
+class Server_Task : public ACE_Task_Base
+{
+public:
+  Server_Task (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc ()
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception &)
+      {
+        return -1;
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:o:n:cx"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        backend_ior = get_opts.opt_arg ();
+        break;
+
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'c':
+        use_coroutines = 1;
+        break;
+
+      case 'x':
+        shutdown_backend = 0;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <backend ior> "
+                           "-o <iorfile> "
+                           "-n <nthreads> "
+                           "-c (coroutine AMH relay) "
+                           "-x (do not shutdown the backend) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return nthreads > 0 ? 0 : -1;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Unable to initialize the POA.\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (backend_ior);
+
+      Test::Echo_var backend =
+        Test::Echo::_narrow (object.in ());
+
+      if (CORBA::is_nil (backend.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Echo reference <%s>\n",
+                             backend_ior),
+                            1);
+        }
+
+      PortableServer::Servant relay_impl = 0;
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+      if (use_coroutines)
+        {
+          ACE_NEW_RETURN (relay_impl,
+                          Coroutine_Relay (orb.in (),
+                                           backend.in (),
+                                           shutdown_backend),
+                          1);
+        }
+#else
+      if (use_coroutines)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) relay - coroutines not available, ")
+                      ACE_TEXT ("build with C++20\n")));
+        }
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+      if (relay_impl == 0)
+        {
+          ACE_NEW_RETURN (relay_impl,
+                          Sync_Relay (orb.in (),
+                                      backend.in (),
+                                      shutdown_backend),
+                          1);
+        }
+      PortableServer::ServantBase_var owner_transfer (relay_impl);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (relay_impl);
+
+      object = root_poa->id_to_reference (id.in ());
+
+      CORBA::String_var ior =
+        orb->object_to_string (object.in ());
+
+      // Output the ior to the ior_output_file
+      FILE *output_file= ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open output file for writing IOR: %s",
+                           ior_output_file),
+                          1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      poa_manager->activate ();
+
+      Server_Task server_task (orb.in ());
+      if (server_task.activate (THR_NEW_LWP | THR_JOINABLE,
+                                nthreads) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot activate server threads\n"),
+                          1);
+
+      server_task.wait ();
+
+      ACE_DEBUG ((LM_DEBUG, "(%P|%t) relay - event loop finished\n"));
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
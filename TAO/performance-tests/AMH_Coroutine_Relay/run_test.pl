@@ -0,0 +1,143 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$requests = '20000';
+$clients = '64';
+$delay = '1000';
+
+foreach $i (@ARGV) {
+    if ($i eq '-nodelay') {
+        $delay = '0';
+    }
+}
+
+print STDERR "================ AMH coroutine relay vs thread pool relay test\n";
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $relay = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+my $client = PerlACE::TestTarget::create_target (3) || die "Create target 3 failed\n";
+
+my $backend_iorbase = "backend.ior";
+my $relay_iorbase = "relay.ior";
+my $server_iorfile = $server->LocalFile ($backend_iorbase);
+my $relay_backend_iorfile = $relay->LocalFile ($backend_iorbase);
+my $relay_iorfile = $relay->LocalFile ($relay_iorbase);
+my $client_iorfile = $client->LocalFile ($relay_iorbase);
+$server->DeleteFile($backend_iorbase);
+$relay->DeleteFile($backend_iorbase);
+$relay->DeleteFile($relay_iorbase);
+$client->DeleteFile($relay_iorbase);
+
+$SV = $server->CreateProcess ("server",
+                              "-n $clients -d $delay " .
+                              "-o $server_iorfile");
+$server_status = $SV->Spawn ();
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    exit 1;
+}
+
+if ($server->WaitForFileTimed ($backend_iorbase,
+                               $server->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($server->GetFile ($backend_iorbase) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+if ($relay->PutFile ($backend_iorbase) == -1) {
+    print STDERR "ERROR: cannot set file <$relay_backend_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+# The thread pool relay needs a thread for each client, the coroutine
+# relay runs on one.  The last relay shuts the backend down.
+@relays = (["THREADS", "-n $clients -x"],
+           ["COROUTINES", "-n 1 -c"]);
+
+foreach $r (@relays) {
+    my ($name, $args) = @$r;
+
+    print STDERR "Relay: $name\n";
+
+    $relay->DeleteFile($relay_iorbase);
+    $client->DeleteFile($relay_iorbase);
+
+    $RL = $relay->CreateProcess ("relay",
+                                 "$args -k file://$relay_backend_iorfile " .
+                                 "-o $relay_iorfile");
+
+    $CL = $client->CreateProcess ("client",
+                                  "-n $requests -c $clients " .
+                                  "-k file://$client_iorfile");
+
+    $relay_status = $RL->Spawn ();
+
+    if ($relay_status != 0) {
+        print STDERR "ERROR: relay returned $relay_status\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($relay->WaitForFileTimed ($relay_iorbase,
+                                  $relay->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$relay_iorfile>\n";
+        $RL->Kill (); $RL->TimedWait (1);
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($relay->GetFile ($relay_iorbase) == -1) {
+        print STDERR "ERROR: cannot retrieve file <$relay_iorfile>\n";
+        $RL->Kill (); $RL->TimedWait (1);
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+    if ($client->PutFile ($relay_iorbase) == -1) {
+        print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+        $RL->Kill (); $RL->TimedWait (1);
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 200);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $relay_status = $RL->WaitKill ($relay->ProcessStopWaitInterval());
+
+    if ($relay_status != 0) {
+        print STDERR "ERROR: relay returned $relay_status\n";
+        $status = 1;
+    }
+}
+
+$server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    $status = 1;
+}
+
+$server->DeleteFile($backend_iorbase);
+$relay->DeleteFile($backend_iorbase);
+$relay->DeleteFile($relay_iorbase);
+$client->DeleteFile($relay_iorbase);
+
+exit $status;
@@ -0,0 +1,32 @@
+
+#ifndef ECHO_H
+#define ECHO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+#include "ace/Time_Value.h"
+
+/// Implement the Test::Echo interface
+class Echo
+  : public virtual POA_Test::Echo
+{
+public:
+  /// Constructor
+  Echo (CORBA::ORB_ptr orb, const ACE_Time_Value &delay);
+
+  // = The skeleton methods
+  virtual CORBA::LongLong ping (CORBA::LongLong value);
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// How long each request takes, as if it waited for another
+  /// server.
+  ACE_Time_Value const delay_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* ECHO_H */
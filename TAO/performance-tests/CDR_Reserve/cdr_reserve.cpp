@@ -0,0 +1,219 @@
+//=============================================================================
+/**
+ *  @file   cdr_reserve.cpp
+ *
+ *  Time marshaling a large reply of records with strings and
+ *  sequences into a stream that grows as it is written, and into one
+ *  where the size of the reply, computed first, is reserved, as the
+ *  ORB does with -ORBCDRReserve; and count the memory allocations
+ *  each way takes.
+ *
+ *  Usage: cdr_reserve [-n iterations] [-i records]
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "tao/CDR.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include <cstdlib>
+#include <new>
+
+static unsigned long allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+static int iterations = 10000;
+static CORBA::ULong records = 100;
+
+static void
+make_reply (Test::RecordSeq &reply)
+{
+  reply.length (records);
+  for (CORBA::ULong i = 0; i != records; ++i)
+    {
+      char buf[32];
+      ACE_OS::snprintf (buf, sizeof buf, "record-%u", i);
+      reply[i].name = CORBA::string_dup (buf);
+      reply[i].id = static_cast<CORBA::Long> (i);
+
+      CORBA::ULong const nlabels = 1 + i % 5;
+      reply[i].labels.length (nlabels);
+      for (CORBA::ULong j = 0; j != nlabels; ++j)
+        {
+          reply[i].labels[j] = CORBA::string_dup ("a label of a record");
+        }
+
+      CORBA::ULong const nsamples = 10 + i % 50;
+      reply[i].samples.length (nsamples);
+      for (CORBA::ULong j = 0; j != nsamples; ++j)
+        {
+          reply[i].samples[j].time = j;
+          reply[i].samples[j].value = i * 0.5 + j;
+        }
+    }
+}
+
+/// Marshal @a reply as the return value of an operation, after a
+/// reply header, into a stream starting on a buffer of the stack.
+static void
+run (const Test::RecordSeq &reply, bool reserve, const ACE_TCHAR *what)
+{
+  TAO::Arg_Traits<Test::RecordSeq>::in_arg_val ret (reply);
+  TAO::Argument *args[] = { &ret };
+
+  size_t length = 0;
+  size_t blocks = 0;
+
+  unsigned long const allocations_before = allocations;
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      char repbuf[ACE_CDR::DEFAULT_BUFSIZE];
+      TAO_OutputCDR cdr (repbuf, sizeof repbuf);
+
+      // The GIOP and reply headers.
+      cdr.write_octet_array (reinterpret_cast<const CORBA::Octet *> ("GIOP"), 4);
+      cdr.write_ulong (0);
+      cdr.write_ulong (0);
+      cdr.write_ulong (static_cast<CORBA::ULong> (i));
+      cdr.write_ulong (0);
+      cdr.write_ulong (0);
+
+      if (reserve)
+        {
+          TAO::reserve_arguments (cdr, args, 1, 1);
+        }
+
+      if (!ret.marshal (cdr))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) marshal failed\n")));
+          return;
+        }
+
+      length = cdr.total_length ();
+      blocks = 0;
+      for (const ACE_Message_Block *mb = cdr.begin (); mb != 0; mb = mb->cont ())
+        ++blocks;
+    }
+
+  timer.stop ();
+  unsigned long const calls = allocations - allocations_before;
+
+  ACE_hrtime_t elapsed;
+  timer.elapsed_time (elapsed);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("  %-8s %8B octets in %3B blocks %8.1f allocations ")
+              ACE_TEXT ("%10.1f ns per reply\n"),
+              what,
+              length,
+              blocks,
+              double (calls) / double (iterations),
+              double (elapsed) / double (iterations)));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        records = static_cast<CORBA::ULong> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <iterations> "
+                           "-i <records> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  try
+    {
+      Test::RecordSeq reply;
+      make_reply (reply);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%d replies of %u records marshaled\n"),
+                  iterations, records));
+
+      // Once to warm up the heap.
+      run (reply, false, ACE_TEXT ("warmup"));
+      run (reply, false, ACE_TEXT ("grown"));
+      run (reply, true, ACE_TEXT ("reserved"));
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,226 @@
+//=============================================================================
+/**
+ *  @file   cdr_view.cpp
+ *
+ *  Time reading two members of an order received in CDR, by
+ *  demarshaling the whole struct, as skeletons do, and through the
+ *  view tao_idl generates with -Gview, which skips over the struct
+ *  and reads only what is accessed; and count the memory allocations
+ *  each way takes.
+ *
+ *  Usage: cdr_view [-n iterations] [-i items]
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "tao/CDR.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+#include <cstdlib>
+#include <new>
+
+static unsigned long allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+static int iterations = 100000;
+static CORBA::ULong items = 20;
+
+static void
+make_order (Test::Order &order)
+{
+  order.header.id = CORBA::string_dup ("order-0001-2024");
+  order.header.route.source = CORBA::string_dup ("warehouse north");
+  order.header.route.destination = CORBA::string_dup ("store 42 downtown");
+  order.header.route.hops = 3;
+  order.header.time = 1700000000;
+  order.note = CORBA::string_dup ("leave at the back door, ring twice");
+
+  order.items.length (items);
+  for (CORBA::ULong i = 0; i != items; ++i)
+    {
+      char buf[32];
+      ACE_OS::snprintf (buf, sizeof buf, "sku-%08u", i);
+      order.items[i].sku = CORBA::string_dup (buf);
+      order.items[i].quantity = 1 + i % 7;
+      order.items[i].price = 9.99 + i;
+
+      CORBA::ULong const ntags = 1 + i % 3;
+      order.items[i].tags.length (ntags);
+      for (CORBA::ULong j = 0; j != ntags; ++j)
+        {
+          order.items[i].tags[j] = CORBA::string_dup ("fragile");
+        }
+    }
+}
+
+/// Read the hops and the id of the order in @a data, @a decode-ing
+/// it whole or through a view.
+static void
+run (TAO_InputCDR &data, bool decode, const ACE_TCHAR *what)
+{
+  CORBA::Long checksum = 0;
+
+  unsigned long const allocations_before = allocations;
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      TAO_InputCDR cdr (data.rd_ptr (), data.length ());
+
+      if (decode)
+        {
+          Test::Order order;
+          if (!(cdr >> order))
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) decode failed\n")));
+              return;
+            }
+          checksum += order.header.route.hops
+                      + static_cast<CORBA::Long> (
+                          ACE_OS::strlen (order.header.id.in ()));
+        }
+      else
+        {
+          Test::Order_View order;
+          if (!order._tao_bind (cdr))
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) bind failed\n")));
+              return;
+            }
+          checksum += order.header ().route ().hops ()
+                      + static_cast<CORBA::Long> (
+                          ACE_OS::strlen (order.header ().id ()));
+        }
+    }
+
+  timer.stop ();
+  unsigned long const calls = allocations - allocations_before;
+
+  ACE_hrtime_t elapsed;
+  timer.elapsed_time (elapsed);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("  %-8s %8.1f allocations %10.1f ns per order ")
+              ACE_TEXT ("(checksum %d)\n"),
+              what,
+              double (calls) / double (iterations),
+              double (elapsed) / double (iterations),
+              checksum));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        items = static_cast<CORBA::ULong> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <iterations> "
+                           "-i <items> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  try
+    {
+      Test::Order order;
+      make_order (order);
+
+      TAO_OutputCDR out;
+      if (!(out << order))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) marshal failed\n")),
+                            1);
+        }
+
+      // In one block, as a request is received.
+      TAO_InputCDR data (out);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%d orders of %u items, %B octets, read\n"),
+                  iterations, items, data.length ()));
+
+      // Once to warm up the heap.
+      run (data, true, ACE_TEXT ("warmup"));
+      run (data, true, ACE_TEXT ("decode"));
+      run (data, false, ACE_TEXT ("view"));
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,275 @@
+//=============================================================================
+/**
+ *  @file   codeset_translators.cpp
+ *
+ *  Time writing strings to a stream and reading them back through
+ *  the UTF-8/Latin-1 and UTF-16 codeset translators, and through the
+ *  CDR streams themselves with two octet wchars, for mostly ASCII
+ *  text and for multilingual text, and check that the strings read
+ *  back are the ones written.
+ *
+ *  Usage: codeset_translators [-n iterations] [-l characters]
+ */
+//=============================================================================
+
+#include "tao/Codeset/UTF8_Latin1_Translator.h"
+#include "tao/Codeset/UTF16_BOM_Translator.h"
+#include "ace/CDR_Stream.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+#include <vector>
+
+static int iterations = 20000;
+static ACE_CDR::ULong characters = 4096;
+
+static int status = 0;
+
+/// Mostly ASCII text.
+static const char ascii_sample[] =
+  "The quick brown fox jumps over the lazy dog while the request "
+  "waits for its reply. ";
+
+/// Western European text in Latin-1, about a tenth of it accented.
+static const char latin1_sample[] =
+  "Gr\xF6\xDF" "enwahn, Stra\xDF" "enbahn und \xDC" "bermut; "
+  "d\xE9" "j\xE0" " vu \xE0" " la fran\xE7" "aise, \xE7" "a co\xFB" "te "
+  "cher; \xBF" "Qu\xE9" " a\xF1" "o? \xA1" "Ol\xE9" "! ";
+
+/// Greek, Russian, Japanese and English, in UTF-16 code units.
+static const ACE_UINT16 wide_sample[] =
+{
+  0x039A, 0x03B1, 0x03BB, 0x03B7, 0x03BC, 0x03AD, 0x03C1, 0x03B1, 0x0020,
+  0x03BA, 0x03CC, 0x03C3, 0x03BC, 0x03B5, 0x002C, 0x0020,
+  0x041F, 0x0440, 0x0438, 0x0432, 0x0435, 0x0442, 0x002C, 0x0020,
+  0x043C, 0x0438, 0x0440, 0x002C, 0x0020,
+  0x3053, 0x3093, 0x306B, 0x3061, 0x306F, 0x4E16, 0x754C, 0x002C, 0x0020,
+  0x0068, 0x0065, 0x006C, 0x006C, 0x006F, 0x0021, 0x0020
+};
+
+static void
+report (const ACE_TCHAR *what,
+        ACE_hrtime_t write_time,
+        ACE_hrtime_t read_time)
+{
+  // Characters per microsecond, from nanoseconds.
+  double const chars = double (characters) * double (iterations) * 1000.0;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("  %-34s write %8.1f  read %8.1f Mchars/s\n"),
+              what,
+              chars / double (write_time),
+              chars / double (read_time)));
+}
+
+/// Write @a s through @a translator, then read it back.
+static void
+run_string (ACE_Char_Codeset_Translator *translator,
+            const ACE_CDR::Char *s,
+            const ACE_TCHAR *what)
+{
+  ACE_OutputCDR out (2 * characters + 64,
+                     ACE_CDR::BYTE_ORDER_NATIVE,
+                     0, 0, 0,
+                     ACE_DEFAULT_CDR_MEMCPY_TRADEOFF,
+                     1, 2);
+  out.char_translator (translator);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      out.reset ();
+      out.write_string (characters, s);
+    }
+
+  timer.stop ();
+  ACE_hrtime_t write_time;
+  timer.elapsed_time (write_time);
+
+  ACE_CDR::Char *back = 0;
+  bool same = out.good_bit ();
+
+  timer.start ();
+
+  for (int i = 0; i != iterations && same; ++i)
+    {
+      ACE_InputCDR in (out.begin ()->rd_ptr (),
+                       out.length (),
+                       ACE_CDR::BYTE_ORDER_NATIVE,
+                       1, 2);
+      in.char_translator (translator);
+
+      delete [] back;
+      back = 0;
+      same = in.read_string (back);
+    }
+
+  timer.stop ();
+  ACE_hrtime_t read_time;
+  timer.elapsed_time (read_time);
+
+  if (!same
+      || ACE_OS::strlen (back) != characters
+      || ACE_OS::memcmp (back, s, characters) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: %s: string read back differs\n"),
+                  what));
+      status = 1;
+    }
+  delete [] back;
+
+  report (what, write_time, read_time);
+}
+
+/// Write @a s through @a translator, or through the streams if it
+/// is 0, then read it back.
+static void
+run_wstring (ACE_WChar_Codeset_Translator *translator,
+             const ACE_CDR::WChar *s,
+             const ACE_TCHAR *what)
+{
+  ACE_OutputCDR out (2 * characters + 64,
+                     ACE_CDR::BYTE_ORDER_NATIVE,
+                     0, 0, 0,
+                     ACE_DEFAULT_CDR_MEMCPY_TRADEOFF,
+                     1, 2);
+  out.wchar_translator (translator);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      out.reset ();
+      out.write_wstring (characters, s);
+    }
+
+  timer.stop ();
+  ACE_hrtime_t write_time;
+  timer.elapsed_time (write_time);
+
+  ACE_CDR::WChar *back = 0;
+  bool same = out.good_bit ();
+
+  timer.start ();
+
+  for (int i = 0; i != iterations && same; ++i)
+    {
+      ACE_InputCDR in (out.begin ()->rd_ptr (),
+                       out.length (),
+                       ACE_CDR::BYTE_ORDER_NATIVE,
+                       1, 2);
+      in.wchar_translator (translator);
+
+      delete [] back;
+      back = 0;
+      same = in.read_wstring (back);
+    }
+
+  timer.stop ();
+  ACE_hrtime_t read_time;
+  timer.elapsed_time (read_time);
+
+  if (!same
+      || ACE_OS::memcmp (back, s, characters * sizeof (ACE_CDR::WChar)) != 0
+      || back[characters] != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: %s: wstring read back differs\n"),
+                  what));
+      status = 1;
+    }
+  delete [] back;
+
+  report (what, write_time, read_time);
+}
+
+template <typename CHAR, typename SAMPLE>
+static std::vector<CHAR>
+repeat (const SAMPLE *sample, size_t sample_length)
+{
+  std::vector<CHAR> text (characters + 1);
+  for (ACE_CDR::ULong i = 0; i != characters; ++i)
+    {
+      text[i] = static_cast<CHAR> (sample[i % sample_length]);
+    }
+  text[characters] = 0;
+  return text;
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:l:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'l':
+        characters =
+          static_cast<ACE_CDR::ULong> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <iterations> "
+                           "-l <characters> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  std::vector<ACE_CDR::Char> const ascii =
+    repeat<ACE_CDR::Char> (ascii_sample, sizeof ascii_sample - 1);
+  std::vector<ACE_CDR::Char> const latin1 =
+    repeat<ACE_CDR::Char> (latin1_sample, sizeof latin1_sample - 1);
+  std::vector<ACE_CDR::WChar> const wide_ascii =
+    repeat<ACE_CDR::WChar> (ascii_sample, sizeof ascii_sample - 1);
+  std::vector<ACE_CDR::WChar> const wide =
+    repeat<ACE_CDR::WChar> (wide_sample,
+                            sizeof wide_sample / sizeof wide_sample[0]);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d strings of %u characters written and read\n"),
+              iterations, characters));
+
+  TAO_UTF8_Latin1_Translator utf8_latin1;
+  run_string (&utf8_latin1, &ascii[0], ACE_TEXT ("UTF-8/Latin-1, ASCII"));
+  run_string (&utf8_latin1, &latin1[0], ACE_TEXT ("UTF-8/Latin-1, Latin-1"));
+
+  TAO_UTF16_BOM_Translator utf16 (false);
+  run_wstring (&utf16, &wide_ascii[0], ACE_TEXT ("UTF-16, ASCII"));
+  run_wstring (&utf16, &wide[0], ACE_TEXT ("UTF-16, multilingual"));
+
+  TAO_UTF16_BOM_Translator utf16_be (true);
+  run_wstring (&utf16_be, &wide_ascii[0], ACE_TEXT ("UTF-16 big endian, ASCII"));
+  run_wstring (&utf16_be, &wide[0],
+               ACE_TEXT ("UTF-16 big endian, multilingual"));
+
+  size_t const maxbytes = ACE_OutputCDR::wchar_maxbytes ();
+  ACE_OutputCDR::wchar_maxbytes (2);
+  run_wstring (0, &wide_ascii[0], ACE_TEXT ("CDR 2 octet wchar, ASCII"));
+  run_wstring (0, &wide[0], ACE_TEXT ("CDR 2 octet wchar, multilingual"));
+  ACE_OutputCDR::wchar_maxbytes (maxbytes);
+
+  return status;
+}
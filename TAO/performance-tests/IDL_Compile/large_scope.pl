@@ -0,0 +1,100 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+#
+# Times compiling an IDL module with many declarations, each of which
+# refers to earlier ones, with a quarter, half and all of them, to show
+# how the time grows with the size of a scope.
+#
+# Usage: large_scope.pl [-n declarations] [-o output directory]
+
+use Getopt::Std;
+use File::Path;
+use File::Spec;
+use Time::HiRes qw(time);
+
+my %opts = ('n' => 50000, 'o' => 'generated');
+getopts ('n:o:', \%opts)
+  || die "usage: $0 [-n declarations] [-o output directory]\n";
+
+my $tao_idl = "$ENV{ACE_ROOT}/bin/tao_idl";
+if (exists $ENV{HOST_ROOT}) {
+    $tao_idl = "$ENV{HOST_ROOT}/bin/tao_idl";
+}
+
+my $output = $opts{'o'};
+my $status = 0;
+
+# Write a module of about $n declarations to $file: groups of a
+# struct holding a sequence of an earlier one, a sequence of it, a
+# constant, an enum with its two values and an interface using them
+# all, and a nested module referring back to the outer one.
+sub generate
+{
+    my ($file, $n) = @_;
+
+    open (my $idl, '>', $file) || die "ERROR: cannot create $file: $!\n";
+
+    print $idl "module Large\n{\n";
+
+    my $i = 0;
+    for (my $decls = 0; $decls < $n; $decls += 7, ++$i) {
+        my $before = $i > 0 ? ' S' . int ($i / 2) . 'Seq before;' : '';
+        print $idl
+          "  struct S$i { long id;$before };\n",
+          "  typedef sequence<S$i> S${i}Seq;\n",
+          "  const long C$i = $i;\n",
+          "  enum E$i { E${i}_a, E${i}_b };\n",
+          "  interface I$i\n",
+          "  {\n",
+          "    S$i get (in S${i}Seq all, in E$i which, in long at);\n",
+          "  };\n";
+    }
+
+    print $idl
+      "  module Inner\n",
+      "  {\n",
+      "    typedef S0 First;\n",
+      "    typedef Large::S", $i - 1, " Last;\n",
+      "    const long Sum = C0 + C", $i - 1, ";\n",
+      "  };\n",
+      "};\n";
+
+    close ($idl);
+}
+
+printf "%-14s %10s\n", 'declarations', 'seconds';
+
+foreach my $n (int ($opts{'n'} / 4), int ($opts{'n'} / 2), $opts{'n'}) {
+    rmtree ($output);
+    mkpath ($output);
+
+    my $file = File::Spec->catfile ($output, "large_scope_$n.idl");
+    generate ($file, $n);
+
+    # Keep the GPERF warnings off the report.
+    open (OLDOUT, ">&STDOUT");
+    open (OLDERR, ">&STDERR");
+    open (STDOUT, ">" . File::Spec->devnull ());
+    open (STDERR, ">&STDOUT");
+
+    my $start = time;
+    my $result = system ($tao_idl, '-o', $output, $file);
+    my $elapsed = time - $start;
+
+    open (STDOUT, ">&OLDOUT");
+    open (STDERR, ">&OLDERR");
+
+    if ($result != 0) {
+        print STDERR "ERROR: tao_idl failed on $n declarations\n";
+        $status = 1;
+    }
+
+    printf "%-14d %10.2f\n", $n, $elapsed;
+}
+
+rmtree ($output);
+
+exit $status;
@@ -0,0 +1,106 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+#
+# Times compiling TAO's own .pidl files with tao_idl: one process per
+# file, as the build does, then all files in one run, and all files in
+# parallel processes, with the external preprocessor and the builtin
+# one.
+#
+# Usage: run_test.pl [-j jobs] [-o output directory]
+
+use Getopt::Std;
+use File::Find;
+use File::Path;
+use File::Spec;
+use Time::HiRes qw(time);
+
+my %opts = ('j' => 4, 'o' => 'generated');
+getopts ('j:o:', \%opts) || die "usage: $0 [-j jobs] [-o output directory]\n";
+
+my $tao_idl = "$ENV{ACE_ROOT}/bin/tao_idl";
+if (exists $ENV{HOST_ROOT}) {
+    $tao_idl = "$ENV{HOST_ROOT}/bin/tao_idl";
+}
+
+# Installed along with TAO but never compiled.
+my %install_only = map { $_ => 1 } ('InterfaceDef.pidl',
+                                    'InvalidName.pidl',
+                                    'Object_Key.pidl',
+                                    'Typecode_types.pidl',
+                                    'WrongTransaction.pidl');
+
+my @files;
+find (sub {
+          push @files, $File::Find::name
+            if /\.pidl$/ && !$install_only{$_};
+      },
+      "$ENV{TAO_ROOT}/tao");
+@files = sort @files;
+
+my $output = $opts{'o'};
+my @flags = ('-Sorb', '-SS', '-Sci', '-Gp', '-Gd',
+             "-I$ENV{TAO_ROOT}", '-o', $output);
+
+my $status = 0;
+
+# Run tao_idl with @_ on each file, or on all of them in one run,
+# and return the seconds it took.
+sub compile
+{
+    my $per_file = shift;
+    my @args = (@flags, @_);
+
+    rmtree ($output);
+    mkpath ($output);
+
+    # Keep the GPERF warnings off the report.
+    open (OLDOUT, ">&STDOUT");
+    open (OLDERR, ">&STDERR");
+    open (STDOUT, ">" . File::Spec->devnull ());
+    open (STDERR, ">&STDOUT");
+
+    my $failed = 0;
+    my $start = time;
+
+    if ($per_file) {
+        foreach my $file (@files) {
+            $failed += system ($tao_idl, @args, $file) != 0;
+        }
+    }
+    else {
+        $failed += system ($tao_idl, @args, @files) != 0;
+    }
+
+    my $elapsed = time - $start;
+
+    open (STDOUT, ">&OLDOUT");
+    open (STDERR, ">&OLDERR");
+
+    if ($failed != 0) {
+        print STDERR "ERROR: tao_idl @_ failed\n";
+        $status = 1;
+    }
+
+    return $elapsed;
+}
+
+printf "Compiling %d .pidl files\n", scalar (@files);
+
+foreach my $run (['cpp, one process per file', 1],
+                 ['builtin cpp, one process per file', 1, '--builtin-cpp'],
+                 ['cpp, one run', 0],
+                 ['builtin cpp, one run', 0, '--builtin-cpp'],
+                 ["builtin cpp, $opts{'j'} jobs", 0,
+                  '--builtin-cpp', '--jobs', $opts{'j'}]) {
+    my ($what, @args) = @$run;
+    my $elapsed = compile (@args);
+    printf "  %-36s %8.2f s %8.1f files/s\n",
+           $what, $elapsed, scalar (@files) / $elapsed;
+}
+
+rmtree ($output);
+
+exit $status;
@@ -2,7 +2,7 @@
 #include "Client_Task.h"
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
-#include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/High_Res_Timer.h"
 #include "ace/SString.h"
 
@@ -36,7 +36,9 @@ Client_Task::svc (void)
         this->remote_ref_->test_method (test_time);
 
       // Start for actual Measurements
-      ACE_Sample_History history (niterations);
+      ACE_HDR_Histogram histogram;
+      ACE_Basic_Stats stats;
+      stats.histogram (&histogram);
 
       ACE_hrtime_t test_start = ACE_OS::gethrtime ();
       for (int itercounter = 0; itercounter < niterations; ++itercounter)
@@ -46,7 +48,7 @@ Client_Task::svc (void)
           (void) this->remote_ref_->test_method (start);
 
           ACE_hrtime_t now = ACE_OS::gethrtime ();
-          history.sample (now - start);
+          stats.sample (now - start);
         }
 
       ACE_hrtime_t test_end = ACE_OS::gethrtime ();
@@ -58,8 +60,6 @@ Client_Task::svc (void)
         ACE_High_Res_Timer::global_scale_factor ();
       ACE_DEBUG ((LM_DEBUG, "done\n"));
 
-      ACE_Basic_Stats stats;
-      history.collect_basic_stats (stats);
       stats.dump_results (ACE_TEXT("Total"), gsf);
 
       ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -5,6 +5,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 #include "tao/Strategies/advanced_resource.h"
@@ -105,7 +106,12 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           (void) roundtrip->test_method (start);
         }
 
-      ACE_Sample_History history (niterations);
+      ACE_HDR_Histogram histogram;
+      ACE_Basic_Stats stats;
+      stats.histogram (&histogram);
+
+      // Keep every sample only when they are dumped.
+      ACE_Sample_History history (do_dump_history ? niterations : 0);
 
       ACE_hrtime_t test_start = ACE_OS::gethrtime ();
       for (int i = 0; i < niterations; ++i)
@@ -115,6 +121,7 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           (void) roundtrip->test_method (start);
 
           ACE_hrtime_t now = ACE_OS::gethrtime ();
+          stats.sample (now - start);
           history.sample (now - start);
         }
 
@@ -132,8 +139,6 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           history.dump_samples (ACE_TEXT("HISTORY"), gsf);
         }
 
-      ACE_Basic_Stats stats;
-      history.collect_basic_stats (stats);
       stats.dump_results (ACE_TEXT("Total"), gsf);
 
       ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
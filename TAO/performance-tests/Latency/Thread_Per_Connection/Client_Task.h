@@ -35,6 +35,9 @@ private:
   /// The number of iterations
   int niterations_;
 
+  /// The latency percentiles
+  ACE_HDR_Histogram histogram_;
+
   /// Keep track of the latency (minimum, average, maximum and jitter)
   ACE_Basic_Stats latency_;
 };
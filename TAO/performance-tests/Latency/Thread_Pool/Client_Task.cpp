@@ -6,6 +6,7 @@ Client_Task::Client_Task (Test::Roundtrip_ptr roundtrip,
   : roundtrip_ (Test::Roundtrip::_duplicate (roundtrip))
   , niterations_ (niterations)
 {
+  this->latency_.histogram (&this->histogram_);
 }
 
 int
@@ -5,6 +5,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 #include "tao/Strategies/advanced_resource.h"
@@ -80,7 +81,12 @@ parse_args (int argc, ACE_TCHAR *argv[])
 void
 test_octet_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::octet_load ol (sz);
   ol.length (sz);
@@ -93,6 +99,7 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_octet_method (ol, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -110,8 +117,6 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -123,7 +128,12 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_long_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::long_load ll (sz);
   ll.length (sz);
@@ -136,6 +146,7 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_long_method (ll, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -153,8 +164,6 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -166,7 +175,12 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_short_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::short_load sl (sz);
   sl.length (sz);
@@ -179,6 +193,7 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_short_method (sl, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -196,8 +211,6 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -209,7 +222,12 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_char_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::char_load cl (sz);
   cl.length (sz);
@@ -222,6 +240,7 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_char_method (cl, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -239,8 +258,6 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -252,7 +269,12 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::longlong_load ll (sz);
   ll.length (sz);
@@ -265,6 +287,7 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_longlong_method (ll, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -282,8 +305,6 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -295,7 +316,12 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_double_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::double_load dl (sz);
   dl.length (sz);
@@ -308,6 +334,7 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
       (void) roundtrip->test_double_method (dl, start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -325,8 +352,6 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
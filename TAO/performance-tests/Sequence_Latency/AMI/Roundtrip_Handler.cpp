@@ -4,6 +4,7 @@
 Roundtrip_Handler::Roundtrip_Handler (int expected_callbacks)
   : pending_callbacks_ (expected_callbacks)
 {
+  this->latency_stats_.histogram (&this->histogram_);
 }
 
 int
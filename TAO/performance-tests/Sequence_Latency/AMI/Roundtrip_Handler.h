@@ -54,6 +54,9 @@ private:
   /// The number of callbacks not received yet
   int pending_callbacks_;
 
+  /// The latency percentiles
+  ACE_HDR_Histogram histogram_;
+
   /// Collect the latency results
   ACE_Basic_Stats latency_stats_;
 };
@@ -11,6 +11,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
@@ -83,7 +84,12 @@ parse_args (int argc, ACE_TCHAR *argv[])
 void
 test_octet_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::octet_load ol (sz);
   ol.length (sz);
@@ -104,6 +110,7 @@ test_octet_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -121,8 +128,6 @@ test_octet_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -133,7 +138,12 @@ test_octet_seq (const CORBA::Object_var object)
 void
 test_long_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::long_load ll (sz);
   ll.length (sz);
@@ -153,6 +163,7 @@ test_long_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -170,8 +181,6 @@ test_long_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -182,7 +191,12 @@ test_long_seq (const CORBA::Object_var object)
 void
 test_short_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::short_load sl (sz);
   sl.length (sz);
@@ -202,6 +216,7 @@ test_short_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -219,8 +234,6 @@ test_short_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -231,7 +244,12 @@ test_short_seq (const CORBA::Object_var object)
 void
 test_char_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::char_load cl (sz);
   cl.length (sz);
@@ -251,6 +269,7 @@ test_char_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -268,8 +287,6 @@ test_char_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -280,7 +297,12 @@ test_char_seq (const CORBA::Object_var object)
 void
 test_double_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::double_load dl (sz);
   dl.length (sz);
@@ -300,6 +322,7 @@ test_double_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -317,8 +340,6 @@ test_double_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -329,7 +350,12 @@ test_double_seq (const CORBA::Object_var object)
 void
 test_longlong_seq (const CORBA::Object_var object)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::longlong_load ll (sz);
   ll.length (sz);
@@ -349,6 +375,7 @@ test_longlong_seq (const CORBA::Object_var object)
       request->invoke ();
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -366,8 +393,6 @@ test_longlong_seq (const CORBA::Object_var object)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
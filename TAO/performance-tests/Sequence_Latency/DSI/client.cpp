@@ -6,6 +6,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 #include "tao/Strategies/advanced_resource.h"
@@ -77,7 +78,12 @@ parse_args (int argc, ACE_TCHAR *argv[])
 void
 test_octet_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::octet_load ol (sz);
   ol.length (sz);
@@ -91,6 +97,7 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
                                            start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -108,8 +115,6 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -120,7 +125,12 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_long_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::long_load ll (sz);
   ll.length (sz);
@@ -134,6 +144,7 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
                                           start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -151,8 +162,6 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -164,7 +173,12 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_short_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::short_load sl (sz);
   sl.length (sz);
@@ -178,6 +192,7 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
                                            start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -195,8 +210,6 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -208,7 +221,12 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_char_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::char_load cl (sz);
   cl.length (sz);
@@ -222,6 +240,7 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
                                           start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -239,8 +258,6 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -252,7 +269,12 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::longlong_load ll (sz);
   ll.length (sz);
@@ -266,6 +288,7 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
                                               start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -283,8 +306,6 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -296,7 +317,12 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_double_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::double_load dl (sz);
   dl.length (sz);
@@ -310,6 +336,7 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
                                             start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -327,8 +354,6 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
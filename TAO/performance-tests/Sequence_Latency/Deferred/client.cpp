@@ -13,6 +13,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
@@ -93,7 +94,12 @@ parse_args (int argc, ACE_TCHAR *argv[])
 int
 test_octet_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::octet_load ol (sz);
   ol.length (sz);
@@ -129,6 +135,7 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -149,8 +156,6 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -163,7 +168,12 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
 int
 test_long_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::long_load ll (sz);
   ll.length (sz);
@@ -199,6 +209,7 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -219,8 +230,6 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -233,7 +242,12 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
 int
 test_short_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::short_load sl (sz);
   sl.length (sz);
@@ -269,6 +283,7 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -289,8 +304,6 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -303,7 +316,12 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
 int
 test_char_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::char_load cl (sz);
   cl.length (sz);
@@ -339,6 +357,7 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -359,8 +378,6 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -373,7 +390,12 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
 int
 test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::longlong_load ll (sz);
   ll.length (sz);
@@ -409,6 +431,7 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -429,8 +452,6 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -443,7 +464,12 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 int
 test_double_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::double_load dl (sz);
   dl.length (sz);
@@ -479,6 +505,7 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
           if ((request[j]->return_value () >>= retval) == 1)
             {
               ACE_hrtime_t now = ACE_OS::gethrtime ();
+              stats.sample (ACE_HRTIME_TO_U64(now) - retval);
               history.sample (ACE_HRTIME_TO_U64(now) - retval);
             }
         }
@@ -499,8 +526,6 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -1,4 +1,5 @@
 #include "Roundtrip.h"
+#include "ace/OS_NS_stdio.h"
 
 Roundtrip::Roundtrip (CORBA::ORB_ptr orb)
   : orb_ (CORBA::ORB::_duplicate (orb))
@@ -40,6 +41,33 @@ Roundtrip::test_double_method (const Test::double_load &,
   return send_time;
 }
 
+Test::Timestamp
+Roundtrip::test_point_method (const Test::point_load &,
+                              Test::Timestamp send_time)
+{
+  return send_time;
+}
+
+
+Test::record_load *
+Roundtrip::test_record_method (CORBA::ULong length,
+                               Test::Timestamp)
+{
+  if (this->records_.length () != length)
+    {
+      this->records_.length (length);
+      for (CORBA::ULong i = 0; i < length; ++i)
+        {
+          char name[32];
+          ACE_OS::snprintf (name, sizeof name, "record %u", i);
+          this->records_[i].name = CORBA::string_dup (name);
+          this->records_[i].id = static_cast<CORBA::Long> (i);
+          this->records_[i].value = i * 0.5;
+        }
+    }
+
+  return new Test::record_load (this->records_);
+}
 
 Test::Timestamp
 Roundtrip::test_short_method (const Test::short_load &,
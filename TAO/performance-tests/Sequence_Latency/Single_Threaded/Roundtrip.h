@@ -38,12 +38,21 @@ public:
   Test::Timestamp test_double_method (const Test::double_load& ol,
                                       Test::Timestamp send_time);
 
+  Test::Timestamp test_point_method (const Test::point_load& ol,
+                                     Test::Timestamp send_time);
+
+  Test::record_load * test_record_method (CORBA::ULong length,
+                                          Test::Timestamp send_time);
+
   virtual void shutdown (void);
 
 private:
   /// Use an ORB reference to convert strings to objects and shutdown
   /// the application.
   CORBA::ORB_var orb_;
+
+  /// The records returned by test_record_method().
+  Test::record_load records_;
 };
 
 #if defined(_MSC_VER)
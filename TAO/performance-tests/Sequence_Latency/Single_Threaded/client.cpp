@@ -5,6 +5,7 @@
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
 #include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 #include "tao/Strategies/advanced_resource.h"
@@ -38,6 +39,8 @@ parse_args (int argc, ACE_TCHAR *argv[])
             ACE_OS::strcmp (data_type, ACE_TEXT("long")) != 0 &&
             ACE_OS::strcmp (data_type, ACE_TEXT("short")) != 0 &&
             ACE_OS::strcmp (data_type, ACE_TEXT("double")) != 0 &&
+            ACE_OS::strcmp (data_type, ACE_TEXT("point")) != 0 &&
+            ACE_OS::strcmp (data_type, ACE_TEXT("record")) != 0 &&
             ACE_OS::strcmp (data_type, ACE_TEXT("longlong")) != 0)
           return -1;
         break;
@@ -77,7 +80,12 @@ parse_args (int argc, ACE_TCHAR *argv[])
 void
 test_octet_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::octet_load ol (sz);
   ol.length (sz);
@@ -92,6 +100,7 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
 
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -109,8 +118,6 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -121,7 +128,12 @@ test_octet_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_long_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::long_load ll (sz);
   ll.length (sz);
@@ -135,6 +147,7 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
                                           start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -152,8 +165,6 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -164,7 +175,12 @@ test_long_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_short_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::short_load sl (sz);
   sl.length (sz);
@@ -177,6 +193,7 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
                                            start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -194,8 +211,6 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -206,7 +221,12 @@ test_short_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_char_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::char_load cl (sz);
   cl.length (sz);
@@ -220,6 +240,7 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
                                           start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -237,8 +258,6 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -249,7 +268,12 @@ test_char_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::longlong_load ll (sz);
   ll.length (sz);
@@ -264,6 +288,7 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
                                               start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -281,8 +306,6 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
-  ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -293,7 +316,12 @@ test_longlong_seq (Test::Roundtrip_ptr roundtrip)
 void
 test_double_seq (Test::Roundtrip_ptr roundtrip)
 {
-  ACE_Sample_History history (niterations);
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
 
   Test::double_load dl (sz);
   dl.length (sz);
@@ -308,6 +336,60 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
                                             start);
 
       ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
+      history.sample (now - start);
+    }
+
+  ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+  ACE_DEBUG ((LM_DEBUG, "test finished\n"));
+
+  ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+  ACE_High_Res_Timer::global_scale_factor_type gsf =
+    ACE_High_Res_Timer::global_scale_factor ();
+  ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+  if (do_dump_history)
+    {
+      history.dump_samples (ACE_TEXT("HISTORY"), gsf);
+    }
+
+  stats.dump_results (ACE_TEXT("Total"), gsf);
+
+  ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                         test_end - test_start,
+                                         stats.samples_count ());
+}
+
+void
+test_point_seq (Test::Roundtrip_ptr roundtrip)
+{
+  ACE_HDR_Histogram histogram;
+  ACE_Basic_Stats stats;
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
+
+  Test::point_load pl (sz);
+  pl.length (sz);
+  for (int j = 0; j < sz; ++j)
+    {
+      pl[j].x = j;
+      pl[j].y = j * 0.5;
+      pl[j].z = -j;
+    }
+
+  ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+  for (int i = 0; i < niterations; ++i)
+    {
+      ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+      (void) roundtrip->test_point_method (pl,
+                                           start);
+
+      ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
       history.sample (now - start);
     }
 
@@ -325,8 +407,51 @@ test_double_seq (Test::Roundtrip_ptr roundtrip)
       history.dump_samples (ACE_TEXT("HISTORY"), gsf);
     }
 
+  stats.dump_results (ACE_TEXT("Total"), gsf);
+
+  ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                         test_end - test_start,
+                                         stats.samples_count ());
+}
+
+void
+test_record_seq (Test::Roundtrip_ptr roundtrip)
+{
+  ACE_HDR_Histogram histogram;
   ACE_Basic_Stats stats;
-  history.collect_basic_stats (stats);
+  stats.histogram (&histogram);
+
+  // Keep every sample only when they are dumped.
+  ACE_Sample_History history (do_dump_history ? niterations : 0);
+
+  ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+  for (int i = 0; i < niterations; ++i)
+    {
+      ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+      Test::record_load_var rl =
+        roundtrip->test_record_method (sz,
+                                       start);
+
+      ACE_hrtime_t now = ACE_OS::gethrtime ();
+      stats.sample (now - start);
+      history.sample (now - start);
+    }
+
+  ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+  ACE_DEBUG ((LM_DEBUG, "test finished\n"));
+
+  ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+  ACE_High_Res_Timer::global_scale_factor_type gsf =
+    ACE_High_Res_Timer::global_scale_factor ();
+  ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+  if (do_dump_history)
+    {
+      history.dump_samples (ACE_TEXT("HISTORY"), gsf);
+    }
+
   stats.dump_results (ACE_TEXT("Total"), gsf);
 
   ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
@@ -412,6 +537,14 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
         {
           test_longlong_seq (roundtrip.in ());
         }
+      else if (ACE_OS::strcmp (data_type, ACE_TEXT("point")) == 0)
+        {
+          test_point_seq (roundtrip.in ());
+        }
+      else if (ACE_OS::strcmp (data_type, ACE_TEXT("record")) == 0)
+        {
+          test_record_seq (roundtrip.in ());
+        }
 
       if (do_shutdown)
         {
@@ -10,6 +10,7 @@ Client_Task::Client_Task (const ACE_TCHAR *data_type,
   , roundtrip_ (Test::Roundtrip::_duplicate (roundtrip))
   , niterations_ (niterations)
 {
+  this->latency_.histogram (&this->histogram_);
 }
 
 int
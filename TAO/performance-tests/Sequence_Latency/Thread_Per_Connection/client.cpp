@@ -140,7 +140,9 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
         ACE_High_Res_Timer::global_scale_factor ();
       ACE_DEBUG ((LM_DEBUG, "done\n"));
 
+      ACE_HDR_Histogram histogram;
       ACE_Basic_Stats totals;
+      totals.histogram (&histogram);
       task0.accumulate_and_dump (totals, ACE_TEXT("Task[0]"), gsf);
       task1.accumulate_and_dump (totals, ACE_TEXT("Task[1]"), gsf);
       task2.accumulate_and_dump (totals, ACE_TEXT("Task[2]"), gsf);
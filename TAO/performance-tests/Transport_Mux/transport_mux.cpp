@@ -0,0 +1,298 @@
+//=============================================================================
+/**
+ *  @file   transport_mux.cpp
+ *
+ *  Time the muxed and the active demux transport mux strategies
+ *  binding requests and dispatching their replies on one connection
+ *  with many requests outstanding, as AMI clients have them.  Some
+ *  threads take request ids and bind a reply dispatcher to each,
+ *  keeping a window of requests outstanding between them, while the
+ *  main thread dispatches the replies in the order each thread sent
+ *  its requests, like the thread reading the connection does; no
+ *  requests are sent.
+ *
+ *  Usage: transport_mux [-n requests] [-w outstanding] [-t threads]
+ */
+//=============================================================================
+
+#include "tao/Active_Demux_TMS.h"
+#include "tao/Muxed_TMS.h"
+#include "tao/IIOP_Transport.h"
+#include "tao/Client_Strategy_Factory.h"
+#include "tao/ORB_Core.h"
+#include "tao/Pluggable_Messaging_Utils.h"
+#include "tao/Reply_Dispatcher.h"
+#include "tao/ORB.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Intrusive_Auto_Ptr.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/Task.h"
+
+#include <atomic>
+#include <vector>
+
+static int requests = 1000000;
+static int outstanding = 1000;
+static int threads = 4;
+
+static int status = 0;
+
+/// Count the replies dispatched to it.
+class Reply_Counter : public TAO_Reply_Dispatcher
+{
+public:
+  Reply_Counter () : replies_ (0) {}
+
+  virtual int dispatch_reply (TAO_Pluggable_Reply_Params &)
+  {
+    ++this->replies_;
+    return 1;
+  }
+
+  virtual void reply_timed_out () {}
+  virtual void connection_closed () {}
+
+  long replies_;
+};
+
+/// A transport that is never connected, for the strategies to find
+/// the ORB through.
+class Unconnected_Transport : public TAO_IIOP_Transport
+{
+public:
+  Unconnected_Transport (TAO_ORB_Core *orb_core)
+    : TAO_IIOP_Transport (0, orb_core)
+  {
+  }
+
+  virtual ~Unconnected_Transport () {}
+};
+
+/**
+ * Take request ids and bind them, handing the ids to the main thread
+ * through a ring of its share of the outstanding requests.
+ */
+class Invoker : public ACE_Task_Base
+{
+public:
+  Invoker ()
+    : tms_ (0)
+    , count_ (0)
+    , head_ (0)
+    , tail_ (0)
+  {
+  }
+
+  void init (TAO_Transport_Mux_Strategy *tms, int count, int window)
+  {
+    this->tms_ = tms;
+    this->count_ = count;
+    this->ring_.assign (window, 0);
+    this->head_ = 0;
+    this->tail_ = 0;
+    this->rd_ =
+      ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> (new Reply_Counter, false);
+  }
+
+  virtual int svc ()
+  {
+    size_t const window = this->ring_.size ();
+    ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (this->rd_.get ());
+
+    for (int i = 0; i != this->count_; ++i)
+      {
+        size_t const head = this->head_.load (std::memory_order_relaxed);
+        while (head - this->tail_.load (std::memory_order_acquire) == window)
+          ACE_OS::thr_yield ();
+
+        CORBA::ULong const id = this->tms_->request_id ();
+        if (this->tms_->bind_dispatcher (id, rd) != 0)
+          {
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("ERROR: bind of %u failed\n"), id));
+            status = 1;
+          }
+
+        this->ring_[head % window] = id;
+        this->head_.store (head + 1, std::memory_order_release);
+      }
+    return 0;
+  }
+
+  /// Dispatch the replies to the requests bound so far; return how
+  /// many there were.
+  int dispatch (TAO_Pluggable_Reply_Params &params)
+  {
+    size_t const window = this->ring_.size ();
+    size_t tail = this->tail_.load (std::memory_order_relaxed);
+    size_t const head = this->head_.load (std::memory_order_acquire);
+    int const n = static_cast<int> (head - tail);
+
+    for (; tail != head; ++tail)
+      {
+        params.request_id_ = this->ring_[tail % window];
+        if (this->tms_->dispatch_reply (params) != 1)
+          {
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("ERROR: reply %u not dispatched\n"),
+                        params.request_id_));
+            status = 1;
+          }
+      }
+
+    this->tail_.store (tail, std::memory_order_release);
+    return n;
+  }
+
+  long replies () const
+  {
+    return static_cast<Reply_Counter *> (this->rd_.get ())->replies_;
+  }
+
+private:
+  TAO_Transport_Mux_Strategy *tms_;
+  int count_;
+  std::vector<CORBA::ULong> ring_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd_;
+};
+
+static void
+run (TAO_Transport_Mux_Strategy *tms,
+     TAO_Transport *transport,
+     const ACE_TCHAR *what)
+{
+  std::vector<Invoker> invokers (threads);
+  int const per_thread = requests / threads;
+  int const window = outstanding / threads > 0 ? outstanding / threads : 1;
+
+  for (int i = 0; i != threads; ++i)
+    invokers[i].init (tms, per_thread, window);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != threads; ++i)
+    invokers[i].activate ();
+
+  TAO_Pluggable_Reply_Params params (transport);
+  long dispatched = 0;
+  long const total = static_cast<long> (per_thread) * threads;
+
+  while (dispatched != total)
+    {
+      int n = 0;
+      for (int i = 0; i != threads; ++i)
+        n += invokers[i].dispatch (params);
+
+      if (n == 0)
+        ACE_OS::thr_yield ();
+      dispatched += n;
+    }
+
+  for (int i = 0; i != threads; ++i)
+    invokers[i].wait ();
+
+  timer.stop ();
+  ACE_hrtime_t elapsed;
+  timer.elapsed_time (elapsed);
+
+  for (int i = 0; i != threads; ++i)
+    if (invokers[i].replies () != per_thread)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("ERROR: %s: thread %d got %d replies, not %d\n"),
+                    what, i, static_cast<int> (invokers[i].replies ()),
+                    per_thread));
+        status = 1;
+      }
+
+  if (tms->has_request ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: %s: requests left bound\n"), what));
+      status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("  %-14s %10.0f requests/s\n"),
+              what,
+              double (total) * 1.0e9 / double (elapsed)));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:w:t:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        requests = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'w':
+        outstanding = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 't':
+        threads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <requests> "
+                           "-w <outstanding> "
+                           "-t <threads> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return threads > 0 ? 0 : -1;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      TAO_ORB_Core *orb_core = orb->orb_core ();
+
+      {
+        Unconnected_Transport transport (orb_core);
+
+        ACE_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("%d requests from %d threads, %d outstanding, ")
+                    ACE_TEXT ("reply dispatcher table size %d\n"),
+                    requests, threads, outstanding,
+                    orb_core->client_factory ()->reply_dispatcher_table_size ()));
+
+        {
+          TAO_Muxed_TMS muxed (&transport);
+          run (&muxed, &transport, ACE_TEXT ("MUXED"));
+        }
+
+        {
+          TAO_Active_Demux_TMS active_demux (&transport);
+          run (&active_demux, &transport, ACE_TEXT ("ACTIVE_DEMUX"));
+        }
+      }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,198 @@
+//=============================================================================
+/**
+ *  @file   value_move.cpp
+ *
+ *  Time passing a message made of strings, sequences and a union
+ *  through a queue, by copy and by move, and count the memory
+ *  allocations each way takes.
+ *
+ *  Usage: value_move [-n iterations] [-i items]
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+static unsigned long allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  ++allocations;
+  void *p = std::malloc (size != 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+static int iterations = 100000;
+static CORBA::ULong items = 16;
+
+static const CORBA::ULong queue_depth = 8;
+
+static void
+make_message (Test::Message &message)
+{
+  message.topic = CORBA::string_dup ("performance-tests/Value_Move");
+  message.items.length (items);
+  for (CORBA::ULong i = 0; i != items; ++i)
+    {
+      char buf[32];
+      ACE_OS::snprintf (buf, sizeof buf, "item-%u", i);
+      message.items[i].name = CORBA::string_dup (buf);
+      message.items[i].value = CORBA::string_dup ("a value long enough to matter");
+      message.items[i].id = static_cast<CORBA::Long> (i);
+    }
+
+  Test::ItemSeq body (message.items);
+  message.body.items (body);
+}
+
+/// Pass copies of @a prototype through a queue and out again, by
+/// copy or by move.
+static void
+run (const Test::Message &prototype, bool move, const ACE_TCHAR *what)
+{
+  Test::MessageSeq queue;
+  queue.length (queue_depth);
+  CORBA::ULong total = 0;
+
+  unsigned long const allocations_before = allocations;
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      // Producing the message costs the same both ways.
+      Test::Message message (prototype);
+      CORBA::ULong const slot = static_cast<CORBA::ULong> (i) % queue_depth;
+
+      if (move)
+        {
+          queue[slot] = std::move (message);
+          Test::Message received (std::move (queue[slot]));
+          total += received.items.length ();
+        }
+      else
+        {
+          queue[slot] = message;
+          Test::Message received (queue[slot]);
+          total += received.items.length ();
+        }
+    }
+
+  timer.stop ();
+  unsigned long const calls = allocations - allocations_before;
+
+  ACE_hrtime_t elapsed;
+  timer.elapsed_time (elapsed);
+
+  if (total != static_cast<CORBA::ULong> (iterations) * items)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) lost items\n")));
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("  %-6s %8.1f allocations %10.1f ns per message\n"),
+              what,
+              double (calls) / double (iterations),
+              double (elapsed) / double (iterations)));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        items = static_cast<CORBA::ULong> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <iterations> "
+                           "-i <items> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  try
+    {
+      Test::Message prototype;
+      make_message (prototype);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%d messages of %u items and a union, ")
+                  ACE_TEXT ("queued and received\n"),
+                  iterations, items));
+
+      // Once to warm up the heap.
+      run (prototype, false, ACE_TEXT ("warmup"));
+      run (prototype, false, ACE_TEXT ("copy"));
+      run (prototype, true, ACE_TEXT ("move"));
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
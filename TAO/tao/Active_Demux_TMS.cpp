@@ -0,0 +1,390 @@
+#include "tao/Active_Demux_TMS.h"
+#include "tao/Reply_Dispatcher.h"
+#include "tao/debug.h"
+#include "tao/Transport.h"
+#include "tao/ORB_Core.h"
+#include "tao/Client_Strategy_Factory.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// The number of slots for a reply dispatcher table of @a size,
+  /// less one.
+  CORBA::ULong
+  slot_mask (int size)
+  {
+    CORBA::ULong slots = TAO_ACTIVE_DEMUX_TABLE_SIZE;
+    while (size > 0 && slots < static_cast<CORBA::ULong> (size))
+      slots <<= 1;
+    return slots - 1;
+  }
+}
+
+TAO_Active_Demux_TMS::TAO_Active_Demux_TMS (TAO_Transport *transport)
+  : TAO_Transport_Mux_Strategy (transport)
+    , lock_ (nullptr)
+    , request_sequence_ (0)
+    , orb_core_ (transport->orb_core ())
+    , slots_ (nullptr)
+    , slot_mask_ (slot_mask (this->orb_core_->client_factory ()->reply_dispatcher_table_size ()))
+    , outstanding_ (0)
+    , overflow_size_ (0)
+    , overflow_table_ (this->orb_core_->client_factory ()->reply_dispatcher_table_size ())
+{
+  this->lock_ =
+    this->orb_core_->client_factory ()->create_transport_mux_strategy_lock ();
+}
+
+TAO_Active_Demux_TMS::~TAO_Active_Demux_TMS ()
+{
+  Slot *const slots = this->slots_.load (std::memory_order_acquire);
+
+  if (slots != nullptr)
+    {
+      for (CORBA::ULong i = 0; i <= this->slot_mask_; ++i)
+        {
+          CORBA::ULong const state =
+            slots[i].state_.load (std::memory_order_acquire);
+          if (state != FREE && state != CLAIMED)
+            TAO_Reply_Dispatcher::intrusive_remove_ref (slots[i].rd_);
+        }
+      delete [] slots;
+    }
+
+  delete this->lock_;
+}
+
+CORBA::ULong
+TAO_Active_Demux_TMS::request_id ()
+{
+  // if TAO_Transport::bidirectional_flag_
+  //  ==  1 --> originating side
+  //  ==  0 --> other side
+  //  == -1 --> no bi-directional connection was negotiated
+  // The originating side must have an even request ID, and the other
+  // side must have an odd request ID.  The sequence number goes in
+  // the bits above the parity.
+  CORBA::ULong const parity =
+    this->transport_->bidirectional_flag () == 0 ? 1 : 0;
+
+  CORBA::ULong id = FREE;
+  do
+    {
+      CORBA::ULong const sequence =
+        this->request_sequence_.fetch_add (1, std::memory_order_relaxed);
+      id = (sequence << 1) | parity;
+    }
+  while (id == FREE || id == CLAIMED);
+
+  if (TAO_debug_level > 4)
+    TAOLIB_DEBUG ((LM_DEBUG,
+                "TAO (%P|%t) - Active_Demux_TMS[%d]::request_id, [%d]\n",
+                this->transport_->id (),
+                id));
+
+  return id;
+}
+
+TAO_Active_Demux_TMS::Slot *
+TAO_Active_Demux_TMS::slots ()
+{
+  Slot *slots = this->slots_.load (std::memory_order_acquire);
+
+  if (slots == nullptr)
+    {
+      Slot *fresh = nullptr;
+      ACE_NEW_RETURN (fresh,
+                      Slot[this->slot_mask_ + 1],
+                      nullptr);
+
+      for (CORBA::ULong i = 0; i <= this->slot_mask_; ++i)
+        {
+          fresh[i].state_.store (FREE, std::memory_order_relaxed);
+          fresh[i].rd_ = nullptr;
+        }
+
+      // Another thread binding its first request may have been first.
+      if (this->slots_.compare_exchange_strong (slots,
+                                                fresh,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+        slots = fresh;
+      else
+        delete [] fresh;
+    }
+
+  return slots;
+}
+
+/// Bind the dispatcher with the request id.
+int
+TAO_Active_Demux_TMS::bind_dispatcher (
+  CORBA::ULong request_id,
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd)
+{
+  if (rd == nullptr)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::bind_dispatcher, ")
+                      ACE_TEXT ("null reply dispatcher\n")));
+        }
+      return 0;
+    }
+
+  Slot *const slots = this->slots ();
+
+  if (slots != nullptr)
+    {
+      Slot &slot = slots[(request_id >> 1) & this->slot_mask_];
+      CORBA::ULong expected = FREE;
+
+      if (slot.state_.compare_exchange_strong (expected,
+                                               CLAIMED,
+                                               std::memory_order_acquire))
+        {
+          TAO_Reply_Dispatcher::intrusive_add_ref (rd.get ());
+          slot.rd_ = rd.get ();
+          ++this->outstanding_;
+
+          // Publishing the id makes the dispatcher visible to the
+          // thread reading the reply.
+          slot.state_.store (request_id, std::memory_order_release);
+          return 0;
+        }
+    }
+
+  // The slot is still taken by an earlier request.
+  ACE_GUARD_RETURN (ACE_Lock,
+                    ace_mon,
+                    *this->lock_,
+                    -1);
+
+  int const result = this->overflow_table_.bind (request_id, rd);
+
+  if (result != 0)
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_ERROR ((LM_ERROR,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::bind_dispatcher, ")
+                    ACE_TEXT ("bind dispatcher failed: result = %d, request id [%d]\n"),
+                    result, request_id));
+
+      return -1;
+    }
+
+  ++this->outstanding_;
+  ++this->overflow_size_;
+
+  return 0;
+}
+
+int
+TAO_Active_Demux_TMS::unbind_i (CORBA::ULong request_id,
+                                ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> &rd)
+{
+  Slot *const slots = this->slots_.load (std::memory_order_acquire);
+
+  if (slots != nullptr && request_id != FREE && request_id != CLAIMED)
+    {
+      Slot &slot = slots[(request_id >> 1) & this->slot_mask_];
+      CORBA::ULong expected = request_id;
+
+      if (slot.state_.compare_exchange_strong (expected,
+                                               CLAIMED,
+                                               std::memory_order_acquire))
+        {
+          // Adopt the reference the slot held.
+          rd = ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> (slot.rd_, false);
+          slot.rd_ = nullptr;
+          --this->outstanding_;
+
+          slot.state_.store (FREE, std::memory_order_release);
+          return 0;
+        }
+    }
+
+  if (this->overflow_size_.load (std::memory_order_acquire) == 0)
+    return -1;
+
+  ACE_GUARD_RETURN (ACE_Lock,
+                    ace_mon,
+                    *this->lock_,
+                    -1);
+
+  if (this->overflow_table_.unbind (request_id, rd) != 0)
+    return -1;
+
+  --this->overflow_size_;
+  --this->outstanding_;
+
+  return 0;
+}
+
+int
+TAO_Active_Demux_TMS::unbind_dispatcher (CORBA::ULong request_id)
+{
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+
+  return this->unbind_i (request_id, rd);
+}
+
+bool
+TAO_Active_Demux_TMS::has_request ()
+{
+  return this->outstanding_.load (std::memory_order_acquire) > 0;
+}
+
+int
+TAO_Active_Demux_TMS::dispatch_reply (TAO_Pluggable_Reply_Params &params)
+{
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+
+  // Grab the reply dispatcher for this id.
+  int result = this->unbind_i (params.request_id_, rd);
+
+  if (result == 0 && rd)
+    {
+      if (TAO_debug_level > 8)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::dispatch_reply, ")
+                    ACE_TEXT ("id [%d]\n"),
+                    params.request_id_));
+
+      // Dispatch the reply.
+      // They return 1 on success, and -1 on failure.
+      result = rd->dispatch_reply (params);
+    }
+  else
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::dispatch_reply, ")
+                    ACE_TEXT ("unbind dispatcher failed, id [%d], result = %d\n"),
+                    params.request_id_,
+                    result));
+
+      // The reply was either not ours or it timed out; forget about
+      // it.
+      result = 0;
+    }
+
+  return result;
+}
+
+int
+TAO_Active_Demux_TMS::reply_timed_out (CORBA::ULong request_id)
+{
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+
+  // Grab the reply dispatcher for this id.
+  int const result = this->unbind_i (request_id, rd);
+
+  if (result == 0 && rd)
+    {
+      if (TAO_debug_level > 8)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::reply_timed_out, ")
+                      ACE_TEXT ("id [%d]\n"),
+                      request_id));
+        }
+
+      // The reference taken keeps the reply dispatcher alive even if
+      // a follower thread timed out and unwound its stack.
+      rd->reply_timed_out ();
+    }
+  else
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Active_Demux_TMS::reply_timed_out, ")
+                    ACE_TEXT ("unbind dispatcher failed, id [%d] result = %d\n"),
+                    request_id,
+                    result));
+    }
+
+  return 0;
+}
+
+bool
+TAO_Active_Demux_TMS::idle_after_send ()
+{
+  // Irrespective of whether we are successful or not we need to
+  // return true. If *this* class is not successful in idling the
+  // transport no one can.
+  if (this->transport_ != nullptr)
+    (void) this->transport_->make_idle ();
+
+  return true;
+}
+
+bool
+TAO_Active_Demux_TMS::idle_after_reply ()
+{
+  return false;
+}
+
+void
+TAO_Active_Demux_TMS::connection_closed ()
+{
+  ACE_Unbounded_Stack <ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> > ubs;
+
+  Slot *const slots = this->slots_.load (std::memory_order_acquire);
+
+  if (slots != nullptr)
+    {
+      for (CORBA::ULong i = 0; i <= this->slot_mask_; ++i)
+        {
+          CORBA::ULong const state =
+            slots[i].state_.load (std::memory_order_acquire);
+
+          if (state == FREE || state == CLAIMED)
+            continue;
+
+          ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+          if (this->unbind_i (state, rd) == 0 && rd)
+            ubs.push (rd);
+        }
+    }
+
+  if (this->overflow_size_.load (std::memory_order_acquire) > 0)
+    {
+      ACE_GUARD (ACE_Lock,
+                 ace_mon,
+                 *this->lock_);
+
+      REQUEST_DISPATCHER_TABLE::ITERATOR const end =
+        this->overflow_table_.end ();
+
+      for (REQUEST_DISPATCHER_TABLE::ITERATOR i =
+             this->overflow_table_.begin ();
+           i != end;
+           ++i)
+        {
+          ubs.push ((*i).int_id_);
+          --this->outstanding_;
+        }
+
+      this->overflow_table_.unbind_all ();
+      this->overflow_size_ = 0;
+    }
+
+  // Tell the reply dispatchers outside the lock, they may unbind
+  // other requests.
+  size_t const sz = ubs.size ();
+
+  for (size_t k = 0 ; k != sz ; ++k)
+    {
+      ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+
+      if (ubs.pop (rd) == 0)
+        {
+          rd->connection_closed ();
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
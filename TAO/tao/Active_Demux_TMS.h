@@ -0,0 +1,159 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Active_Demux_TMS.h
+ *
+ *  A muxed transport strategy that finds the reply dispatcher of a
+ *  request from its request id, without locking.
+ */
+//=============================================================================
+
+
+#ifndef TAO_ACTIVE_DEMUX_TMS_H
+#define TAO_ACTIVE_DEMUX_TMS_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Transport_Mux_Strategy.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+template <class X> class ACE_Intrusive_Auto_Ptr;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_ORB_Core;
+class TAO_Pluggable_Reply_Params;
+class TAO_Reply_Dispatcher;
+
+/**
+ * @class TAO_Active_Demux_TMS
+ *
+ * Like TAO_Muxed_TMS this strategy lets a single connection have
+ * multiple outstanding requests, but it uses the request id as an
+ * active demux key instead of looking it up in a locked table.
+ *
+ * Request ids are taken from an atomic sequence, shifted left by one
+ * to keep the even or odd parity bidirectional connections need.  The
+ * low bits of the sequence number select a slot in a table of
+ * reply dispatchers, and the slot holds the whole request id, so
+ * that a late reply for an earlier request mapping to the same slot
+ * is told apart.  Binding, dispatching and unbinding claim a slot
+ * with a compare and swap.
+ *
+ * A request whose slot is still taken by an earlier one, because
+ * more requests are outstanding than there are slots, goes to a
+ * table guarded by the transport mux strategy lock instead.  The
+ * number of slots is the reply dispatcher table size, rounded up to
+ * a power of two, but at least TAO_ACTIVE_DEMUX_TABLE_SIZE.  They
+ * are allocated when the first request is bound, so that transports
+ * which never send requests do not pay for them.
+ */
+class TAO_Export TAO_Active_Demux_TMS : public TAO_Transport_Mux_Strategy
+{
+public:
+  /// Constructor.
+  TAO_Active_Demux_TMS (TAO_Transport *transport);
+
+  /// Destructor.
+  virtual ~TAO_Active_Demux_TMS ();
+
+  /// Generate and return an unique request id for the current
+  /// invocation.
+  virtual CORBA::ULong request_id ();
+
+  // = Please read the documentation in the TAO_Transport_Mux_Strategy
+  //   class.
+  virtual int bind_dispatcher (CORBA::ULong request_id,
+                               ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd);
+  virtual int unbind_dispatcher (CORBA::ULong request_id);
+
+  virtual int dispatch_reply (TAO_Pluggable_Reply_Params &params);
+  virtual int reply_timed_out (CORBA::ULong request_id);
+
+  virtual bool idle_after_send ();
+  virtual bool idle_after_reply ();
+  virtual void connection_closed ();
+  virtual bool has_request ();
+
+private:
+  void operator= (const TAO_Active_Demux_TMS &);
+  TAO_Active_Demux_TMS (const TAO_Active_Demux_TMS &);
+
+  /// A reply dispatcher bound to a request id.
+  struct Slot
+  {
+    /// The request id bound, or one of FREE and CLAIMED.
+    std::atomic<CORBA::ULong> state_;
+
+    /// The reply dispatcher bound, holding a reference to it.
+    TAO_Reply_Dispatcher *rd_;
+  };
+
+  /// State of a slot with no reply dispatcher bound.  No request id
+  /// takes this value.
+  static const CORBA::ULong FREE = 0;
+
+  /// State of a slot being bound or unbound.  No request id takes
+  /// this value either.
+  static const CORBA::ULong CLAIMED = ~static_cast<CORBA::ULong> (0);
+
+  /// Return the slots, allocating them on first use.
+  Slot *slots ();
+
+  /// Take the reply dispatcher bound to @a request_id out of the
+  /// slots or the overflow table.  Returns 0 if it was found and -1
+  /// otherwise.
+  int unbind_i (CORBA::ULong request_id,
+                ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> &rd);
+
+private:
+  /// Lock to protect the overflow table.
+  ACE_Lock *lock_;
+
+  /// Sequence number of the next request id.
+  std::atomic<CORBA::ULong> request_sequence_;
+
+  /// Keep track of the orb core pointer.
+  TAO_ORB_Core * const orb_core_;
+
+  /// The slots, or nullptr before the first request is bound.
+  std::atomic<Slot *> slots_;
+
+  /// The number of slots less one, the number being a power of two.
+  CORBA::ULong const slot_mask_;
+
+  /// Number of requests bound, in the slots or in the overflow table.
+  std::atomic<size_t> outstanding_;
+
+  /// Number of requests bound in the overflow table, so that finding
+  /// a request in the slots only has to take the lock when some are.
+  std::atomic<size_t> overflow_size_;
+
+  typedef ACE_Hash_Map_Manager_Ex <CORBA::ULong,
+                                   ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher>,
+                                   ACE_Hash <CORBA::ULong>,
+                                   ACE_Equal_To <CORBA::ULong>,
+                                   ACE_Null_Mutex>
+    REQUEST_DISPATCHER_TABLE;
+
+  /// Table of <Request ID, Reply Dispatcher> pairs whose slot was
+  /// taken when they were bound.
+  REQUEST_DISPATCHER_TABLE overflow_table_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_ACTIVE_DEMUX_TMS_H */
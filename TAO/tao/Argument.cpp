@@ -1,4 +1,6 @@
 #include "tao/Argument.h"
+#include "tao/CDR.h"
+#include "ace/CDR_Size.h"
 #include "ace/OS_Memory.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -19,6 +21,12 @@ TAO::Argument::demarshal (TAO_InputCDR &)
   return true;
 }
 
+CORBA::Boolean
+TAO::Argument::marshal_size (ACE_SizeCDR &)
+{
+  return true;
+}
+
 TAO::Argument *
 TAO::Argument::clone ()
 {
@@ -68,4 +76,40 @@ TAO::Void_Return_Argument::clone ()
   return clone_arg;
 }
 
+void
+TAO::reserve_arguments (TAO_OutputCDR &cdr,
+                        TAO::Argument * const *args,
+                        size_t nargs,
+                        ACE_CDR::ULong threshold)
+{
+  if (threshold == 0)
+    {
+      return;
+    }
+
+  ACE_CDR::Octet major = 0;
+  ACE_CDR::Octet minor = 0;
+  cdr.ACE_OutputCDR::get_version (major, minor);
+
+  // Start sizing where the stream is, so that the arguments are
+  // padded as they will be when marshaled.
+  size_t const start = cdr.current_alignment () % ACE_CDR::MAX_ALIGNMENT;
+  ACE_SizeCDR sizer (major, minor);
+  sizer.adjust (start, 1);
+
+  for (size_t i = 0; i != nargs; ++i)
+    {
+      if (!args[i]->marshal_size (sizer))
+        {
+          return;
+        }
+    }
+
+  size_t const size = sizer.total_length () - start;
+  if (sizer.good_bit () && size >= threshold)
+    {
+      cdr.reserve (size);
+    }
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -24,6 +24,10 @@
 #include /**/ "tao/TAO_Export.h"
 #include "tao/ParameterModeC.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_SizeCDR;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace CORBA
@@ -65,6 +69,16 @@ namespace TAO
      */
     virtual CORBA::Boolean demarshal (TAO_InputCDR &);
 
+    /// Add the size of what marshal() writes to the given CDR size
+    /// stream.
+    /**
+     * Returns @c false when the size cannot be known without
+     * marshaling the argument.
+     * @note The default implementation adds nothing, as the default
+     *       marshal() writes nothing, and returns @c true.
+     */
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
+
     /// Template method to clone a TAO Argument
     virtual Argument* clone ();
 
@@ -138,6 +152,16 @@ namespace TAO
   public:
     virtual Argument* clone ();
   };
+
+  /// Make room in @a cdr for the @a nargs arguments at @a args to be
+  /// marshaled with one allocation, when the size of all of them is
+  /// known beforehand and at least @a threshold octets.  Otherwise,
+  /// and always when @a threshold is 0, the stream grows as they are
+  /// marshaled.
+  TAO_Export void reserve_arguments (TAO_OutputCDR &cdr,
+                                     Argument * const *args,
+                                     size_t nargs,
+                                     ACE_CDR::ULong threshold);
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
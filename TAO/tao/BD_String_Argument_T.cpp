@@ -2,6 +2,7 @@
 #define TAO_BD_STRING_ARGUMENT_T_CPP
 
 #include "tao/BD_String_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 #include "tao/SystemException.h"
 
 #if !defined (__ACE_INLINE__)
@@ -24,6 +25,15 @@ TAO::In_BD_String_Argument_T<S_var,BOUND,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_var,
+         size_t BOUND,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_BD_String_Argument_T<S_var,BOUND,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
@@ -85,6 +95,15 @@ TAO::Inout_BD_String_Argument_T<S_var,BOUND,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_var,
+         size_t BOUND,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_BD_String_Argument_T<S_var,BOUND,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S_var,
          size_t BOUND,
          template <typename> class Insert_Policy>
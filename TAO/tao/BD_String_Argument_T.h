@@ -42,6 +42,7 @@ namespace TAO
     In_BD_String_Argument_T (const typename S_var::s_traits::char_type * x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
 
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
@@ -89,6 +90,7 @@ namespace TAO
     Inout_BD_String_Argument_T (typename S_var::s_traits::char_type *& x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
     virtual CORBA::Boolean demarshal (TAO_InputCDR &cdr);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
@@ -2,6 +2,7 @@
 #define TAO_BASIC_ARGUMENT_T_CPP
 
 #include "tao/Basic_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 
 #if !defined (__ACE_INLINE__)
 #include "tao/Basic_Argument_T.inl"
@@ -17,6 +18,14 @@ TAO::In_Basic_Argument_T<S, Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Basic_Argument_T<S, Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -62,6 +71,14 @@ TAO::Inout_Basic_Argument_T<S, Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Basic_Argument_T<S, Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -36,6 +36,7 @@ namespace TAO
     In_Basic_Argument_T (S const & x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
 #endif /* TAO_HAS_INTERCEPTORS == 1 */
@@ -80,6 +81,7 @@ namespace TAO
     Inout_Basic_Argument_T (S & x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
     virtual CORBA::Boolean demarshal (TAO_InputCDR &);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
@@ -0,0 +1,178 @@
+#ifndef guard_cdr_bulk_traits_hpp
+#define guard_cdr_bulk_traits_hpp
+/**
+ * @file
+ *
+ * @brief Marshal arrays of fixed size structs as one block when their
+ * layout in memory is their layout in CDR.
+ *
+ * A struct whose members are all of fixed size primitive types, with
+ * no padding other than the padding CDR puts between them, looks the
+ * same in memory as in a CDR stream of the same byte order.  Booleans,
+ * chars and wide chars are left out: the stream may store them
+ * differently, through its codeset translators for chars.  tao_idl
+ * specializes CDR_Bulk_Traits for such structs, and sequences and
+ * arrays of them are then copied to and from the stream with one
+ * memcpy(), or one pass swapping the bytes of every field when the
+ * stream has the other byte order and the stream swaps (see
+ * ACE_ENABLE_SWAP_ON_WRITE and ACE_DISABLE_SWAP_ON_READ), instead of
+ * one call per field.
+ */
+
+#include "tao/Basic_Types.h"
+#include "ace/OS_NS_string.h"
+#include "ace/CDR_Size.h"
+
+#include <cstddef>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Types are marshaled one at a time unless tao_idl specializes this
+   * template for them, with:
+   *
+   * - @c is_bulk true when the layout of the type in memory, checked
+   *   by the C++ compiler, is the one tao_idl computed for CDR;
+   * - @c alignment the CDR alignment of the first member, which is
+   *   the largest of the type;
+   * - @c swap (orig, target, length) copying @a length values from
+   *   @a orig to @a target swapping the bytes of every field.
+   */
+  template<typename T>
+  struct CDR_Bulk_Traits
+  {
+    static bool const is_bulk = false;
+  };
+
+  namespace details
+  {
+#if defined (ACE_LACKS_CDR_ALIGNMENT)
+    template<typename T, bool bulk = false>
+#else
+    template<typename T, bool bulk = CDR_Bulk_Traits<T>::is_bulk>
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+    struct cdr_value_array
+    {
+      template<typename stream>
+      static bool write (stream &strm, T const *buffer, CORBA::ULong length)
+      {
+        for (CORBA::ULong i = 0; i < length; ++i)
+          {
+            if (!(strm << buffer[i]))
+              {
+                return false;
+              }
+          }
+        return true;
+      }
+
+      template<typename stream>
+      static bool read (stream &strm, T *buffer, CORBA::ULong length)
+      {
+        for (CORBA::ULong i = 0; i < length; ++i)
+          {
+            if (!(strm >> buffer[i]))
+              {
+                return false;
+              }
+          }
+        return true;
+      }
+    };
+
+    template<typename T>
+    struct cdr_value_array<T, true>
+    {
+      static bool write (ACE_SizeCDR &strm, T const *, CORBA::ULong length)
+      {
+        if (length != 0)
+          {
+            strm.adjust (sizeof (T) * length, CDR_Bulk_Traits<T>::alignment);
+          }
+        return strm.good_bit ();
+      }
+
+      template<typename stream>
+      static bool write (stream &strm, T const *buffer, CORBA::ULong length)
+      {
+        if (length == 0)
+          {
+            return true;
+          }
+
+        char *buf = 0;
+        if (strm.adjust (sizeof (T) * length,
+                         CDR_Bulk_Traits<T>::alignment,
+                         buf) != 0)
+          {
+            return false;
+          }
+
+#if defined (ACE_ENABLE_SWAP_ON_WRITE)
+        if (strm.do_byte_swap ())
+          {
+            CDR_Bulk_Traits<T>::swap (reinterpret_cast<char const *> (buffer),
+                                      buf,
+                                      length);
+            return true;
+          }
+#endif /* ACE_ENABLE_SWAP_ON_WRITE */
+        ACE_OS::memcpy (buf, buffer, sizeof (T) * length);
+        return true;
+      }
+
+      template<typename stream>
+      static bool read (stream &strm, T *buffer, CORBA::ULong length)
+      {
+        if (length == 0)
+          {
+            return true;
+          }
+
+        char *buf = 0;
+        if (strm.adjust (sizeof (T) * length,
+                         CDR_Bulk_Traits<T>::alignment,
+                         buf) != 0)
+          {
+            return false;
+          }
+
+#if !defined (ACE_DISABLE_SWAP_ON_READ)
+        if (strm.do_byte_swap ())
+          {
+            CDR_Bulk_Traits<T>::swap (buf,
+                                      reinterpret_cast<char *> (buffer),
+                                      length);
+            return true;
+          }
+#endif /* ACE_DISABLE_SWAP_ON_READ */
+        ACE_OS::memcpy (buffer, buf, sizeof (T) * length);
+        return true;
+      }
+    };
+  }
+
+  /// Marshal the @a length values at @a buffer, as one block if
+  /// CDR_Bulk_Traits allows it.
+  template<typename stream, typename T>
+  inline bool
+  marshal_value_array (stream &strm, T const *buffer, CORBA::ULong length)
+  {
+    return details::cdr_value_array<T>::write (strm, buffer, length);
+  }
+
+  /// Demarshal @a length values into @a buffer, as one block if
+  /// CDR_Bulk_Traits allows it.
+  template<typename stream, typename T>
+  inline bool
+  demarshal_value_array (stream &strm, T *buffer, CORBA::ULong length)
+  {
+    return details::cdr_value_array<T>::read (strm, buffer, length);
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif // guard_cdr_bulk_traits_hpp
@@ -0,0 +1,67 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    CDR_Size_T.h
+ *
+ *  Size a value in CDR ahead of marshaling it, when its type has an
+ *  operator<< (ACE_SizeCDR &, ...).
+ */
+//=============================================================================
+
+#ifndef TAO_CDR_SIZE_T_H
+#define TAO_CDR_SIZE_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/CDR_Size.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace details
+  {
+    template<typename T>
+    inline auto
+    cdr_size_i (ACE_SizeCDR &strm, T const &x, int)
+      -> decltype (static_cast<CORBA::Boolean> (strm << x))
+    {
+      return strm << x;
+    }
+
+    template<typename T>
+    inline CORBA::Boolean
+    cdr_size_i (ACE_SizeCDR &, T const &, long)
+    {
+      return false;
+    }
+  }
+
+  /**
+   * Add the size of @a x in CDR to @a strm.  The primitive types and
+   * strings have an operator<< (ACE_SizeCDR &, ...) in ACE, and
+   * tao_idl generates one for the structs, unions, sequences, arrays
+   * and enums it can size without marshaling them.  For any other
+   * type, such as object references, valuetypes and Any, this returns
+   * false: the size is not known.
+   */
+  template<typename T>
+  inline CORBA::Boolean
+  cdr_size (ACE_SizeCDR &strm, T const &x)
+  {
+    return details::cdr_size_i (strm, x, 0);
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_CDR_SIZE_T_H */
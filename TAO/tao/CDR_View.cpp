@@ -0,0 +1,125 @@
+#include "tao/CDR_View.h"
+#include "tao/SystemException.h"
+
+#if !defined (__ACE_INLINE__)
+# include "tao/CDR_View.inl"
+#endif /* ! __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+CORBA::Boolean
+TAO::View_Base::_tao_bind_members (TAO_InputCDR &strm,
+                                   size_t offsets[],
+                                   CORBA::ULong &known,
+                                   CORBA::ULong count,
+                                   Skip_Member skip)
+{
+  this->_tao_bind_i (strm);
+  known = 0;
+
+  // The members are skipped anyway to get past the struct, so their
+  // positions are all known without walking them again later.
+  for (CORBA::ULong i = 0; i != count; ++i)
+    {
+      offsets[i] = _tao_position (strm);
+      if (!skip (strm, i))
+        {
+          return false;
+        }
+    }
+
+  known = count;
+  return true;
+}
+
+CORBA::Boolean
+TAO::View_Base::_tao_skip_members (TAO_InputCDR &strm,
+                                   CORBA::ULong count,
+                                   Skip_Member skip)
+{
+  for (CORBA::ULong i = 0; i != count; ++i)
+    {
+      if (!skip (strm, i))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+size_t
+TAO::View_Base::_tao_member_offset (CORBA::ULong member,
+                                    size_t offsets[],
+                                    CORBA::ULong &known,
+                                    Skip_Member skip) const
+{
+  if (member < known)
+    {
+      return offsets[member];
+    }
+
+  if (known == 0)
+    {
+      offsets[0] = this->start_;
+      known = 1;
+    }
+
+  View_Reader strm (*this, offsets[known - 1]);
+  while (known <= member)
+    {
+      if (!skip (strm, known - 1))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+      offsets[known++] = _tao_position (strm);
+    }
+
+  return offsets[member];
+}
+
+const CORBA::Char *
+TAO::View_Base::_tao_string (size_t pos, CORBA::String_var &cache) const
+{
+  View_Reader strm (*this, pos);
+
+  if (strm.char_translator () != 0)
+    {
+      if (!(strm >> cache.out ()))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+      return cache.in ();
+    }
+
+  CORBA::ULong len = 0;
+  if (!strm.read_ulong (len) || len > strm.length ())
+    {
+      throw ::CORBA::MARSHAL ();
+    }
+
+  // A null string is read as an empty one, as ACE_InputCDR does.
+  if (len == 0)
+    {
+      return "";
+    }
+
+  const char *s = strm.rd_ptr ();
+  if (s[len - 1] != '\0')
+    {
+      throw ::CORBA::MARSHAL ();
+    }
+  return s;
+}
+
+const CORBA::WChar *
+TAO::View_Base::_tao_wstring (size_t pos, CORBA::WString_var &cache) const
+{
+  View_Reader strm (*this, pos);
+  if (!(strm >> cache.out ()))
+    {
+      throw ::CORBA::MARSHAL ();
+    }
+  return cache.in ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,157 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    CDR_View.h
+ *
+ *  Read-only views of IDL structs over the CDR stream they were
+ *  received in.
+ *
+ *  With -Gview tao_idl generates, next to a struct @c S, a class
+ *  @c S_View whose accessors decode one member at a time straight
+ *  from the stream of the request, instead of demarshaling the whole
+ *  struct, with its strings and sequences, into the C++ mapping.  The
+ *  positions of the members of a struct received as an argument are
+ *  kept while skipping over it; those of the structs nested in it are
+ *  found on first access, by skipping over the members before the one
+ *  accessed, and kept for the next accesses.  Skeletons pass
+ *  such a view to the servant for the @c in arguments of struct
+ *  types; a view, and what its accessors return, is only valid until
+ *  the upcall returns.
+ */
+//=============================================================================
+
+#ifndef TAO_CDR_VIEW_H
+#define TAO_CDR_VIEW_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/CDR.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/CORBA_String.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * @class View_Base
+   *
+   * @brief The stream and position a view reads its value from.
+   *
+   * The members are used by the generated views and by
+   * Sequence_View; they are not part of the interface of the views
+   * to applications.
+   */
+  class TAO_Export View_Base
+  {
+  public:
+    /// Skip member @a member of a struct, read from @a strm.
+    typedef ::CORBA::Boolean (*Skip_Member) (TAO_InputCDR &strm,
+                                            ::CORBA::ULong member);
+
+    /// Refer to the value at the read position of @a strm, which must
+    /// outlive this view.
+    void _tao_bind_i (TAO_InputCDR &strm);
+
+    /// Refer to the value at @a pos in the stream of @a outer.
+    void _tao_bind_i (const View_Base &outer, size_t pos);
+
+    /**
+     * Refer to the struct of @a count members at the read position of
+     * @a strm, and skip over it, keeping the positions of all its
+     * members in @a offsets.
+     */
+    ::CORBA::Boolean _tao_bind_members (TAO_InputCDR &strm,
+                                        size_t offsets[],
+                                        ::CORBA::ULong &known,
+                                        ::CORBA::ULong count,
+                                        Skip_Member skip);
+
+    /// Skip over a struct of @a count members.
+    static ::CORBA::Boolean _tao_skip_members (TAO_InputCDR &strm,
+                                               ::CORBA::ULong count,
+                                               Skip_Member skip);
+
+    /// Forget the value, for views kept by another view.
+    void _tao_unbind ();
+
+    /// True if the view refers to a value.
+    bool _tao_is_bound () const;
+
+    /// Position of the value in the data of the stream.
+    size_t _tao_start () const;
+
+    /// Position of the read pointer of @a strm in its data.
+    static size_t _tao_position (const TAO_InputCDR &strm);
+
+    /**
+     * Position of member @a member of the struct the view refers
+     * to.  @a offsets holds the positions of the first @a known
+     * members; they are extended, skipping members with @a skip, up
+     * to @a member.  Throws CORBA::MARSHAL if the data is short.
+     */
+    size_t _tao_member_offset (::CORBA::ULong member,
+                               size_t offsets[],
+                               ::CORBA::ULong &known,
+                               Skip_Member skip) const;
+
+    /**
+     * The string at @a pos.  It points into the stream when no
+     * codeset translator is in use, else it is translated into
+     * @a cache.  Throws CORBA::MARSHAL if the string is not
+     * terminated within the data.
+     */
+    const ::CORBA::Char *_tao_string (size_t pos,
+                                      ::CORBA::String_var &cache) const;
+
+    /// The wide string at @a pos, decoded into @a cache.
+    const ::CORBA::WChar *_tao_wstring (size_t pos,
+                                        ::CORBA::WString_var &cache) const;
+
+    /// The data of the stream at @a pos.
+    const char *_tao_buffer (size_t pos) const;
+
+    /// True if the values in the stream are not in the byte order of
+    /// this host.
+    bool _tao_swapped () const;
+
+  protected:
+    View_Base ();
+
+  private:
+    friend class View_Reader;
+
+    /// The stream the value was received in.
+    TAO_InputCDR *stream_;
+
+    /// Position of the value in the data of @c stream_.
+    size_t start_;
+  };
+
+  /**
+   * @class View_Reader
+   *
+   * @brief A stream reading the data of a view from a position,
+   * without copying or taking a reference to the data.
+   */
+  class TAO_Export View_Reader : public TAO_InputCDR
+  {
+  public:
+    View_Reader (const View_Base &view, size_t pos);
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "tao/CDR_View.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_CDR_VIEW_H */
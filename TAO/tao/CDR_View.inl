@@ -0,0 +1,84 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE
+TAO::View_Base::View_Base ()
+  : stream_ (0),
+    start_ (0)
+{
+}
+
+ACE_INLINE void
+TAO::View_Base::_tao_bind_i (TAO_InputCDR &strm)
+{
+  this->stream_ = &strm;
+  this->start_ = _tao_position (strm);
+}
+
+ACE_INLINE void
+TAO::View_Base::_tao_bind_i (const View_Base &outer, size_t pos)
+{
+  this->stream_ = outer.stream_;
+  this->start_ = pos;
+}
+
+ACE_INLINE void
+TAO::View_Base::_tao_unbind ()
+{
+  this->stream_ = 0;
+}
+
+ACE_INLINE bool
+TAO::View_Base::_tao_is_bound () const
+{
+  return this->stream_ != 0;
+}
+
+ACE_INLINE size_t
+TAO::View_Base::_tao_start () const
+{
+  return this->start_;
+}
+
+ACE_INLINE size_t
+TAO::View_Base::_tao_position (const TAO_InputCDR &strm)
+{
+  const ACE_Message_Block *mb = strm.start ();
+  return mb->rd_ptr () - mb->base ();
+}
+
+ACE_INLINE const char *
+TAO::View_Base::_tao_buffer (size_t pos) const
+{
+  return this->stream_->start ()->base () + pos;
+}
+
+ACE_INLINE bool
+TAO::View_Base::_tao_swapped () const
+{
+  return this->stream_->do_byte_swap ();
+}
+
+// ==========================================================================
+
+ACE_INLINE
+TAO::View_Reader::View_Reader (const View_Base &view, size_t pos)
+  : TAO_InputCDR (view.stream_->start ()->data_block (),
+                  ACE_Message_Block::DONT_DELETE,
+                  pos,
+                  view.stream_->start ()->wr_ptr ()
+                    - view.stream_->start ()->base (),
+                  view.stream_->byte_order (),
+                  TAO_DEF_GIOP_MAJOR,
+                  TAO_DEF_GIOP_MINOR,
+                  view.stream_->orb_core ())
+{
+  ACE_CDR::Octet major = 0;
+  ACE_CDR::Octet minor = 0;
+  view.stream_->get_version (major, minor);
+  this->set_version (major, minor);
+  this->char_translator (view.stream_->char_translator ());
+  this->wchar_translator (view.stream_->wchar_translator ());
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,69 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Cached_Time_Policy_Strategy.h
+ */
+//=============================================================================
+
+#ifndef CACHED_TIME_POLICY_STRATEGY_H
+#define CACHED_TIME_POLICY_STRATEGY_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "tao/TAO_Export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/orbconf.h"
+
+#if (TAO_HAS_TIME_POLICY == 1)
+
+#include "tao/Time_Policy_Strategy.h"
+
+#include "ace/Time_Policy_T.h"
+#include "ace/Cached_Time_Policy.h"
+#include "ace/Service_Config.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Cached_Time_Policy_Strategy
+ *
+ * @brief Time policy strategy providing monotonic time, read once per
+ * reactor event.
+ *
+ * Timers and countdowns use ACE_Cached_Time_Policy, so the reactor
+ * reads the clock once per event for the timer queue, the ORB's
+ * timeouts and the timers its handlers schedule.  Creating a timer
+ * queue turns on ACE_Cached_Time_Policy::reactor_scope() for the
+ * whole process.
+ */
+class TAO_Export TAO_Cached_Time_Policy_Strategy
+  : public TAO_Time_Policy_Strategy
+{
+public:
+  virtual ~TAO_Cached_Time_Policy_Strategy ();
+
+  virtual ACE_Timer_Queue * create_timer_queue (void);
+
+  virtual void destroy_timer_queue (ACE_Timer_Queue *tmq);
+
+  virtual ACE_Dynamic_Time_Policy_Base * get_time_policy (void);
+
+private:
+  static ACE_Time_Policy_T<ACE_Cached_Time_Policy>  time_policy_;
+};
+
+ACE_STATIC_SVC_DECLARE_EXPORT (TAO, TAO_Cached_Time_Policy_Strategy)
+ACE_FACTORY_DECLARE (TAO, TAO_Cached_Time_Policy_Strategy)
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_TIME_POLICY */
+
+#include /**/ "ace/post.h"
+
+#endif /* CACHED_TIME_POLICY_STRATEGY_H */
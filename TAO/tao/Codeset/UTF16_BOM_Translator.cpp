@@ -15,6 +15,7 @@
 #include "ace/OS_Memory.h"
 #include "tao/debug.h"
 #include "ace/Log_Msg.h"
+#include "ace/Transcode.h"
 
 // ****************************************************************
 
@@ -258,27 +259,15 @@ TAO_UTF16_BOM_Translator::read_wchar_array_i (ACE_InputCDR & cdr,
       if (has_bom)
         {
           buf += ACE_UTF16_CODEPOINT_SIZE;
-          ++sb;
 
           if (adjust_len)
             length -= 1;
         }
 
-      for (size_t i = 0; i < length; ++i)
 #if defined (ACE_DISABLE_SWAP_ON_READ)
-        x[i] = static_cast<ACE_CDR::WChar> (sb[i]);
-#else
-      if (!must_swap)
-        {
-          x[i] = static_cast<ACE_CDR::WChar> (sb[i]);
-        }
-      else
-        {
-          ACE_CDR::UShort sx;
-          ACE_CDR::swap_2 (&buf[i*2], reinterpret_cast<char *> (&sx));
-          x[i] = static_cast<ACE_CDR::WChar> (sx);
-        }
+      must_swap = 0;
 #endif /* ACE_DISABLE_SWAP_ON_READ */
+      ACE_Transcode::utf16_to_wchar (buf, length, x, must_swap != 0);
 
       if (has_bom && !adjust_len)
         {
@@ -467,14 +456,8 @@ TAO_UTF16_BOM_Translator::write_wchar_array_i (ACE_OutputCDR & cdr,
       return 0;
     }
 
-  ACE_UTF16_T *sb = reinterpret_cast<ACE_UTF16_T *> (buf);
-
-  for (size_t i = 0; i < length; ++i)
-    {
-      sb[i] = static_cast<ACE_UTF16_T> (x[i]);
-    }
+  ACE_Transcode::wchar_to_utf16 (x, length, buf, false);
   return 1;
-
 }
 
 ACE_CDR::Boolean
@@ -492,13 +475,7 @@ TAO_UTF16_BOM_Translator::write_swapped_wchar_array_i (ACE_OutputCDR & cdr,
       return 0;
     }
 
-  ACE_UTF16_T *sb = reinterpret_cast<ACE_UTF16_T *> (buf);
-
-  for (size_t i = 0; i < length; ++i)
-    {
-      ACE_CDR::swap_2 (reinterpret_cast<const char*> (&x[i]),
-                       reinterpret_cast<char *> (&sb[i]));
-    }
+  ACE_Transcode::wchar_to_utf16 (x, length, buf, true);
   return 1;
 }
 
@@ -14,6 +14,8 @@
 #include "tao/Codeset/UTF8_Latin1_Translator.h"
 #include "tao/debug.h"
 #include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Transcode.h"
 
 // ****************************************************************
 
@@ -48,31 +50,38 @@ TAO_UTF8_Latin1_Translator::read_char (ACE_InputCDR &cdr, ACE_CDR::Char &x)
   return false;
 }
 
-ACE_CDR::ULong
-TAO_UTF8_Latin1_Translator::read_char_i (ACE_InputCDR &cdr, ACE_CDR::Char &x)
+ACE_CDR::Boolean
+TAO_UTF8_Latin1_Translator::read_string_i (ACE_InputCDR &cdr,
+                                           ACE_CDR::ULong len,
+                                           ACE_CDR::Char *x,
+                                           size_t &length)
 {
-  // This will read up to 2 octets and combine them into one char if possible
-  ACE_CDR::Octet upper;
-  if (this->read_1 (cdr, &upper))
+  char *buf = 0;
+  if (cdr.adjust (len, ACE_CDR::OCTET_ALIGN, buf) != 0)
+    return false;
+
+  length = 0;
+  size_t pos = 0;
+  while (pos < len)
     {
-      if ( upper >= 0xC4) // Anything with a leading char > 110001xx converts
-                          // to a codepoint value > 0x00FF, thus won't fit in
-                          // a single char.
-        return 0;
-      if ( upper < 0xC0 )
+      size_t written = 0;
+      pos += ACE_Transcode::utf8_to_latin1 (buf + pos,
+                                            len - pos,
+                                            x + length,
+                                            written);
+      length += written;
+
+      if (pos < len)
         {
-          x = static_cast<ACE_CDR::Char>(upper);
-          return 1;
+          // Earlier versions of this translator wrote the codepoints
+          // from 0x80 to 0xBF as single octets, so accept those. Any
+          // other octet starts a codepoint > 0x00FF or is not UTF-8.
+          if (static_cast<ACE_CDR::Octet> (buf[pos]) >= 0xC0)
+            return false;
+          x[length++] = buf[pos++];
         }
-      ACE_CDR::Octet lower;
-      if (this->read_1 (cdr, &lower))
-        {
-          ACE_CDR::Octet final = ((upper & 0xBF) << 6) + (lower & 0xC0);
-          x = static_cast<ACE_CDR::Char>(final);
-          return 2;
-        };
     }
-  return 0;
+  return true;
 }
 
 ACE_CDR::Boolean
@@ -84,22 +93,17 @@ TAO_UTF8_Latin1_Translator::read_string (ACE_InputCDR &cdr,
     return 0;
 
   // A check for the length being too great is done later in the
-  // call to read_char_array but we want to have it done before
+  // call to read_string_i but we want to have it done before
   // the memory is allocated.
   if (len > 0 && len <= cdr.length())
     {
       ACE_NEW_RETURN (x,
                       ACE_CDR::Char [len],
                       0);
-      // pos keeps track of the character position, it will never be
-      // greater than len
-      size_t pos = 0;
-      ACE_CDR::ULong incr = 1;
-      for (ACE_CDR::ULong i = 0; incr > 0 && i < len; i += incr)
-        {
-          incr = this->read_char_i(cdr,x[pos++]);
-        }
-      if (incr > 0)
+      // The terminating nul is decoded along with the rest, and
+      // the string can only get shorter.
+      size_t length = 0;
+      if (this->read_string_i (cdr, len, x, length))
         return 1;
       delete [] x;
     }
@@ -126,12 +130,10 @@ TAO_UTF8_Latin1_Translator::read_string (ACE_InputCDR &cdr,
     return false;
 
   // A check for the length being too great is done later in the
-  // call to read_char_array but we want to have it done before
+  // call to read_string_i but we want to have it done before
   // the memory is allocated.
   if (len > 0 && len <= cdr.length())
     {
-      // detract terminating '\0' from length
-      len--;
       try
         {
           x.resize (len);
@@ -141,21 +143,13 @@ TAO_UTF8_Latin1_Translator::read_string (ACE_InputCDR &cdr,
           return false;
         }
 
-      // pos keeps track of the character position, it will never be
-      // greater than len
-      size_t pos = 0;
-      ACE_CDR::ULong incr = 1;
-      for (ACE_CDR::ULong i = 0; incr > 0 && i < len; i += incr)
+      size_t length = 0;
+      if (this->read_string_i (cdr, len, &x[0], length))
         {
-          incr = this->read_char_i(cdr,x[pos++]);
+          // detract terminating '\0' from length
+          x.resize (length - 1);
+          return true;
         }
-      if (incr > 0)
-      {
-        // read terminating '\0' from stream
-        ACE_CDR::Char c;
-        incr = this->read_char_i(cdr, c);
-        return (incr > 0);
-      }
     }
 
   x.clear ();
@@ -170,9 +164,17 @@ TAO_UTF8_Latin1_Translator::read_char_array (ACE_InputCDR & cdr,
   if (length == 0)
     return 1;
 
+  char *buf = 0;
+  if (cdr.adjust (length, ACE_CDR::OCTET_ALIGN, buf) != 0)
+    return 0;
+
+  // As in read_char, every char must be a single octet.
   for (size_t i = 0; i < length; ++i)
-    if (!this->read_char(cdr,x[i]))
-      return 0;
+    {
+      if (static_cast<ACE_CDR::Octet> (buf[i]) >= 0xC0)
+        return 0;
+      x[i] = buf[i];
+    }
 
   return 1;
 }
@@ -191,29 +193,6 @@ TAO_UTF8_Latin1_Translator::write_char (ACE_OutputCDR &cdr,
     }
 }
 
-ACE_CDR::Boolean
-TAO_UTF8_Latin1_Translator::write_char_i (ACE_OutputCDR &cdr,
-                                      ACE_CDR::Char x)
-{
-  // @@@ Strictly speaking, we should test for 7F < x < C0 and do
-  // something else in that case, but for now we will just let it
-  // pass.
-
-  ACE_CDR::Octet ox = x;
-  if (ox < 0xC0)
-    return this->write_1 (cdr,&ox);
-  else
-    { // character cannot be represented in a single octet
-      // Since the source will never be > 0xFF, we don't have to worry about
-      // using a third octet.
-      ACE_CDR::Octet upper = 0xC0 + (ox >> 6);
-      ACE_CDR::Octet lower = 0x80 + (ox & 0x3F);
-      if (this->write_1(cdr, &upper))
-        return this->write_1(cdr, &lower);
-    }
-  return 0;
-}
-
 ACE_CDR::Boolean
 TAO_UTF8_Latin1_Translator::write_string (ACE_OutputCDR & cdr,
                                      ACE_CDR::ULong len,
@@ -223,22 +202,20 @@ TAO_UTF8_Latin1_Translator::write_string (ACE_OutputCDR & cdr,
   if (x == 0 && len != 0)
     return 0;
 
-  ACE_CDR::ULong l = len;
-  // Compute the real buffer size by adding in multi-byte codepoints.
-  for (ACE_CDR::ULong i = 0; i < len; i++)
-    if (static_cast<ACE_CDR::Octet>(x[i]) > 0xbf) l++;
+  // Compute the real buffer size by adding in multi-byte codepoints,
+  // and always add one for the nul.
+  size_t const l = ACE_Transcode::latin1_utf8_length (x, len) + 1;
+  if (l > ACE_UINT32_MAX)
+    return 0;
 
-  // Always add one for the nul
-  l++;
-  if (cdr.write_ulong (l))
+  if (cdr.write_ulong (static_cast<ACE_CDR::ULong> (l)))
     {
-      for (ACE_CDR::ULong i = 0; i < len; ++i)
-        {
-          if (this->write_char_i (cdr,x[i]) == 0)
-            return 0;
-        }
-      ACE_CDR::Octet s = 0;
-      return this->write_1 (cdr, &s);
+      char *buf = 0;
+      if (cdr.adjust (l, ACE_CDR::OCTET_ALIGN, buf) != 0)
+        return 0;
+      ACE_Transcode::latin1_to_utf8 (x, len, buf);
+      buf[l - 1] = '\x00';
+      return 1;
     }
   return 0;
 }
@@ -251,12 +228,21 @@ TAO_UTF8_Latin1_Translator::write_char_array (ACE_OutputCDR & cdr,
   if (length == 0)
     return true;
 
+  // As in write_char, any translated value may fail to fit in a
+  // single octet.
   for (size_t i = 0; i < length; ++i)
-    // We still have to write each char individually, as any translated
-    // value may fail to fit in a single octet.
-    if (this->write_char (cdr, x[i]) == 0)
-      return false;
+    {
+      if (static_cast<ACE_CDR::Octet> (x[i]) >= 0xC0)
+        {
+          errno = EINVAL;
+          return false;
+        }
+    }
 
+  char *buf = 0;
+  if (cdr.adjust (length, ACE_CDR::OCTET_ALIGN, buf) != 0)
+    return false;
+  ACE_OS::memcpy (buf, x, length);
   return true;
 }
 
@@ -73,11 +73,12 @@ public:
   virtual ACE_CDR::ULong tcs () {return 0x05010001U;}
 
 private:
-  ACE_CDR::ULong read_char_i (ACE_InputCDR &,
-                                ACE_CDR::Char &);
-
-  ACE_CDR::Boolean write_char_i (ACE_OutputCDR &,
-                                 ACE_CDR::Char);
+  /// Decode the @a len octets of a string, nul included, into @a x,
+  /// setting @a length to the number of chars.
+  ACE_CDR::Boolean read_string_i (ACE_InputCDR &,
+                                  ACE_CDR::ULong len,
+                                  ACE_CDR::Char *x,
+                                  size_t &length);
 
 };
 
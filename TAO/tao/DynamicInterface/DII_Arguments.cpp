@@ -56,6 +56,12 @@ namespace TAO
     return true;
   }
 
+  CORBA::Boolean
+  NVList_Argument::marshal_size (ACE_SizeCDR &)
+  {
+    return false;
+  }
+
   CORBA::Boolean
   NVList_Argument::demarshal (TAO_InputCDR &cdr)
   {
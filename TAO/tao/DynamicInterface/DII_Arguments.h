@@ -73,6 +73,9 @@ namespace TAO
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
 
+    /// The size of Any values is not known before marshaling them.
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
+
     virtual CORBA::Boolean demarshal (TAO_InputCDR &);
 
     // Not an override of a base class method, but a new one that
@@ -2,6 +2,7 @@
 #define TAO_FIXED_ARRAY_ARGUMENT_T_CPP
 
 #include "tao/Fixed_Array_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 
 #if !defined (__ACE_INLINE__)
 #include "tao/Fixed_Array_Argument_T.inl"
@@ -18,6 +19,14 @@ TAO::In_Fixed_Array_Argument_T<S_forany,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Fixed_Array_Argument_T<S_forany,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_forany,
@@ -73,6 +82,14 @@ TAO::Inout_Fixed_Array_Argument_T<S_forany,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Fixed_Array_Argument_T<S_forany,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S_forany,
          template <typename> class Insert_Policy>
 CORBA::Boolean
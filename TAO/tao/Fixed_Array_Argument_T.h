@@ -38,6 +38,7 @@ namespace TAO
     In_Fixed_Array_Argument_T (const typename S_forany::_slice_type * x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
 #endif /* TAO_HAS_INTERCEPTORS == 1 */
@@ -82,6 +83,7 @@ namespace TAO
     Inout_Fixed_Array_Argument_T (typename S_forany::_slice_type *&x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
     virtual CORBA::Boolean demarshal (TAO_InputCDR &);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
@@ -2,6 +2,7 @@
 #define TAO_FIXED_SIZE_ARGUMENT_T_CPP
 
 #include "tao/Fixed_Size_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 
 #if !defined (__ACE_INLINE__)
 #include "tao/Fixed_Size_Argument_T.inl"
@@ -17,6 +18,14 @@ TAO::In_Fixed_Size_Argument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << *this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Fixed_Size_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, *this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -62,6 +71,14 @@ TAO::Inout_Fixed_Size_Argument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << *this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Fixed_Size_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, *this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -58,6 +58,7 @@
 #include "ace/checked_iterator.h"
 
 #include <algorithm>
+#include <utility>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -140,6 +141,25 @@ public:
     return * this;
   }
 
+  /// Move constructor, takes over the buffer of @a rhs and leaves it
+  /// as a default constructed sequence without a buffer.
+  generic_sequence(generic_sequence && rhs) noexcept
+    : maximum_(allocation_traits::default_maximum())
+    , length_(0)
+    , buffer_(0)
+    , release_(false)
+  {
+    swap(rhs);
+  }
+
+  /// Move assignment operator
+  generic_sequence & operator=(generic_sequence && rhs) noexcept
+  {
+    generic_sequence tmp(std::move(rhs));
+    swap(tmp);
+    return * this;
+  }
+
   /// Destructor.
   ~generic_sequence()
   {
@@ -21,17 +21,32 @@ namespace
   off_t const the_default_buf_size =
     sizeof (ACE_Control_Block) + ACE_DEFAULT_CDR_BUFSIZE;
 
-  ACE_MMAP_Memory_Pool_Options const the_pool_options (
-    ACE_DEFAULT_BASE_ADDR,
-    ACE_MMAP_Memory_Pool_Options::ALWAYS_FIXED,
-    0, // No need to sync
-    the_default_buf_size,
-    MAP_SHARED, // Written data must be reflected in the backing store
-                // file in order for sendfile() to be able to read it.
-    1,
-    0,
-    /* 0 */ ACE_DEFAULT_FILE_PERMS,
-    true); // Generate for each mmap an unqiue pool
+  struct Pool_Options : public ACE_MMAP_Memory_Pool_Options
+  {
+    Pool_Options (int huge_pages, bool prefault, int numa_node)
+      : ACE_MMAP_Memory_Pool_Options (
+          ACE_DEFAULT_BASE_ADDR,
+          ACE_MMAP_Memory_Pool_Options::ALWAYS_FIXED,
+          0, // No need to sync
+          the_default_buf_size,
+          MAP_SHARED, // Written data must be reflected in the backing store
+                      // file in order for sendfile() to be able to read it.
+          1,
+          0,
+          /* 0 */ ACE_DEFAULT_FILE_PERMS,
+          true, // Generate for each mmap an unqiue pool
+          true,
+          huge_pages,
+          prefault,
+          numa_node)
+    {
+    }
+  };
+
+  Pool_Options const the_pool_options (
+    ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES,
+    false,
+    -1);
 }
 
 
@@ -61,6 +76,18 @@ TAO_MMAP_Allocator::TAO_MMAP_Allocator ()
 {
 }
 
+// The pool copies its options, so they only need to live as long as
+// the base class constructor runs.
+TAO_MMAP_Allocator::TAO_MMAP_Allocator (int huge_pages,
+                                        bool prefault,
+                                        int numa_node)
+  : TAO_MMAP_Allocator_Base ((char const *) nullptr /* pool name */,
+                             nullptr,  // No need to explicitly name the lock.
+                             &static_cast<ACE_MMAP_Memory_Pool_Options const &> (
+                               Pool_Options (huge_pages, prefault, numa_node)))
+{
+}
+
 TAO_MMAP_Allocator::~TAO_MMAP_Allocator ()
 {
 }
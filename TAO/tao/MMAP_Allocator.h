@@ -47,6 +47,11 @@ public:
   /// Constructor
   TAO_MMAP_Allocator (void);
 
+  /// Constructor with the huge page, prefault and NUMA options of
+  /// ACE_MMAP_Memory_Pool_Options.  Huge pages and NUMA binding take
+  /// effect when TMPDIR, where the backing store goes, is a tmpfs.
+  TAO_MMAP_Allocator (int huge_pages, bool prefault, int numa_node);
+
   /// Destructor.
   virtual ~TAO_MMAP_Allocator (void);
 
@@ -42,6 +42,11 @@ class TAO_ServerRequest;
 
 typedef ACE_Allocator TAO_AMH_BUFFER_ALLOCATOR;
 
+namespace TAO
+{
+  class AMH_Task;
+}
+
 /**
  * @class TAO_AMH_Response_Handler
  *
@@ -102,6 +107,9 @@ protected:
   void _tao_rh_send_location_forward (CORBA::Object_ptr fwd,
                                       CORBA::Boolean is_perm);
 
+  /// Sends the exceptions coroutine upcalls let escape.
+  friend class TAO::AMH_Task;
+
 
   /// The outgoing CDR stream
   /**
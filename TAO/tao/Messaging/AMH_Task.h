@@ -0,0 +1,283 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    AMH_Task.h
+ *
+ *  The return type of the AMH upcalls tao_idl -GHcoro generates,
+ *  which servants implement as C++20 coroutines.
+ *
+ *  Everything here is inline, so that the ORB libraries can be built
+ *  with any C++ standard and used from code built with C++20.
+ */
+//=============================================================================
+
+#ifndef TAO_MESSAGING_AMH_TASK_H
+#define TAO_MESSAGING_AMH_TASK_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+#include "tao/Messaging/AMH_Response_Handler.h"
+#include "tao/SystemException.h"
+#include "tao/debug.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * @class AMH_Task
+   *
+   * @brief The task of an AMH upcall that is a coroutine.
+   *
+   * The coroutine runs as soon as the skeleton calls it and may
+   * co_await the async_ operations of tao_idl -Gcoro to call other
+   * servers, giving back the thread that dispatched the request while
+   * it waits.  It replies through its ResponseHandler like any AMH
+   * servant, the difference being that the ResponseHandler and the
+   * in and inout arguments stay valid until the coroutine returns.
+   * An exception the coroutine lets escape is sent as the reply, and
+   * the ResponseHandler replies CORBA::NO_RESPONSE, as always, if the
+   * coroutine returns without having replied.
+   *
+   * The coroutine frame is freed once the coroutine has returned and
+   * the skeleton has let go of the task, in whichever order these
+   * happen.
+   */
+  class AMH_Task
+  {
+  public:
+    struct promise_type
+    {
+      /// For coroutines that are not AMH upcalls.
+      promise_type () noexcept;
+
+      /// For upcalls, a ResponseHandler follows the servant.
+      template <typename SERVANT, typename RH, typename... ARGS>
+        requires std::is_convertible_v<RH *, ::CORBA::Object_ptr>
+      promise_type (SERVANT &, RH *rh, ARGS &...) noexcept;
+
+      ~promise_type ();
+
+      AMH_Task get_return_object () noexcept;
+      std::suspend_never initial_suspend () noexcept;
+      auto final_suspend () noexcept;
+      void return_void () noexcept;
+      void unhandled_exception () noexcept;
+
+      /// Drop a reference to the frame, true for the last one.
+      bool release () noexcept;
+
+      TAO_AMH_Response_Handler *rh_;
+      std::shared_ptr<void> arguments_;
+      std::atomic<int> refcount_;
+    };
+
+    AMH_Task (AMH_Task &&rhs) noexcept;
+    ~AMH_Task ();
+
+    /// Keep @a arguments until the coroutine returns.
+    AMH_Task &retain (std::shared_ptr<void> arguments) noexcept;
+
+  private:
+    explicit AMH_Task (std::coroutine_handle<promise_type> coroutine) noexcept;
+
+    AMH_Task (const AMH_Task &) = delete;
+    AMH_Task &operator= (const AMH_Task &) = delete;
+    AMH_Task &operator= (AMH_Task &&) = delete;
+
+    /// Send @a ex as the reply of @a rh.
+    static void send_exception (TAO_AMH_Response_Handler *rh,
+                                const ::CORBA::Exception &ex) noexcept;
+
+    std::coroutine_handle<promise_type> coroutine_;
+  };
+
+  inline
+  AMH_Task::promise_type::promise_type () noexcept
+    : rh_ (nullptr)
+    , refcount_ (2)
+  {
+  }
+
+  template <typename SERVANT, typename RH, typename... ARGS>
+    requires std::is_convertible_v<RH *, ::CORBA::Object_ptr>
+  inline
+  AMH_Task::promise_type::promise_type (SERVANT &, RH *rh, ARGS &...) noexcept
+    : rh_ (dynamic_cast<TAO_AMH_Response_Handler *> (rh))
+    , refcount_ (2)
+  {
+    if (this->rh_ != nullptr)
+      {
+        this->rh_->_add_ref ();
+      }
+  }
+
+  inline
+  AMH_Task::promise_type::~promise_type ()
+  {
+    if (this->rh_ != nullptr)
+      {
+        this->rh_->_remove_ref ();
+      }
+  }
+
+  inline AMH_Task
+  AMH_Task::promise_type::get_return_object () noexcept
+  {
+    return AMH_Task (
+      std::coroutine_handle<promise_type>::from_promise (*this));
+  }
+
+  inline std::suspend_never
+  AMH_Task::promise_type::initial_suspend () noexcept
+  {
+    return std::suspend_never ();
+  }
+
+  inline auto
+  AMH_Task::promise_type::final_suspend () noexcept
+  {
+    struct Final_Awaiter
+    {
+      bool await_ready () const noexcept
+      {
+        return false;
+      }
+
+      void await_suspend (std::coroutine_handle<promise_type> self) noexcept
+      {
+        if (self.promise ().release ())
+          {
+            self.destroy ();
+          }
+      }
+
+      void await_resume () const noexcept
+      {
+      }
+    };
+
+    return Final_Awaiter ();
+  }
+
+  inline void
+  AMH_Task::promise_type::return_void () noexcept
+  {
+  }
+
+  inline void
+  AMH_Task::promise_type::unhandled_exception () noexcept
+  {
+    try
+      {
+        throw;
+      }
+    catch (const ::CORBA::Exception &ex)
+      {
+        if (this->rh_ != nullptr)
+          {
+            AMH_Task::send_exception (this->rh_, ex);
+          }
+        else if (TAO_debug_level > 0)
+          {
+            ex._tao_print_exception ("TAO::AMH_Task - unhandled exception");
+          }
+      }
+    catch (...)
+      {
+        if (this->rh_ != nullptr)
+          {
+            AMH_Task::send_exception (this->rh_,
+                                      ::CORBA::UNKNOWN ());
+          }
+        else if (TAO_debug_level > 0)
+          {
+            TAOLIB_ERROR ((LM_ERROR,
+                           ACE_TEXT ("TAO (%P|%t) - AMH_Task, ")
+                           ACE_TEXT ("unhandled exception\n")));
+          }
+      }
+  }
+
+  inline bool
+  AMH_Task::promise_type::release () noexcept
+  {
+    return this->refcount_.fetch_sub (1, std::memory_order_acq_rel) == 1;
+  }
+
+  inline
+  AMH_Task::AMH_Task (std::coroutine_handle<promise_type> coroutine) noexcept
+    : coroutine_ (coroutine)
+  {
+  }
+
+  inline
+  AMH_Task::AMH_Task (AMH_Task &&rhs) noexcept
+    : coroutine_ (rhs.coroutine_)
+  {
+    rhs.coroutine_ = nullptr;
+  }
+
+  inline
+  AMH_Task::~AMH_Task ()
+  {
+    if (this->coroutine_ && this->coroutine_.promise ().release ())
+      {
+        this->coroutine_.destroy ();
+      }
+  }
+
+  inline AMH_Task &
+  AMH_Task::retain (std::shared_ptr<void> arguments) noexcept
+  {
+    // The frame lives at least as long as this, even if the coroutine
+    // has returned already.
+    this->coroutine_.promise ().arguments_ = std::move (arguments);
+    return *this;
+  }
+
+  inline void
+  AMH_Task::send_exception (TAO_AMH_Response_Handler *rh,
+                            const ::CORBA::Exception &ex) noexcept
+  {
+    try
+      {
+        rh->_tao_rh_send_exception (ex);
+      }
+    catch (const ::CORBA::Exception &send_ex)
+      {
+        // Most likely the coroutine had replied already.
+        if (TAO_debug_level > 0)
+          {
+            send_ex._tao_print_exception (
+              "TAO::AMH_Task - cannot send the exception of the upcall");
+          }
+      }
+    catch (...)
+      {
+      }
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_MESSAGING_AMH_TASK_H */
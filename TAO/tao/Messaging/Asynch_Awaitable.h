@@ -0,0 +1,574 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Asynch_Awaitable.h
+ *
+ *  Asynchronous invocations that C++20 coroutines co_await, as
+ *  generated by tao_idl -Gcoro next to the AMI sendc_ operations.
+ *
+ *  Everything here is inline, so that the ORB libraries can be built
+ *  with any C++ standard and used from code built with C++20.
+ */
+//=============================================================================
+
+#ifndef TAO_MESSAGING_ASYNCH_AWAITABLE_H
+#define TAO_MESSAGING_ASYNCH_AWAITABLE_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+#include "tao/Messaging/Messaging.h"
+#include "tao/Messaging/Asynch_Invocation_Adapter.h"
+#include "tao/Messaging/ExceptionHolder_i.h"
+#include "tao/Exception_Data.h"
+#include "tao/CDR.h"
+#include "tao/debug.h"
+#include "tao/Argument.h"
+#include "ace/OS_NS_Thread.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  class Asynch_Reply_Awaiter;
+
+  /**
+   * @class Asynch_Awaitable_Base
+   *
+   * @brief The part of an awaited invocation that does not depend on
+   * the signature of the operation.
+   *
+   * The request is sent through an Asynch_Invocation_Adapter when the
+   * awaitable is made, like sendc_ does, with an Asynch_Reply_Awaiter
+   * as the reply handler, so the in arguments need not outlive the
+   * call.  Awaiting it suspends the coroutine until the thread that
+   * dispatches the reply, the one running the ORB's reactor,
+   * demarshals it into the arguments and resumes the coroutine
+   * itself.  If the reply was dispatched before, as for collocated
+   * calls, the coroutine does not suspend at all.
+   */
+  class Asynch_Awaitable_Base
+  {
+  public:
+    /// True if the reply was dispatched already.
+    bool await_ready () const noexcept;
+
+    /// Suspend until the reply is dispatched.  Returns false if it
+    /// was dispatched meanwhile.
+    bool await_suspend (std::coroutine_handle<> continuation) noexcept;
+
+  protected:
+    Asynch_Awaitable_Base (CORBA::Object_ptr target,
+                           Argument **args,
+                           int arg_number,
+                           const char *operation,
+                           size_t op_len,
+                           int collocation_opportunity,
+                           bool has_in_args,
+                           Exception_Data *ex_data,
+                           CORBA::ULong ex_count);
+
+    /// The reply handler keeps running when the coroutine is destroyed
+    /// while it waits, but no longer touches the arguments.
+    ~Asynch_Awaitable_Base ();
+
+    /// Send the request, once the arguments are in place.
+    void send ();
+
+    /// Raise the exception the reply carried, if it carried one.
+    void check_reply ();
+
+  private:
+    friend class Asynch_Reply_Awaiter;
+
+    Asynch_Awaitable_Base (const Asynch_Awaitable_Base &) = delete;
+    Asynch_Awaitable_Base &operator= (const Asynch_Awaitable_Base &) = delete;
+
+    /// Demarshal the reply into the arguments, or keep the exception
+    /// it carries for check_reply().
+    void reply (TAO_InputCDR &cdr, CORBA::ULong reply_status) noexcept;
+
+    CORBA::Object_ptr const target_;
+    Argument **const args_;
+    int const arg_number_;
+    const char *const operation_;
+    size_t const op_len_;
+    int const collocation_opportunity_;
+    bool const has_in_args_;
+    Exception_Data *const ex_data_;
+    CORBA::ULong const ex_count_;
+
+    /// The coroutine to resume when the reply arrives.
+    std::coroutine_handle<> continuation_;
+
+    /// The exception the reply carried, if any.
+    std::exception_ptr exception_;
+
+    /// The reply handler of the request, once it is sent.
+    Asynch_Reply_Awaiter *awaiter_;
+  };
+
+  /**
+   * @class Asynch_Reply_Awaiter
+   *
+   * @brief The reply handler of an awaited invocation.
+   *
+   * It is a reference counted local object, so that the reply
+   * dispatcher can hold on to it for as long as the reply takes,
+   * and it only hands the reply to the awaitable while the
+   * coroutine waiting for it is there.
+   */
+  class Asynch_Reply_Awaiter : public virtual ::Messaging::ReplyHandler
+  {
+  public:
+    explicit Asynch_Reply_Awaiter (Asynch_Awaitable_Base *awaitable);
+
+    /// The stub the reply dispatcher calls with the reply.
+    static void reply_stub (TAO_InputCDR &cdr,
+                            ::Messaging::ReplyHandler_ptr reply_handler,
+                            CORBA::ULong reply_status);
+
+    /// True once the reply was demarshaled.
+    bool dispatched () const noexcept;
+
+    /// Let the reply resume the coroutine.  Returns false if it was
+    /// dispatched meanwhile, and the coroutine must go on by itself.
+    bool suspend () noexcept;
+
+    /// Forget the awaitable, which is going away.
+    void abandon ();
+
+  protected:
+    virtual ~Asynch_Reply_Awaiter () = default;
+
+  private:
+    enum
+    {
+      /// The request is being sent.
+      IDLE,
+      /// The coroutine waits for the reply.
+      SUSPENDED,
+      /// The reply is being demarshaled.
+      DISPATCHING,
+      /// The reply was demarshaled.
+      DISPATCHED,
+      /// The awaitable is gone.
+      ABANDONED
+    };
+
+    std::atomic<int> state_;
+    Asynch_Awaitable_Base *const awaitable_;
+  };
+
+  /**
+   * @class Asynch_Awaitable
+   *
+   * @brief What an async_ operation returns, holding its arguments.
+   *
+   * @a RET and @a ARGS are the Arg_Traits stub argument types of the
+   * operation, in the order of the synchronous signature, so the
+   * reply is demarshaled as a synchronous invocation would do it.
+   * The awaitable is neither copied nor moved, as the reply refers
+   * to the arguments in place; co_await it where it is returned, or
+   * keep it in a variable initialized with the call, to have several
+   * requests outstanding.  It returns what the synchronous operation would, and fills in
+   * its out and inout arguments.
+   */
+  template <typename RET, typename... ARGS>
+  class Asynch_Awaitable : public Asynch_Awaitable_Base
+  {
+  public:
+    template <typename... A>
+    Asynch_Awaitable (CORBA::Object_ptr target,
+                      const char *operation,
+                      size_t op_len,
+                      int collocation_opportunity,
+                      bool has_in_args,
+                      Exception_Data *ex_data,
+                      CORBA::ULong ex_count,
+                      A &&... args)
+      : Asynch_Awaitable_Base (target,
+                               this->signature_,
+                               1 + sizeof... (ARGS),
+                               operation,
+                               op_len,
+                               collocation_opportunity,
+                               has_in_args,
+                               ex_data,
+                               ex_count)
+      , args_ (std::forward<A> (args)...)
+    {
+      this->signature_[0] = std::addressof (this->ret_);
+      std::apply ([this] (ARGS &... a)
+                    {
+                      Argument **arg = this->signature_;
+                      ((*++arg = std::addressof (a)), ...);
+                    },
+                  this->args_);
+
+      this->send ();
+    }
+
+    Asynch_Awaitable (const Asynch_Awaitable &) = delete;
+    Asynch_Awaitable &operator= (const Asynch_Awaitable &) = delete;
+
+    /// Return the return value of the operation, or raise the
+    /// exception it raised.
+    auto await_resume ()
+    {
+      this->check_reply ();
+
+      if constexpr (!std::is_same_v<RET, RetArgument>)
+        {
+          return this->ret_.retn ();
+        }
+    }
+
+  private:
+    RET ret_;
+    std::tuple<ARGS...> args_;
+    Argument *signature_[1 + sizeof... (ARGS)];
+  };
+
+  /**
+   * @class Asynch_Task
+   *
+   * @brief The return type of a coroutine that runs as soon as it is
+   * called and that nobody waits for.
+   *
+   * It suits a coroutine that makes awaited invocations from a
+   * program's main line, which goes on with the coroutine suspended
+   * and runs the ORB to dispatch the replies.  The coroutine frees
+   * itself when it returns.  An exception it lets escape is reported
+   * with TAO debugging on, and otherwise dropped.
+   */
+  class Asynch_Task
+  {
+  public:
+    struct promise_type
+    {
+      Asynch_Task get_return_object () noexcept;
+      std::suspend_never initial_suspend () noexcept;
+      std::suspend_never final_suspend () noexcept;
+      void return_void () noexcept;
+      void unhandled_exception () noexcept;
+    };
+  };
+
+  inline
+  Asynch_Awaitable_Base::Asynch_Awaitable_Base (
+    CORBA::Object_ptr target,
+    Argument **args,
+    int arg_number,
+    const char *operation,
+    size_t op_len,
+    int collocation_opportunity,
+    bool has_in_args,
+    Exception_Data *ex_data,
+    CORBA::ULong ex_count)
+    : target_ (target)
+    , args_ (args)
+    , arg_number_ (arg_number)
+    , operation_ (operation)
+    , op_len_ (op_len)
+    , collocation_opportunity_ (collocation_opportunity)
+    , has_in_args_ (has_in_args)
+    , ex_data_ (ex_data)
+    , ex_count_ (ex_count)
+    , awaiter_ (nullptr)
+  {
+  }
+
+  inline
+  Asynch_Awaitable_Base::~Asynch_Awaitable_Base ()
+  {
+    if (this->awaiter_ != nullptr)
+      {
+        this->awaiter_->abandon ();
+        CORBA::release (this->awaiter_);
+      }
+  }
+
+  inline bool
+  Asynch_Awaitable_Base::await_ready () const noexcept
+  {
+    return this->awaiter_->dispatched ();
+  }
+
+  inline bool
+  Asynch_Awaitable_Base::await_suspend (
+    std::coroutine_handle<> continuation) noexcept
+  {
+    this->continuation_ = continuation;
+
+    // Once the coroutine is suspended the reply may resume it, and
+    // free this, on another thread.
+    return this->awaiter_->suspend ();
+  }
+
+  inline void
+  Asynch_Awaitable_Base::send ()
+  {
+    ACE_NEW_THROW_EX (this->awaiter_,
+                      Asynch_Reply_Awaiter (this),
+                      CORBA::NO_MEMORY ());
+
+    Asynch_Invocation_Adapter call (this->target_,
+                                    this->args_,
+                                    this->arg_number_,
+                                    this->operation_,
+                                    this->op_len_,
+                                    this->collocation_opportunity_,
+                                    TAO_ASYNCHRONOUS_CALLBACK_INVOCATION,
+                                    this->has_in_args_);
+
+    call.invoke (this->awaiter_, &Asynch_Reply_Awaiter::reply_stub);
+  }
+
+  inline void
+  Asynch_Awaitable_Base::check_reply ()
+  {
+    if (this->exception_)
+      {
+        std::rethrow_exception (this->exception_);
+      }
+  }
+
+  inline void
+  Asynch_Awaitable_Base::reply (TAO_InputCDR &cdr,
+                                CORBA::ULong reply_status) noexcept
+  {
+    try
+      {
+        switch (reply_status)
+          {
+          case TAO_AMI_REPLY_OK:
+            try
+              {
+                for (int i = 0; i != this->arg_number_; ++i)
+                  {
+                    if (!this->args_[i]->demarshal (cdr))
+                      {
+                        throw ::CORBA::MARSHAL ();
+                      }
+                  }
+
+                cdr.reset_vt_indirect_maps ();
+              }
+            catch (...)
+              {
+                cdr.reset_vt_indirect_maps ();
+                throw;
+              }
+            break;
+          case TAO_AMI_REPLY_USER_EXCEPTION:
+          case TAO_AMI_REPLY_SYSTEM_EXCEPTION:
+            {
+              const ACE_Message_Block *mb = cdr.start ();
+
+              ::CORBA::OctetSeq marshaled_exception (
+                  static_cast<CORBA::ULong> (mb->length ()),
+                  static_cast<CORBA::ULong> (mb->length ()),
+                  reinterpret_cast<unsigned char *> (mb->rd_ptr ()),
+                  false);
+
+              ::Messaging::ExceptionHolder *holder = nullptr;
+              ACE_NEW_THROW_EX (
+                  holder,
+                  ::TAO::ExceptionHolder (
+                    (reply_status == TAO_AMI_REPLY_SYSTEM_EXCEPTION),
+                    cdr.byte_order (),
+                    marshaled_exception,
+                    this->ex_data_,
+                    this->ex_count_,
+                    cdr.char_translator (),
+                    cdr.wchar_translator ()),
+                  CORBA::NO_MEMORY ());
+
+              ::Messaging::ExceptionHolder_var holder_var = holder;
+              holder->raise_exception ();
+            }
+            break;
+          default:
+            // A forwarded request is not sent again, as with sendc_.
+            throw ::CORBA::TRANSIENT (0, CORBA::COMPLETED_NO);
+          }
+      }
+    catch (...)
+      {
+        this->exception_ = std::current_exception ();
+      }
+  }
+
+  inline
+  Asynch_Reply_Awaiter::Asynch_Reply_Awaiter (Asynch_Awaitable_Base *awaitable)
+    : state_ (IDLE)
+    , awaitable_ (awaitable)
+  {
+  }
+
+  inline void
+  Asynch_Reply_Awaiter::reply_stub (
+    TAO_InputCDR &cdr,
+    ::Messaging::ReplyHandler_ptr reply_handler,
+    CORBA::ULong reply_status)
+  {
+    Asynch_Reply_Awaiter *const awaiter =
+      dynamic_cast<Asynch_Reply_Awaiter *> (reply_handler);
+
+    if (awaiter == nullptr)
+      {
+        return;
+      }
+
+    int prior = awaiter->state_.load (std::memory_order_acquire);
+
+    do
+      {
+        // The coroutine went away, or the reply came already.
+        if (prior != IDLE && prior != SUSPENDED)
+          {
+            return;
+          }
+      }
+    while (!awaiter->state_.compare_exchange_weak (prior,
+                                                   DISPATCHING,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+
+    Asynch_Awaitable_Base *const awaitable = awaiter->awaitable_;
+    awaitable->reply (cdr, reply_status);
+
+    // A coroutine that was not suspended yet goes on by itself.
+    if (prior == SUSPENDED)
+      {
+        std::coroutine_handle<> const continuation = awaitable->continuation_;
+        awaiter->state_.store (DISPATCHED, std::memory_order_release);
+        continuation.resume ();
+      }
+    else
+      {
+        awaiter->state_.store (DISPATCHED, std::memory_order_release);
+      }
+  }
+
+  inline bool
+  Asynch_Reply_Awaiter::dispatched () const noexcept
+  {
+    return this->state_.load (std::memory_order_acquire) == DISPATCHED;
+  }
+
+  inline bool
+  Asynch_Reply_Awaiter::suspend () noexcept
+  {
+    int prior = IDLE;
+
+    if (this->state_.compare_exchange_strong (prior,
+                                              SUSPENDED,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire))
+      {
+        return true;
+      }
+
+    // The reply came meanwhile, wait until it is demarshaled.
+    while (prior == DISPATCHING)
+      {
+        ACE_OS::thr_yield ();
+        prior = this->state_.load (std::memory_order_acquire);
+      }
+
+    return false;
+  }
+
+  inline void
+  Asynch_Reply_Awaiter::abandon ()
+  {
+    int prior = this->state_.load (std::memory_order_acquire);
+
+    do
+      {
+        while (prior == DISPATCHING)
+          {
+            ACE_OS::thr_yield ();
+            prior = this->state_.load (std::memory_order_acquire);
+          }
+      }
+    while (!this->state_.compare_exchange_weak (prior,
+                                                ABANDONED,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire));
+  }
+
+  inline Asynch_Task
+  Asynch_Task::promise_type::get_return_object () noexcept
+  {
+    return Asynch_Task ();
+  }
+
+  inline std::suspend_never
+  Asynch_Task::promise_type::initial_suspend () noexcept
+  {
+    return std::suspend_never ();
+  }
+
+  inline std::suspend_never
+  Asynch_Task::promise_type::final_suspend () noexcept
+  {
+    return std::suspend_never ();
+  }
+
+  inline void
+  Asynch_Task::promise_type::return_void () noexcept
+  {
+  }
+
+  inline void
+  Asynch_Task::promise_type::unhandled_exception () noexcept
+  {
+    try
+      {
+        throw;
+      }
+    catch (const ::CORBA::Exception &ex)
+      {
+        if (TAO_debug_level > 0)
+          {
+            ex._tao_print_exception ("TAO::Asynch_Task - unhandled exception");
+          }
+      }
+    catch (...)
+      {
+        if (TAO_debug_level > 0)
+          {
+            TAOLIB_ERROR ((LM_ERROR,
+                           ACE_TEXT ("TAO (%P|%t) - Asynch_Task, ")
+                           ACE_TEXT ("unhandled exception\n")));
+          }
+      }
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_MESSAGING_ASYNCH_AWAITABLE_H */
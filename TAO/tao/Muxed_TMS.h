@@ -38,8 +38,8 @@ class TAO_Reply_Dispatcher;
  *
  * Using this strategy a single connection can have multiple
  * outstanding requests.
- * @@ Can the performance of the demuxer be made more predictable,
- * for example, using the request id as an active demux key?
+ * @note TAO_Active_Demux_TMS uses the request id as an active demux
+ * key instead, for connections with many outstanding requests.
  * @note Check the OMG resolutions about bidirectional
  * connections, it is possible that the request ids can only
  * assume even or odd values.
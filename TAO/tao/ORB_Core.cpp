@@ -1093,6 +1093,13 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
         {
           this->orb_params_.max_message_size (ACE_OS::atoi (current_arg));
 
+          arg_shifter.consume_arg ();
+        }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBCDRReserve"))))
+        {
+          this->orb_params_.cdr_reserve_threshold (ACE_OS::atoi (current_arg));
+
           arg_shifter.consume_arg ();
         }
       else if (nullptr != (current_arg = arg_shifter.get_the_parameter
@@ -2,6 +2,7 @@
 #define TAO_OBJECT_ARGUMENT_T_CPP
 
 #include "tao/Object_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 
 #if !defined (__ACE_INLINE__)
 #include "tao/Object_Argument_T.inl"
@@ -17,6 +18,14 @@ TAO::In_Object_Argument_T<S_ptr,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S_ptr,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Object_Argument_T<S_ptr,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_ptr,
@@ -83,6 +92,15 @@ TAO::Inout_Object_Argument_T<S_ptr,S_traits,Insert_Policy>::marshal (TAO_OutputC
   return cdr << this->x_;
 }
 
+template<typename S_ptr,
+         typename S_traits,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Object_Argument_T<S_ptr,S_traits,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S_ptr,
          typename S_traits,
          template <typename> class Insert_Policy>
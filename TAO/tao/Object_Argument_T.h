@@ -38,6 +38,7 @@ namespace TAO
     In_Object_Argument_T (S_ptr x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
 #endif /* TAO_HAS_INTERCEPTORS == 1 */
@@ -90,6 +91,7 @@ namespace TAO
     Inout_Object_Argument_T (S_ptr & x);
 
     virtual CORBA::Boolean marshal (TAO_OutputCDR &cdr);
+    virtual CORBA::Boolean marshal_size (ACE_SizeCDR &cdr);
     virtual CORBA::Boolean demarshal (TAO_InputCDR &cdr);
 #if TAO_HAS_INTERCEPTORS == 1
     virtual void interceptor_value (CORBA::Any *any) const;
@@ -21,6 +21,8 @@
 
 #include "tao/varbase.h"
 
+#include <utility>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_OutputCDR;
@@ -50,10 +52,12 @@ public:
   TAO_Objref_Var_T ();
   TAO_Objref_Var_T (T * p) : ptr_ (p) {}
   TAO_Objref_Var_T (const TAO_Objref_Var_T<T> &);
+  TAO_Objref_Var_T (TAO_Objref_Var_T<T> &&) noexcept;
   ~TAO_Objref_Var_T ();
 
   TAO_Objref_Var_T<T> & operator= (T *);
   TAO_Objref_Var_T<T> & operator= (const TAO_Objref_Var_T<T> &);
+  TAO_Objref_Var_T<T> & operator= (TAO_Objref_Var_T<T> &&) noexcept;
   T * operator-> () const;
 
   /// Cast operators.
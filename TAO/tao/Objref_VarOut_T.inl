@@ -8,6 +8,24 @@ TAO_Objref_Var_T<T>::TAO_Objref_Var_T (void)
 {
 }
 
+template <typename T>
+ACE_INLINE
+TAO_Objref_Var_T<T>::TAO_Objref_Var_T (TAO_Objref_Var_T<T> && p) noexcept
+  : TAO_Base_var (),
+    ptr_ (p.ptr_)
+{
+  p.ptr_ = TAO::Objref_Traits<T>::nil ();
+}
+
+template <typename T>
+ACE_INLINE
+TAO_Objref_Var_T<T> &
+TAO_Objref_Var_T<T>::operator= (TAO_Objref_Var_T<T> && p) noexcept
+{
+  std::swap (this->ptr_, p.ptr_);
+  return *this;
+}
+
 template <typename T>
 ACE_INLINE
 TAO_Objref_Var_T<T>::~TAO_Objref_Var_T (void)
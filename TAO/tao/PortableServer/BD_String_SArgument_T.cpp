@@ -5,6 +5,8 @@
 #include "tao/PortableServer/BD_String_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #include "tao/SystemException.h"
 
 #if !defined (__ACE_INLINE__)
@@ -61,6 +63,15 @@ TAO::Inout_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal (
   return cdr << this->x_.in ();
 }
 
+template<typename S_var,
+         size_t BOUND,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 template<typename S_var,
          size_t BOUND,
          template <typename> class Insert_Policy>
@@ -109,6 +120,15 @@ TAO::Out_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal (
   return cdr << this->x_.in ();
 }
 
+template<typename S_var,
+         size_t BOUND,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
@@ -142,6 +162,15 @@ TAO::Ret_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal (
   return cdr << this->x_.in ();
 }
 
+template<typename S_var,
+         size_t BOUND,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_BD_String_SArgument_T<S_var,BOUND,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
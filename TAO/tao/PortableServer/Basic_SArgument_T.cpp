@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Basic_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Basic_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -41,6 +43,14 @@ TAO::Inout_Basic_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Basic_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -71,6 +81,14 @@ TAO::Out_Basic_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Basic_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -93,6 +111,14 @@ TAO::Ret_Basic_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Basic_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
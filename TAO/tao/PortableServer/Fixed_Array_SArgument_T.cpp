@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Fixed_Array_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Fixed_Array_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -46,6 +48,16 @@ TAO::Inout_Fixed_Array_SArgument_T<S_forany,
   return cdr << S_forany (this->x_);
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Fixed_Array_SArgument_T<S_forany,
+                                   Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_));
+}
+
 template<typename S_forany,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -82,6 +94,16 @@ TAO::Out_Fixed_Array_SArgument_T<S_forany,
   return cdr << S_forany (this->x_);
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Fixed_Array_SArgument_T<S_forany,
+                                 Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_forany,
@@ -111,6 +133,18 @@ TAO::Ret_Fixed_Array_SArgument_T<S_var,
   return cdr << S_forany (this->x_.inout ());
 }
 
+template<typename S_var,
+         typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Fixed_Array_SArgument_T<S_var,
+                                 S_forany,
+                                 Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_.inout ()));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
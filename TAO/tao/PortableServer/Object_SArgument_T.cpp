@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Object_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Object_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -45,6 +47,15 @@ TAO::Inout_Object_SArgument_T<S_ptr,S_var,Insert_Policy>::marshal (TAO_OutputCDR
   return cdr << this->x_.in ();
 }
 
+template<typename S_ptr,
+         typename S_var,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Object_SArgument_T<S_ptr,S_var,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 template<typename S_ptr,
          typename S_var,
          template <typename> class Insert_Policy>
@@ -80,6 +91,16 @@ TAO::Out_Object_SArgument_T<S_ptr,S_var,S_out,Insert_Policy>::marshal (TAO_Outpu
   return cdr << this->x_.in ();
 }
 
+template<typename S_ptr,
+         typename S_var,
+         typename S_out,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Object_SArgument_T<S_ptr,S_var,S_out,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_ptr,
@@ -106,6 +127,15 @@ TAO::Ret_Object_SArgument_T<S_ptr,S_var,Insert_Policy>::marshal (TAO_OutputCDR &
   return cdr << this->x_.in ();
 }
 
+template<typename S_ptr,
+         typename S_var,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Object_SArgument_T<S_ptr,S_var,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_ptr,
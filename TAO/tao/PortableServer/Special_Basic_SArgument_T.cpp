@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Special_Basic_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Special_Basic_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -55,6 +57,16 @@ TAO::Inout_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal (
   return cdr << from_S (this->x_);
 }
 
+template<typename S,
+         typename to_S,
+         typename from_S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, from_S (this->x_));
+}
+
 template<typename S,
          typename to_S,
          typename from_S,
@@ -96,6 +108,16 @@ TAO::Out_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal (
   return cdr << from_S (this->x_);
 }
 
+template<typename S,
+         typename to_S,
+         typename from_S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, from_S (this->x_));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -125,6 +147,16 @@ TAO::Ret_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal (
   return cdr << from_S (this->x_);
 }
 
+template<typename S,
+         typename to_S,
+         typename from_S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Special_Basic_SArgument_T<S,to_S,from_S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, from_S (this->x_));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -5,6 +5,8 @@
 #include "tao/PortableServer/UB_String_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/UB_String_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -39,6 +41,13 @@ TAO::Inout_UB_String_SArgument_T<S,S_var>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_.in ();
 }
 
+template<typename S, typename S_var>
+CORBA::Boolean
+TAO::Inout_UB_String_SArgument_T<S,S_var>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 template<typename S, typename S_var>
 CORBA::Boolean
 TAO::Inout_UB_String_SArgument_T<S,S_var>::demarshal (TAO_InputCDR & cdr)
@@ -67,6 +76,13 @@ TAO::Out_UB_String_SArgument_T<S,S_var>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_.in ();
 }
 
+template<typename S, typename S_var>
+CORBA::Boolean
+TAO::Out_UB_String_SArgument_T<S,S_var>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S, typename S_var>
@@ -88,6 +104,13 @@ TAO::Ret_UB_String_SArgument_T<S,S_var>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_.in ();
 }
 
+template<typename S, typename S_var>
+CORBA::Boolean
+TAO::Ret_UB_String_SArgument_T<S,S_var>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S, typename S_var>
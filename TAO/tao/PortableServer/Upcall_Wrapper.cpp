@@ -5,13 +5,13 @@
 
 #if TAO_HAS_INTERCEPTORS == 1
 # include "tao/ServerRequestInterceptor_Adapter.h"
-# include "tao/ORB_Core.h"
 #endif  /* TAO_HAS_INTERCEPTORS == 1 */
 
 #include "tao/PortableInterceptorC.h"
 #include "tao/PortableInterceptor.h"
 
 #include "tao/TAO_Server_Request.h"
+#include "tao/ORB_Core.h"
 #include "tao/CDR.h"
 #include "tao/Argument.h"
 #include "tao/operation_details.h"
@@ -253,6 +253,12 @@ TAO::Upcall_Wrapper::post_upcall (TAO_ServerRequest& server_request,
   TAO::Argument * const * const end   = args + nargs;
 
   try {
+    TAO::reserve_arguments (
+      cdr,
+      args,
+      nargs,
+      server_request.orb_core ()->orb_params ()->cdr_reserve_threshold ());
+
     errno = 0;
     for (TAO::Argument * const * i = begin; i != end; ++i)
       {
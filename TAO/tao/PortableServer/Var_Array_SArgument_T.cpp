@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Var_Array_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Var_Array_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -46,6 +48,16 @@ TAO::Inout_Var_Array_SArgument_T<S_forany,
   return cdr << S_forany (this->x_);
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Var_Array_SArgument_T<S_forany,
+                                 Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_));
+}
+
 template<typename S_forany,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -89,6 +101,18 @@ TAO::Out_Var_Array_SArgument_T<S_var,
   return cdr << tmp;
 }
 
+template<typename S_var,
+         typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Var_Array_SArgument_T<S_var,
+                               S_forany,
+                               Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_.ptr ()));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
@@ -120,6 +144,18 @@ TAO::Ret_Var_Array_SArgument_T<S_var,
   return cdr << S_forany (this->x_.ptr ());
 }
 
+template<typename S_var,
+         typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Var_Array_SArgument_T<S_var,
+                               S_forany,
+                               Insert_Policy>::marshal_size (
+    ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, S_forany (this->x_.ptr ()));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
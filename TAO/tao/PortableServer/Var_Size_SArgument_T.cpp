@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Var_Size_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/CDR_Size_T.h"
+
 #include "tao/SystemException.h"
 
 #if !defined (__ACE_INLINE__)
@@ -44,6 +46,14 @@ TAO::Inout_Var_Size_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Var_Size_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -78,6 +88,14 @@ TAO::Out_Var_Size_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_.in ();
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Out_Var_Size_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -101,6 +119,14 @@ TAO::Ret_Var_Size_SArgument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_.in ();
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Ret_Var_Size_SArgument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_.in ());
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
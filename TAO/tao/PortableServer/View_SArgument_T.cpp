@@ -0,0 +1,66 @@
+#ifndef TAO_VIEW_SARGUMENT_T_CPP
+#define TAO_VIEW_SARGUMENT_T_CPP
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#include "tao/PortableServer/View_SArgument_T.h"
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include "tao/SystemException.h"
+
+#if !defined (__ACE_INLINE__)
+#include "tao/PortableServer/View_SArgument_T.inl"
+#endif /* __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template<typename T,
+         typename V,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_View_SArgument_T<T,V,Insert_Policy>::demarshal (TAO_InputCDR &cdr)
+{
+  return this->x_._tao_bind (cdr);
+}
+
+#if TAO_HAS_INTERCEPTORS == 1
+
+template<typename T,
+         typename V,
+         template <typename> class Insert_Policy>
+void
+TAO::In_View_SArgument_T<T,V,Insert_Policy>::interceptor_value (
+    CORBA::Any *any) const
+{
+  T x;
+  this->x_._decode (x);
+  Insert_Policy<T>::any_insert (any, x);
+}
+
+#endif /* TAO_HAS_INTERCEPTORS */
+
+template<typename T,
+         typename V,
+         template <typename> class Insert_Policy>
+void
+TAO::In_View_SArgument_T<T,V,Insert_Policy>::bind (T const &x)
+{
+  TAO_OutputCDR out;
+  if (!(out << x))
+    {
+      throw ::CORBA::MARSHAL ();
+    }
+
+  TAO_InputCDR *in = 0;
+  ACE_NEW_THROW_EX (in,
+                    TAO_InputCDR (out),
+                    CORBA::NO_MEMORY ());
+  this->collocated_.reset (in);
+  if (!this->x_._tao_bind (*this->collocated_))
+    {
+      throw ::CORBA::MARSHAL ();
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_VIEW_SARGUMENT_T_CPP */
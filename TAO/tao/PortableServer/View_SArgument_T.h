@@ -0,0 +1,97 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    View_SArgument_T.h
+ *
+ *  Skeleton argument passing an @c in struct to the servant as the
+ *  read-only view tao_idl generates for it with -Gview, over the
+ *  request, instead of demarshaling it.
+ */
+//=============================================================================
+
+#ifndef TAO_VIEW_SARGUMENT_T_H
+#define TAO_VIEW_SARGUMENT_T_H
+
+#include /**/ "ace/pre.h"
+#include "tao/Argument.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/CDR.h"
+
+#include <memory>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * @class In_View_SArgument_T
+   *
+   * @brief Template class for IN skeleton argument of a struct @a T
+   * read through its view @a V.
+   *
+   * The view refers to the stream of the request, which outlives the
+   * upcall.  A collocated caller passes the struct itself; it is
+   * marshaled into a stream the argument owns, and viewed there.
+   */
+  template<typename T,
+           typename V,
+           template <typename> class Insert_Policy>
+  class In_View_SArgument_T : public InArgument
+  {
+  public:
+    virtual CORBA::Boolean demarshal (TAO_InputCDR &);
+#if TAO_HAS_INTERCEPTORS == 1
+    virtual void interceptor_value (CORBA::Any *any) const;
+#endif /* TAO_HAS_INTERCEPTORS == 1 */
+
+    /// View @a x, passed by a collocated caller.
+    void bind (T const &x);
+
+    V const & arg () const;
+
+  private:
+    V x_;
+
+    /// The stream @a x_ refers to when passed by a collocated caller.
+    std::unique_ptr<TAO_InputCDR> collocated_;
+  };
+
+  /**
+   * @struct View_SArg_Traits_T
+   *
+   * @brief Template class for skeleton argument traits of the views
+   * of IDL structs, which are only @c in arguments.
+   */
+  template<typename T,
+           typename V,
+           template <typename> class Insert_Policy>
+  struct View_SArg_Traits_T
+  {
+    typedef const V &                                       in_type;
+    typedef In_View_SArgument_T<T,V,Insert_Policy>          in_arg_val;
+    typedef in_type                                         in_arg_type;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "tao/PortableServer/View_SArgument_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "tao/PortableServer/View_SArgument_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("View_SArgument_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_VIEW_SARGUMENT_T_H */
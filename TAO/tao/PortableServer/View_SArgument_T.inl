@@ -0,0 +1,14 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template<typename T,
+         typename V,
+         template <typename> class Insert_Policy>
+ACE_INLINE
+V const &
+TAO::In_View_SArgument_T<T,V,Insert_Policy>::arg () const
+{
+  return this->x_;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
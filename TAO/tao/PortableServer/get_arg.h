@@ -65,6 +65,27 @@ namespace TAO
             skel_args[i])->arg ();
     }
 
+    /// Get "in" argument of the struct type @a T as its view @a V.
+    template<typename T, typename V>
+    typename TAO::SArg_Traits<V>::in_arg_type
+    get_in_view_arg (TAO_Operation_Details const * details,
+                     TAO::Argument * const * skel_args,
+                     size_t i)
+    {
+      typename TAO::SArg_Traits<V>::in_arg_val * const arg =
+        static_cast<typename TAO::SArg_Traits<V>::in_arg_val *> (
+          skel_args[i]);
+
+      if (details != 0 && details->use_stub_args ())
+        {
+          arg->bind (
+            static_cast<typename TAO::Arg_Traits<T>::in_arg_val *> (
+              details->args ()[i])->arg ());
+        }
+
+      return arg->arg ();
+    }
+
     /// Get "inout" argument.
     template<typename T>
     typename TAO::SArg_Traits<T>::inout_arg_type
@@ -21,6 +21,7 @@
 #include "tao/RTCORBA/RT_ORB.h"
 #include "tao/RTCORBA/RT_Current.h"
 #include "tao/RTCORBA/RT_Thread_Lane_Resources_Manager.h"
+#include "tao/RTCORBA/Thread_Pool.h"
 #include "tao/RTCORBA/RT_Service_Context_Handler.h"
 
 #include "tao/Exception.h"
@@ -49,14 +50,16 @@ TAO_RT_ORBInitializer::TAO_RT_ORBInitializer (int priority_mapping_type,
                                               long sched_policy,
                                               long scope_policy,
                                               TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                                              ACE_Time_Value const &dynamic_thread_time)
+                                              ACE_Time_Value const &dynamic_thread_time,
+                                              TAO_RTCORBA_Lane_CPUs const &lane_cpus)
   : priority_mapping_type_ (priority_mapping_type),
     network_priority_mapping_type_ (network_priority_mapping_type),
     ace_sched_policy_ (ace_sched_policy),
     sched_policy_ (sched_policy),
     scope_policy_ (scope_policy),
     lifespan_ (lifespan),
-    dynamic_thread_time_ (dynamic_thread_time)
+    dynamic_thread_time_ (dynamic_thread_time),
+    lane_cpus_ (lane_cpus)
 {
 }
 
@@ -177,8 +180,8 @@ TAO_RT_ORBInitializer::pre_init (PortableInterceptor::ORBInitInfo_ptr info)
                                     network_manager);
 
   // Create the RT_ORB.
-  CORBA::Object_ptr rt_orb = CORBA::Object::_nil ();
-  ACE_NEW_THROW_EX (rt_orb,
+  TAO_RT_ORB *tao_rt_orb = 0;
+  ACE_NEW_THROW_EX (tao_rt_orb,
                     TAO_RT_ORB (tao_info->orb_core (),
                     lifespan_,
                     dynamic_thread_time_),
@@ -187,8 +190,12 @@ TAO_RT_ORBInitializer::pre_init (PortableInterceptor::ORBInitInfo_ptr info)
                         TAO::VMCID,
                         ENOMEM),
                       CORBA::COMPLETED_NO));
+  CORBA::Object_ptr rt_orb = tao_rt_orb;
   CORBA::Object_var safe_rt_orb = rt_orb;
 
+  // Tell the thread pools where to run the threads of their lanes.
+  tao_rt_orb->tp_manager ().lane_cpus (this->lane_cpus_);
+
   info->register_initial_reference (TAO_OBJID_RTORB, rt_orb);
 
   // Create the RT_Current.
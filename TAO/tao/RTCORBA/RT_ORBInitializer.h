@@ -26,6 +26,8 @@
 
 #include "tao/PI/PI.h"
 #include "tao/LocalObject.h"
+#include "ace/Array_Map.h"
+#include "ace/SString.h"
 
 // This is to remove "inherits via dominance" warnings from MSVC.
 // MSVC is being a little too paranoid.
@@ -71,13 +73,19 @@ public:
     TAO_RTCORBA_DT_FIXED
   };
 
+  /// CPUs the threads of the lanes run on, given with
+  /// -RTORBLaneCPUs and keyed by "pool:lane", either of which may be
+  /// "*".
+  typedef ACE_Array_Map<ACE_CString, ACE_CString> TAO_RTCORBA_Lane_CPUs;
+
   TAO_RT_ORBInitializer (int priority_mapping_type,
                          int network_priority_mapping_type,
                          int ace_sched_policy,
                          long sched_policy,
                          long scope_policy,
                          TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                         ACE_Time_Value const &dynamic_thread_time);
+                         ACE_Time_Value const &dynamic_thread_time,
+                         TAO_RTCORBA_Lane_CPUs const &lane_cpus);
 
   virtual void pre_init (PortableInterceptor::ORBInitInfo_ptr info);
 
@@ -140,6 +148,9 @@ private:
    * a time can be specified
    */
   ACE_Time_Value const dynamic_thread_time_;
+
+  /// CPUs of the lanes.
+  TAO_RTCORBA_Lane_CPUs const lane_cpus_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
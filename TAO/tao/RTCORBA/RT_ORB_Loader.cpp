@@ -9,6 +9,7 @@
 #include "tao/ORBInitializer_Registry.h"
 #include "tao/SystemException.h"
 #include "ace/OS_NS_strings.h"
+#include "ace/Thread_Placement.h"
 #include "ace/Arg_Shifter.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -57,6 +58,7 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
   int curarg = 0;
   ACE_Time_Value dynamic_thread_time;
   TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan = TAO_RT_ORBInitializer::TAO_RTCORBA_DT_INFINITIVE;
+  TAO_RT_ORBInitializer::TAO_RTCORBA_Lane_CPUs lane_cpus;
 
   ACE_Arg_Shifter arg_shifter (argc, argv);
 
@@ -161,6 +163,32 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
           lifespan = TAO_RT_ORBInitializer::TAO_RTCORBA_DT_FIXED;
           arg_shifter.consume_arg ();
         }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter
+                                   (ACE_TEXT("-RTORBLaneCPUs"))))
+        {
+          // -RTORBLaneCPUs <pool>:<lane> <cpus>, where <cpus> is a
+          // list such as "0-3,8" or "node1", binds the threads of a
+          // lane to the CPUs, round robin.
+          ACE_CString const lane (ACE_TEXT_ALWAYS_CHAR (current_arg));
+          arg_shifter.consume_arg ();
+
+          ACE_Thread_Placement placement;
+          if (arg_shifter.is_option_next ()
+              || !arg_shifter.is_anything_left ()
+              || placement.add (arg_shifter.get_current ()) != 0)
+            {
+              TAOLIB_DEBUG ((LM_DEBUG,
+                          ACE_TEXT("RT_ORB_Loader - bad CPUs")
+                          ACE_TEXT(" for -RTORBLaneCPUs <%C>\n"),
+                          lane.c_str ()));
+            }
+          else
+            {
+              lane_cpus[lane] =
+                ACE_TEXT_ALWAYS_CHAR (arg_shifter.get_current ());
+              arg_shifter.consume_arg ();
+            }
+        }
     else
       {
         arg_shifter.ignore_arg ();
@@ -188,7 +216,8 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
                                                sched_policy,
                                                scope_policy,
                                                lifespan,
-                                               dynamic_thread_time),
+                                               dynamic_thread_time,
+                                               lane_cpus),
                         CORBA::NO_MEMORY (
                           CORBA::SystemException::_tao_minor_code (
                             TAO::VMCID,
@@ -17,6 +17,7 @@
 #include "tao/LF_Follower.h"
 #include "tao/Leader_Follower.h"
 #include "ace/Auto_Ptr.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -171,7 +172,9 @@ TAO_Thread_Lane::TAO_Thread_Lane (TAO_Thread_Pool &pool,
                 &new_thread_generator_),
     native_priority_ (TAO_INVALID_PRIORITY),
     lifespan_ (lifespan),
-    dynamic_thread_time_ (dynamic_thread_time)
+    dynamic_thread_time_ (dynamic_thread_time),
+    static_placement_ (ACE_Thread_Placement::ROUND_ROBIN),
+    dynamic_placement_ (ACE_Thread_Placement::SHARED)
 {
 }
 
@@ -286,6 +289,18 @@ TAO_Thread_Lane::open (void)
   // Validate and map priority.
   this->validate_and_map_priority ();
 
+  // Bind the threads to the CPUs given for the lane, if any.
+  this->pool ().manager ().lane_placement (this->pool ().id (),
+                                           this->id (),
+                                           this->static_placement_);
+  if (!this->static_placement_.empty ())
+    {
+      this->dynamic_placement_ = this->static_placement_;
+      this->dynamic_placement_.policy (ACE_Thread_Placement::SHARED);
+      this->static_threads_.thread_placement (&this->static_placement_);
+      this->dynamic_threads_.thread_placement (&this->dynamic_placement_);
+    }
+
   char pool_lane_id[10];
   TAO_ORB_Parameters *params =
     this->pool ().manager ().orb_core ().orb_params ();
@@ -942,6 +957,39 @@ TAO_Thread_Pool_Manager::get_threadpool (RTCORBA::ThreadpoolId thread_pool_id )
   return thread_pool;
 }
 
+void
+TAO_Thread_Pool_Manager::lane_cpus (
+  TAO_RT_ORBInitializer::TAO_RTCORBA_Lane_CPUs const &lane_cpus)
+{
+  this->lane_cpus_ = lane_cpus;
+}
+
+void
+TAO_Thread_Pool_Manager::lane_placement (RTCORBA::ThreadpoolId pool,
+                                         CORBA::ULong lane,
+                                         ACE_Thread_Placement &placement) const
+{
+  placement.clear ();
+
+  // The most specific entry wins.
+  char pool_lane_ids[4][24];
+  ACE_OS::sprintf (pool_lane_ids[0], "%u:%u", pool, lane);
+  ACE_OS::sprintf (pool_lane_ids[1], "%u:*", pool);
+  ACE_OS::sprintf (pool_lane_ids[2], "*:%u", lane);
+  ACE_OS::strcpy (pool_lane_ids[3], "*:*");
+
+  for (size_t i = 0; i != 4; ++i)
+    {
+      TAO_RT_ORBInitializer::TAO_RTCORBA_Lane_CPUs::const_iterator const
+        entry = this->lane_cpus_.find (ACE_CString (pool_lane_ids[i]));
+      if (entry != this->lane_cpus_.end ())
+        {
+          placement.add (ACE_TEXT_CHAR_TO_TCHAR (entry->second.c_str ()));
+          return;
+        }
+    }
+}
+
 TAO_ORB_Core &
 TAO_Thread_Pool_Manager::orb_core () const
 {
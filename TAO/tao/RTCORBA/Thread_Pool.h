@@ -27,6 +27,7 @@
 #include "tao/Thread_Lane_Resources.h"
 #include "tao/New_Leader_Generator.h"
 #include "ace/Task.h"
+#include "ace/Thread_Placement.h"
 #include "ace/Null_Mutex.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -240,6 +241,13 @@ private:
 
   /// Lock to guard all members of the lane
   mutable TAO_SYNCH_MUTEX lock_;
+
+  /// CPUs of the static threads, one each, round robin.
+  ACE_Thread_Placement static_placement_;
+
+  /// CPUs of the dynamic threads, which come and go so may run on
+  /// any of the CPUs of the lane.
+  ACE_Thread_Placement dynamic_placement_;
 };
 
 class TAO_Thread_Pool_Manager;
@@ -405,6 +413,18 @@ public:
   /// Collection of thread pools.
   typedef ACE_Hash_Map_Manager<RTCORBA::ThreadpoolId, TAO_Thread_Pool *, ACE_Null_Mutex> THREAD_POOLS;
 
+  /// Set the CPUs the threads of the lanes run on.
+  void lane_cpus (TAO_RT_ORBInitializer::TAO_RTCORBA_Lane_CPUs const &lane_cpus);
+
+  /**
+   * Add to @a placement the CPUs given for lane @a lane of pool
+   * @a pool, looking for "pool:lane", "pool:*", "*:lane" and "*:*" in
+   * that order.  Leaves @a placement empty if there are none.
+   */
+  void lane_placement (RTCORBA::ThreadpoolId pool,
+                       CORBA::ULong lane,
+                       ACE_Thread_Placement &placement) const;
+
   /// @name Accessors
   // @{
   TAO_ORB_Core &orb_core () const;
@@ -447,6 +467,9 @@ private:
   THREAD_POOLS thread_pools_;
   RTCORBA::ThreadpoolId thread_pool_id_counter_;
   TAO_SYNCH_MUTEX lock_;
+
+  /// CPUs of the lanes.
+  TAO_RT_ORBInitializer::TAO_RTCORBA_Lane_CPUs lane_cpus_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
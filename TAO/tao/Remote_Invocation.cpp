@@ -2,6 +2,7 @@
 #include "tao/Profile.h"
 #include "tao/Profile_Transport_Resolver.h"
 #include "tao/Stub.h"
+#include "tao/Argument.h"
 #include "tao/Connection_Handler.h"
 #include "tao/ORB_Core.h"
 #include "tao/Protocols_Hooks.h"
@@ -33,6 +34,22 @@ namespace TAO
   {
   }
 
+  void
+  Remote_Invocation::marshal_data (TAO_OutputCDR &out_stream)
+  {
+    TAO::reserve_arguments (
+      out_stream,
+      this->details_.args (),
+      this->details_.args_num (),
+      this->resolver_.stub ()->orb_core ()->orb_params ()->cdr_reserve_threshold ());
+
+    // Marshal application data
+    if (this->details_.marshal_args (out_stream) == false)
+      {
+        throw ::CORBA::MARSHAL ();
+      }
+  }
+
   void
   Remote_Invocation::init_target_spec (TAO_Target_Specification &target_spec,
                                        TAO_OutputCDR &output)
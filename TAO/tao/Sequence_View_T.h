@@ -0,0 +1,450 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Sequence_View_T.h
+ *
+ *  Read-only views of sequences over the CDR stream they were received
+ *  in, for the members of the views tao_idl generates with -Gview.
+ *
+ *  The elements of fixed size types are found at once from their
+ *  index; those of other types by skipping the elements before them,
+ *  from the last one accessed, so that the sequence is walked once
+ *  when read in order.
+ */
+//=============================================================================
+
+#ifndef TAO_SEQUENCE_VIEW_T_H
+#define TAO_SEQUENCE_VIEW_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/CDR_View.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/SystemException.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /// Nothing is kept for elements decoded on each access.
+  struct View_No_Cache
+  {
+  };
+
+  namespace details
+  {
+    inline ::CORBA::Boolean
+    view_read (TAO_InputCDR &strm, ::CORBA::Boolean &x)
+    {
+      return strm >> ACE_InputCDR::to_boolean (x);
+    }
+
+    inline ::CORBA::Boolean
+    view_read (TAO_InputCDR &strm, ::CORBA::Char &x)
+    {
+      return strm >> ACE_InputCDR::to_char (x);
+    }
+
+    inline ::CORBA::Boolean
+    view_read (TAO_InputCDR &strm, ::CORBA::Octet &x)
+    {
+      return strm >> ACE_InputCDR::to_octet (x);
+    }
+
+    inline ::CORBA::Boolean
+    view_read (TAO_InputCDR &strm, ::CORBA::WChar &x)
+    {
+      return strm >> ACE_InputCDR::to_wchar (x);
+    }
+
+    template<typename T>
+    inline ::CORBA::Boolean
+    view_read (TAO_InputCDR &strm, T &x)
+    {
+      return strm >> x;
+    }
+  }
+
+  /**
+   * How a Sequence_View reads its elements:
+   *
+   * - @c value_type what operator[] returns;
+   * - @c cache_type what is kept in the view to return a value that
+   *   is not in the stream as is, such as a translated string;
+   * - @c fixed_size the size of an element in CDR if it is always the
+   *   same, else 0, and @c alignment its CDR alignment;
+   * - @c in_place true if the stream holds the elements as they are
+   *   laid out in memory, when the byte order is the one of this host;
+   * - @c skip (strm) and @c get (view, pos, cache) skip an element,
+   *   and read the one at @a pos; the traits of the types read
+   *   without a cache also have @c get (view, pos).
+   *
+   * This default is for the views tao_idl generates for structs.
+   */
+  template<typename T>
+  struct View_Element_Traits
+  {
+    typedef T value_type;
+    typedef View_No_Cache cache_type;
+    static size_t const fixed_size = 0;
+    static size_t const alignment = 1;
+    static bool const in_place = false;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return T::_tao_skip (strm);
+    }
+
+    static value_type get (const View_Base &view, size_t pos, cache_type &)
+    {
+      T x;
+      x._tao_bind (view, pos);
+      return x;
+    }
+  };
+
+  /// Traits of the primitive types of @a Size octets in CDR.
+  template<typename T,
+           size_t Size = sizeof (T),
+           size_t Align = Size,
+           bool In_Place = true>
+  struct View_Basic_Traits
+  {
+    typedef T value_type;
+    typedef View_No_Cache cache_type;
+    static size_t const fixed_size = Size;
+    static size_t const alignment = Align;
+    static bool const in_place = In_Place && sizeof (T) == Size;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return strm.align_read_ptr (Align) == 0 && strm.skip_bytes (Size);
+    }
+
+    static value_type get (const View_Base &view, size_t pos)
+    {
+      View_Reader strm (view, pos);
+      T x;
+      if (!details::view_read (strm, x))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+      return x;
+    }
+
+    static value_type get (const View_Base &view, size_t pos, cache_type &)
+    {
+      return get (view, pos);
+    }
+  };
+
+  // A boolean is any non-zero octet in CDR, so it is always decoded.
+  template<>
+  struct View_Element_Traits< ::CORBA::Boolean>
+    : public View_Basic_Traits< ::CORBA::Boolean, 1, 1, false> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Char>
+    : public View_Basic_Traits< ::CORBA::Char> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Octet>
+    : public View_Basic_Traits< ::CORBA::Octet> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Short>
+    : public View_Basic_Traits< ::CORBA::Short> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::UShort>
+    : public View_Basic_Traits< ::CORBA::UShort> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Long>
+    : public View_Basic_Traits< ::CORBA::Long> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::ULong>
+    : public View_Basic_Traits< ::CORBA::ULong> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::LongLong>
+    : public View_Basic_Traits< ::CORBA::LongLong> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::ULongLong>
+    : public View_Basic_Traits< ::CORBA::ULongLong> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Float>
+    : public View_Basic_Traits< ::CORBA::Float> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::Double>
+    : public View_Basic_Traits< ::CORBA::Double> {};
+  template<>
+  struct View_Element_Traits< ::CORBA::LongDouble>
+    : public View_Basic_Traits< ::CORBA::LongDouble,
+                                ACE_CDR::LONGDOUBLE_SIZE,
+                                ACE_CDR::LONGDOUBLE_ALIGN> {};
+
+  /// The size of a wide character in CDR depends on the GIOP version.
+  template<>
+  struct View_Element_Traits< ::CORBA::WChar>
+  {
+    typedef ::CORBA::WChar value_type;
+    typedef View_No_Cache cache_type;
+    static size_t const fixed_size = 0;
+    static size_t const alignment = 1;
+    static bool const in_place = false;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return strm.skip_wchar ();
+    }
+
+    static value_type get (const View_Base &view, size_t pos)
+    {
+      View_Reader strm (view, pos);
+      ::CORBA::WChar x;
+      if (!details::view_read (strm, x))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+      return x;
+    }
+
+    static value_type get (const View_Base &view, size_t pos, cache_type &)
+    {
+      return get (view, pos);
+    }
+  };
+
+  /// Strings point into the stream, see View_Base::_tao_string().
+  template<>
+  struct View_Element_Traits<const ::CORBA::Char *>
+  {
+    typedef const ::CORBA::Char *value_type;
+    typedef ::CORBA::String_var cache_type;
+    static size_t const fixed_size = 0;
+    static size_t const alignment = 1;
+    static bool const in_place = false;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return strm.skip_string ();
+    }
+
+    static value_type get (const View_Base &view,
+                           size_t pos,
+                           cache_type &cache)
+    {
+      return view._tao_string (pos, cache);
+    }
+  };
+
+  template<>
+  struct View_Element_Traits<const ::CORBA::WChar *>
+  {
+    typedef const ::CORBA::WChar *value_type;
+    typedef ::CORBA::WString_var cache_type;
+    static size_t const fixed_size = 0;
+    static size_t const alignment = 1;
+    static bool const in_place = false;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return strm.skip_wstring ();
+    }
+
+    static value_type get (const View_Base &view,
+                           size_t pos,
+                           cache_type &cache)
+    {
+      return view._tao_wstring (pos, cache);
+    }
+  };
+
+  /// Traits of the enums, read as an unsigned long.
+  template<typename E>
+  struct View_Enum_Traits
+  {
+    typedef E value_type;
+    typedef View_No_Cache cache_type;
+    static size_t const fixed_size = 4;
+    static size_t const alignment = 4;
+    static bool const in_place = sizeof (E) == 4;
+
+    static ::CORBA::Boolean skip (TAO_InputCDR &strm)
+    {
+      return strm.skip_ulong ();
+    }
+
+    static value_type get (const View_Base &view, size_t pos)
+    {
+      View_Reader strm (view, pos);
+      ::CORBA::ULong x = 0;
+      if (!strm.read_ulong (x))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+      return static_cast<E> (x);
+    }
+
+    static value_type get (const View_Base &view, size_t pos, cache_type &)
+    {
+      return get (view, pos);
+    }
+  };
+
+  /**
+   * @class Sequence_View
+   *
+   * @brief Read-only view of a sequence of @a T over a CDR stream.
+   */
+  template<typename T, typename Traits = View_Element_Traits<T> >
+  class Sequence_View : public View_Base
+  {
+  public:
+    typedef typename Traits::value_type value_type;
+
+    Sequence_View ()
+      : init_ (false),
+        length_ (0),
+        first_ (0),
+        cursor_ (0),
+        cursor_pos_ (0)
+    {
+    }
+
+    /// Number of elements.
+    ::CORBA::ULong length () const
+    {
+      this->_tao_init ();
+      return this->length_;
+    }
+
+    /// Element @a i.  Throws CORBA::BAD_PARAM if it is past the end.
+    value_type operator[] (::CORBA::ULong i) const
+    {
+      this->_tao_init ();
+      if (i >= this->length_)
+        {
+          throw ::CORBA::BAD_PARAM ();
+        }
+
+      if (Traits::fixed_size != 0)
+        {
+          return Traits::get (*this,
+                              this->first_ + i * Traits::fixed_size,
+                              this->cache_);
+        }
+
+      if (i < this->cursor_)
+        {
+          this->cursor_ = 0;
+          this->cursor_pos_ = this->first_;
+        }
+      if (i != this->cursor_)
+        {
+          View_Reader strm (*this, this->cursor_pos_);
+          for (; this->cursor_ != i; ++this->cursor_)
+            {
+              if (!Traits::skip (strm))
+                {
+                  throw ::CORBA::MARSHAL ();
+                }
+            }
+          this->cursor_pos_ = _tao_position (strm);
+        }
+      return Traits::get (*this, this->cursor_pos_, this->cache_);
+    }
+
+    /**
+     * The elements in the stream, without copying them, if they are
+     * laid out there as in memory; else 0, and they are read with
+     * operator[].
+     */
+    const value_type *get_buffer () const
+    {
+      this->_tao_init ();
+      if (!Traits::in_place || this->length_ == 0 || this->_tao_swapped ())
+        {
+          return 0;
+        }
+      return reinterpret_cast<const value_type *> (
+        this->_tao_buffer (this->first_));
+    }
+
+    /// Refer to the sequence at @a pos in the stream of @a outer.
+    void _tao_bind (const View_Base &outer, size_t pos)
+    {
+      this->_tao_bind_i (outer, pos);
+      this->init_ = false;
+    }
+
+    /// Skip over a sequence.
+    static ::CORBA::Boolean _tao_skip (TAO_InputCDR &strm)
+    {
+      ::CORBA::ULong length = 0;
+      if (!strm.read_ulong (length))
+        {
+          return false;
+        }
+
+      if (Traits::fixed_size != 0)
+        {
+          return length == 0
+            || (strm.align_read_ptr (Traits::alignment) == 0
+                && length <= strm.length () / Traits::fixed_size
+                && strm.skip_bytes (length * Traits::fixed_size));
+        }
+
+      for (::CORBA::ULong i = 0; i != length; ++i)
+        {
+          if (!Traits::skip (strm))
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+
+  private:
+    /// Read the length, and find the first element.
+    void _tao_init () const
+    {
+      if (this->init_)
+        {
+          return;
+        }
+
+      View_Reader strm (*this, this->_tao_start ());
+      if (!strm.read_ulong (this->length_)
+          || (Traits::fixed_size != 0
+              && this->length_ != 0
+              && strm.align_read_ptr (Traits::alignment) != 0))
+        {
+          throw ::CORBA::MARSHAL ();
+        }
+
+      this->first_ = _tao_position (strm);
+      this->cursor_ = 0;
+      this->cursor_pos_ = this->first_;
+      this->init_ = true;
+    }
+
+    mutable bool init_;
+    mutable ::CORBA::ULong length_;
+
+    /// Position of the first element.
+    mutable size_t first_;
+
+    /// Index and position of the last element found by skipping.
+    mutable ::CORBA::ULong cursor_;
+    mutable size_t cursor_pos_;
+
+    mutable typename Traits::cache_type cache_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_SEQUENCE_VIEW_T_H */
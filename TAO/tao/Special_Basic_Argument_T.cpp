@@ -2,6 +2,7 @@
 #define TAO_SPECIAL_BASIC_ARGUMENT_T_CPP
 
 #include "tao/Special_Basic_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 #include "tao/CDR.h"
 
 #if !defined (__ACE_INLINE__)
@@ -20,6 +21,16 @@ TAO::In_Special_Basic_Argument_T<S,to_S,from_S,Insert_Policy>::marshal (TAO_Outp
   return cdr << from_S (this->x_);
 }
 
+template<typename S,
+         typename to_S,
+         typename from_S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Special_Basic_Argument_T<S,to_S,from_S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, from_S (this->x_));
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -75,6 +86,16 @@ TAO::Inout_Special_Basic_Argument_T<S,to_S,from_S,Insert_Policy>::marshal (
   return cdr << from_S (this->x_);
 }
 
+template<typename S,
+         typename to_S,
+         typename from_S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Special_Basic_Argument_T<S,to_S,from_S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, from_S (this->x_));
+}
+
 template<typename S,
          typename to_S,
          typename from_S,
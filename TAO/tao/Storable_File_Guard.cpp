@@ -197,6 +197,12 @@ TAO::Storable_File_Guard::peer ()
   return *fl_;
 }
 
+void
+TAO::Storable_File_Guard::unmodified ()
+{
+  this->use_backup_ = false;
+}
+
 int
 TAO::Storable_File_Guard::load ()
 {
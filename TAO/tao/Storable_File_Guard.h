@@ -47,6 +47,10 @@ namespace TAO
     /// Get the underlying stream being used.
     TAO::Storable_Base & peer ();
 
+    /// Indicate that the file opened for writing was left unchanged,
+    /// so release() need not copy it to the backup file.
+    void unmodified ();
+
     /// Indicate how the state of the object is being used.
     /// This is used for determine the mode for accessing
     /// the persistent store.
@@ -176,7 +176,7 @@ TAO::Storable_FlatFileStream::reopen ()
 int
 TAO::Storable_FlatFileStream::open()
 {
-  // For now, three flags exist "r", "w",  and "c"
+  // For now, four flags exist "r", "w", "c" and "a"
   int flags = 0;
   const char *fdmode = nullptr;
   if( ACE_OS::strchr(mode_.c_str(), 'r') )
@@ -188,6 +188,12 @@ TAO::Storable_FlatFileStream::open()
     flags = O_WRONLY, fdmode = "w";
   if( ACE_OS::strchr(mode_.c_str(), 'c') )
     flags |= O_CREAT;
+  // Every write goes to the current end of the file.
+  if( ACE_OS::strchr(mode_.c_str(), 'a') )
+    {
+      flags |= O_APPEND;
+      fdmode = (flags & O_RDWR) ? "a+" : "a";
+    }
 
 #ifndef ACE_WIN32
   if( ACE_OS::flock_init (&filelock_, flags,
@@ -49,6 +49,14 @@ public:
   {
   }
 
+  /// Move constructor, takes over the string of @a rhs and leaves it
+  /// null, which marshals as an empty string.
+  inline String_Manager_T (String_Manager_T<charT> &&rhs) noexcept :
+    ptr_ (rhs.ptr_)
+  {
+    rhs.ptr_ = nullptr;
+  }
+
   /// Constructor from const char* makes a copy.
   inline String_Manager_T (const character_type *s) :
     ptr_ (s_traits::duplicate (s))
@@ -69,6 +77,12 @@ public:
     return *this;
   }
 
+  /// Move assignment, exchanges the strings
+  inline String_Manager_T &operator= (String_Manager_T<charT> &&rhs) noexcept {
+    std::swap (this->ptr_, rhs.ptr_);
+    return *this;
+  }
+
   /// Assignment from var type will make a copy
   inline String_Manager_T &operator= (const typename s_traits::string_var& value) {
     // Strongly exception safe by means of copy and non-throwing swap
@@ -22,6 +22,7 @@
 #include "tao/Time_Policy_Manager.h"
 #include "tao/System_Time_Policy_Strategy.h"
 #include "tao/HR_Time_Policy_Strategy.h"
+#include "tao/Cached_Time_Policy_Strategy.h"
 #include "tao/debug.h"
 
 #include "ace/Dynamic_Service.h"
@@ -691,6 +692,7 @@ namespace
     pcfg->process_directive (ace_svc_desc_TAO_Time_Policy_Manager);
     pcfg->process_directive (ace_svc_desc_TAO_System_Time_Policy_Strategy);
     pcfg->process_directive (ace_svc_desc_TAO_HR_Time_Policy_Strategy);
+    pcfg->process_directive (ace_svc_desc_TAO_Cached_Time_Policy_Strategy);
 #endif
 
   } /* register_global_services_i */
@@ -57,6 +57,9 @@ TAO_Time_Policy_Manager::parse_args (int argc, ACE_TCHAR* argv[])
               else if (ACE_OS::strcasecmp (name,
                                            ACE_TEXT("HR")) == 0)
                 this->time_policy_setting_ = TAO_HR_TIME_POLICY;
+              else if (ACE_OS::strcasecmp (name,
+                                           ACE_TEXT("CACHED")) == 0)
+                this->time_policy_setting_ = TAO_CACHED_TIME_POLICY;
               else
                 {
                   this->time_policy_setting_ = TAO_DYN_TIME_POLICY;
@@ -89,6 +92,10 @@ ACE_Timer_Queue * TAO_Time_Policy_Manager::create_timer_queue ()
           {
             this->time_policy_name_ = "TAO_HR_TIME_POLICY";
           }
+        else if (this->time_policy_setting_ == TAO_CACHED_TIME_POLICY)
+          {
+            this->time_policy_name_ = "TAO_CACHED_TIME_POLICY";
+          }
         this->time_policy_strategy_ =
             ACE_Dynamic_Service<TAO_Time_Policy_Strategy>::instance (
                 this->time_policy_name_.c_str ());
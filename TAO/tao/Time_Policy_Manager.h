@@ -60,6 +60,7 @@ private:
   {
     TAO_OS_TIME_POLICY,
     TAO_HR_TIME_POLICY,
+    TAO_CACHED_TIME_POLICY,
     TAO_DYN_TIME_POLICY
   };
 
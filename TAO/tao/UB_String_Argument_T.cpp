@@ -2,6 +2,7 @@
 #define TAO_UB_STRING_ARGUMENT_T_CPP
 
 #include "tao/UB_String_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 #include "tao/CDR.h"
 #include "ace/OS_NS_string.h"
 
@@ -19,6 +20,14 @@ TAO::In_UB_String_Argument_T<S_var,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S_var,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_UB_String_Argument_T<S_var,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_var,
@@ -71,6 +80,14 @@ TAO::Inout_UB_String_Argument_T<S_var,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_var,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_UB_String_Argument_T<S_var,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S_var,
          template <typename> class Insert_Policy>
 CORBA::Boolean
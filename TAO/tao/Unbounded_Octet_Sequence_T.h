@@ -24,6 +24,8 @@
 #include "ace/OS_Memory.h"
 #include "ace/checked_iterator.h"
 
+#include <utility>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO
@@ -44,21 +46,21 @@ public:
   typedef details::generic_sequence<value_type, allocation_traits, element_traits> implementation_type;
   typedef details::range_checking<value_type,true> range;
 
-  inline unbounded_value_sequence<CORBA::Octet>()
+  inline unbounded_value_sequence ()
     : maximum_ (allocation_traits::default_maximum())
     , length_ (0)
     , buffer_ (allocation_traits::default_buffer_allocation())
     , release_ (buffer_ != 0)
     , mb_ (0)
   {}
-  inline explicit unbounded_value_sequence<CORBA::Octet>(CORBA::ULong maximum)
+  inline explicit unbounded_value_sequence (CORBA::ULong maximum)
     : maximum_(maximum)
     , length_(0)
     , buffer_(allocbuf(maximum_))
     , release_(true)
     , mb_ (0)
   {}
-  inline unbounded_value_sequence<CORBA::Octet>(
+  inline unbounded_value_sequence (
       CORBA::ULong maximum,
       CORBA::ULong length,
       value_type * data,
@@ -69,7 +71,7 @@ public:
       release_ (release),
       mb_ (0)
   {}
-  inline ~unbounded_value_sequence<CORBA::Octet>() {
+  inline ~unbounded_value_sequence () {
     if (mb_)
       ACE_Message_Block::release (mb_);
     if (release_)
@@ -77,7 +79,7 @@ public:
   }
   /// Create a sequence of octets from a single message block (i.e. it
   /// ignores any chaining in the message block).
-  inline unbounded_value_sequence<CORBA::Octet> (CORBA::ULong length,
+  inline unbounded_value_sequence (CORBA::ULong length,
                                                  const ACE_Message_Block* mb)
     : maximum_ (length)
     , length_ (length)
@@ -250,7 +252,7 @@ public:
     swap (s);
   }
 
-  unbounded_value_sequence<CORBA::Octet> (
+  unbounded_value_sequence (
     const unbounded_value_sequence<CORBA::Octet> &rhs)
     : maximum_ (0)
     , length_ (0)
@@ -295,6 +297,27 @@ public:
     return * this;
   }
 
+  /// Take over the buffer or message block of @a rhs, leaving it
+  /// empty.
+  unbounded_value_sequence (
+    unbounded_value_sequence<CORBA::Octet> && rhs) noexcept
+    : maximum_ (0)
+    , length_ (0)
+    , buffer_(0)
+    , release_(false)
+    , mb_ (0)
+  {
+    swap(rhs);
+  }
+
+  unbounded_value_sequence<CORBA::Octet> &
+  operator= (unbounded_value_sequence<CORBA::Octet> && rhs) noexcept
+  {
+    unbounded_value_sequence<CORBA::Octet> tmp(std::move(rhs));
+    swap(tmp);
+    return * this;
+  }
+
 private:
   /// The maximum number of elements the buffer can contain.
   CORBA::ULong maximum_;
@@ -12,6 +12,7 @@
 #include "tao/orbconf.h"
 #include "tao/CORBA_String.h"
 #include "tao/SystemException.h"
+#include "tao/CDR_Bulk_Traits_T.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -326,10 +327,8 @@ namespace TAO {
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
-    for(CORBA::ULong i = 0; i < new_length; ++i) {
-      if (!(strm >> buffer[i])) {
-        return false;
-      }
+    if (!TAO::demarshal_value_array (strm, buffer, new_length)) {
+      return false;
     }
     tmp.swap(target);
     return true;
@@ -560,12 +559,7 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
-    for(CORBA::ULong i = 0; i < length; ++i) {
-      if (!(strm << source[i])) {
-        return false;
-      }
-    }
-    return true;
+    return TAO::marshal_value_array (strm, source.get_buffer (), length);
   }
 
   template <typename stream, typename charT>
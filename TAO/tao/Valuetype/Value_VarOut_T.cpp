@@ -31,6 +31,14 @@ TAO_Value_Var_T<T>::TAO_Value_Var_T (const TAO_Value_Var_T<T> & p)
   this->ptr_ = p.ptr ();
 }
 
+template <typename T>
+TAO_Value_Var_T<T>::TAO_Value_Var_T (TAO_Value_Var_T<T> && p) noexcept
+  : TAO_Base_var (),
+    ptr_ (p.ptr_)
+{
+  p.ptr_ = 0;
+}
+
 template <typename T>
 TAO_Value_Var_T<T>::~TAO_Value_Var_T (void)
 {
@@ -64,6 +72,14 @@ TAO_Value_Var_T<T>::operator= (const TAO_Value_Var_T<T> & p)
   return *this;
 }
 
+template <typename T>
+TAO_Value_Var_T<T> &
+TAO_Value_Var_T<T>::operator= (TAO_Value_Var_T<T> && p) noexcept
+{
+  std::swap (this->ptr_, p.ptr_);
+  return *this;
+}
+
 template <typename T>
 TAO_Value_Var_T<T>::operator const T * () const
 {
@@ -45,6 +45,7 @@ public:
   TAO_Value_Var_T ();
   TAO_Value_Var_T (T *);
   TAO_Value_Var_T (const TAO_Value_Var_T<T> &);
+  TAO_Value_Var_T (TAO_Value_Var_T<T> &&) noexcept;
 
   // (TAO extension)
   TAO_Value_Var_T (const T *);
@@ -53,6 +54,7 @@ public:
 
   TAO_Value_Var_T &operator= (T *);
   TAO_Value_Var_T &operator= (const TAO_Value_Var_T<T> &);
+  TAO_Value_Var_T &operator= (TAO_Value_Var_T<T> &&) noexcept;
 
   T * operator-> () const;
 
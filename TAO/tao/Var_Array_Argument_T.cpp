@@ -2,6 +2,7 @@
 #define TAO_VAR_ARRAY_ARGUMENT_T_CPP
 
 #include "tao/Var_Array_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 #include "tao/Array_Traits_T.h"
 
 #if !defined (__ACE_INLINE__)
@@ -20,6 +21,14 @@ TAO::In_Var_Array_Argument_T<S_forany,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Var_Array_Argument_T<S_forany,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S_forany,
@@ -76,6 +85,14 @@ TAO::Inout_Var_Array_Argument_T<S_forany,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S_forany,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Var_Array_Argument_T<S_forany,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S_forany,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -2,6 +2,7 @@
 #define TAO_VAR_SIZE_ARGUMENT_T_CPP
 
 #include "tao/Var_Size_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 #include "ace/OS_Memory.h"
 
 #if !defined (__ACE_INLINE__)
@@ -18,6 +19,14 @@ TAO::In_Var_Size_Argument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << *this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Var_Size_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, *this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -66,6 +75,14 @@ TAO::Inout_Var_Size_Argument_T<S,Insert_Policy>::marshal (
   return cdr << *this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Var_Size_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, *this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
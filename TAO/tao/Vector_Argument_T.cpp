@@ -2,6 +2,7 @@
 #define TAO_VECTOR_ARGUMENT_T_CPP
 
 #include "tao/Vector_Argument_T.h"
+#include "tao/CDR_Size_T.h"
 
 #if !defined (__ACE_INLINE__)
 #include "tao/Vector_Argument_T.inl"
@@ -17,6 +18,14 @@ TAO::In_Vector_Argument_T<S,Insert_Policy>::marshal (TAO_OutputCDR &cdr)
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::In_Vector_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 #if TAO_HAS_INTERCEPTORS == 1
 
 template<typename S,
@@ -64,6 +73,14 @@ TAO::Inout_Vector_Argument_T<S,Insert_Policy>::marshal (
   return cdr << this->x_;
 }
 
+template<typename S,
+         template <typename> class Insert_Policy>
+CORBA::Boolean
+TAO::Inout_Vector_Argument_T<S,Insert_Policy>::marshal_size (ACE_SizeCDR &cdr)
+{
+  return TAO::cdr_size (cdr, this->x_);
+}
+
 template<typename S,
          template <typename> class Insert_Policy>
 CORBA::Boolean
@@ -97,7 +97,8 @@ ACE_INLINE
 S
 TAO::Ret_Vector_Argument_T<S,Insert_Policy>::retn (void)
 {
-  return this->x_;
+  // The argument is done with once the reply is demarshaled.
+  return std::move (this->x_);
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -6,6 +6,7 @@
 #include "tao/Wait_On_LF_No_Upcall.h"
 #include "tao/Exclusive_TMS.h"
 #include "tao/Muxed_TMS.h"
+#include "tao/Active_Demux_TMS.h"
 #include "tao/Blocked_Connect_Strategy.h"
 #include "tao/Reactive_Connect_Strategy.h"
 #include "tao/LF_Connect_Strategy.h"
@@ -119,6 +120,9 @@ TAO_Default_Client_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
               else if (ACE_OS::strcasecmp (name,
                                            ACE_TEXT("EXCLUSIVE")) == 0)
                 this->transport_mux_strategy_ = TAO_EXCLUSIVE_TMS;
+              else if (ACE_OS::strcasecmp (name,
+                                           ACE_TEXT("ACTIVE_DEMUX")) == 0)
+                this->transport_mux_strategy_ = TAO_ACTIVE_DEMUX_TMS;
               else
                 this->report_option_value_error (
                   ACE_TEXT("-ORBTransportMuxStrategy"), name);
@@ -386,6 +390,13 @@ TAO_Default_Client_Strategy_Factory::create_transport_mux_strategy (
                         nullptr);
         break;
       }
+      case TAO_ACTIVE_DEMUX_TMS:
+      {
+        ACE_NEW_RETURN (tms,
+                        TAO_Active_Demux_TMS (transport),
+                        nullptr);
+        break;
+      }
     }
 
   return tms;
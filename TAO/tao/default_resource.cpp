@@ -122,6 +122,11 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
 #else
   , use_local_memory_pool_ (false)
 #endif
+#if TAO_HAS_SENDFILE == 1
+  , output_cdr_mmap_huge_pages_ (ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES)
+  , output_cdr_mmap_prefault_ (false)
+  , output_cdr_mmap_numa_node_ (-1)
+#endif  /* TAO_HAS_SENDFILE==1 */
   , cached_connection_lock_type_ (TAO_THREAD_LOCK)
 #if defined (TAO_USE_BLOCKING_FLUSHING)
   , flushing_strategy_type_ (TAO_BLOCKING_FLUSHING)
@@ -472,6 +477,48 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBOutputCDRMMAPHugePages")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+#if TAO_HAS_SENDFILE == 1
+            this->output_cdr_mmap_huge_pages_ =
+              ACE_OS::atoi (argv[curarg]) == 0
+              ? ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES
+              : ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES;
+#endif  /* TAO_HAS_SENDFILE==1 */
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBOutputCDRMMAPHugePages"), argv[curarg]);
+      }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBOutputCDRMMAPPrefault")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+#if TAO_HAS_SENDFILE == 1
+            this->output_cdr_mmap_prefault_ = ACE_OS::atoi (argv[curarg]) != 0;
+#endif  /* TAO_HAS_SENDFILE==1 */
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBOutputCDRMMAPPrefault"), argv[curarg]);
+      }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBOutputCDRMMAPNumaNode")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+#if TAO_HAS_SENDFILE == 1
+            this->output_cdr_mmap_numa_node_ = ACE_OS::atoi (argv[curarg]);
+#endif  /* TAO_HAS_SENDFILE==1 */
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBOutputCDRMMAPNumaNode"), argv[curarg]);
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -923,7 +970,9 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
 #if TAO_HAS_SENDFILE == 1
     case MMAP_ALLOCATOR:
       ACE_NEW_RETURN (allocator,
-                      TAO_MMAP_Allocator,
+                      TAO_MMAP_Allocator (this->output_cdr_mmap_huge_pages_,
+                                          this->output_cdr_mmap_prefault_,
+                                          this->output_cdr_mmap_numa_node_),
                       nullptr);
 
       break;
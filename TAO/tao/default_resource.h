@@ -284,6 +284,19 @@ protected:
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
 
+#if TAO_HAS_SENDFILE == 1
+  /// Huge page option of the pool of the mmap output CDR allocator,
+  /// see ACE_MMAP_Memory_Pool_Options.
+  int output_cdr_mmap_huge_pages_;
+
+  /// Should the pages of the mmap output CDR allocator be faulted in
+  /// when they are mapped?
+  bool output_cdr_mmap_prefault_;
+
+  /// NUMA node of the pages of the mmap output CDR allocator, or -1.
+  int output_cdr_mmap_numa_node_;
+#endif  /* TAO_HAS_SENDFILE == 1 */
+
 private:
   enum Lock_Type
   {
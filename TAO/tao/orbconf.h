@@ -22,6 +22,15 @@
 #include "ace/Condition_Thread_Mutex.h"
 #include "ace/Synch_Traits.h"
 
+// Define TAO_USE_PER_CPU_RW_MUTEX to 1 to make TAO_SYNCH_RW_MUTEX a
+// lock whose readers do not contend with each other, for tables that
+// are read on every request and seldom changed.
+#if defined (TAO_USE_PER_CPU_RW_MUTEX) && (TAO_USE_PER_CPU_RW_MUTEX == 1) \
+    && defined (ACE_HAS_THREADS) && !defined (TAO_SYNCH_RW_MUTEX)
+# include "ace/Per_CPU_RW_Thread_Mutex.h"
+# define TAO_SYNCH_RW_MUTEX ACE_Per_CPU_RW_Thread_Mutex
+#endif /* TAO_USE_PER_CPU_RW_MUTEX */
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -105,6 +114,13 @@ const size_t TAO_DEFAULT_ADAPTER_REGISTRY_SIZE = 16;
 const size_t TAO_RD_TABLE_SIZE = 16;
 #endif  /* !TAO_RD_TABLE_SIZE */
 
+// The least number of slots of the reply dispatcher table of the
+// active demux transport mux strategy, which should cover the
+// requests a connection has outstanding at a time.
+#if !defined (TAO_ACTIVE_DEMUX_TABLE_SIZE)
+const unsigned int TAO_ACTIVE_DEMUX_TABLE_SIZE = 1024;
+#endif  /* !TAO_ACTIVE_DEMUX_TABLE_SIZE */
+
 // The default size of TAO's policy factory registry, i.e. the map
 // used as the underlying implementation for the
 // PortableInterceptor::ORBInitInfo::register_policy_factory() method.
@@ -646,6 +662,22 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
             TAO_HAS_CORBA_MESSAGING == 0 */
 #endif  /* !TAO_HAS_AMI_CALLBACK */
 
+// The awaitable asynchronous invocations tao_idl -Gcoro generates
+// for C++20 coroutines are enabled by default when AMI_CALLBACK is
+// and the compiler implements coroutines.
+// To explicitly disable them uncomment the following
+// #define TAO_HAS_AMI_COROUTINES 0
+
+/// Default AMI_COROUTINES settings
+#if !defined (TAO_HAS_AMI_COROUTINES)
+#  if (TAO_HAS_AMI_CALLBACK == 1) && defined (ACE_HAS_CPP20) && \
+      defined (__cpp_impl_coroutine)
+#    define TAO_HAS_AMI_COROUTINES 1
+#  else
+#    define TAO_HAS_AMI_COROUTINES 0
+#  endif  /* TAO_HAS_AMI_CALLBACK == 1 && ACE_HAS_CPP20 */
+#endif  /* !TAO_HAS_AMI_COROUTINES */
+
 /// Interceptors is supported by default if we are not building for
 /// MinimumCORBA.
 #if !defined (TAO_HAS_INTERCEPTORS)
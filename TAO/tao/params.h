@@ -125,6 +125,16 @@ public:
   void max_message_size (ACE_CDR::ULong size);
   //@}
 
+  /**
+   * Minimum size of the arguments of a request or reply for which
+   * the room is reserved in the CDR stream before marshaling them.
+   * Zero, the default, never reserves.
+   */
+  //@{
+  ACE_CDR::ULong cdr_reserve_threshold () const;
+  void cdr_reserve_threshold (ACE_CDR::ULong size);
+  //@}
+
   /// The ORB will use the dotted decimal notation for addresses. By
   /// default we use the full ascii names.
   int use_dotted_decimal_addresses () const;
@@ -349,6 +359,9 @@ private:
    */
   ACE_CDR::ULong max_message_size_;
 
+  /// Reserve the room for arguments of at least this size.
+  ACE_CDR::ULong cdr_reserve_threshold_;
+
   /// For selecting a address notation
   int use_dotted_decimal_addresses_;
 
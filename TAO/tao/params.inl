@@ -49,6 +49,18 @@ TAO_ORB_Parameters::max_message_size (ACE_CDR::ULong size)
   this->max_message_size_ = size;
 }
 
+ACE_INLINE ACE_CDR::ULong
+TAO_ORB_Parameters::cdr_reserve_threshold () const
+{
+  return this->cdr_reserve_threshold_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::cdr_reserve_threshold (ACE_CDR::ULong size)
+{
+  this->cdr_reserve_threshold_ = size;
+}
+
 ACE_INLINE int
 TAO_ORB_Parameters::use_dotted_decimal_addresses () const
 {
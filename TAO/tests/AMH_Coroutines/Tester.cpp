@@ -0,0 +1,136 @@
+#include "Tester.h"
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+#include "tao/ORB_Core.h"
+#include "ace/Reactor.h"
+
+Delay::Delay (ACE_Reactor *reactor, CORBA::ULong msec)
+  : ACE_Event_Handler (reactor)
+  , msec_ (msec)
+{
+}
+
+bool
+Delay::await_ready () const noexcept
+{
+  return this->msec_ == 0;
+}
+
+void
+Delay::await_suspend (std::coroutine_handle<> coroutine)
+{
+  this->coroutine_ = coroutine;
+
+  if (this->reactor ()->schedule_timer (
+        this, 0, ACE_Time_Value (0, this->msec_ * 1000)) == -1)
+    throw CORBA::NO_RESOURCES ();
+}
+
+void
+Delay::await_resume () const noexcept
+{
+}
+
+int
+Delay::handle_timeout (const ACE_Time_Value &, const void *)
+{
+  // This is part of the coroutine frame, which may be freed before
+  // resume() returns.
+  this->coroutine_.resume ();
+  return 0;
+}
+
+Pending::Pending (CORBA::ULong &pending)
+  : pending_ (pending)
+{
+  ++this->pending_;
+}
+
+Pending::~Pending ()
+{
+  --this->pending_;
+}
+
+Tester::Tester (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , pending_ (0)
+{
+}
+
+TAO::AMH_Task
+Tester::echo (Test::AMH_TesterResponseHandler_ptr _tao_rh,
+              CORBA::Long value,
+              CORBA::ULong msec)
+{
+  Pending pending (this->pending_);
+
+  co_await Delay (this->orb_reactor (), msec);
+
+  _tao_rh->echo (value);
+}
+
+TAO::AMH_Task
+Tester::fail (Test::AMH_TesterResponseHandler_ptr,
+              const char *reason,
+              CORBA::ULong msec)
+{
+  Pending pending (this->pending_);
+
+  co_await Delay (this->orb_reactor (), msec);
+
+  // The skeleton keeps the reason until the coroutine returns, and
+  // sends the exception as the reply.
+  throw Test::Failed (reason);
+}
+
+TAO::AMH_Task
+Tester::pending (Test::AMH_TesterResponseHandler_ptr _tao_rh)
+{
+  _tao_rh->pending (this->pending_);
+
+  co_return;
+}
+
+TAO::AMH_Task
+Tester::shutdown (Test::AMH_TesterResponseHandler_ptr)
+{
+  this->orb_->shutdown (false);
+
+  co_return;
+}
+
+ACE_Reactor *
+Tester::orb_reactor () const
+{
+  return this->orb_->orb_core ()->reactor ();
+}
+#else
+Tester::Tester (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::Long
+Tester::echo (CORBA::Long, CORBA::ULong)
+{
+  throw CORBA::NO_IMPLEMENT ();
+}
+
+void
+Tester::fail (const char *, CORBA::ULong)
+{
+  throw CORBA::NO_IMPLEMENT ();
+}
+
+CORBA::ULong
+Tester::pending ()
+{
+  throw CORBA::NO_IMPLEMENT ();
+}
+
+void
+Tester::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
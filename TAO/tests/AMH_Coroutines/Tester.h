@@ -0,0 +1,104 @@
+#ifndef TESTER_H
+#define TESTER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+#include "ace/Event_Handler.h"
+
+/// Suspend the awaiting coroutine for some milliseconds, and resume
+/// it from a timer of the reactor.
+class Delay
+  : public ACE_Event_Handler
+{
+public:
+  /// Constructor
+  Delay (ACE_Reactor *reactor, CORBA::ULong msec);
+
+  bool await_ready () const noexcept;
+  void await_suspend (std::coroutine_handle<> coroutine);
+  void await_resume () const noexcept;
+
+  virtual int handle_timeout (const ACE_Time_Value &, const void *);
+
+private:
+  /// The delay
+  CORBA::ULong const msec_;
+
+  /// The awaiting coroutine
+  std::coroutine_handle<> coroutine_;
+};
+
+/// Count the upcall coroutines that have neither returned nor been
+/// destroyed.
+class Pending
+{
+public:
+  explicit Pending (CORBA::ULong &pending);
+  ~Pending ();
+
+private:
+  Pending (const Pending &) = delete;
+  Pending &operator= (const Pending &) = delete;
+
+  CORBA::ULong &pending_;
+};
+
+/// Implement the Test::Tester interface with coroutine AMH upcalls
+class Tester
+  : public virtual POA_Test::AMH_Tester
+{
+public:
+  /// Constructor
+  Tester (CORBA::ORB_ptr orb);
+
+  // = The AMH skeleton methods
+  virtual TAO::AMH_Task echo (Test::AMH_TesterResponseHandler_ptr _tao_rh,
+                              CORBA::Long value,
+                              CORBA::ULong msec);
+
+  virtual TAO::AMH_Task fail (Test::AMH_TesterResponseHandler_ptr _tao_rh,
+                              const char *reason,
+                              CORBA::ULong msec);
+
+  virtual TAO::AMH_Task pending (Test::AMH_TesterResponseHandler_ptr _tao_rh);
+
+  virtual TAO::AMH_Task shutdown (Test::AMH_TesterResponseHandler_ptr _tao_rh);
+
+private:
+  /// The reactor the coroutines are resumed from
+  ACE_Reactor *orb_reactor () const;
+
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The upcalls that have neither returned nor been destroyed.
+  CORBA::ULong pending_;
+};
+#else
+/// Without coroutines, the server is only shut down.
+class Tester
+  : public virtual POA_Test::Tester
+{
+public:
+  /// Constructor
+  Tester (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long echo (CORBA::Long value, CORBA::ULong msec);
+
+  virtual void fail (const char *reason, CORBA::ULong msec);
+
+  virtual CORBA::ULong pending ();
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+#include /**/ "ace/post.h"
+#endif /* TESTER_H */
@@ -0,0 +1,212 @@
+//=============================================================================
+/**
+ *  @file   client.cpp
+ *
+ *  Check the AMH upcalls tao_idl -GHcoro generates, which the server
+ *  implements as coroutines: a reply sent before and after the
+ *  coroutine suspends, an exception the coroutine lets escape sent as
+ *  the reply, and a coroutine that is still suspended when the
+ *  skeleton lets go of its task running to completion.
+ *
+ *  Usage: client [-k ior] [-x]
+ */
+//=============================================================================
+
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Thread_Manager.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int do_shutdown = 1;
+
+int status = 0;
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+/// Check that echo returns @a value after @a msec milliseconds.
+void
+check_echo (Test::Tester_ptr tester,
+            CORBA::Long value,
+            CORBA::ULong msec)
+{
+  try
+    {
+      CORBA::Long const result = tester->echo (value, msec);
+      if (result != value)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: echo returned %d, expected %d\n"),
+                      result, value));
+          status = 1;
+        }
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("ERROR: echo:");
+      status = 1;
+    }
+}
+
+/// Check that fail raises Test::Failed after @a msec milliseconds.
+void
+check_fail (Test::Tester_ptr tester,
+            const char *reason,
+            CORBA::ULong msec)
+{
+  try
+    {
+      tester->fail (reason, msec);
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: fail returned normally\n")));
+      status = 1;
+    }
+  catch (const Test::Failed &ex)
+    {
+      if (ACE_OS::strcmp (ex.reason.in (), reason) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: fail raised <%C>, expected <%C>\n"),
+                      ex.reason.in (), reason));
+          status = 1;
+        }
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("ERROR: fail:");
+      status = 1;
+    }
+}
+
+/// Check the number of upcall coroutines pending in the server.
+void
+check_pending (Test::Tester_ptr tester,
+               CORBA::ULong expected,
+               const char *when)
+{
+  CORBA::ULong const pending = tester->pending ();
+  if (pending != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: %C, %u upcalls are pending, ")
+                  ACE_TEXT ("expected %u\n"),
+                  when, pending, expected));
+      status = 1;
+    }
+}
+
+/// Keep an upcall suspended in the server for a while.
+ACE_THR_FUNC_RETURN
+slow_echo (void *arg)
+{
+  check_echo (static_cast<Test::Tester_ptr> (arg), 7, 500);
+  return 0;
+}
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Tester_var tester =
+        Test::Tester::_narrow (object.in ());
+
+      if (CORBA::is_nil (tester.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Tester reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+      // Without a delay the coroutines reply and return before the
+      // skeleton lets go of them, with one they suspend and reply
+      // after the skeleton has returned.
+      check_echo (tester.in (), 21, 0);
+      check_echo (tester.in (), 42, 100);
+      check_fail (tester.in (), "now", 0);
+      check_fail (tester.in (), "later", 100);
+
+      check_pending (tester.in (), 0, "after the replies");
+
+      // The server dispatches pending() while the echo of the other
+      // thread is suspended, so the skeleton of the echo has let go
+      // of its task, but the coroutine must not have been destroyed.
+      if (ACE_Thread_Manager::instance ()->spawn (
+            slow_echo, tester.in ()) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Cannot spawn the echo thread\n"),
+                            1);
+        }
+
+      ACE_OS::sleep (ACE_Time_Value (0, 200 * 1000));
+      check_pending (tester.in (), 1, "during a suspended echo");
+
+      ACE_Thread_Manager::instance ()->wait ();
+      check_pending (tester.in (), 0, "after the suspended echo");
+#else
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("AMH coroutines not available, ")
+                  ACE_TEXT ("build with C++20\n")));
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+      if (do_shutdown)
+        {
+          tester->shutdown ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
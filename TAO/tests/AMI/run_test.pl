@@ -28,6 +28,9 @@ foreach $i (@ARGV) {
     elsif ($i eq '-exclusive') {
         $conf_file = "exclusive$PerlACE::svcconf_ext";
     }
+    elsif ($i eq '-active_demux') {
+        $conf_file = "active_demux$PerlACE::svcconf_ext";
+    }
 }
 
 $client_conf = $client->LocalFile ($conf_file);
@@ -0,0 +1,32 @@
+#include "Tester.h"
+#include "ace/OS_NS_unistd.h"
+
+Tester::Tester (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::Long
+Tester::echo (CORBA::Long value, CORBA::Long_out doubled)
+{
+  doubled = 2 * value;
+  return value;
+}
+
+void
+Tester::fail (const char *reason)
+{
+  throw Test::Failed (reason);
+}
+
+void
+Tester::delay (CORBA::ULong msec)
+{
+  ACE_OS::sleep (ACE_Time_Value (0, msec * 1000));
+}
+
+void
+Tester::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
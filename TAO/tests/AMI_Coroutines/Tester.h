@@ -0,0 +1,31 @@
+
+#ifndef TESTER_H
+#define TESTER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Tester interface
+class Tester
+  : public virtual POA_Test::Tester
+{
+public:
+  /// Constructor
+  Tester (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long echo (CORBA::Long value, CORBA::Long_out doubled);
+
+  virtual void fail (const char *reason);
+
+  virtual void delay (CORBA::ULong msec);
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* TESTER_H */
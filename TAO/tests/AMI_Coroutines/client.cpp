@@ -0,0 +1,291 @@
+//=============================================================================
+/**
+ *  @file   client.cpp
+ *
+ *  Check the async_ operations tao_idl -Gcoro generates: a coroutine
+ *  awaiting them gets the return value and the out arguments of a
+ *  normal reply, the exception of an exception reply, and
+ *  CORBA::TIMEOUT when the reply does not come in time, while a
+ *  coroutine destroyed before the reply arrives is not resumed by it.
+ *
+ *  Usage: client [-k ior] [-x]
+ */
+//=============================================================================
+
+#include "TestC.h"
+#include "tao/Messaging/Messaging.h"
+#include "tao/AnyTypeCode/Any.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_string.h"
+
+#include <exception>
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int do_shutdown = 1;
+
+int status = 0;
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+/// A coroutine that the test can destroy while it is suspended.
+class Owned_Task
+{
+public:
+  struct promise_type
+  {
+    Owned_Task get_return_object () noexcept
+    {
+      return Owned_Task (
+        std::coroutine_handle<promise_type>::from_promise (*this));
+    }
+
+    std::suspend_never initial_suspend () noexcept
+    {
+      return std::suspend_never ();
+    }
+
+    std::suspend_always final_suspend () noexcept
+    {
+      return std::suspend_always ();
+    }
+
+    void return_void () noexcept
+    {
+    }
+
+    void unhandled_exception () noexcept
+    {
+      std::terminate ();
+    }
+  };
+
+  ~Owned_Task ()
+  {
+    this->coroutine_.destroy ();
+  }
+
+  bool done () const
+  {
+    return this->coroutine_.done ();
+  }
+
+private:
+  explicit Owned_Task (std::coroutine_handle<promise_type> coroutine)
+    : coroutine_ (coroutine)
+  {
+  }
+
+  Owned_Task (const Owned_Task &) = delete;
+  Owned_Task &operator= (const Owned_Task &) = delete;
+
+  std::coroutine_handle<promise_type> coroutine_;
+};
+
+/// Await a normal reply, an exception reply and a timeout.
+TAO::Asynch_Task
+await_replies (Test::Tester_ptr tester,
+               Test::Tester_ptr impatient,
+               bool &finished)
+{
+  try
+    {
+      CORBA::Long doubled = 0;
+      CORBA::Long const value = co_await tester->async_echo (21, doubled);
+      if (value != 21 || doubled != 42)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: echo returned %d and %d, ")
+                      ACE_TEXT ("expected 21 and 42\n"),
+                      value, doubled));
+          status = 1;
+        }
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("ERROR: echo:");
+      status = 1;
+    }
+
+  try
+    {
+      co_await tester->async_fail ("expected");
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: fail returned normally\n")));
+      status = 1;
+    }
+  catch (const Test::Failed &ex)
+    {
+      if (ACE_OS::strcmp (ex.reason.in (), "expected") != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: fail raised <%C>\n"),
+                      ex.reason.in ()));
+          status = 1;
+        }
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("ERROR: fail:");
+      status = 1;
+    }
+
+  try
+    {
+      co_await impatient->async_delay (1000);
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ERROR: delay did not time out\n")));
+      status = 1;
+    }
+  catch (const CORBA::TIMEOUT &)
+    {
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("ERROR: delay:");
+      status = 1;
+    }
+
+  finished = true;
+}
+
+/// Await a reply that comes after the coroutine is destroyed.
+Owned_Task
+abandon_reply (Test::Tester_ptr tester, bool &resumed)
+{
+  co_await tester->async_delay (100);
+  resumed = true;
+}
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Tester_var tester =
+        Test::Tester::_narrow (object.in ());
+
+      if (CORBA::is_nil (tester.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Tester reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+      // The same object, with requests timing out after 200 ms.
+      TimeBase::TimeT const timeout = 200 * 10000;
+      CORBA::Any any;
+      any <<= timeout;
+
+      CORBA::PolicyList policies (1);
+      policies.length (1);
+      policies[0] =
+        orb->create_policy (Messaging::RELATIVE_RT_TIMEOUT_POLICY_TYPE,
+                            any);
+
+      object =
+        tester->_set_policy_overrides (policies, CORBA::SET_OVERRIDE);
+
+      policies[0]->destroy ();
+
+      Test::Tester_var impatient =
+        Test::Tester::_narrow (object.in ());
+
+      bool finished = false;
+      await_replies (tester.in (), impatient.in (), finished);
+      while (!finished)
+        orb->perform_work ();
+
+      bool resumed = false;
+      {
+        Owned_Task abandoned = abandon_reply (tester.in (), resumed);
+        if (abandoned.done ())
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: the coroutine did not wait ")
+                        ACE_TEXT ("for the reply\n")));
+            status = 1;
+          }
+      }
+
+      // The server replies in order, so the reply to the destroyed
+      // coroutine has been dispatched once this one is back.
+      CORBA::Long doubled = 0;
+      if (tester->echo (1, doubled) != 1 || doubled != 2)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: bad reply to echo\n")));
+          status = 1;
+        }
+
+      if (resumed)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: the reply resumed a destroyed ")
+                      ACE_TEXT ("coroutine\n")));
+          status = 1;
+        }
+#else
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("AMI coroutines not available, ")
+                  ACE_TEXT ("build with C++20\n")));
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+      if (do_shutdown)
+        {
+          tester->shutdown ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,508 @@
+//=============================================================================
+/**
+ *  @file   test.cpp
+ *
+ *  Verifies that sequences and arrays of structs marshaled as one block
+ *  of memory give the same CDR stream as when the structs are marshaled
+ *  one at a time, and that they are read back as one at a time, also
+ *  from streams of the other byte order.  Structs with chars must go
+ *  through the char codeset translator of the stream.
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "tao/CDR.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_ctype.h"
+
+#include <string>
+
+/// The bytes of @a cdr in one string.
+static std::string
+contents (const TAO_OutputCDR &cdr)
+{
+  std::string s;
+  for (const ACE_Message_Block *mb = cdr.begin (); mb != 0; mb = mb->cont ())
+    {
+      s.append (mb->rd_ptr (), mb->length ());
+    }
+  return s;
+}
+
+/// Write a ulong first so that the sequence elements follow the
+/// length without padding.
+static const CORBA::ULong marker = 0xcafe;
+
+/// Streams write to zeroed buffers, so that the padding between the
+/// structs not marshaled as one block compares equal.
+static const size_t buffer_size = 256 * 1024;
+static char bulk_buffer[buffer_size];
+static char one_by_one_buffer[buffer_size];
+
+/// Output streams only swap bytes when built to; otherwise what is
+/// written is only read back in the native byte order.
+#if defined (ACE_ENABLE_SWAP_ON_WRITE)
+static const bool swap_on_write = true;
+#else
+static const bool swap_on_write = false;
+#endif /* ACE_ENABLE_SWAP_ON_WRITE */
+
+static bool
+same (const Test::Point &a, const Test::Point &b)
+{
+  return ACE_OS::memcmp (&a, &b, sizeof a) == 0;
+}
+
+static bool
+same (const Test::Mixed &a, const Test::Mixed &b)
+{
+  for (CORBA::ULong j = 0; j != 2; ++j)
+    {
+      if (a.inner[j].a != b.inner[j].a
+          || a.inner[j].b != b.inner[j].b
+          || a.inner[j].c != b.inner[j].c)
+        {
+          return false;
+        }
+    }
+  return ACE_OS::memcmp (&a.d, &b.d, sizeof a.d) == 0
+    && a.l == b.l
+    && ACE_OS::memcmp (a.tag, b.tag, sizeof a.tag) == 0
+    && a.us[0] == b.us[0]
+    && a.us[1] == b.us[1]
+    && ACE_OS::memcmp (&a.f, &b.f, sizeof a.f) == 0;
+}
+
+static bool
+same (const Test::Bytes &a, const Test::Bytes &b)
+{
+  return a.o == b.o && a.c == b.c;
+}
+
+static bool
+same (const Test::Padded &a, const Test::Padded &b)
+{
+  return a.l == b.l && ACE_OS::memcmp (&a.d, &b.d, sizeof a.d) == 0;
+}
+
+static bool
+same (const Test::Flag &a, const Test::Flag &b)
+{
+  return a.l == b.l && a.b == b.b;
+}
+
+static void
+fill (Test::Point &p, CORBA::ULong i)
+{
+  p.x = i * 1.5;
+  p.y = -1.0 / (i + 1);
+  p.z = i * 1e100;
+}
+
+static void
+fill (Test::Mixed &m, CORBA::ULong i)
+{
+  m.d = i * 0.25;
+  for (CORBA::ULong j = 0; j != 2; ++j)
+    {
+      m.inner[j].a = static_cast<CORBA::Long> (0x01020304 * (i + j));
+      m.inner[j].b = static_cast<CORBA::Short> (-i);
+      m.inner[j].c = static_cast<CORBA::UShort> (0x0102 + i);
+    }
+  m.l = static_cast<CORBA::Long> (i) - 1000;
+  for (CORBA::ULong j = 0; j != 4; ++j)
+    {
+      m.tag[j] = static_cast<CORBA::Octet> (i + j);
+    }
+  m.us[0] = 0xff00;
+  m.us[1] = static_cast<CORBA::UShort> (i);
+  m.f = i / 3.0f;
+}
+
+static void
+fill (Test::Bytes &b, CORBA::ULong i)
+{
+  b.o = static_cast<CORBA::Octet> (i);
+  b.c = static_cast<CORBA::Char> ('a' + i % 26);
+}
+
+static void
+fill (Test::Padded &p, CORBA::ULong i)
+{
+  p.d = i * 2.5;
+  p.l = static_cast<CORBA::Long> (i);
+}
+
+static void
+fill (Test::Flag &f, CORBA::ULong i)
+{
+  f.l = static_cast<CORBA::Long> (i);
+  f.b = (i % 2) != 0;
+}
+
+/// Marshal @a seq, whose elements the stubs may marshal as one block,
+/// and compare with marshaling the elements one at a time.
+template<typename Seq>
+static int
+test_sequence (const char *name, CORBA::ULong length, int byte_order)
+{
+  Seq seq;
+  seq.length (length);
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      fill (seq[i], i);
+    }
+
+  ACE_OS::memset (bulk_buffer, 0, buffer_size);
+  TAO_OutputCDR bulk (bulk_buffer, buffer_size, byte_order);
+  bulk << marker;
+  if (!(bulk << seq))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: %C: cannot marshal %u elements\n",
+                         name, length),
+                        1);
+    }
+
+  ACE_OS::memset (one_by_one_buffer, 0, buffer_size);
+  TAO_OutputCDR one_by_one (one_by_one_buffer, buffer_size, byte_order);
+  one_by_one << marker;
+  one_by_one << length;
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      one_by_one << seq[i];
+    }
+
+  if (contents (bulk) != contents (one_by_one))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: %C: %u elements in byte order %d "
+                         "are not marshaled as one at a time\n",
+                         name, length, byte_order),
+                        1);
+    }
+
+  bool const round_trip = byte_order == ACE_CDR_BYTE_ORDER || swap_on_write;
+  if (!round_trip)
+    {
+      // Make the stream one of the other byte order, with elements
+      // that are read back swapped.
+      char *length_field = one_by_one.begin ()->rd_ptr () + 4;
+      ACE_CDR::swap_4 (length_field, length_field);
+    }
+
+  // Read the stream as a sequence, and one element at a time.
+  TAO_InputCDR input (one_by_one);
+  CORBA::ULong m = 0;
+  Seq read;
+  if (!(input >> m) || !(input >> read) || read.length () != length)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: %C: cannot demarshal %u elements\n",
+                         name, length),
+                        1);
+    }
+
+  TAO_InputCDR input_one_by_one (one_by_one);
+  CORBA::ULong read_length = 0;
+  Seq expected;
+  expected.length (length);
+  input_one_by_one >> m;
+  input_one_by_one >> read_length;
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      input_one_by_one >> expected[i];
+    }
+
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      if (!same (read[i], expected[i])
+          || (round_trip && !same (read[i], seq[i])))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: %C: element %u of %u in byte order %d "
+                             "is not read back\n",
+                             name, i, length, byte_order),
+                            1);
+        }
+    }
+
+  // A stream too short for the elements is refused.
+  TAO_OutputCDR truncated;
+  truncated << length + 1;
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      truncated << seq[i];
+    }
+  TAO_InputCDR short_input (truncated);
+  if (length != 0 && (short_input >> read))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: %C: demarshaled a truncated sequence\n",
+                         name),
+                        1);
+    }
+
+  return 0;
+}
+
+static int
+test_array (int byte_order)
+{
+  Test::PointGrid grid;
+  for (CORBA::ULong i = 0; i != 4; ++i)
+    for (CORBA::ULong j = 0; j != 3; ++j)
+      fill (grid[i][j], i * 3 + j);
+
+  ACE_OS::memset (bulk_buffer, 0, buffer_size);
+  TAO_OutputCDR bulk (bulk_buffer, buffer_size, byte_order);
+  bulk << marker;
+  bulk << Test::PointGrid_forany (grid);
+
+  ACE_OS::memset (one_by_one_buffer, 0, buffer_size);
+  TAO_OutputCDR one_by_one (one_by_one_buffer, buffer_size, byte_order);
+  one_by_one << marker;
+  for (CORBA::ULong i = 0; i != 4; ++i)
+    for (CORBA::ULong j = 0; j != 3; ++j)
+      one_by_one << grid[i][j];
+
+  if (contents (bulk) != contents (one_by_one))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: array in byte order %d is not marshaled "
+                         "as one at a time\n",
+                         byte_order),
+                        1);
+    }
+
+  TAO_InputCDR input (one_by_one);
+  CORBA::ULong m = 0;
+  Test::PointGrid read;
+  Test::PointGrid_forany read_forany (read);
+  if (!(input >> m) || !(input >> read_forany))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot demarshal array\n"), 1);
+    }
+
+  TAO_InputCDR input_one_by_one (one_by_one);
+  Test::PointGrid expected;
+  input_one_by_one >> m;
+  for (CORBA::ULong i = 0; i != 4; ++i)
+    for (CORBA::ULong j = 0; j != 3; ++j)
+      input_one_by_one >> expected[i][j];
+
+  bool const round_trip = byte_order == ACE_CDR_BYTE_ORDER || swap_on_write;
+
+  for (CORBA::ULong i = 0; i != 4; ++i)
+    for (CORBA::ULong j = 0; j != 3; ++j)
+      if (!same (read[i][j], expected[i][j])
+          || (round_trip && !same (read[i][j], grid[i][j])))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: array element [%u][%u] in byte order %d "
+                             "is not read back\n",
+                             i, j, byte_order),
+                            1);
+        }
+
+  return 0;
+}
+
+/// Writes chars in upper case and reads them in lower case, so that
+/// the streams it is used by show whether it was.
+class Upper_Case_Translator : public ACE_Char_Codeset_Translator
+{
+public:
+  virtual ACE_CDR::Boolean read_char (ACE_InputCDR &in, ACE_CDR::Char &x)
+  {
+    ACE_CDR::Octet o = 0;
+    if (!this->read_1 (in, &o))
+      {
+        return false;
+      }
+    x = static_cast<ACE_CDR::Char> (ACE_OS::ace_tolower (o));
+    return true;
+  }
+
+  virtual ACE_CDR::Boolean read_string (ACE_InputCDR &, ACE_CDR::Char *&)
+  {
+    return false;
+  }
+
+  virtual ACE_CDR::Boolean read_char_array (ACE_InputCDR &in,
+                                            ACE_CDR::Char *x,
+                                            ACE_CDR::ULong length)
+  {
+    for (ACE_CDR::ULong i = 0; i != length; ++i)
+      {
+        if (!this->read_char (in, x[i]))
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  virtual ACE_CDR::Boolean write_char (ACE_OutputCDR &out, ACE_CDR::Char x)
+  {
+    ACE_CDR::Octet const o =
+      static_cast<ACE_CDR::Octet> (ACE_OS::ace_toupper (x));
+    return this->write_1 (out, &o);
+  }
+
+  virtual ACE_CDR::Boolean write_string (ACE_OutputCDR &,
+                                         ACE_CDR::ULong,
+                                         const ACE_CDR::Char *)
+  {
+    return false;
+  }
+
+  virtual ACE_CDR::Boolean write_char_array (ACE_OutputCDR &out,
+                                             const ACE_CDR::Char *x,
+                                             ACE_CDR::ULong length)
+  {
+    for (ACE_CDR::ULong i = 0; i != length; ++i)
+      {
+        if (!this->write_char (out, x[i]))
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  virtual ACE_CDR::ULong ncs ()
+  {
+    return 0x00010001U;
+  }
+
+  virtual ACE_CDR::ULong tcs ()
+  {
+    return 0x00010001U;
+  }
+};
+
+/// Marshal a sequence of structs with chars through a char codeset
+/// translator, which must see every char.
+static int
+test_translator ()
+{
+  if (TAO::CDR_Bulk_Traits<Test::Bytes>::is_bulk)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: structs with chars are marshaled as "
+                         "one block\n"),
+                        1);
+    }
+
+  Upper_Case_Translator translator;
+  CORBA::ULong const length = 64;
+  Test::BytesSeq seq;
+  seq.length (length);
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      fill (seq[i], i);
+    }
+
+  TAO_OutputCDR out;
+  out.char_translator (&translator);
+  if (!(out << seq))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: cannot marshal through a translator\n"),
+                        1);
+    }
+
+  // The stream holds what the translator wrote.
+  TAO_InputCDR raw (out);
+  CORBA::ULong raw_length = 0;
+  raw >> raw_length;
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      CORBA::Octet o = 0;
+      CORBA::Octet c = 0;
+      if (!raw.read_octet (o)
+          || !raw.read_octet (c)
+          || o != seq[i].o
+          || c != ACE_OS::ace_toupper (seq[i].c))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: element %u was not written through "
+                             "the translator\n",
+                             i),
+                            1);
+        }
+    }
+
+  TAO_InputCDR in (out);
+  in.char_translator (&translator);
+  Test::BytesSeq read;
+  if (!(in >> read) || read.length () != length)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: cannot demarshal through a translator\n"),
+                        1);
+    }
+
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      if (!same (read[i], seq[i]))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: element %u was not read through "
+                             "the translator\n",
+                             i),
+                            1);
+        }
+    }
+
+  return 0;
+}
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_DEBUG ((LM_DEBUG,
+              "Marshaled as one block: Point %d, Inner %d, Mixed %d, "
+              "Bytes %d, Padded %d, Flag %d\n",
+              TAO::CDR_Bulk_Traits<Test::Point>::is_bulk,
+              TAO::CDR_Bulk_Traits<Test::Inner>::is_bulk,
+              TAO::CDR_Bulk_Traits<Test::Mixed>::is_bulk,
+              TAO::CDR_Bulk_Traits<Test::Bytes>::is_bulk,
+              TAO::CDR_Bulk_Traits<Test::Padded>::is_bulk,
+              TAO::CDR_Bulk_Traits<Test::Flag>::is_bulk));
+
+  int status = 0;
+  static const CORBA::ULong lengths[] = { 0, 1, 7, 64, 5000 };
+  static const int byte_orders[] = { ACE_CDR_BYTE_ORDER, !ACE_CDR_BYTE_ORDER };
+
+  for (size_t o = 0; o != 2; ++o)
+    {
+      int const byte_order = byte_orders[o];
+      for (size_t l = 0; l != sizeof lengths / sizeof lengths[0]; ++l)
+        {
+          CORBA::ULong const length = lengths[l];
+          status |= test_sequence<Test::PointSeq> ("PointSeq", length, byte_order);
+          status |= test_sequence<Test::MixedSeq> ("MixedSeq", length, byte_order);
+          status |= test_sequence<Test::BytesSeq> ("BytesSeq", length, byte_order);
+          status |= test_sequence<Test::PaddedSeq> ("PaddedSeq", length, byte_order);
+          status |= test_sequence<Test::FlagSeq> ("FlagSeq", length, byte_order);
+          if (length <= 64)
+            {
+              status |= test_sequence<Test::BoundedPointSeq> (
+                "BoundedPointSeq", length, byte_order);
+            }
+        }
+      status |= test_array (byte_order);
+    }
+
+  status |= test_translator ();
+
+  if (status == 0)
+    {
+      ACE_DEBUG ((LM_DEBUG, "Test passed\n"));
+    }
+
+  return status;
+}
@@ -0,0 +1,377 @@
+//=============================================================================
+/**
+ *  @file   test.cpp
+ *
+ *  Verifies that the operator<< (ACE_SizeCDR &, ...) generated by
+ *  tao_idl gives the size the value takes when marshaled, wherever
+ *  in the stream it starts, that types holding object references are
+ *  not sized, and that reserving the size of the arguments of a
+ *  request puts them in one block, from which they are read back.
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "tao/CDR.h"
+#include "tao/CDR_Size_T.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_string.h"
+
+static size_t
+blocks (const TAO_OutputCDR &cdr)
+{
+  size_t n = 0;
+  for (const ACE_Message_Block *mb = cdr.begin (); mb != 0; mb = mb->cont ())
+    {
+      if (mb->length () != 0)
+        {
+          ++n;
+        }
+    }
+  return n;
+}
+
+/// Size @a value starting at every offset up to the largest
+/// alignment, and compare with marshaling it.
+template<typename T>
+static int
+check_size (const char *name, const T &value)
+{
+  for (size_t start = 0; start <= ACE_CDR::MAX_ALIGNMENT; ++start)
+    {
+      TAO_OutputCDR out;
+      for (size_t i = 0; i != start; ++i)
+        {
+          out.write_octet (0);
+        }
+
+      if (!(out << value))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: %C: cannot marshal\n", name),
+                            1);
+        }
+
+      ACE_SizeCDR sizer;
+      sizer.adjust (start, 1);
+      if (!TAO::cdr_size (sizer, value))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: %C: cannot size\n", name),
+                            1);
+        }
+
+      if (sizer.total_length () != out.total_length ())
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: %C at offset %B is sized as %B octets "
+                             "instead of %B\n",
+                             name, start,
+                             sizer.total_length () - start,
+                             out.total_length () - start),
+                            1);
+        }
+    }
+
+  return 0;
+}
+
+static void
+fill (Test::Record &r, CORBA::ULong n)
+{
+  r.tag = 7;
+  r.name = CORBA::string_dup ("a record");
+  r.id = static_cast<CORBA::Long> (n);
+  r.shade = Test::GREEN;
+  r.flag = true;
+  r.labels.length (n);
+  for (CORBA::ULong i = 0; i != n; ++i)
+    {
+      r.labels[i] = CORBA::string_dup (i % 2 ? "odd" : "even label");
+    }
+  r.path.length (n * 10);
+  for (CORBA::ULong i = 0; i != n * 10; ++i)
+    {
+      r.path[i].x = i;
+      r.path[i].y = -1.0 * i;
+      r.path[i].z = 0.5;
+    }
+  r.dims[0] = 1;
+  r.dims[1] = 2;
+  r.dims[2] = 3;
+  r.data.length (n * 3 + 1);
+  for (CORBA::ULong i = 0; i != r.data.length (); ++i)
+    {
+      r.data[i] = static_cast<CORBA::Octet> (i);
+    }
+  r.wname = CORBA::wstring_dup (L"wide");
+  r.stamp = 1234567890123LL;
+}
+
+static void
+fill (Test::ValueSeq &values, CORBA::ULong n)
+{
+  values.length (n);
+  for (CORBA::ULong i = 0; i != n; ++i)
+    {
+      switch (i % 4)
+        {
+        case 0:
+          values[i].s ("a string in a union");
+          break;
+        case 1:
+          values[i].d (i * 1.5);
+          break;
+        case 2:
+          {
+            Test::PointSeq points;
+            points.length (i);
+            values[i].points (points);
+          }
+          break;
+        default:
+          values[i].o (static_cast<CORBA::Octet> (i));
+          break;
+        }
+    }
+}
+
+static int
+test_sizes ()
+{
+  int status = 0;
+
+  status |= check_size ("Color", Test::BLUE);
+
+  Test::Point point;
+  point.x = point.y = point.z = 1.0;
+  status |= check_size ("Point", point);
+
+  for (CORBA::ULong n = 0; n != 4; ++n)
+    {
+      Test::Record record;
+      fill (record, n);
+      status |= check_size ("Record", record);
+
+      Test::RecordSeq records;
+      records.length (n);
+      for (CORBA::ULong i = 0; i != n; ++i)
+        {
+          fill (records[i], i);
+        }
+      status |= check_size ("RecordSeq", records);
+
+      Test::ValueSeq values;
+      fill (values, n * 3);
+      status |= check_size ("ValueSeq", values);
+    }
+
+  Test::ValueTriple triple;
+  triple[0].s ("first");
+  triple[1].d (2.0);
+  triple[2].o (3);
+  status |= check_size ("ValueTriple", Test::ValueTriple_forany (triple));
+
+  Test::Maybe maybe;
+  maybe._default ();
+  status |= check_size ("Maybe empty", maybe);
+  Test::Record record;
+  fill (record, 2);
+  maybe.r (record);
+  status |= check_size ("Maybe", maybe);
+
+  Test::NamePair names;
+  names[0] = CORBA::string_dup ("one");
+  names[1] = CORBA::string_dup ("three");
+  status |= check_size ("NamePair", Test::NamePair_forany (names));
+
+  Test::Node tree;
+  tree.label = CORBA::string_dup ("root");
+  tree.children.length (2);
+  tree.children[0].label = CORBA::string_dup ("leaf");
+  tree.children[1].label = CORBA::string_dup ("branch");
+  tree.children[1].children.length (1);
+  tree.children[1].children[0].label = CORBA::string_dup ("leaf");
+  status |= check_size ("Node", tree);
+
+  // The size of an object reference is not known before marshaling it.
+  Test::Holder holder;
+  holder.name = CORBA::string_dup ("holder");
+  ACE_SizeCDR sizer;
+  if (TAO::cdr_size (sizer, holder))
+    {
+      ACE_ERROR ((LM_ERROR, "ERROR: Holder is sized\n"));
+      status = 1;
+    }
+
+  return status;
+}
+
+static bool
+same (const Test::Record &a, const Test::Record &b)
+{
+  if (ACE_OS::strcmp (a.name.in (), b.name.in ()) != 0
+      || a.id != b.id
+      || a.shade != b.shade
+      || a.labels.length () != b.labels.length ()
+      || a.path.length () != b.path.length ()
+      || a.data.length () != b.data.length ()
+      || ACE_OS::strcmp (a.wname.in (), b.wname.in ()) != 0
+      || a.stamp != b.stamp)
+    {
+      return false;
+    }
+  for (CORBA::ULong i = 0; i != a.labels.length (); ++i)
+    {
+      if (ACE_OS::strcmp (a.labels[i].in (), b.labels[i].in ()) != 0)
+        {
+          return false;
+        }
+    }
+  for (CORBA::ULong i = 0; i != a.path.length (); ++i)
+    {
+      if (a.path[i].x != b.path[i].x || a.path[i].z != b.path[i].z)
+        {
+          return false;
+        }
+    }
+  return a.data.length () == 0
+    || ACE_OS::memcmp (a.data.get_buffer (),
+                       b.data.get_buffer (),
+                       a.data.length ()) == 0;
+}
+
+static bool
+same (const Test::ValueSeq &a, const Test::ValueSeq &b)
+{
+  if (a.length () != b.length ())
+    {
+      return false;
+    }
+  for (CORBA::ULong i = 0; i != a.length (); ++i)
+    {
+      if (a[i]._d () != b[i]._d ())
+        {
+          return false;
+        }
+      switch (a[i]._d ())
+        {
+        case 1:
+          if (ACE_OS::strcmp (a[i].s (), b[i].s ()) != 0)
+            return false;
+          break;
+        case 2:
+          if (a[i].d () != b[i].d ())
+            return false;
+          break;
+        case 3:
+          if (a[i].points ().length () != b[i].points ().length ())
+            return false;
+          break;
+        default:
+          if (a[i].o () != b[i].o ())
+            return false;
+          break;
+        }
+    }
+  return true;
+}
+
+/// Marshal the arguments of get_records() as a request does, with
+/// and without reserving their size first.
+static int
+test_reserve ()
+{
+  Test::Record record;
+  fill (record, 500);
+  Test::ValueSeq values;
+  fill (values, 1000);
+
+  TAO::Arg_Traits<Test::Record>::in_arg_val in (record);
+  TAO::Arg_Traits<Test::ValueSeq>::inout_arg_val inout (values);
+  TAO::Argument *args[] = { &in, &inout };
+  size_t const nargs = sizeof args / sizeof args[0];
+
+  // A threshold of 0, the default of the ORB, and one above the size
+  // of the arguments do not reserve.
+  TAO_OutputCDR grown;
+  grown.write_ulong (42);
+  TAO::reserve_arguments (grown, args, nargs, 0);
+  TAO_OutputCDR below;
+  below.write_ulong (42);
+  TAO::reserve_arguments (below, args, nargs, ACE_UINT32_MAX);
+  TAO_OutputCDR reserved;
+  reserved.write_ulong (42);
+  TAO::reserve_arguments (reserved, args, nargs, 1);
+
+  for (size_t i = 0; i != nargs; ++i)
+    {
+      if (!args[i]->marshal (grown)
+          || !args[i]->marshal (below)
+          || !args[i]->marshal (reserved))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: cannot marshal argument %B\n", i),
+                            1);
+        }
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%B octets of arguments in %B blocks, "
+              "%B blocks when reserved\n",
+              grown.total_length (), blocks (grown), blocks (reserved)));
+
+  if (grown.total_length () != reserved.total_length ())
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: reserving changes what is marshaled\n"),
+                        1);
+    }
+
+  TAO_InputCDR input (reserved);
+  CORBA::ULong header = 0;
+  Test::Record read_record;
+  Test::ValueSeq read_values;
+  if (!(input >> header)
+      || !(input >> read_record)
+      || !(input >> read_values)
+      || !same (read_record, record)
+      || !same (read_values, values))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: arguments are not read back\n"),
+                        1);
+    }
+
+  if (blocks (below) != blocks (grown))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: arguments below the threshold reserved\n"),
+                        1);
+    }
+
+  // The request header and the start of the arguments, then the rest
+  // of the arguments in one block.
+  if (blocks (reserved) != 2)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: arguments reserved in %B blocks\n",
+                         blocks (reserved)),
+                        1);
+    }
+
+  return 0;
+}
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  int status = test_sizes ();
+  status |= test_reserve ();
+
+  if (status == 0)
+    {
+      ACE_DEBUG ((LM_DEBUG, "Test passed\n"));
+    }
+
+  return status;
+}
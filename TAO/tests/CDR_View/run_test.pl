@@ -0,0 +1,28 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $status = 0;
+
+# Through the POA, directly, and over IIOP to the same process.
+foreach my $args ("",
+                  "-ORBCollocationStrategy direct",
+                  "-ORBCollocation no") {
+    $SV = $server->CreateProcess ("test", $args);
+
+    $test = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval());
+
+    if ($test != 0) {
+        print STDERR "ERROR: test $args returned $test\n";
+        $status = 1;
+    }
+}
+
+exit $status;
@@ -0,0 +1,348 @@
+//=============================================================================
+/**
+ *  @file   test.cpp
+ *
+ *  Verifies the views tao_idl generates with -Gview: that they read
+ *  the same values as demarshaling, wherever the struct starts in the
+ *  stream, that short data is rejected, and
+ *  that a servant receives the struct arguments through views when
+ *  called remotely, through the POA or directly.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "tao/CDR_View.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_wchar.h"
+
+static void
+fill (Test::Outer &o, CORBA::ULong n)
+{
+  o.version = 3;
+  o.body.flag = true;
+  o.body.core.tag = 'q';
+  o.body.core.name = CORBA::string_dup ("inner name");
+  o.body.core.where.x = 1.5;
+  o.body.core.where.y = -2.5;
+  o.body.core.path.length (n);
+  for (CORBA::ULong i = 0; i != n; ++i)
+    {
+      o.body.core.path[i].x = i;
+      o.body.core.path[i].y = -1.0 * i;
+    }
+  o.body.labels.length (n);
+  for (CORBA::ULong i = 0; i != n; ++i)
+    {
+      o.body.labels[i] = CORBA::string_dup (i % 2 ? "odd" : "even label");
+    }
+  o.body.wname = CORBA::wstring_dup (L"wide name");
+  o.stamp = 1234567890123LL;
+  o.shade = Test::BLUE;
+  o.shades.length (n);
+  for (CORBA::ULong i = 0; i != n; ++i)
+    {
+      o.shades[i] = static_cast<Test::Color> (i % 3);
+    }
+  o.data.length (n * 3 + 1);
+  for (CORBA::ULong i = 0; i != o.data.length (); ++i)
+    {
+      o.data[i] = static_cast<CORBA::Octet> (i);
+    }
+  o.extra.s ("a string in a union");
+  o.sizes[0] = 10;
+  o.sizes[1] = 20;
+  o.sizes[2] = 30;
+  o.last = 65000;
+}
+
+static void
+fill (Test::Node &tree)
+{
+  tree.label = CORBA::string_dup ("root");
+  tree.children.length (3);
+  tree.children[0].label = CORBA::string_dup ("leaf");
+  tree.children[1].label = CORBA::string_dup ("branch");
+  tree.children[1].children.length (1);
+  tree.children[1].children[0].label = CORBA::string_dup ("deep leaf");
+  tree.children[2].label = CORBA::string_dup ("");
+}
+
+#define CHECK(X) \
+  do { \
+    if (!(X)) \
+      { \
+        ACE_ERROR ((LM_ERROR, "ERROR: %C:%d: %C\n", \
+                    __FILE__, __LINE__, #X)); \
+        ++errors; \
+      } \
+  } while (0)
+
+/// Read @a v through its accessors, and compare with @a o.
+static int
+compare (const Test::Outer_View &v, const Test::Outer &o)
+{
+  int errors = 0;
+
+  // Access the last member first, then go back to the first ones.
+  CHECK (v.last () == o.last);
+  CHECK (v.version () == o.version);
+  CHECK (v.stamp () == o.stamp);
+  CHECK (v.shade () == o.shade);
+
+  const Test::Middle_View &body = v.body ();
+  CHECK (body.flag () == o.body.flag);
+  CHECK (ACE_OS::strcmp (body.wname (), o.body.wname.in ()) == 0);
+
+  const Test::Inner_View &core = body.core ();
+  CHECK (core.tag () == o.body.core.tag);
+  CHECK (ACE_OS::strcmp (core.name (), o.body.core.name.in ()) == 0);
+  CHECK (core.where ().x () == o.body.core.where.x);
+  CHECK (core.where ().y () == o.body.core.where.y);
+
+  CHECK (core.path ().length () == o.body.core.path.length ());
+  for (CORBA::ULong i = core.path ().length (); i-- != 0; )
+    {
+      CHECK (core.path ()[i].x () == o.body.core.path[i].x);
+      CHECK (core.path ()[i].y () == o.body.core.path[i].y);
+    }
+
+  CHECK (body.labels ().length () == o.body.labels.length ());
+  for (CORBA::ULong i = 0; i != body.labels ().length (); ++i)
+    {
+      CHECK (ACE_OS::strcmp (body.labels ()[i], o.body.labels[i]) == 0);
+    }
+
+  CHECK (v.shades ().length () == o.shades.length ());
+  for (CORBA::ULong i = 0; i != v.shades ().length (); ++i)
+    {
+      CHECK (v.shades ()[i] == o.shades[i]);
+    }
+
+  CHECK (v.data ().length () == o.data.length ());
+  CHECK (v.data ().get_buffer () == 0
+         || ACE_OS::memcmp (v.data ().get_buffer (),
+                            o.data.get_buffer (),
+                            o.data.length ()) == 0);
+  for (CORBA::ULong i = 0; i != v.data ().length (); ++i)
+    {
+      CHECK (v.data ()[i] == o.data[i]);
+    }
+  bool past_end = false;
+  try
+    {
+      v.data ()[o.data.length ()];
+    }
+  catch (const CORBA::BAD_PARAM &)
+    {
+      past_end = true;
+    }
+  CHECK (past_end);
+
+  Test::Value extra;
+  v.extra (extra);
+  CHECK (extra._d () == o.extra._d ());
+  CHECK (ACE_OS::strcmp (extra.s (), o.extra.s ()) == 0);
+
+  Test::Dims sizes;
+  v.sizes (sizes);
+  CHECK (ACE_OS::memcmp (sizes, o.sizes, sizeof sizes) == 0);
+
+  Test::Outer copy;
+  v._decode (copy);
+  CHECK (copy.stamp == o.stamp);
+  CHECK (ACE_OS::strcmp (copy.body.core.name.in (),
+                         o.body.core.name.in ()) == 0);
+  CHECK (copy.body.labels.length () == o.body.labels.length ());
+  CHECK (copy.last == o.last);
+
+  return errors;
+}
+
+static int
+compare (const Test::Node_View &v, const Test::Node &tree)
+{
+  int errors = 0;
+
+  CHECK (ACE_OS::strcmp (v.label (), tree.label.in ()) == 0);
+  CHECK (v.children ().length () == tree.children.length ());
+  for (CORBA::ULong i = 0; i != v.children ().length (); ++i)
+    {
+      errors += compare (v.children ()[i], tree.children[i]);
+    }
+
+  return errors;
+}
+
+/// Marshal the values after @a start octets, and read them through
+/// views.
+static int
+test_view (size_t start)
+{
+  int errors = 0;
+
+  Test::Outer outer;
+  fill (outer, static_cast<CORBA::ULong> (start + 2));
+  Test::Node tree;
+  fill (tree);
+
+  TAO_OutputCDR out;
+  for (size_t i = 0; i != start; ++i)
+    {
+      out.write_octet (0);
+    }
+  if (!(out << outer) || !(out << tree) || !out.write_ulong (42))
+    {
+      ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot marshal\n"), 1);
+    }
+
+  TAO_InputCDR in (out);
+  in.skip_bytes (start);
+
+  Test::Outer_View outer_view;
+  Test::Node_View tree_view;
+  CORBA::ULong after = 0;
+  if (!outer_view._tao_bind (in)
+      || !tree_view._tao_bind (in)
+      || !in.read_ulong (after)
+      || after != 42)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: cannot skip over the views "
+                         "at offset %B\n", start),
+                        1);
+    }
+
+  errors += compare (outer_view, outer);
+  errors += compare (tree_view, tree);
+
+  // A view left in a sequence is found again by skipping.
+  Test::Node_View branch = tree_view.children ()[1];
+  CHECK (ACE_OS::strcmp (branch.children ()[0].label (), "deep leaf") == 0);
+  CHECK (ACE_OS::strcmp (tree_view.children ()[0].label (), "leaf") == 0);
+
+  return errors;
+}
+
+static int
+test_short ()
+{
+  Test::Outer outer;
+  fill (outer, 4);
+
+  TAO_OutputCDR out;
+  out << outer;
+  TAO_InputCDR full (out);
+
+  // Truncate the data at each position.
+  for (size_t len = 0; len < full.length (); len += 7)
+    {
+      TAO_InputCDR in (full.rd_ptr (), len);
+      Test::Outer_View view;
+      if (view._tao_bind (in))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: view bound to %B of %B octets\n",
+                             len, full.length ()),
+                            1);
+        }
+    }
+
+  return 0;
+}
+
+// ==========================================================================
+
+class Receiver_i : public virtual POA_Test::Receiver
+{
+public:
+  CORBA::Long check (const Test::Outer_View &outer,
+                     const Test::Node_View &tree,
+                     Test::Point &p,
+                     CORBA::String_out s) override
+  {
+    Test::Outer o;
+    fill (o, 5);
+    Test::Node t;
+    fill (t);
+
+    p.x += 1;
+    s = CORBA::string_dup (outer.body ().core ().name ());
+
+    return compare (outer, o) + compare (tree, t);
+  }
+};
+
+static int
+test_upcall (int argc, ACE_TCHAR *argv[])
+{
+  CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+  CORBA::Object_var poa_object =
+    orb->resolve_initial_references ("RootPOA");
+  PortableServer::POA_var root_poa =
+    PortableServer::POA::_narrow (poa_object.in ());
+  PortableServer::POAManager_var poa_manager = root_poa->the_POAManager ();
+  poa_manager->activate ();
+
+  Receiver_i *impl = 0;
+  ACE_NEW_RETURN (impl, Receiver_i, 1);
+  PortableServer::ServantBase_var owner (impl);
+
+  PortableServer::ObjectId_var id = root_poa->activate_object (impl);
+  CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+  Test::Receiver_var receiver = Test::Receiver::_narrow (object.in ());
+
+  Test::Outer outer;
+  fill (outer, 5);
+  Test::Node tree;
+  fill (tree);
+  Test::Point p;
+  p.x = 1;
+  p.y = 2;
+  CORBA::String_var s;
+
+  CORBA::Long errors = receiver->check (outer, tree, p, s.out ());
+
+  if (errors != 0
+      || p.x != 2
+      || ACE_OS::strcmp (s.in (), outer.body.core.name.in ()) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: servant read %d wrong values\n", errors));
+      errors = errors == 0 ? 1 : errors;
+    }
+
+  root_poa->destroy (true, true);
+  orb->destroy ();
+
+  return errors;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      for (size_t start = 0; start <= ACE_CDR::MAX_ALIGNMENT; ++start)
+        {
+          status += test_view (start);
+        }
+      status += test_short ();
+      status += test_upcall (argc, argv);
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (status == 0)
+    {
+      ACE_DEBUG ((LM_DEBUG, "Test passed\n"));
+    }
+
+  return status != 0;
+}
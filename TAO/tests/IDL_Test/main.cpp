@@ -22,6 +22,8 @@
 #include "ace/OS_NS_string.h"
 #include "tao/AnyTypeCode/Any.h"
 
+#include <utility>
+
 class hello_i : public virtual POA_hello
 {
 };
@@ -399,6 +401,53 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
                       "default case label value\n"));
         }
 
+      // A union moved from is left as if default constructed, and a
+      // union move assigned to gives its old value to the other one.
+      UnionTest3::IndType ind;
+      UnionTest3::DownType down;
+      down.high.integerValue (1);
+      down.low.realValue (2.0);
+      ind.down (down);
+      UnionTest3::IndType moved (std::move (ind));
+
+      if (moved._d () != UnionTest3::down_Level
+          || moved.down ().high.integerValue () != 1
+          || ind._d () != UnionTest3::IndType ()._d ())
+        {
+          ++error_count;
+          ACE_ERROR ((LM_ERROR,
+                      "error - union not moved\n"));
+        }
+
+      UnionTest3::UpType up;
+      up.high.integerValue (3);
+      up.low.integerValue (4);
+      ind.up (up);
+      ind = std::move (moved);
+
+      if (ind._d () != UnionTest3::down_Level
+          || ind.down ().low.realValue () != 2.0
+          || moved._d () != UnionTest3::up_Level
+          || moved.up ().high.integerValue () != 3)
+        {
+          ++error_count;
+          ACE_ERROR ((LM_ERROR,
+                      "error - union not move assigned\n"));
+        }
+
+      FieldValue defvalue;
+      defvalue.defstr (CORBA::string_dup ("moved"));
+      FieldValue strvalue (std::move (defvalue));
+      defvalue = strvalue;
+
+      if (ACE_OS::strcmp (strvalue.defstr (), "moved") != 0
+          || ACE_OS::strcmp (defvalue.defstr (), "moved") != 0)
+        {
+          ++error_count;
+          ACE_ERROR ((LM_ERROR,
+                      "error - string union not moved\n"));
+        }
+
       if (SignedGen::val !=  -3)
         {
           ++error_count;
@@ -0,0 +1 @@
+#include "TAO_IDL/driver/drv_cpp.cpp"
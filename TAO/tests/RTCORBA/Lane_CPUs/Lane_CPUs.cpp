@@ -0,0 +1,308 @@
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/Thread_Placement.h"
+#include "testS.h"
+#include "tao/RTCORBA/RTCORBA.h"
+#include "tao/RTCORBA/RT_ORB.h"
+#include "tao/RTCORBA/Thread_Pool.h"
+#include "tao/RTPortableServer/RTPortableServer.h"
+#include "../check_supported_priorities.cpp"
+
+static int iterations = 10;
+
+/// The CPUs the calling thread may run on, empty when the platform
+/// cannot tell.
+static ACE_Thread_Placement
+current_cpus ()
+{
+  ACE_Thread_Placement current;
+#if defined (CPU_ISSET)
+  cpu_set_t set;
+  ACE_OS::memset (&set, 0, sizeof set);
+# if defined (ACE_HAS_PTHREAD_GETAFFINITY_NP)
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+# else
+  ACE_hthread_t self = 0;
+# endif /* ACE_HAS_PTHREAD_GETAFFINITY_NP */
+  if (ACE_OS::thr_get_affinity (self, sizeof set, &set) == 0)
+    for (size_t cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET (cpu, &set))
+        current.add_cpu (cpu);
+#endif /* CPU_ISSET */
+  return current;
+}
+
+class test_i :
+  public POA_test
+{
+public:
+  CORBA::ULong cpus (CORBA::ULong_out first);
+};
+
+CORBA::ULong
+test_i::cpus (CORBA::ULong_out first)
+{
+  ACE_Thread_Placement const current = current_cpus ();
+
+  first = current.empty () ? 0 : current.cpu (0);
+  return current.cpu_count ();
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-i <iterations> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  return 0;
+}
+
+/// Create a pool with one lane of @a static_threads threads, and a
+/// POA it serves.
+PortableServer::POA_ptr
+create_pool_and_POA (const char *poa_name,
+                     CORBA::ULong static_threads,
+                     RTCORBA::ThreadpoolId expected_id,
+                     PortableServer::POA_ptr root_poa,
+                     RTCORBA::RTORB_ptr rt_orb,
+                     RTCORBA::Priority priority)
+{
+  RTCORBA::ThreadpoolLanes lanes (1);
+  lanes.length (1);
+
+  lanes[0].lane_priority = priority;
+  lanes[0].static_threads = static_threads;
+  lanes[0].dynamic_threads = 0;
+
+  RTCORBA::ThreadpoolId const id =
+    rt_orb->create_threadpool_with_lanes (0,
+                                          lanes,
+                                          false,
+                                          false,
+                                          0,
+                                          0);
+
+  // svc.conf names the pools by their ids.
+  if (id != expected_id)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: pool %C has id %u, expected %u\n",
+                  poa_name,
+                  id,
+                  expected_id));
+      throw CORBA::INTERNAL ();
+    }
+
+  CORBA::PolicyList policies (2);
+  policies.length (2);
+  policies[0] =
+    rt_orb->create_threadpool_policy (id);
+  policies[1] =
+    rt_orb->create_priority_model_policy (RTCORBA::CLIENT_PROPAGATED,
+                                          priority);
+
+  PortableServer::POAManager_var poa_manager =
+    root_poa->the_POAManager ();
+
+  PortableServer::POA_var poa =
+    root_poa->create_POA (poa_name,
+                          poa_manager.in (),
+                          policies);
+
+  for (CORBA::ULong i = 0;
+       i < policies.length ();
+       ++i)
+    {
+      policies[i]->destroy ();
+    }
+
+  return poa._retn ();
+}
+
+/// Check that the lanes are given the CPUs of svc.conf.
+int
+check_lane_placement (RTCORBA::RTORB_ptr rt_orb)
+{
+  TAO_RT_ORB *tao_rt_orb =
+    dynamic_cast<TAO_RT_ORB *> (rt_orb);
+  if (tao_rt_orb == 0)
+    throw CORBA::INTERNAL ();
+
+  TAO_Thread_Pool_Manager &manager = tao_rt_orb->tp_manager ();
+  int status = 0;
+
+  ACE_Thread_Placement placement;
+  manager.lane_placement (1, 0, placement);
+  if (!placement.empty ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: lane 1:0 is given %B CPUs, expected none\n",
+                  placement.cpu_count ()));
+      status = 1;
+    }
+
+  manager.lane_placement (2, 0, placement);
+  if (placement.cpu_count () != 1
+      || placement.cpu (0) != 0
+      || placement.policy () != ACE_Thread_Placement::ROUND_ROBIN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: lane 2:0 is not given CPU 0\n"));
+      status = 1;
+    }
+
+  return status;
+}
+
+/// Call @a object and check that the upcalls ran on @a count CPUs,
+/// the lowest of them @a first.
+int
+check_cpus (test_ptr object,
+            const char *what,
+            CORBA::ULong count,
+            CORBA::ULong first)
+{
+  int status = 0;
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      CORBA::ULong upcall_first = 0;
+      CORBA::ULong const upcall_count =
+        object->cpus (upcall_first);
+
+      if (upcall_count != count || upcall_first != first)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %C: upcall runs on %u CPUs from %u, "
+                      "expected %u CPUs from %u\n",
+                      what,
+                      upcall_count,
+                      upcall_first,
+                      count,
+                      first));
+          status = 1;
+        }
+    }
+
+  return status;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc,
+                         argv);
+
+      int result =
+        parse_args (argc, argv);
+      if (result != 0)
+        return result;
+
+      // svc.conf binds the second pool to CPU 0, which the test needs
+      // to be able to run on.
+      ACE_Thread_Placement const cpus = current_cpus ();
+      if (cpus.empty () || cpus.cpu (0) != 0)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "Thread affinity is not available or CPU 0 "
+                      "cannot be used, terminating program....\n"));
+          orb->destroy ();
+          return 2;
+        }
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      object =
+        orb->resolve_initial_references ("RTORB");
+
+      RTCORBA::RTORB_var rt_orb =
+        RTCORBA::RTORB::_narrow (object.in ());
+
+      RTCORBA::Priority const default_thread_priority =
+        get_implicit_thread_CORBA_priority (orb.in ());
+
+      PortableServer::POA_var unbound_poa =
+        create_pool_and_POA ("unbound",
+                             1,
+                             1,
+                             root_poa.in (),
+                             rt_orb.in (),
+                             default_thread_priority);
+
+      PortableServer::POA_var bound_poa =
+        create_pool_and_POA ("bound",
+                             2,
+                             2,
+                             root_poa.in (),
+                             rt_orb.in (),
+                             default_thread_priority);
+
+      test_i unbound_servant;
+      PortableServer::ObjectId_var id =
+        unbound_poa->activate_object (&unbound_servant);
+      object = unbound_poa->id_to_reference (id.in ());
+      test_var unbound = test::_narrow (object.in ());
+
+      test_i bound_servant;
+      id = bound_poa->activate_object (&bound_servant);
+      object = bound_poa->id_to_reference (id.in ());
+      test_var bound = test::_narrow (object.in ());
+
+      poa_manager->activate ();
+
+      int status =
+        check_lane_placement (rt_orb.in ());
+
+      // The main thread is in neither pool, so the upcalls run in the
+      // threads of the lanes.
+      status |=
+        check_cpus (unbound.in (),
+                    "unbound lane",
+                    static_cast<CORBA::ULong> (cpus.cpu_count ()),
+                    static_cast<CORBA::ULong> (cpus.cpu (0)));
+
+      status |=
+        check_cpus (bound.in (),
+                    "bound lane",
+                    1,
+                    0);
+
+      orb->destroy ();
+
+      return status;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return -1;
+    }
+}
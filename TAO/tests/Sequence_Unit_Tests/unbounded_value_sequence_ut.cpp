@@ -76,6 +76,56 @@ struct Tester
     return 0;
   }
 
+  int test_move_constructor_from_ulong()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(16);
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      x.length(8);
+      x[7] = 7;
+
+      tested_sequence y(std::move(x));
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      CHECK_EQUAL(CORBA::ULong(16), y.maximum());
+      CHECK_EQUAL(CORBA::ULong(8), y.length());
+      CHECK_EQUAL(true, y.release());
+      CHECK_EQUAL(7, y[7]);
+
+      // The moved from sequence is left empty and can be reused.
+      CHECK_EQUAL(CORBA::ULong(0), x.maximum());
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+      CHECK_EQUAL(false, x.release());
+      x.length(4);
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+    }
+    FAIL_RETURN_IF_NOT(f.expect(2), f);
+    return 0;
+  }
+
+  int test_move_assignment_from_ulong()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(16);
+      x.length(8);
+      tested_sequence y(4);
+      FAIL_RETURN_IF_NOT(a.expect(2), a);
+
+      y = std::move(x);
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      FAIL_RETURN_IF_NOT(f.expect(1), f);
+      CHECK_EQUAL(CORBA::ULong(16), y.maximum());
+      CHECK_EQUAL(CORBA::ULong(8), y.length());
+      CHECK_EQUAL(true, y.release());
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+    }
+    FAIL_RETURN_IF_NOT(f.expect(1), f);
+    return 0;
+  }
+
   int test_ulong_constructor()
   {
     expected_calls a(tested_allocation_traits::allocbuf_calls);
@@ -394,6 +444,8 @@ struct Tester
     status += this->test_ulong_constructor();
     status += this->test_copy_constructor_from_ulong();
     status += this->test_assignment_from_ulong();
+    status += this->test_move_constructor_from_ulong();
+    status += this->test_move_assignment_from_ulong();
     status += this->test_exception_in_ulong_constructor();
     status += this->test_set_length_less_than_maximum();
     status += this->test_set_length_more_than_maximum();